@@ -10001,6 +10001,39 @@ template <typename Enum> friend bool operator==(Enum value, Int);
 template <typename Enum> friend bool operator!=(Enum value, Int);
 };
 
+/// @ref oglplus_smart_enums "Smart enum" for enumerations with the @c Int_2_10_10_10_Rev value.
+/**
+ *  @see @ref oglplus::DataType "DataType"
+ *
+ *  @glsymbols
+ *  @gldefref{INT_2_10_10_10_REV}
+ *
+ *  @ingroup smart_enums
+ */
+struct Int_2_10_10_10_Rev {
+
+/// Conversion to any @p Enum type having the Int_2_10_10_10_Rev value.
+/** Instances of the @ref oglplus::smart_enums::Int_2_10_10_10_Rev "Int_2_10_10_10_Rev"
+ *  type are convertible to instances of any enumeration type having
+ *  the @c Int_2_10_10_10_Rev value.
+ */
+template <typename Enum, Enum = Enum::Int_2_10_10_10_Rev> operator Enum (void) const;
+
+/// Equality comparison with any @p Enum type having the Int_2_10_10_10_Rev value.
+/** Instances of the @c smart_enums::Int_2_10_10_10_Rev type can be compared
+ *  for equality to instances of any enumeration type having
+ *  the @c Int_2_10_10_10_Rev value.
+ */
+template <typename Enum> friend bool operator==(Enum value, Int_2_10_10_10_Rev);
+
+/// Non-equality comparison with any @p Enum type having the Int_2_10_10_10_Rev value.
+/** Instances of the @c smart_enums::Int_2_10_10_10_Rev type can be compared
+ *  for non-equality to instances of any enumeration type having
+ *  the @c Int_2_10_10_10_Rev value.
+ */
+template <typename Enum> friend bool operator!=(Enum value, Int_2_10_10_10_Rev);
+};
+
 /// @ref oglplus_smart_enums "Smart enum" for enumerations with the @c Intensity value.
 /**
  *  @see @ref oglplus::PathNVColorFormat "PathNVColorFormat"
@@ -26784,6 +26817,7 @@ template <typename Enum> friend bool operator!=(Enum value, UnsignedInt_10f_11f_
 
 /// @ref oglplus_smart_enums "Smart enum" for enumerations with the @c UnsignedInt_2_10_10_10_Rev value.
 /**
+ *  @see @ref oglplus::DataType "DataType"
  *  @see @ref oglplus::PixelDataType "PixelDataType"
  *
  *  @glsymbols
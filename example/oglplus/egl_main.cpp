@@ -240,7 +240,7 @@ void run_framedump_loop(
 		);
 	}
 
-	typedef CubicBezierLoop<Vec2f, double> Loop;
+	CubicBezierLoop<Vec2f, double> mouse_path(mouse_path_pos);
 
 	double t = 0.0;
 	double period = 1.0 / 25.0;
@@ -251,7 +251,8 @@ void run_framedump_loop(
 
 	while(true)
 	{
-		Vec2f mouse_pos = Loop(mouse_path_pos).Position(t*0.2);
+		mouse_path.Update(mouse_path_pos);
+		Vec2f mouse_pos = mouse_path.Position(t*0.2);
 
 		for(std::size_t p=0; p!= mouse_path_pts; ++p)
 		{
@@ -0,0 +1,102 @@
+/**
+ *  @example standalone/001_shape_analyzer_bench.cpp
+ *  @brief Measures the time of the adjacency detection of the shape analyzer
+ *
+ *  Generates and analyzes large shapes (with more than one million
+ *  triangles by default) and prints the time spent and the numbers
+ *  of the detected adjacent and border edges. The time includes
+ *  the generation of the shape, which some shapes do when they are
+ *  constructed and others when their attributes are first queried.
+ *  The subdivision level of the sphere can be specified on the command
+ *  line:
+ *  @code
+ *  ./001_shape_analyzer_bench 10
+ *  @endcode
+ *
+ *  Copyright 2008-2013 Matus Chochlik. Distributed under the Boost
+ *  Software License, Version 1.0. (See accompanying file
+ *  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ *
+ */
+#include <cassert>
+#include <cstdlib>
+#include <iostream>
+#include <chrono>
+
+#include <oglplus/gl.hpp>
+
+#include <oglplus/shapes/analyzer.hpp>
+#include <oglplus/shapes/subdiv_sphere.hpp>
+#include <oglplus/shapes/plane.hpp>
+
+template <typename MakeShape>
+void benchmark(const char* name, MakeShape make_shape)
+{
+	typedef std::chrono::steady_clock clock;
+	const clock::time_point start = clock::now();
+
+	auto builder = make_shape();
+	const clock::time_point made = clock::now();
+
+	oglplus::shapes::ShapeAnalyzer analyzer(builder);
+
+	const std::chrono::duration<double> make_time = made - start;
+	const std::chrono::duration<double> time = clock::now() - start;
+
+	GLuint edges = 0, adjacent = 0, smooth = 0;
+	for(GLuint f=0; f!=analyzer.FaceCount(); ++f)
+	{
+		auto face = analyzer.Face(f);
+		for(GLuint e=0; e!=face.Arity(); ++e)
+		{
+			auto edge = face.Edge(e);
+			++edges;
+			if(edge.HasAdjacentEdge()) ++adjacent;
+			if(edge.IsSmoothEdge()) ++smooth;
+		}
+	}
+
+	std::cout
+		<< name << ": "
+		<< analyzer.FaceCount() << " faces, "
+		<< edges << " edges ("
+		<< adjacent << " adjacent, "
+		<< edges - adjacent << " border, "
+		<< smooth << " smooth) in "
+		<< time.count() << " s ("
+		<< make_time.count() << " s construction)"
+		<< std::endl;
+}
+
+int main(int argc, char* argv[])
+{
+	try
+	{
+		using namespace oglplus;
+
+		const GLuint subdivs = (argc > 1)?GLuint(std::atoi(argv[1])):9;
+
+		benchmark(
+			"SimpleSubdivSphere",
+			[subdivs](void)
+			{
+				return shapes::SimpleSubdivSphere(subdivs);
+			}
+		);
+		// a plane with a comparable number of triangles
+		benchmark(
+			"Plane",
+			[subdivs](void)
+			{
+				const unsigned n = 1u << (subdivs+1);
+				return shapes::Plane(n, n);
+			}
+		);
+		return 0;
+	}
+	catch(std::exception& err)
+	{
+		std::cerr << "Error: " << err.what() << std::endl;
+	}
+	return 1;
+}
@@ -1514,6 +1514,11 @@ template <typename Enum, Enum = Enum::Int> operator Enum (void) const{ return En
 template <typename Enum> friend bool operator==(Enum value, Int){ return value == Enum::Int; }
 template <typename Enum> friend bool operator!=(Enum value, Int){ return value != Enum::Int; }
 };
+struct Int_2_10_10_10_Rev {
+template <typename Enum, Enum = Enum::Int_2_10_10_10_Rev> operator Enum (void) const{ return Enum::Int_2_10_10_10_Rev; }
+template <typename Enum> friend bool operator==(Enum value, Int_2_10_10_10_Rev){ return value == Enum::Int_2_10_10_10_Rev; }
+template <typename Enum> friend bool operator!=(Enum value, Int_2_10_10_10_Rev){ return value != Enum::Int_2_10_10_10_Rev; }
+};
 struct Intensity {
 template <typename Enum, Enum = Enum::Intensity> operator Enum (void) const{ return Enum::Intensity; }
 template <typename Enum> friend bool operator==(Enum value, Intensity){ return value == Enum::Intensity; }
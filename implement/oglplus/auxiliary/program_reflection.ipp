@@ -0,0 +1,360 @@
+/**
+ *  @file oglplus/auxiliary/program_reflection.ipp
+ *  @brief Implementation of the program reflection cache
+ *
+ *  @author Matus Chochlik
+ *
+ *  Copyright 2010-2013 Matus Chochlik. Distributed under the Boost
+ *  Software License, Version 1.0. (See accompanying file
+ *  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ */
+
+#include <oglplus/state_cache.hpp>
+
+namespace oglplus {
+namespace aux {
+
+OGLPLUS_LIB_FUNC
+void ProgramReflectionTable::Reserve(std::size_t count)
+{
+	// keep the load factor at most 1/2
+	std::size_t capacity = 8;
+	while(capacity < 2*count) capacity *= 2;
+	_slot empty = { 0, 0, 0, { -1, GL_NONE, 0, -1 } };
+	_slots.assign(capacity, empty);
+	_names.clear();
+	_size = 0;
+}
+
+OGLPLUS_LIB_FUNC
+bool ProgramReflectionTable::Insert(
+	const GLchar* name,
+	std::size_t len,
+	const ProgramReflectionEntry& entry
+)
+{
+	assert(len != 0);
+	if(2*(_size+1) > _slots.size())
+	{
+		// rehash the current entries into a bigger table
+		ProgramReflectionTable bigger;
+		bigger.Reserve(2*(_size+1));
+		for(auto i=_slots.begin(), e=_slots.end(); i!=e; ++i)
+		{
+			if(i->name_len == 0) continue;
+			bigger.Insert(
+				_names.data()+i->name_pos,
+				i->name_len,
+				i->entry
+			);
+		}
+		std::swap(_slots, bigger._slots);
+		std::swap(_names, bigger._names);
+	}
+
+	const std::size_t mask = _slots.size()-1;
+	const std::size_t hash = _hash(name, len);
+	std::size_t pos = hash & mask;
+	while(_slots[pos].name_len != 0)
+	{
+		if(_matches(_slots[pos], hash, name, len)) return false;
+		pos = (pos + 1) & mask;
+	}
+	_slot& slot = _slots[pos];
+	slot.hash = hash;
+	slot.name_pos = _names.size();
+	slot.name_len = len;
+	slot.entry = entry;
+	_names.insert(_names.end(), name, name+len);
+	++_size;
+	return true;
+}
+
+OGLPLUS_LIB_FUNC
+const ProgramReflectionEntry* ProgramReflectionTable::Find(
+	const GLchar* name,
+	std::size_t len
+) const
+{
+	if(_slots.empty() || (len == 0)) return nullptr;
+	const std::size_t mask = _slots.size()-1;
+	const std::size_t hash = _hash(name, len);
+	std::size_t pos = hash & mask;
+	while(_slots[pos].name_len != 0)
+	{
+		if(_matches(_slots[pos], hash, name, len))
+			return &_slots[pos].entry;
+		pos = (pos + 1) & mask;
+	}
+	return nullptr;
+}
+
+OGLPLUS_LIB_FUNC
+ProgramReflection::_registry_map& ProgramReflection::_registry(void)
+{
+	static _registry_map _reflections;
+	return _reflections;
+}
+
+OGLPLUS_LIB_FUNC
+bool ProgramReflection::_make_key(GLuint program, _key& key)
+{
+	StateCache* context = StateCache::Current();
+	if(!context) return false;
+	key = _key(context->Id(), program);
+	return true;
+}
+
+#if !OGLPLUS_NO_THREADS
+OGLPLUS_LIB_FUNC
+std::mutex& ProgramReflection::_mutex(void)
+{
+	static std::mutex _registry_mutex;
+	return _registry_mutex;
+}
+
+# define OGLPLUS_PROGRAM_REFLECTION_LOCK \
+	std::lock_guard<std::mutex> _lock(_mutex());
+#else
+# define OGLPLUS_PROGRAM_REFLECTION_LOCK
+#endif
+
+OGLPLUS_LIB_FUNC
+void ProgramReflection::_init_uniforms(GLuint program)
+{
+	GLint active_uniforms = 0;
+	OGLPLUS_GLFUNC(GetProgramiv)(
+		program,
+		GL_ACTIVE_UNIFORMS,
+		&active_uniforms
+	);
+	OGLPLUS_VERIFY(OGLPLUS_ERROR_INFO(GetProgramiv));
+
+	GLint max_length = 0;
+	OGLPLUS_GLFUNC(GetProgramiv)(
+		program,
+		GL_ACTIVE_UNIFORM_MAX_LENGTH,
+		&max_length
+	);
+	OGLPLUS_VERIFY(OGLPLUS_ERROR_INFO(GetProgramiv));
+
+	// the arrays are registered also under their base name
+	_uniforms.Reserve(2*active_uniforms);
+	if(active_uniforms <= 0) return;
+
+	std::vector<GLint> block_indices(active_uniforms, -1);
+#if GL_VERSION_3_1 || GL_ARB_uniform_buffer_object
+	std::vector<GLuint> indices(active_uniforms);
+	for(GLint index=0; index!=active_uniforms; ++index)
+		indices[index] = GLuint(index);
+	OGLPLUS_GLFUNC(GetActiveUniformsiv)(
+		program,
+		active_uniforms,
+		indices.data(),
+		GL_UNIFORM_BLOCK_INDEX,
+		block_indices.data()
+	);
+	OGLPLUS_VERIFY(OGLPLUS_ERROR_INFO(GetActiveUniformsiv));
+#endif
+
+	std::vector<GLchar> buffer(max_length+1);
+	for(GLint index=0; index!=active_uniforms; ++index)
+	{
+		GLsizei length = 0;
+		ProgramReflectionEntry entry = { -1, GL_NONE, 0, -1 };
+		OGLPLUS_GLFUNC(GetActiveUniform)(
+			program,
+			GLuint(index),
+			GLsizei(buffer.size()),
+			&length,
+			&entry.size,
+			&entry.type,
+			buffer.data()
+		);
+		OGLPLUS_VERIFY(OGLPLUS_ERROR_INFO(GetActiveUniform));
+		if(length <= 0) continue;
+		buffer[length] = '\0';
+
+		entry.block_index = block_indices[index];
+		// the uniforms in blocks do not have a location
+		if(entry.block_index < 0)
+		{
+			entry.location = OGLPLUS_GLFUNC(GetUniformLocation)(
+				program,
+				buffer.data()
+			);
+			OGLPLUS_VERIFY(OGLPLUS_ERROR_INFO(GetUniformLocation));
+		}
+		_uniforms.Insert(buffer.data(), length, entry);
+
+		// the name of an array is reported as "name[0]"
+		if((length > 3) && (std::strcmp(buffer.data()+length-3, "[0]") == 0))
+			_uniforms.Insert(buffer.data(), length-3, entry);
+	}
+}
+
+OGLPLUS_LIB_FUNC
+void ProgramReflection::_init_blocks(GLuint program)
+{
+#if GL_VERSION_3_1 || GL_ARB_uniform_buffer_object
+	GLint active_blocks = 0;
+	OGLPLUS_GLFUNC(GetProgramiv)(
+		program,
+		GL_ACTIVE_UNIFORM_BLOCKS,
+		&active_blocks
+	);
+	OGLPLUS_VERIFY(OGLPLUS_ERROR_INFO(GetProgramiv));
+
+	GLint max_length = 0;
+	OGLPLUS_GLFUNC(GetProgramiv)(
+		program,
+		GL_ACTIVE_UNIFORM_BLOCK_MAX_NAME_LENGTH,
+		&max_length
+	);
+	OGLPLUS_VERIFY(OGLPLUS_ERROR_INFO(GetProgramiv));
+
+	_blocks.Reserve(active_blocks);
+	std::vector<GLchar> buffer(max_length+1);
+	for(GLint index=0; index<active_blocks; ++index)
+	{
+		GLsizei length = 0;
+		OGLPLUS_GLFUNC(GetActiveUniformBlockName)(
+			program,
+			GLuint(index),
+			GLsizei(buffer.size()),
+			&length,
+			buffer.data()
+		);
+		OGLPLUS_VERIFY(OGLPLUS_ERROR_INFO(GetActiveUniformBlockName));
+		if(length <= 0) continue;
+		ProgramReflectionEntry entry = { index, GL_NONE, 1, index };
+		_blocks.Insert(buffer.data(), length, entry);
+	}
+#else
+	OGLPLUS_FAKE_USE(program);
+#endif
+}
+
+OGLPLUS_LIB_FUNC
+bool ProgramReflection::_init(GLuint program)
+{
+	// the program must be linked to have active uniforms
+	GLint status = GL_FALSE;
+	OGLPLUS_GLFUNC(GetProgramiv)(program, GL_LINK_STATUS, &status);
+	OGLPLUS_CHECK(OGLPLUS_ERROR_INFO(GetProgramiv));
+	if(status != GL_TRUE) return false;
+
+	_init_uniforms(program);
+	_init_blocks(program);
+	return true;
+}
+
+OGLPLUS_LIB_FUNC
+const ProgramReflection* ProgramReflection::_get(GLuint program)
+{
+	_key key;
+	if(!_make_key(program, key)) return nullptr;
+	auto pos = _registry().find(key);
+	if(pos != _registry().end()) return &pos->second;
+
+	ProgramReflection& reflection = _registry()[key];
+	try
+	{
+		if(reflection._init(program)) return &reflection;
+	}
+	catch(...)
+	{
+		_registry().erase(key);
+		throw;
+	}
+	_registry().erase(key);
+	return nullptr;
+}
+
+OGLPLUS_LIB_FUNC
+bool ProgramReflection::FindUniform(
+	GLuint program,
+	const GLchar* identifier,
+	ProgramReflectionEntry& entry
+)
+{
+	OGLPLUS_PROGRAM_REFLECTION_LOCK
+	const ProgramReflection* reflection = _get(program);
+	if(!reflection) return false;
+	auto result = reflection->_uniforms.Find(
+		identifier,
+		std::strlen(identifier)
+	);
+	if(!result) return false;
+	entry = *result;
+	return true;
+}
+
+OGLPLUS_LIB_FUNC
+bool ProgramReflection::FindUniformOrArray(
+	GLuint program,
+	const GLchar* identifier,
+	ProgramReflectionEntry& entry
+)
+{
+	OGLPLUS_PROGRAM_REFLECTION_LOCK
+	// without a current StateCache the data are gathered
+	// for this lookup only
+	ProgramReflection uncached;
+	const ProgramReflection* reflection = _get(program);
+	if(!reflection && !StateCache::Current() && uncached._init(program))
+		reflection = &uncached;
+	if(!reflection) return false;
+	std::size_t length = std::strlen(identifier);
+	auto result = reflection->_uniforms.Find(identifier, length);
+
+	// try the array if the identifier is an element "name[N]"
+	if(!result && (length >= 4) && (identifier[length-1] == ']'))
+	{
+		std::size_t pos = length-1;
+		while(pos != 0)
+		{
+			const GLchar c = identifier[pos-1];
+			if((c < '0') || (c > '9')) break;
+			--pos;
+		}
+		if((pos > 1) && (pos != length-1) && (identifier[pos-1] == '['))
+			result = reflection->_uniforms.Find(identifier, pos-1);
+	}
+	if(!result) return false;
+	entry = *result;
+	return true;
+}
+
+OGLPLUS_LIB_FUNC
+bool ProgramReflection::FindUniformBlock(
+	GLuint program,
+	const GLchar* identifier,
+	ProgramReflectionEntry& entry
+)
+{
+	OGLPLUS_PROGRAM_REFLECTION_LOCK
+	const ProgramReflection* reflection = _get(program);
+	if(!reflection) return false;
+	auto result = reflection->_blocks.Find(
+		identifier,
+		std::strlen(identifier)
+	);
+	if(!result) return false;
+	entry = *result;
+	return true;
+}
+
+OGLPLUS_LIB_FUNC
+void ProgramReflection::Invalidate(GLuint program)
+{
+	OGLPLUS_PROGRAM_REFLECTION_LOCK
+	_key key;
+	if(_make_key(program, key)) _registry().erase(key);
+}
+
+#undef OGLPLUS_PROGRAM_REFLECTION_LOCK
+
+} // namespace aux
+} // namespace oglplus
+
@@ -22,50 +22,10 @@ GLenum UniformTypecheckBase::_query_uniform_type(
 	const GLchar* identifier
 )
 {
-	GLenum type, result = GL_NONE;
-	GLint size;
-	GLsizei length = 0;
-	const GLsizei id_len = std::strlen(identifier);
-	// The +2 is intentional
-	// to distinguish between the searched identifier
-	// and the udentifiers having the searched identifier
-	// as prefix
-	std::vector<GLchar> buffer(id_len+2);
-
-	GLint active_uniforms = 0;
-	OGLPLUS_GLFUNC(GetProgramiv)(
-		program,
-		GL_ACTIVE_UNIFORMS,
-		&active_uniforms
-	);
-	OGLPLUS_VERIFY(OGLPLUS_ERROR_INFO(GetProgramiv));
-
-	for(GLint index=0; index!=active_uniforms; ++index)
-	{
-		OGLPLUS_GLFUNC(GetActiveUniform)(
-			program,
-			index,
-			buffer.size(),
-			&length,
-			&size,
-			&type,
-			buffer.data()
-		);
-		OGLPLUS_VERIFY(OGLPLUS_ERROR_INFO(GetActiveUniform));
-		if(id_len == length)
-		{
-			if(std::strncmp(
-				identifier,
-				buffer.data(),
-				length
-			) == 0)
-			{
-				result = type;
-				break;
-			}
-		}
-	}
-	return result;
+	ProgramReflectionEntry entry;
+	if(!ProgramReflection::FindUniformOrArray(program, identifier, entry))
+		return GL_NONE;
+	return entry.type;
 }
 
 OGLPLUS_LIB_FUNC
@@ -49,6 +49,12 @@ switch(value)
 #endif
 #if defined GL_UNSIGNED_INT
 	case GL_UNSIGNED_INT: return StrLit("UNSIGNED_INT");
+#endif
+#if defined GL_INT_2_10_10_10_REV
+	case GL_INT_2_10_10_10_REV: return StrLit("INT_2_10_10_10_REV");
+#endif
+#if defined GL_UNSIGNED_INT_2_10_10_10_REV
+	case GL_UNSIGNED_INT_2_10_10_10_REV: return StrLit("UNSIGNED_INT_2_10_10_10_REV");
 #endif
 	default:;
 }
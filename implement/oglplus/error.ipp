@@ -195,5 +195,101 @@ void HandleError(GLenum code, const ErrorInfo& info, bool assertion)
 	throw Error(code, msg, info, assertion);
 }
 
+#if OGLPLUS_DEFERRED_ERROR_CHECKS
+
+namespace aux {
+
+OGLPLUS_LIB_FUNC
+DeferredErrorHistory& _deferred_errors(void)
+{
+	// each thread has its own current context and its own error flags
+	static OGLPLUS_THREAD_LOCAL DeferredErrorHistory _history;
+	return _history;
+}
+
+OGLPLUS_LIB_FUNC
+const char* _deferred_error_name(GLenum error_code)
+{
+	switch(error_code)
+	{
+		case GL_OUT_OF_MEMORY: return "OUT_OF_MEMORY";
+		case GL_INVALID_ENUM: return "INVALID_ENUM";
+		case GL_INVALID_VALUE: return "INVALID_VALUE";
+		case GL_INVALID_OPERATION: return "INVALID_OPERATION";
+		case GL_INVALID_FRAMEBUFFER_OPERATION:
+			return "INVALID_FRAMEBUFFER_OPERATION";
+#ifdef GL_STACK_OVERFLOW
+		case GL_STACK_OVERFLOW: return "STACK_OVERFLOW";
+#endif
+#ifdef GL_STACK_UNDERFLOW
+		case GL_STACK_UNDERFLOW: return "STACK_UNDERFLOW";
+#endif
+#ifdef GL_TABLE_TOO_LARGE
+		case GL_TABLE_TOO_LARGE: return "TABLE_TOO_LARGE";
+#endif
+	}
+	return "UNKNOWN_ERROR";
+}
+
+} // namespace aux
+
+OGLPLUS_LIB_FUNC
+void CheckDeferredErrors(void)
+{
+	GLenum error_code = ::glGetError();
+	aux::DeferredErrorHistory& history = aux::_deferred_errors();
+	if(error_code == GL_NO_ERROR)
+	{
+		history.Clear();
+		return;
+	}
+
+	// GL keeps a separate flag for each kind of error, all of them
+	// must be cleared, otherwise the next checkpoint would blame them
+	// on unrelated calls. The number of iterations is limited in case
+	// the implementation keeps reporting an error (i.e. a lost context)
+	String other_errors;
+	for(std::size_t i=0; i!=16; ++i)
+	{
+		GLenum other_code = ::glGetError();
+		if(other_code == GL_NO_ERROR) break;
+		if(!other_errors.empty()) other_errors.append(", ");
+		other_errors.append(aux::_deferred_error_name(other_code));
+	}
+
+	// prefer the calls that may fail due to run-time parameters
+	std::size_t likely = 0;
+	while((likely != history.Size()) && history.Assertion(likely))
+		++likely;
+	if(likely == history.Size()) likely = 0;
+
+	const bool remembered = (history.Size() != 0);
+	const ErrorInfo info = remembered?
+		history.Info(likely):
+		OGLPLUS_ERROR_INFO(GetError);
+	const bool assertion = remembered && history.Assertion(likely);
+
+	String calls;
+	if(history.Total() > history.Size()) calls.append("..., ");
+	for(std::size_t age=history.Size(); age!=0; --age)
+	{
+		calls.append(ErrorGLSymbol(history.Info(age-1)));
+		if(age != 1) calls.append(", ");
+	}
+	history.Clear();
+
+	try { HandleError(error_code, info, assertion); }
+	catch(Error& error)
+	{
+		if(!calls.empty())
+			error.SetPropertyValue("DeferredCalls", calls);
+		if(!other_errors.empty())
+			error.SetPropertyValue("DeferredErrors", other_errors);
+		throw;
+	}
+}
+
+#endif // OGLPLUS_DEFERRED_ERROR_CHECKS
+
 } // namespace oglplus
 
@@ -0,0 +1,133 @@
+/**
+ *  @file oglplus/program_build.ipp
+ *  @brief Implementation of ProgramBuildQueue
+ *
+ *  @author Matus Chochlik
+ *
+ *  Copyright 2010-2013 Matus Chochlik. Distributed under the Boost
+ *  Software License, Version 1.0. (See accompanying file
+ *  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ */
+
+namespace oglplus {
+
+OGLPLUS_LIB_FUNC
+bool ProgramBuildQueue::_use_parallel(bool allow_parallel)
+{
+#if GL_KHR_parallel_shader_compile || !OGLPLUS_USE_GLEW
+	return allow_parallel && KHR_parallel_shader_compile::Available();
+#else
+	OGLPLUS_FAKE_USE(allow_parallel);
+	return false;
+#endif
+}
+
+OGLPLUS_LIB_FUNC
+ProgramBuildHandle ProgramBuildQueue::Add(
+	const ProgramOps& program,
+	const ProgramSource& source
+)
+{
+	_build build;
+	build.program = &program;
+	build.status = _building;
+	build.failed_shader = 0;
+	build.shaders.reserve(source._shaders.size());
+
+	auto sb = source._shaders.begin(), se = source._shaders.end();
+	for(auto i=sb; i!=se; ++i)
+	{
+		build.shaders.push_back(Shader(i->type));
+		build.shaders.back().Source(i->source).CompileAsync();
+		program.AttachShader(build.shaders.back());
+	}
+	source._prepare_link(program);
+	program.LinkAsync();
+
+	_builds.push_back(std::move(build));
+	++_unfinished;
+	return ProgramBuildHandle(*this, _builds.size()-1);
+}
+
+OGLPLUS_LIB_FUNC
+void ProgramBuildQueue::_finish(_build& build)
+{
+	assert(build.status == _building);
+	if(build.program->IsLinked())
+	{
+		build.status = _linked;
+		// the shaders are not needed anymore after linking
+		auto b = build.shaders.begin(), e = build.shaders.end();
+		for(auto i=b; i!=e; ++i)
+			build.program->DetachShader(*i);
+		build.shaders.clear();
+	}
+	else
+	{
+		build.status = _link_failed;
+		for(std::size_t i=0, n=build.shaders.size(); i!=n; ++i)
+		{
+			if(!build.shaders[i].IsCompiled())
+			{
+				build.status = _compile_failed;
+				build.failed_shader = i;
+				break;
+			}
+		}
+	}
+	assert(_unfinished > 0);
+	--_unfinished;
+}
+
+OGLPLUS_LIB_FUNC
+bool ProgramBuildQueue::_finished(_build& build, bool wait)
+{
+	if(build.status != _building) return true;
+	if(!wait && !build.program->CompletionStatus()) return false;
+	_finish(build);
+	return true;
+}
+
+OGLPLUS_LIB_FUNC
+void ProgramBuildQueue::_wait(std::size_t index)
+{
+	assert(index < _builds.size());
+	_build& build = _builds[index];
+	_finished(build, true);
+	if(build.status == _compile_failed)
+	{
+		assert(build.failed_shader < build.shaders.size());
+		build.shaders[build.failed_shader].HandleCompileError();
+	}
+	else if(build.status == _link_failed)
+	{
+		build.program->HandleLinkError();
+	}
+}
+
+OGLPLUS_LIB_FUNC
+std::size_t ProgramBuildQueue::Poll(void)
+{
+	for(auto i=_builds.begin(), e=_builds.end(); i!=e; ++i)
+	{
+		if(_unfinished == 0) break;
+		if(i->status != _building) continue;
+		_finished(*i, !_parallel);
+		// without the completion status queries only the oldest
+		// unfinished build is waited for in each call
+		if(!_parallel) break;
+	}
+	return _unfinished;
+}
+
+OGLPLUS_LIB_FUNC
+void ProgramBuildQueue::Finish(void)
+{
+	for(auto i=_builds.begin(), e=_builds.end(); i!=e; ++i)
+	{
+		if(_unfinished == 0) break;
+		_finished(*i, true);
+	}
+}
+
+} // namespace oglplus
@@ -0,0 +1,302 @@
+/**
+ *  @file oglplus/program_cache.ipp
+ *  @brief Implementation of ProgramCache
+ *
+ *  @author Matus Chochlik
+ *
+ *  Copyright 2010-2013 Matus Chochlik. Distributed under the Boost
+ *  Software License, Version 1.0. (See accompanying file
+ *  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ */
+
+#include <oglplus/auxiliary/filesystem.hpp>
+
+#include <fstream>
+#include <cstdio>
+#include <cstring>
+
+#if defined(WIN32) || defined(_WIN32) || defined(WIN64) || defined(_WIN64)
+#include <process.h>
+#else
+#include <unistd.h>
+#endif
+
+#if !OGLPLUS_NO_THREADS
+#include <atomic>
+#endif
+
+namespace oglplus {
+
+#if OGLPLUS_DOCUMENTATION_ONLY || GL_VERSION_4_1 || GL_ARB_get_program_binary
+
+namespace aux {
+
+// identifies the cache files and their layout
+inline const char* ProgramCacheMagic(void)
+{
+	return "OGLPLUSPRGBIN001";
+}
+
+// makes a suffix of temporary file names unique for the process and call
+inline String ProgramCacheTempSuffix(void)
+{
+#if !OGLPLUS_NO_THREADS
+	static std::atomic<unsigned long> counter(0);
+#else
+	static unsigned long counter = 0;
+#endif
+#if defined(WIN32) || defined(_WIN32) || defined(WIN64) || defined(_WIN64)
+	const unsigned long pid = static_cast<unsigned long>(::_getpid());
+#else
+	const unsigned long pid = static_cast<unsigned long>(::getpid());
+#endif
+	char suffix[48];
+	std::sprintf(suffix, ".%lu-%lu.tmp", pid, ++counter);
+	return String(suffix);
+}
+
+} // namespace aux
+
+OGLPLUS_LIB_FUNC
+void ProgramCache::_init_driver(void)
+{
+	if(_driver_initialized) return;
+
+	GLint formats = 0;
+	OGLPLUS_GLFUNC(GetIntegerv)(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+	OGLPLUS_VERIFY(OGLPLUS_ERROR_INFO(GetIntegerv));
+	_binaries_supported = (formats > 0);
+
+	const GLenum queries[3] = {GL_VENDOR, GL_RENDERER, GL_VERSION};
+	for(std::size_t i=0; i!=3; ++i)
+	{
+		const GLubyte* str = OGLPLUS_GLFUNC(GetString)(queries[i]);
+		OGLPLUS_VERIFY(OGLPLUS_ERROR_INFO(GetString));
+		if(str) _driver.append(reinterpret_cast<const char*>(str));
+		_driver.push_back('\n');
+	}
+	_driver_initialized = true;
+}
+
+OGLPLUS_LIB_FUNC
+unsigned long long ProgramCache::_key(const ProgramSource& source) const
+{
+	aux::ProgramCacheHash hash;
+	hash.Add(_driver);
+
+	hash.Add(GLuint(source._shaders.size()));
+	auto sb = source._shaders.begin(), se = source._shaders.end();
+	for(auto i=sb; i!=se; ++i)
+	{
+		hash.Add(GLuint(GLenum(i->type)));
+		hash.Add(i->source);
+	}
+
+	hash.Add(GLuint(source._attrib_locations.size()));
+	auto ab = source._attrib_locations.begin();
+	auto ae = source._attrib_locations.end();
+	for(auto i=ab; i!=ae; ++i)
+	{
+		hash.Add(i->first);
+		hash.Add(i->second);
+	}
+
+	hash.Add(GLuint(source._varyings.size()));
+	auto vb = source._varyings.begin(), ve = source._varyings.end();
+	for(auto i=vb; i!=ve; ++i)
+		hash.Add(*i);
+	hash.Add(GLuint(GLenum(source._varyings_mode)));
+
+	hash.Add(GLuint(source._separable?1:0));
+	return hash.Value();
+}
+
+OGLPLUS_LIB_FUNC
+String ProgramCache::_path(unsigned long long key) const
+{
+	char name[32];
+	std::sprintf(name, "program-%016llx.bin", key);
+	String result(_directory);
+	if(!result.empty()) result.append(aux::FilesysPathSep());
+	result.append(name);
+	return result;
+}
+
+OGLPLUS_LIB_FUNC
+bool ProgramCache::_read(
+	const String& path,
+	unsigned long long key,
+	std::vector<GLubyte>& binary,
+	GLenum& format
+)
+{
+	std::ifstream file(path.c_str(), std::ios::in | std::ios::binary);
+	if(!file.good()) return false;
+
+	const char* magic = aux::ProgramCacheMagic();
+	const std::size_t magic_len = std::strlen(magic);
+	char file_magic[32] = {'\0'};
+	unsigned long long file_key = 0;
+	GLuint size = 0;
+
+	file.read(file_magic, magic_len);
+	file.read(reinterpret_cast<char*>(&file_key), sizeof(file_key));
+	file.read(reinterpret_cast<char*>(&format), sizeof(format));
+	file.read(reinterpret_cast<char*>(&size), sizeof(size));
+	if(!file.good()) return false;
+	if(std::strncmp(file_magic, magic, magic_len) != 0) return false;
+	if((file_key != key) || (size == 0)) return false;
+
+	binary.resize(size);
+	file.read(reinterpret_cast<char*>(binary.data()), size);
+	return file.gcount() == std::streamsize(size);
+}
+
+OGLPLUS_LIB_FUNC
+void ProgramCache::_write(
+	const String& path,
+	unsigned long long key,
+	const std::vector<GLubyte>& binary,
+	GLenum format
+)
+{
+	// write a temporary file first so that a partially written
+	// file is never read by a concurrently running application,
+	// the name of the file is unique so that the applications
+	// (or threads) building the same program do not share it
+	const String tmp_path = path + aux::ProgramCacheTempSuffix();
+	{
+		std::ofstream file(
+			tmp_path.c_str(),
+			std::ios::out | std::ios::binary | std::ios::trunc
+		);
+		if(!file.good()) return;
+
+		const char* magic = aux::ProgramCacheMagic();
+		const GLuint size = GLuint(binary.size());
+		file.write(magic, std::strlen(magic));
+		file.write(reinterpret_cast<const char*>(&key), sizeof(key));
+		file.write(reinterpret_cast<const char*>(&format), sizeof(format));
+		file.write(reinterpret_cast<const char*>(&size), sizeof(size));
+		file.write(
+			reinterpret_cast<const char*>(binary.data()),
+			std::streamsize(size)
+		);
+		file.close();
+		if(file.fail())
+		{
+			std::remove(tmp_path.c_str());
+			return;
+		}
+	}
+	std::remove(path.c_str());
+	if(std::rename(tmp_path.c_str(), path.c_str()) != 0)
+		std::remove(tmp_path.c_str());
+}
+
+OGLPLUS_LIB_FUNC
+bool ProgramCache::_load(
+	const ProgramOps& program,
+	const ProgramSource& source,
+	const String& path,
+	unsigned long long key
+)
+{
+	std::vector<GLubyte> binary;
+	GLenum format = GL_NONE;
+	if(!_read(path, key, binary, format)) return false;
+
+#if GL_VERSION_4_1 || GL_ARB_separate_shader_objects
+	if(source._separable) program.MakeSeparable();
+#endif
+	program.MakeRetrievable();
+
+	// an unsupported format (INVALID_ENUM) or a rejected binary
+	// are expected here so the error is checked explicitly instead
+	// of going through the (possibly deferred) error handling
+#if OGLPLUS_DEFERRED_ERROR_CHECKS
+	// the errors of the preceding calls must not be taken for
+	// the error of ProgramBinary
+	CheckDeferredErrors();
+#endif
+	const GLuint name = FriendOf<ProgramOps>::GetName(program);
+	aux::ProgramReflection::Invalidate(name);
+	OGLPLUS_GLFUNC(ProgramBinary)(
+		name,
+		format,
+		binary.data(),
+		GLsizei(binary.size())
+	);
+	const GLenum error = OGLPLUS_GLFUNC(GetError)();
+	const bool loaded = (error == GL_NO_ERROR) && program.IsLinked();
+	if(!loaded)
+	{
+		++_rejected;
+		std::remove(path.c_str());
+	}
+	return loaded;
+}
+
+OGLPLUS_LIB_FUNC
+void ProgramCache::_build(const ProgramOps& program, const ProgramSource& src)
+{
+	std::vector<Shader> shaders;
+	shaders.reserve(src._shaders.size());
+	auto sb = src._shaders.begin(), se = src._shaders.end();
+	for(auto i=sb; i!=se; ++i)
+	{
+		shaders.push_back(Shader(i->type));
+		shaders.back().Source(i->source).Compile();
+		program.AttachShader(shaders.back());
+	}
+
+	src._prepare_link(program);
+	program.MakeRetrievable();
+	program.Link();
+
+	// the shaders are not needed anymore after linking
+	for(auto i=shaders.begin(), e=shaders.end(); i!=e; ++i)
+		program.DetachShader(*i);
+}
+
+OGLPLUS_LIB_FUNC
+bool ProgramCache::Build(const ProgramOps& program, const ProgramSource& source)
+{
+	_init_driver();
+	const unsigned long long key = _key(source);
+	const String path = _path(key);
+
+	if(_binaries_supported && _load(program, source, path, key))
+	{
+		++_hits;
+		return true;
+	}
+	++_misses;
+	_build(program, source);
+
+	if(_binaries_supported)
+	{
+		std::vector<GLubyte> binary;
+		GLenum format = GL_NONE;
+		program.GetBinary(binary, format);
+		if(!binary.empty()) _write(path, key, binary, format);
+	}
+	return false;
+}
+
+OGLPLUS_LIB_FUNC
+void ProgramCache::Forget(const ProgramSource& source)
+{
+	std::remove(Path(source).c_str());
+}
+
+OGLPLUS_LIB_FUNC
+String ProgramCache::Path(const ProgramSource& source)
+{
+	_init_driver();
+	return _path(_key(source));
+}
+
+#endif // get program binary
+
+} // namespace oglplus
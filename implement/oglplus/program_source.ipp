@@ -0,0 +1,54 @@
+/**
+ *  @file oglplus/program_source.ipp
+ *  @brief Implementation of ProgramSource
+ *
+ *  @author Matus Chochlik
+ *
+ *  Copyright 2010-2013 Matus Chochlik. Distributed under the Boost
+ *  Software License, Version 1.0. (See accompanying file
+ *  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ */
+
+namespace oglplus {
+
+OGLPLUS_LIB_FUNC
+ProgramSource& ProgramSource::AddShader(
+	ShaderType type,
+	const GLSLSource& source
+)
+{
+	String str;
+	const GLchar** parts = source.Parts();
+	const GLint* lengths = source.Lengths();
+	for(GLsizei i=0, n=source.Count(); i!=n; ++i)
+	{
+		if(lengths && (lengths[i] >= 0))
+			str.append(parts[i], std::size_t(lengths[i]));
+		else str.append(parts[i]);
+	}
+	return AddShader(type, std::move(str));
+}
+
+OGLPLUS_LIB_FUNC
+void ProgramSource::_prepare_link(const ProgramOps& program) const
+{
+	auto ab = _attrib_locations.begin(), ae = _attrib_locations.end();
+	for(auto i=ab; i!=ae; ++i)
+	{
+		OGLPLUS_GLFUNC(BindAttribLocation)(
+			FriendOf<ProgramOps>::GetName(program),
+			i->first,
+			i->second.c_str()
+		);
+		OGLPLUS_CHECK(OGLPLUS_ERROR_INFO(BindAttribLocation));
+	}
+
+	if(!_varyings.empty())
+		program.TransformFeedbackVaryings(_varyings, _varyings_mode);
+
+#if GL_VERSION_4_1 || GL_ARB_separate_shader_objects
+	if(_separable) program.MakeSeparable();
+#endif
+}
+
+} // namespace oglplus
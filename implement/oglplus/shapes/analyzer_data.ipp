@@ -1,5 +1,5 @@
 /**
- *  @file oglplus/shapes/analyzer_graph.ipp
+ *  @file oglplus/shapes/analyzer_data.ipp
  *  @brief Implementation of shapes::ShapeAnalyzerGraphData
  *
  *  @author Matus Chochlik
@@ -11,8 +11,42 @@
 
 #include <cassert>
 #include <cmath>
+#include <cstdint>
+#include <utility>
 
 namespace oglplus {
+namespace aux {
+
+// Returns a power of two size of a hash table for count elements
+inline std::size_t AnalyzerHashTableSize(std::size_t count)
+{
+	std::size_t size = 16;
+	while(size < count*2) size *= 2;
+	return size;
+}
+
+// Mixes the bits of a 64-bit hash key
+inline std::size_t AnalyzerHashKey(std::uint64_t k)
+{
+	k ^= k >> 33;
+	k *= 0xFF51AFD7ED558CCDULL;
+	k ^= k >> 33;
+	k *= 0xC4CEB9FE1A85EC53ULL;
+	k ^= k >> 33;
+	return std::size_t(k);
+}
+
+// Returns the hash of the coordinates of a cell of a 3D grid
+inline std::size_t AnalyzerHashCell(const std::int64_t* cell)
+{
+	std::uint64_t k = std::uint64_t(cell[0]);
+	k = k*0x9E3779B97F4A7C15ULL + std::uint64_t(cell[1]);
+	k = k*0x9E3779B97F4A7C15ULL + std::uint64_t(cell[2]);
+	return AnalyzerHashKey(k);
+}
+
+} // namespace aux
+
 namespace shapes {
 
 OGLPLUS_LIB_FUNC
@@ -274,6 +308,9 @@ _init_dr_el_triangle_strip(const DrawOperation& draw_op)
 			continue;
 		}
 
+		// the winding alternates from the start of each strip
+		const GLuint strip_start = i;
+
 		_face_index.push_back(_face_verts.size());
 		_face_phase.push_back(draw_op.phase);
 
@@ -306,7 +343,7 @@ _init_dr_el_triangle_strip(const DrawOperation& draw_op)
 			_face_index.push_back(_face_verts.size());
 			_face_phase.push_back(draw_op.phase);
 
-			if(i % 2 != 0)
+			if((i - strip_start) % 2 != 0)
 			{
 				_face_verts.push_back(_index[draw_op.first+i-1]);
 				_face_verts.push_back(_index[draw_op.first+i-2]);
@@ -503,9 +540,36 @@ GLuint ShapeAnalyzerGraphData::_guess_face_count(void)
 }
 
 OGLPLUS_LIB_FUNC
-GLuint ShapeAnalyzerGraphData::_guess_vertex_count(GLuint face_count)
+GLuint ShapeAnalyzerGraphData::_guess_vertex_count(void)
 {
-	return face_count * 3; // TODO n-gons or just triangles?
+	// the number of the face vertices (the sum of the face arities),
+	// the faces of strips and fans have their own vertices
+	const std::vector<DrawOperation>& draw_ops = _instr.Operations();
+	GLuint result = 0;
+	for(auto i=draw_ops.begin(), e=draw_ops.end(); i!=e; ++i)
+	{
+		switch(i->mode)
+		{
+			case Mode::Triangles:
+			{
+				assert(i->count % 3 == 0);
+				result += i->count;
+				break;
+			}
+			case Mode::TriangleStrip:
+			case Mode::TriangleFan:
+			{
+				assert((i->count == 0) || (i->count >= 3));
+				if(i->count) result += 3*(i->count-2);
+				break;
+			}
+			default: assert(!
+				"Only Triangles, TriangleStrip and "
+				"TriangleFan are currently supported"
+			);
+		}
+	}
+	return result;
 }
 
 OGLPLUS_LIB_FUNC
@@ -514,7 +578,7 @@ void ShapeAnalyzerGraphData::_initialize(void)
 	const std::vector<DrawOperation>& draw_ops = _instr.Operations();
 
 	GLuint fc = _guess_face_count();
-	GLuint vc = _guess_vertex_count(fc);
+	GLuint vc = _guess_vertex_count();
 
 	_face_index.reserve(fc);
 	_face_phase.reserve(fc);
@@ -534,6 +598,18 @@ void ShapeAnalyzerGraphData::_initialize(void)
 			case Method::DrawElements:
 				_init_draw_elements(*i);
 				break;
+			case Method::DrawElementsBaseVertex:
+			{
+				const std::size_t first = _face_verts.size();
+				_init_draw_elements(*i);
+				for(std::size_t v=first; v!=_face_verts.size(); ++v)
+					_face_verts[v] += GLuint(i->base_vertex);
+				break;
+			}
+			case Method::DrawArraysIndirect:
+			case Method::DrawElementsIndirect:
+				assert(!"Indirect operations cannot be analyzed");
+				break;
 		}
 	}
 
@@ -542,170 +618,226 @@ void ShapeAnalyzerGraphData::_initialize(void)
 
 OGLPLUS_LIB_FUNC
 bool ShapeAnalyzerGraphData::_same_va_values(
-	GLuint fa,
-	GLuint ea,
-	GLuint fb,
-	GLuint eb,
+	GLuint va,
+	GLuint vb,
 	GLuint attr_vpv,
 	const std::vector<GLdouble>& vert_attr
-)
+) const
+{
+	if(va == vb) return true;
+
+	va *= attr_vpv;
+	vb *= attr_vpv;
+
+	for(GLuint c=0; c!=attr_vpv; ++c)
+	{
+		if(std::fabs(vert_attr[va+c] - vert_attr[vb+c]) > _eps)
+			return false;
+	}
+	return true;
+}
+
+OGLPLUS_LIB_FUNC
+void ShapeAnalyzerGraphData::_weld_vertices(std::vector<GLuint>& weld) const
 {
-	GLuint va0 = _face_verts[_face_index[fa]+ea];
-	GLuint va1 = _face_verts[_face_index[fa]+(ea+1)%_face_arity(fa)];
+	assert(_main_vpv > 0);
+	assert(_eps > 0.0);
 
-	GLuint vb0 = _face_verts[_face_index[fb]+eb];
-	GLuint vb1 = _face_verts[_face_index[fb]+(eb+1)%_face_arity(fb)];
+	const GLuint vert_count = GLuint(_main_va.size() / _main_vpv);
+	const GLuint dims = (_main_vpv < 3)?_main_vpv:3;
+	// the vertices closer than _eps are at most in the adjacent cells
+	const GLdouble cell_size = 2*_eps;
 
-	if((va0 == vb0) && (va1 == vb1)) return true;
-	if((va0 == vb1) && (va1 == vb0)) return true;
+	weld.resize(vert_count);
 
-	va0 *= attr_vpv;
-	va1 *= attr_vpv;
-	vb0 *= attr_vpv;
-	vb1 *= attr_vpv;
+	// the cells of the representative welded vertices
+	// in an open addressing hash table
+	const std::size_t table_size = aux::AnalyzerHashTableSize(vert_count);
+	const std::size_t mask = table_size - 1;
+	std::vector<GLuint> table(table_size, _nil_face());
+	std::vector<std::int64_t> table_cells(table_size*3, 0);
 
-	bool equal = true;
-	for(GLuint c=0; c!=attr_vpv; ++c)
+	for(GLuint v=0; v!=vert_count; ++v)
 	{
-		if(std::fabs(vert_attr[va0+c] - vert_attr[vb0+c]) > _eps)
+		const GLdouble* p = _main_va.data() + v*_main_vpv;
+		std::int64_t lo[3] = {0, 0, 0}, hi[3] = {0, 0, 0};
+		for(GLuint d=0; d!=dims; ++d)
 		{
-			equal = false;
-			break;
+			lo[d] = std::int64_t(std::floor((p[d]-_eps)/cell_size));
+			hi[d] = std::int64_t(std::floor((p[d]+_eps)/cell_size));
 		}
-		if(std::fabs(vert_attr[va1+c] - vert_attr[vb1+c]) > _eps)
+
+		GLuint rep = _nil_face();
+		std::int64_t q[3];
+		for(q[0]=lo[0]; q[0]<=hi[0] && rep==_nil_face(); ++q[0])
+		for(q[1]=lo[1]; q[1]<=hi[1] && rep==_nil_face(); ++q[1])
+		for(q[2]=lo[2]; q[2]<=hi[2] && rep==_nil_face(); ++q[2])
 		{
-			equal = false;
-			break;
+			std::size_t h = aux::AnalyzerHashCell(q) & mask;
+			while(table[h] != _nil_face())
+			{
+				const std::int64_t* c = table_cells.data()+h*3;
+				if(	(c[0] == q[0]) &&
+					(c[1] == q[1]) &&
+					(c[2] == q[2]) &&
+					_same_va_values(
+						table[h], v,
+						_main_vpv,
+						_main_va
+					)
+				)
+				{
+					rep = table[h];
+					break;
+				}
+				h = (h+1) & mask;
+			}
 		}
-	}
-	if(equal) return true;
-	else equal = true;
-
-	for(GLuint c=0; c!=attr_vpv; ++c)
-	{
-		if(std::fabs(vert_attr[va0+c] - vert_attr[vb1+c]) > _eps)
+		if(rep != _nil_face())
 		{
-			equal = false;
-			break;
+			weld[v] = rep;
+			continue;
 		}
-		if(std::fabs(vert_attr[va1+c] - vert_attr[vb0+c]) > _eps)
+
+		weld[v] = v;
+		for(GLuint d=0; d!=3; ++d)
 		{
-			equal = false;
-			break;
+			q[d] = (d < dims)?
+				std::int64_t(std::floor(p[d]/cell_size)):
+				0;
 		}
+		std::size_t h = aux::AnalyzerHashCell(q) & mask;
+		while(table[h] != _nil_face())
+			h = (h+1) & mask;
+		table[h] = v;
+		for(GLuint d=0; d!=3; ++d)
+			table_cells[h*3+d] = q[d];
 	}
-	if(equal) return true;
-
-	return false;
-}
-
-OGLPLUS_LIB_FUNC
-bool ShapeAnalyzerGraphData::
-_adjacent_faces(GLuint fa, GLuint ea, GLuint fb, GLuint eb)
-{
-	return _same_va_values(fa, ea, fb, eb, _main_vpv, _main_va);
 }
 
 OGLPLUS_LIB_FUNC
-bool ShapeAnalyzerGraphData::
-_smooth_faces(GLuint fa, GLuint ea, GLuint fb, GLuint eb)
+void ShapeAnalyzerGraphData::_connect_edges(
+	GLuint fi,
+	GLuint ei,
+	GLuint fj,
+	GLuint ej,
+	const std::vector<GLuint>& weld
+)
 {
-	return _same_va_values(fa, ea, fb, eb, _smooth_vpv, _smooth_va);
-}
+	const GLuint i = _face_index[fi]+ei;
+	const GLuint j = _face_index[fj]+ej;
+
+	_face_adj_f[i] = fj;
+	_face_adj_f[j] = fi;
+
+	_face_adj_e[i] = ej;
+	_face_adj_e[j] = ei;
+
+	// the corresponding vertices of the two edges
+	GLuint va0 = _face_verts[i];
+	GLuint va1 = _face_verts[_face_index[fi]+(ei+1)%_face_arity(fi)];
+	GLuint vb0 = _face_verts[j];
+	GLuint vb1 = _face_verts[_face_index[fj]+(ej+1)%_face_arity(fj)];
+	if(weld[va0] != weld[vb0])
+		std::swap(vb0, vb1);
+
+	const bool smooth =
+		_same_va_values(va0, vb0, _smooth_vpv, _smooth_va) &&
+		_same_va_values(va1, vb1, _smooth_vpv, _smooth_va);
+	if(smooth)
+	{
+		_face_edge_flags[i] |= _flg_smooth_edge;
+		_face_edge_flags[j] |= _flg_smooth_edge;
+	}
 
-OGLPLUS_LIB_FUNC
-bool ShapeAnalyzerGraphData::
-_contin_faces(GLuint fa, GLuint ea, GLuint fb, GLuint eb)
-{
-	std::size_t n = _other_vas.size();
+	const std::size_t n = _other_vas.size();
 	assert(n == _other_vpvs.size());
-	bool result = true;
-	for(std::size_t i=0; i!=n; ++i)
+	bool contin = true;
+	for(std::size_t a=0; a!=n && contin; ++a)
 	{
-		result |= _same_va_values(
-			fa, ea, fb, eb,
-			_other_vpvs[i],
-			_other_vas[i]
-		);
+		contin =
+			_same_va_values(va0, vb0, _other_vpvs[a], _other_vas[a]) &&
+			_same_va_values(va1, vb1, _other_vpvs[a], _other_vas[a]);
+	}
+	if(contin)
+	{
+		_face_edge_flags[i] |= _flg_contin_edge;
+		_face_edge_flags[j] |= _flg_contin_edge;
 	}
-	return result;
 }
 
 OGLPLUS_LIB_FUNC
 void ShapeAnalyzerGraphData::_detect_adjacent(void)
 {
-	const auto fb=_face_index.begin();
-	const auto fe=_face_index.end();
+	assert(!_face_index.empty());
+
+	// the vertices with the same main attribute values
+	// are welded into a single representative vertex
+	_weld_vertices(_main_weld);
+	const std::vector<GLuint>& weld = _main_weld;
 
-	assert(fb != fe);
+	const GLuint face_count = GLuint(_face_index.size());
+	const std::size_t edge_count = _face_verts.size();
 
-	auto fi=fb;
-	// for each face
-	while(fi != fe)
+	// the face of each edge
+	std::vector<GLuint> edge_face(edge_count);
+	for(GLuint f=0; f!=face_count; ++f)
 	{
-		GLuint fien = _face_arity(fi-fb);
-		for(GLuint fie=0; fie!=fien; ++fie)
+		const GLuint b = _face_index[f];
+		const GLuint e = b + _face_arity(f);
+		for(GLuint i=b; i!=e; ++i)
+			edge_face[i] = f;
+	}
+
+	// the edges waiting for an adjacent edge keyed by the welded
+	// vertices in an open addressing hash table
+	const std::size_t table_size = aux::AnalyzerHashTableSize(edge_count);
+	const std::size_t mask = table_size - 1;
+	std::vector<GLuint> table(table_size, _nil_face());
+	std::vector<std::uint64_t> table_keys(table_size, 0);
+
+	for(GLuint f=0; f!=face_count; ++f)
+	{
+		const GLuint arity = _face_arity(f);
+		for(GLuint e=0; e!=arity; ++e)
 		{
-			GLuint i=*fi+fie;
-			if(_face_adj_f[i] == _nil_face())
+			const GLuint i = _face_index[f]+e;
+			// the edges inside of strips and fans are already connected
+			if(_face_adj_f[i] != _nil_face()) continue;
+
+			GLuint w0 = weld[_face_verts[i]];
+			GLuint w1 = weld[_face_verts[_face_index[f]+(e+1)%arity]];
+			// skip the degenerate edges
+			if(w0 == w1) continue;
+			if(w0 > w1) std::swap(w0, w1);
+			const std::uint64_t key = (std::uint64_t(w0) << 32) | w1;
+
+			std::size_t h = aux::AnalyzerHashKey(key) & mask;
+			bool connected = false;
+			while(table[h] != _nil_face())
 			{
-				auto fj = fi+1;
-				while(fj != fe)
+				const GLuint j = table[h];
+				if(	(table_keys[h] == key) &&
+					(_face_adj_f[j] == _nil_face())
+				)
 				{
-					GLuint fjen = _face_arity(fj-fb);
-					for(GLuint fje=0; fje!=fjen; ++fje)
-					{
-						GLuint j=*fj+fje;
-						bool nadj = (
-							_face_adj_f[j] ==
-							_nil_face()
-						);
-						bool adjf = _adjacent_faces(
-							fi-fb,
-							fie,
-							fj-fb,
-							fje
-						);
-						bool smtf = adjf&&_smooth_faces(
-							fi-fb,
-							fie,
-							fj-fb,
-							fje
-						);
-						bool cntf = adjf&&_contin_faces(
-							fi-fb,
-							fie,
-							fj-fb,
-							fje
-						);
-						if(nadj && adjf)
-						{
-							_face_adj_f[i]=fj-fb;
-							_face_adj_f[j]=fi-fb;
-
-							_face_adj_e[i]=fje;
-							_face_adj_e[j]=fie;
-						}
-						if(nadj && smtf)
-						{
-							_face_edge_flags[i] |=
-								_flg_smooth_edge;
-							_face_edge_flags[j] |=
-								_flg_smooth_edge;
-						}
-						if(nadj && cntf)
-						{
-							_face_edge_flags[i] |=
-								_flg_contin_edge;
-							_face_edge_flags[j] |=
-								_flg_contin_edge;
-						}
-					}
-					++fj;
+					_connect_edges(
+						edge_face[j],
+						j - _face_index[edge_face[j]],
+						f, e,
+						weld
+					);
+					connected = true;
+					break;
 				}
+				h = (h+1) & mask;
+			}
+			if(!connected)
+			{
+				table[h] = i;
+				table_keys[h] = key;
 			}
 		}
-		++fi;
 	}
 }
 
@@ -0,0 +1,361 @@
+/**
+ *  @file oglplus/shapes/batch.ipp
+ *  @brief Implementation of the batching of shapes
+ *
+ *  @author Matus Chochlik
+ *
+ *  Copyright 2010-2013 Matus Chochlik. Distributed under the Boost
+ *  Software License, Version 1.0. (See accompanying file
+ *  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ */
+
+#include <algorithm>
+
+namespace oglplus {
+namespace shapes {
+
+OGLPLUS_LIB_FUNC
+GLuint ShapeBatchBuilder::_add_shape(
+	const std::vector<std::vector<GLfloat> >& values,
+	const std::vector<GLuint>& npvs,
+	const std::vector<GLuint>& indices,
+	const DrawingInstructions& instructions,
+	GLuint inst_count,
+	GLuint base_inst
+)
+{
+	assert(values.size() == _names.size());
+	assert(npvs.size() == _names.size());
+
+	GLuint vertex_count = 0;
+	for(std::size_t i=0, n=_names.size(); i!=n; ++i)
+	{
+		if(npvs[i] == 0) continue;
+		assert(
+			(vertex_count == 0) ||
+			(vertex_count == values[i].size() / npvs[i])
+		);
+		vertex_count = GLuint(values[i].size() / npvs[i]);
+	}
+
+	for(std::size_t i=0, n=_names.size(); i!=n; ++i)
+	{
+		if(npvs[i] != 0)
+		{
+			if(_npvs[i] == 0)
+			{
+				// the previous shapes did not have this attribute
+				_npvs[i] = npvs[i];
+				_values[i].resize(_vertex_count*_npvs[i], 0.0f);
+			}
+			assert(npvs[i] == _npvs[i]);
+			_values[i].insert(
+				_values[i].end(),
+				values[i].begin(),
+				values[i].end()
+			);
+		}
+		else if(_npvs[i] != 0)
+		{
+			_values[i].resize(
+				(_vertex_count+vertex_count)*_npvs[i],
+				0.0f
+			);
+		}
+	}
+
+	auto op = instructions.Operations().begin();
+	auto end = instructions.Operations().end();
+	while(op != end)
+	{
+		DrawElementsIndirectCommand command;
+		command.count = op->count;
+		command.instance_count = inst_count;
+		command.first_index = GLuint(_indices.size());
+		command.base_vertex = GLint(_vertex_count);
+		command.base_instance = base_inst;
+
+		assert(!op->Indirect());
+		if(op->Indexed())
+		{
+			command.base_vertex += op->BaseVertex();
+			assert(op->first+op->count <= indices.size());
+			const bool restart =
+				op->restart_index != DrawOperation::NoRestartIndex();
+			for(GLuint i=op->first, e=op->first+op->count; i!=e; ++i)
+			{
+				if(restart && (indices[i] == op->restart_index))
+				{
+					_indices.push_back(RestartIndex());
+					_restart = true;
+				}
+				else _indices.push_back(indices[i]);
+			}
+		}
+		else
+		{
+			for(GLuint i=op->first, e=op->first+op->count; i!=e; ++i)
+				_indices.push_back(i);
+		}
+		_commands.push_back(command);
+		_modes.push_back(op->mode);
+		++op;
+	}
+	_vertex_count += vertex_count;
+	_shape_commands.push_back(GLuint(_commands.size()));
+	return GLuint(_shape_commands.size()-2);
+}
+
+OGLPLUS_LIB_FUNC
+DrawingInstructions ShapeBatchBuilder::Instructions(void) const
+{
+	auto instructions = this->MakeInstructions();
+	for(std::size_t shape=0, n=ShapeCount(); shape!=n; ++shape)
+	{
+		const GLuint first = _shape_commands[shape];
+		const GLuint end = _shape_commands[shape+1];
+		for(GLuint i=first; i!=end; ++i)
+		{
+			DrawOperation operation;
+			operation.method = DrawOperation::Method::DrawElementsBaseVertex;
+			operation.mode = _modes[i];
+			operation.first = _commands[i].first_index;
+			operation.count = _commands[i].count;
+			operation.base_vertex = _commands[i].base_vertex;
+			operation.restart_index = _restart?
+				RestartIndex():
+				DrawOperation::NoRestartIndex();
+			operation.phase = GLuint(shape);
+			this->AddInstruction(instructions, operation);
+		}
+	}
+	return instructions;
+}
+
+OGLPLUS_LIB_FUNC
+std::vector<ShapeBatchGroup> ShapeBatchBuilder::SortedCommands(
+	std::vector<DrawElementsIndirectCommand>& sorted
+) const
+{
+	std::vector<GLuint> order(_commands.size());
+	for(GLuint i=0, n=GLuint(order.size()); i!=n; ++i)
+		order[i] = i;
+	const std::vector<PrimitiveType>& modes = _modes;
+	std::stable_sort(
+		order.begin(),
+		order.end(),
+		[&modes](GLuint a, GLuint b) -> bool
+		{
+			return GLenum(modes[a]) < GLenum(modes[b]);
+		}
+	);
+
+	std::vector<ShapeBatchGroup> groups;
+	sorted.clear();
+	sorted.reserve(order.size());
+	for(auto i=order.begin(), e=order.end(); i!=e; ++i)
+	{
+		const DrawElementsIndirectCommand& command = _commands[*i];
+		if(groups.empty() || (groups.back().mode != _modes[*i]))
+		{
+			ShapeBatchGroup group;
+			group.mode = _modes[*i];
+			group.first = GLuint(sorted.size());
+			group.count = 0;
+			group.instanced = false;
+			groups.push_back(group);
+		}
+		ShapeBatchGroup& group = groups.back();
+		++group.count;
+		if(	(command.instance_count != 1) ||
+			(command.base_instance != 0)
+		) group.instanced = true;
+		sorted.push_back(command);
+	}
+	return groups;
+}
+
+OGLPLUS_LIB_FUNC
+void ShapeBatch::_init(const ShapeBatchBuilder& builder)
+{
+	VertexArray::Unbind();
+	_groups = builder.SortedCommands(_commands);
+	_restart = builder.PrimitiveRestart();
+
+	for(std::size_t i=0, n=builder.AttribCount(); i!=n; ++i)
+	{
+		_names.push_back(builder.AttribName(i));
+		_npvs.push_back(builder.ValuesPerVertex(i));
+		if(_npvs.back() == 0) continue;
+		_vbos[GLuint(i)].Bind(Buffer::Target::Array);
+		Buffer::Data(Buffer::Target::Array, builder.Values(i));
+	}
+	_vbos[GLuint(_names.size())].Bind(Buffer::Target::ElementArray);
+	Buffer::Data(Buffer::Target::ElementArray, builder.Indices());
+
+#if GL_VERSION_4_3
+	if(_indirect && !_commands.empty())
+	{
+		_vbos[GLuint(_names.size()+1)].Bind(
+			Buffer::Target::DrawIndirect
+		);
+		Buffer::Data(Buffer::Target::DrawIndirect, _commands);
+		return;
+	}
+#endif
+	_indirect = false;
+	_counts.reserve(_commands.size());
+	_offsets.reserve(_commands.size());
+	_base_vertices.reserve(_commands.size());
+	for(auto i=_commands.begin(), e=_commands.end(); i!=e; ++i)
+	{
+		_counts.push_back(GLsizei(i->count));
+		_offsets.push_back(reinterpret_cast<GLuint*>(
+			std::size_t(i->first_index)*sizeof(GLuint)
+		));
+		_base_vertices.push_back(i->base_vertex);
+	}
+}
+
+OGLPLUS_LIB_FUNC
+VertexArray ShapeBatch::VAOForProgram(const ProgramOps& prog) const
+{
+	VertexArray vao;
+	vao.Bind();
+	prog.Use();
+	for(std::size_t i=0, n=_names.size(); i!=n; ++i)
+	{
+		if(_npvs[i] == 0) continue;
+		try
+		{
+			VertexAttribArray attr(prog, _names[i]);
+			_vbos[GLuint(i)].Bind(Buffer::Target::Array);
+			attr.Setup<GLfloat>(_npvs[i]);
+			attr.Enable();
+		}
+		catch(Error&){ }
+	}
+	_vbos[GLuint(_names.size())].Bind(Buffer::Target::ElementArray);
+	return vao;
+}
+
+OGLPLUS_LIB_FUNC
+std::size_t ShapeBatch::DrawCallCount(void) const
+{
+	if(_indirect) return _groups.size();
+	std::size_t result = 0;
+	for(auto i=_groups.begin(), e=_groups.end(); i!=e; ++i)
+		result += i->instanced?i->count:1;
+	return result;
+}
+
+OGLPLUS_LIB_FUNC
+void ShapeBatch::_draw_indirect(const ShapeBatchGroup& group) const
+{
+#if GL_VERSION_4_3
+	_gl.MultiDrawElementsIndirect(
+		group.mode,
+		DataType::UnsignedInt,
+		GLsizei(group.count),
+		GLsizei(sizeof(DrawElementsIndirectCommand)),
+		reinterpret_cast<const void*>(
+			std::size_t(group.first)*
+			sizeof(DrawElementsIndirectCommand)
+		)
+	);
+#else
+	OGLPLUS_FAKE_USE(group);
+	assert(!
+		"MultiDrawElementsIndirect required, "
+		"but not supported by the used version of OpenGL!"
+	);
+#endif
+}
+
+OGLPLUS_LIB_FUNC
+void ShapeBatch::_draw_multi(const ShapeBatchGroup& group) const
+{
+#if GL_VERSION_3_2 || GL_ARB_draw_elements_base_vertex
+	if(!group.instanced)
+	{
+		_gl.MultiDrawElementsBaseVertex(
+			group.mode,
+			_counts.data()+group.first,
+			_offsets.data()+group.first,
+			GLsizei(group.count),
+			_base_vertices.data()+group.first
+		);
+		return;
+	}
+	for(GLuint i=group.first, e=group.first+group.count; i!=e; ++i)
+	{
+		const DrawElementsIndirectCommand& command = _commands[i];
+		if(command.base_instance == 0)
+		{
+			_gl.DrawElementsInstancedBaseVertex(
+				group.mode,
+				_counts[i],
+				_offsets[i],
+				GLsizei(command.instance_count),
+				command.base_vertex
+			);
+		}
+		else
+		{
+#if GL_VERSION_4_2 || GL_ARB_base_instance
+			_gl.DrawElementsInstancedBaseVertexBaseInstance(
+				group.mode,
+				_counts[i],
+				_offsets[i],
+				GLsizei(command.instance_count),
+				command.base_vertex,
+				command.base_instance
+			);
+#else
+			assert(!
+				"DrawElementsInstancedBaseVertexBaseInstance "
+				"required, but not supported by the used "
+				"version of OpenGL!"
+			);
+#endif
+		}
+	}
+#else
+	OGLPLUS_FAKE_USE(group);
+	assert(!
+		"MultiDrawElementsBaseVertex required, "
+		"but not supported by the used version of OpenGL!"
+	);
+#endif
+}
+
+OGLPLUS_LIB_FUNC
+void ShapeBatch::Draw(void) const
+{
+	if(_restart)
+	{
+		_gl.Enable(Capability::PrimitiveRestart);
+		_gl.PrimitiveRestartIndex(ShapeBatchBuilder::RestartIndex());
+	}
+	if(_indirect)
+	{
+		_vbos[GLuint(_names.size()+1)].Bind(
+			Buffer::Target::DrawIndirect
+		);
+		for(auto i=_groups.begin(), e=_groups.end(); i!=e; ++i)
+			_draw_indirect(*i);
+	}
+	else
+	{
+		for(auto i=_groups.begin(), e=_groups.end(); i!=e; ++i)
+			_draw_multi(*i);
+	}
+	if(_restart)
+	{
+		_gl.Disable(Capability::PrimitiveRestart);
+	}
+}
+
+} // shapes
+} // oglplus
+
@@ -46,18 +46,10 @@ void BlenderMesh::_load_mesh(
 		std::vector<GLshort> ms(opts.load_materials?1*n_verts:0,-1);
 		for(std::size_t v=0; v!=n_verts; ++v)
 		{
-			// (transpose y and z axes)
 			// get the positional coordinates
-			Vec4f position(
-				vertex_co_field.Get(v, 0),
-				vertex_co_field.Get(v, 1),
-				vertex_co_field.Get(v, 2),
-				1.0f
-			);
-			Vec4f newpos = mesh_matrix * position;
-			ps[3*v+0] = newpos.x();
-			ps[3*v+1] = newpos.z();
-			ps[3*v+2] =-newpos.y();
+			ps[3*v+0] = vertex_co_field.Get(v, 0);
+			ps[3*v+1] = vertex_co_field.Get(v, 1);
+			ps[3*v+2] = vertex_co_field.Get(v, 2);
 			//
 			// get the normals
 			if(opts.load_normals)
@@ -67,12 +59,32 @@ void BlenderMesh::_load_mesh(
 					vertex_no_field.Get(v, 1),
 					vertex_no_field.Get(v, 2)
 				));
-				Vec4f newnorm = mesh_matrix * Vec4f(normal, 0.0f);
-				ns[3*v+0] = newnorm.x();
-				ns[3*v+1] = newnorm.z();
-				ns[3*v+2] =-newnorm.y();
+				ns[3*v+0] = normal.x();
+				ns[3*v+1] = normal.y();
+				ns[3*v+2] = normal.z();
 			}
 		}
+		// transform the positions and normals by the mesh matrix
+		// and transpose the y and z axes: (x, y, z) -> (x, z, -y)
+		const Mat4f vertex_matrix = Mat4f(
+			1.0f, 0.0f, 0.0f, 0.0f,
+			0.0f, 0.0f, 1.0f, 0.0f,
+			0.0f,-1.0f, 0.0f, 0.0f,
+			0.0f, 0.0f, 0.0f, 1.0f
+		) * mesh_matrix;
+		TransformPositions(
+			vertex_matrix,
+			StridedSpan<GLfloat>(ps, 3),
+			StridedSpan<GLfloat>(ps, 3)
+		);
+		if(opts.load_normals)
+		{
+			TransformDirections(
+				vertex_matrix,
+				StridedSpan<GLfloat>(ns, 3),
+				StridedSpan<GLfloat>(ns, 3)
+			);
+		}
 		// append the values:
 		// positions
 		_pos_data.insert(_pos_data.end(), ps.begin(), ps.end());
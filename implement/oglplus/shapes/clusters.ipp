@@ -0,0 +1,297 @@
+/**
+ *  @file oglplus/shapes/clusters.ipp
+ *  @brief Implementation of the partitioning of shapes into clusters
+ *
+ *  @author Matus Chochlik
+ *
+ *  Copyright 2010-2013 Matus Chochlik. Distributed under the Boost
+ *  Software License, Version 1.0. (See accompanying file
+ *  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ */
+
+#include <limits>
+#include <cmath>
+
+namespace oglplus {
+namespace aux {
+
+// Calculates the bounding sphere and the normal cone of a cluster
+// from its vertices and the unit normals of its triangles
+inline void ClusterBounds(
+	shapes::ShapeCluster& cluster,
+	const std::vector<GLuint>& cluster_verts,
+	const std::vector<GLuint>& cluster_tris,
+	const std::vector<GLfloat>& positions,
+	GLuint values_per_vertex,
+	const std::vector<GLfloat>& tri_normals
+)
+{
+	GLfloat lo[3], hi[3];
+	for(GLuint c=0; c!=3; ++c)
+	{
+		lo[c] = std::numeric_limits<GLfloat>::max();
+		hi[c] =-std::numeric_limits<GLfloat>::max();
+	}
+	for(auto i=cluster_verts.begin(), e=cluster_verts.end(); i!=e; ++i)
+	{
+		const GLfloat* p = positions.data() + (*i)*values_per_vertex;
+		for(GLuint c=0; c!=3; ++c)
+		{
+			if(lo[c] > p[c]) lo[c] = p[c];
+			if(hi[c] < p[c]) hi[c] = p[c];
+		}
+	}
+	const GLfloat center[3] = {
+		(lo[0]+hi[0])*0.5f,
+		(lo[1]+hi[1])*0.5f,
+		(lo[2]+hi[2])*0.5f
+	};
+	GLfloat radius = 0.0f;
+	for(auto i=cluster_verts.begin(), e=cluster_verts.end(); i!=e; ++i)
+	{
+		const GLfloat* p = positions.data() + (*i)*values_per_vertex;
+		GLfloat d = 0.0f;
+		for(GLuint c=0; c!=3; ++c)
+			d += (p[c]-center[c])*(p[c]-center[c]);
+		if(radius < d) radius = d;
+	}
+	cluster.center = Vec3f(center[0], center[1], center[2]);
+	cluster.radius = std::sqrt(radius);
+
+	GLfloat axis[3] = {0.0f, 0.0f, 0.0f};
+	for(auto i=cluster_tris.begin(), e=cluster_tris.end(); i!=e; ++i)
+	{
+		for(GLuint c=0; c!=3; ++c)
+			axis[c] += tri_normals[(*i)*3+c];
+	}
+	const GLfloat l = std::sqrt(
+		axis[0]*axis[0] + axis[1]*axis[1] + axis[2]*axis[2]
+	);
+	GLfloat min_dp = 1.0f;
+	if(l > 0.0f)
+	{
+		for(GLuint c=0; c!=3; ++c)
+			axis[c] /= l;
+		for(auto i=cluster_tris.begin(), e=cluster_tris.end(); i!=e; ++i)
+		{
+			const GLfloat* n = tri_normals.data() + (*i)*3;
+			// skip the degenerate triangles
+			if((n[0] == 0.0f) && (n[1] == 0.0f) && (n[2] == 0.0f))
+				continue;
+			const GLfloat dp = n[0]*axis[0]+n[1]*axis[1]+n[2]*axis[2];
+			if(min_dp > dp) min_dp = dp;
+		}
+	}
+	else min_dp = 0.0f;
+	cluster.cone_axis = Vec3f(axis[0], axis[1], axis[2]);
+	// clusters with normals spread over (almost) a hemisphere
+	// are (almost) never back-facing and are not tested at all
+	if(min_dp <= 0.1f)
+		cluster.cone_cutoff = 1.0f;
+	else cluster.cone_cutoff = std::sqrt(1.0f - min_dp*min_dp);
+}
+
+} // namespace aux
+
+namespace shapes {
+
+OGLPLUS_LIB_FUNC
+std::vector<ShapeCluster> BuildShapeClusters(
+	std::vector<GLuint>& triangles,
+	const std::vector<GLfloat>& positions,
+	GLuint values_per_vertex,
+	FaceOrientation winding,
+	GLuint max_vertices,
+	GLuint max_triangles
+)
+{
+	assert(max_vertices >= 3);
+	assert(max_triangles >= 1);
+	assert(values_per_vertex >= 3);
+	assert(triangles.size() % 3 == 0);
+
+	const GLuint tri_count = GLuint(triangles.size() / 3);
+	const GLuint vertex_count = GLuint(positions.size() / values_per_vertex);
+
+	// the triangles referencing each vertex
+	std::vector<GLuint> adj_first(vertex_count+1, 0);
+	for(auto i=triangles.begin(), e=triangles.end(); i!=e; ++i)
+	{
+		assert(*i < vertex_count);
+		++adj_first[*i+1];
+	}
+	for(GLuint v=0; v!=vertex_count; ++v)
+		adj_first[v+1] += adj_first[v];
+	std::vector<GLuint> adj(triangles.size());
+	{
+		std::vector<GLuint> pos(adj_first.begin(), adj_first.end()-1);
+		for(GLuint i=0, n=GLuint(triangles.size()); i!=n; ++i)
+			adj[pos[triangles[i]]++] = i / 3;
+	}
+
+	// the centroids and the unit normals of the triangles
+	const GLfloat sign = (winding == FaceOrientation::CW)?-1.0f:1.0f;
+	std::vector<GLfloat> centroids(tri_count*3);
+	std::vector<GLfloat> normals(tri_count*3);
+	for(GLuint t=0; t!=tri_count; ++t)
+	{
+		const GLfloat* p[3];
+		for(GLuint k=0; k!=3; ++k)
+			p[k] = positions.data() + triangles[t*3+k]*values_per_vertex;
+		GLfloat e1[3], e2[3];
+		for(GLuint c=0; c!=3; ++c)
+		{
+			centroids[t*3+c] = (p[0][c]+p[1][c]+p[2][c])/3.0f;
+			e1[c] = p[1][c] - p[0][c];
+			e2[c] = p[2][c] - p[0][c];
+		}
+		GLfloat* n = normals.data() + t*3;
+		n[0] = e1[1]*e2[2] - e1[2]*e2[1];
+		n[1] = e1[2]*e2[0] - e1[0]*e2[2];
+		n[2] = e1[0]*e2[1] - e1[1]*e2[0];
+		const GLfloat l = std::sqrt(n[0]*n[0] + n[1]*n[1] + n[2]*n[2]);
+		if(l > 0.0f)
+		{
+			for(GLuint c=0; c!=3; ++c)
+				n[c] *= sign / l;
+		}
+	}
+
+	std::vector<ShapeCluster> clusters;
+	std::vector<GLuint> result;
+	result.reserve(triangles.size());
+
+	std::vector<bool> used(tri_count, false);
+	// the number of the last cluster referencing a vertex or
+	// having a triangle as a candidate for the next step
+	std::vector<GLuint> vert_stamp(vertex_count, 0);
+	std::vector<GLuint> cand_stamp(tri_count, 0);
+	GLuint stamp = 0;
+
+	std::vector<GLuint> cluster_tris, cluster_verts, candidates;
+	GLfloat sum[3] = {0.0f, 0.0f, 0.0f};
+	GLuint scan = 0;
+
+	while(result.size() != triangles.size())
+	{
+		// continue with the unused neighbor closest to the previous
+		// cluster, or with the first unused triangle if there is none
+		GLuint next = tri_count;
+		GLfloat seed_dist = std::numeric_limits<GLfloat>::max();
+		for(auto i=candidates.begin(), e=candidates.end(); i!=e; ++i)
+		{
+			if(used[*i]) continue;
+			const GLfloat* c = centroids.data() + (*i)*3;
+			GLfloat d = 0.0f;
+			for(GLuint k=0; k!=3; ++k)
+			{
+				const GLfloat x = c[k]*cluster_tris.size() - sum[k];
+				d += x*x;
+			}
+			if(seed_dist > d)
+			{
+				seed_dist = d;
+				next = *i;
+			}
+		}
+		if(next == tri_count)
+		{
+			while(used[scan]) ++scan;
+			next = scan;
+		}
+
+		++stamp;
+		cluster_tris.clear();
+		cluster_verts.clear();
+		candidates.clear();
+		sum[0] = sum[1] = sum[2] = 0.0f;
+
+		while(true)
+		{
+			used[next] = true;
+			cluster_tris.push_back(next);
+			for(GLuint k=0; k!=3; ++k)
+			{
+				sum[k] += centroids[next*3+k];
+				const GLuint v = triangles[next*3+k];
+				if(vert_stamp[v] == stamp) continue;
+				vert_stamp[v] = stamp;
+				cluster_verts.push_back(v);
+				for(GLuint a=adj_first[v]; a!=adj_first[v+1]; ++a)
+				{
+					const GLuint t = adj[a];
+					if(used[t] || (cand_stamp[t] == stamp))
+						continue;
+					cand_stamp[t] = stamp;
+					candidates.push_back(t);
+				}
+			}
+			if(cluster_tris.size() >= max_triangles) break;
+
+			// pick the candidate adding the fewest new vertices
+			// and closest to the centroid of the cluster
+			const GLfloat n = GLfloat(cluster_tris.size());
+			next = tri_count;
+			GLuint next_new = 4;
+			GLfloat next_dist = std::numeric_limits<GLfloat>::max();
+			std::size_t keep = 0;
+			for(std::size_t i=0, m=candidates.size(); i!=m; ++i)
+			{
+				const GLuint t = candidates[i];
+				if(used[t]) continue;
+				candidates[keep++] = t;
+				GLuint new_verts = 0;
+				for(GLuint k=0; k!=3; ++k)
+				{
+					if(vert_stamp[triangles[t*3+k]] != stamp)
+						++new_verts;
+				}
+				if(cluster_verts.size()+new_verts > max_vertices)
+					continue;
+				if(new_verts > next_new) continue;
+				GLfloat d = 0.0f;
+				for(GLuint k=0; k!=3; ++k)
+				{
+					const GLfloat x = centroids[t*3+k] - sum[k]/n;
+					d += x*x;
+				}
+				if((new_verts < next_new) || (next_dist > d))
+				{
+					next = t;
+					next_new = new_verts;
+					next_dist = d;
+				}
+			}
+			candidates.resize(keep);
+			if(next == tri_count) break;
+		}
+
+		ShapeCluster cluster;
+		cluster.first = GLuint(result.size());
+		cluster.count = GLuint(cluster_tris.size()*3);
+		cluster.vertex_count = GLuint(cluster_verts.size());
+		aux::ClusterBounds(
+			cluster,
+			cluster_verts,
+			cluster_tris,
+			positions,
+			values_per_vertex,
+			normals
+		);
+		clusters.push_back(cluster);
+		for(auto i=cluster_tris.begin(), e=cluster_tris.end(); i!=e; ++i)
+		{
+			result.insert(
+				result.end(),
+				triangles.begin() + (*i)*3,
+				triangles.begin() + (*i)*3+3
+			);
+		}
+	}
+	triangles.swap(result);
+	return clusters;
+}
+
+} // namespace shapes
+} // namespace oglplus
+
@@ -18,13 +18,11 @@ void DrawOperation::SetupPrimitiveRestart_(void) const
 #if GL_VERSION_3_1
 	if(restart_index == NoRestartIndex())
 	{
-		OGLPLUS_GLFUNC(Disable)(GL_PRIMITIVE_RESTART);
-		OGLPLUS_VERIFY(OGLPLUS_ERROR_INFO(Disable));
+		aux::SetCapability(GL_PRIMITIVE_RESTART, false);
 	}
 	else
 	{
-		OGLPLUS_GLFUNC(Enable)(GL_PRIMITIVE_RESTART);
-		OGLPLUS_VERIFY(OGLPLUS_ERROR_INFO(Enable));
+		aux::SetCapability(GL_PRIMITIVE_RESTART, true);
 		OGLPLUS_GLFUNC(PrimitiveRestartIndex)(restart_index);
 		OGLPLUS_VERIFY(OGLPLUS_ERROR_INFO(PrimitiveRestartIndex));
 	}
@@ -41,8 +39,7 @@ void DrawOperation::CleanupPrimitiveRestart_(void) const
 {
 	if(restart_index != NoRestartIndex())
 	{
-		OGLPLUS_GLFUNC(Disable)(GL_PRIMITIVE_RESTART);
-		OGLPLUS_VERIFY(OGLPLUS_ERROR_INFO(Disable));
+		aux::SetCapability(GL_PRIMITIVE_RESTART, false);
 	}
 }
 
@@ -71,6 +68,23 @@ void DrawOperation::Draw_(
 			inst_count,
 			base_inst
 		);
+
+		case OGLPLUS_CONST_ENUM_VALUE(
+			Method::DrawElementsBaseVertex
+		): return DrawElementsBaseVertex_(
+			indices,
+			index_data_type,
+			inst_count,
+			base_inst
+		);
+
+		case OGLPLUS_CONST_ENUM_VALUE(
+			Method::DrawArraysIndirect
+		): return DrawArraysIndirect_();
+
+		case OGLPLUS_CONST_ENUM_VALUE(
+			Method::DrawElementsIndirect
+		): return DrawElementsIndirect_(index_data_type);
 	}
 }
 
@@ -185,6 +199,212 @@ void DrawOperation::DrawElements_(
 	CleanupPrimitiveRestart_();
 }
 
+OGLPLUS_LIB_FUNC
+void DrawOperation::DrawElementsBaseVertex_(
+	void* indices,
+	DataType index_data_type,
+	GLuint inst_count,
+	GLuint base_inst
+) const
+{
+#if OGLPLUS_DOCUMENTATION_ONLY || \
+	GL_VERSION_3_2 || \
+	GL_ARB_draw_elements_base_vertex
+	SetupPrimitiveRestart_();
+	if(inst_count == 1)
+	{
+		OGLPLUS_GLFUNC(DrawElementsBaseVertex)(
+			GLenum(mode),
+			count,
+			GLenum(index_data_type),
+			indices,
+			base_vertex
+		);
+		OGLPLUS_CHECK(OGLPLUS_ERROR_INFO(DrawElementsBaseVertex));
+	}
+	else if(base_inst == 0)
+	{
+		OGLPLUS_GLFUNC(DrawElementsInstancedBaseVertex)(
+			GLenum(mode),
+			count,
+			GLenum(index_data_type),
+			indices,
+			inst_count,
+			base_vertex
+		);
+		OGLPLUS_CHECK(OGLPLUS_ERROR_INFO(
+			DrawElementsInstancedBaseVertex
+		));
+	}
+	else
+	{
+#if OGLPLUS_DOCUMENTATION_ONLY || GL_VERSION_4_2 || GL_ARB_base_instance
+		OGLPLUS_GLFUNC(DrawElementsInstancedBaseVertexBaseInstance)(
+			GLenum(mode),
+			count,
+			GLenum(index_data_type),
+			indices,
+			inst_count,
+			base_vertex,
+			base_inst
+		);
+		OGLPLUS_CHECK(OGLPLUS_ERROR_INFO(
+			DrawElementsInstancedBaseVertexBaseInstance
+		));
+#else
+		assert(!
+			"DrawElementsInstancedBaseVertexBaseInstance required, "
+			"but not supported by the used version of OpenGL!"
+		);
+#endif
+	}
+	CleanupPrimitiveRestart_();
+#else
+	OGLPLUS_FAKE_USE(indices);
+	OGLPLUS_FAKE_USE(index_data_type);
+	OGLPLUS_FAKE_USE(inst_count);
+	OGLPLUS_FAKE_USE(base_inst);
+	assert(!
+		"DrawElementsBaseVertex required, "
+		"but not supported by the used version of OpenGL!"
+	);
+#endif
+}
+
+OGLPLUS_LIB_FUNC
+void DrawOperation::DrawArraysIndirect_(void) const
+{
+	if(count == 1)
+	{
+#if OGLPLUS_DOCUMENTATION_ONLY || GL_VERSION_4_0 || GL_ARB_draw_indirect
+		OGLPLUS_GLFUNC(DrawArraysIndirect)(
+			GLenum(mode),
+			(const void*)std::size_t(first)
+		);
+		OGLPLUS_CHECK(OGLPLUS_ERROR_INFO(DrawArraysIndirect));
+#else
+		assert(!
+			"DrawArraysIndirect required, "
+			"but not supported by the used version of OpenGL!"
+		);
+#endif
+	}
+	else
+	{
+#if OGLPLUS_DOCUMENTATION_ONLY || \
+	GL_VERSION_4_3 || \
+	GL_ARB_multi_draw_indirect
+		OGLPLUS_GLFUNC(MultiDrawArraysIndirect)(
+			GLenum(mode),
+			(const void*)std::size_t(first),
+			GLsizei(count),
+			0
+		);
+		OGLPLUS_CHECK(OGLPLUS_ERROR_INFO(MultiDrawArraysIndirect));
+#else
+		assert(!
+			"MultiDrawArraysIndirect required, "
+			"but not supported by the used version of OpenGL!"
+		);
+#endif
+	}
+}
+
+OGLPLUS_LIB_FUNC
+void DrawOperation::DrawElementsIndirect_(DataType index_data_type) const
+{
+	SetupPrimitiveRestart_();
+	if(count == 1)
+	{
+#if OGLPLUS_DOCUMENTATION_ONLY || GL_VERSION_4_0 || GL_ARB_draw_indirect
+		OGLPLUS_GLFUNC(DrawElementsIndirect)(
+			GLenum(mode),
+			GLenum(index_data_type),
+			(const void*)std::size_t(first)
+		);
+		OGLPLUS_CHECK(OGLPLUS_ERROR_INFO(DrawElementsIndirect));
+#else
+		OGLPLUS_FAKE_USE(index_data_type);
+		assert(!
+			"DrawElementsIndirect required, "
+			"but not supported by the used version of OpenGL!"
+		);
+#endif
+	}
+	else
+	{
+#if OGLPLUS_DOCUMENTATION_ONLY || \
+	GL_VERSION_4_3 || \
+	GL_ARB_multi_draw_indirect
+		OGLPLUS_GLFUNC(MultiDrawElementsIndirect)(
+			GLenum(mode),
+			GLenum(index_data_type),
+			(const void*)std::size_t(first),
+			GLsizei(count),
+			0
+		);
+		OGLPLUS_CHECK(OGLPLUS_ERROR_INFO(MultiDrawElementsIndirect));
+#else
+		OGLPLUS_FAKE_USE(index_data_type);
+		assert(!
+			"MultiDrawElementsIndirect required, "
+			"but not supported by the used version of OpenGL!"
+		);
+#endif
+	}
+	CleanupPrimitiveRestart_();
+}
+
+OGLPLUS_LIB_FUNC
+DrawingInstructions DrawingInstructions::IndirectInstructions(
+	std::vector<GLuint>& commands,
+	GLuint inst_count,
+	GLuint base_inst
+) const
+{
+	DrawOperationSeq ops;
+	ops.reserve(_ops.size());
+	for(auto i=_ops.begin(), e=_ops.end(); i!=e; ++i)
+	{
+		assert(!i->Indirect());
+		DrawOperation op = *i;
+		op.first = GLuint(commands.size()*sizeof(GLuint));
+		op.count = 1;
+		op.base_vertex = 0;
+		if(i->Indexed())
+		{
+			DrawElementsIndirectCommand command;
+			command.count = i->count;
+			command.instance_count = inst_count;
+			command.first_index = i->first;
+			command.base_vertex = i->BaseVertex();
+			command.base_instance = base_inst;
+			const GLuint* p = reinterpret_cast<const GLuint*>(&command);
+			commands.insert(
+				commands.end(),
+				p, p+sizeof(command)/sizeof(GLuint)
+			);
+			op.method = DrawOperation::Method::DrawElementsIndirect;
+		}
+		else
+		{
+			DrawArraysIndirectCommand command;
+			command.count = i->count;
+			command.instance_count = inst_count;
+			command.first = i->first;
+			command.base_instance = base_inst;
+			const GLuint* p = reinterpret_cast<const GLuint*>(&command);
+			commands.insert(
+				commands.end(),
+				p, p+sizeof(command)/sizeof(GLuint)
+			);
+			op.method = DrawOperation::Method::DrawArraysIndirect;
+		}
+		ops.push_back(op);
+	}
+	return DrawingInstructions(std::move(ops));
+}
+
 } // shapes
 } // oglplus
 
@@ -0,0 +1,610 @@
+/**
+ *  @file oglplus/shapes/lod.ipp
+ *  @brief Implementation of shapes::ShapeSimplifier
+ *
+ *  @author Matus Chochlik
+ *
+ *  Copyright 2010-2013 Matus Chochlik. Distributed under the Boost
+ *  Software License, Version 1.0. (See accompanying file
+ *  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ */
+
+#include <algorithm>
+#include <cmath>
+
+namespace oglplus {
+namespace aux {
+
+inline void LODCross(const GLdouble a[3], const GLdouble b[3], GLdouble r[3])
+{
+	r[0] = a[1]*b[2] - a[2]*b[1];
+	r[1] = a[2]*b[0] - a[0]*b[2];
+	r[2] = a[0]*b[1] - a[1]*b[0];
+}
+
+inline GLdouble LODDot(const GLdouble a[3], const GLdouble b[3])
+{
+	return a[0]*b[0] + a[1]*b[1] + a[2]*b[2];
+}
+
+} // namespace aux
+
+namespace shapes {
+
+OGLPLUS_LIB_FUNC
+void ShapeSimplifier::_weld_vertices(void)
+{
+	const GLuint vert_count = GLuint(_data._main_va.size()/_data._main_vpv);
+	assert(_data._main_weld.size() == vert_count);
+
+	const GLuint face_count = GLuint(_data._face_index.size());
+	_face_verts.resize(face_count*3);
+	for(GLuint f=0; f!=face_count; ++f)
+	{
+		for(GLuint k=0; k!=3; ++k)
+		{
+			_face_verts[f*3+k] =
+				_data._face_verts[_data._face_index[f]+k];
+		}
+	}
+
+	// number the welded vertices referenced by the faces
+	const GLuint none = ~GLuint(0);
+	std::vector<GLuint> root_weld(vert_count, none);
+	std::vector<bool> counted(vert_count, false);
+	_weld.assign(vert_count, none);
+	for(auto i=_face_verts.begin(), e=_face_verts.end(); i!=e; ++i)
+	{
+		// the vertices with the same position have the same root
+		const GLuint root = _data._main_weld[*i];
+		if(root_weld[root] == none)
+		{
+			root_weld[root] = GLuint(_weld_vert.size());
+			_weld_vert.push_back(*i);
+			_weld_size.push_back(0);
+		}
+		_weld[*i] = root_weld[root];
+		if(!counted[*i])
+		{
+			counted[*i] = true;
+			++_weld_size[_weld[*i]];
+		}
+	}
+}
+
+OGLPLUS_LIB_FUNC
+void ShapeSimplifier::_add_quadric(
+	GLuint weld,
+	const GLdouble plane[4],
+	GLdouble w
+)
+{
+	GLdouble* q = _quadrics.data() + weld*10;
+	GLuint n = 0;
+	for(GLuint i=0; i!=4; ++i)
+		for(GLuint j=i; j!=4; ++j)
+			q[n++] += w*plane[i]*plane[j];
+}
+
+OGLPLUS_LIB_FUNC
+GLdouble ShapeSimplifier::_quadric_error(GLuint from, GLuint to) const
+{
+	const GLdouble* qa = _quadrics.data() + from*10;
+	const GLdouble* qb = _quadrics.data() + to*10;
+	const GLdouble p[4] = {_pos(to, 0), _pos(to, 1), _pos(to, 2), 1.0};
+	GLdouble result = 0;
+	GLuint n = 0;
+	for(GLuint i=0; i!=4; ++i)
+	{
+		for(GLuint j=i; j!=4; ++j)
+		{
+			const GLdouble q = qa[n] + qb[n];
+			result += (i == j ? 1 : 2)*q*p[i]*p[j];
+			++n;
+		}
+	}
+	return result > 0 ? result : 0;
+}
+
+OGLPLUS_LIB_FUNC
+GLdouble ShapeSimplifier::_face_area(GLuint face) const
+{
+	GLdouble e1[3], e2[3], n[3];
+	for(GLuint c=0; c!=3; ++c)
+	{
+		e1[c] = _pos(_welded(face, 1), c) - _pos(_welded(face, 0), c);
+		e2[c] = _pos(_welded(face, 2), c) - _pos(_welded(face, 0), c);
+	}
+	aux::LODCross(e1, e2, n);
+	return std::sqrt(aux::LODDot(n, n))*0.5;
+}
+
+OGLPLUS_LIB_FUNC
+GLdouble ShapeSimplifier::_attrib_error(
+	GLuint from,
+	GLuint to,
+	GLuint target
+) const
+{
+	// the attributes of the removed vertex are compared with
+	// the values interpolated at its position by the face
+	// (after the collapse) that covers that position the best
+	const GLuint none = ~GLuint(0);
+	GLuint best_face = none;
+	GLdouble best_min = 0, best_bc[3] = {0, 0, 0};
+	const std::vector<GLuint>& faces = _vert_faces[from];
+	for(auto i=faces.begin(), e=faces.end(); i!=e; ++i)
+	{
+		GLdouble q[3][3];
+		bool has_to = false;
+		for(GLuint k=0; k!=3; ++k)
+		{
+			GLuint w = _welded(*i, k);
+			if(w == to) has_to = true;
+			if(w == from) w = to;
+			for(GLuint c=0; c!=3; ++c)
+				q[k][c] = _pos(w, c);
+		}
+		if(has_to) continue;
+
+		GLdouble e1[3], e2[3], n[3], a[3], b[3], m[3], bc[3];
+		for(GLuint c=0; c!=3; ++c)
+		{
+			e1[c] = q[1][c] - q[0][c];
+			e2[c] = q[2][c] - q[0][c];
+		}
+		aux::LODCross(e1, e2, n);
+		const GLdouble nn = aux::LODDot(n, n);
+		if(nn <= 0) continue;
+		for(GLuint k=0; k!=3; ++k)
+		{
+			const GLuint k1 = (k+1)%3, k2 = (k+2)%3;
+			for(GLuint c=0; c!=3; ++c)
+			{
+				a[c] = q[k2][c] - q[k1][c];
+				b[c] = _pos(from, c) - q[k1][c];
+			}
+			aux::LODCross(a, b, m);
+			bc[k] = aux::LODDot(m, n)/nn;
+		}
+		const GLdouble bc_min = std::min(bc[0], std::min(bc[1], bc[2]));
+		if((best_face == none) || (best_min < bc_min))
+		{
+			best_face = *i;
+			best_min = bc_min;
+			GLdouble sum = 0;
+			for(GLuint k=0; k!=3; ++k)
+				sum += (best_bc[k] = std::max(bc[k], GLdouble(0)));
+			for(GLuint k=0; k!=3; ++k)
+				best_bc[k] /= sum;
+		}
+	}
+
+	const GLuint source = _weld_vert[from];
+	GLdouble result = 0;
+	for(std::size_t a=0, n=_attribs.size(); a!=n; ++a)
+	{
+		const std::vector<GLdouble>& v = *_attribs[a];
+		const GLuint vpv = _attrib_vpvs[a];
+		for(GLuint c=0; c!=vpv; ++c)
+		{
+			GLdouble value = v[target*vpv+c];
+			if(best_face != none)
+			{
+				value = 0;
+				for(GLuint k=0; k!=3; ++k)
+				{
+					GLuint vert = _face_verts[best_face*3+k];
+					if(_weld[vert] == from) vert = target;
+					value += best_bc[k]*v[vert*vpv+c];
+				}
+			}
+			const GLdouble d = v[source*vpv+c] - value;
+			result += d*d;
+		}
+	}
+	return result;
+}
+
+OGLPLUS_LIB_FUNC
+void ShapeSimplifier::_init_quadrics(void)
+{
+	const GLuint weld_count = GLuint(_weld_vert.size());
+	const GLuint face_count = GLuint(_face_verts.size()/3);
+	_quadrics.assign(weld_count*10, 0.0);
+	_border.assign(weld_count, false);
+	_vert_faces.resize(weld_count);
+
+	for(GLuint f=0; f!=face_count; ++f)
+	{
+		// the faces degenerated by welding are not drawn
+		if(	(_welded(f, 0) == _welded(f, 1)) ||
+			(_welded(f, 1) == _welded(f, 2)) ||
+			(_welded(f, 2) == _welded(f, 0))
+		)
+		{
+			_face_removed[f] = true;
+			--_face_count;
+			continue;
+		}
+		GLdouble p[3][3];
+		for(GLuint k=0; k!=3; ++k)
+			for(GLuint c=0; c!=3; ++c)
+				p[k][c] = _pos(_welded(f, k), c);
+		GLdouble e1[3], e2[3], n[3];
+		for(GLuint c=0; c!=3; ++c)
+		{
+			e1[c] = p[1][c] - p[0][c];
+			e2[c] = p[2][c] - p[0][c];
+		}
+		aux::LODCross(e1, e2, n);
+		const GLdouble len = std::sqrt(aux::LODDot(n, n));
+		for(GLuint k=0; k!=3; ++k)
+			_vert_faces[_welded(f, k)].push_back(f);
+		if(len <= 0) continue;
+		for(GLuint c=0; c!=3; ++c)
+			n[c] /= len;
+
+		const GLdouble plane[4] = {n[0], n[1], n[2], -aux::LODDot(n, p[0])};
+		for(GLuint k=0; k!=3; ++k)
+			_add_quadric(_welded(f, k), plane, len*0.5);
+
+		// the borders are kept by planes perpendicular to the faces
+		for(GLuint k=0; k!=3; ++k)
+		{
+			const GLuint i = _data._face_index[f]+k;
+			if(_data._face_adj_f[i] != ShapeAnalyzerGraphData::_nil_face())
+				continue;
+			const GLuint k1 = (k+1)%3;
+			GLdouble e[3], m[3];
+			for(GLuint c=0; c!=3; ++c)
+				e[c] = p[k1][c] - p[k][c];
+			aux::LODCross(e, n, m);
+			const GLdouble el = std::sqrt(aux::LODDot(m, m));
+			if(el <= 0) continue;
+			for(GLuint c=0; c!=3; ++c)
+				m[c] /= el;
+			const GLdouble border[4] = {
+				m[0], m[1], m[2],
+				-aux::LODDot(m, p[k])
+			};
+			const GLdouble w = 10.0*aux::LODDot(e, e);
+			_add_quadric(_welded(f, k), border, w);
+			_add_quadric(_welded(f, k1), border, w);
+			_border[_welded(f, k)] = true;
+			_border[_welded(f, k1)] = true;
+		}
+	}
+}
+
+OGLPLUS_LIB_FUNC
+GLuint ShapeSimplifier::_target_vertex(
+	GLuint from,
+	GLuint to,
+	GLuint& shared
+) const
+{
+	const GLuint none = ~GLuint(0);
+	GLuint result = none;
+	shared = 0;
+	const std::vector<GLuint>& faces = _vert_faces[from];
+	for(auto i=faces.begin(), e=faces.end(); i!=e; ++i)
+	{
+		for(GLuint k=0; k!=3; ++k)
+		{
+			if(_welded(*i, k) != to) continue;
+			const GLuint vert = _face_verts[*i*3+k];
+			// the faces along the edge must not be separated
+			// by an attribute seam at the target vertex
+			if((result != none) && (result != vert))
+				return none;
+			result = vert;
+			++shared;
+		}
+	}
+	return result;
+}
+
+OGLPLUS_LIB_FUNC
+bool ShapeSimplifier::_check_link(GLuint from, GLuint to, GLuint shared) const
+{
+	// the vertices adjacent to both collapsed vertices must be
+	// only the vertices opposite to the collapsed edge
+	std::vector<GLuint> adj_from, adj_to;
+	const std::vector<GLuint>& ff = _vert_faces[from];
+	for(auto i=ff.begin(), e=ff.end(); i!=e; ++i)
+		for(GLuint k=0; k!=3; ++k)
+			adj_from.push_back(_welded(*i, k));
+	const std::vector<GLuint>& tf = _vert_faces[to];
+	for(auto i=tf.begin(), e=tf.end(); i!=e; ++i)
+		for(GLuint k=0; k!=3; ++k)
+			adj_to.push_back(_welded(*i, k));
+	std::sort(adj_from.begin(), adj_from.end());
+	adj_from.erase(
+		std::unique(adj_from.begin(), adj_from.end()),
+		adj_from.end()
+	);
+	std::sort(adj_to.begin(), adj_to.end());
+	adj_to.erase(std::unique(adj_to.begin(), adj_to.end()), adj_to.end());
+
+	GLuint common = 0;
+	auto i = adj_from.begin(), j = adj_to.begin();
+	while((i != adj_from.end()) && (j != adj_to.end()))
+	{
+		if(*i < *j) ++i;
+		else if(*j < *i) ++j;
+		else
+		{
+			if((*i != from) && (*i != to))
+				++common;
+			++i;
+			++j;
+		}
+	}
+	return common == shared;
+}
+
+OGLPLUS_LIB_FUNC
+bool ShapeSimplifier::_check_flips(GLuint from, GLuint to) const
+{
+	const std::vector<GLuint>& faces = _vert_faces[from];
+	for(auto i=faces.begin(), e=faces.end(); i!=e; ++i)
+	{
+		GLdouble p[3][3], q[3][3];
+		bool has_to = false;
+		for(GLuint k=0; k!=3; ++k)
+		{
+			const GLuint w = _welded(*i, k);
+			if(w == to) has_to = true;
+			for(GLuint c=0; c!=3; ++c)
+			{
+				p[k][c] = _pos(w, c);
+				q[k][c] = (w == from)?_pos(to, c):p[k][c];
+			}
+		}
+		// the faces along the edge are removed
+		if(has_to) continue;
+
+		GLdouble e1[3], e2[3], n0[3], n1[3];
+		for(GLuint c=0; c!=3; ++c)
+		{
+			e1[c] = p[1][c] - p[0][c];
+			e2[c] = p[2][c] - p[0][c];
+		}
+		aux::LODCross(e1, e2, n0);
+		for(GLuint c=0; c!=3; ++c)
+		{
+			e1[c] = q[1][c] - q[0][c];
+			e2[c] = q[2][c] - q[0][c];
+		}
+		aux::LODCross(e1, e2, n1);
+		const GLdouble d = aux::LODDot(n0, n1);
+		// reject flipped and degenerate faces
+		if(d <= 1e-6*aux::LODDot(n0, n0))
+			return false;
+	}
+	return true;
+}
+
+OGLPLUS_LIB_FUNC
+bool ShapeSimplifier::_collapse_cost(
+	GLuint from,
+	GLuint to,
+	GLdouble& cost
+) const
+{
+	if((from == to) || _removed[from] || _removed[to])
+		return false;
+	// the vertices on attribute seams are kept
+	if(_weld_size[from] != 1)
+		return false;
+
+	GLuint shared = 0;
+	const GLuint target = _target_vertex(from, to, shared);
+	if(target == ~GLuint(0))
+		return false;
+	// the border vertices can move only along the border
+	if(_border[from])
+	{
+		if((shared != 1) || !_border[to])
+			return false;
+	}
+	else if(shared != 2) return false;
+
+	if(!_check_link(from, to, shared))
+		return false;
+	if(!_check_flips(from, to))
+		return false;
+
+	cost = _quadric_error(from, to);
+	if(!_attribs.empty())
+	{
+		GLdouble area = 0;
+		const std::vector<GLuint>& faces = _vert_faces[from];
+		for(auto i=faces.begin(), e=faces.end(); i!=e; ++i)
+			area += _face_area(*i);
+		cost += _attrib_weight*area*_attrib_error(from, to, target);
+	}
+	return true;
+}
+
+OGLPLUS_LIB_FUNC
+void ShapeSimplifier::_push_collapse(GLuint from, GLuint to)
+{
+	_collapse collapse;
+	if(_collapse_cost(from, to, collapse.cost))
+	{
+		collapse.from = from;
+		collapse.to = to;
+		collapse.from_version = _version[from];
+		collapse.to_version = _version[to];
+		_heap.push_back(collapse);
+		std::push_heap(_heap.begin(), _heap.end());
+	}
+}
+
+OGLPLUS_LIB_FUNC
+void ShapeSimplifier::_push_collapses(GLuint weld)
+{
+	const std::vector<GLuint> faces = _vert_faces[weld];
+	for(auto i=faces.begin(), e=faces.end(); i!=e; ++i)
+	{
+		for(GLuint k=0; k!=3; ++k)
+		{
+			const GLuint other = _welded(*i, k);
+			if(other == weld) continue;
+			_push_collapse(weld, other);
+			_push_collapse(other, weld);
+		}
+	}
+}
+
+OGLPLUS_LIB_FUNC
+void ShapeSimplifier::_do_collapse(GLuint from, GLuint to)
+{
+	GLuint shared = 0;
+	const GLuint target = _target_vertex(from, to, shared);
+	assert(target != ~GLuint(0));
+
+	std::vector<GLuint>& faces = _vert_faces[from];
+	for(auto i=faces.begin(), e=faces.end(); i!=e; ++i)
+	{
+		bool has_to = false;
+		for(GLuint k=0; k!=3; ++k)
+			if(_welded(*i, k) == to) has_to = true;
+		if(has_to)
+		{
+			_face_removed[*i] = true;
+			--_face_count;
+			for(GLuint k=0; k!=3; ++k)
+			{
+				const GLuint w = _welded(*i, k);
+				if(w == from) continue;
+				std::vector<GLuint>& wf = _vert_faces[w];
+				wf.erase(std::remove(wf.begin(), wf.end(), *i), wf.end());
+			}
+		}
+		else
+		{
+			for(GLuint k=0; k!=3; ++k)
+			{
+				if(_welded(*i, k) == from)
+					_face_verts[*i*3+k] = target;
+			}
+			_vert_faces[to].push_back(*i);
+		}
+	}
+	faces.clear();
+	_removed[from] = true;
+	for(GLuint n=0; n!=10; ++n)
+		_quadrics[to*10+n] += _quadrics[from*10+n];
+	++_version[to];
+	_push_collapses(to);
+}
+
+OGLPLUS_LIB_FUNC
+ShapeSimplifier::ShapeSimplifier(
+	const ShapeAnalyzerGraphData& data,
+	GLdouble attrib_weight
+): _data(data)
+ , _face_count(GLuint(data._face_index.size()))
+ , _attrib_weight(attrib_weight)
+{
+	assert(_data._main_vpv >= 3);
+	_face_removed.assign(_face_count, false);
+	_weld_vertices();
+	_init_quadrics();
+	_removed.assign(_weld_vert.size(), false);
+	_version.assign(_weld_vert.size(), 0);
+}
+
+OGLPLUS_LIB_FUNC
+void ShapeSimplifier::AddAttrib(
+	const std::vector<GLdouble>& values,
+	GLuint values_per_vertex
+)
+{
+	assert(values_per_vertex > 0);
+	assert(values.size() >= _weld.size()*values_per_vertex);
+	_attribs.push_back(&values);
+	_attrib_vpvs.push_back(values_per_vertex);
+	// the costs of the collapses must be recalculated
+	_heap.clear();
+}
+
+OGLPLUS_LIB_FUNC
+GLdouble ShapeSimplifier::Simplify(
+	const LODLevel& level,
+	std::vector<GLuint>& indices
+)
+{
+	if(_heap.empty())
+	{
+		for(GLuint w=0, n=GLuint(_weld_vert.size()); w!=n; ++w)
+		{
+			const std::vector<GLuint>& faces = _vert_faces[w];
+			for(auto i=faces.begin(), e=faces.end(); i!=e; ++i)
+			{
+				for(GLuint k=0; k!=3; ++k)
+				{
+					if(_welded(*i, k) != w)
+						_push_collapse(w, _welded(*i, k));
+				}
+			}
+		}
+	}
+
+	GLdouble result = 0;
+	while((_face_count > level.max_triangles) && !_heap.empty())
+	{
+		const _collapse top = _heap.front();
+		if(	_removed[top.from] ||
+			_removed[top.to] ||
+			(_version[top.from] != top.from_version) ||
+			(_version[top.to] != top.to_version)
+		)
+		{
+			std::pop_heap(_heap.begin(), _heap.end());
+			_heap.pop_back();
+			continue;
+		}
+		// the neighborhood of the vertices might have changed
+		GLdouble cost = 0;
+		if(!_collapse_cost(top.from, top.to, cost))
+		{
+			std::pop_heap(_heap.begin(), _heap.end());
+			_heap.pop_back();
+			continue;
+		}
+		if(cost > top.cost)
+		{
+			std::pop_heap(_heap.begin(), _heap.end());
+			_heap.back().cost = cost;
+			std::push_heap(_heap.begin(), _heap.end());
+			continue;
+		}
+		if(cost > level.max_error)
+			break;
+
+		std::pop_heap(_heap.begin(), _heap.end());
+		_heap.pop_back();
+		_do_collapse(top.from, top.to);
+		if(result < cost) result = cost;
+	}
+
+	for(GLuint f=0, n=GLuint(_face_removed.size()); f!=n; ++f)
+	{
+		if(!_face_removed[f])
+		{
+			indices.insert(
+				indices.end(),
+				_face_verts.begin()+f*3,
+				_face_verts.begin()+f*3+3
+			);
+		}
+	}
+	return result;
+}
+
+} // shapes
+} // oglplus
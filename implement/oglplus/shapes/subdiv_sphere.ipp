@@ -9,76 +9,182 @@
  *  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
  */
 
+#include <oglplus/math.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cassert>
+
 namespace oglplus {
 namespace shapes {
 
 OGLPLUS_LIB_FUNC
-GLuint SimpleSubdivSphere::_midpoint(GLuint ia, GLuint ib)
+void SimpleSubdivSphere::_subdivide(void)
 {
-	GLuint ea=ia<ib?ia:ib;
-	GLuint eb=ia>ib?ia:ib;
+	const GLuint vert_count = GLuint(_positions.size()/3);
+	const GLuint face_count = GLuint(_indices.size()/3);
+	// the initial shapes are closed so by Euler's formula
+	// there is one new vertex for each of the V+F-2 edges
+	const GLuint edge_count = vert_count + face_count - 2;
 
-	_edge e(ea,eb);
+	// the open-addressing table mapping the edges to their midpoints
+	GLuint table_size = 1;
+	while(table_size < edge_count*2) table_size <<= 1;
+	const GLuint mask = table_size - 1;
+	const GLuint none = ~GLuint(0);
+	std::vector<GLuint> edge_keys(table_size*2, none);
+	std::vector<GLuint> edge_mids(table_size);
 
-	auto p = _midpoints.find(e);
-	if(p == _midpoints.end())
-	{
-		Vec3d va(_positions.data()+ea*3, 3);
-		Vec3d vb(_positions.data()+eb*3, 3);
-		Vec3f mp = Normalized((va+vb)*0.5);
-		GLuint result = _positions.size();
+	_positions.resize((vert_count + edge_count)*3);
+	std::vector<GLuint> indices(face_count*4*3);
+	GLuint next_vert = vert_count;
 
-		_positions.insert(_positions.end(), mp.Data(), mp.Data()+3);
+	for(GLuint f=0; f!=face_count; ++f)
+	{
+		const GLuint* face = _indices.data() + f*3;
+		GLuint mid[3];
+		for(GLuint k=0; k!=3; ++k)
+		{
+			const GLuint ia = face[k];
+			const GLuint ib = face[(k+1)%3];
+			const GLuint ea = ia<ib?ia:ib;
+			const GLuint eb = ia<ib?ib:ia;
 
-		assert(result % 3 == 0);
-		result /= 3;
+			GLuint slot = ((ea*2654435761u)^(eb*40503u)) & mask;
+			while(	(edge_keys[slot*2+0] != none) && (
+					(edge_keys[slot*2+0] != ea) ||
+					(edge_keys[slot*2+1] != eb)
+				)
+			) slot = (slot + 1) & mask;
 
-		_midpoints[e] = result;
+			if(edge_keys[slot*2+0] == none)
+			{
+				assert(next_vert < vert_count + edge_count);
+				edge_keys[slot*2+0] = ea;
+				edge_keys[slot*2+1] = eb;
+				edge_mids[slot] = next_vert;
 
-		return result;
-	}
-	else
-	{
-		return p->second;
+				const GLdouble* pa = _positions.data()+ea*3;
+				const GLdouble* pb = _positions.data()+eb*3;
+				GLdouble* pm = _positions.data()+next_vert*3;
+				GLdouble len = 0;
+				for(GLuint c=0; c!=3; ++c)
+				{
+					pm[c] = pa[c] + pb[c];
+					len += pm[c]*pm[c];
+				}
+				len = std::sqrt(len);
+				for(GLuint c=0; c!=3; ++c)
+					pm[c] /= len;
+				++next_vert;
+			}
+			mid[k] = edge_mids[slot];
+		}
+		const GLuint iab = mid[0], ibc = mid[1], ica = mid[2];
+		const GLuint faces[4*3] = {
+			iab, ibc, ica,
+			ica, face[0], iab,
+			iab, face[1], ibc,
+			ibc, face[2], ica
+		};
+		std::copy(faces, faces+4*3, indices.begin()+f*4*3);
 	}
+	assert(next_vert == vert_count + edge_count);
+	_indices.swap(indices);
 }
 
 OGLPLUS_LIB_FUNC
-void SimpleSubdivSphere::_subdivide(
-	GLuint ia,
-	GLuint ib,
-	GLuint ic,
-	GLuint levels
-)
+void SimpleSubdivSphere::_make_tex_coords(void)
 {
-	GLuint iab = _midpoint(ia, ib);
-	GLuint ibc = _midpoint(ib, ic);
-	GLuint ica = _midpoint(ic, ia);
-
-	_make_face(iab,ibc, ica, levels);
-	_make_face(ica, ia, iab, levels);
-	_make_face(iab, ib, ibc, levels);
-	_make_face(ibc, ic, ica, levels);
+	const GLuint vert_count = GLuint(_positions.size()/3);
+	const GLuint face_count = GLuint(_indices.size()/3);
+	const GLdouble inv_2pi = 1.0 / math::TwoPi();
+	const GLdouble inv_pi = 1.0 / math::Pi();
+
+	_tex_coords.resize(vert_count*2);
+	std::vector<bool> pole(vert_count);
+	for(GLuint v=0; v!=vert_count; ++v)
+	{
+		const GLdouble* p = _positions.data()+v*3;
+		GLdouble s = std::atan2(-p[2], p[0]) * inv_2pi;
+		if(s < 0) s += 1.0;
+		const GLdouble y = (p[1]<-1.0)?-1.0:(p[1]>1.0?1.0:p[1]);
+		_tex_coords[v*2+0] = s;
+		_tex_coords[v*2+1] = 1.0 - std::acos(y) * inv_pi;
+		pole[v] = (p[0]*p[0] + p[2]*p[2]) < 1e-12;
+	}
+
+	// duplicates vertex v with the specified s texture coordinate
+	auto duplicate = [this](GLuint v, GLdouble s) -> GLuint
+	{
+		const GLuint result = GLuint(_positions.size()/3);
+		for(GLuint c=0; c!=3; ++c)
+			_positions.push_back(_positions[v*3+c]);
+		_tex_coords.push_back(s);
+		_tex_coords.push_back(_tex_coords[v*2+1]);
+		return result;
+	};
+
+	const GLuint none = ~GLuint(0);
+	std::vector<GLuint> wrapped(vert_count, none);
+	for(GLuint f=0; f!=face_count; ++f)
+	{
+		GLuint* face = _indices.data() + f*3;
+		GLdouble s_min = 1.0, s_max = 0.0;
+		for(GLuint k=0; k!=3; ++k)
+		{
+			if(pole[face[k]]) continue;
+			const GLdouble s = _tex_coords[face[k]*2];
+			if(s_min > s) s_min = s;
+			if(s_max < s) s_max = s;
+		}
+		// the faces crossing the seam use copies of the vertices
+		// on the s=0 side with the s coordinate shifted by 1
+		if(s_max - s_min > 0.5)
+		{
+			for(GLuint k=0; k!=3; ++k)
+			{
+				const GLuint v = face[k];
+				if(pole[v] || (_tex_coords[v*2] >= 0.5))
+					continue;
+				if(wrapped[v] == none)
+				{
+					wrapped[v] = duplicate(
+						v,
+						_tex_coords[v*2]+1.0
+					);
+				}
+				face[k] = wrapped[v];
+			}
+		}
+		// each face gets its own copy of the pole vertex with the s
+		// coordinate in the middle of the other two vertices
+		for(GLuint k=0; k!=3; ++k)
+		{
+			if((face[k] >= vert_count) || !pole[face[k]])
+				continue;
+			const GLdouble s = 0.5*(
+				_tex_coords[face[(k+1)%3]*2]+
+				_tex_coords[face[(k+2)%3]*2]
+			);
+			face[k] = duplicate(face[k], s);
+		}
+	}
 }
 
 OGLPLUS_LIB_FUNC
-void SimpleSubdivSphere::_make_face(
-	GLuint ia,
-	GLuint ib,
-	GLuint ic,
-	GLuint levels
-)
+void SimpleSubdivSphere::_make(void)
 {
-	if(levels)
+	// the coordinates of the initial vertices may be rounded
+	for(auto p=_positions.begin(), e=_positions.end(); p!=e; p+=3)
 	{
-		_subdivide(ia, ib, ic, levels-1);
-	}
-	else
-	{
-		_indices.push_back(ia);
-		_indices.push_back(ib);
-		_indices.push_back(ic);
+		const GLdouble len = std::sqrt(p[0]*p[0]+p[1]*p[1]+p[2]*p[2]);
+		for(GLuint c=0; c!=3; ++c)
+			p[c] /= len;
 	}
+	for(GLuint l=0; l!=_subdivs; ++l)
+		_subdivide();
+	_make_tex_coords();
 }
 
 OGLPLUS_LIB_FUNC
@@ -105,26 +211,30 @@ void SimpleSubdivSphere::_init_icosah(void)
 		init_pos+12*3
 	);
 
-	_make_face( 2,  1,  0, _subdivs);
-	_make_face( 3,  2,  0, _subdivs);
-	_make_face( 4,  3,  0, _subdivs);
-	_make_face( 5,  4,  0, _subdivs);
-	_make_face( 1,  5,  0, _subdivs);
-	_make_face(11,  6,  7, _subdivs);
-	_make_face(11,  7,  8, _subdivs);
-	_make_face(11,  8,  9, _subdivs);
-	_make_face(11,  9, 10, _subdivs);
-	_make_face(11, 10,  6, _subdivs);
-	_make_face( 1,  2,  6, _subdivs);
-	_make_face( 2,  3,  7, _subdivs);
-	_make_face( 3,  4,  8, _subdivs);
-	_make_face( 4,  5,  9, _subdivs);
-	_make_face( 5,  1, 10, _subdivs);
-	_make_face( 2,  7,  6, _subdivs);
-	_make_face( 3,  8,  7, _subdivs);
-	_make_face( 4,  9,  8, _subdivs);
-	_make_face( 5, 10,  9, _subdivs);
-	_make_face( 1,  6, 10, _subdivs);
+	static const GLuint init_idx[20*3] = {
+		 2,  1,  0,
+		 3,  2,  0,
+		 4,  3,  0,
+		 5,  4,  0,
+		 1,  5,  0,
+		11,  6,  7,
+		11,  7,  8,
+		11,  8,  9,
+		11,  9, 10,
+		11, 10,  6,
+		 1,  2,  6,
+		 2,  3,  7,
+		 3,  4,  8,
+		 4,  5,  9,
+		 5,  1, 10,
+		 2,  7,  6,
+		 3,  8,  7,
+		 4,  9,  8,
+		 5, 10,  9,
+		 1,  6, 10
+	};
+
+	_indices.assign(init_idx, init_idx+20*3);
 }
 
 OGLPLUS_LIB_FUNC
@@ -143,10 +253,14 @@ void SimpleSubdivSphere::_init_tetrah(void)
 		init_pos+4*3
 	);
 
-	_make_face( 3, 2, 1, _subdivs);
-	_make_face( 3, 0, 2, _subdivs);
-	_make_face( 1, 0, 3, _subdivs);
-	_make_face( 2, 0, 1, _subdivs);
+	static const GLuint init_idx[4*3] = {
+		 3,  2,  1,
+		 3,  0,  2,
+		 1,  0,  3,
+		 2,  0,  1
+	};
+
+	_indices.assign(init_idx, init_idx+4*3);
 }
 
 OGLPLUS_LIB_FUNC
@@ -170,21 +284,21 @@ void SimpleSubdivSphere::_init_octoh(void)
 	_positions[nz*3+2] = -1;
 
 	// f[0]
-	_make_face(px, py, pz, _subdivs);
+	_indices.insert(_indices.end(), {px, py, pz});
 	// f[1]
-	_make_face(pz, py, nx, _subdivs);
+	_indices.insert(_indices.end(), {pz, py, nx});
 	// f[2]
-	_make_face(nx, ny, pz, _subdivs);
+	_indices.insert(_indices.end(), {nx, ny, pz});
 	// f[3]
-	_make_face(pz, ny, px, _subdivs);
+	_indices.insert(_indices.end(), {pz, ny, px});
 	// f[4]
-	_make_face(nz, py, px, _subdivs);
+	_indices.insert(_indices.end(), {nz, py, px});
 	// f[5]
-	_make_face(nx, py, nz, _subdivs);
+	_indices.insert(_indices.end(), {nx, py, nz});
 	// f[6]
-	_make_face(nz, ny, nx, _subdivs);
+	_indices.insert(_indices.end(), {nz, ny, nx});
 	// f[7]
-	_make_face(px, ny, nz, _subdivs);
+	_indices.insert(_indices.end(), {px, ny, nz});
 }
 
 OGLPLUS_LIB_FUNC
@@ -198,6 +312,7 @@ SimpleSubdivSphere::SimpleSubdivSphere(GLuint subdivs, InitialShape init_shape)
 	else if(init_shape == InitialShape::Tetrahedron)
 		_init_tetrah();
 	else assert(!"Invalid initial shape!");
+	_make();
 }
 
 OGLPLUS_LIB_FUNC
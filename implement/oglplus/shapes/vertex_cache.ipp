@@ -0,0 +1,249 @@
+/**
+ *  @file oglplus/shapes/vertex_cache.ipp
+ *  @brief Implementation of the vertex cache optimization functions
+ *
+ *  @author Matus Chochlik
+ *
+ *  Copyright 2010-2013 Matus Chochlik. Distributed under the Boost
+ *  Software License, Version 1.0. (See accompanying file
+ *  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ */
+
+#include <cmath>
+
+namespace oglplus {
+namespace aux {
+
+// The vertex scoring function from T. Forsyth's algorithm
+inline float VertexCacheScore(
+	int cache_position,
+	GLuint remaining_triangles,
+	unsigned cache_size
+)
+{
+	if(remaining_triangles == 0) return -1.0f;
+	float score = 0.0f;
+	if(cache_position >= 0)
+	{
+		// the vertices of the last triangle are scored equally
+		// to avoid favoring a particular orientation
+		if(cache_position < 3) score = 0.75f;
+		else
+		{
+			const float scaler = 1.0f / (cache_size - 3);
+			score = std::pow(
+				1.0f - (cache_position - 3) * scaler,
+				1.5f
+			);
+		}
+	}
+	// bonus for vertices with few remaining triangles
+	score += 2.0f / std::sqrt(float(remaining_triangles));
+	return score;
+}
+
+} // namespace aux
+
+namespace shapes {
+
+OGLPLUS_LIB_FUNC
+VertexCacheStatistics AnalyzeVertexCache(
+	const std::vector<GLuint>& triangles,
+	unsigned cache_size
+)
+{
+	assert(triangles.size() % 3 == 0);
+	assert(cache_size > 0);
+	VertexCacheStatistics result = {GLuint(triangles.size() / 3), 0, 0};
+
+	GLuint max_index = 0;
+	for(auto i=triangles.begin(), e=triangles.end(); i!=e; ++i)
+		if(max_index < *i) max_index = *i;
+
+	// the time at which each vertex entered the FIFO cache
+	const GLuint never = ~GLuint(0);
+	std::vector<GLuint> cached(triangles.empty()?0:max_index+1, never);
+	for(auto i=triangles.begin(), e=triangles.end(); i!=e; ++i)
+	{
+		if(cached[*i] == never)
+			++result.vertex_count;
+		if(	(cached[*i] == never) ||
+			(result.transform_count - cached[*i] >= cache_size)
+		)
+		{
+			cached[*i] = result.transform_count;
+			++result.transform_count;
+		}
+	}
+	return result;
+}
+
+OGLPLUS_LIB_FUNC
+void OptimizeVertexCache(
+	std::vector<GLuint>& triangles,
+	GLuint vertex_count,
+	unsigned cache_size
+)
+{
+	assert(triangles.size() % 3 == 0);
+	assert(cache_size > 3);
+	const GLuint tri_count = GLuint(triangles.size() / 3);
+	if(tri_count == 0) return;
+
+	// the list of triangles adjacent to each vertex
+	std::vector<GLuint> adj_offs(vertex_count+1, 0);
+	for(auto i=triangles.begin(), e=triangles.end(); i!=e; ++i)
+	{
+		assert(*i < vertex_count);
+		++adj_offs[*i+1];
+	}
+	for(GLuint v=0; v!=vertex_count; ++v)
+		adj_offs[v+1] += adj_offs[v];
+	std::vector<GLuint> adj_tris(triangles.size());
+	std::vector<GLuint> remaining(vertex_count, 0);
+	for(GLuint t=0; t!=tri_count; ++t)
+	{
+		for(GLuint c=0; c!=3; ++c)
+		{
+			const GLuint v = triangles[t*3+c];
+			adj_tris[adj_offs[v]+remaining[v]] = t;
+			++remaining[v];
+		}
+	}
+
+	std::vector<int> cache_pos(vertex_count, -1);
+	std::vector<float> vert_score(vertex_count);
+	for(GLuint v=0; v!=vertex_count; ++v)
+		vert_score[v] = aux::VertexCacheScore(-1, remaining[v], cache_size);
+
+	std::vector<float> tri_score(tri_count);
+	std::vector<bool> tri_added(tri_count, false);
+	for(GLuint t=0; t!=tri_count; ++t)
+	{
+		tri_score[t] =
+			vert_score[triangles[t*3+0]]+
+			vert_score[triangles[t*3+1]]+
+			vert_score[triangles[t*3+2]];
+	}
+
+	// the LRU cache with room for the vertices of one new triangle
+	std::vector<GLuint> cache, new_cache;
+	cache.reserve(cache_size+3);
+	new_cache.reserve(cache_size+3);
+
+	std::vector<GLuint> result;
+	result.reserve(triangles.size());
+
+	GLuint best_tri = 0;
+	float best_score = tri_score[0];
+	for(GLuint t=1; t!=tri_count; ++t)
+	{
+		if(best_score < tri_score[t])
+		{
+			best_score = tri_score[t];
+			best_tri = t;
+		}
+	}
+	// the first triangle that might have not been added yet
+	GLuint scan_pos = 0;
+
+	for(GLuint n=0; n!=tri_count; ++n)
+	{
+		if(best_score < 0.0f)
+		{
+			// no candidate in the cache, take the next unused triangle
+			while(tri_added[scan_pos]) ++scan_pos;
+			best_tri = scan_pos;
+		}
+		assert(!tri_added[best_tri]);
+		tri_added[best_tri] = true;
+
+		new_cache.clear();
+		for(GLuint c=0; c!=3; ++c)
+		{
+			const GLuint v = triangles[best_tri*3+c];
+			result.push_back(v);
+			new_cache.push_back(v);
+			// remove the triangle from the vertex's adjacency list
+			GLuint* b = adj_tris.data()+adj_offs[v];
+			GLuint* e = b+remaining[v];
+			*std::find(b, e, best_tri) = *(e-1);
+			--remaining[v];
+		}
+		for(auto i=cache.begin(), e=cache.end(); i!=e; ++i)
+		{
+			if(	(*i != new_cache[0]) &&
+				(*i != new_cache[1]) &&
+				(*i != new_cache[2])
+			) new_cache.push_back(*i);
+		}
+		cache.swap(new_cache);
+
+		// update the scores of the vertices in the cache
+		for(GLuint p=0; p!=GLuint(cache.size()); ++p)
+		{
+			const GLuint v = cache[p];
+			cache_pos[v] = (p < cache_size)?int(p):-1;
+			vert_score[v] = aux::VertexCacheScore(
+				cache_pos[v],
+				remaining[v],
+				cache_size
+			);
+		}
+
+		// and of their triangles, picking the best one
+		best_score = -1.0f;
+		for(auto i=cache.begin(), e=cache.end(); i!=e; ++i)
+		{
+			const GLuint* b = adj_tris.data()+adj_offs[*i];
+			const GLuint* te = b+remaining[*i];
+			while(b != te)
+			{
+				const GLuint t = *b++;
+				tri_score[t] =
+					vert_score[triangles[t*3+0]]+
+					vert_score[triangles[t*3+1]]+
+					vert_score[triangles[t*3+2]];
+				if(best_score < tri_score[t])
+				{
+					best_score = tri_score[t];
+					best_tri = t;
+				}
+			}
+		}
+		if(cache.size() > cache_size)
+			cache.resize(cache_size);
+	}
+	triangles.swap(result);
+}
+
+OGLPLUS_LIB_FUNC
+std::vector<GLuint> OptimizeVertexFetch(
+	std::vector<GLuint>& indices,
+	GLuint vertex_count
+)
+{
+	const GLuint unused = ~GLuint(0);
+	std::vector<GLuint> remap(vertex_count, unused);
+	std::vector<GLuint> order;
+	order.reserve(vertex_count);
+	for(auto i=indices.begin(), e=indices.end(); i!=e; ++i)
+	{
+		if(*i >= vertex_count) continue;
+		if(remap[*i] == unused)
+		{
+			remap[*i] = GLuint(order.size());
+			order.push_back(*i);
+		}
+		*i = remap[*i];
+	}
+	for(GLuint v=0; v!=vertex_count; ++v)
+	{
+		if(remap[v] == unused)
+			order.push_back(v);
+	}
+	return order;
+}
+
+} // shapes
+} // oglplus
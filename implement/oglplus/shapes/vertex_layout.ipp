@@ -0,0 +1,266 @@
+/**
+ *  @file oglplus/shapes/vertex_layout.ipp
+ *  @brief Implementation of shapes::VertexLayout
+ *
+ *  @author Matus Chochlik
+ *
+ *  Copyright 2010-2013 Matus Chochlik. Distributed under the Boost
+ *  Software License, Version 1.0. (See accompanying file
+ *  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ */
+
+#include <cstring>
+#include <cmath>
+#include <cassert>
+
+namespace oglplus {
+namespace aux {
+
+OGLPLUS_LIB_FUNC
+GLushort FloatToHalf(GLfloat value)
+{
+	GLuint bits;
+	std::memcpy(&bits, &value, sizeof(bits));
+	const GLuint sign = (bits >> 16) & 0x8000;
+	const GLuint magnitude = bits & 0x7FFFFFFF;
+	// infinity or NaN
+	if(magnitude >= 0x7F800000)
+		return GLushort(sign | 0x7C00 | ((magnitude > 0x7F800000)?0x0200:0));
+	// too large, converts to infinity
+	if(magnitude >= 0x47800000)
+		return GLushort(sign | 0x7C00);
+	// converts to zero
+	if(magnitude < 0x33000000)
+		return GLushort(sign);
+
+	GLuint result, rem, half;
+	if(magnitude < 0x38800000)
+	{
+		// converts to a denormalized half
+		const GLuint shift = 126 - (magnitude >> 23);
+		const GLuint mantissa = (magnitude & 0x007FFFFF) | 0x00800000;
+		result = mantissa >> shift;
+		rem = mantissa & ((1u << shift) - 1);
+		half = 1u << (shift - 1);
+	}
+	else
+	{
+		// re-bias the exponent and truncate the mantissa
+		result = (magnitude - 0x38000000) >> 13;
+		rem = magnitude & 0x1FFF;
+		half = 0x1000;
+	}
+	// round to nearest even, the carry can correctly
+	// propagate into the exponent
+	if((rem > half) || ((rem == half) && (result & 1)))
+		++result;
+	return GLushort(sign | result);
+}
+
+OGLPLUS_LIB_FUNC
+GLfloat HalfToFloat(GLushort value)
+{
+	const GLuint sign = GLuint(value & 0x8000) << 16;
+	const GLuint exponent = (value >> 10) & 0x1F;
+	const GLuint mantissa = value & 0x03FF;
+	GLuint bits;
+	if(exponent == 0)
+	{
+		const GLfloat result = std::ldexp(GLfloat(mantissa), -24);
+		return sign?-result:result;
+	}
+	else if(exponent == 0x1F)
+		bits = sign | 0x7F800000 | (mantissa << 13);
+	else bits = sign | ((exponent + 112) << 23) | (mantissa << 13);
+	GLfloat result;
+	std::memcpy(&result, &bits, sizeof(result));
+	return result;
+}
+
+OGLPLUS_LIB_FUNC
+GLint FloatToSnorm(GLfloat value, unsigned bits)
+{
+	assert(bits > 1 && bits <= 32);
+	const GLfloat max = GLfloat((1u << (bits - 1)) - 1);
+	if(!(value > -1.0f)) value = -1.0f;
+	else if(value > 1.0f) value = 1.0f;
+	return GLint(std::floor(value * max + 0.5f));
+}
+
+OGLPLUS_LIB_FUNC
+GLuint PackSnorm2101010Rev(const GLfloat* values, GLuint count)
+{
+	assert(count <= 4);
+	GLuint result = 0;
+	for(GLuint i=0; i!=count; ++i)
+	{
+		const unsigned bits = (i < 3)?10:2;
+		const GLuint mask = (1u << bits) - 1;
+		const GLuint packed = GLuint(FloatToSnorm(values[i], bits));
+		result |= (packed & mask) << (i*10);
+	}
+	return result;
+}
+
+} // namespace aux
+
+namespace shapes {
+
+OGLPLUS_LIB_FUNC
+VertexLayout VertexLayout::Packed(void)
+{
+	VertexLayout result(true);
+	result.AttribFormat("Position", Format::HalfFloat);
+	result.AttribFormat("TexCoord", Format::HalfFloat);
+	result.AttribFormat("Normal", Format::Int_2_10_10_10_Rev);
+	result.AttribFormat("Tangent", Format::Int_2_10_10_10_Rev);
+	result.AttribFormat("Bitangent", Format::Int_2_10_10_10_Rev);
+	return result;
+}
+
+OGLPLUS_LIB_FUNC
+VertexLayout& VertexLayout::AttribFormat(const String& name, Format format)
+{
+	for(auto i=_formats.begin(), e=_formats.end(); i!=e; ++i)
+	{
+		if(i->first == name)
+		{
+			i->second = format;
+			return *this;
+		}
+	}
+	_formats.push_back(std::make_pair(name, format));
+	return *this;
+}
+
+OGLPLUS_LIB_FUNC
+VertexLayout::Format VertexLayout::AttribFormat(const String& name) const
+{
+	Format result = _default_format;
+	for(auto i=_formats.begin(), e=_formats.end(); i!=e; ++i)
+	{
+		if(i->first == name)
+		{
+			result = i->second;
+			break;
+		}
+	}
+#ifndef GL_INT_2_10_10_10_REV
+	if(result == Format::Int_2_10_10_10_Rev)
+		result = Format::NormalizedShort;
+#endif
+	return result;
+}
+
+OGLPLUS_LIB_FUNC
+GLint VertexLayout::ValuesPerVertex(Format format, GLuint values_per_vertex)
+{
+	// the packed format always has four components
+	if(format == Format::Int_2_10_10_10_Rev)
+		return 4;
+	return GLint(values_per_vertex);
+}
+
+OGLPLUS_LIB_FUNC
+DataType VertexLayout::FormatDataType(Format format)
+{
+	switch(format)
+	{
+		case Format::HalfFloat:
+			return DataType::HalfFloat;
+#ifdef GL_INT_2_10_10_10_REV
+		case Format::Int_2_10_10_10_Rev:
+			return DataType::Int_2_10_10_10_Rev;
+#endif
+		case Format::NormalizedShort:
+			return DataType::Short;
+		default:;
+	}
+	return DataType::Float;
+}
+
+OGLPLUS_LIB_FUNC
+bool VertexLayout::Normalized(Format format)
+{
+	return	(format == Format::Int_2_10_10_10_Rev) ||
+		(format == Format::NormalizedShort);
+}
+
+OGLPLUS_LIB_FUNC
+GLuint VertexLayout::Size(Format format, GLuint values_per_vertex)
+{
+	GLuint result;
+	switch(format)
+	{
+		case Format::HalfFloat:
+		case Format::NormalizedShort:
+			result = values_per_vertex*sizeof(GLshort);
+			break;
+		case Format::Int_2_10_10_10_Rev:
+			result = sizeof(GLuint);
+			break;
+		default:
+			result = values_per_vertex*sizeof(GLfloat);
+	}
+	// keep the following attributes aligned to four bytes
+	return (result + 3) & ~GLuint(3);
+}
+
+OGLPLUS_LIB_FUNC
+void VertexLayout::Pack(
+	Format format,
+	GLuint values_per_vertex,
+	const GLfloat* source,
+	GLuint count,
+	GLubyte* dest,
+	GLuint stride
+)
+{
+	assert(stride >= Size(format, values_per_vertex));
+	for(GLuint v=0; v!=count; ++v)
+	{
+		const GLfloat* src = source + v*values_per_vertex;
+		GLubyte* dst = dest + v*stride;
+		switch(format)
+		{
+			case Format::HalfFloat:
+			{
+				for(GLuint i=0; i!=values_per_vertex; ++i)
+				{
+					const GLushort h = aux::FloatToHalf(src[i]);
+					std::memcpy(dst+i*sizeof(h), &h, sizeof(h));
+				}
+				break;
+			}
+			case Format::Int_2_10_10_10_Rev:
+			{
+				const GLuint p = aux::PackSnorm2101010Rev(
+					src,
+					values_per_vertex
+				);
+				std::memcpy(dst, &p, sizeof(p));
+				break;
+			}
+			case Format::NormalizedShort:
+			{
+				for(GLuint i=0; i!=values_per_vertex; ++i)
+				{
+					const GLshort s = GLshort(
+						aux::FloatToSnorm(src[i], 16)
+					);
+					std::memcpy(dst+i*sizeof(s), &s, sizeof(s));
+				}
+				break;
+			}
+			default:
+				std::memcpy(
+					dst,
+					src,
+					values_per_vertex*sizeof(GLfloat)
+				);
+		}
+	}
+}
+
+} // namespace shapes
+} // namespace oglplus
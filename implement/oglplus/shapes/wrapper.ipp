@@ -18,6 +18,10 @@ VertexArray ShapeWrapperBase::VAOForProgram(const ProgramOps& prog) const
 	VertexArray vao;
 	vao.Bind();
 	prog.Use();
+	if(_stride != 0)
+	{
+		_vbos[0].Bind(Buffer::Target::Array);
+	}
 	size_t i=0, n = _names.size();
 	while(i != n)
 	{
@@ -25,9 +29,27 @@ VertexArray ShapeWrapperBase::VAOForProgram(const ProgramOps& prog) const
 		{
 			try
 			{
-				_vbos[i].Bind(Buffer::Target::Array);
 				VertexAttribArray attr(prog, _names[i]);
-				attr.Setup<GLfloat>(_npvs[i]);
+				if(_stride != 0)
+				{
+					attr.Pointer(
+						VertexLayout::ValuesPerVertex(
+							_formats[i],
+							_npvs[i]
+						),
+						VertexLayout::FormatDataType(
+							_formats[i]
+						),
+						VertexLayout::Normalized(_formats[i]),
+						GLsizei(_stride),
+						(void*)std::size_t(_offsets[i])
+					);
+				}
+				else
+				{
+					_vbos[i].Bind(Buffer::Target::Array);
+					attr.Setup<GLfloat>(_npvs[i]);
+				}
 				attr.Enable();
 			}
 			catch(Error&){ }
@@ -37,12 +59,30 @@ VertexArray ShapeWrapperBase::VAOForProgram(const ProgramOps& prog) const
 	assert((i+1) == _npvs.size());
 	if(_npvs[i] != 0)
 	{
-		assert((i+1) == _vbos.size());
-		_vbos[i].Bind(Buffer::Target::ElementArray);
+		_vbos[_vbos.size()-1].Bind(Buffer::Target::ElementArray);
 	}
 	return std::move(vao);
 }
 
+OGLPLUS_LIB_FUNC
+void ShapeWrapperBase::UseIndirect(GLuint inst_count, GLuint base_inst)
+{
+	assert(!IsIndirect());
+	std::vector<GLuint> commands;
+	_shape_instr = _shape_instr.IndirectInstructions(
+		commands,
+		inst_count,
+		base_inst
+	);
+	_indirect.Assign(Buffer());
+	_indirect.Bind(Buffer::Target::DrawIndirect);
+	Buffer::Data(
+		Buffer::Target::DrawIndirect,
+		commands,
+		BufferUsage::DynamicDraw
+	);
+}
+
 } // shapes
 } // oglplus
 
@@ -0,0 +1,167 @@
+/**
+ *  @file oglplus/state_cache.ipp
+ *  @brief Implementation of the GL state cache
+ *
+ *  @author Matus Chochlik
+ *
+ *  Copyright 2010-2013 Matus Chochlik. Distributed under the Boost
+ *  Software License, Version 1.0. (See accompanying file
+ *  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ */
+
+namespace oglplus {
+
+OGLPLUS_LIB_FUNC
+StateCache*& StateCache::_current(void)
+{
+	// each thread has its own current GL context
+	static OGLPLUS_THREAD_LOCAL StateCache* current = nullptr;
+	return current;
+}
+
+OGLPLUS_LIB_FUNC
+std::size_t StateCache::_next_id(void)
+{
+#if !OGLPLUS_NO_THREADS
+	static std::atomic<std::size_t> counter(0);
+#else
+	static std::size_t counter = 0;
+#endif
+	return ++counter;
+}
+
+OGLPLUS_LIB_FUNC
+bool StateCache::_is_redundant(
+	const aux::StateCacheKey& key,
+	const aux::StateCacheValue& value
+)
+{
+	const _entries& entries = _state[key.kind];
+	std::size_t i = _find_entry(entries, key);
+	if((i != entries.size()) && (entries[i].value == value))
+	{
+		++_hits;
+		return true;
+	}
+	++_misses;
+	return false;
+}
+
+OGLPLUS_LIB_FUNC
+void StateCache::_record(
+	const aux::StateCacheKey& key,
+	const aux::StateCacheValue& value
+)
+{
+	_entries& entries = _state[key.kind];
+	std::size_t i = _find_entry(entries, key);
+	if(i != entries.size()) entries[i].value = value;
+	else
+	{
+		_entry new_entry = {key.target, key.index, value};
+		entries.push_back(new_entry);
+	}
+	// the element array buffer binding is a part of the VAO state
+	if(key.kind == aux::StateCacheKey::VertexArray)
+	{
+		aux::StateCacheKey eab = {
+			aux::StateCacheKey::Buffer,
+			GL_ELEMENT_ARRAY_BUFFER,
+			0
+		};
+		_forget(eab);
+	}
+}
+
+OGLPLUS_LIB_FUNC
+bool StateCache::_find(
+	const aux::StateCacheKey& key,
+	aux::StateCacheValue& value
+) const
+{
+	const _entries& entries = _state[key.kind];
+	std::size_t i = _find_entry(entries, key);
+	if(i == entries.size()) return false;
+	value = entries[i].value;
+	return true;
+}
+
+OGLPLUS_LIB_FUNC
+void StateCache::_forget(const aux::StateCacheKey& key)
+{
+	_entries& entries = _state[key.kind];
+	std::size_t i = _find_entry(entries, key);
+	if(i != entries.size())
+	{
+		entries[i] = entries.back();
+		entries.pop_back();
+	}
+}
+
+OGLPLUS_LIB_FUNC
+void StateCache::_forget_all(aux::StateCacheKey::Kind kind)
+{
+	_state[kind].clear();
+}
+
+OGLPLUS_LIB_FUNC
+void StateCache::_forget_all(aux::StateCacheKey::Kind kind, GLenum target)
+{
+	_entries& entries = _state[kind];
+	std::size_t i = 0;
+	while(i != entries.size())
+	{
+		if(entries[i].target == target)
+		{
+			entries[i] = entries.back();
+			entries.pop_back();
+		}
+		else ++i;
+	}
+}
+
+OGLPLUS_LIB_FUNC
+void StateCache::ForgetNames(GLsizei count, const GLuint* names)
+{
+	// the kinds of state whose values are object names
+	const aux::StateCacheKey::Kind kinds[] = {
+		aux::StateCacheKey::Program,
+		aux::StateCacheKey::VertexArray,
+		aux::StateCacheKey::Buffer,
+		aux::StateCacheKey::Texture,
+		aux::StateCacheKey::Sampler
+	};
+	bool forget_eab = false;
+	for(std::size_t k=0; k!=sizeof(kinds)/sizeof(kinds[0]); ++k)
+	{
+		_entries& entries = _state[kinds[k]];
+		std::size_t i = 0;
+		while(i != entries.size())
+		{
+			bool forget = false;
+			for(GLsizei n=0; n!=count; ++n)
+			{
+				if(GLuint(entries[i].value.values[0]) == names[n])
+					forget = true;
+			}
+			if(forget)
+			{
+				if(kinds[k] == aux::StateCacheKey::VertexArray)
+					forget_eab = true;
+				entries[i] = entries.back();
+				entries.pop_back();
+			}
+			else ++i;
+		}
+	}
+	if(forget_eab)
+	{
+		_forget_all(
+			aux::StateCacheKey::Buffer,
+			GL_ELEMENT_ARRAY_BUFFER
+		);
+	}
+}
+
+} // namespace oglplus
+
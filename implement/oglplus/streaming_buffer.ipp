@@ -0,0 +1,167 @@
+/**
+ *  @file oglplus/streaming_buffer.ipp
+ *  @brief Implementation of StreamingBuffer
+ *
+ *  @author Matus Chochlik
+ *
+ *  Copyright 2010-2013 Matus Chochlik. Distributed under the Boost
+ *  Software License, Version 1.0. (See accompanying file
+ *  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ */
+
+#include <oglplus/context/synchronization.hpp>
+
+#include <cstring>
+
+namespace oglplus {
+
+#if OGLPLUS_DOCUMENTATION_ONLY || GL_VERSION_4_4 || GL_ARB_buffer_storage
+
+OGLPLUS_LIB_FUNC
+StreamingBuffer::StreamingBuffer(BufferTarget target, GLsizeiptr size)
+ : _target(target)
+ , _size(size)
+ , _data(nullptr)
+ , _uniform_alignment(1)
+ , _head(0)
+ , _frame_begin(0)
+ , _allocations(0)
+ , _wraps(0)
+ , _stalls(0)
+{
+	assert(_size > 0);
+	const Bitfield<BufferStorageBit> storage_flags({
+		BufferStorageBit::MapWrite,
+		BufferStorageBit::MapPersistent,
+		BufferStorageBit::MapCoherent
+	});
+	const Bitfield<BufferMapAccess> map_access({
+		BufferMapAccess::Write,
+		BufferMapAccess::Persistent,
+		BufferMapAccess::Coherent
+	});
+	// the mapping is not affected by the binding of the buffer
+	// so the target can be rebound right after the buffer is mapped
+	const GLuint prev = BindingQuery<BufferOps>::QueryBinding(_target);
+	_buffer.Bind(_target);
+	Buffer::Storage(_target, _size, nullptr, storage_flags);
+	_map.reset(new Buffer::Map(_target, 0, _size, map_access));
+	_data = _map->Data();
+	_rebind(_target, prev);
+
+	GLint alignment = 0;
+	OGLPLUS_GLFUNC(GetIntegerv)(
+		GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT,
+		&alignment
+	);
+	OGLPLUS_VERIFY(OGLPLUS_ERROR_INFO(GetIntegerv));
+	if(alignment > 0) _uniform_alignment = alignment;
+}
+
+OGLPLUS_LIB_FUNC
+StreamingBuffer::~StreamingBuffer(void)
+{
+	try
+	{
+		// the map unmaps the buffer bound to the target
+		const GLuint prev = BindingQuery<BufferOps>::QueryBinding(_target);
+		_buffer.Bind(_target);
+		_map.reset();
+		_rebind(_target, prev);
+	}
+	catch(...)
+	{ }
+}
+
+OGLPLUS_LIB_FUNC
+void StreamingBuffer::_rebind(BufferTarget target, GLuint name)
+{
+	if(name != 0) Managed<Buffer>(name).Bind(target);
+	else Buffer::Unbind(target);
+}
+
+OGLPLUS_LIB_FUNC
+void StreamingBuffer::_reclaim(GLuint64 end)
+{
+	const GLuint64 size = GLuint64(_size);
+	if(end <= size) return;
+	const GLuint64 limit = end - size;
+	while(!_regions.empty() && (_regions.front().begin < limit))
+	{
+		const Sync& fence = _regions.front().fence;
+		if(!fence.Signaled())
+		{
+			++_stalls;
+			// make sure that the fence gets to the GPU
+			context::Synchronization::Flush();
+			while(
+				fence.ClientWait(1000000000) ==
+				SyncWaitResult::TimeoutExpired
+			);
+		}
+		_regions.pop_front();
+	}
+}
+
+OGLPLUS_LIB_FUNC
+StreamingBuffer::Range StreamingBuffer::Allocate(
+	GLsizeiptr size,
+	GLsizeiptr alignment
+)
+{
+	assert(size > 0);
+	assert(alignment > 0);
+	const GLuint64 buf_size = GLuint64(_size);
+	const GLuint64 offset = _head % buf_size;
+	const GLuint64 align = GLuint64(alignment);
+	const GLuint64 aligned = ((offset + align - 1) / align) * align;
+
+	// the range must not be split at the end of the buffer
+	const bool skip = (aligned + GLuint64(size) > buf_size);
+	const GLuint64 begin = _head - offset + (skip?buf_size:aligned);
+	const GLuint64 end = begin + GLuint64(size);
+	const bool wrap = (_head != 0) && (begin/buf_size != (_head-1)/buf_size);
+
+	// the data of the current frame are not fenced yet
+	// so they must not be overwritten
+	if(end > _frame_begin + buf_size)
+	{
+		HandleLimitError(
+			GLuint(end - _frame_begin),
+			GLuint(_size),
+			OGLPLUS_ERROR_INFO_STR("StreamingBuffer")
+		);
+		return Range(0, 0, nullptr);
+	}
+	if(wrap) ++_wraps;
+	_reclaim(end);
+
+	_head = end;
+	++_allocations;
+	const GLintptr result = GLintptr(begin % buf_size);
+	return Range(result, size, _data + result);
+}
+
+OGLPLUS_LIB_FUNC
+StreamingBuffer::Range StreamingBuffer::Write(
+	const GLvoid* data,
+	GLsizeiptr size,
+	GLsizeiptr alignment
+)
+{
+	Range range = Allocate(size, alignment);
+	if(range.Data()) std::memcpy(range.Data(), data, std::size_t(size));
+	return range;
+}
+
+OGLPLUS_LIB_FUNC
+void StreamingBuffer::EndFrame(void)
+{
+	if(_frame_begin == _head) return;
+	_regions.push_back(_region(_frame_begin, _head));
+	_frame_begin = _head;
+}
+
+#endif // buffer storage
+
+} // namespace oglplus
@@ -47,17 +47,17 @@ private:
 	T _val_rad;
 
 	struct Radians_ { };
-	Angle(T val_rad, Radians_)
+	OGLPLUS_CONSTEXPR_MATH Angle(T val_rad, Radians_)
 	 : _val_rad(val_rad)
 	{ }
 
 	struct Degrees_ { };
-	Angle(T val_deg, Degrees_)
+	OGLPLUS_CONSTEXPR_MATH Angle(T val_deg, Degrees_)
 	 : _val_rad(T(val_deg * (math::Pi() / T(180))))
 	{ }
 public:
 	/// Constructs a zero angle
-	Angle(void)
+	OGLPLUS_CONSTEXPR_MATH Angle(void)
 	 : _val_rad(T(0))
 	{ }
 
@@ -73,18 +73,18 @@ public:
 
 	/// Copy construction from angles using different underlying type
 	template <typename U>
-	Angle(const Angle<U>& other)
+	OGLPLUS_CONSTEXPR_MATH Angle(const Angle<U>& other)
 	 : _val_rad(T(other.Value()))
 	{ }
 
 	/// Constructs a new angle from value in radians
-	static inline Angle Radians(T val_rad)
+	static OGLPLUS_CONSTEXPR_MATH Angle Radians(T val_rad)
 	{
 		return Angle(val_rad, Radians_());
 	}
 
 	/// Constructs a new angle from value in degrees
-	static inline Angle Degrees(T val_deg)
+	static OGLPLUS_CONSTEXPR_MATH Angle Degrees(T val_deg)
 	{
 		return Angle(val_deg, Degrees_());
 	}
@@ -104,61 +104,61 @@ public:
 	}
 
 	/// Returns the value of the angle in radians
-	inline T Value(void) const
+	OGLPLUS_CONSTEXPR_MATH T Value(void) const
 	{
 		return _val_rad;
 	}
 
 	/// Returns the value of the angle in degrees
-	inline T ValueInDegrees(void) const
+	OGLPLUS_CONSTEXPR_MATH T ValueInDegrees(void) const
 	{
 		return _val_rad * T(180 / math::Pi());
 	}
 
 	/// Returns the value of the angle in number of right angles
-	inline T ValueInRightAngles(void) const
+	OGLPLUS_CONSTEXPR_MATH T ValueInRightAngles(void) const
 	{
 		return _val_rad * T(2.0 / math::Pi());
 	}
 
 	/// Returns the value of the angle in number of full circles
-	inline T ValueInFullCircles(void) const
+	OGLPLUS_CONSTEXPR_MATH T ValueInFullCircles(void) const
 	{
 		return _val_rad * T(0.5 / math::Pi());
 	}
 
 	/// Equality comparison
-	friend bool operator == (const Angle& a, const Angle& b)
+	friend OGLPLUS_CONSTEXPR_MATH bool operator == (const Angle& a, const Angle& b)
 	{
 		return a._val_rad == b._val_rad;
 	}
 
 	/// Inequality comparison
-	friend bool operator != (const Angle& a, const Angle& b)
+	friend OGLPLUS_CONSTEXPR_MATH bool operator != (const Angle& a, const Angle& b)
 	{
 		return a._val_rad != b._val_rad;
 	}
 
 	/// Less than comparison
-	friend bool operator <  (const Angle& a, const Angle& b)
+	friend OGLPLUS_CONSTEXPR_MATH bool operator <  (const Angle& a, const Angle& b)
 	{
 		return a._val_rad <  b._val_rad;
 	}
 
 	/// Greater than comparison
-	friend bool operator >  (const Angle& a, const Angle& b)
+	friend OGLPLUS_CONSTEXPR_MATH bool operator >  (const Angle& a, const Angle& b)
 	{
 		return a._val_rad >  b._val_rad;
 	}
 
 	/// Less than/equal comparison
-	friend bool operator <= (const Angle& a, const Angle& b)
+	friend OGLPLUS_CONSTEXPR_MATH bool operator <= (const Angle& a, const Angle& b)
 	{
 		return a._val_rad <= b._val_rad;
 	}
 
 	/// Greater than/equal comparison
-	friend bool operator >= (const Angle& a, const Angle& b)
+	friend OGLPLUS_CONSTEXPR_MATH bool operator >= (const Angle& a, const Angle& b)
 	{
 		return a._val_rad >=  b._val_rad;
 	}
@@ -169,13 +169,13 @@ public:
 #endif
 
 	/// Negation
-	Angle Negated(void) const
+	OGLPLUS_CONSTEXPR_MATH Angle Negated(void) const
 	{
 		return Angle(-this->_val_rad, Radians_());
 	}
 
 	/// Negation operator
-	friend Angle operator - (const Angle& angle)
+	friend OGLPLUS_CONSTEXPR_MATH Angle operator - (const Angle& angle)
 	{
 		return angle.Negated();
 	}
@@ -185,13 +185,13 @@ public:
 	friend Angle Add(const Angle& a, const Angle& b);
 #endif
 
-	static Angle Added(const Angle& a, const Angle& b)
+	static OGLPLUS_CONSTEXPR_MATH Angle Added(const Angle& a, const Angle& b)
 	{
 		return Angle(a._val_rad + b._val_rad, Radians_());
 	}
 
 	/// Addition operator
-	friend Angle operator + (const Angle& a, const Angle& b)
+	friend OGLPLUS_CONSTEXPR_MATH Angle operator + (const Angle& a, const Angle& b)
 	{
 		return Added(a, b);
 	}
@@ -208,13 +208,13 @@ public:
 	friend Angle Subtract(const Angle& a, const Angle& b);
 #endif
 
-	static Angle Subtracted(const Angle& a, const Angle& b)
+	static OGLPLUS_CONSTEXPR_MATH Angle Subtracted(const Angle& a, const Angle& b)
 	{
 		return Angle(a._val_rad - b._val_rad, Radians_());
 	}
 
 	/// Subtraction operator
-	friend Angle operator - (const Angle& a, const Angle& b)
+	friend OGLPLUS_CONSTEXPR_MATH Angle operator - (const Angle& a, const Angle& b)
 	{
 		return Subtracted(a, b);
 	}
@@ -231,19 +231,19 @@ public:
 	friend Angle Multiply(const Angle& a, T mult);
 #endif
 
-	static Angle Multiplied(const Angle& a, T mult)
+	static OGLPLUS_CONSTEXPR_MATH Angle Multiplied(const Angle& a, T mult)
 	{
 		return Angle(a._val_rad * mult, Radians_());
 	}
 
 	/// Multiplication by constant operator
-	friend Angle operator * (const Angle& a, T mult)
+	friend OGLPLUS_CONSTEXPR_MATH Angle operator * (const Angle& a, T mult)
 	{
 		return Multiplied(a, mult);
 	}
 
 	/// Multiplication by constant operator
-	friend Angle operator * (T mult, const Angle& a)
+	friend OGLPLUS_CONSTEXPR_MATH Angle operator * (T mult, const Angle& a)
 	{
 		return Multiplied(a, mult);
 	}
@@ -260,14 +260,14 @@ public:
 	friend Angle Divide(const Angle& a, T div)
 #endif
 
-	static Angle Divided(const Angle& a, T div)
+	static OGLPLUS_CONSTEXPR_MATH Angle Divided(const Angle& a, T div)
 	{
-		assert(div != T(0));
-		return Angle(a._val_rad / div, Radians_());
+		return assert(div != T(0)),
+			Angle(a._val_rad / div, Radians_());
 	}
 
 	/// Division by constant operator
-	friend Angle operator / (const Angle& a, T div)
+	friend OGLPLUS_CONSTEXPR_MATH Angle operator / (const Angle& a, T div)
 	{
 		return Divided(a, div);
 	}
@@ -314,31 +314,31 @@ public:
 };
 
 template <typename T>
-inline Angle<T> Negate(const Angle<T>& a)
+OGLPLUS_CONSTEXPR_MATH Angle<T> Negate(const Angle<T>& a)
 {
 	return a.Negated();
 }
 
 template <typename T>
-inline Angle<T> Add(const Angle<T>& a, const Angle<T>& b)
+OGLPLUS_CONSTEXPR_MATH Angle<T> Add(const Angle<T>& a, const Angle<T>& b)
 {
 	return Angle<T>::Added(a, b);
 }
 
 template <typename T>
-inline Angle<T> Subtract(const Angle<T>& a, const Angle<T>& b)
+OGLPLUS_CONSTEXPR_MATH Angle<T> Subtract(const Angle<T>& a, const Angle<T>& b)
 {
 	return Angle<T>::Subtracted(a, b);
 }
 
 template <typename T>
-inline Angle<T> Multiply(const Angle<T>& a, T v)
+OGLPLUS_CONSTEXPR_MATH Angle<T> Multiply(const Angle<T>& a, T v)
 {
 	return Angle<T>::Multiplied(a, v);
 }
 
 template <typename T>
-inline Angle<T> Divide(const Angle<T>& a, T v)
+OGLPLUS_CONSTEXPR_MATH Angle<T> Divide(const Angle<T>& a, T v)
 {
 	return Angle<T>::Divided(a, v);
 }
@@ -387,7 +387,7 @@ typedef double AngleValueType;
  *
  *  @ingroup math_utils
  */
-inline Angle<AngleValueType> Radians(AngleValueType val_rad)
+OGLPLUS_CONSTEXPR_MATH Angle<AngleValueType> Radians(AngleValueType val_rad)
 {
 	return Angle<AngleValueType>::Radians(val_rad);
 }
@@ -414,7 +414,7 @@ inline Angle<AngleValueType> Radians(AngleValueType val_rad)
  *
  *  @ingroup math_utils
  */
-inline Angle<AngleValueType> Degrees(AngleValueType val_deg)
+OGLPLUS_CONSTEXPR_MATH Angle<AngleValueType> Degrees(AngleValueType val_deg)
 {
 	return Angle<AngleValueType>::Degrees(val_deg);
 }
@@ -442,14 +442,14 @@ inline Angle<AngleValueType> Degrees(AngleValueType val_deg)
  *
  *  @ingroup math_utils
  */
-inline Angle<AngleValueType> FullCircles(AngleValueType value)
+OGLPLUS_CONSTEXPR_MATH Angle<AngleValueType> FullCircles(AngleValueType value)
 {
 	return Angle<AngleValueType>::Radians(
 		AngleValueType(value * math::TwoPi())
 	);
 }
 
-inline Angle<AngleValueType> FullCircle(void)
+OGLPLUS_CONSTEXPR_MATH Angle<AngleValueType> FullCircle(void)
 {
 	return Angle<AngleValueType>::Radians(AngleValueType(math::TwoPi()));
 }
@@ -477,14 +477,14 @@ inline Angle<AngleValueType> FullCircle(void)
  *
  *  @ingroup math_utils
  */
-inline Angle<AngleValueType> RightAngles(AngleValueType value)
+OGLPLUS_CONSTEXPR_MATH Angle<AngleValueType> RightAngles(AngleValueType value)
 {
 	return Angle<AngleValueType>::Radians(
 		AngleValueType(value * math::HalfPi())
 	);
 }
 
-inline Angle<AngleValueType> RightAngle(void)
+OGLPLUS_CONSTEXPR_MATH Angle<AngleValueType> RightAngle(void)
 {
 	return Angle<AngleValueType>::Radians(AngleValueType(math::HalfPi()));
 }
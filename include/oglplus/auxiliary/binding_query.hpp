@@ -30,6 +30,18 @@ public:
 		assert(result >= 0);
 		return GLuint(result);
 	}
+
+	// the name of the bound object for the ErrorInfo
+	static GLuint ErrorInfoName(typename Object::Target target)
+	{
+#if !OGLPLUS_DEFERRED_ERROR_CHECKS
+		return QueryBinding(target);
+#else
+		// the errors are checked later when the binding may be different
+		OGLPLUS_FAKE_USE(target);
+		return 0;
+#endif
+	}
 };
 
 } // namespace oglplus
@@ -9,6 +9,17 @@
  *  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
  */
 
+#if !OGLPLUS_NO_CONSTEXPR_MATH
+	template <typename ... P>
+	constexpr explicit Matrix(T v, P ... p)
+	 : _m{{v, T(p)...}}
+	{
+		static_assert(
+			1 + sizeof...(P) == Rows * Cols,
+			"Invalid number of elements for this matrix type"
+		);
+	}
+#else
 	template <typename ... P>
 	explicit Matrix(T v, P ... p)
 	{
@@ -19,6 +30,7 @@
 		T tmp[Rows * Cols] = {v, T(p)...};
 		std::copy(tmp, tmp+Rows*Cols, this->_m._data);
 	}
+#endif
 private:
 	void _init_rows(std::size_t){ }
 
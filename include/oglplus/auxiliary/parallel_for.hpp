@@ -0,0 +1,124 @@
+/**
+ *  .file oglplus/auxiliary/parallel_for.hpp
+ *  .brief Splitting of loops over large ranges between several threads
+ *
+ *  @author Matus Chochlik
+ *
+ *  Copyright 2010-2013 Matus Chochlik. Distributed under the Boost
+ *  Software License, Version 1.0. (See accompanying file
+ *  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ */
+
+#pragma once
+#ifndef OGLPLUS_AUX_PARALLEL_FOR_1310251530_HPP
+#define OGLPLUS_AUX_PARALLEL_FOR_1310251530_HPP
+
+#include <oglplus/config_compiler.hpp>
+#include <oglplus/strided_span.hpp>
+
+#include <cassert>
+#include <cstddef>
+#include <vector>
+
+#if !OGLPLUS_NO_THREADS
+#include <thread>
+#include <exception>
+#endif
+
+namespace oglplus {
+namespace aux {
+
+// Calls func(begin, end) for consecutive parts of the range [0, count).
+// If max_threads is greater than one, then the range is split into parts
+// (each with at least min_chunk elements) which are processed in parallel
+// and this function waits for all of them to be finished.
+// If func throws in any of the threads, then the exception is rethrown
+// by this function after all the threads are finished (if several
+// parts throw, the exception from the first of them is rethrown).
+template <typename Func>
+inline void ParallelFor(
+	std::size_t count,
+	std::size_t min_chunk,
+	unsigned max_threads,
+	Func func
+)
+{
+#if !OGLPLUS_NO_THREADS
+	if(min_chunk < 1) min_chunk = 1;
+	if(max_threads > count / min_chunk)
+		max_threads = unsigned(count / min_chunk);
+	if(max_threads > 1)
+	{
+		const std::size_t chunk = (count + max_threads - 1) / max_threads;
+		// the exceptions thrown by func in the individual parts
+		std::vector<std::exception_ptr> errors(max_threads);
+		auto call = [func, &errors](
+			std::size_t part,
+			std::size_t begin,
+			std::size_t end
+		) mutable
+		{
+			try { func(begin, end); }
+			catch(...) { errors[part] = std::current_exception(); }
+		};
+		std::vector<std::thread> threads;
+		threads.reserve(max_threads-1);
+		std::size_t offset = chunk;
+		while(offset < count)
+		{
+			const std::size_t end = (offset + chunk < count)?
+				offset + chunk:
+				count;
+			threads.push_back(std::thread(call, offset/chunk, offset, end));
+			offset = end;
+		}
+		call(0, std::size_t(0), chunk);
+		for(auto i=threads.begin(), e=threads.end(); i!=e; ++i)
+			i->join();
+		for(auto i=errors.begin(), e=errors.end(); i!=e; ++i)
+			if(*i) std::rethrow_exception(*i);
+		return;
+	}
+#else
+	OGLPLUS_FAKE_USE(min_chunk);
+	OGLPLUS_FAKE_USE(max_threads);
+#endif
+	func(std::size_t(0), count);
+}
+
+// Calls make_row(row, p) for each of the rows of row_size consecutive
+// tuples in dest, where p points to the first value of the row.
+// The rows are split between up to max_threads threads, so that each
+// thread processes at least several thousands of tuples.
+template <typename T, typename Func>
+inline void ParallelForRows(
+	StridedSpan<T> dest,
+	std::size_t rows,
+	std::size_t row_size,
+	unsigned max_threads,
+	Func make_row
+)
+{
+	assert(row_size > 0);
+	assert(dest.Size() >= rows*row_size);
+	const std::size_t row_step = row_size*dest.Stride();
+	ParallelFor(
+		rows,
+		4096 / row_size + 1,
+		max_threads,
+		[&](std::size_t begin, std::size_t end)
+		{
+			T* p = dest.Data() + begin*row_step;
+			for(std::size_t r=begin; r!=end; ++r)
+			{
+				make_row(r, p);
+				p += row_step;
+			}
+		}
+	);
+}
+
+} // namespace aux
+} // namespace oglplus
+
+#endif // include guard
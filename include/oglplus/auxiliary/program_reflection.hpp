@@ -0,0 +1,184 @@
+/**
+ *  @file oglplus/auxiliary/program_reflection.hpp
+ *  @brief Cache of the active uniforms and uniform blocks of linked programs
+ *
+ *  @author Matus Chochlik
+ *
+ *  Copyright 2010-2013 Matus Chochlik. Distributed under the Boost
+ *  Software License, Version 1.0. (See accompanying file
+ *  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ */
+
+#pragma once
+#ifndef OGLPLUS_AUX_PROGRAM_REFLECTION_1311081530_HPP
+#define OGLPLUS_AUX_PROGRAM_REFLECTION_1311081530_HPP
+
+#include <oglplus/config.hpp>
+#include <oglplus/glfunc.hpp>
+#include <oglplus/error.hpp>
+#include <oglplus/string.hpp>
+
+#include <vector>
+#include <map>
+#include <utility>
+#include <cstring>
+
+#if !OGLPLUS_NO_THREADS
+#include <mutex>
+#endif
+
+namespace oglplus {
+namespace aux {
+
+// Information about an active uniform or an uniform block of a program
+struct ProgramReflectionEntry
+{
+	// the location of the uniform or the index of the uniform block
+	GLint location;
+	// the GLSL type of the uniform (GL_NONE for uniform blocks)
+	GLenum type;
+	// the number of the array elements (1 for non-arrays)
+	GLint size;
+	// the index of the block containing the uniform or -1
+	GLint block_index;
+};
+
+// Flat open-addressing hash table mapping names to reflection entries
+class ProgramReflectionTable
+{
+private:
+	struct _slot
+	{
+		std::size_t hash;
+		std::size_t name_pos;
+		std::size_t name_len;
+		ProgramReflectionEntry entry;
+	};
+	// the names are not empty, empty slots have zero name length
+	std::vector<_slot> _slots;
+	std::vector<GLchar> _names;
+	std::size_t _size;
+
+	static std::size_t _hash(const GLchar* name, std::size_t len)
+	{
+		// FNV-1a
+		std::size_t result = 2166136261u;
+		for(std::size_t i=0; i!=len; ++i)
+		{
+			result ^= std::size_t(GLubyte(name[i]));
+			result *= 16777619u;
+		}
+		return result;
+	}
+
+	bool _matches(
+		const _slot& slot,
+		std::size_t hash,
+		const GLchar* name,
+		std::size_t len
+	) const
+	{
+		return	(slot.hash == hash) &&
+			(slot.name_len == len) &&
+			(std::strncmp(_names.data()+slot.name_pos, name, len) == 0);
+	}
+public:
+	ProgramReflectionTable(void)
+	 : _size(0)
+	{ }
+
+	// prepares the table for the specified number of entries
+	void Reserve(std::size_t count);
+
+	// inserts a new entry, returns false if the name is already present
+	bool Insert(
+		const GLchar* name,
+		std::size_t len,
+		const ProgramReflectionEntry& entry
+	);
+
+	const ProgramReflectionEntry* Find(
+		const GLchar* name,
+		std::size_t len
+	) const;
+
+	std::size_t Size(void) const
+	{
+		return _size;
+	}
+};
+
+// The reflection data of a linked program built on the first lookup
+/* The data is kept until the program is relinked or deleted, so the
+ * initialization of many Uniform(Block)s does not need to query GL
+ * for all active uniforms repeatedly. The program names are unique only
+ * in a context, so the data are kept separately for each context,
+ * identified by the Id of its current StateCache. If no StateCache
+ * is current, then the context cannot be identified and nothing is kept;
+ * FindUniform and FindUniformBlock return false and the callers query
+ * GL directly, FindUniformOrArray gathers the data for the single lookup.
+ * The lookups may be done concurrently from several threads and return
+ * copies of the entries.
+ */
+class ProgramReflection
+{
+private:
+	ProgramReflectionTable _uniforms;
+	ProgramReflectionTable _blocks;
+
+	// the key of a program in the registry: (context, program name)
+	typedef std::pair<std::size_t, GLuint> _key;
+	typedef std::map<_key, ProgramReflection> _registry_map;
+
+	static _registry_map& _registry(void);
+
+	// returns false if the context cannot be identified
+	static bool _make_key(GLuint program, _key& key);
+
+#if !OGLPLUS_NO_THREADS
+	static std::mutex& _mutex(void);
+#endif
+
+	// gathers the data, returns false if the program is not linked
+	bool _init(GLuint program);
+
+	// must be called with the mutex locked, returns the kept data
+	// or nullptr if the program is not linked or no StateCache is current
+	static const ProgramReflection* _get(GLuint program);
+
+	void _init_uniforms(GLuint program);
+	void _init_blocks(GLuint program);
+public:
+	// Finds the active uniform with the specified name
+	static bool FindUniform(
+		GLuint program,
+		const GLchar* identifier,
+		ProgramReflectionEntry& entry
+	);
+
+	// Finds the active uniform or the array that the element belongs to
+	static bool FindUniformOrArray(
+		GLuint program,
+		const GLchar* identifier,
+		ProgramReflectionEntry& entry
+	);
+
+	// Finds the active uniform block with the specified name
+	static bool FindUniformBlock(
+		GLuint program,
+		const GLchar* identifier,
+		ProgramReflectionEntry& entry
+	);
+
+	// Forgets the reflection data when the program is relinked or deleted
+	static void Invalidate(GLuint program);
+};
+
+} // namespace aux
+} // namespace oglplus
+
+#if !OGLPLUS_LINK_LIBRARY || defined(OGLPLUS_IMPLEMENTING_LIBRARY)
+#include <oglplus/auxiliary/program_reflection.ipp>
+#endif // OGLPLUS_LINK_LIBRARY
+
+#endif // include guard
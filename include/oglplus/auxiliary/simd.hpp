@@ -0,0 +1,867 @@
+/**
+ *  .file oglplus/auxiliary/simd.hpp
+ *  .brief Vector and Matrix operation kernels with SIMD specializations
+ *
+ *  @author Matus Chochlik
+ *
+ *  Copyright 2010-2013 Matus Chochlik. Distributed under the Boost
+ *  Software License, Version 1.0. (See accompanying file
+ *  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ */
+
+#pragma once
+#ifndef OGLPLUS_AUX_SIMD_1310171042_HPP
+#define OGLPLUS_AUX_SIMD_1310171042_HPP
+
+#include <oglplus/config_compiler.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <cmath>
+
+#if OGLPLUS_USE_AVX
+#include <immintrin.h>
+#elif OGLPLUS_USE_SSE
+#include <xmmintrin.h>
+#endif
+
+namespace oglplus {
+namespace aux {
+
+// The portable implementations of the element-wise vector operations.
+// All operations work on raw arrays and the result may alias the arguments.
+template <typename T, std::size_t N>
+struct VectorOps
+{
+	static void Negate(T* r, const T* a)
+	{
+		for(std::size_t i=0; i!=N; ++i)
+			r[i] = -a[i];
+	}
+
+	static void Add(T* r, const T* a, const T* b)
+	{
+		for(std::size_t i=0; i!=N; ++i)
+			r[i] = a[i] + b[i];
+	}
+
+	static void Subtract(T* r, const T* a, const T* b)
+	{
+		for(std::size_t i=0; i!=N; ++i)
+			r[i] = a[i] - b[i];
+	}
+
+	static void Multiply(T* r, const T* a, T v)
+	{
+		for(std::size_t i=0; i!=N; ++i)
+			r[i] = a[i] * v;
+	}
+
+	static void Divide(T* r, const T* a, T v)
+	{
+		for(std::size_t i=0; i!=N; ++i)
+			r[i] = a[i] / v;
+	}
+
+	static T Dot(const T* a, const T* b)
+	{
+		T result = a[0] * b[0];
+		for(std::size_t i=1; i!=N; ++i)
+			result += a[i] * b[i];
+		return result;
+	}
+
+	static void Cross(T* r, const T* a, const T* b)
+	{
+		static_assert(N == 3, "Cross product requires 3D vectors");
+		const T r0 = a[1] * b[2] - a[2] * b[1];
+		const T r1 = a[2] * b[0] - a[0] * b[2];
+		const T r2 = a[0] * b[1] - a[1] * b[0];
+		r[0] = r0;
+		r[1] = r1;
+		r[2] = r2;
+	}
+};
+
+// Multiplication of row-major RxN and NxC matrices, r must not alias a or b
+template <typename T, std::size_t R, std::size_t N, std::size_t C>
+struct MatrixMultiplyOp
+{
+	static void Apply(T* r, const T* a, const T* b)
+	{
+		for(std::size_t i=0; i!=R; ++i)
+		for(std::size_t j=0; j!=C; ++j)
+		{
+			T s = a[i*N+0] * b[0*C+j];
+			for(std::size_t k=1; k!=N; ++k)
+				s += a[i*N+k] * b[k*C+j];
+			r[i*C+j] = s;
+		}
+	}
+};
+
+// Transposition of a row-major CxR matrix into a RxC matrix
+template <typename T, std::size_t R, std::size_t C>
+struct MatrixTransposeOp
+{
+	static void Apply(T* r, const T* a)
+	{
+		for(std::size_t i=0; i!=R; ++i)
+		for(std::size_t j=0; j!=C; ++j)
+			r[i*C+j] = a[j*R+i];
+	}
+};
+
+// Multiplication of a row-major RxC matrix by a C-vector (column)
+template <typename T, std::size_t R, std::size_t C>
+struct MatrixVectorMultiplyOp
+{
+	static void Apply(T* r, const T* m, const T* v)
+	{
+		for(std::size_t i=0; i!=R; ++i)
+		{
+			T s = m[i*C+0] * v[0];
+			for(std::size_t j=1; j!=C; ++j)
+				s += m[i*C+j] * v[j];
+			r[i] = s;
+		}
+	}
+};
+
+// Multiplication of a R-vector (row) by a row-major RxC matrix
+template <typename T, std::size_t R, std::size_t C>
+struct VectorMatrixMultiplyOp
+{
+	static void Apply(T* r, const T* v, const T* m)
+	{
+		for(std::size_t j=0; j!=C; ++j)
+		{
+			T s = v[0] * m[0*C+j];
+			for(std::size_t i=1; i!=R; ++i)
+				s += v[i] * m[i*C+j];
+			r[j] = s;
+		}
+	}
+};
+
+// Transforms an array of strided tuples by a row-major 4x4 matrix.
+// The missing input components are 0 for y and z and w for w.
+// The output may alias the input only if both have the same stride.
+template <typename T>
+inline void BulkTransformScalar(
+	const T* m,
+	const T* in,
+	std::size_t in_n,
+	std::size_t in_stride,
+	T w,
+	T* out,
+	std::size_t out_n,
+	std::size_t out_stride,
+	std::size_t count
+)
+{
+	for(std::size_t i=0; i!=count; ++i)
+	{
+		T v[4] = {in[0], T(0), T(0), w};
+		for(std::size_t c=1; c<in_n; ++c)
+			v[c] = in[c];
+		for(std::size_t r=0; r!=out_n; ++r)
+		{
+			out[r] =
+				m[r*4+0]*v[0]+
+				m[r*4+1]*v[1]+
+				m[r*4+2]*v[2]+
+				m[r*4+3]*v[3];
+		}
+		in += in_stride;
+		out += out_stride;
+	}
+}
+
+template <typename T>
+struct BulkTransformOp
+{
+	static void Apply(
+		const T* m,
+		const T* in,
+		std::size_t in_n,
+		std::size_t in_stride,
+		T w,
+		T* out,
+		std::size_t out_n,
+		std::size_t out_stride,
+		std::size_t count
+	)
+	{
+		BulkTransformScalar(
+			m, in, in_n, in_stride, w,
+			out, out_n, out_stride, count
+		);
+	}
+};
+
+// Adjusts the NLERP parameter @p t so that the normalized linear
+// interpolation of two unit quaternions with the absolute value
+// of the dot product @p d closely approximates SLERP
+template <typename T>
+inline T NLERPCorrection(T t, T d)
+{
+	const T a = T(1.0904)+d*(T(-3.2452)+d*(T(3.55645)-d*T(1.43519)));
+	const T b = T(0.848013)+d*(T(-1.06021)+d*T(0.215638));
+	const T h = t-T(0.5);
+	return t + t*h*(t-T(1))*(a*h*h + b);
+}
+
+// Interpolates between the pairs of unit quaternions stored as
+// structures of arrays (the a, x, y, z components in this order)
+// taking the shorter arc, with optional parameter correction.
+template <typename T>
+inline void QuaternionNLERPScalar(
+	const T* const q1[4],
+	const T* const q2[4],
+	const T* t,
+	T* const r[4],
+	std::size_t offset,
+	std::size_t count,
+	bool correct
+)
+{
+	for(std::size_t i=offset; i!=count; ++i)
+	{
+		T d =	q1[0][i]*q2[0][i]+
+			q1[1][i]*q2[1][i]+
+			q1[2][i]*q2[2][i]+
+			q1[3][i]*q2[3][i];
+		const T s = (d < T(0))?T(-1):T(1);
+		d *= s;
+		const T u = correct?NLERPCorrection(t[i], d):t[i];
+		T v[4], l = T(0);
+		for(std::size_t c=0; c!=4; ++c)
+		{
+			v[c] = q1[c][i] + u*(s*q2[c][i] - q1[c][i]);
+			l += v[c]*v[c];
+		}
+		l = T(1)/std::sqrt(l);
+		for(std::size_t c=0; c!=4; ++c)
+			r[c][i] = v[c]*l;
+	}
+}
+
+template <typename T>
+struct QuaternionNLERPOp
+{
+	static void Apply(
+		const T* const q1[4],
+		const T* const q2[4],
+		const T* t,
+		T* const r[4],
+		std::size_t count,
+		bool correct
+	)
+	{
+		QuaternionNLERPScalar(q1, q2, t, r, 0, count, correct);
+	}
+};
+
+// Tests the bounding spheres stored as structures of arrays (the x, y, z
+// coordinates of the centers and the radii) against the six planes
+// (a, b, c, d) with inward-facing normals and sets the bits in the mask
+// of the spheres which are not completely outside of any of the planes.
+template <typename T>
+inline void FrustumCullSpheresScalar(
+	const T* planes,
+	const T* const s[4],
+	std::size_t offset,
+	std::size_t count,
+	std::uint32_t* mask
+)
+{
+	for(std::size_t i=offset; i!=count; ++i)
+	{
+		bool visible = true;
+		for(std::size_t p=0; visible && (p!=6); ++p)
+		{
+			const T* e = planes + p*4;
+			visible =
+				e[0]*s[0][i]+e[1]*s[1][i]+e[2]*s[2][i]+e[3] >=
+				-s[3][i];
+		}
+		if(visible) mask[i/32] |= std::uint32_t(1) << (i%32);
+	}
+}
+
+// Like FrustumCullSpheresScalar but with axis-aligned boxes stored
+// as the coordinates of their centers and their half-extents
+template <typename T>
+inline void FrustumCullBoxesScalar(
+	const T* planes,
+	const T* const c[3],
+	const T* const h[3],
+	std::size_t offset,
+	std::size_t count,
+	std::uint32_t* mask
+)
+{
+	for(std::size_t i=offset; i!=count; ++i)
+	{
+		bool visible = true;
+		for(std::size_t p=0; visible && (p!=6); ++p)
+		{
+			const T* e = planes + p*4;
+			const T r =
+				std::fabs(e[0])*h[0][i]+
+				std::fabs(e[1])*h[1][i]+
+				std::fabs(e[2])*h[2][i];
+			visible =
+				e[0]*c[0][i]+e[1]*c[1][i]+e[2]*c[2][i]+e[3] >= -r;
+		}
+		if(visible) mask[i/32] |= std::uint32_t(1) << (i%32);
+	}
+}
+
+template <typename T>
+struct FrustumCullOp
+{
+	static void Spheres(
+		const T* planes,
+		const T* const s[4],
+		std::size_t count,
+		std::uint32_t* mask
+	)
+	{
+		FrustumCullSpheresScalar(planes, s, 0, count, mask);
+	}
+
+	static void Boxes(
+		const T* planes,
+		const T* const c[3],
+		const T* const h[3],
+		std::size_t count,
+		std::uint32_t* mask
+	)
+	{
+		FrustumCullBoxesScalar(planes, c, h, 0, count, mask);
+	}
+};
+
+#if OGLPLUS_USE_SSE
+
+inline __m128 SSE_Load3f(const float* p)
+{
+	return _mm_set_ps(0.0f, p[2], p[1], p[0]);
+}
+
+inline void SSE_Store3f(float* p, __m128 v)
+{
+	_mm_storel_pi(reinterpret_cast<__m64*>(p), v);
+	_mm_store_ss(p+2, _mm_movehl_ps(v, v));
+}
+
+inline float SSE_HorizontalSum(__m128 v)
+{
+	__m128 s = _mm_add_ps(v, _mm_movehl_ps(v, v));
+	s = _mm_add_ss(s, _mm_shuffle_ps(s, s, _MM_SHUFFLE(1,1,1,1)));
+	return _mm_cvtss_f32(s);
+}
+
+template <>
+struct VectorOps<float, 4>
+{
+	static void Negate(float* r, const float* a)
+	{
+		_mm_storeu_ps(r, _mm_sub_ps(_mm_setzero_ps(), _mm_loadu_ps(a)));
+	}
+
+	static void Add(float* r, const float* a, const float* b)
+	{
+		_mm_storeu_ps(r, _mm_add_ps(_mm_loadu_ps(a), _mm_loadu_ps(b)));
+	}
+
+	static void Subtract(float* r, const float* a, const float* b)
+	{
+		_mm_storeu_ps(r, _mm_sub_ps(_mm_loadu_ps(a), _mm_loadu_ps(b)));
+	}
+
+	static void Multiply(float* r, const float* a, float v)
+	{
+		_mm_storeu_ps(r, _mm_mul_ps(_mm_loadu_ps(a), _mm_set1_ps(v)));
+	}
+
+	static void Divide(float* r, const float* a, float v)
+	{
+		_mm_storeu_ps(r, _mm_div_ps(_mm_loadu_ps(a), _mm_set1_ps(v)));
+	}
+
+	static float Dot(const float* a, const float* b)
+	{
+		return SSE_HorizontalSum(
+			_mm_mul_ps(_mm_loadu_ps(a), _mm_loadu_ps(b))
+		);
+	}
+};
+
+template <>
+struct VectorOps<float, 3>
+{
+	static void Negate(float* r, const float* a)
+	{
+		SSE_Store3f(r, _mm_sub_ps(_mm_setzero_ps(), SSE_Load3f(a)));
+	}
+
+	static void Add(float* r, const float* a, const float* b)
+	{
+		SSE_Store3f(r, _mm_add_ps(SSE_Load3f(a), SSE_Load3f(b)));
+	}
+
+	static void Subtract(float* r, const float* a, const float* b)
+	{
+		SSE_Store3f(r, _mm_sub_ps(SSE_Load3f(a), SSE_Load3f(b)));
+	}
+
+	static void Multiply(float* r, const float* a, float v)
+	{
+		SSE_Store3f(r, _mm_mul_ps(SSE_Load3f(a), _mm_set1_ps(v)));
+	}
+
+	static void Divide(float* r, const float* a, float v)
+	{
+		SSE_Store3f(r, _mm_div_ps(SSE_Load3f(a), _mm_set1_ps(v)));
+	}
+
+	static float Dot(const float* a, const float* b)
+	{
+		return SSE_HorizontalSum(
+			_mm_mul_ps(SSE_Load3f(a), SSE_Load3f(b))
+		);
+	}
+
+	static void Cross(float* r, const float* a, const float* b)
+	{
+		const __m128 va = SSE_Load3f(a);
+		const __m128 vb = SSE_Load3f(b);
+		// (a.y, a.z, a.x) * (b.z, b.x, b.y) - (a.z, a.x, a.y) * (b.y, b.z, b.x)
+		const __m128 a_yzx = _mm_shuffle_ps(va, va, _MM_SHUFFLE(3,0,2,1));
+		const __m128 b_yzx = _mm_shuffle_ps(vb, vb, _MM_SHUFFLE(3,0,2,1));
+		const __m128 c = _mm_sub_ps(
+			_mm_mul_ps(va, b_yzx),
+			_mm_mul_ps(a_yzx, vb)
+		);
+		SSE_Store3f(r, _mm_shuffle_ps(c, c, _MM_SHUFFLE(3,0,2,1)));
+	}
+};
+
+template <>
+struct MatrixMultiplyOp<float, 4, 4, 4>
+{
+	static void Apply(float* r, const float* a, const float* b)
+	{
+		const __m128 b0 = _mm_loadu_ps(b+ 0);
+		const __m128 b1 = _mm_loadu_ps(b+ 4);
+		const __m128 b2 = _mm_loadu_ps(b+ 8);
+		const __m128 b3 = _mm_loadu_ps(b+12);
+		for(std::size_t i=0; i!=4; ++i)
+		{
+			const float* ai = a+i*4;
+			__m128 s = _mm_mul_ps(_mm_set1_ps(ai[0]), b0);
+			s = _mm_add_ps(s, _mm_mul_ps(_mm_set1_ps(ai[1]), b1));
+			s = _mm_add_ps(s, _mm_mul_ps(_mm_set1_ps(ai[2]), b2));
+			s = _mm_add_ps(s, _mm_mul_ps(_mm_set1_ps(ai[3]), b3));
+			_mm_storeu_ps(r+i*4, s);
+		}
+	}
+};
+
+template <>
+struct MatrixTransposeOp<float, 4, 4>
+{
+	static void Apply(float* r, const float* a)
+	{
+		__m128 r0 = _mm_loadu_ps(a+ 0);
+		__m128 r1 = _mm_loadu_ps(a+ 4);
+		__m128 r2 = _mm_loadu_ps(a+ 8);
+		__m128 r3 = _mm_loadu_ps(a+12);
+		_MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+		_mm_storeu_ps(r+ 0, r0);
+		_mm_storeu_ps(r+ 4, r1);
+		_mm_storeu_ps(r+ 8, r2);
+		_mm_storeu_ps(r+12, r3);
+	}
+};
+
+template <>
+struct MatrixVectorMultiplyOp<float, 4, 4>
+{
+	static void Apply(float* r, const float* m, const float* v)
+	{
+		const __m128 vv = _mm_loadu_ps(v);
+		__m128 r0 = _mm_mul_ps(_mm_loadu_ps(m+ 0), vv);
+		__m128 r1 = _mm_mul_ps(_mm_loadu_ps(m+ 4), vv);
+		__m128 r2 = _mm_mul_ps(_mm_loadu_ps(m+ 8), vv);
+		__m128 r3 = _mm_mul_ps(_mm_loadu_ps(m+12), vv);
+		_MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+		_mm_storeu_ps(
+			r,
+			_mm_add_ps(_mm_add_ps(r0, r1), _mm_add_ps(r2, r3))
+		);
+	}
+};
+
+template <>
+struct VectorMatrixMultiplyOp<float, 4, 4>
+{
+	static void Apply(float* r, const float* v, const float* m)
+	{
+		__m128 s = _mm_mul_ps(_mm_set1_ps(v[0]), _mm_loadu_ps(m+ 0));
+		s = _mm_add_ps(s, _mm_mul_ps(_mm_set1_ps(v[1]), _mm_loadu_ps(m+ 4)));
+		s = _mm_add_ps(s, _mm_mul_ps(_mm_set1_ps(v[2]), _mm_loadu_ps(m+ 8)));
+		s = _mm_add_ps(s, _mm_mul_ps(_mm_set1_ps(v[3]), _mm_loadu_ps(m+12)));
+		_mm_storeu_ps(r, s);
+	}
+};
+
+template <>
+struct BulkTransformOp<float>
+{
+	static void Apply(
+		const float* m,
+		const float* in,
+		std::size_t in_n,
+		std::size_t in_stride,
+		float w,
+		float* out,
+		std::size_t out_n,
+		std::size_t out_stride,
+		std::size_t count
+	)
+	{
+		if((in_n < 3) || (out_n < 3))
+		{
+			BulkTransformScalar(
+				m, in, in_n, in_stride, w,
+				out, out_n, out_stride, count
+			);
+			return;
+		}
+		// the columns of the matrix
+		__m128 c0 = _mm_loadu_ps(m+ 0);
+		__m128 c1 = _mm_loadu_ps(m+ 4);
+		__m128 c2 = _mm_loadu_ps(m+ 8);
+		__m128 c3 = _mm_loadu_ps(m+12);
+		_MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+		// the contribution of the implicit w
+		const __m128 cw = _mm_mul_ps(c3, _mm_set1_ps(w));
+		for(std::size_t i=0; i!=count; ++i)
+		{
+			__m128 r = (in_n == 4)?
+				_mm_mul_ps(c3, _mm_set1_ps(in[3])):
+				cw;
+			r = _mm_add_ps(r, _mm_mul_ps(c0, _mm_set1_ps(in[0])));
+			r = _mm_add_ps(r, _mm_mul_ps(c1, _mm_set1_ps(in[1])));
+			r = _mm_add_ps(r, _mm_mul_ps(c2, _mm_set1_ps(in[2])));
+			if(out_n == 4) _mm_storeu_ps(out, r);
+			else SSE_Store3f(out, r);
+			in += in_stride;
+			out += out_stride;
+		}
+	}
+};
+
+template <>
+struct QuaternionNLERPOp<float>
+{
+	static void Apply(
+		const float* const q1[4],
+		const float* const q2[4],
+		const float* t,
+		float* const r[4],
+		std::size_t count,
+		bool correct
+	)
+	{
+		const __m128 sign_mask = _mm_set1_ps(-0.0f);
+		const __m128 half = _mm_set1_ps(0.5f);
+		const __m128 one = _mm_set1_ps(1.0f);
+		std::size_t i = 0;
+		for(; i+4 <= count; i += 4)
+		{
+			__m128 a[4], b[4];
+			for(std::size_t c=0; c!=4; ++c)
+			{
+				a[c] = _mm_loadu_ps(q1[c]+i);
+				b[c] = _mm_loadu_ps(q2[c]+i);
+			}
+			__m128 d = _mm_add_ps(
+				_mm_add_ps(
+					_mm_mul_ps(a[0], b[0]),
+					_mm_mul_ps(a[1], b[1])
+				),
+				_mm_add_ps(
+					_mm_mul_ps(a[2], b[2]),
+					_mm_mul_ps(a[3], b[3])
+				)
+			);
+			// flip q2 to take the shorter arc
+			const __m128 s = _mm_and_ps(d, sign_mask);
+			d = _mm_xor_ps(d, s);
+			__m128 u = _mm_loadu_ps(t+i);
+			if(correct)
+			{
+				const __m128 ka = _mm_add_ps(
+					_mm_set1_ps(1.0904f),
+					_mm_mul_ps(d, _mm_add_ps(
+						_mm_set1_ps(-3.2452f),
+						_mm_mul_ps(d, _mm_sub_ps(
+							_mm_set1_ps(3.55645f),
+							_mm_mul_ps(d, _mm_set1_ps(1.43519f))
+						))
+					))
+				);
+				const __m128 kb = _mm_add_ps(
+					_mm_set1_ps(0.848013f),
+					_mm_mul_ps(d, _mm_add_ps(
+						_mm_set1_ps(-1.06021f),
+						_mm_mul_ps(d, _mm_set1_ps(0.215638f))
+					))
+				);
+				const __m128 h = _mm_sub_ps(u, half);
+				const __m128 k = _mm_add_ps(
+					_mm_mul_ps(ka, _mm_mul_ps(h, h)),
+					kb
+				);
+				u = _mm_add_ps(u, _mm_mul_ps(
+					_mm_mul_ps(u, h),
+					_mm_mul_ps(_mm_sub_ps(u, one), k)
+				));
+			}
+			__m128 l = _mm_setzero_ps();
+			for(std::size_t c=0; c!=4; ++c)
+			{
+				b[c] = _mm_xor_ps(b[c], s);
+				a[c] = _mm_add_ps(
+					a[c],
+					_mm_mul_ps(u, _mm_sub_ps(b[c], a[c]))
+				);
+				l = _mm_add_ps(l, _mm_mul_ps(a[c], a[c]));
+			}
+			l = _mm_div_ps(one, _mm_sqrt_ps(l));
+			for(std::size_t c=0; c!=4; ++c)
+				_mm_storeu_ps(r[c]+i, _mm_mul_ps(a[c], l));
+		}
+		QuaternionNLERPScalar(q1, q2, t, r, i, count, correct);
+	}
+};
+
+template <>
+struct FrustumCullOp<float>
+{
+	static void Spheres(
+		const float* planes,
+		const float* const s[4],
+		std::size_t count,
+		std::uint32_t* mask
+	)
+	{
+		std::size_t i = 0;
+		for(; i+4 <= count; i += 4)
+		{
+			const __m128 x = _mm_loadu_ps(s[0]+i);
+			const __m128 y = _mm_loadu_ps(s[1]+i);
+			const __m128 z = _mm_loadu_ps(s[2]+i);
+			const __m128 r = _mm_xor_ps(
+				_mm_loadu_ps(s[3]+i),
+				_mm_set1_ps(-0.0f)
+			);
+			__m128 visible = _mm_cmpge_ps(
+				_mm_setzero_ps(),
+				_mm_setzero_ps()
+			);
+			for(std::size_t p=0; p!=6; ++p)
+			{
+				const float* e = planes + p*4;
+				const __m128 d = _mm_add_ps(
+					_mm_add_ps(
+						_mm_mul_ps(_mm_set1_ps(e[0]), x),
+						_mm_mul_ps(_mm_set1_ps(e[1]), y)
+					),
+					_mm_add_ps(
+						_mm_mul_ps(_mm_set1_ps(e[2]), z),
+						_mm_set1_ps(e[3])
+					)
+				);
+				visible = _mm_and_ps(visible, _mm_cmpge_ps(d, r));
+			}
+			mask[i/32] |= std::uint32_t(_mm_movemask_ps(visible))<<(i%32);
+		}
+		FrustumCullSpheresScalar(planes, s, i, count, mask);
+	}
+
+	static void Boxes(
+		const float* planes,
+		const float* const c[3],
+		const float* const h[3],
+		std::size_t count,
+		std::uint32_t* mask
+	)
+	{
+		std::size_t i = 0;
+		for(; i+4 <= count; i += 4)
+		{
+			const __m128 x = _mm_loadu_ps(c[0]+i);
+			const __m128 y = _mm_loadu_ps(c[1]+i);
+			const __m128 z = _mm_loadu_ps(c[2]+i);
+			const __m128 hx = _mm_loadu_ps(h[0]+i);
+			const __m128 hy = _mm_loadu_ps(h[1]+i);
+			const __m128 hz = _mm_loadu_ps(h[2]+i);
+			__m128 visible = _mm_cmpge_ps(
+				_mm_setzero_ps(),
+				_mm_setzero_ps()
+			);
+			for(std::size_t p=0; p!=6; ++p)
+			{
+				const float* e = planes + p*4;
+				const __m128 d = _mm_add_ps(
+					_mm_add_ps(
+						_mm_mul_ps(_mm_set1_ps(e[0]), x),
+						_mm_mul_ps(_mm_set1_ps(e[1]), y)
+					),
+					_mm_add_ps(
+						_mm_mul_ps(_mm_set1_ps(e[2]), z),
+						_mm_set1_ps(e[3])
+					)
+				);
+				const __m128 r = _mm_add_ps(
+					_mm_add_ps(
+						_mm_mul_ps(
+							_mm_set1_ps(std::fabs(e[0])),
+							hx
+						),
+						_mm_mul_ps(
+							_mm_set1_ps(std::fabs(e[1])),
+							hy
+						)
+					),
+					_mm_mul_ps(_mm_set1_ps(std::fabs(e[2])), hz)
+				);
+				visible = _mm_and_ps(
+					visible,
+					_mm_cmpge_ps(d, _mm_sub_ps(_mm_setzero_ps(), r))
+				);
+			}
+			mask[i/32] |= std::uint32_t(_mm_movemask_ps(visible))<<(i%32);
+		}
+		FrustumCullBoxesScalar(planes, c, h, i, count, mask);
+	}
+};
+
+#endif // OGLPLUS_USE_SSE
+
+#if OGLPLUS_USE_AVX
+
+template <>
+struct VectorOps<double, 4>
+{
+	static void Negate(double* r, const double* a)
+	{
+		_mm256_storeu_pd(
+			r,
+			_mm256_sub_pd(_mm256_setzero_pd(), _mm256_loadu_pd(a))
+		);
+	}
+
+	static void Add(double* r, const double* a, const double* b)
+	{
+		_mm256_storeu_pd(
+			r,
+			_mm256_add_pd(_mm256_loadu_pd(a), _mm256_loadu_pd(b))
+		);
+	}
+
+	static void Subtract(double* r, const double* a, const double* b)
+	{
+		_mm256_storeu_pd(
+			r,
+			_mm256_sub_pd(_mm256_loadu_pd(a), _mm256_loadu_pd(b))
+		);
+	}
+
+	static void Multiply(double* r, const double* a, double v)
+	{
+		_mm256_storeu_pd(
+			r,
+			_mm256_mul_pd(_mm256_loadu_pd(a), _mm256_set1_pd(v))
+		);
+	}
+
+	static void Divide(double* r, const double* a, double v)
+	{
+		_mm256_storeu_pd(
+			r,
+			_mm256_div_pd(_mm256_loadu_pd(a), _mm256_set1_pd(v))
+		);
+	}
+
+	static double Dot(const double* a, const double* b)
+	{
+		const __m256d p = _mm256_mul_pd(
+			_mm256_loadu_pd(a),
+			_mm256_loadu_pd(b)
+		);
+		const __m128d s = _mm_add_pd(
+			_mm256_castpd256_pd128(p),
+			_mm256_extractf128_pd(p, 1)
+		);
+		return _mm_cvtsd_f64(_mm_add_sd(s, _mm_unpackhi_pd(s, s)));
+	}
+};
+
+template <>
+struct MatrixMultiplyOp<double, 4, 4, 4>
+{
+	static void Apply(double* r, const double* a, const double* b)
+	{
+		const __m256d b0 = _mm256_loadu_pd(b+ 0);
+		const __m256d b1 = _mm256_loadu_pd(b+ 4);
+		const __m256d b2 = _mm256_loadu_pd(b+ 8);
+		const __m256d b3 = _mm256_loadu_pd(b+12);
+		for(std::size_t i=0; i!=4; ++i)
+		{
+			const double* ai = a+i*4;
+			__m256d s = _mm256_mul_pd(_mm256_set1_pd(ai[0]), b0);
+			s = _mm256_add_pd(s, _mm256_mul_pd(_mm256_set1_pd(ai[1]), b1));
+			s = _mm256_add_pd(s, _mm256_mul_pd(_mm256_set1_pd(ai[2]), b2));
+			s = _mm256_add_pd(s, _mm256_mul_pd(_mm256_set1_pd(ai[3]), b3));
+			_mm256_storeu_pd(r+i*4, s);
+		}
+	}
+};
+
+template <>
+struct VectorMatrixMultiplyOp<double, 4, 4>
+{
+	static void Apply(double* r, const double* v, const double* m)
+	{
+		__m256d s = _mm256_mul_pd(
+			_mm256_set1_pd(v[0]),
+			_mm256_loadu_pd(m+ 0)
+		);
+		s = _mm256_add_pd(s, _mm256_mul_pd(
+			_mm256_set1_pd(v[1]),
+			_mm256_loadu_pd(m+ 4)
+		));
+		s = _mm256_add_pd(s, _mm256_mul_pd(
+			_mm256_set1_pd(v[2]),
+			_mm256_loadu_pd(m+ 8)
+		));
+		s = _mm256_add_pd(s, _mm256_mul_pd(
+			_mm256_set1_pd(v[3]),
+			_mm256_loadu_pd(m+12)
+		));
+		_mm256_storeu_pd(r, s);
+	}
+};
+
+#endif // OGLPLUS_USE_AVX
+
+} // namespace aux
+} // namespace oglplus
+
+#endif // include guard
@@ -20,6 +20,7 @@
 #if OGLPLUS_NO_OBJECT_DESCS == 0
 #include <cassert>
 #include <map>
+#include <exception>
 #endif
 
 namespace oglplus {
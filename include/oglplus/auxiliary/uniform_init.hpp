@@ -19,6 +19,7 @@
 #include <oglplus/program.hpp>
 
 #include <oglplus/auxiliary/uniform_typecheck.hpp>
+#include <oglplus/auxiliary/program_reflection.hpp>
 
 namespace oglplus {
 namespace aux {
@@ -198,6 +199,9 @@ protected:
 
 	GLint _init_location(GLuint program, const GLchar* identifier) const
 	{
+		ProgramReflectionEntry entry;
+		if(ProgramReflection::FindUniform(program, identifier, entry))
+			return entry.location;
 		return OGLPLUS_GLFUNC(GetUniformLocation)(
 			program,
 			identifier
@@ -215,6 +219,9 @@ protected:
 
 	GLint _do_init_location(GLuint program, const GLchar* identifier) const
 	{
+		ProgramReflectionEntry entry;
+		if(ProgramReflection::FindUniform(program, identifier, entry))
+			return entry.location;
 		GLint result = OGLPLUS_GLFUNC(GetUniformLocation)(
 			program,
 			identifier
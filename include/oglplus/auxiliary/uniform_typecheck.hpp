@@ -16,6 +16,7 @@
 #include <oglplus/config.hpp>
 #include <oglplus/fwd.hpp>
 #include <oglplus/glfunc.hpp>
+#include <oglplus/auxiliary/program_reflection.hpp>
 
 #include <vector>
 #include <cstring>
@@ -16,8 +16,9 @@ class Vector<T, 1>
 private:
 	typedef VectorBase<T, 1> Base;
 	typedef typename Base::Unit_ Unit_;
+	typedef typename Base::Elems_ Elems_;
 public:
-	Vector(void)
+	OGLPLUS_CONSTEXPR_MATH Vector(void)
 	{ }
 
 	template <typename U>
@@ -33,27 +34,21 @@ public:
 	 : Base(v, n)
 	{ }
 
-	explicit Vector(T v0)
-	 : Base(v0)
+	OGLPLUS_CONSTEXPR_MATH explicit Vector(T v0)
+	 : Base(Elems_(), v0)
 	{ }
 
-	Vector(const Vector<T, 2>& v)
-	 : Base(oglplus::Nothing())
-	{
-		this->_elem[0] = v[0];
-	}
+	OGLPLUS_CONSTEXPR_MATH Vector(const Vector<T, 2>& v)
+	 : Base(Elems_(), v[0])
+	{ }
 
-	Vector(const Vector<T, 3>& v)
-	 : Base(oglplus::Nothing())
-	{
-		this->_elem[0] = v[0];
-	}
+	OGLPLUS_CONSTEXPR_MATH Vector(const Vector<T, 3>& v)
+	 : Base(Elems_(), v[0])
+	{ }
 
-	Vector(const Vector<T, 4>& v)
-	 : Base(oglplus::Nothing())
-	{
-		this->_elem[0] = v[0];
-	}
+	OGLPLUS_CONSTEXPR_MATH Vector(const Vector<T, 4>& v)
+	 : Base(Elems_(), v[0])
+	{ }
 
 	Vector(Unit_, std::size_t axis)
 	{
@@ -66,17 +61,20 @@ public:
 		return Vector(Unit_(), axis);
 	}
 
-	T x(void) const
+	OGLPLUS_CONSTEXPR_MATH T x(void) const
 	{
 		return this->At(0);
 	}
 
-	friend Vector Negated(const Vector& a)
+	friend OGLPLUS_CONSTEXPR_MATH Vector Negated(const Vector& a)
 	{
 		return Vector(-a[0]);
 	}
 
-	friend Vector Added(const Vector& a, const Vector& b)
+	friend OGLPLUS_CONSTEXPR_MATH Vector Added(
+		const Vector& a,
+		const Vector& b
+	)
 	{
 		return Vector(a[0]+b[0]);
 	}
@@ -87,7 +85,10 @@ public:
 		return *this;
 	}
 
-	friend Vector Subtracted(const Vector& a, const Vector& b)
+	friend OGLPLUS_CONSTEXPR_MATH Vector Subtracted(
+		const Vector& a,
+		const Vector& b
+	)
 	{
 		return Vector(a[0]-b[0]);
 	}
@@ -99,7 +100,7 @@ public:
 	}
 
 
-	friend Vector Multiplied(const Vector& a, T v)
+	friend OGLPLUS_CONSTEXPR_MATH Vector Multiplied(const Vector& a, T v)
 	{
 		return Vector(a[0]*v);
 	}
@@ -110,7 +111,7 @@ public:
 		return *this;
 	}
 
-	friend Vector Divided(const Vector& a, T v)
+	friend OGLPLUS_CONSTEXPR_MATH Vector Divided(const Vector& a, T v)
 	{
 		return Vector(a[0]/v);
 	}
@@ -16,8 +16,9 @@ class Vector<T, 2>
 private:
 	typedef VectorBase<T, 2> Base;
 	typedef typename Base::Unit_ Unit_;
+	typedef typename Base::Elems_ Elems_;
 public:
-	Vector(void)
+	OGLPLUS_CONSTEXPR_MATH Vector(void)
 	{ }
 
 	template <typename U>
@@ -33,37 +34,25 @@ public:
 	 : Base(v, n)
 	{ }
 
-	explicit Vector(T v0)
-	 : Base(v0)
+	OGLPLUS_CONSTEXPR_MATH explicit Vector(T v0)
+	 : Base(Elems_(), v0, v0)
 	{ }
 
-	Vector(T v0, T v1)
-	 : Base(oglplus::Nothing())
-	{
-		this->_elem[0] = v0;
-		this->_elem[1] = v1;
-	}
+	OGLPLUS_CONSTEXPR_MATH Vector(T v0, T v1)
+	 : Base(Elems_(), v0, v1)
+	{ }
 
-	Vector(const Vector<T, 1>& v, T v1)
-	 : Base(oglplus::Nothing())
-	{
-		this->_elem[0] = v[0];
-		this->_elem[1] = v1;
-	}
+	OGLPLUS_CONSTEXPR_MATH Vector(const Vector<T, 1>& v, T v1)
+	 : Base(Elems_(), v[0], v1)
+	{ }
 
-	Vector(const Vector<T, 3>& v)
-	 : Base(oglplus::Nothing())
-	{
-		this->_elem[0] = v[0];
-		this->_elem[1] = v[1];
-	}
+	OGLPLUS_CONSTEXPR_MATH Vector(const Vector<T, 3>& v)
+	 : Base(Elems_(), v[0], v[1])
+	{ }
 
-	Vector(const Vector<T, 4>& v)
-	 : Base(oglplus::Nothing())
-	{
-		this->_elem[0] = v[0];
-		this->_elem[1] = v[1];
-	}
+	OGLPLUS_CONSTEXPR_MATH Vector(const Vector<T, 4>& v)
+	 : Base(Elems_(), v[0], v[1])
+	{ }
 
 	Vector(Unit_, std::size_t axis)
 	{
@@ -84,22 +73,25 @@ public:
 	 : Base(matrix)
 	{ }
 
-	T x(void) const
+	OGLPLUS_CONSTEXPR_MATH T x(void) const
 	{
 		return this->At(0);
 	}
 
-	T y(void) const
+	OGLPLUS_CONSTEXPR_MATH T y(void) const
 	{
 		return this->At(1);
 	}
 
-	friend Vector Negated(const Vector& a)
+	friend OGLPLUS_CONSTEXPR_MATH Vector Negated(const Vector& a)
 	{
 		return Vector(-a[0], -a[1]);
 	}
 
-	friend Vector Added(const Vector& a, const Vector& b)
+	friend OGLPLUS_CONSTEXPR_MATH Vector Added(
+		const Vector& a,
+		const Vector& b
+	)
 	{
 		return Vector(a[0]+b[0], a[1]+b[1]);
 	}
@@ -110,7 +102,10 @@ public:
 		return *this;
 	}
 
-	friend Vector Subtracted(const Vector& a, const Vector& b)
+	friend OGLPLUS_CONSTEXPR_MATH Vector Subtracted(
+		const Vector& a,
+		const Vector& b
+	)
 	{
 		return Vector(a[0]-b[0], a[1]-b[1]);
 	}
@@ -122,7 +117,7 @@ public:
 	}
 
 
-	friend Vector Multiplied(const Vector& a, T v)
+	friend OGLPLUS_CONSTEXPR_MATH Vector Multiplied(const Vector& a, T v)
 	{
 		return Vector(a[0]*v, a[1]*v);
 	}
@@ -133,7 +128,7 @@ public:
 		return *this;
 	}
 
-	friend Vector Divided(const Vector& a, T v)
+	friend OGLPLUS_CONSTEXPR_MATH Vector Divided(const Vector& a, T v)
 	{
 		return Vector(a[0]/v, a[1]/v);
 	}
@@ -16,8 +16,51 @@ class Vector<T, 3>
 private:
 	typedef VectorBase<T, 3> Base;
 	typedef typename Base::Unit_ Unit_;
+	typedef typename Base::Elems_ Elems_;
+	typedef aux::VectorOps<T, 3> _ops;
+
+	// No initialization
+	Vector(oglplus::Nothing)
+	 : Base(oglplus::Nothing())
+	{ }
+
+	// the run-time (SIMD) implementations of the arithmetic operations
+	static Vector _negated(const Vector& a)
+	{
+		Vector r = Vector(oglplus::Nothing());
+		_ops::Negate(r._elem, a._elem);
+		return r;
+	}
+
+	static Vector _added(const Vector& a, const Vector& b)
+	{
+		Vector r = Vector(oglplus::Nothing());
+		_ops::Add(r._elem, a._elem, b._elem);
+		return r;
+	}
+
+	static Vector _subtracted(const Vector& a, const Vector& b)
+	{
+		Vector r = Vector(oglplus::Nothing());
+		_ops::Subtract(r._elem, a._elem, b._elem);
+		return r;
+	}
+
+	static Vector _multiplied(const Vector& a, T v)
+	{
+		Vector r = Vector(oglplus::Nothing());
+		_ops::Multiply(r._elem, a._elem, v);
+		return r;
+	}
+
+	static Vector _divided(const Vector& a, T v)
+	{
+		Vector r = Vector(oglplus::Nothing());
+		_ops::Divide(r._elem, a._elem, v);
+		return r;
+	}
 public:
-	Vector(void)
+	OGLPLUS_CONSTEXPR_MATH Vector(void)
 	{ }
 
 	template <typename U>
@@ -33,41 +76,25 @@ public:
 	 : Base(v, n)
 	{ }
 
-	explicit Vector(T v0)
-	 : Base(v0)
+	OGLPLUS_CONSTEXPR_MATH explicit Vector(T v0)
+	 : Base(Elems_(), v0, v0, v0)
 	{ }
 
-	Vector(T v0, T v1, T v2)
-	 : Base(oglplus::Nothing())
-	{
-		this->_elem[0] = v0;
-		this->_elem[1] = v1;
-		this->_elem[2] = v2;
-	}
+	OGLPLUS_CONSTEXPR_MATH Vector(T v0, T v1, T v2)
+	 : Base(Elems_(), v0, v1, v2)
+	{ }
 
-	Vector(const Vector<T, 1>& v, T v1, T v2)
-	 : Base(oglplus::Nothing())
-	{
-		this->_elem[0] = v[0];
-		this->_elem[1] = v1;
-		this->_elem[2] = v2;
-	}
+	OGLPLUS_CONSTEXPR_MATH Vector(const Vector<T, 1>& v, T v1, T v2)
+	 : Base(Elems_(), v[0], v1, v2)
+	{ }
 
-	Vector(const Vector<T, 2>& v, T v2)
-	 : Base(oglplus::Nothing())
-	{
-		this->_elem[0] = v[0];
-		this->_elem[1] = v[1];
-		this->_elem[2] = v2;
-	}
+	OGLPLUS_CONSTEXPR_MATH Vector(const Vector<T, 2>& v, T v2)
+	 : Base(Elems_(), v[0], v[1], v2)
+	{ }
 
-	Vector(const Vector<T, 4>& v)
-	 : Base(oglplus::Nothing())
-	{
-		this->_elem[0] = v[0];
-		this->_elem[1] = v[1];
-		this->_elem[2] = v[2];
-	}
+	OGLPLUS_CONSTEXPR_MATH Vector(const Vector<T, 4>& v)
+	 : Base(Elems_(), v[0], v[1], v[2])
+	{ }
 
 	Vector(Unit_, std::size_t axis)
 	{
@@ -88,34 +115,51 @@ public:
 	 : Base(matrix)
 	{ }
 
-	T x(void) const
+	OGLPLUS_CONSTEXPR_MATH T x(void) const
 	{
 		return this->At(0);
 	}
 
-	T y(void) const
+	OGLPLUS_CONSTEXPR_MATH T y(void) const
 	{
 		return this->At(1);
 	}
 
-	T z(void) const
+	OGLPLUS_CONSTEXPR_MATH T z(void) const
 	{
 		return this->At(2);
 	}
 
-	Vector<T, 2> xy(void) const
+	OGLPLUS_CONSTEXPR_MATH Vector<T, 2> xy(void) const
 	{
 		return Vector<T, 2>(this->At(0), this->At(1));
 	}
 
-	friend Vector Negated(const Vector& a)
+	friend OGLPLUS_CONSTEXPR_MATH Vector Negated(const Vector& a)
 	{
-		return Vector(-a[0], -a[1], -a[2]);
+		return OGLPLUS_CONSTEXPR_MATH_SELECT(
+			Vector(
+				-a[0],
+				-a[1],
+				-a[2]
+			),
+			_negated(a)
+		);
 	}
 
-	friend Vector Added(const Vector& a, const Vector& b)
+	friend OGLPLUS_CONSTEXPR_MATH Vector Added(
+		const Vector& a,
+		const Vector& b
+	)
 	{
-		return Vector(a[0]+b[0], a[1]+b[1], a[2]+b[2]);
+		return OGLPLUS_CONSTEXPR_MATH_SELECT(
+			Vector(
+				a[0]+b[0],
+				a[1]+b[1],
+				a[2]+b[2]
+			),
+			_added(a, b)
+		);
 	}
 
 	Vector& operator += (const Vector& v)
@@ -124,9 +168,19 @@ public:
 		return *this;
 	}
 
-	friend Vector Subtracted(const Vector& a, const Vector& b)
+	friend OGLPLUS_CONSTEXPR_MATH Vector Subtracted(
+		const Vector& a,
+		const Vector& b
+	)
 	{
-		return Vector(a[0]-b[0], a[1]-b[1], a[2]-b[2]);
+		return OGLPLUS_CONSTEXPR_MATH_SELECT(
+			Vector(
+				a[0]-b[0],
+				a[1]-b[1],
+				a[2]-b[2]
+			),
+			_subtracted(a, b)
+		);
 	}
 
 	Vector& operator -= (const Vector& v)
@@ -136,9 +190,16 @@ public:
 	}
 
 
-	friend Vector Multiplied(const Vector& a, T v)
+	friend OGLPLUS_CONSTEXPR_MATH Vector Multiplied(const Vector& a, T v)
 	{
-		return Vector(a[0]*v, a[1]*v, a[2]*v);
+		return OGLPLUS_CONSTEXPR_MATH_SELECT(
+			Vector(
+				a[0]*v,
+				a[1]*v,
+				a[2]*v
+			),
+			_multiplied(a, v)
+		);
 	}
 
 	Vector& operator *= (T v)
@@ -147,9 +208,16 @@ public:
 		return *this;
 	}
 
-	friend Vector Divided(const Vector& a, T v)
+	friend OGLPLUS_CONSTEXPR_MATH Vector Divided(const Vector& a, T v)
 	{
-		return Vector(a[0]/v, a[1]/v, a[2]/v);
+		return OGLPLUS_CONSTEXPR_MATH_SELECT(
+			Vector(
+				a[0]/v,
+				a[1]/v,
+				a[2]/v
+			),
+			_divided(a, v)
+		);
 	}
 
 	Vector& operator /= (T v)
@@ -62,8 +62,7 @@ private:
 			const Vector& a
 		) const
 		{
-			for(std::size_t i=0; i!=N; ++i)
-				t._elem[i] = -a._elem[i];
+			aux::VectorOps<T, N>::Negate(t._elem, a._elem);
 		}
 	};
 
@@ -75,8 +74,7 @@ private:
 			const Vector& b
 		) const
 		{
-			for(std::size_t i=0; i!=N; ++i)
-				t._elem[i] = a._elem[i] + b._elem[i];
+			aux::VectorOps<T, N>::Add(t._elem, a._elem, b._elem);
 		}
 	};
 
@@ -88,8 +86,7 @@ private:
 			const Vector& b
 		) const
 		{
-			for(std::size_t i=0; i!=N; ++i)
-				t._elem[i] = a._elem[i] - b._elem[i];
+			aux::VectorOps<T, N>::Subtract(t._elem, a._elem, b._elem);
 		}
 	};
 
@@ -101,8 +98,7 @@ private:
 			T v
 		) const
 		{
-			for(std::size_t i=0; i!=N; ++i)
-				t._elem[i] = a._elem[i] * v;
+			aux::VectorOps<T, N>::Multiply(t._elem, a._elem, v);
 		}
 	};
 
@@ -114,13 +110,12 @@ private:
 			T v
 		) const
 		{
-			for(std::size_t i=0; i!=N; ++i)
-				t._elem[i] = a._elem[i] / v;
+			aux::VectorOps<T, N>::Divide(t._elem, a._elem, v);
 		}
 	};
 public:
 	/// Default construction, initializes all components to zero
-	Vector(void)
+	OGLPLUS_CONSTEXPR_MATH Vector(void)
 	{ }
 
 	/// Copy construction from a vector with different element type
@@ -221,37 +216,37 @@ public:
 #endif
 
 	/// Returns the 0-th component
-	T x(void) const
+	OGLPLUS_CONSTEXPR_MATH T x(void) const
 	{
 		return this->At(0);
 	}
 
 	/// Returns the 1-st component
-	T y(void) const
+	OGLPLUS_CONSTEXPR_MATH T y(void) const
 	{
 		return this->At(1);
 	}
 
 	/// Returns the 2-nd component
-	T z(void) const
+	OGLPLUS_CONSTEXPR_MATH T z(void) const
 	{
 		return this->At(2);
 	}
 
 	/// Returns the 3-nd component
-	T w(void) const
+	OGLPLUS_CONSTEXPR_MATH T w(void) const
 	{
 		return this->At(3);
 	}
 
 	/// Returns a subvector with the first two components
-	Vector<T, 2> xy(void) const
+	OGLPLUS_CONSTEXPR_MATH Vector<T, 2> xy(void) const
 	{
 		return Vector<T, 2>(this->At(0), this->At(1));
 	}
 
 	/// Returns a subvector with the first three components
-	Vector<T, 3> xyz(void) const
+	OGLPLUS_CONSTEXPR_MATH Vector<T, 3> xyz(void) const
 	{
 		return Vector<T, 3>(this->At(0), this->At(1), this->At(2));
 	}
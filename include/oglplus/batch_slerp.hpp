@@ -0,0 +1,237 @@
+/**
+ *  @file oglplus/batch_slerp.hpp
+ *  @brief Batched interpolation of arrays of quaternions
+ *
+ *  @author Matus Chochlik
+ *
+ *  Copyright 2010-2013 Matus Chochlik. Distributed under the Boost
+ *  Software License, Version 1.0. (See accompanying file
+ *  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ */
+
+#pragma once
+#ifndef OGLPLUS_BATCH_SLERP_1310211010_HPP
+#define OGLPLUS_BATCH_SLERP_1310211010_HPP
+
+#include <oglplus/config_compiler.hpp>
+#include <oglplus/quaternion.hpp>
+#include <oglplus/matrix.hpp>
+#include <oglplus/auxiliary/simd.hpp>
+
+#include <cassert>
+#include <cstddef>
+#include <type_traits>
+
+namespace oglplus {
+
+/// A view of an array of quaternions stored as a structure of arrays
+/** The @c QuaternionArrays class references @c Size() quaternions whose
+ *  real parts and the x, y and z coordinates of the imaginary parts
+ *  are stored in four separate arrays. This layout allows to process
+ *  several quaternions at once with the SIMD instructions.
+ *
+ *  @see BatchNLERP
+ *
+ *  @ingroup math_utils
+ */
+template <typename T>
+class QuaternionArrays
+{
+private:
+	T* _c[4];
+	std::size_t _size;
+	typedef typename std::remove_const<T>::type _value_type;
+public:
+	/// The type of arrays referencing the same values as immutable
+	typedef QuaternionArrays<const T> ConstArrays;
+
+	/// References @p size quaternions with the specified components
+	QuaternionArrays(T* a, T* x, T* y, T* z, std::size_t size)
+	 : _size(size)
+	{
+		_c[0] = a;
+		_c[1] = x;
+		_c[2] = y;
+		_c[3] = z;
+	}
+
+	/// References @p size quaternions stored in a single array
+	/** The @p data array is expected to contain first @p size
+	 *  real parts, followed by @p size x, y and z coordinates.
+	 */
+	QuaternionArrays(T* data, std::size_t size)
+	 : _size(size)
+	{
+		for(std::size_t c=0; c!=4; ++c)
+			_c[c] = data + c*size;
+	}
+
+	/// Converts mutable arrays to arrays of immutable values
+	template <typename U>
+	QuaternionArrays(
+		const QuaternionArrays<U>& that,
+		typename std::enable_if<
+			std::is_convertible<U*, T*>::value
+		>::type* = nullptr
+	): _size(that.Size())
+	{
+		for(std::size_t c=0; c!=4; ++c)
+			_c[c] = that.Components()[c];
+	}
+
+	/// Returns the number of referenced quaternions
+	std::size_t Size(void) const
+	{
+		return _size;
+	}
+
+	/// Returns the pointers to the a, x, y and z component arrays
+	T* const* Components(void) const
+	{
+		return _c;
+	}
+
+	/// Returns the quaternion at the specified @p index
+	Quaternion<_value_type> At(std::size_t index) const
+	{
+		assert(index < _size);
+		return Quaternion<_value_type>(
+			_c[0][index],
+			_c[1][index],
+			_c[2][index],
+			_c[3][index]
+		);
+	}
+
+	/// Stores the quaternion @p q at the specified @p index
+	void Set(std::size_t index, const Quaternion<_value_type>& q) const
+	{
+		assert(index < _size);
+		for(std::size_t c=0; c!=4; ++c)
+			_c[c][index] = q.At(c);
+	}
+
+	/// Returns arrays referencing quaternions in range [offset, offset+size)
+	QuaternionArrays Slice(std::size_t offset, std::size_t size) const
+	{
+		assert(offset + size <= _size);
+		return QuaternionArrays(
+			_c[0]+offset,
+			_c[1]+offset,
+			_c[2]+offset,
+			_c[3]+offset,
+			size
+		);
+	}
+};
+
+/// Interpolates between pairs of unit quaternions
+/** For each index @c i in the range [0, q1.Size()) this function computes
+ *  the normalized linear interpolation between @c q1.At(i) and @c q2.At(i)
+ *  with the interpolation parameter @c params[i], taking the shorter
+ *  of the two arcs, and stores the result into @p result.
+ *  If @p correct is true then the interpolation parameter is adjusted
+ *  so that the result closely approximates (with the error in the order
+ *  of 1e-3 or less) the spherical linear interpolation without
+ *  requiring any trigonometric functions. Otherwise the angular
+ *  velocity of the plain NLERP is not constant.
+ *
+ *  Unlike QuaternionSLERP this function does not require any
+ *  per-pair setup and processes several quaternions at once with
+ *  the SIMD instructions where available.
+ *
+ *  @pre q2.Size() >= q1.Size() && result.Size() >= q1.Size()
+ *  @pre all quaternions in @p q1 and @p q2 are normalized
+ *
+ *  @see QuaternionSLERP
+ *
+ *  @ingroup math_utils
+ */
+template <typename T>
+inline void BatchNLERP(
+	typename QuaternionArrays<T>::ConstArrays q1,
+	typename QuaternionArrays<T>::ConstArrays q2,
+	const T* params,
+	QuaternionArrays<T> result,
+	bool correct = true
+)
+{
+	assert(q2.Size() >= q1.Size());
+	assert(result.Size() >= q1.Size());
+	aux::QuaternionNLERPOp<T>::Apply(
+		q1.Components(),
+		q2.Components(),
+		params,
+		result.Components(),
+		q1.Size(),
+		correct
+	);
+}
+
+/// Interpolates between pairs of unit quaternions into rotation matrices
+/** This function works like the overload storing the results into
+ *  QuaternionArrays, but instead of quaternions it stores the 3x4
+ *  matrices of the rotations represented by the interpolated quaternions
+ *  into the @p result array, which must have space for at least
+ *  @c q1.Size() matrices. The last column (translation) of the matrices
+ *  is zero.
+ *
+ *  @see ModelMatrix::RotationQ
+ *
+ *  @ingroup math_utils
+ */
+template <typename T>
+inline void BatchNLERP(
+	typename QuaternionArrays<T>::ConstArrays q1,
+	typename QuaternionArrays<T>::ConstArrays q2,
+	const T* params,
+	Matrix<T, 3, 4>* result,
+	bool correct = true
+)
+{
+	assert(q2.Size() >= q1.Size());
+	// the interpolated quaternions are processed in chunks
+	// small enough to be kept on the stack
+	const std::size_t chunk = 64;
+	T tmp[4*chunk];
+	for(std::size_t offset=0; offset < q1.Size(); offset += chunk)
+	{
+		const std::size_t size = (offset + chunk < q1.Size())?
+			chunk:
+			q1.Size() - offset;
+		QuaternionArrays<T> q(tmp, size);
+		BatchNLERP<T>(
+			q1.Slice(offset, size),
+			q2.Slice(offset, size),
+			params+offset,
+			q,
+			correct
+		);
+		const T* a = q.Components()[0];
+		const T* x = q.Components()[1];
+		const T* y = q.Components()[2];
+		const T* z = q.Components()[3];
+		for(std::size_t i=0; i!=size; ++i)
+		{
+			const T x2 = 2*x[i]*x[i];
+			const T y2 = 2*y[i]*y[i];
+			const T z2 = 2*z[i]*z[i];
+			const T xy = 2*x[i]*y[i];
+			const T xz = 2*x[i]*z[i];
+			const T yz = 2*y[i]*z[i];
+			const T xa = 2*x[i]*a[i];
+			const T ya = 2*y[i]*a[i];
+			const T za = 2*z[i]*a[i];
+			const T data[12] = {
+				1-y2-z2,   xy-za,   xz+ya, T(0),
+				  xy+za, 1-x2-z2,   yz-xa, T(0),
+				  xz-ya,   yz+xa, 1-x2-y2, T(0)
+			};
+			result[offset+i] = Matrix<T, 3, 4>(data);
+		}
+	}
+}
+
+} // namespace oglplus
+
+#endif // include guard
@@ -18,6 +18,7 @@
 #include <oglplus/glfunc.hpp>
 #include <oglplus/error.hpp>
 #include <oglplus/object.hpp>
+#include <oglplus/state_cache.hpp>
 #include <oglplus/array.hpp>
 #include <oglplus/friend_of.hpp>
 #include <oglplus/bitfield.hpp>
@@ -29,6 +30,8 @@
 #include <oglplus/auxiliary/binding_query.hpp>
 
 #include <vector>
+#include <type_traits>
+#include <utility>
 #include <cassert>
 
 namespace oglplus {
@@ -189,6 +192,46 @@ OGLPLUS_ENUM_CLASS_END(BufferIndexedTarget)
 #include <oglplus/enums/buffer_indexed_target_range.ipp>
 #endif
 
+namespace aux {
+
+// Checks if Range has the data() and size() member functions
+template <typename Range>
+class IsBufferDataRange
+{
+private:
+	template <typename R>
+	static auto _test(const R* r) ->
+	decltype(r->data(), r->size(), std::true_type());
+
+	static std::false_type _test(...);
+public:
+	typedef decltype(_test(static_cast<const Range*>(nullptr))) Type;
+	static const bool value = Type::value;
+};
+
+// The type of the elements of a contiguous Range uploaded into a buffer
+template <typename Range>
+struct BufferDataElement
+{
+	typedef decltype(std::declval<const Range&>().data()) Pointer;
+
+	static_assert(
+		std::is_pointer<Pointer>::value,
+		"The data() of a buffer data range must return a pointer"
+	);
+
+	typedef typename std::remove_cv<
+		typename std::remove_pointer<Pointer>::type
+	>::type Type;
+
+	static_assert(
+		std::is_standard_layout<Type>::value &&
+		!std::is_pointer<Type>::value,
+		"The elements of a buffer data range must be plain data"
+	);
+};
+
+} // namespace aux
 
 /// Wrapper for OpenGL buffer operations
 /**
@@ -247,6 +290,13 @@ protected:
 
 	static void _bind(GLuint _name, Target target)
 	{
+		aux::StateChange change(
+			aux::StateCacheKey::Buffer,
+			GLenum(target),
+			0,
+			GLint(_name)
+		);
+		if(change.Redundant()) return;
 		assert(_name != 0);
 		OGLPLUS_GLFUNC(BindBuffer)(GLenum(target), _name);
 		OGLPLUS_VERIFY(OGLPLUS_OBJECT_ERROR_INFO(
@@ -255,6 +305,7 @@ protected:
 			EnumValueName(target),
 			_name
 		));
+		change.Done();
 	}
 
 	friend class FriendOf<BufferOps>;
@@ -349,8 +400,8 @@ public:
 		 , _ptr(
 			OGLPLUS_GLFUNC(MapBufferRange)(
 				GLenum(target),
-				offset,
-				size,
+				_offset,
+				_size,
 				GLbitfield(access)
 			)
 		), _target(target)
@@ -407,6 +458,28 @@ public:
 			}
 		}
 
+		/// Unmaps the buffer, returns false if its data got corrupted
+		/** The data store of the buffer may become corrupted while it
+		 *  is mapped (for example after a change of the screen mode),
+		 *  in which case it has to be reinitialized. The mapped data
+		 *  must not be accessed after the buffer is unmapped.
+		 *
+		 *  @glsymbols
+		 *  @glfunref{UnmapBuffer}
+		 *
+		 *  @throws Error
+		 */
+		bool Unmap(void)
+		{
+			assert(_ptr != nullptr);
+			_ptr = nullptr;
+			bool result = true;
+			if(OGLPLUS_GLFUNC(UnmapBuffer)(GLenum(_target)) != GL_TRUE)
+				result = false;
+			OGLPLUS_CHECK(OGLPLUS_ERROR_INFO(UnmapBuffer));
+			return result;
+		}
+
 		/// Returns the size (in bytes) of the mapped buffer
 		GLsizeiptr Size(void) const
 		{
@@ -468,13 +541,21 @@ public:
 	 */
 	static void Unbind(Target target)
 	{
+		aux::StateChange change(
+			aux::StateCacheKey::Buffer,
+			GLenum(target),
+			0,
+			0
+		);
+		if(change.Redundant()) return;
 		OGLPLUS_GLFUNC(BindBuffer)(GLenum(target), 0);
 		OGLPLUS_VERIFY(OGLPLUS_OBJECT_ERROR_INFO(
 			BindBuffer,
 			Buffer,
 			EnumValueName(target),
-			BindingQuery<BufferOps>::QueryBinding(target)
+			BindingQuery<BufferOps>::ErrorInfoName(target)
 		));
+		change.Done();
 	}
 
 	/// Bind this buffer to the specified indexed target
@@ -491,6 +572,13 @@ public:
 			EnumValueName(target),
 			_name
 		));
+		// this also changes the generic binding of the target
+		aux::StateChange(
+			aux::StateCacheKey::Buffer,
+			GLenum(target),
+			0,
+			GLint(_name)
+		).Done();
 	}
 
 #if OGLPLUS_DOCUMENTATION_ONLY || GL_VERSION_4_0 || GL_ARB_transform_feedback3
@@ -551,6 +639,13 @@ public:
 	{
 		OGLPLUS_GLFUNC(BindBufferBase)(GLenum(target), index, 0);
 		OGLPLUS_VERIFY(OGLPLUS_ERROR_INFO(BindBufferBase));
+		// this also changes the generic binding of the target
+		aux::StateChange(
+			aux::StateCacheKey::Buffer,
+			GLenum(target),
+			0,
+			0
+		).Done();
 	}
 
 #if OGLPLUS_DOCUMENTATION_ONLY || GL_VERSION_4_4 || GL_ARB_multi_bind
@@ -601,6 +696,13 @@ public:
 			EnumValueName(target),
 			_name
 		));
+		// this also changes the generic binding of the target
+		aux::StateChange(
+			aux::StateCacheKey::Buffer,
+			GLenum(target),
+			0,
+			GLint(_name)
+		).Done();
 	}
 
 #if OGLPLUS_DOCUMENTATION_ONLY || GL_VERSION_4_4 || GL_ARB_multi_bind
@@ -657,7 +759,7 @@ public:
 			BufferData,
 			Buffer,
 			EnumValueName(target),
-			BindingQuery<BufferOps>::QueryBinding(target)
+			BindingQuery<BufferOps>::ErrorInfoName(target)
 		));
 	}
 
@@ -678,7 +780,7 @@ public:
 			BufferData,
 			Buffer,
 			EnumValueName(target),
-			BindingQuery<BufferOps>::QueryBinding(target)
+			BindingQuery<BufferOps>::ErrorInfoName(target)
 		));
 	}
 
@@ -708,10 +810,128 @@ public:
 			BufferData,
 			Buffer,
 			EnumValueName(target),
-			BindingQuery<BufferOps>::QueryBinding(target)
+			BindingQuery<BufferOps>::ErrorInfoName(target)
+		));
+	}
+
+	/// Uploads (sets) the buffer data from a contiguous range
+	/** This member function uploads the elements of a contiguous
+	 *  @p range (for example a @c std::array, a custom vector or a span)
+	 *  having the @c data() and @c size() member functions to the buffer
+	 *  bound to the specified @p target using the @p usage as hint.
+	 *  The data are passed to GL directly, without any intermediate copy.
+	 *  The type of the elements is checked at compile-time.
+	 *
+	 *  @see SubData
+	 *  @see CopySubData
+	 *  @throws Error
+	 */
+	template <typename Range>
+	static typename std::enable_if<
+		aux::IsBufferDataRange<Range>::value
+	>::type Data(
+		Target target,
+		const Range& range,
+		BufferUsage usage = BufferUsage::StaticDraw
+	)
+	{
+		typedef typename aux::BufferDataElement<Range>::Type GLtype;
+		OGLPLUS_GLFUNC(BufferData)(
+			GLenum(target),
+			GLsizeiptr(range.size() * sizeof(GLtype)),
+			range.data(),
+			GLenum(usage)
+		);
+		OGLPLUS_CHECK(OGLPLUS_OBJECT_ERROR_INFO(
+			BufferData,
+			Buffer,
+			EnumValueName(target),
+			BindingQuery<BufferOps>::ErrorInfoName(target)
 		));
 	}
 
+#if OGLPLUS_DOCUMENTATION_ONLY || GL_VERSION_3_0
+	/// Sets the buffer data by a @p writer filling the mapped buffer
+	/** This member function allocates storage for @p count instances
+	 *  of @c GLtype in the buffer bound to the specified @p target using
+	 *  the @p usage as hint, maps it for writing and calls
+	 *  @c writer(GLtype* data, std::size_t count) to fill it in place.
+	 *  The @p writer must be a function object (for example a lambda).
+	 *  This way the data can be generated straight into the buffer
+	 *  without a temporary container.
+	 *  If the data got corrupted while the buffer was mapped,
+	 *  (UnmapBuffer returns false) then the error is handled
+	 *  and the data should be uploaded again.
+	 *
+	 *  @code
+	 *  Buffer::Data<GLfloat>(
+	 *  	Buffer::Target::Array,
+	 *  	shape.VertexCount()*3,
+	 *  	[&shape](GLfloat* data, std::size_t count)
+	 *  	{
+	 *  		shape.Positions(StridedSpan<GLfloat>(data, count/3, 3));
+	 *  	}
+	 *  );
+	 *  @endcode
+	 *
+	 *  @see SubData
+	 *  @see TypedMap
+	 *  @throws Error
+	 *
+	 *  @glsymbols
+	 *  @glfunref{BufferData}
+	 *  @glfunref{MapBufferRange}
+	 *  @glfunref{UnmapBuffer}
+	 */
+	template <typename GLtype, typename Writer>
+	static typename std::enable_if<
+		std::is_class<Writer>::value
+	>::type Data(
+		Target target,
+		std::size_t count,
+		Writer writer,
+		BufferUsage usage = BufferUsage::StaticDraw
+	)
+	{
+		OGLPLUS_GLFUNC(BufferData)(
+			GLenum(target),
+			GLsizeiptr(count * sizeof(GLtype)),
+			nullptr,
+			GLenum(usage)
+		);
+		OGLPLUS_CHECK(OGLPLUS_OBJECT_ERROR_INFO(
+			BufferData,
+			Buffer,
+			EnumValueName(target),
+			BindingQuery<BufferOps>::ErrorInfoName(target)
+		));
+		if(count == 0) return;
+
+		// the buffer is unmapped even if the writer throws
+		TypedMap<GLtype> map(
+			target,
+			0,
+			GLsizeiptr(count),
+			BufferMapAccess::Write
+		);
+		writer(map.Data(), count);
+		if(OGLPLUS_IS_ERROR(!map.Unmap()))
+		{
+			HandleError(
+				GL_INVALID_OPERATION,
+				"The buffer data got corrupted while mapped",
+				OGLPLUS_OBJECT_ERROR_INFO(
+					UnmapBuffer,
+					Buffer,
+					EnumValueName(target),
+					BindingQuery<BufferOps>::ErrorInfoName(target)
+				),
+				Error::PropertyMapInit()
+			);
+		}
+	}
+#endif
+
 	/// Uploads (sets) the buffer data
 	/**
 	 *  @see SubData
@@ -736,7 +956,7 @@ public:
 			BufferData,
 			Buffer,
 			EnumValueName(target),
-			BindingQuery<BufferOps>::QueryBinding(target)
+			BindingQuery<BufferOps>::ErrorInfoName(target)
 		));
 	}
 
@@ -764,7 +984,7 @@ public:
 			BufferSubData,
 			Buffer,
 			EnumValueName(target),
-			BindingQuery<BufferOps>::QueryBinding(target)
+			BindingQuery<BufferOps>::ErrorInfoName(target)
 		));
 	}
 
@@ -785,7 +1005,7 @@ public:
 			BufferSubData,
 			Buffer,
 			EnumValueName(target),
-			BindingQuery<BufferOps>::QueryBinding(target)
+			BindingQuery<BufferOps>::ErrorInfoName(target)
 		));
 	}
 
@@ -812,7 +1032,38 @@ public:
 			BufferSubData,
 			Buffer,
 			EnumValueName(target),
-			BindingQuery<BufferOps>::QueryBinding(target)
+			BindingQuery<BufferOps>::ErrorInfoName(target)
+		));
+	}
+
+	/// Uploads (sets) a subrange of the buffer data from a contiguous range
+	/** The @p offset is specified in units of the elements of the range.
+	 *
+	 *  @see Data
+	 *  @see CopySubData
+	 *  @throws Error
+	 */
+	template <typename Range>
+	static typename std::enable_if<
+		aux::IsBufferDataRange<Range>::value
+	>::type SubData(
+		Target target,
+		GLintptr offset,
+		const Range& range
+	)
+	{
+		typedef typename aux::BufferDataElement<Range>::Type GLtype;
+		OGLPLUS_GLFUNC(BufferSubData)(
+			GLenum(target),
+			GLintptr(offset * sizeof(GLtype)),
+			GLsizeiptr(range.size() * sizeof(GLtype)),
+			range.data()
+		);
+		OGLPLUS_CHECK(OGLPLUS_OBJECT_ERROR_INFO(
+			BufferSubData,
+			Buffer,
+			EnumValueName(target),
+			BindingQuery<BufferOps>::ErrorInfoName(target)
 		));
 	}
 
@@ -875,7 +1126,7 @@ public:
 			ClearBufferData,
 			Buffer,
 			EnumValueName(target),
-			BindingQuery<BufferOps>::QueryBinding(target)
+			BindingQuery<BufferOps>::ErrorInfoName(target)
 		));
 	}
 
@@ -913,7 +1164,7 @@ public:
 			ClearBufferSubData,
 			Buffer,
 			EnumValueName(target),
-			BindingQuery<BufferOps>::QueryBinding(target)
+			BindingQuery<BufferOps>::ErrorInfoName(target)
 		));
 	}
 #endif
@@ -931,7 +1182,6 @@ public:
 	 *  @glsymbols
 	 *  @glfunref{BufferStorage}
 	 */
-	template <typename GLtype>
 	static void Storage(
 		Target target,
 		GLsizeiptr size,
@@ -949,7 +1199,7 @@ public:
 			BufferStorage,
 			Buffer,
 			EnumValueName(target),
-			BindingQuery<BufferOps>::QueryBinding(target)
+			BindingQuery<BufferOps>::ErrorInfoName(target)
 		));
 	}
 
@@ -0,0 +1,165 @@
+/**
+ *  @file oglplus/bulk_transform.hpp
+ *  @brief Transformation of arrays of positions and directions
+ *
+ *  @author Matus Chochlik
+ *
+ *  Copyright 2010-2013 Matus Chochlik. Distributed under the Boost
+ *  Software License, Version 1.0. (See accompanying file
+ *  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ */
+
+#pragma once
+#ifndef OGLPLUS_BULK_TRANSFORM_1310171420_HPP
+#define OGLPLUS_BULK_TRANSFORM_1310171420_HPP
+
+#include <oglplus/config_compiler.hpp>
+#include <oglplus/matrix.hpp>
+#include <oglplus/strided_span.hpp>
+#include <oglplus/auxiliary/simd.hpp>
+#include <oglplus/auxiliary/parallel_for.hpp>
+
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+
+namespace oglplus {
+
+namespace aux {
+
+template <typename T>
+inline void BulkRenormalize(StridedSpan<T> out)
+{
+	const std::size_t n = out.Components() < 3 ? out.Components() : 3;
+	T* p = out.Data();
+	for(std::size_t i=0, e=out.Size(); i!=e; ++i)
+	{
+		T l = T(0);
+		for(std::size_t c=0; c!=n; ++c)
+			l += p[c]*p[c];
+		if(l > T(0))
+		{
+			l = T(1)/std::sqrt(l);
+			for(std::size_t c=0; c!=n; ++c)
+				p[c] *= l;
+		}
+		p += out.Stride();
+	}
+}
+
+template <typename T>
+inline void BulkTransformChunk(
+	const Matrix<T, 4, 4>& m,
+	StridedSpan<const T> in,
+	StridedSpan<T> out,
+	T w,
+	bool renormalize
+)
+{
+	BulkTransformOp<T>::Apply(
+		m.Data(),
+		in.Data(),
+		in.Components(),
+		in.Stride(),
+		w,
+		out.Data(),
+		out.Components(),
+		out.Stride(),
+		in.Size()
+	);
+	if(renormalize) BulkRenormalize(out);
+}
+
+template <typename T>
+inline void BulkTransform(
+	const Matrix<T, 4, 4>& m,
+	StridedSpan<const T> in,
+	StridedSpan<T> out,
+	T w,
+	bool renormalize,
+	unsigned max_threads
+)
+{
+	assert(out.Size() >= in.Size());
+	// the in-place transformation requires the same layout
+	assert(
+		(static_cast<const void*>(in.Data()) !=
+		static_cast<const void*>(out.Data())) ||
+		(in.Stride() == out.Stride())
+	);
+	const std::size_t count = in.Size();
+	// the minimal number of tuples processed by a single thread
+	const std::size_t min_chunk = 4096;
+	ParallelFor(
+		count,
+		min_chunk,
+		max_threads,
+		[&](std::size_t begin, std::size_t end)
+		{
+			BulkTransformChunk(
+				m,
+				in.Slice(begin, end-begin),
+				out.Slice(begin, end-begin),
+				w, renormalize
+			);
+		}
+	);
+}
+
+} // namespace aux
+
+/// Transforms an array of positions by the specified matrix
+/** The tuples referenced by @p in are treated as homogeneous coordinates
+ *  of points; if they have less than four components the missing
+ *  y and z coordinates are zero and the w coordinate is one.
+ *  The first @c out.Components() coordinates of the transformed
+ *  points are stored into @p out, which may reference the same values
+ *  as @p in if it has the same stride. If @p max_threads is greater than
+ *  one then large arrays are split into parts transformed
+ *  in parallel.
+ *
+ *  @pre out.Size() >= in.Size()
+ *
+ *  @ingroup math_utils
+ */
+template <typename T>
+inline void TransformPositions(
+	const Matrix<T, 4, 4>& m,
+	typename StridedSpan<T>::ConstSpan in,
+	StridedSpan<T> out,
+	unsigned max_threads = 1
+)
+{
+	aux::BulkTransform(m, in, out, T(1), false, max_threads);
+}
+
+/// Transforms an array of directions (normals, tangents, ...)
+/** The tuples referenced by @p in are treated like vectors with the w
+ *  coordinate equal to zero, i.e. they are not affected by the translation
+ *  part of the matrix @p m. If @p renormalize is true then
+ *  the xyz part of the transformed vectors is normalized.
+ *  Otherwise this function works like @c TransformPositions.
+ *
+ *  Note that for non-uniformly scaling matrices the normals
+ *  should be transformed by the inverse transpose of the matrix.
+ *
+ *  @see TransformPositions
+ *  @see InverseTranspose3x3
+ *
+ *  @ingroup math_utils
+ */
+template <typename T>
+inline void TransformDirections(
+	const Matrix<T, 4, 4>& m,
+	typename StridedSpan<T>::ConstSpan in,
+	StridedSpan<T> out,
+	bool renormalize = false,
+	unsigned max_threads = 1
+)
+{
+	aux::BulkTransform(m, in, out, T(0), renormalize, max_threads);
+}
+
+} // namespace oglplus
+
+#endif // include guard
@@ -14,6 +14,7 @@
 #define OGLPLUS_CAPABILITY_1107121519_HPP
 
 #include <oglplus/enumerations.hpp>
+#include <oglplus/state_cache.hpp>
 
 namespace oglplus {
 
@@ -63,30 +64,45 @@ OGLPLUS_ENUM_CLASS_END(Capability)
 #include <oglplus/enums/capability_range.ipp>
 #endif
 
-inline void operator << (Capability capability, bool enable)
+namespace aux {
+
+inline void SetCapability(GLenum capability, bool enable)
 {
+	aux::StateChange change(
+		aux::StateCacheKey::Capability,
+		capability,
+		0,
+		enable?GL_TRUE:GL_FALSE
+	);
+	if(change.Redundant()) return;
 	if(enable)
 	{
-		OGLPLUS_GLFUNC(Enable)(GLenum(capability));
+		OGLPLUS_GLFUNC(Enable)(capability);
 		OGLPLUS_VERIFY(OGLPLUS_ERROR_INFO(Enable));
 	}
 	else
 	{
-		OGLPLUS_GLFUNC(Disable)(GLenum(capability));
+		OGLPLUS_GLFUNC(Disable)(capability);
 		OGLPLUS_VERIFY(OGLPLUS_ERROR_INFO(Disable));
 	}
+	change.Done();
+}
+
+} // namespace aux
+
+inline void operator << (Capability capability, bool enable)
+{
+	aux::SetCapability(GLenum(capability), enable);
 }
 
 inline void operator + (Capability capability)
 {
-	OGLPLUS_GLFUNC(Enable)(GLenum(capability));
-	OGLPLUS_VERIFY(OGLPLUS_ERROR_INFO(Enable));
+	aux::SetCapability(GLenum(capability), true);
 }
 
 inline void operator - (Capability capability)
 {
-	OGLPLUS_GLFUNC(Disable)(GLenum(capability));
-	OGLPLUS_VERIFY(OGLPLUS_ERROR_INFO(Disable));
+	aux::SetCapability(GLenum(capability), false);
 }
 
 /// Functionality enumeration
@@ -154,28 +170,17 @@ inline FunctionalityAndNumber operator | (Functionality func, GLuint number)
 
 inline void operator << (FunctionalityAndNumber func_and_num, bool enable)
 {
-	if(enable)
-	{
-		OGLPLUS_GLFUNC(Enable)(func_and_num._code);
-		OGLPLUS_VERIFY(OGLPLUS_ERROR_INFO(Enable));
-	}
-	else
-	{
-		OGLPLUS_GLFUNC(Disable)(func_and_num._code);
-		OGLPLUS_VERIFY(OGLPLUS_ERROR_INFO(Disable));
-	}
+	aux::SetCapability(func_and_num._code, enable);
 }
 
 inline void operator + (FunctionalityAndNumber func_and_num)
 {
-	OGLPLUS_GLFUNC(Enable)(func_and_num._code);
-	OGLPLUS_VERIFY(OGLPLUS_ERROR_INFO(Enable));
+	aux::SetCapability(func_and_num._code, true);
 }
 
 inline void operator - (FunctionalityAndNumber func_and_num)
 {
-	OGLPLUS_GLFUNC(Disable)(func_and_num._code);
-	OGLPLUS_VERIFY(OGLPLUS_ERROR_INFO(Disable));
+	aux::SetCapability(func_and_num._code, false);
 }
 
 } // namespace oglplus
@@ -253,6 +253,26 @@
 # endif
 #endif
 
+#if OGLPLUS_DOCUMENTATION_ONLY
+/// Compile-time switch disabling the StateCache
+/** Setting this preprocessor symbol to a nonzero value causes that
+ *  the object binds and the context state setters do not check
+ *  the current StateCache and always call GL.
+ *
+ *  By default this option is set to the same value as #OGLPLUS_LOW_PROFILE,
+ *  i.e. the state cache can be used when not in low-profile mode.
+ *
+ *  @see StateCache
+ *
+ *  @ingroup compile_time_config
+ */
+#define OGLPLUS_NO_STATE_CACHE
+#else
+# ifndef OGLPLUS_NO_STATE_CACHE
+#  define OGLPLUS_NO_STATE_CACHE OGLPLUS_LOW_PROFILE
+# endif
+#endif
+
 #if OGLPLUS_DOCUMENTATION_ONLY
 /// Compile-time switch enabling customized @ref error_handling
 /**
@@ -268,6 +288,43 @@
 # endif
 #endif
 
+#if OGLPLUS_DOCUMENTATION_ONLY
+/// Compile-time switch enabling the deferred checking of GL errors
+/** If set to a nonzero value, then the wrappers do not call glGetError
+ *  after every GL function call, but only record the ErrorInfo of the
+ *  recent calls and the errors are checked at explicit checkpoints
+ *  (see CheckDeferredErrors() and DeferredErrorCheckpoint).
+ *
+ *  By default this option is set to 0, i.e. the errors are checked
+ *  immediatelly after the GL function calls.
+ *
+ *  @see OGLPLUS_DEFERRED_ERROR_HISTORY
+ *
+ *  @ingroup compile_time_config
+ */
+#define OGLPLUS_DEFERRED_ERROR_CHECKS
+#else
+# ifndef OGLPLUS_DEFERRED_ERROR_CHECKS
+#  define OGLPLUS_DEFERRED_ERROR_CHECKS 0
+# endif
+#endif
+
+#if OGLPLUS_DOCUMENTATION_ONLY
+/// The number of recent GL calls remembered by the deferred error checks
+/**
+ *  By default this option is set to 16.
+ *
+ *  @see OGLPLUS_DEFERRED_ERROR_CHECKS
+ *
+ *  @ingroup compile_time_config
+ */
+#define OGLPLUS_DEFERRED_ERROR_HISTORY
+#else
+# ifndef OGLPLUS_DEFERRED_ERROR_HISTORY
+#  define OGLPLUS_DEFERRED_ERROR_HISTORY 16
+# endif
+#endif
+
 
 // Configuration options related to ErrorInfo
 
@@ -156,8 +156,66 @@
 #endif
 #endif
 
+#ifndef OGLPLUS_NO_THREADS
+#ifdef BOOST_NO_CXX11_HDR_THREAD
+#define OGLPLUS_NO_THREADS 1
+#else
+#define OGLPLUS_NO_THREADS 0
+#endif
+#endif
+
+#ifndef OGLPLUS_NO_THREAD_LOCAL
+#if OGLPLUS_NO_THREADS || defined(BOOST_NO_CXX11_THREAD_LOCAL)
+#define OGLPLUS_NO_THREAD_LOCAL 1
+#else
+#define OGLPLUS_NO_THREAD_LOCAL 0
+#endif
+#endif
+
 // ------- C++11 feature availability detection -------
 
+// ------- SIMD instruction set availability detection -------
+
+#if OGLPLUS_DOCUMENTATION_ONLY
+/// Compile-time switch disabling the SIMD math kernels
+/** Setting this preprocessor symbol to a nonzero value causes that
+ *  the specializations of the Vector and Matrix operations using
+ *  the SSE or AVX instructions are not used even if the target
+ *  instruction set supports them and the portable (scalar) implementation
+ *  is used instead.
+ *
+ *  By default this option is set to 0, i.e. the SIMD kernels are used
+ *  if the compiler targets an instruction set supporting them.
+ *
+ *  @ingroup compile_time_config
+ */
+#define OGLPLUS_NO_SIMD
+#else
+# ifndef OGLPLUS_NO_SIMD
+#  define OGLPLUS_NO_SIMD 0
+# endif
+#endif
+
+#ifndef OGLPLUS_USE_SSE
+#if !OGLPLUS_NO_SIMD && (\
+	defined(__SSE__) || \
+	defined(_M_X64) || \
+	(defined(_M_IX86_FP) && (_M_IX86_FP >= 1)) \
+)
+#define OGLPLUS_USE_SSE 1
+#else
+#define OGLPLUS_USE_SSE 0
+#endif
+#endif
+
+#ifndef OGLPLUS_USE_AVX
+#if !OGLPLUS_NO_SIMD && defined(__AVX__)
+#define OGLPLUS_USE_AVX 1
+#else
+#define OGLPLUS_USE_AVX 0
+#endif
+#endif
+
 #if OGLPLUS_NO_NULLPTR
 #define nullptr 0
 #endif
@@ -168,6 +226,80 @@
 #define OGLPLUS_CONSTEXPR const
 #endif
 
+#if OGLPLUS_DOCUMENTATION_ONLY
+/// Compile-time switch disabling the constexpr math utilities
+/** Setting this preprocessor symbol to a nonzero value causes that
+ *  the constructors, element access functions and the basic arithmetic
+ *  operations of Vector, Matrix and Angle and the factory functions
+ *  of ModelMatrix and CameraMatrix not requiring trigonometric functions
+ *  are not declared as @c constexpr.
+ *
+ *  By default this option is set to 0 if the compiler supports
+ *  @c constexpr functions, variadic templates and the unified
+ *  initialization syntax, and to 1 otherwise.
+ *
+ *  @ingroup compile_time_config
+ */
+#define OGLPLUS_NO_CONSTEXPR_MATH
+#else
+# ifndef OGLPLUS_NO_CONSTEXPR_MATH
+#  if OGLPLUS_NO_CONSTEXPR || \
+	OGLPLUS_NO_VARIADIC_TEMPLATES || \
+	OGLPLUS_NO_UNIFIED_INITIALIZATION_SYNTAX
+#   define OGLPLUS_NO_CONSTEXPR_MATH 1
+#  else
+#   define OGLPLUS_NO_CONSTEXPR_MATH 0
+#  endif
+# endif
+#endif
+
+#if !OGLPLUS_NO_CONSTEXPR_MATH
+#define OGLPLUS_CONSTEXPR_MATH constexpr
+#else
+#define OGLPLUS_CONSTEXPR_MATH inline
+#endif
+
+#if OGLPLUS_DOCUMENTATION_ONLY
+/// Compile-time switch disabling the detection of constant evaluation
+/** The constexpr arithmetic operations of Vector use the element-wise
+ *  implementation in constant expressions and the SIMD implementation
+ *  otherwise, if the compiler can tell these two cases apart
+ *  (with @c __builtin_is_constant_evaluated). If this symbol is set to
+ *  a nonzero value the element-wise implementation is used always,
+ *  unless #OGLPLUS_NO_CONSTEXPR_MATH is also set to a nonzero value.
+ *
+ *  By default this option is set to 0 if the compiler provides
+ *  @c __builtin_is_constant_evaluated, and to 1 otherwise.
+ *
+ *  @ingroup compile_time_config
+ */
+#define OGLPLUS_NO_CONSTANT_EVALUATION_CHECK
+#else
+# ifndef OGLPLUS_NO_CONSTANT_EVALUATION_CHECK
+#  if !OGLPLUS_NO_CONSTEXPR_MATH && defined(__has_builtin)
+#   if __has_builtin(__builtin_is_constant_evaluated)
+#    define OGLPLUS_NO_CONSTANT_EVALUATION_CHECK 0
+#   endif
+#  endif
+# endif
+# ifndef OGLPLUS_NO_CONSTANT_EVALUATION_CHECK
+#  define OGLPLUS_NO_CONSTANT_EVALUATION_CHECK 1
+# endif
+#endif
+
+// selects the expression evaluated in constant expressions (CONST_EXPR)
+// or at run-time (RUNTIME_EXPR) in the OGLPLUS_CONSTEXPR_MATH functions
+#if OGLPLUS_NO_CONSTEXPR_MATH
+#define OGLPLUS_CONSTEXPR_MATH_SELECT(CONST_EXPR, RUNTIME_EXPR) \
+	RUNTIME_EXPR
+#elif !OGLPLUS_NO_CONSTANT_EVALUATION_CHECK
+#define OGLPLUS_CONSTEXPR_MATH_SELECT(CONST_EXPR, RUNTIME_EXPR) \
+	(__builtin_is_constant_evaluated()?(CONST_EXPR):(RUNTIME_EXPR))
+#else
+#define OGLPLUS_CONSTEXPR_MATH_SELECT(CONST_EXPR, RUNTIME_EXPR) \
+	CONST_EXPR
+#endif
+
 #if !OGLPLUS_NO_NOEXCEPT
 #define OGLPLUS_NOEXCEPT(...) noexcept(__VA_ARGS__)
 #define OGLPLUS_NOEXCEPT_IF(...) noexcept(noexcept(__VA_ARGS__))
@@ -176,6 +308,12 @@
 #define OGLPLUS_NOEXCEPT_IF(...)
 #endif
 
+#if !OGLPLUS_NO_THREAD_LOCAL
+#define OGLPLUS_THREAD_LOCAL thread_local
+#else
+#define OGLPLUS_THREAD_LOCAL
+#endif
+
 // -------- helper definitions ---------
 
 #ifndef OGLPLUS_DOCUMENTATION_ONLY
@@ -17,6 +17,7 @@
 #include <oglplus/glfunc.hpp>
 #include <oglplus/error.hpp>
 #include <oglplus/blend_func.hpp>
+#include <oglplus/state_cache.hpp>
 
 namespace oglplus {
 namespace context {
@@ -35,8 +36,17 @@ public:
 	 */
 	static void BlendEquation(oglplus::BlendEquation eq)
 	{
+		aux::StateChange change(
+			aux::StateCacheKey::BlendEquation,
+			0,
+			0,
+			GLint(eq),
+			GLint(eq)
+		);
+		if(change.Redundant()) return;
 		OGLPLUS_GLFUNC(BlendEquation)(GLenum(eq));
 		OGLPLUS_VERIFY(OGLPLUS_ERROR_INFO(BlendEquation));
+		change.Done();
 	}
 
 	/// Sets the blend equation separate for RGB and alpha
@@ -49,11 +59,20 @@ public:
 		oglplus::BlendEquation eq_alpha
 	)
 	{
+		aux::StateChange change(
+			aux::StateCacheKey::BlendEquation,
+			0,
+			0,
+			GLint(eq_rgb),
+			GLint(eq_alpha)
+		);
+		if(change.Redundant()) return;
 		OGLPLUS_GLFUNC(BlendEquationSeparate)(
 			GLenum(eq_rgb),
 			GLenum(eq_alpha)
 		);
 		OGLPLUS_VERIFY(OGLPLUS_ERROR_INFO(BlendEquationSeparate));
+		change.Done();
 	}
 
 #if OGLPLUS_DOCUMENTATION_ONLY || GL_VERSION_4_0
@@ -67,6 +86,8 @@ public:
 	{
 		OGLPLUS_GLFUNC(BlendEquationi)(buffer, GLenum(eq));
 		OGLPLUS_VERIFY(OGLPLUS_ERROR_INFO(BlendEquationi));
+		// the equation is not the same for all buffers anymore
+		aux::StateChange(aux::StateCacheKey::BlendEquation, 0, 0, 0).Forget();
 	}
 
 	/// Sets the blend equation separate for RGB and alpha for a @p buffer
@@ -87,6 +108,8 @@ public:
 			GLenum(eq_alpha)
 		);
 		OGLPLUS_VERIFY(OGLPLUS_ERROR_INFO(BlendEquationSeparatei));
+		// the equation is not the same for all buffers anymore
+		aux::StateChange(aux::StateCacheKey::BlendEquation, 0, 0, 0).Forget();
 	}
 #endif
 
@@ -97,8 +120,19 @@ public:
 	 */
 	static void BlendFunc(BlendFunction src, BlendFunction dst)
 	{
+		aux::StateChange change(
+			aux::StateCacheKey::BlendFunc,
+			0,
+			0,
+			GLint(src),
+			GLint(dst),
+			GLint(src),
+			GLint(dst)
+		);
+		if(change.Redundant()) return;
 		OGLPLUS_GLFUNC(BlendFunc)(GLenum(src), GLenum(dst));
 		OGLPLUS_VERIFY(OGLPLUS_ERROR_INFO(BlendFunc));
+		change.Done();
 	}
 
 	/// Sets the blend function separate for RGB and alpha
@@ -113,6 +147,16 @@ public:
 		BlendFunction dst_alpha
 	)
 	{
+		aux::StateChange change(
+			aux::StateCacheKey::BlendFunc,
+			0,
+			0,
+			GLint(src_rgb),
+			GLint(dst_rgb),
+			GLint(src_alpha),
+			GLint(dst_alpha)
+		);
+		if(change.Redundant()) return;
 		OGLPLUS_GLFUNC(BlendFuncSeparate)(
 			GLenum(src_rgb),
 			GLenum(dst_rgb),
@@ -120,6 +164,7 @@ public:
 			GLenum(dst_alpha)
 		);
 		OGLPLUS_VERIFY(OGLPLUS_ERROR_INFO(BlendFuncSeparate));
+		change.Done();
 	}
 
 #if OGLPLUS_DOCUMENTATION_ONLY || GL_VERSION_4_0
@@ -137,6 +182,8 @@ public:
 	{
 		OGLPLUS_GLFUNC(BlendFunci)(buffer, GLenum(src), GLenum(dst));
 		OGLPLUS_VERIFY(OGLPLUS_ERROR_INFO(BlendFunci));
+		// the function is not the same for all buffers anymore
+		aux::StateChange(aux::StateCacheKey::BlendFunc, 0, 0, 0).Forget();
 	}
 
 	/// Sets the blend function separate for RGB and alpha for a @p buffer
@@ -161,6 +208,8 @@ public:
 			GLenum(dst_alpha)
 		);
 		OGLPLUS_VERIFY(OGLPLUS_ERROR_INFO(BlendFuncSeparatei));
+		// the function is not the same for all buffers anymore
+		aux::StateChange(aux::StateCacheKey::BlendFunc, 0, 0, 0).Forget();
 	}
 #endif
 
@@ -171,8 +220,19 @@ public:
 	 */
 	static void BlendColor(GLclampf r, GLclampf g, GLclampf b, GLclampf a)
 	{
+		aux::StateChange change(
+			aux::StateCacheKey::BlendColor,
+			0,
+			0,
+			aux::StateCacheBits(r),
+			aux::StateCacheBits(g),
+			aux::StateCacheBits(b),
+			aux::StateCacheBits(a)
+		);
+		if(change.Redundant()) return;
 		OGLPLUS_GLFUNC(BlendColor)(r, g, b, a);
 		OGLPLUS_VERIFY(OGLPLUS_ERROR_INFO(BlendColor));
+		change.Done();
 	}
 };
 
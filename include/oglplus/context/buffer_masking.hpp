@@ -16,6 +16,7 @@
 #include <oglplus/config_compiler.hpp>
 #include <oglplus/glfunc.hpp>
 #include <oglplus/error.hpp>
+#include <oglplus/state_cache.hpp>
 #include <oglplus/face_mode.hpp>
 
 namespace oglplus {
@@ -101,8 +102,16 @@ public:
 	 */
 	static void DepthMask(bool mask)
 	{
+		aux::StateChange change(
+			aux::StateCacheKey::DepthMask,
+			0,
+			0,
+			mask ? GL_TRUE : GL_FALSE
+		);
+		if(change.Redundant()) return;
 		OGLPLUS_GLFUNC(DepthMask)(mask ? GL_TRUE : GL_FALSE);
 		OGLPLUS_VERIFY(OGLPLUS_ERROR_INFO(DepthMask));
+		change.Done();
 	}
 
 	/// Sets the stencil @p mask
@@ -35,8 +35,7 @@ public:
 	 */
 	static void Enable(Capability capability)
 	{
-		OGLPLUS_GLFUNC(Enable)(GLenum(capability));
-		OGLPLUS_VERIFY(OGLPLUS_ERROR_INFO(Enable));
+		aux::SetCapability(GLenum(capability), true);
 	}
 
 	/// Enable a @p functionality
@@ -46,8 +45,7 @@ public:
 	 */
 	static void Enable(Functionality functionality, GLuint number)
 	{
-		OGLPLUS_GLFUNC(Enable)(GLenum(functionality)+number);
-		OGLPLUS_VERIFY(OGLPLUS_ERROR_INFO(Enable));
+		aux::SetCapability(GLenum(functionality)+number, true);
 	}
 
 	/// Disable a @p capability
@@ -57,8 +55,7 @@ public:
 	 */
 	static void Disable(Capability capability)
 	{
-		OGLPLUS_GLFUNC(Disable)(GLenum(capability));
-		OGLPLUS_VERIFY(OGLPLUS_ERROR_INFO(Disable));
+		aux::SetCapability(GLenum(capability), false);
 	}
 
 	/// Disable a @p functionality
@@ -68,8 +65,7 @@ public:
 	 */
 	static void Disable(Functionality functionality, GLuint number)
 	{
-		OGLPLUS_GLFUNC(Disable)(GLenum(functionality)+number);
-		OGLPLUS_VERIFY(OGLPLUS_ERROR_INFO(Disable));
+		aux::SetCapability(GLenum(functionality)+number, false);
 	}
 
 	/// Checks if a @p capability is enabled
@@ -79,6 +75,13 @@ public:
 	 */
 	static bool IsEnabled(Capability capability)
 	{
+		GLint cached = GL_FALSE;
+		if(aux::StateChange::Find(
+			aux::StateCacheKey::Capability,
+			GLenum(capability),
+			0,
+			cached
+		)) return cached == GL_TRUE;
 		GLboolean result = OGLPLUS_GLFUNC(IsEnabled)(GLenum(capability));
 		OGLPLUS_VERIFY(OGLPLUS_ERROR_INFO(IsEnabled));
 		return result == GL_TRUE;
@@ -91,6 +94,13 @@ public:
 	 */
 	static bool IsEnabled(Functionality functionality, GLuint number)
 	{
+		GLint cached = GL_FALSE;
+		if(aux::StateChange::Find(
+			aux::StateCacheKey::Capability,
+			GLenum(functionality)+number,
+			0,
+			cached
+		)) return cached == GL_TRUE;
 		GLboolean result = OGLPLUS_GLFUNC(IsEnabled)(
 			GLenum(functionality)+
 			number
@@ -109,6 +119,13 @@ public:
 	{
 		OGLPLUS_GLFUNC(Enablei)(GLenum(capability), index);
 		OGLPLUS_VERIFY(OGLPLUS_ERROR_INFO(Enablei));
+		// the capability is not uniform for all indices anymore
+		aux::StateChange(
+			aux::StateCacheKey::Capability,
+			GLenum(capability),
+			0,
+			GL_TRUE
+		).Forget();
 	}
 
 	/// Disable a @p capability for an indexed target
@@ -120,6 +137,13 @@ public:
 	{
 		OGLPLUS_GLFUNC(Disablei)(GLenum(capability), index);
 		OGLPLUS_VERIFY(OGLPLUS_ERROR_INFO(Disablei));
+		// the capability is not uniform for all indices anymore
+		aux::StateChange(
+			aux::StateCacheKey::Capability,
+			GLenum(capability),
+			0,
+			GL_FALSE
+		).Forget();
 	}
 
 	/// Check if a @p capability is enabled for indexed target
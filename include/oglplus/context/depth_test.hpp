@@ -16,6 +16,7 @@
 #include <oglplus/config_compiler.hpp>
 #include <oglplus/glfunc.hpp>
 #include <oglplus/error.hpp>
+#include <oglplus/state_cache.hpp>
 #include <oglplus/compare_func.hpp>
 
 namespace oglplus {
@@ -35,8 +36,16 @@ public:
 	 */
 	static void DepthFunc(CompareFunction function)
 	{
+		aux::StateChange change(
+			aux::StateCacheKey::DepthFunc,
+			0,
+			0,
+			GLint(function)
+		);
+		if(change.Redundant()) return;
 		OGLPLUS_GLFUNC(DepthFunc)(GLenum(function));
 		OGLPLUS_VERIFY(OGLPLUS_ERROR_INFO(DepthFunc));
+		change.Done();
 	}
 
 	/// Returns the depth comparison function
@@ -383,7 +383,7 @@ public:
 			GLenum(primitive),
 			count,
 			GLenum(GetDataType<T>()),
-			indices,
+			(const GLvoid**)indices,
 			draw_count
 		);
 		OGLPLUS_VERIFY(OGLPLUS_ERROR_INFO(MultiDrawElements));
@@ -718,7 +718,7 @@ public:
 			GLenum(primitive),
 			const_cast<GLsizei*>(count), //TODO remove const_cast
 			GLenum(GetDataType<T>()),
-			indices,
+			(const GLvoid**)indices,
 			draw_count,
 			const_cast<GLint*>(base_vertex) //TODO remove const_cast
 		);
@@ -726,12 +726,12 @@ public:
 	}
 #endif
 
-#if OGLPLUS_DOCUMENTATION_ONLY || GL_VERSION_4_2
+#if OGLPLUS_DOCUMENTATION_ONLY || GL_VERSION_4_2 || GL_ARB_base_instance
 	/// Draws a sequence of primitives from the bound element array buffers
 	/**
 	 *  @throws Error
 	 *
-	 *  @glverreq{4,2}
+	 *  @glvoereq{4,2,ARB,base_instance}
 	 *  @glsymbols
 	 *  @glfunref{DrawElementsInstancedBaseVertexBaseInstance}
 	 */
@@ -16,6 +16,7 @@
 #include <oglplus/config_compiler.hpp>
 #include <oglplus/glfunc.hpp>
 #include <oglplus/error.hpp>
+#include <oglplus/state_cache.hpp>
 #include <oglplus/compare_func.hpp>
 #include <oglplus/stencil_op.hpp>
 #include <oglplus/face_mode.hpp>
@@ -41,8 +42,18 @@ public:
 		GLuint mask = ~GLuint(0)
 	)
 	{
+		aux::StateChange change(
+			aux::StateCacheKey::StencilFunc,
+			0,
+			0,
+			GLint(func),
+			ref,
+			GLint(mask)
+		);
+		if(change.Redundant()) return;
 		OGLPLUS_GLFUNC(StencilFunc)(GLenum(func), ref, mask);
 		OGLPLUS_VERIFY(OGLPLUS_ERROR_INFO(StencilFunc));
+		change.Done();
 	}
 
 	/// Sets the stencil function separately for front and back faces
@@ -64,6 +75,8 @@ public:
 			mask
 		);
 		OGLPLUS_VERIFY(OGLPLUS_ERROR_INFO(StencilFuncSeparate));
+		// the function is not the same for both faces anymore
+		aux::StateChange(aux::StateCacheKey::StencilFunc, 0, 0, 0).Forget();
 	}
 
 	/// Sets the stencil operation
@@ -77,12 +90,22 @@ public:
 		StencilOperation dpass
 	)
 	{
+		aux::StateChange change(
+			aux::StateCacheKey::StencilOp,
+			0,
+			0,
+			GLint(sfail),
+			GLint(dfail),
+			GLint(dpass)
+		);
+		if(change.Redundant()) return;
 		OGLPLUS_GLFUNC(StencilOp)(
 			GLenum(sfail),
 			GLenum(dfail),
 			GLenum(dpass)
 		);
 		OGLPLUS_VERIFY(OGLPLUS_ERROR_INFO(StencilOp));
+		change.Done();
 	}
 
 	/// Sets the stencil operation separately for front and back faces
@@ -104,6 +127,8 @@ public:
 			GLenum(dpass)
 		);
 		OGLPLUS_VERIFY(OGLPLUS_ERROR_INFO(StencilOpSeparate));
+		// the operation is not the same for both faces anymore
+		aux::StateChange(aux::StateCacheKey::StencilOp, 0, 0, 0).Forget();
 	}
 
 	/// Returns the stencil function
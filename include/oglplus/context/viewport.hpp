@@ -16,6 +16,7 @@
 #include <oglplus/config_compiler.hpp>
 #include <oglplus/glfunc.hpp>
 #include <oglplus/error.hpp>
+#include <oglplus/state_cache.hpp>
 #include <vector>
 
 namespace oglplus {
@@ -125,8 +126,19 @@ public:
 	 */
 	static void Viewport(GLint x, GLint y, GLsizei w, GLsizei h)
 	{
+		aux::StateChange change(
+			aux::StateCacheKey::Viewport,
+			0,
+			0,
+			x,
+			y,
+			w,
+			h
+		);
+		if(change.Redundant()) return;
 		OGLPLUS_GLFUNC(Viewport)(x, y, w, h);
 		OGLPLUS_CHECK(OGLPLUS_ERROR_INFO(Viewport));
+		change.Done();
 	}
 
 	/// Sets the size of the current viewport starting at (0,0)
@@ -138,8 +150,19 @@ public:
 	 */
 	static void Viewport(GLsizei w, GLsizei h)
 	{
+		aux::StateChange change(
+			aux::StateCacheKey::Viewport,
+			0,
+			0,
+			0,
+			0,
+			w,
+			h
+		);
+		if(change.Redundant()) return;
 		OGLPLUS_GLFUNC(Viewport)(0, 0, w, h);
 		OGLPLUS_CHECK(OGLPLUS_ERROR_INFO(Viewport));
+		change.Done();
 	}
 
 #if OGLPLUS_DOCUMENTATION_ONLY || GL_VERSION_4_1 || GL_ARB_viewport_array
@@ -247,6 +270,8 @@ public:
 	{
 		OGLPLUS_GLFUNC(ViewportIndexedf)(viewport, x, y, width, height);
 		OGLPLUS_CHECK(OGLPLUS_ERROR_INFO(ViewportIndexedf));
+		// the viewport 0 may have been changed
+		aux::StateChange(aux::StateCacheKey::Viewport, 0, 0, 0).Forget();
 	}
 
 	/// Sets the @p extents of the specified @p viewport
@@ -260,6 +285,8 @@ public:
 	{
 		OGLPLUS_GLFUNC(ViewportIndexedfv)(viewport, extents);
 		OGLPLUS_CHECK(OGLPLUS_ERROR_INFO(ViewportIndexedfv));
+		// the viewport 0 may have been changed
+		aux::StateChange(aux::StateCacheKey::Viewport, 0, 0, 0).Forget();
 	}
 
 	/// Sets @p extents of the viewports specified by @p first and @p count
@@ -277,6 +304,8 @@ public:
 	{
 		OGLPLUS_GLFUNC(ViewportArrayv)(first, count, extents);
 		OGLPLUS_CHECK(OGLPLUS_ERROR_INFO(ViewportArrayv));
+		// the viewport 0 may have been changed
+		aux::StateChange(aux::StateCacheKey::Viewport, 0, 0, 0).Forget();
 	}
 
 	/// Returns the extents of the specified @p viewport
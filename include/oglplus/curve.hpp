@@ -20,8 +20,74 @@
 #include <array>
 #include <cmath>
 #include <cassert>
+#include <type_traits>
 
 namespace oglplus {
+namespace aux {
+
+// Evaluates a cubic Bezier curve at uniformly spaced parameter values
+// by forward differencing, i.e. with three additions per point
+template <typename Type, typename Parameter>
+class CubicBezierForwardDiff
+{
+private:
+	Type _f, _df, _d2f, _d3f;
+public:
+	// Starts at the begin of the curve with control points p[0..3],
+	// advancing the parameter by 1/n in each step
+	CubicBezierForwardDiff(const Type* p, unsigned n)
+	{
+		const Parameter h = Parameter(1)/n;
+		const Parameter h2 = h*h;
+		const Parameter h3 = h2*h;
+		const Type a = Type(p[3] - p[0] + (p[1] - p[2])*Parameter(3));
+		const Type b = Type((p[0] - p[1]*Parameter(2) + p[2])*Parameter(3));
+		const Type c = Type((p[1] - p[0])*Parameter(3));
+		_f = p[0];
+		_df = Type(a*h3 + b*h2 + c*h);
+		_d2f = Type(a*(h3*6) + b*(h2*2));
+		_d3f = Type(a*(h3*6));
+	}
+
+	// Returns the current point on the curve
+	const Type& Position(void) const
+	{
+		return _f;
+	}
+
+	// Advances to the next point on the curve
+	void Next(void)
+	{
+		_f = Type(_f + _df);
+		_df = Type(_df + _d2f);
+		_d2f = Type(_d2f + _d3f);
+	}
+};
+
+template <typename T>
+inline typename std::enable_if<std::is_arithmetic<T>::value, T>::type
+CurvePointDistance(T a, T b)
+{
+	return std::fabs(a - b);
+}
+
+template <typename T, std::size_t N>
+inline T CurvePointDistance(const Vector<T, N>& a, const Vector<T, N>& b)
+{
+	return Distance(a, b);
+}
+
+// The identity projection of curve points
+struct CurveNoProjection
+{
+	template <typename Type>
+	const Type& operator()(const Type& point) const
+	{
+		return point;
+	}
+};
+
+} // namespace aux
 
 /// A sequence of Bezier curves, connected at end points
 /** This class stores the data for a sequence of connected Bezier curves
@@ -39,8 +105,95 @@ namespace oglplus {
 template <typename Type, typename Parameter, unsigned Order>
 class BezierCurves
 {
-private:
+protected:
 	::std::vector<Type> _points;
+private:
+	typedef aux::Bezier<Type, Parameter, Order> _bezier;
+
+	// generic segment approximation
+	template <unsigned O>
+	static void _approx_segment(
+		std::integral_constant<unsigned, O>,
+		const Type* data,
+		unsigned size,
+		unsigned n,
+		Type* dest
+	)
+	{
+		const Parameter t_step = Parameter(1)/n;
+		Parameter t_sub = Parameter(0);
+		for(unsigned j=0; j!=n; ++j)
+		{
+			dest[j] = Type(_bezier::Position(data, size, t_sub));
+			t_sub += t_step;
+		}
+	}
+
+	// cubic segment approximation using forward differencing
+	static void _approx_segment(
+		std::integral_constant<unsigned, 3>,
+		const Type* data,
+		unsigned /*size*/,
+		unsigned n,
+		Type* dest
+	)
+	{
+		aux::CubicBezierForwardDiff<Type, Parameter> fd(data, n);
+		for(unsigned j=0; j!=n; ++j)
+		{
+			dest[j] = fd.Position();
+			fd.Next();
+		}
+	}
+
+	template <typename Projection>
+	static bool _is_flat(
+		const Type* p,
+		Parameter tolerance,
+		const Projection& project
+	)
+	{
+		for(unsigned i=1; i!=Order; ++i)
+		{
+			const Type l = Type(p[0]+(p[Order]-p[0])*(Parameter(i)/Order));
+			if(aux::CurvePointDistance(
+				project(p[i]),
+				project(l)
+			) > tolerance) return false;
+		}
+		return true;
+	}
+
+	template <typename Projection>
+	static void _flatten(
+		std::vector<Type>& dest,
+		const Type* p,
+		Parameter tolerance,
+		const Projection& project,
+		unsigned depth
+	)
+	{
+		if((depth == 0) || _is_flat(p, tolerance, project))
+		{
+			dest.push_back(p[0]);
+			return;
+		}
+		// de Casteljau subdivision at t = 0.5
+		Type tmp[Order+1], left[Order+1], right[Order+1];
+		for(unsigned i=0; i!=Order+1; ++i)
+			tmp[i] = p[i];
+		left[0] = tmp[0];
+		right[Order] = tmp[Order];
+		for(unsigned k=1; k!=Order+1; ++k)
+		{
+			for(unsigned i=0; i!=Order+1-k; ++i)
+				tmp[i] = Type((tmp[i] + tmp[i+1])*Parameter(0.5));
+			left[k] = tmp[0];
+			right[Order-k] = tmp[Order-k];
+		}
+		_flatten(dest, left, tolerance, project, depth-1);
+		_flatten(dest, right, tolerance, project, depth-1);
+	}
 public:
 	/// Checks if the sequence of control points is OK for this curve type
 	static bool PointsOk(const ::std::vector<Type>& points)
@@ -127,32 +280,25 @@ public:
 	}
 
 	/// Makes a sequence of points on the curve (n points per segment)
+	/** The storage of @p dest is reused if it has sufficient capacity.
+	 *  Cubic curves are evaluated by forward differencing.
+	 */
 	void Approximate(std::vector<Type>& dest, unsigned n) const
 	{
 		unsigned s = SegmentCount();
 		dest.resize(s*n+1);
-		auto p = dest.begin(), e = dest.end();
-		const Parameter t_step = Parameter(1)/n;
-		typedef aux::Bezier<Type, Parameter, Order> b;
 		for(unsigned i=0; i!=s; ++i)
 		{
 			unsigned poffs = i*Order;
-			Parameter t_sub = Parameter(0);
-			const Type* data = _points.data() + poffs;
-			unsigned size = _points.size() - poffs;
-			for(unsigned j=0; j!=n; ++j)
-			{
-				assert(p != e);
-				*p = Type(b::Position(data, size, t_sub));
-				++p;
-				t_sub += t_step;
-			}
+			_approx_segment(
+				std::integral_constant<unsigned, Order>(),
+				_points.data() + poffs,
+				_points.size() - poffs,
+				n,
+				dest.data() + i*n
+			);
 		}
-		assert(p != e);
-		*p = _points.back();
-		++p;
-		OGLPLUS_FAKE_USE(e);
-		assert(p == e);
+		dest.back() = _points.back();
 	}
 
 	/// Returns a sequence of points on the curve (n points per segment)
@@ -162,6 +308,63 @@ public:
 		Approximate(result, n);
 		return result;
 	}
+
+	/// Makes a sequence of points on the curve with the specified tolerance
+	/** Each segment is recursively subdivided until its control points
+	 *  are within @p tolerance from the chord between its end points.
+	 *  The distances are measured between the points transformed by
+	 *  the @p project function, so for example with a function projecting
+	 *  the points to the screen, the @p tolerance is in pixels.
+	 *  This way the number of the generated points depends on the
+	 *  curvature of the individual segments and their size on the screen
+	 *  instead of being fixed.
+	 *  The recursion is limited to @p max_depth levels, i.e. to
+	 *  2^max_depth points per segment. The storage of @p dest is reused
+	 *  if it has sufficient capacity.
+	 *
+	 *  The @p project function must accept a @c Type value and
+	 *  return a scalar or a Vector.
+	 */
+	template <typename Projection>
+	void ApproximateAdaptive(
+		std::vector<Type>& dest,
+		Parameter tolerance,
+		const Projection& project,
+		unsigned max_depth = 10
+	) const
+	{
+		assert(tolerance > Parameter(0));
+		dest.clear();
+		for(unsigned i=0, s=SegmentCount(); i!=s; ++i)
+		{
+			_flatten(
+				dest,
+				_points.data() + i*Order,
+				tolerance,
+				project,
+				max_depth
+			);
+		}
+		dest.push_back(_points.back());
+	}
+
+	/// Makes a sequence of points on the curve with the specified tolerance
+	/** This overload measures the distances directly between the points
+	 *  on the curve.
+	 */
+	void ApproximateAdaptive(
+		std::vector<Type>& dest,
+		Parameter tolerance,
+		unsigned max_depth = 10
+	) const
+	{
+		ApproximateAdaptive(
+			dest,
+			tolerance,
+			aux::CurveNoProjection(),
+			max_depth
+		);
+	}
 };
 
 /// A closed smooth cubic Bezier spline passing through all input points
@@ -178,14 +381,15 @@ class CubicBezierLoop
 {
 private:
 	template <typename StdRange>
-	static std::vector<Type> _make_cpoints(
+	static void _make_cpoints(
 		const StdRange& points,
-		Parameter r
+		Parameter r,
+		std::vector<Type>& result
 	)
 	{
 		std::size_t i = 0, n = points.size();
 		assert(n != 0);
-		std::vector<Type> result(n * 3 + 1);
+		result.resize(n * 3 + 1);
 		auto ir = result.begin();
 		while(i != n)
 		{
@@ -207,6 +411,16 @@ private:
 		assert(ir != result.end());
 		*ir = points[0]; ++ir;
 		assert(ir == result.end());
+	}
+
+	template <typename StdRange>
+	static std::vector<Type> _make_cpoints(
+		const StdRange& points,
+		Parameter r
+	)
+	{
+		std::vector<Type> result;
+		_make_cpoints(points, r, result);
 		return result;
 	}
 public:
@@ -223,6 +437,20 @@ public:
 		Parameter r = Parameter(1)/Parameter(3)
 	): BezierCurves<Type, Parameter, 3>(_make_cpoints(points, r))
 	{ }
+
+	/// Recalculates the loop to pass through new input points
+	/** The storage for the control points is reused, so unlike
+	 *  constructing a new loop this does not allocate memory if
+	 *  the number of points does not grow.
+	 */
+	template <typename StdRange>
+	void Update(
+		const StdRange& points,
+		Parameter r = Parameter(1)/Parameter(3)
+	)
+	{
+		_make_cpoints(points, r, this->_points);
+	}
 };
 
 } // namespace oglplus
@@ -25,6 +25,11 @@
 #include <functional>
 #endif
 
+#if OGLPLUS_DEFERRED_ERROR_CHECKS
+#include <type_traits>
+#include <new>
+#endif
+
 #define OGLPLUS_ERROR_INFO_CONTEXT(CONTEXT, CLASS) \
 	static const char* _errinf_ctxt(void) \
 	{ \
@@ -1096,6 +1101,166 @@ void HandleError(
 
 void HandleError(GLenum code, const ErrorInfo& info, bool assertion);
 
+#if OGLPLUS_DOCUMENTATION_ONLY || OGLPLUS_DEFERRED_ERROR_CHECKS
+namespace aux {
+
+// Ring buffer keeping the ErrorInfo of the recent unchecked GL calls
+class DeferredErrorHistory
+{
+private:
+	static_assert(
+		std::is_trivially_destructible<ErrorInfo>::value,
+		"ErrorInfo must be trivially destructible"
+	);
+
+	static const std::size_t _capacity = OGLPLUS_DEFERRED_ERROR_HISTORY;
+
+	std::aligned_storage<
+		sizeof(ErrorInfo),
+		std::alignment_of<ErrorInfo>::value
+	>::type _infos[_capacity];
+	bool _assertions[_capacity];
+
+	std::size_t _next, _size, _total;
+
+	std::size_t _pos(std::size_t age) const
+	{
+		assert(age < _size);
+		return (_next + _capacity - age - 1) % _capacity;
+	}
+public:
+	DeferredErrorHistory(void)
+	 : _next(0)
+	 , _size(0)
+	 , _total(0)
+	{ }
+
+	void Push(const ErrorInfo& info, bool assertion)
+	{
+		// ErrorInfo is not assignable but it is trivially destructible
+		new(static_cast<void*>(_infos+_next)) ErrorInfo(info);
+		_assertions[_next] = assertion;
+		_next = (_next + 1) % _capacity;
+		if(_size < _capacity) ++_size;
+		++_total;
+	}
+
+	// the number of remembered calls
+	std::size_t Size(void) const
+	{
+		return _size;
+	}
+
+	// the number of calls since the last checkpoint
+	std::size_t Total(void) const
+	{
+		return _total;
+	}
+
+	// the info about a remembered call (age 0 is the most recent call)
+	const ErrorInfo& Info(std::size_t age) const
+	{
+		return *reinterpret_cast<const ErrorInfo*>(_infos+_pos(age));
+	}
+
+	// true if the call "should not" fail (it was a VERIFY site)
+	bool Assertion(std::size_t age) const
+	{
+		return _assertions[_pos(age)];
+	}
+
+	void Clear(void)
+	{
+		_size = 0;
+		_total = 0;
+	}
+};
+
+DeferredErrorHistory& _deferred_errors(void);
+
+const char* _deferred_error_name(GLenum error_code);
+
+inline void DeferErrorCheck(const ErrorInfo& info, bool assertion)
+{
+	_deferred_errors().Push(info, assertion);
+}
+
+} // namespace aux
+
+/// Checks for GL errors that occured since the last checkpoint
+/** This function is available only if the #OGLPLUS_DEFERRED_ERROR_CHECKS
+ *  compile-time switch is set to a nonzero value. In that case it
+ *  should be called at the points where the application wants to
+ *  detect errors, for example at the end of every frame.
+ *
+ *  Since the error is not checked immediatelly after the failed call,
+ *  the ErrorInfo of the thrown Error describes the most likely offending
+ *  call, which is the most recent of the remembered calls whose failure
+ *  depends on run-time parameters, or the most recent call if there
+ *  are no such calls. The GL symbols of all the remembered calls are
+ *  listed in the @c "DeferredCalls" property of the Error.
+ *
+ *  @see DeferredErrorCheckpoint
+ *  @see #OGLPLUS_DEFERRED_ERROR_HISTORY
+ *
+ *  @throws Error
+ *
+ *  @ingroup error_handling
+ */
+void CheckDeferredErrors(void);
+
+/// Forgets the unchecked calls without checking for GL errors
+/** This function is available only if the #OGLPLUS_DEFERRED_ERROR_CHECKS
+ *  compile-time switch is set to a nonzero value.
+ *
+ *  @ingroup error_handling
+ */
+inline void ForgetDeferredErrors(void)
+{
+	aux::_deferred_errors().Clear();
+}
+
+/// A RAII class checking for deferred GL errors at the end of a scope
+/** This class is available only if the #OGLPLUS_DEFERRED_ERROR_CHECKS
+ *  compile-time switch is set to a nonzero value. The destructor does
+ *  not throw if the scope is left because of an exception, but the
+ *  errors remain pending until the next checkpoint in that case.
+ *
+ *  @code
+ *  {
+ *    DeferredErrorCheckpoint checkpoint;
+ *    // render the frame
+ *  } // throws if any of the GL calls above failed
+ *  @endcode
+ *
+ *  @see CheckDeferredErrors
+ *
+ *  @ingroup error_handling
+ */
+class DeferredErrorCheckpoint
+{
+public:
+	DeferredErrorCheckpoint(void)
+	{
+		CheckDeferredErrors();
+	}
+
+#if !OGLPLUS_NO_DELETED_FUNCTIONS
+	DeferredErrorCheckpoint(const DeferredErrorCheckpoint&) = delete;
+#else
+private:
+	DeferredErrorCheckpoint(const DeferredErrorCheckpoint&);
+public:
+#endif
+
+	~DeferredErrorCheckpoint(void)
+	OGLPLUS_NOEXCEPT(false)
+	{
+		if(!std::uncaught_exception()) CheckDeferredErrors();
+	}
+};
+#endif // OGLPLUS_DEFERRED_ERROR_CHECKS
+
 #if OGLPLUS_DOCUMENTATION_ONLY
 /// This macro decides if error handling should be done
 /** The @p EXPRESSION parameter is a boolean expression
@@ -1119,10 +1284,16 @@ void HandleError(GLenum code, const ErrorInfo& info, bool assertion);
 #endif
 
 #ifndef OGLPLUS_CHECK
+#if !OGLPLUS_DEFERRED_ERROR_CHECKS
 #define OGLPLUS_CHECK(PARAM) { \
 	GLenum error_code = ::glGetError(); \
 	if(error_code != GL_NO_ERROR) HandleError(error_code, PARAM, false); \
 }
+#else
+#define OGLPLUS_CHECK(PARAM) { \
+	::oglplus::aux::DeferErrorCheck(PARAM, false); \
+}
+#endif
 #endif
 
 #if OGLPLUS_DOCUMENTATION_ONLY
@@ -1135,17 +1306,40 @@ void HandleError(GLenum code, const ErrorInfo& info, bool assertion);
 #endif
 
 #ifndef OGLPLUS_VERIFY
-#if !OGPLUS_LOW_PROFILE
+#if !OGPLUS_LOW_PROFILE && !OGLPLUS_DEFERRED_ERROR_CHECKS
 #define OGLPLUS_VERIFY(PARAM) { \
 	GLenum error_code = ::glGetError(); \
 	if(error_code != GL_NO_ERROR) HandleError(error_code, PARAM, true); \
 }
+#elif !OGPLUS_LOW_PROFILE
+#define OGLPLUS_VERIFY(PARAM) { \
+	::oglplus::aux::DeferErrorCheck(PARAM, true); \
+}
 #else
 #define OGLPLUS_VERIFY(PARAM)
 #endif
 #endif
 
+#if OGLPLUS_DOCUMENTATION_ONLY
+/// Macro clearing the error caused by the previous call to GL
+/** This macro is called after calls to GL functions whose failure
+ *  is not important, for example in destructors. If the deferred
+ *  error checks are enabled, this macro does nothing, because it would
+ *  also clear the errors of the preceding unchecked calls. Possible
+ *  errors are then reported by the next checkpoint.
+ *
+ *  @see #OGLPLUS_DEFERRED_ERROR_CHECKS
+ */
+#define OGLPLUS_IGNORE(PARAM)
+#endif
+
+#ifndef OGLPLUS_IGNORE
+#if !OGLPLUS_DEFERRED_ERROR_CHECKS
 #define OGLPLUS_IGNORE(PARAM) ::glGetError();
+#else
+#define OGLPLUS_IGNORE(PARAM)
+#endif
+#endif
 
 } // namespace oglplus
 
@@ -18,6 +18,7 @@
 #include <oglplus/string.hpp>
 #include <oglplus/glfunc.hpp>
 #include <oglplus/enumerations.hpp>
+#include <oglplus/capability.hpp>
 
 #include <cassert>
 #include <stack>
@@ -246,20 +247,7 @@ public:
 	/// Enables or disables synchronous debug output
 	static void Synchronous(bool enable)
 	{
-		if(enable)
-		{
-			OGLPLUS_GLFUNC(Enable)(
-				GL_DEBUG_OUTPUT_SYNCHRONOUS_ARB
-			);
-			OGLPLUS_VERIFY(OGLPLUS_ERROR_INFO(Enable));
-		}
-		else
-		{
-			OGLPLUS_GLFUNC(Disable)(
-				GL_DEBUG_OUTPUT_SYNCHRONOUS_ARB
-			);
-			OGLPLUS_VERIFY(OGLPLUS_ERROR_INFO(Disable));
-		}
+		aux::SetCapability(GL_DEBUG_OUTPUT_SYNCHRONOUS_ARB, enable);
 	}
 
 	/// Inserts a new message into the debug output
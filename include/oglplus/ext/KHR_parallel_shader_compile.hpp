@@ -0,0 +1,59 @@
+/**
+ *  @file oglplus/ext/KHR_parallel_shader_compile.hpp
+ *  @brief Wrapper for the KHR_parallel_shader_compile extension
+ *
+ *  @author Matus Chochlik
+ *
+ *  Copyright 2010-2013 Matus Chochlik. Distributed under the Boost
+ *  Software License, Version 1.0. (See accompanying file
+ *  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ */
+
+#pragma once
+#ifndef OGLPLUS_EXT_KHR_PARALLEL_SHADER_COMPILE_1311101450_HPP
+#define OGLPLUS_EXT_KHR_PARALLEL_SHADER_COMPILE_1311101450_HPP
+
+#include <oglplus/extension.hpp>
+
+namespace oglplus {
+
+// The availability of the extension is checked at run-time unless
+// it is done by GLEW, which requires the extension to be in its headers
+#if OGLPLUS_DOCUMENTATION_ONLY || \
+	GL_KHR_parallel_shader_compile || \
+	!OGLPLUS_USE_GLEW
+/// Wrapper for the KHR_parallel_shader_compile extension
+/** The completion of the asynchronous compilation and linking
+ *  can be checked with Shader::CompletionStatus and
+ *  Program::CompletionStatus.
+ *
+ *  @glsymbols
+ *  @glextref{KHR,parallel_shader_compile}
+ *
+ *  @ingroup gl_extensions
+ */
+class KHR_parallel_shader_compile
+{
+public:
+	OGLPLUS_EXTENSION_CLASS(KHR, parallel_shader_compile)
+
+#if OGLPLUS_DOCUMENTATION_ONLY || GL_KHR_parallel_shader_compile
+	/// Sets the number of threads used by the driver to compile shaders
+	/** The value 0xFFFFFFFF lets the driver use as many threads
+	 *  as it finds suitable, 0 disables the parallel compilation.
+	 *
+	 *  @glsymbols
+	 *  @glfunref{MaxShaderCompilerThreadsKHR}
+	 */
+	static void MaxShaderCompilerThreads(GLuint count)
+	{
+		OGLPLUS_GLFUNC(MaxShaderCompilerThreadsKHR)(count);
+		OGLPLUS_VERIFY(OGLPLUS_ERROR_INFO(MaxShaderCompilerThreadsKHR));
+	}
+#endif
+};
+#endif
+
+} // namespace oglplus
+
+#endif // include guard
@@ -250,7 +250,7 @@ public:
 			CheckFramebufferStatus,
 			Framebuffer,
 			EnumValueName(target),
-			BindingQuery<FramebufferOps>::QueryBinding(target)
+			BindingQuery<FramebufferOps>::ErrorInfoName(target)
 		));
 		return FramebufferStatus(result);
 	}
@@ -307,7 +307,7 @@ public:
 			FramebufferRenderbuffer,
 			Framebuffer,
 			EnumValueName(target),
-			BindingQuery<FramebufferOps>::QueryBinding(target)
+			BindingQuery<FramebufferOps>::ErrorInfoName(target)
 		));
 	}
 
@@ -340,7 +340,7 @@ public:
 			FramebufferRenderbuffer,
 			Framebuffer,
 			EnumValueName(target),
-			BindingQuery<FramebufferOps>::QueryBinding(target)
+			BindingQuery<FramebufferOps>::ErrorInfoName(target)
 		));
 	}
 
@@ -375,7 +375,7 @@ public:
 			FramebufferTexture,
 			Framebuffer,
 			EnumValueName(target),
-			BindingQuery<FramebufferOps>::QueryBinding(target)
+			BindingQuery<FramebufferOps>::ErrorInfoName(target)
 		));
 	}
 
@@ -409,7 +409,7 @@ public:
 			FramebufferTexture,
 			Framebuffer,
 			EnumValueName(target),
-			BindingQuery<FramebufferOps>::QueryBinding(target)
+			BindingQuery<FramebufferOps>::ErrorInfoName(target)
 		));
 	}
 #endif
@@ -447,7 +447,7 @@ public:
 			FramebufferTexture1D,
 			Framebuffer,
 			EnumValueName(target),
-			BindingQuery<FramebufferOps>::QueryBinding(target)
+			BindingQuery<FramebufferOps>::ErrorInfoName(target)
 		));
 	}
 #endif
@@ -484,7 +484,7 @@ public:
 			FramebufferTexture2D,
 			Framebuffer,
 			EnumValueName(target),
-			BindingQuery<FramebufferOps>::QueryBinding(target)
+			BindingQuery<FramebufferOps>::ErrorInfoName(target)
 		));
 	}
 
@@ -523,7 +523,7 @@ public:
 			FramebufferTexture3D,
 			Framebuffer,
 			EnumValueName(target),
-			BindingQuery<FramebufferOps>::QueryBinding(target)
+			BindingQuery<FramebufferOps>::ErrorInfoName(target)
 		));
 	}
 #endif
@@ -560,7 +560,7 @@ public:
 			FramebufferTextureLayer,
 			Framebuffer,
 			EnumValueName(target),
-			BindingQuery<FramebufferOps>::QueryBinding(target)
+			BindingQuery<FramebufferOps>::ErrorInfoName(target)
 		));
 	}
 };
@@ -0,0 +1,467 @@
+/**
+ *  @file oglplus/frustum.hpp
+ *  @brief View frustum and batched bounding volume culling
+ *
+ *  @author Matus Chochlik
+ *
+ *  Copyright 2010-2013 Matus Chochlik. Distributed under the Boost
+ *  Software License, Version 1.0. (See accompanying file
+ *  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ */
+
+#pragma once
+#ifndef OGLPLUS_FRUSTUM_1310221315_HPP
+#define OGLPLUS_FRUSTUM_1310221315_HPP
+
+#include <oglplus/config_compiler.hpp>
+#include <oglplus/vector.hpp>
+#include <oglplus/matrix.hpp>
+#include <oglplus/plane.hpp>
+#include <oglplus/sphere.hpp>
+#include <oglplus/auxiliary/simd.hpp>
+
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace oglplus {
+
+/// An array of bounding spheres stored as a structure of arrays
+/** The coordinates of the centers and the radii of the spheres are
+ *  stored in separate arrays, which allows to test several spheres
+ *  at once with the SIMD instructions.
+ *
+ *  @see Frustum
+ *
+ *  @ingroup math_utils
+ */
+template <typename T>
+class BoundingSphereArrays
+{
+private:
+	std::vector<T> _v[4];
+public:
+	/// Returns the number of spheres
+	std::size_t Size(void) const
+	{
+		return _v[3].size();
+	}
+
+	/// Reserves storage for @p count spheres
+	void Reserve(std::size_t count)
+	{
+		for(std::size_t c=0; c!=4; ++c)
+			_v[c].reserve(count);
+	}
+
+	/// Removes all spheres
+	void Clear(void)
+	{
+		for(std::size_t c=0; c!=4; ++c)
+			_v[c].clear();
+	}
+
+	/// Appends a sphere with the specified @p center and @p radius
+	void Append(const Vector<T, 3>& center, T radius)
+	{
+		assert(radius >= T(0));
+		for(std::size_t c=0; c!=3; ++c)
+			_v[c].push_back(center.At(c));
+		_v[3].push_back(radius);
+	}
+
+	/// Appends the specified @p sphere
+	void Append(const Sphere<T>& sphere)
+	{
+		Append(sphere.Center(), sphere.Radius());
+	}
+
+	/// Replaces the sphere at the specified @p index
+	void Set(std::size_t index, const Sphere<T>& sphere)
+	{
+		assert(index < Size());
+		for(std::size_t c=0; c!=3; ++c)
+			_v[c][index] = sphere.Center().At(c);
+		_v[3][index] = sphere.Radius();
+	}
+
+	/// Returns the sphere at the specified @p index
+	Sphere<T> At(std::size_t index) const
+	{
+		assert(index < Size());
+		return Sphere<T>(
+			_v[0][index],
+			_v[1][index],
+			_v[2][index],
+			_v[3][index]
+		);
+	}
+
+	/// Returns the array of the x, y or z coordinates or the radii
+	const T* Data(std::size_t component) const
+	{
+		assert(component < 4);
+		return _v[component].data();
+	}
+};
+
+/// An array of axis-aligned bounding boxes stored as a structure of arrays
+/** The boxes are stored as the coordinates of their centers and
+ *  their half-extents along the x, y and z axes, each in a separate array.
+ *
+ *  @see Frustum
+ *
+ *  @ingroup math_utils
+ */
+template <typename T>
+class BoundingBoxArrays
+{
+private:
+	std::vector<T> _c[3];
+	std::vector<T> _h[3];
+public:
+	/// Returns the number of boxes
+	std::size_t Size(void) const
+	{
+		return _c[0].size();
+	}
+
+	/// Reserves storage for @p count boxes
+	void Reserve(std::size_t count)
+	{
+		for(std::size_t c=0; c!=3; ++c)
+		{
+			_c[c].reserve(count);
+			_h[c].reserve(count);
+		}
+	}
+
+	/// Removes all boxes
+	void Clear(void)
+	{
+		for(std::size_t c=0; c!=3; ++c)
+		{
+			_c[c].clear();
+			_h[c].clear();
+		}
+	}
+
+	/// Appends a box with the specified minimal and maximal coordinates
+	void Append(const Vector<T, 3>& min, const Vector<T, 3>& max)
+	{
+		for(std::size_t c=0; c!=3; ++c)
+		{
+			assert(min.At(c) <= max.At(c));
+			_c[c].push_back((max.At(c) + min.At(c)) / T(2));
+			_h[c].push_back((max.At(c) - min.At(c)) / T(2));
+		}
+	}
+
+	/// Replaces the box at the specified @p index
+	void Set(
+		std::size_t index,
+		const Vector<T, 3>& min,
+		const Vector<T, 3>& max
+	)
+	{
+		assert(index < Size());
+		for(std::size_t c=0; c!=3; ++c)
+		{
+			assert(min.At(c) <= max.At(c));
+			_c[c][index] = (max.At(c) + min.At(c)) / T(2);
+			_h[c][index] = (max.At(c) - min.At(c)) / T(2);
+		}
+	}
+
+	/// Returns the minimal coordinates of the box at @p index
+	Vector<T, 3> Min(std::size_t index) const
+	{
+		assert(index < Size());
+		return Vector<T, 3>(
+			_c[0][index] - _h[0][index],
+			_c[1][index] - _h[1][index],
+			_c[2][index] - _h[2][index]
+		);
+	}
+
+	/// Returns the maximal coordinates of the box at @p index
+	Vector<T, 3> Max(std::size_t index) const
+	{
+		assert(index < Size());
+		return Vector<T, 3>(
+			_c[0][index] + _h[0][index],
+			_c[1][index] + _h[1][index],
+			_c[2][index] + _h[2][index]
+		);
+	}
+
+	/// Returns the array of the x, y or z coordinates of the centers
+	const T* Centers(std::size_t component) const
+	{
+		assert(component < 3);
+		return _c[component].data();
+	}
+
+	/// Returns the array of the x, y or z half-extents
+	const T* HalfExtents(std::size_t component) const
+	{
+		assert(component < 3);
+		return _h[component].data();
+	}
+};
+
+/// A view frustum for culling of bounding volumes
+/** The frustum is defined by six planes extracted from a view-projection
+ *  matrix (for example the product of a perspective CameraMatrix and
+ *  a LookingAt CameraMatrix or the product of these with a ModelMatrix
+ *  to cull in model space). The normals of the planes point into
+ *  the frustum.
+ *
+ *  The Cull and CullIndices functions test arrays of bounding spheres
+ *  or boxes against all planes and return a visibility bitmask or
+ *  a compacted list of indices of the potentially visible volumes.
+ *  The test is conservative, i.e. some volumes near the edges
+ *  of the frustum may be reported as visible even if they are outside.
+ *
+ *  @ingroup math_utils
+ */
+template <typename T>
+class Frustum
+{
+private:
+	// the a, b, c, d coefficients of the six planes
+	T _planes[6*4];
+
+	void _set_plane(
+		std::size_t p,
+		const Matrix<T, 4, 4>& m,
+		std::size_t r,
+		T s
+	)
+	{
+		T* e = _planes + p*4;
+		for(std::size_t c=0; c!=4; ++c)
+			e[c] = m.At(3, c) + s*m.At(r, c);
+		const T l = std::sqrt(e[0]*e[0] + e[1]*e[1] + e[2]*e[2]);
+		assert(l > T(0));
+		for(std::size_t c=0; c!=4; ++c)
+			e[c] /= l;
+	}
+public:
+	/// The indices of the planes of the frustum
+	enum {
+		Left, Right,
+		Bottom, Top,
+		Near, Far,
+		PlaneCount
+	};
+
+	/// Extracts the planes of the frustum from a view-projection matrix
+	Frustum(const Matrix<T, 4, 4>& view_projection)
+	{
+		_set_plane(Left,   view_projection, 0, T( 1));
+		_set_plane(Right,  view_projection, 0, T(-1));
+		_set_plane(Bottom, view_projection, 1, T( 1));
+		_set_plane(Top,    view_projection, 1, T(-1));
+		_set_plane(Near,   view_projection, 2, T( 1));
+		_set_plane(Far,    view_projection, 2, T(-1));
+	}
+
+	/// Returns the plane with the specified index
+	/**
+	 *  @pre index < PlaneCount
+	 */
+	Plane<T> PlaneAt(std::size_t index) const
+	{
+		assert(index < PlaneCount);
+		const T* e = _planes + index*4;
+		return Plane<T>(e[0], e[1], e[2], e[3]);
+	}
+
+	/// Returns true if the @p sphere is (potentially) inside the frustum
+	bool Intersects(const Sphere<T>& sphere) const
+	{
+		const T v[4] = {
+			sphere.Center().x(),
+			sphere.Center().y(),
+			sphere.Center().z(),
+			sphere.Radius()
+		};
+		const T* const s[4] = {v+0, v+1, v+2, v+3};
+		std::uint32_t mask = 0;
+		aux::FrustumCullSpheresScalar(_planes, s, 0, 1, &mask);
+		return mask != 0;
+	}
+
+	/// Returns the number of 32-bit words needed for a bitmask of @p count
+	static std::size_t MaskSize(std::size_t count)
+	{
+		return (count + 31) / 32;
+	}
+
+	/// Tests the @p spheres and stores the results into the @p mask
+	/** After this call the bit (i % 32) in the (i / 32)-th word of @p mask
+	 *  is set if the i-th sphere is potentially visible.
+	 */
+	void Cull(
+		const BoundingSphereArrays<T>& spheres,
+		std::vector<std::uint32_t>& mask
+	) const
+	{
+		mask.assign(MaskSize(spheres.Size()), 0);
+		if(spheres.Size() == 0) return;
+		const T* const s[4] = {
+			spheres.Data(0),
+			spheres.Data(1),
+			spheres.Data(2),
+			spheres.Data(3)
+		};
+		aux::FrustumCullOp<T>::Spheres(
+			_planes,
+			s,
+			spheres.Size(),
+			mask.data()
+		);
+	}
+
+	/// Tests the @p boxes and stores the results into the @p mask
+	/**
+	 *  @see Cull(const BoundingSphereArrays<T>&, std::vector<std::uint32_t>&)
+	 */
+	void Cull(
+		const BoundingBoxArrays<T>& boxes,
+		std::vector<std::uint32_t>& mask
+	) const
+	{
+		mask.assign(MaskSize(boxes.Size()), 0);
+		if(boxes.Size() == 0) return;
+		const T* const c[3] = {
+			boxes.Centers(0),
+			boxes.Centers(1),
+			boxes.Centers(2)
+		};
+		const T* const h[3] = {
+			boxes.HalfExtents(0),
+			boxes.HalfExtents(1),
+			boxes.HalfExtents(2)
+		};
+		aux::FrustumCullOp<T>::Boxes(
+			_planes,
+			c, h,
+			boxes.Size(),
+			mask.data()
+		);
+	}
+
+	/// Appends the indices of the potentially visible @p spheres
+	/** Before culling, the capacity of @p indices is reserved for
+	 *  the case that all the spheres are visible, so it is reallocated
+	 *  at most once (and not at all if its capacity is sufficient).
+	 *  No other memory is allocated.
+	 *  Returns the number of potentially visible spheres.
+	 */
+	template <typename Index>
+	std::size_t CullIndices(
+		const BoundingSphereArrays<T>& spheres,
+		std::vector<Index>& indices
+	) const
+	{
+		return _cull_indices(spheres, indices);
+	}
+
+	/// Appends the indices of the potentially visible @p boxes
+	/**
+	 *  @see CullIndices(const BoundingSphereArrays<T>&, std::vector<Index>&)
+	 */
+	template <typename Index>
+	std::size_t CullIndices(
+		const BoundingBoxArrays<T>& boxes,
+		std::vector<Index>& indices
+	) const
+	{
+		return _cull_indices(boxes, indices);
+	}
+private:
+	void _cull_chunk(
+		const BoundingSphereArrays<T>& spheres,
+		std::size_t offset,
+		std::size_t count,
+		std::uint32_t* mask
+	) const
+	{
+		const T* const s[4] = {
+			spheres.Data(0) + offset,
+			spheres.Data(1) + offset,
+			spheres.Data(2) + offset,
+			spheres.Data(3) + offset
+		};
+		aux::FrustumCullOp<T>::Spheres(_planes, s, count, mask);
+	}
+
+	void _cull_chunk(
+		const BoundingBoxArrays<T>& boxes,
+		std::size_t offset,
+		std::size_t count,
+		std::uint32_t* mask
+	) const
+	{
+		const T* const c[3] = {
+			boxes.Centers(0) + offset,
+			boxes.Centers(1) + offset,
+			boxes.Centers(2) + offset
+		};
+		const T* const h[3] = {
+			boxes.HalfExtents(0) + offset,
+			boxes.HalfExtents(1) + offset,
+			boxes.HalfExtents(2) + offset
+		};
+		aux::FrustumCullOp<T>::Boxes(_planes, c, h, count, mask);
+	}
+
+	template <typename Volumes, typename Index>
+	std::size_t _cull_indices(
+		const Volumes& volumes,
+		std::vector<Index>& indices
+	) const
+	{
+		// the volumes are tested in chunks with a bitmask on the stack
+		const std::size_t mask_size = 64;
+		const std::size_t chunk = mask_size*32;
+		std::uint32_t mask[mask_size];
+		const std::size_t total = volumes.Size();
+		const std::size_t before = indices.size();
+		indices.reserve(before + total);
+		for(std::size_t offset=0; offset < total; offset += chunk)
+		{
+			const std::size_t count = (offset + chunk < total)?
+				chunk:
+				total - offset;
+			for(std::size_t w=0; w!=mask_size; ++w)
+				mask[w] = 0;
+			_cull_chunk(volumes, offset, count, mask);
+			for(std::size_t w=0, n=MaskSize(count); w!=n; ++w)
+			{
+				std::uint32_t bits = mask[w];
+				std::size_t i = offset + w*32;
+				while(bits)
+				{
+					if(bits & 1) indices.push_back(Index(i));
+					bits >>= 1;
+					++i;
+				}
+			}
+		}
+		return indices.size() - before;
+	}
+};
+
+#if OGLPLUS_DOCUMENTATION_ONLY || defined(GL_FLOAT)
+/// Instantiation of Frustum using GL floating-point as underlying type
+typedef Frustum<GLfloat> Frustumf;
+#endif
+
+} // namespace oglplus
+
+#endif // include guard
@@ -31,16 +31,16 @@ template <typename T, std::size_t N>
 class Vector;
 
 template <typename T, std::size_t N>
-const T* Data(const Vector<T, N>& a);
+OGLPLUS_CONSTEXPR_MATH const T* Data(const Vector<T, N>& a);
 
 template <typename T, std::size_t N>
 std::size_t Size(const Vector<T, N>&);
 
 template <typename T, std::size_t N>
-T At(const Vector<T, N>& a, std::size_t i);
+OGLPLUS_CONSTEXPR_MATH T At(const Vector<T, N>& a, std::size_t i);
 
 template <typename T, std::size_t N>
-T At(const Vector<T, N>& a, std::size_t i, T fallback);
+OGLPLUS_CONSTEXPR_MATH T At(const Vector<T, N>& a, std::size_t i, T fallback);
 
 // Quaternion
 template <typename T>
@@ -51,19 +51,23 @@ template <typename T, std::size_t Rows, std::size_t Cols>
 class Matrix;
 
 template <typename T, std::size_t R, std::size_t C>
-const T* Data(const Matrix<T, R, C>& matrix);
+OGLPLUS_CONSTEXPR_MATH const T* Data(const Matrix<T, R, C>& matrix);
 
 template <typename T, std::size_t R, std::size_t C>
-std::size_t Size(const Matrix<T, R, C>&);
+OGLPLUS_CONSTEXPR_MATH std::size_t Size(const Matrix<T, R, C>&);
 
 template <typename T, std::size_t R, std::size_t C>
-std::size_t Rows(const Matrix<T, R, C>&);
+OGLPLUS_CONSTEXPR_MATH std::size_t Rows(const Matrix<T, R, C>&);
 
 template <typename T, std::size_t R, std::size_t C>
-std::size_t Cols(const Matrix<T, R, C>&);
+OGLPLUS_CONSTEXPR_MATH std::size_t Cols(const Matrix<T, R, C>&);
 
 template <typename T, std::size_t R, std::size_t C>
-T At(const Matrix<T, R, C>& matrix, std::size_t i, std::size_t j);
+OGLPLUS_CONSTEXPR_MATH T At(
+	const Matrix<T, R, C>& matrix,
+	std::size_t i,
+	std::size_t j
+);
 
 // ObjectTypeId
 template <typename ObjectOps>
@@ -140,6 +140,12 @@ public:
 #define GL_VERTEX_ARRAY 0x8074
 #endif
 
+// KHR_parallel_shader_compile is not in the older GL headers, but
+// its status query can be used whenever the extension is available
+#ifndef GL_COMPLETION_STATUS_KHR
+#define GL_COMPLETION_STATUS_KHR 0x91B1
+#endif
+
 #ifndef GL_BUFFER 
 #define GL_BUFFER 0x82E0
 #endif
@@ -0,0 +1,73 @@
+/**
+ *  @file oglplus/indirect_command.hpp
+ *  @brief Structures of the commands for indirect drawing
+ *
+ *  @author Matus Chochlik
+ *
+ *  Copyright 2010-2013 Matus Chochlik. Distributed under the Boost
+ *  Software License, Version 1.0. (See accompanying file
+ *  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ */
+
+#pragma once
+#ifndef OGLPLUS_INDIRECT_COMMAND_1310271152_HPP
+#define OGLPLUS_INDIRECT_COMMAND_1310271152_HPP
+
+#include <oglplus/config.hpp>
+
+namespace oglplus {
+
+/// The layout of a command read by DrawArraysIndirect from a buffer
+/** Arrays of instances of this structure can be stored in a buffer
+ *  bound to the Buffer::Target::DrawIndirect target and used by
+ *  Context::DrawArraysIndirect and Context::MultiDrawArraysIndirect.
+ *
+ *  @glverreq{4,0}
+ *  @glsymbols
+ *  @glfunref{DrawArraysIndirect}
+ */
+struct DrawArraysIndirectCommand
+{
+	/// The number of vertices
+	GLuint count;
+
+	/// The number of instances
+	GLuint instance_count;
+
+	/// The first vertex
+	GLuint first;
+
+	/// The first instance (must be zero before GL 4.2)
+	GLuint base_instance;
+};
+
+/// The layout of a command read by DrawElementsIndirect from a buffer
+/** Arrays of instances of this structure can be stored in a buffer
+ *  bound to the Buffer::Target::DrawIndirect target and used by
+ *  Context::DrawElementsIndirect and Context::MultiDrawElementsIndirect.
+ *
+ *  @glverreq{4,0}
+ *  @glsymbols
+ *  @glfunref{DrawElementsIndirect}
+ */
+struct DrawElementsIndirectCommand
+{
+	/// The number of indices
+	GLuint count;
+
+	/// The number of instances
+	GLuint instance_count;
+
+	/// The position of the first index in the element buffer
+	GLuint first_index;
+
+	/// The value added to the indices before fetching the vertices
+	GLint base_vertex;
+
+	/// The first instance (must be zero before GL 4.2)
+	GLuint base_instance;
+};
+
+} // namespace oglplus
+
+#endif // include guard
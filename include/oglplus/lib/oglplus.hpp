@@ -32,12 +32,14 @@
 #include <oglplus/auxiliary/strings.hpp>
 #include <oglplus/auxiliary/base_range.hpp>
 #include <oglplus/auxiliary/uniform_typecheck.hpp>
+#include <oglplus/auxiliary/program_reflection.hpp>
 #include <oglplus/auxiliary/info_log.hpp>
 #include <oglplus/auxiliary/glsl_source.hpp>
 #include <oglplus/auxiliary/shader_data.hpp>
 #include <oglplus/auxiliary/uniform_init.hpp>
 
 #include <oglplus/error.hpp>
+#include <oglplus/state_cache.hpp>
 #include <oglplus/compile_error.hpp>
 #include <oglplus/link_error.hpp>
 #include <oglplus/vertex_attrib.hpp>
@@ -47,6 +49,10 @@
 #include <oglplus/shader.hpp>
 #include <oglplus/program.hpp>
 #include <oglplus/program_pipeline.hpp>
+#include <oglplus/program_source.hpp>
+#include <oglplus/program_cache.hpp>
+#include <oglplus/program_build.hpp>
+#include <oglplus/streaming_buffer.hpp>
 
 #include <oglplus/imports/blend_file.hpp>
 
@@ -69,6 +75,10 @@
 #include <oglplus/shapes/draw.hpp>
 #include <oglplus/shapes/wrapper.hpp>
 #include <oglplus/shapes/analyzer.hpp>
+#include <oglplus/shapes/vertex_cache.hpp>
+#include <oglplus/shapes/lod.hpp>
+#include <oglplus/shapes/clusters.hpp>
+#include <oglplus/shapes/batch.hpp>
 
 #include <oglplus/images/image.hpp>
 #include <oglplus/images/brushed_metal.hpp>
@@ -13,26 +13,43 @@
 #ifndef OGLPLUS_MATH_1107121519_HPP
 #define OGLPLUS_MATH_1107121519_HPP
 
+#include <oglplus/config_compiler.hpp>
+
 #include <cmath>
 
 namespace oglplus {
 namespace math {
 
 #ifdef M_PI
-inline decltype(M_PI) Pi(void)
+OGLPLUS_CONSTEXPR_MATH decltype(M_PI) Pi(void)
 {
 	return M_PI;
 }
 
-inline decltype(2*M_PI) TwoPi(void)
+OGLPLUS_CONSTEXPR_MATH decltype(2*M_PI) TwoPi(void)
 {
 	return 2*M_PI;
 }
 
-inline decltype(0.5*M_PI) HalfPi(void)
+OGLPLUS_CONSTEXPR_MATH decltype(0.5*M_PI) HalfPi(void)
 {
 	return 0.5*M_PI;
 }
+#elif !OGLPLUS_NO_CONSTEXPR_MATH
+constexpr double Pi(void)
+{
+	return 3.14159265358979323846;
+}
+
+constexpr double TwoPi(void)
+{
+	return 2*3.14159265358979323846;
+}
+
+constexpr double HalfPi(void)
+{
+	return 0.5*3.14159265358979323846;
+}
 #else
 inline decltype(std::atan(1.0) * 4.0) Pi(void)
 {
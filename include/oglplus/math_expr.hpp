@@ -0,0 +1,384 @@
+/**
+ *  @file oglplus/math_expr.hpp
+ *  @brief Lazily evaluated Vector and Matrix arithmetic expressions
+ *
+ *  @author Matus Chochlik
+ *
+ *  Copyright 2010-2013 Matus Chochlik. Distributed under the Boost
+ *  Software License, Version 1.0. (See accompanying file
+ *  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ */
+
+#pragma once
+#ifndef OGLPLUS_MATH_EXPR_1310201135_HPP
+#define OGLPLUS_MATH_EXPR_1310201135_HPP
+
+#include <oglplus/config_compiler.hpp>
+#include <oglplus/vector.hpp>
+#include <oglplus/matrix.hpp>
+
+#include <cstddef>
+
+namespace oglplus {
+namespace aux {
+
+// Describes how the elements of a Vector or Matrix are accessed
+template <typename X>
+struct MathExprTraits;
+
+template <typename T, std::size_t N>
+struct MathExprTraits<Vector<T, N> >
+{
+	typedef T ValueType;
+
+	static const std::size_t Size = N;
+
+	static T Get(const Vector<T, N>& v, std::size_t i)
+	{
+		return v.Data()[i];
+	}
+
+	static void Set(Vector<T, N>& v, std::size_t i, T x)
+	{
+		v[i] = x;
+	}
+};
+
+template <typename T, std::size_t R, std::size_t C>
+struct MathExprTraits<Matrix<T, R, C> >
+{
+	typedef T ValueType;
+
+	static const std::size_t Size = R*C;
+
+	static T Get(const Matrix<T, R, C>& m, std::size_t i)
+	{
+		return m.Data()[i];
+	}
+
+	static void Set(Matrix<T, R, C>& m, std::size_t i, T x)
+	{
+		m.Set(i / C, i % C, x);
+	}
+};
+
+// Common base of all expression nodes evaluating to a Value
+template <typename Value, typename Derived>
+class MathExpr
+{
+public:
+	typedef typename MathExprTraits<Value>::ValueType ValueType;
+
+	const Derived& Self(void) const
+	{
+		return *static_cast<const Derived*>(this);
+	}
+
+	// Evaluates the expression into the @p dest Vector or Matrix
+	void EvalInto(Value& dest) const
+	{
+		typedef MathExprTraits<Value> Traits;
+		for(std::size_t i=0; i!=Traits::Size; ++i)
+			Traits::Set(dest, i, Self().At(i));
+	}
+
+	// Evaluates the expression
+	operator Value (void) const
+	{
+		Value result;
+		EvalInto(result);
+		return result;
+	}
+};
+
+// Leaf node referencing a Vector or Matrix
+template <typename Value>
+class MathExprRef
+ : public MathExpr<Value, MathExprRef<Value> >
+{
+private:
+	const Value& _v;
+public:
+	typedef typename MathExprTraits<Value>::ValueType ValueType;
+
+	MathExprRef(const Value& v)
+	 : _v(v)
+	{ }
+
+	ValueType At(std::size_t i) const
+	{
+		return MathExprTraits<Value>::Get(_v, i);
+	}
+};
+
+// Node applying an element-wise unary operation
+template <typename Value, typename E, typename Op>
+class MathExprUnary
+ : public MathExpr<Value, MathExprUnary<Value, E, Op> >
+{
+private:
+	E _e;
+public:
+	typedef typename MathExprTraits<Value>::ValueType ValueType;
+
+	MathExprUnary(const E& e)
+	 : _e(e)
+	{ }
+
+	ValueType At(std::size_t i) const
+	{
+		return Op::Apply(_e.At(i));
+	}
+};
+
+// Node applying an element-wise binary operation
+template <typename Value, typename L, typename R, typename Op>
+class MathExprBinary
+ : public MathExpr<Value, MathExprBinary<Value, L, R, Op> >
+{
+private:
+	L _l;
+	R _r;
+public:
+	typedef typename MathExprTraits<Value>::ValueType ValueType;
+
+	MathExprBinary(const L& l, const R& r)
+	 : _l(l)
+	 , _r(r)
+	{ }
+
+	ValueType At(std::size_t i) const
+	{
+		return Op::Apply(_l.At(i), _r.At(i));
+	}
+};
+
+// Node applying a binary operation to each element and a scalar
+template <typename Value, typename E, typename Op>
+class MathExprScalar
+ : public MathExpr<Value, MathExprScalar<Value, E, Op> >
+{
+public:
+	typedef typename MathExprTraits<Value>::ValueType ValueType;
+private:
+	E _e;
+	ValueType _s;
+public:
+	MathExprScalar(const E& e, ValueType s)
+	 : _e(e)
+	 , _s(s)
+	{ }
+
+	ValueType At(std::size_t i) const
+	{
+		return Op::Apply(_e.At(i), _s);
+	}
+};
+
+struct MathExprOpNegate
+{
+	template <typename T>
+	static T Apply(T a)
+	{
+		return -a;
+	}
+};
+
+struct MathExprOpAdd
+{
+	template <typename T>
+	static T Apply(T a, T b)
+	{
+		return a + b;
+	}
+};
+
+struct MathExprOpSubtract
+{
+	template <typename T>
+	static T Apply(T a, T b)
+	{
+		return a - b;
+	}
+};
+
+struct MathExprOpMultiply
+{
+	template <typename T>
+	static T Apply(T a, T b)
+	{
+		return a * b;
+	}
+};
+
+struct MathExprOpDivide
+{
+	template <typename T>
+	static T Apply(T a, T b)
+	{
+		return a / b;
+	}
+};
+
+} // namespace aux
+
+/// Starts a lazily evaluated expression with the specified Vector
+/** Arithmetic operators applied to the result of this function
+ *  (negation, addition, subtraction, multiplication and division
+ *  by a scalar) do not compute intermediate vectors, but build a light-weight
+ *  expression object, which is evaluated in a single loop when it is
+ *  converted to (assigned to or used to initialize) a Vector.
+ *
+ *  @code
+ *  Vec3f r = Lazy(a)*s + b - c;
+ *  @endcode
+ *
+ *  The expression references its operands; it should not outlive them
+ *  and should not be stored in an @c auto variable.
+ *
+ *  @see Eval
+ *  @see Assign
+ *
+ *  @ingroup math_utils
+ */
+template <typename T, std::size_t N>
+inline aux::MathExprRef<Vector<T, N> > Lazy(const Vector<T, N>& v)
+{
+	return aux::MathExprRef<Vector<T, N> >(v);
+}
+
+/// Starts a lazily evaluated expression with the specified Matrix
+/** Works like the overload for Vectors. Only the element-wise
+ *  operations are lazy, the Matrix products are always evaluated
+ *  eagerly.
+ *
+ *  @ingroup math_utils
+ */
+template <typename T, std::size_t R, std::size_t C>
+inline aux::MathExprRef<Matrix<T, R, C> > Lazy(const Matrix<T, R, C>& m)
+{
+	return aux::MathExprRef<Matrix<T, R, C> >(m);
+}
+
+/// Evaluates a lazy expression and returns the resulting Vector or Matrix
+/**
+ *  @ingroup math_utils
+ */
+template <typename Value, typename E>
+inline Value Eval(const aux::MathExpr<Value, E>& e)
+{
+	return e;
+}
+
+/// Evaluates a lazy expression directly into the @p dest Vector or Matrix
+/** Since the expressions are element-wise, @p dest may be also one
+ *  of the operands of the expression.
+ *
+ *  @ingroup math_utils
+ */
+template <typename Value, typename E>
+inline void Assign(Value& dest, const aux::MathExpr<Value, E>& e)
+{
+	e.EvalInto(dest);
+}
+
+template <typename V, typename E>
+inline aux::MathExprUnary<V, E, aux::MathExprOpNegate>
+operator - (const aux::MathExpr<V, E>& e)
+{
+	return aux::MathExprUnary<V, E, aux::MathExprOpNegate>(e.Self());
+}
+
+#define OGLPLUS_MATH_EXPR_BINARY_OP(OP, NAME) \
+template <typename V, typename L, typename R> \
+inline aux::MathExprBinary<V, L, R, aux::MathExprOp##NAME> \
+operator OP (const aux::MathExpr<V, L>& a, const aux::MathExpr<V, R>& b) \
+{ \
+	return aux::MathExprBinary<V, L, R, aux::MathExprOp##NAME>( \
+		a.Self(), \
+		b.Self() \
+	); \
+} \
+template <typename V, typename L> \
+inline aux::MathExprBinary<V, L, aux::MathExprRef<V>, aux::MathExprOp##NAME>\
+operator OP (const aux::MathExpr<V, L>& a, const V& b) \
+{ \
+	return aux::MathExprBinary< \
+		V, L, aux::MathExprRef<V>, aux::MathExprOp##NAME \
+	>(a.Self(), aux::MathExprRef<V>(b)); \
+} \
+template <typename V, typename R> \
+inline aux::MathExprBinary<V, aux::MathExprRef<V>, R, aux::MathExprOp##NAME>\
+operator OP (const V& a, const aux::MathExpr<V, R>& b) \
+{ \
+	return aux::MathExprBinary< \
+		V, aux::MathExprRef<V>, R, aux::MathExprOp##NAME \
+	>(aux::MathExprRef<V>(a), b.Self()); \
+}
+
+OGLPLUS_MATH_EXPR_BINARY_OP(+, Add)
+OGLPLUS_MATH_EXPR_BINARY_OP(-, Subtract)
+
+#undef OGLPLUS_MATH_EXPR_BINARY_OP
+
+template <typename V, typename E>
+inline aux::MathExprScalar<V, E, aux::MathExprOpMultiply>
+operator * (
+	const aux::MathExpr<V, E>& e,
+	typename aux::MathExprTraits<V>::ValueType s
+)
+{
+	return aux::MathExprScalar<V, E, aux::MathExprOpMultiply>(e.Self(), s);
+}
+
+template <typename V, typename E>
+inline aux::MathExprScalar<V, E, aux::MathExprOpMultiply>
+operator * (
+	typename aux::MathExprTraits<V>::ValueType s,
+	const aux::MathExpr<V, E>& e
+)
+{
+	return aux::MathExprScalar<V, E, aux::MathExprOpMultiply>(e.Self(), s);
+}
+
+template <typename V, typename E>
+inline aux::MathExprScalar<V, E, aux::MathExprOpDivide>
+operator / (
+	const aux::MathExpr<V, E>& e,
+	typename aux::MathExprTraits<V>::ValueType s
+)
+{
+	return aux::MathExprScalar<V, E, aux::MathExprOpDivide>(e.Self(), s);
+}
+
+/// Computes the dot product of two lazy vector expressions in a single loop
+/**
+ *  @ingroup math_utils
+ */
+template <typename T, std::size_t N, typename L, typename R>
+inline T Dot(
+	const aux::MathExpr<Vector<T, N>, L>& a,
+	const aux::MathExpr<Vector<T, N>, R>& b
+)
+{
+	T result = T(0);
+	for(std::size_t i=0; i!=N; ++i)
+		result += a.Self().At(i) * b.Self().At(i);
+	return result;
+}
+
+template <typename T, std::size_t N, typename L>
+inline T Dot(const aux::MathExpr<Vector<T, N>, L>& a, const Vector<T, N>& b)
+{
+	return Dot(a, Lazy(b));
+}
+
+template <typename T, std::size_t N, typename R>
+inline T Dot(const Vector<T, N>& a, const aux::MathExpr<Vector<T, N>, R>& b)
+{
+	return Dot(Lazy(a), b);
+}
+
+} // namespace oglplus
+
+#endif // include guard
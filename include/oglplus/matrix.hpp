@@ -147,8 +147,31 @@ typedef Matrix<GLdouble, 4, 4> Mat4d;
 
 namespace aux {
 struct Matrix_spec_ctr_tag { };
+
+#if !OGLPLUS_NO_CONSTEXPR_MATH
+// A sequence of the indices of the matrix elements
+template <std::size_t ... I>
+struct Matrix_index_seq { };
+
+template <std::size_t N, std::size_t ... I>
+struct Matrix_make_index_seq
+ : Matrix_make_index_seq<N-1, N-1, I...>
+{ };
+
+template <std::size_t ... I>
+struct Matrix_make_index_seq<0, I...>
+{
+	typedef Matrix_index_seq<I...> type;
+};
+#endif
 } // namespace aux
 
+template <typename T, std::size_t R, std::size_t N, std::size_t C>
+Matrix<T, R, C> Multiplied(const Matrix<T, R, N>&, const Matrix<T, N, C>&);
+
+template <typename T, std::size_t R, std::size_t C>
+Matrix<T, C, R> Transposed(const Matrix<T, R, C>&);
+
 /// Base template for Matrix
 template <typename T, std::size_t Rows, std::size_t Cols>
 class Matrix
@@ -211,27 +234,20 @@ protected:
 
 		void operator()(Matrix& t) const
 		{
-			for(std::size_t i=0; i!=Rows; ++i)
-			for(std::size_t j=0; j!=Cols; ++j)
-			{
-				t._m._elem[i][j] = a.At(i, 0)* b.At(0, j);
-				for(std::size_t k=1; k!=N; ++k)
-				{
-					t._m._elem[i][j] +=
-						a.At(i, k)*
-						b.At(k, j);
-				}
-			}
+			aux::MatrixMultiplyOp<T, Rows, N, Cols>::Apply(
+				t._m._data,
+				a.Data(),
+				b.Data()
+			);
 		}
 	};
 
 	struct _op_mult_c
 	{
-		void operator()(
-			Matrix& t,
-			const Matrix& a,
-			const T& v
-		)
+		const Matrix& a;
+		T v;
+
+		void operator()(Matrix& t) const
 		{
 			for(std::size_t i=0; i!=Rows; ++i)
 			for(std::size_t j=0; j!=Cols; ++j)
@@ -245,9 +261,10 @@ protected:
 
 		void operator()(Matrix& t) const
 		{
-			for(std::size_t i=0; i!=Rows; ++i)
-			for(std::size_t j=0; j!=Cols; ++j)
-				t._m._elem[i][j] = a._m._elem[j][i];
+			aux::MatrixTransposeOp<T, Rows, Cols>::Apply(
+				t._m._data,
+				a.Data()
+			);
 		}
 	};
 
@@ -308,6 +325,54 @@ protected:
 	Matrix(oglplus::Nothing)
 	{ }
 
+#if !OGLPLUS_NO_CONSTEXPR_MATH
+	typedef typename aux::Matrix_make_index_seq<Rows*Cols>::type _indices;
+
+	// Identity matrix
+	template <std::size_t ... I>
+	constexpr Matrix(aux::Matrix_index_seq<I...>)
+	 : _m{{T(((I / Cols) == (I % Cols))?1:0)...}}
+	{ }
+
+	template <std::size_t ... I>
+	static constexpr Matrix _negated(
+		const Matrix& a,
+		aux::Matrix_index_seq<I...>
+	)
+	{
+		return Matrix(T(-a._m._data[I])...);
+	}
+
+	template <std::size_t ... I>
+	static constexpr Matrix _added(
+		const Matrix& a,
+		const Matrix& b,
+		aux::Matrix_index_seq<I...>
+	)
+	{
+		return Matrix(T(a._m._data[I] + b._m._data[I])...);
+	}
+
+	template <std::size_t ... I>
+	static constexpr Matrix _subtracted(
+		const Matrix& a,
+		const Matrix& b,
+		aux::Matrix_index_seq<I...>
+	)
+	{
+		return Matrix(T(a._m._data[I] - b._m._data[I])...);
+	}
+
+	template <std::size_t ... I>
+	static constexpr Matrix _multiplied(
+		const Matrix& a,
+		T v,
+		aux::Matrix_index_seq<I...>
+	)
+	{
+		return Matrix(T(a._m._data[I] * v)...);
+	}
+#endif
 public:
 	template <typename InitOp>
 	explicit Matrix(_spec_ctr, InitOp& init)
@@ -316,12 +381,18 @@ public:
 	}
 
 	/// Default construction (identity matrix)
+#if !OGLPLUS_NO_CONSTEXPR_MATH
+	constexpr Matrix(void)
+	 : Matrix(_indices())
+	{ }
+#else
 	Matrix(void)
 	{
 		std::fill(_m._data, _m._data+Rows*Cols, T(0));
 		for(std::size_t i=0, n=Rows<Cols?Rows:Cols; i!=n; ++i)
 			this->_m._elem[i][i] = T(1);
 	}
+#endif
 
 	/// Constructuion from raw data
 	Matrix(const T* data, std::size_t n)
@@ -384,13 +455,13 @@ public:
 	}
 
 	/// Returns a pointer to the matrix elements in row major order
-	const T* Data(void) const
+	OGLPLUS_CONSTEXPR_MATH const T* Data(void) const
 	{
 		return this->_m._data;
 	}
 
 	/// Returns the number of elements of the matrix
-	std::size_t Size(void) const
+	OGLPLUS_CONSTEXPR_MATH std::size_t Size(void) const
 	{
 		return Rows * Cols;
 	}
@@ -413,10 +484,10 @@ public:
 	/**
 	 *  @pre (i < Rows) && (j < Cols)
 	 */
-	T At(std::size_t i, std::size_t j) const
+	OGLPLUS_CONSTEXPR_MATH T At(std::size_t i, std::size_t j) const
 	{
-		assert((i < Rows) && (j < Cols));
-		return this->_m._elem[i][j];
+		return assert((i < Rows) && (j < Cols)),
+			this->_m._data[i*Cols+j];
 	}
 
 	/// Sets the value of the element at position i, j
@@ -475,90 +546,120 @@ public:
 	}
 
 	/// Element negation function
-	friend Matrix Negated(const Matrix& a)
+	friend OGLPLUS_CONSTEXPR_MATH Matrix Negated(const Matrix& a)
 	{
+#if !OGLPLUS_NO_CONSTEXPR_MATH
+		return _negated(a, _indices());
+#else
 		_op_negate init = {a};
 		return Matrix(_spec_ctr(), init);
+#endif
 	}
 
 	/// Element negation operator
-	friend Matrix operator - (const Matrix& a)
+	friend OGLPLUS_CONSTEXPR_MATH Matrix operator - (const Matrix& a)
 	{
 		return Negated(a);
 	}
 
 	/// Matrix addition
-	friend Matrix Added(const Matrix& a, const Matrix& b)
+	friend OGLPLUS_CONSTEXPR_MATH Matrix Added(
+		const Matrix& a,
+		const Matrix& b
+	)
 	{
+#if !OGLPLUS_NO_CONSTEXPR_MATH
+		return _added(a, b, _indices());
+#else
 		_op_add init = {a, b};
 		return Matrix(_spec_ctr(), init);
+#endif
 	}
 
 	/// Matrix addition operator
-	friend Matrix operator + (const Matrix& a, const Matrix& b)
+	friend OGLPLUS_CONSTEXPR_MATH Matrix operator + (
+		const Matrix& a,
+		const Matrix& b
+	)
 	{
 		return Added(a, b);
 	}
 
 	/// Matrix subtraction
-	friend Matrix Subtracted(const Matrix& a, const Matrix& b)
+	friend OGLPLUS_CONSTEXPR_MATH Matrix Subtracted(
+		const Matrix& a,
+		const Matrix& b
+	)
 	{
+#if !OGLPLUS_NO_CONSTEXPR_MATH
+		return _subtracted(a, b, _indices());
+#else
 		_op_subtract init = {a, b};
 		return Matrix(_spec_ctr(), init);
+#endif
 	}
 
 	/// Matrix subtraction operator
-	friend Matrix operator - (const Matrix& a, const Matrix& b)
+	friend OGLPLUS_CONSTEXPR_MATH Matrix operator - (
+		const Matrix& a,
+		const Matrix& b
+	)
 	{
 		return Subtracted(a, b);
 	}
 
+#if OGLPLUS_DOCUMENTATION_ONLY
 	/// Matrix multiplication
 	template <std::size_t N>
 	friend Matrix Multiplied(
 		const Matrix<T, Rows, N>& a,
 		const Matrix<T, N, Cols>& b
-	)
-	{
-		_op_multiply<N> init = {a, b};
-		return Matrix(_spec_ctr(), init);
-	}
+	);
 
 	/// Matrix multiplication operator
 	template <std::size_t N>
 	friend Matrix operator * (
 		const Matrix<T, Rows, N>& a,
 		const Matrix<T, N, Cols>& b
-	)
-	{
-		return Multiplied(a, b);
-	}
+	);
+#endif
+
+	template <typename U, std::size_t R, std::size_t N, std::size_t C>
+	friend Matrix<U, R, C> Multiplied(
+		const Matrix<U, R, N>& a,
+		const Matrix<U, N, C>& b
+	);
 
 	/// Multiplication by scalar value
-	friend Matrix Multiplied(const Matrix& a, T m)
+	friend OGLPLUS_CONSTEXPR_MATH Matrix Multiplied(const Matrix& a, T m)
 	{
+#if !OGLPLUS_NO_CONSTEXPR_MATH
+		return _multiplied(a, m, _indices());
+#else
 		_op_mult_c init = {a, m};
 		return Matrix(_spec_ctr(), init);
+#endif
 	}
 
 	/// Multiplication by scalar value operator
-	friend Matrix operator * (const Matrix& a, T m)
+	friend OGLPLUS_CONSTEXPR_MATH Matrix operator * (const Matrix& a, T m)
 	{
 		return Multiplied(a, m);
 	}
 
 	/// Multiplication by scalar value operator
-	friend Matrix operator * (T m, const Matrix& a)
+	friend OGLPLUS_CONSTEXPR_MATH Matrix operator * (T m, const Matrix& a)
 	{
 		return Multiplied(a, m);
 	}
 
+#if OGLPLUS_DOCUMENTATION_ONLY
 	/// Matrix transposition
-	friend Matrix Transposed(const Matrix<T, Cols, Rows>& a)
-	{
-		_op_transpose init = {a};
-		return Matrix(_spec_ctr(), init);
-	}
+	friend Matrix Transposed(const Matrix<T, Cols, Rows>& a);
+#endif
+
+	template <typename U, std::size_t R, std::size_t C>
+	friend Matrix<U, C, R> Transposed(const Matrix<U, R, C>& a);
 
 	/// Submatrix extraction
 	template <std::size_t I, std::size_t J, std::size_t R, std::size_t C>
@@ -672,6 +773,32 @@ public:
 	}
 };
 
+template <typename T, std::size_t R, std::size_t N, std::size_t C>
+inline Matrix<T, R, C> Multiplied(
+	const Matrix<T, R, N>& a,
+	const Matrix<T, N, C>& b
+)
+{
+	typename Matrix<T, R, C>::template _op_multiply<N> init = {a, b};
+	return Matrix<T, R, C>(aux::Matrix_spec_ctr_tag(), init);
+}
+
+template <typename T, std::size_t R, std::size_t N, std::size_t C>
+inline Matrix<T, R, C> operator * (
+	const Matrix<T, R, N>& a,
+	const Matrix<T, N, C>& b
+)
+{
+	return Multiplied(a, b);
+}
+
+template <typename T, std::size_t R, std::size_t C>
+inline Matrix<T, C, R> Transposed(const Matrix<T, R, C>& a)
+{
+	typename Matrix<T, C, R>::_op_transpose init = {a};
+	return Matrix<T, C, R>(aux::Matrix_spec_ctr_tag(), init);
+}
+
 template <
 	std::size_t I,
 	std::size_t J,
@@ -737,31 +864,35 @@ inline void InitMatrix4x4(
 }
 
 template <typename T, std::size_t R, std::size_t C>
-inline const T* Data(const Matrix<T, R, C>& matrix)
+OGLPLUS_CONSTEXPR_MATH const T* Data(const Matrix<T, R, C>& matrix)
 {
 	return matrix.Data();
 }
 
 template <typename T, std::size_t R, std::size_t C>
-inline std::size_t Size(const Matrix<T, R, C>&)
+OGLPLUS_CONSTEXPR_MATH std::size_t Size(const Matrix<T, R, C>&)
 {
 	return R * C;
 }
 
 template <typename T, std::size_t R, std::size_t C>
-inline std::size_t Rows(const Matrix<T, R, C>&)
+OGLPLUS_CONSTEXPR_MATH std::size_t Rows(const Matrix<T, R, C>&)
 {
 	return R;
 }
 
 template <typename T, std::size_t R, std::size_t C>
-inline std::size_t Cols(const Matrix<T, R, C>&)
+OGLPLUS_CONSTEXPR_MATH std::size_t Cols(const Matrix<T, R, C>&)
 {
 	return C;
 }
 
 template <typename T, std::size_t R, std::size_t C>
-inline T At(const Matrix<T, R, C>& matrix, std::size_t i, std::size_t j)
+OGLPLUS_CONSTEXPR_MATH T At(
+	const Matrix<T, R, C>& matrix,
+	std::size_t i,
+	std::size_t j
+)
 {
 	return matrix.At(i, j);
 }
@@ -774,6 +905,196 @@ inline Matrix<T, R, C> Inverse(Matrix<T, R, C> m)
 	return i;
 }
 
+namespace aux {
+
+// Calculates the cofactors of the upper-left 3x3 submatrix of @p m
+// and returns its determinant
+template <typename T, std::size_t R, std::size_t C>
+inline T Cofactors3x3(const Matrix<T, R, C>& m, T (&c)[9])
+{
+	static_assert(R >= 3 && C >= 3, "Matrix must be at least 3x3");
+	const T* a = m.Data();
+	const T
+		a00 = a[0*C+0], a01 = a[0*C+1], a02 = a[0*C+2],
+		a10 = a[1*C+0], a11 = a[1*C+1], a12 = a[1*C+2],
+		a20 = a[2*C+0], a21 = a[2*C+1], a22 = a[2*C+2];
+
+	c[0] = a11*a22 - a12*a21;
+	c[1] = a12*a20 - a10*a22;
+	c[2] = a10*a21 - a11*a20;
+
+	c[3] = a02*a21 - a01*a22;
+	c[4] = a00*a22 - a02*a20;
+	c[5] = a01*a20 - a00*a21;
+
+	c[6] = a01*a12 - a02*a11;
+	c[7] = a02*a10 - a00*a12;
+	c[8] = a00*a11 - a01*a10;
+
+	return a00*c[0] + a01*c[1] + a02*c[2];
+}
+
+template <typename T>
+inline T SafeReciprocal(T det)
+{
+	return (det != T(0))? T(1) / det : T(0);
+}
+
+} // namespace aux
+
+/// Returns the inverse of a 3x3 matrix
+/** This overload uses the closed-form adjugate-based inversion.
+ *  If the matrix is singular then a zero matrix is returned.
+ *
+ *  @ingroup math_utils
+ */
+template <typename T>
+inline Matrix<T, 3, 3> Inverse(const Matrix<T, 3, 3>& m)
+{
+	T c[9];
+	const T id = aux::SafeReciprocal(aux::Cofactors3x3(m, c));
+	return Matrix<T, 3, 3>(
+		c[0]*id, c[3]*id, c[6]*id,
+		c[1]*id, c[4]*id, c[7]*id,
+		c[2]*id, c[5]*id, c[8]*id
+	);
+}
+
+/// Returns the inverse of a 4x4 matrix
+/** This overload uses the closed-form cofactor expansion based on 2x2
+ *  sub-determinants, without pivoting. If the matrix is singular
+ *  then a zero matrix is returned.
+ *
+ *  @see AffineInverse
+ *  @see RigidInverse
+ *
+ *  @ingroup math_utils
+ */
+template <typename T>
+inline Matrix<T, 4, 4> Inverse(const Matrix<T, 4, 4>& m)
+{
+	const T* a = m.Data();
+	const T
+		a00 = a[ 0], a01 = a[ 1], a02 = a[ 2], a03 = a[ 3],
+		a10 = a[ 4], a11 = a[ 5], a12 = a[ 6], a13 = a[ 7],
+		a20 = a[ 8], a21 = a[ 9], a22 = a[10], a23 = a[11],
+		a30 = a[12], a31 = a[13], a32 = a[14], a33 = a[15];
+
+	const T s0 = a00*a11 - a10*a01;
+	const T s1 = a00*a12 - a10*a02;
+	const T s2 = a00*a13 - a10*a03;
+	const T s3 = a01*a12 - a11*a02;
+	const T s4 = a01*a13 - a11*a03;
+	const T s5 = a02*a13 - a12*a03;
+
+	const T c5 = a22*a33 - a32*a23;
+	const T c4 = a21*a33 - a31*a23;
+	const T c3 = a21*a32 - a31*a22;
+	const T c2 = a20*a33 - a30*a23;
+	const T c1 = a20*a32 - a30*a22;
+	const T c0 = a20*a31 - a30*a21;
+
+	const T id = aux::SafeReciprocal(
+		s0*c5 - s1*c4 + s2*c3 + s3*c2 - s4*c1 + s5*c0
+	);
+
+	return Matrix<T, 4, 4>(
+		( a11*c5 - a12*c4 + a13*c3)*id,
+		(-a01*c5 + a02*c4 - a03*c3)*id,
+		( a31*s5 - a32*s4 + a33*s3)*id,
+		(-a21*s5 + a22*s4 - a23*s3)*id,
+
+		(-a10*c5 + a12*c2 - a13*c1)*id,
+		( a00*c5 - a02*c2 + a03*c1)*id,
+		(-a30*s5 + a32*s2 - a33*s1)*id,
+		( a20*s5 - a22*s2 + a23*s1)*id,
+
+		( a10*c4 - a11*c2 + a13*c0)*id,
+		(-a00*c4 + a01*c2 - a03*c0)*id,
+		( a30*s4 - a31*s2 + a33*s0)*id,
+		(-a20*s4 + a21*s2 - a23*s0)*id,
+
+		(-a10*c3 + a11*c1 - a12*c0)*id,
+		( a00*c3 - a01*c1 + a02*c0)*id,
+		(-a30*s3 + a31*s1 - a32*s0)*id,
+		( a20*s3 - a21*s1 + a22*s0)*id
+	);
+}
+
+/// Returns the inverse of an affine 4x4 transformation matrix
+/** The matrix @p m must have (0, 0, 0, 1) as its last row. Only the upper
+ *  left 3x3 submatrix is inverted and the inverse translation is calculated
+ *  from it. If the 3x3 submatrix is singular then the 3x3 part
+ *  of the result is zero.
+ *
+ *  @see RigidInverse
+ *
+ *  @ingroup math_utils
+ */
+template <typename T>
+inline Matrix<T, 4, 4> AffineInverse(const Matrix<T, 4, 4>& m)
+{
+	T c[9];
+	const T id = aux::SafeReciprocal(aux::Cofactors3x3(m, c));
+	const T* a = m.Data();
+	const T tx = a[3], ty = a[7], tz = a[11];
+
+	const T i00 = c[0]*id, i01 = c[3]*id, i02 = c[6]*id;
+	const T i10 = c[1]*id, i11 = c[4]*id, i12 = c[7]*id;
+	const T i20 = c[2]*id, i21 = c[5]*id, i22 = c[8]*id;
+
+	return Matrix<T, 4, 4>(
+		i00, i01, i02, -(i00*tx + i01*ty + i02*tz),
+		i10, i11, i12, -(i10*tx + i11*ty + i12*tz),
+		i20, i21, i22, -(i20*tx + i21*ty + i22*tz),
+		T(0), T(0), T(0), T(1)
+	);
+}
+
+/// Returns the inverse of a rigid-body 4x4 transformation matrix
+/** The matrix @p m must have (0, 0, 0, 1) as its last row and
+ *  an orthonormal (rotation) upper left 3x3 submatrix. The inverse is then
+ *  obtained by transposing the rotation and rotating the negated
+ *  translation.
+ *
+ *  @see AffineInverse
+ *
+ *  @ingroup math_utils
+ */
+template <typename T>
+inline Matrix<T, 4, 4> RigidInverse(const Matrix<T, 4, 4>& m)
+{
+	const T* a = m.Data();
+	const T tx = a[3], ty = a[7], tz = a[11];
+	return Matrix<T, 4, 4>(
+		a[0], a[4], a[ 8], -(a[0]*tx + a[4]*ty + a[ 8]*tz),
+		a[1], a[5], a[ 9], -(a[1]*tx + a[5]*ty + a[ 9]*tz),
+		a[2], a[6], a[10], -(a[2]*tx + a[6]*ty + a[10]*tz),
+		T(0), T(0), T(0), T(1)
+	);
+}
+
+/// Returns the inverse transpose of the upper left 3x3 submatrix of @p m
+/** This function is useful for calculating the normal matrix
+ *  from a model or model-view matrix. The result is the matrix
+ *  of cofactors divided by the determinant, so no explicit inversion
+ *  or transposition is done. If the 3x3 submatrix is singular then
+ *  a zero matrix is returned.
+ *
+ *  @ingroup math_utils
+ */
+template <typename T, std::size_t R, std::size_t C>
+inline Matrix<T, 3, 3> InverseTranspose3x3(const Matrix<T, R, C>& m)
+{
+	T c[9];
+	const T id = aux::SafeReciprocal(aux::Cofactors3x3(m, c));
+	return Matrix<T, 3, 3>(
+		c[0]*id, c[1]*id, c[2]*id,
+		c[3]*id, c[4]*id, c[5]*id,
+		c[6]*id, c[7]*id, c[8]*id
+	);
+}
+
 /// Class implementing model transformation matrix named constructors
 /** The static member functions of this class can be used to construct
  *  various model transformation matrices.
@@ -788,97 +1109,85 @@ private:
 	typedef Matrix<T, 4, 4> Base;
 public:
 	/// Constructs an identity matrix
-	ModelMatrix(void)
+	OGLPLUS_CONSTEXPR_MATH ModelMatrix(void)
 	 : Base()
 	{ }
 
-	ModelMatrix(const Base& base)
+	OGLPLUS_CONSTEXPR_MATH ModelMatrix(const Base& base)
 	 : Base(base)
 	{ }
 
 	struct Translation_ { };
 
-	ModelMatrix(Translation_, T dx, T dy, T dz)
-	 : Base(oglplus::Nothing())
-	{
-		InitMatrix4x4(
-			*this,
-			T(1), T(0), T(0),   dx,
-			T(0), T(1), T(0),   dy,
-			T(0), T(0), T(1),   dz,
-			T(0), T(0), T(0), T(1)
-		);
-	}
+	OGLPLUS_CONSTEXPR_MATH ModelMatrix(Translation_, T dx, T dy, T dz)
+	 : Base(
+		T(1), T(0), T(0),   dx,
+		T(0), T(1), T(0),   dy,
+		T(0), T(0), T(1),   dz,
+		T(0), T(0), T(0), T(1)
+	)
+	{ }
 
 	/// Constructs a translation matrix
-	static inline ModelMatrix Translation(T dx, T dy, T dz)
+	static OGLPLUS_CONSTEXPR_MATH ModelMatrix Translation(T dx, T dy, T dz)
 	{
 		return ModelMatrix(Translation_(), dx, dy, dz);
 	}
 
 	/// Constructs a translation matrix
-	static inline ModelMatrix TranslationX(T dx)
+	static OGLPLUS_CONSTEXPR_MATH ModelMatrix TranslationX(T dx)
 	{
 		return ModelMatrix(Translation_(), dx, T(0), T(0));
 	}
 
 	/// Constructs a translation matrix
-	static inline ModelMatrix TranslationY(T dy)
+	static OGLPLUS_CONSTEXPR_MATH ModelMatrix TranslationY(T dy)
 	{
 		return ModelMatrix(Translation_(), T(0), dy, T(0));
 	}
 
 	/// Constructs a translation matrix
-	static inline ModelMatrix TranslationZ(T dz)
+	static OGLPLUS_CONSTEXPR_MATH ModelMatrix TranslationZ(T dz)
 	{
 		return ModelMatrix(Translation_(), T(0), T(0), dz);
 	}
 
 	/// Constructs a translation matrix
-	static inline ModelMatrix Translation(const Vector<T, 3>& dp)
+	static OGLPLUS_CONSTEXPR_MATH ModelMatrix Translation(const Vector<T, 3>& dp)
 	{
 		return ModelMatrix(Translation_(), dp.x(), dp.y(), dp.z());
 	}
 
 	struct Scale_ { };
 
-	ModelMatrix(Scale_, T sx, T sy, T sz)
-	 : Base(oglplus::Nothing())
-	{
-		InitMatrix4x4(
-			*this,
-			  sx, T(0), T(0), T(0),
-			T(0),   sy, T(0), T(0),
-			T(0), T(0),   sz, T(0),
-			T(0), T(0), T(0), T(1)
-		);
-	}
+	OGLPLUS_CONSTEXPR_MATH ModelMatrix(Scale_, T sx, T sy, T sz)
+	 : Base(
+		  sx, T(0), T(0), T(0),
+		T(0),   sy, T(0), T(0),
+		T(0), T(0),   sz, T(0),
+		T(0), T(0), T(0), T(1)
+	)
+	{ }
 
 	/// Constructs a scale matrix
-	static inline ModelMatrix Scale(T sx, T sy, T sz)
+	static OGLPLUS_CONSTEXPR_MATH ModelMatrix Scale(T sx, T sy, T sz)
 	{
 		return ModelMatrix(Scale_(), sx, sy, sz);
 	}
 
 	struct Reflection_ { };
 
-	ModelMatrix(Reflection_, bool rx, bool ry, bool rz)
-	 : Base(oglplus::Nothing())
-	{
-		const T _rx = rx ?-T(1):T(1);
-		const T _ry = ry ?-T(1):T(1);
-		const T _rz = rz ?-T(1):T(1);
-		InitMatrix4x4(
-			*this,
-			 _rx, T(0), T(0), T(0),
-			T(0),  _ry, T(0), T(0),
-			T(0), T(0),  _rz, T(0),
-			T(0), T(0), T(0), T(1)
-		);
-	}
+	OGLPLUS_CONSTEXPR_MATH ModelMatrix(Reflection_, bool rx, bool ry, bool rz)
+	 : Base(
+		rx?-T(1):T(1), T(0), T(0), T(0),
+		T(0), ry?-T(1):T(1), T(0), T(0),
+		T(0), T(0), rz?-T(1):T(1), T(0),
+		T(0), T(0), T(0), T(1)
+	)
+	{ }
 
 	/// Constructs a reflection matrix
-	static inline ModelMatrix Reflection(bool rx, bool ry, bool rz)
+	static OGLPLUS_CONSTEXPR_MATH ModelMatrix Reflection(bool rx, bool ry, bool rz)
 	{
 		return ModelMatrix(Reflection_(), rx, ry, rz);
 	}
@@ -1044,13 +1353,17 @@ public:
 	CameraMatrix(void){ }
 #endif
 
-	CameraMatrix(const Base& base)
+	OGLPLUS_CONSTEXPR_MATH CameraMatrix(const Base& base)
 	 : Base(base)
 	{ }
 
+	/// Returns the position of the camera
+	/** The camera matrix is expected to be affine (i.e. not to contain
+	 *  the projection).
+	 */
 	Vector<T, 3> Position(void) const
 	{
-		return Vector<T,3>(Inverse(*this).Col(3).Data(), 3);
+		return Vector<T,3>(AffineInverse(*this).Col(3).Data(), 3);
 	}
 
 	Vector<T, 3> Direction(void) const
@@ -1177,7 +1490,7 @@ public:
 
 	struct Ortho_ { };
 
-	CameraMatrix(
+	OGLPLUS_CONSTEXPR_MATH CameraMatrix(
 		Ortho_,
 		T x_left,
 		T x_right,
@@ -1185,30 +1498,31 @@ public:
 		T y_top,
 		T z_near,
 		T z_far
-	): Base(oglplus::Nothing())
-	{
-		T m00 =  T(2) / (x_right - x_left);
-		T m11 =  T(2) / (y_top - y_bottom);
-		T m22 = -T(2) / (z_far - z_near);
-
-		T m30 = -(x_right + x_left) / (x_right - x_left);
-		T m31 = -(y_top + y_bottom) / (y_top - y_bottom);
-		T m32 = -(z_far + z_near)   / (z_far - z_near);
-
-		InitMatrix4x4(
-			*this,
-			 m00, T(0), T(0),  m30,
-			T(0),  m11, T(0),  m31,
-			T(0), T(0),  m22,  m32,
-			T(0), T(0), T(0), T(1)
-		);
-	}
+	): Base(
+		T(2) / (x_right - x_left),
+		T(0),
+		T(0),
+		-(x_right + x_left) / (x_right - x_left),
+
+		T(0),
+		T(2) / (y_top - y_bottom),
+		T(0),
+		-(y_top + y_bottom) / (y_top - y_bottom),
+
+		T(0),
+		T(0),
+		-T(2) / (z_far - z_near),
+		-(z_far + z_near) / (z_far - z_near),
+
+		T(0), T(0), T(0), T(1)
+	)
+	{ }
 
 	/// Constructs an orthographic projection matrix
 	/** Creates a new orthographic matrix from the x-axis @p x_left, @p x_right,
 	 *  y-axis @p y_bottom, @p y_top and z-axis @p z_near and @p z_far values
 	 */
-	static inline CameraMatrix Ortho(
+	static OGLPLUS_CONSTEXPR_MATH CameraMatrix Ortho(
 		T x_left,
 		T x_right,
 		T y_bottom,
@@ -1232,97 +1546,77 @@ public:
 	/** Creates a new orthographic matrix from x-axis @p width,
 	 *  x/y @p aspect ratio and z-axis @p z_near and @p z_far planes
 	 */
-	static inline CameraMatrix OrthoX(
+	static OGLPLUS_CONSTEXPR_MATH CameraMatrix OrthoX(
 		T width,
 		T aspect,
 		T z_near,
 		T z_far
 	)
 	{
-		assert(aspect > T(0));
-		assert(width > T(0));
-
-		T x_right = width / T(2);
-		T x_left = -x_right;
-
-		T y_bottom = x_left / aspect;
-		T y_top = x_right / aspect;
-
-		return CameraMatrix(
-			Ortho_(),
-			x_left,
-			x_right,
-			y_bottom,
-			y_top,
-			z_near,
-			z_far
-		);
+		return assert(aspect > T(0)), assert(width > T(0)),
+			CameraMatrix(
+				Ortho_(),
+				-(width / T(2)),
+				width / T(2),
+				-(width / T(2)) / aspect,
+				width / T(2) / aspect,
+				z_near,
+				z_far
+			);
 	}
 
 	/// Constructs an orthographic projection matrix
 	/** Creates a new orthographic matrix from y-axis @p height,
 	 *  x/y @p aspect ratio and z-axis @p z_near and @p z_far planes
 	 */
-	static inline CameraMatrix OrthoY(
+	static OGLPLUS_CONSTEXPR_MATH CameraMatrix OrthoY(
 		T height,
 		T aspect,
 		T z_near,
 		T z_far
 	)
 	{
-		assert(aspect > T(0));
-		assert(height > T(0));
-
-		T y_top = height / T(2);
-		T y_bottom = -y_top;
-
-		T x_left = y_bottom * aspect;
-		T x_right = y_top * aspect;
-
-		return CameraMatrix(
-			Ortho_(),
-			x_left,
-			x_right,
-			y_bottom,
-			y_top,
-			z_near,
-			z_far
-		);
+		return assert(aspect > T(0)), assert(height > T(0)),
+			CameraMatrix(
+				Ortho_(),
+				-(height / T(2)) * aspect,
+				height / T(2) * aspect,
+				-(height / T(2)),
+				height / T(2),
+				z_near,
+				z_far
+			);
 	}
 
 	struct ScreenStretch_ { };
 
-	CameraMatrix(
+	OGLPLUS_CONSTEXPR_MATH CameraMatrix(
 		ScreenStretch_,
 		T x_left,
 		T x_right,
 		T y_bottom,
 		T y_top
-	): Base(oglplus::Nothing())
-	{
-		assert((x_right - x_left) != T(0));
-		assert((y_top - y_bottom) != T(0));
-
-		T m00 =  T(2) / (x_right - x_left);
-		T m11 =  T(2) / (y_top - y_bottom);
-
-		T m30 = -(x_right + x_left) / (x_right - x_left);
-		T m31 = -(y_top + y_bottom) / (y_top - y_bottom);
-
-		InitMatrix4x4(
-			*this,
-			 m00, T(0), T(0),  m30,
-			T(0),  m11, T(0),  m31,
-			T(0), T(0), T(1), T(0),
-			T(0), T(0), T(0), T(1)
-		);
-	}
+	): Base(
+		(assert((x_right - x_left) != T(0)), T(2) / (x_right - x_left)),
+		T(0),
+		T(0),
+		-(x_right + x_left) / (x_right - x_left),
+
+		T(0),
+		(assert((y_top - y_bottom) != T(0)), T(2) / (y_top - y_bottom)),
+		T(0),
+		-(y_top + y_bottom) / (y_top - y_bottom),
+
+		T(0), T(0), T(1), T(0),
+		T(0), T(0), T(0), T(1)
+	)
+	{ }
 
 	/// Constructs a matrix for stretching NDCs after projection
 	/** ScreenStretch constructs a matrix that can be used to stretch
 	 *  the normalized device coordinates after projection is applied.
 	 */
-	static inline CameraMatrix ScreenStretch(
+	static OGLPLUS_CONSTEXPR_MATH CameraMatrix ScreenStretch(
 		T x_left,
 		T x_right,
 		T y_bottom,
@@ -1345,23 +1639,21 @@ public:
 	 *
 	 *  @pre (x >= 0) && (nx > 0) && (y >= 0) && (ny >= 0)
 	 */
-	static inline CameraMatrix ScreenTile(
+	static OGLPLUS_CONSTEXPR_MATH CameraMatrix ScreenTile(
 		unsigned x,
 		unsigned y,
 		unsigned nx,
 		unsigned ny
 	)
 	{
-		assert(x < nx);
-		assert(y < ny);
-
-		return CameraMatrix(
-			ScreenStretch_(),
-			-T(1)+T(2*(x+0))/T(nx),
-			-T(1)+T(2*(x+1))/T(nx),
-			-T(1)+T(2*(y+0))/T(ny),
-			-T(1)+T(2*(y+1))/T(ny)
-		);
+		return assert(x < nx), assert(y < ny),
+			CameraMatrix(
+				ScreenStretch_(),
+				-T(1)+T(2*(x+0))/T(nx),
+				-T(1)+T(2*(x+1))/T(nx),
+				-T(1)+T(2*(y+0))/T(ny),
+				-T(1)+T(2*(y+1))/T(ny)
+			);
 	}
 
 	struct LookingAt_ { };
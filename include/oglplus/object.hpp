@@ -16,6 +16,7 @@
 #include <oglplus/fwd.hpp>
 #include <oglplus/glfunc.hpp>
 #include <oglplus/enumerations.hpp>
+#include <oglplus/state_cache.hpp>
 #include <oglplus/auxiliary/named.hpp>
 #include <oglplus/auxiliary/strings.hpp>
 #include <type_traits>
@@ -408,8 +409,11 @@ private:
 		assert(ObjectOps::IsMultiObject::value || (_c == 1));
 		try
 		{
+			aux::StateCacheForgetNames(_c, _n);
 			ObjectOps::_cleanup(_c, _n);
+#if !OGLPLUS_DEFERRED_ERROR_CHECKS
 			assert((OGLPLUS_GLFUNC(GetError)()) == GL_NO_ERROR);
+#endif
 		}
 		catch(...){ }
 		*_n = 0;
@@ -19,6 +19,7 @@
 #include <oglplus/object.hpp>
 #include <oglplus/exposed.hpp>
 #include <oglplus/enumerations.hpp>
+#include <oglplus/capability.hpp>
 
 #include <cassert>
 #include <stack>
@@ -396,20 +397,7 @@ public:
 	 */
 	static void Synchronous(bool enable)
 	{
-		if(enable)
-		{
-			OGLPLUS_GLFUNC(Enable)(
-				GL_DEBUG_OUTPUT_SYNCHRONOUS
-			);
-			OGLPLUS_VERIFY(OGLPLUS_ERROR_INFO(Enable));
-		}
-		else
-		{
-			OGLPLUS_GLFUNC(Disable)(
-				GL_DEBUG_OUTPUT_SYNCHRONOUS
-			);
-			OGLPLUS_VERIFY(OGLPLUS_ERROR_INFO(Disable));
-		}
+		aux::SetCapability(GL_DEBUG_OUTPUT_SYNCHRONOUS, enable);
 	}
 
 	/// Inserts a new message into the debug output
@@ -17,12 +17,14 @@
 #include <oglplus/error.hpp>
 #include <oglplus/data_type.hpp>
 #include <oglplus/object.hpp>
+#include <oglplus/state_cache.hpp>
 #include <oglplus/shader.hpp>
 #include <oglplus/transform_feedback.hpp>
 #include <oglplus/friend_of.hpp>
 #include <oglplus/link_error.hpp>
 #include <oglplus/program_interface.hpp>
 #include <oglplus/auxiliary/program.hpp>
+#include <oglplus/auxiliary/program_reflection.hpp>
 #include <oglplus/auxiliary/info_log.hpp>
 #include <oglplus/auxiliary/base_range.hpp>
 #include <oglplus/primitive_type.hpp>
@@ -294,7 +296,11 @@ protected:
 		assert(_count == 1);
 		assert(_name != nullptr);
 		assert(*_name != 0);
-		try{OGLPLUS_GLFUNC(DeleteProgram)(*_name);}
+		try
+		{
+			aux::ProgramReflection::Invalidate(*_name);
+			OGLPLUS_GLFUNC(DeleteProgram)(*_name);
+		}
 		catch(...){ }
 	}
 
@@ -433,20 +439,22 @@ public:
 
 	void HandleLinkError(void) const;
 
-	/// Links this shading language program
-	/**
-	 *  @post IsLinked()
-	 *  @throws Error LinkError
+	/// Starts linking this program without waiting for the result
+	/** Unlike Link, this function does not query the link status,
+	 *  so the driver does not have to finish the linking before
+	 *  it returns. The status should be checked later with IsLinked.
+	 *
+	 *  @see Link
 	 *  @see IsLinked
+	 *  @see CompletionStatus
 	 *
 	 *  @glsymbols
 	 *  @glfunref{LinkProgram}
-	 *  @glfunref{GetProgram}
-	 *  @glfunref{GetProgramInfoLog}
 	 */
-	const ProgramOps& Link(void) const
+	const ProgramOps& LinkAsync(void) const
 	{
 		assert(_name != 0);
+		aux::ProgramReflection::Invalidate(_name);
 		OGLPLUS_GLFUNC(LinkProgram)(_name);
 		OGLPLUS_CHECK(OGLPLUS_OBJECT_ERROR_INFO(
 			LinkProgram,
@@ -454,6 +462,40 @@ public:
 			nullptr,
 			_name
 		));
+		return *this;
+	}
+
+	/// Returns true if the linking of this program has finished
+	/** This query does not block until the linking is finished.
+	 *  It requires the KHR_parallel_shader_compile extension, which
+	 *  should be checked with KHR_parallel_shader_compile::Available.
+	 *
+	 *  @see LinkAsync
+	 *
+	 *  @glsymbols
+	 *  @glextref{KHR,parallel_shader_compile}
+	 *  @glfunref{GetProgram}
+	 *  @gldefref{COMPLETION_STATUS_KHR}
+	 */
+	bool CompletionStatus(void) const
+	{
+		return GetIntParam(GL_COMPLETION_STATUS_KHR) == GL_TRUE;
+	}
+
+	/// Links this shading language program
+	/**
+	 *  @post IsLinked()
+	 *  @throws Error LinkError
+	 *  @see IsLinked
+	 *
+	 *  @glsymbols
+	 *  @glfunref{LinkProgram}
+	 *  @glfunref{GetProgram}
+	 *  @glfunref{GetProgramInfoLog}
+	 */
+	const ProgramOps& Link(void) const
+	{
+		LinkAsync();
 		if(OGLPLUS_IS_ERROR(!IsLinked()))
 		{
 			HandleLinkError();
@@ -526,6 +568,13 @@ public:
 	{
 		assert(_name != 0);
 		assert(IsLinked());
+		aux::StateChange change(
+			aux::StateCacheKey::Program,
+			0,
+			0,
+			GLint(_name)
+		);
+		if(change.Redundant()) return *this;
 		OGLPLUS_GLFUNC(UseProgram)(_name);
 		OGLPLUS_VERIFY(OGLPLUS_OBJECT_ERROR_INFO(
 			UseProgram,
@@ -533,6 +582,7 @@ public:
 			nullptr,
 			_name
 		));
+		change.Done();
 		return *this;
 	}
 
@@ -543,8 +593,16 @@ public:
 	 */
 	static void UseNone(void)
 	{
+		aux::StateChange change(
+			aux::StateCacheKey::Program,
+			0,
+			0,
+			0
+		);
+		if(change.Redundant()) return;
 		OGLPLUS_GLFUNC(UseProgram)(0);
 		OGLPLUS_VERIFY(OGLPLUS_ERROR_INFO(UseProgram));
+		change.Done();
 	}
 
 #if OGLPLUS_DOCUMENTATION_ONLY
@@ -1079,6 +1137,7 @@ public:
 	void Binary(const std::vector<GLubyte>& binary, GLenum format) const
 	{
 		assert(_name != 0);
+		aux::ProgramReflection::Invalidate(_name);
 		OGLPLUS_GLFUNC(ProgramBinary)(
 			_name,
 			format,
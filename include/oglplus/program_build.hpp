@@ -0,0 +1,226 @@
+/**
+ *  @file oglplus/program_build.hpp
+ *  @brief Asynchronous building of multiple programs
+ *
+ *  @author Matus Chochlik
+ *
+ *  Copyright 2010-2013 Matus Chochlik. Distributed under the Boost
+ *  Software License, Version 1.0. (See accompanying file
+ *  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ */
+
+#pragma once
+#ifndef OGLPLUS_PROGRAM_BUILD_1311101500_HPP
+#define OGLPLUS_PROGRAM_BUILD_1311101500_HPP
+
+#include <oglplus/config.hpp>
+#include <oglplus/error.hpp>
+#include <oglplus/shader.hpp>
+#include <oglplus/program.hpp>
+#include <oglplus/program_source.hpp>
+#include <oglplus/ext/KHR_parallel_shader_compile.hpp>
+
+#include <vector>
+#include <cstddef>
+#include <cassert>
+
+namespace oglplus {
+
+class ProgramBuildQueue;
+
+/// A future-like handle of a program built by a ProgramBuildQueue
+/** The handle is valid as long as the queue which returned it exists.
+ *
+ *  @see ProgramBuildQueue
+ */
+class ProgramBuildHandle
+{
+private:
+	ProgramBuildQueue* _queue;
+	std::size_t _index;
+
+	friend class ProgramBuildQueue;
+
+	ProgramBuildHandle(ProgramBuildQueue& queue, std::size_t index)
+	 : _queue(&queue)
+	 , _index(index)
+	{ }
+public:
+	/// Returns true if the build is finished, successfully or not
+	/** If the KHR_parallel_shader_compile extension is used by the queue
+	 *  then this function does not wait for the driver. Otherwise it
+	 *  waits until the program is linked.
+	 */
+	bool Ready(void) const;
+
+	/// Waits until the build is finished
+	/**
+	 *  @throws Error CompileError LinkError
+	 */
+	void Wait(void) const;
+
+	/// Waits until the build is finished and returns the built program
+	/**
+	 *  @throws Error CompileError LinkError
+	 */
+	const ProgramOps& Get(void) const;
+};
+
+/// Builds multiple programs asynchronously
+/** ProgramBuildQueue submits the compilation of all shaders and the linking
+ *  of a program to GL when the program is added, without querying their
+ *  status. Drivers which compile in the background can then process many
+ *  programs in parallel with the application's other work (for example
+ *  with loading of the assets).
+ *
+ *  If the KHR_parallel_shader_compile extension is available, then
+ *  the queue checks whether the builds are finished with the non-blocking
+ *  completion status queries. Otherwise the status queries, which wait
+ *  for the driver, are deferred until the queue is polled or the result
+ *  of a build is requested.
+ *
+ *  The compilation and link errors are reported by the handles returned
+ *  by Add, when the build is waited for, not by the queue.
+ *
+ *  @code
+ *  ProgramBuildQueue queue;
+ *  std::vector<ProgramBuildHandle> builds;
+ *  for(...) builds.push_back(queue.Add(programs[i], sources[i]));
+ *  while(queue.Poll() != 0)
+ *  {
+ *  	LoadNextAsset();
+ *  }
+ *  builds[0].Get().Use();
+ *  @endcode
+ *
+ *  @ingroup utility_classes
+ */
+class ProgramBuildQueue
+{
+private:
+	enum _status
+	{
+		_building,
+		_linked,
+		_compile_failed,
+		_link_failed
+	};
+
+	struct _build
+	{
+		const ProgramOps* program;
+		std::vector<Shader> shaders;
+		_status status;
+		std::size_t failed_shader;
+	};
+
+	std::vector<_build> _builds;
+	std::size_t _unfinished;
+	bool _parallel;
+
+	friend class ProgramBuildHandle;
+
+	static bool _use_parallel(bool allow_parallel);
+
+	// checks the status of a build after the driver finished it
+	void _finish(_build& build);
+
+	// returns true if the build is finished, optionally waiting for it
+	bool _finished(_build& build, bool wait);
+
+	void _wait(std::size_t index);
+
+	const ProgramOps& _program(std::size_t index) const
+	{
+		assert(index < _builds.size());
+		return *_builds[index].program;
+	}
+public:
+	/// Creates an empty queue
+	/** If @p allow_parallel is true and the KHR_parallel_shader_compile
+	 *  extension is available, then the completion of the builds is
+	 *  polled without waiting for the driver.
+	 */
+	ProgramBuildQueue(bool allow_parallel = true)
+	 : _unfinished(0)
+	 , _parallel(_use_parallel(allow_parallel))
+	{ }
+
+#if !OGLPLUS_NO_DELETED_FUNCTIONS
+	ProgramBuildQueue(const ProgramBuildQueue&) = delete;
+	ProgramBuildQueue& operator = (const ProgramBuildQueue&) = delete;
+#else
+private:
+	ProgramBuildQueue(const ProgramBuildQueue&);
+	ProgramBuildQueue& operator = (const ProgramBuildQueue&);
+public:
+#endif
+
+	/// Starts building the @p program from the specified @p source
+	/** The shaders are compiled and attached to the program and the program
+	 *  is linked without waiting for the results. The @p program must not
+	 *  be destroyed until the build is finished.
+	 *
+	 *  @glsymbols
+	 *  @glfunref{CompileShader}
+	 *  @glfunref{AttachShader}
+	 *  @glfunref{LinkProgram}
+	 */
+	ProgramBuildHandle Add(
+		const ProgramOps& program,
+		const ProgramSource& source
+	);
+
+	/// Checks the status of the unfinished builds
+	/** Returns the number of the builds that are not finished yet.
+	 *  Without the KHR_parallel_shader_compile extension, each call
+	 *  waits for the oldest unfinished build.
+	 *  This function does not throw on the compilation or link errors,
+	 *  these are reported by the build handles.
+	 */
+	std::size_t Poll(void);
+
+	/// Waits until all builds are finished
+	/** This function does not throw on the compilation or link errors,
+	 *  these are reported by the build handles.
+	 */
+	void Finish(void);
+
+	/// Returns the number of the builds that are not finished yet
+	std::size_t Unfinished(void) const
+	{
+		return _unfinished;
+	}
+
+	/// Returns true if the completion of the builds is polled in parallel
+	bool Parallel(void) const
+	{
+		return _parallel;
+	}
+};
+
+inline bool ProgramBuildHandle::Ready(void) const
+{
+	assert(_queue);
+	return _queue->_finished(_queue->_builds[_index], !_queue->_parallel);
+}
+
+inline void ProgramBuildHandle::Wait(void) const
+{
+	assert(_queue);
+	_queue->_wait(_index);
+}
+
+inline const ProgramOps& ProgramBuildHandle::Get(void) const
+{
+	Wait();
+	return _queue->_program(_index);
+}
+
+} // namespace oglplus
+
+#if !OGLPLUS_LINK_LIBRARY || defined(OGLPLUS_IMPLEMENTING_LIBRARY)
+#include <oglplus/program_build.ipp>
+#endif // OGLPLUS_LINK_LIBRARY
+
+#endif // include guard
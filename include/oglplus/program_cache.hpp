@@ -0,0 +1,198 @@
+/**
+ *  @file oglplus/program_cache.hpp
+ *  @brief Persistent cache of linked program binaries
+ *
+ *  @author Matus Chochlik
+ *
+ *  Copyright 2010-2013 Matus Chochlik. Distributed under the Boost
+ *  Software License, Version 1.0. (See accompanying file
+ *  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ */
+
+#pragma once
+#ifndef OGLPLUS_PROGRAM_CACHE_1311091040_HPP
+#define OGLPLUS_PROGRAM_CACHE_1311091040_HPP
+
+#include <oglplus/config.hpp>
+#include <oglplus/error.hpp>
+#include <oglplus/string.hpp>
+#include <oglplus/shader.hpp>
+#include <oglplus/program.hpp>
+#include <oglplus/program_source.hpp>
+
+#include <vector>
+#include <cstddef>
+
+namespace oglplus {
+
+#if OGLPLUS_DOCUMENTATION_ONLY || GL_VERSION_4_1 || GL_ARB_get_program_binary
+
+namespace aux {
+
+// 64-bit FNV-1a hash of the inputs from which a program is built
+class ProgramCacheHash
+{
+private:
+	unsigned long long _value;
+public:
+	ProgramCacheHash(void)
+	 : _value(14695981039346656037ULL)
+	{ }
+
+	void Add(const void* data, std::size_t size)
+	{
+		const GLubyte* bytes = static_cast<const GLubyte*>(data);
+		for(std::size_t i=0; i!=size; ++i)
+		{
+			_value ^= bytes[i];
+			_value *= 1099511628211ULL;
+		}
+	}
+
+	void Add(GLuint value)
+	{
+		Add(&value, sizeof(value));
+	}
+
+	// the strings are prefixed by their length to keep the inputs apart
+	void Add(const String& str)
+	{
+		Add(GLuint(str.size()));
+		Add(str.data(), str.size());
+	}
+
+	unsigned long long Value(void) const
+	{
+		return _value;
+	}
+};
+
+} // namespace aux
+
+/// Persistent on-disk cache of linked program binaries
+/** ProgramCache builds programs from a ProgramSource. The binary of each
+ *  newly linked program is stored in a file in the cache directory.
+ *  Later builds with the same inputs load the binary with ProgramBinary
+ *  instead of compiling and linking the shaders again.
+ *
+ *  The cache files are keyed by a hash of the shader types and sources,
+ *  the attribute locations, the transform feedback varyings, the
+ *  separability and the GL vendor, renderer and version strings, so
+ *  a driver update does not reuse the old binaries. If the driver
+ *  rejects a cached binary anyway, then the program is rebuilt from
+ *  the sources and the cache file is replaced.
+ *
+ *  The cache directory must exist. Failures to read or write the cache
+ *  files are not reported, the program is just built from the sources.
+ *
+ *  @code
+ *  ProgramCache cache("/path/to/cache");
+ *  ProgramSource source;
+ *  source.AddShader(ShaderType::Vertex, vs_source);
+ *  source.AddShader(ShaderType::Fragment, fs_source);
+ *  Program prog;
+ *  cache.Build(prog, source);
+ *  prog.Use();
+ *  @endcode
+ *
+ *  @glvoereq{4,1,ARB,get_program_binary}
+ *
+ *  @ingroup utility_classes
+ */
+class ProgramCache
+ : public FriendOf<ProgramOps>
+{
+private:
+	String _directory;
+	String _driver;
+	bool _driver_initialized;
+	bool _binaries_supported;
+	std::size_t _hits, _misses, _rejected;
+
+	void _init_driver(void);
+
+	unsigned long long _key(const ProgramSource& source) const;
+
+	String _path(unsigned long long key) const;
+
+	static bool _read(
+		const String& path,
+		unsigned long long key,
+		std::vector<GLubyte>& binary,
+		GLenum& format
+	);
+
+	static void _write(
+		const String& path,
+		unsigned long long key,
+		const std::vector<GLubyte>& binary,
+		GLenum format
+	);
+
+	bool _load(
+		const ProgramOps& program,
+		const ProgramSource& source,
+		const String& path,
+		unsigned long long key
+	);
+
+	static void _build(const ProgramOps& program, const ProgramSource& src);
+public:
+	/// Creates a cache storing the program binaries in the @p directory
+	ProgramCache(String directory)
+	 : _directory(std::move(directory))
+	 , _driver_initialized(false)
+	 , _binaries_supported(false)
+	 , _hits(0)
+	 , _misses(0)
+	 , _rejected(0)
+	{ }
+
+	/// Builds the @p program from the @p source, using the cached binary
+	/** Returns true if the program was loaded from a cached binary
+	 *  and false if it was compiled and linked from the sources.
+	 *
+	 *  @throws Error CompileError LinkError
+	 *
+	 *  @post program.IsLinked()
+	 *
+	 *  @glsymbols
+	 *  @glfunref{ProgramBinary}
+	 *  @glfunref{GetProgramBinary}
+	 */
+	bool Build(const ProgramOps& program, const ProgramSource& source);
+
+	/// Removes the cached binary of the program built from @p source
+	void Forget(const ProgramSource& source);
+
+	/// Returns the path of the cache file for the specified @p source
+	String Path(const ProgramSource& source);
+
+	/// Returns the number of programs loaded from cached binaries
+	std::size_t Hits(void) const
+	{
+		return _hits;
+	}
+
+	/// Returns the number of programs built from the sources
+	std::size_t Misses(void) const
+	{
+		return _misses;
+	}
+
+	/// Returns the number of cached binaries rejected by the driver
+	std::size_t Rejected(void) const
+	{
+		return _rejected;
+	}
+};
+
+#endif // get program binary
+
+} // namespace oglplus
+
+#if !OGLPLUS_LINK_LIBRARY || defined(OGLPLUS_IMPLEMENTING_LIBRARY)
+#include <oglplus/program_cache.ipp>
+#endif // OGLPLUS_LINK_LIBRARY
+
+#endif // include guard
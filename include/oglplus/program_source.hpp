@@ -0,0 +1,128 @@
+/**
+ *  @file oglplus/program_source.hpp
+ *  @brief Description of the inputs from which a program is built
+ *
+ *  @author Matus Chochlik
+ *
+ *  Copyright 2010-2013 Matus Chochlik. Distributed under the Boost
+ *  Software License, Version 1.0. (See accompanying file
+ *  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ */
+
+#pragma once
+#ifndef OGLPLUS_PROGRAM_SOURCE_1311101120_HPP
+#define OGLPLUS_PROGRAM_SOURCE_1311101120_HPP
+
+#include <oglplus/config.hpp>
+#include <oglplus/string.hpp>
+#include <oglplus/friend_of.hpp>
+#include <oglplus/glsl_source.hpp>
+#include <oglplus/shader.hpp>
+#include <oglplus/program.hpp>
+#include <oglplus/transform_feedback.hpp>
+
+#include <vector>
+#include <utility>
+
+namespace oglplus {
+
+class ProgramCache;
+class ProgramBuildQueue;
+
+/// Description of the inputs from which a Program is built
+/** ProgramSource stores the sources and the types of the shaders and
+ *  the parameters set before linking (the vertex attribute locations,
+ *  the transform feedback varyings and the separability) that
+ *  together determine the resulting program.
+ *
+ *  @see ProgramCache
+ *  @see ProgramBuildQueue
+ */
+class ProgramSource
+ : public FriendOf<ProgramOps>
+{
+private:
+	struct _shader
+	{
+		ShaderType type;
+		String source;
+	};
+	std::vector<_shader> _shaders;
+	std::vector<std::pair<GLuint, String> > _attrib_locations;
+	std::vector<String> _varyings;
+	TransformFeedbackMode _varyings_mode;
+	bool _separable;
+
+	friend class ProgramCache;
+	friend class ProgramBuildQueue;
+
+	// sets the parameters of the program which must precede linking
+	void _prepare_link(const ProgramOps& program) const;
+public:
+	/// Creates an empty program source without any shaders
+	ProgramSource(void)
+	 : _varyings_mode(TransformFeedbackMode::InterleavedAttribs)
+	 , _separable(false)
+	{ }
+
+	/// Adds a shader with the specified @p type and @p source
+	ProgramSource& AddShader(ShaderType type, String source)
+	{
+		_shader shader = { type, std::move(source) };
+		_shaders.push_back(std::move(shader));
+		return *this;
+	}
+
+	/// Adds a shader with the specified @p type and @p source
+	ProgramSource& AddShader(ShaderType type, const GLSLSource& source);
+
+	/// Binds the vertex attribute @p identifier to the @p location
+	/**
+	 *  @glsymbols
+	 *  @glfunref{BindAttribLocation}
+	 */
+	ProgramSource& BindAttribLocation(GLuint location, String identifier)
+	{
+		_attrib_locations.push_back(
+			std::make_pair(location, std::move(identifier))
+		);
+		return *this;
+	}
+
+	/// Sets the varyings captured by transform feedback
+	/**
+	 *  @glsymbols
+	 *  @glfunref{TransformFeedbackVaryings}
+	 */
+	ProgramSource& TransformFeedbackVaryings(
+		std::vector<String> varyings,
+		TransformFeedbackMode mode
+	)
+	{
+		_varyings = std::move(varyings);
+		_varyings_mode = mode;
+		return *this;
+	}
+
+#if OGLPLUS_DOCUMENTATION_ONLY || GL_VERSION_4_1 || GL_ARB_separate_shader_objects
+	/// Makes the built program separable
+	/**
+	 *  @glvoereq{4,1,ARB,separate_shader_objects}
+	 *  @glsymbols
+	 *  @glfunref{ProgramParameter}
+	 */
+	ProgramSource& MakeSeparable(bool separable = true)
+	{
+		_separable = separable;
+		return *this;
+	}
+#endif
+};
+
+} // namespace oglplus
+
+#if !OGLPLUS_LINK_LIBRARY || defined(OGLPLUS_IMPLEMENTING_LIBRARY)
+#include <oglplus/program_source.ipp>
+#endif // OGLPLUS_LINK_LIBRARY
+
+#endif // include guard
@@ -123,7 +123,7 @@ protected:
 			GetRenderbufferParameteriv,
 			Renderbuffer,
 			EnumValueName(target),
-			BindingQuery<RenderbufferOps>::QueryBinding(target)
+			BindingQuery<RenderbufferOps>::ErrorInfoName(target)
 		));
 		return result;
 	}
@@ -172,7 +172,7 @@ public:
 			RenderbufferStorage,
 			Renderbuffer,
 			EnumValueName(target),
-			BindingQuery<RenderbufferOps>::QueryBinding(target)
+			BindingQuery<RenderbufferOps>::ErrorInfoName(target)
 		));
 	}
 
@@ -200,7 +200,7 @@ public:
 			RenderbufferStorageMultisample,
 			Renderbuffer,
 			EnumValueName(target),
-			BindingQuery<RenderbufferOps>::QueryBinding(target)
+			BindingQuery<RenderbufferOps>::ErrorInfoName(target)
 		));
 	}
 
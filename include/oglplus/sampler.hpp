@@ -17,6 +17,7 @@
 #include <oglplus/glfunc.hpp>
 #include <oglplus/error.hpp>
 #include <oglplus/object.hpp>
+#include <oglplus/state_cache.hpp>
 #include <oglplus/friend_of.hpp>
 #include <oglplus/texture.hpp>
 #include <cassert>
@@ -78,6 +79,13 @@ protected:
 
 	static void _bind(GLuint _name, TextureUnitSelector unit)
 	{
+		aux::StateChange change(
+			aux::StateCacheKey::Sampler,
+			0,
+			GLuint(unit),
+			GLint(_name)
+		);
+		if(change.Redundant()) return;
 		assert(_name != 0);
 		OGLPLUS_GLFUNC(BindSampler)(GLuint(unit), _name);
 		OGLPLUS_VERIFY(OGLPLUS_OBJECT_ERROR_INFO(
@@ -86,6 +94,7 @@ protected:
 			nullptr,
 			_name
 		));
+		change.Done();
 	}
 
 	friend class FriendOf<SamplerOps>;
@@ -107,8 +116,16 @@ public:
 	 */
 	static void Unbind(TextureUnitSelector unit)
 	{
+		aux::StateChange change(
+			aux::StateCacheKey::Sampler,
+			0,
+			GLuint(unit),
+			0
+		);
+		if(change.Redundant()) return;
 		OGLPLUS_GLFUNC(BindSampler)(GLuint(unit), 0);
 		OGLPLUS_VERIFY(OGLPLUS_ERROR_INFO(BindSampler));
+		change.Done();
 	}
 
 #if OGLPLUS_DOCUMENTATION_ONLY || GL_VERSION_4_4 || GL_ARB_multi_bind
@@ -130,6 +147,15 @@ public:
 			names
 		);
 		OGLPLUS_VERIFY(OGLPLUS_ERROR_INFO(BindSamplers));
+		for(GLsizei i=0; i!=count; ++i)
+		{
+			aux::StateChange(
+				aux::StateCacheKey::Sampler,
+				0,
+				first+GLuint(i),
+				names?GLint(names[i]):0
+			).Done();
+		}
 	}
 #endif
 
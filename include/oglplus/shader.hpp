@@ -289,16 +289,19 @@ public:
 
 	void HandleCompileError(void) const;
 
-	/// Compiles the shader
-	/**
-	 *  @post IsCompiled()
-	 *  @throws Error CompileError
+	/// Starts compiling the shader without waiting for the result
+	/** Unlike Compile, this function does not query the compile status,
+	 *  so the driver does not have to finish the compilation before
+	 *  it returns. The status should be checked later with IsCompiled.
+	 *
+	 *  @see Compile
 	 *  @see IsCompiled
+	 *  @see CompletionStatus
 	 *
 	 *  @glsymbols
 	 *  @glfunref{CompileShader}
 	 */
-	const ShaderOps& Compile(void) const
+	const ShaderOps& CompileAsync(void) const
 	{
 		assert(_name != 0);
 		OGLPLUS_GLFUNC(CompileShader)(_name);
@@ -308,6 +311,50 @@ public:
 			EnumValueName(Type()),
 			_name
 		));
+		return *this;
+	}
+
+	/// Returns true if the compilation of this shader has finished
+	/** This query does not block until the compilation is finished.
+	 *  It requires the KHR_parallel_shader_compile extension, which
+	 *  should be checked with KHR_parallel_shader_compile::Available.
+	 *
+	 *  @see CompileAsync
+	 *
+	 *  @glsymbols
+	 *  @glextref{KHR,parallel_shader_compile}
+	 *  @glfunref{GetShader}
+	 *  @gldefref{COMPLETION_STATUS_KHR}
+	 */
+	bool CompletionStatus(void) const
+	{
+		GLint status = GL_FALSE;
+		OGLPLUS_GLFUNC(GetShaderiv)(
+			_name,
+			GL_COMPLETION_STATUS_KHR,
+			&status
+		);
+		OGLPLUS_VERIFY(OGLPLUS_OBJECT_ERROR_INFO(
+			GetShaderiv,
+			Shader,
+			nullptr,
+			_name
+		));
+		return status == GL_TRUE;
+	}
+
+	/// Compiles the shader
+	/**
+	 *  @post IsCompiled()
+	 *  @throws Error CompileError
+	 *  @see IsCompiled
+	 *
+	 *  @glsymbols
+	 *  @glfunref{CompileShader}
+	 */
+	const ShaderOps& Compile(void) const
+	{
+		CompileAsync();
 		if(OGLPLUS_IS_ERROR(!IsCompiled()))
 		{
 			HandleCompileError();
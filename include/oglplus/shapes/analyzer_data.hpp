@@ -17,6 +17,7 @@
 #include <oglplus/shapes/draw.hpp>
 
 #include <vector>
+#include <cassert>
 
 namespace oglplus {
 namespace shapes {
@@ -39,7 +40,7 @@ private:
 	}
 
 	GLuint _guess_face_count(void);
-	GLuint _guess_vertex_count(GLuint);
+	GLuint _guess_vertex_count(void);
 
 	void _initialize(void);
 
@@ -55,18 +56,21 @@ private:
 	void _init_dr_el_triangle_strip(const DrawOperation& draw_op);
 	void _init_dr_el_triangle_fan(const DrawOperation& draw_op);
 
+	void _weld_vertices(std::vector<GLuint>& weld) const;
 	void _detect_adjacent(void);
+	void _connect_edges(
+		GLuint fi,
+		GLuint ei,
+		GLuint fj,
+		GLuint ej,
+		const std::vector<GLuint>& weld
+	);
 	bool _same_va_values(
-		GLuint fa,
-		GLuint ea,
-		GLuint fb,
-		GLuint eb,
+		GLuint va,
+		GLuint vb,
 		GLuint attr_vpv,
 		const std::vector<GLdouble>& vert_attr
-	);
-	bool _adjacent_faces(GLuint fa, GLuint ea, GLuint fb, GLuint eb);
-	bool _smooth_faces(GLuint fa, GLuint ea, GLuint fb, GLuint eb);
-	bool _contin_faces(GLuint fa, GLuint ea, GLuint fb, GLuint eb);
+	) const;
 public:
 	DrawingInstructions _instr;
 	std::vector<GLuint> _index;
@@ -75,6 +79,8 @@ public:
 	std::vector<GLdouble> _main_va;
 	// number of values per vertex for the main attribute
 	GLuint _main_vpv;
+	// the first vertex with the same main attribute value as each vertex
+	std::vector<GLuint> _main_weld;
 
 	// vertex attribute used to detect smoothing (usually normal)
 	std::vector<GLdouble> _smooth_va;
@@ -109,10 +115,13 @@ public:
 		_flg_contin_edge|
 		0x0008;
 
-	static GLuint _face_arity(GLuint /*face*/)
+	GLuint _face_arity(GLuint face) const
 	{
-		// TODO Arity or triangles only?
-		return 3;
+		assert(face < _face_index.size());
+		const GLuint end = (face+1 < _face_index.size())?
+			_face_index[face+1]:
+			GLuint(_face_verts.size());
+		return end - _face_index[face];
 	}
 
 	typedef oglplus::ShapeDrawOperationMethod Method;
@@ -0,0 +1,418 @@
+/**
+ *  @file oglplus/shapes/batch.hpp
+ *  @brief Batching of the drawing instructions of many shapes
+ *
+ *  @author Matus Chochlik
+ *
+ *  Copyright 2010-2013 Matus Chochlik. Distributed under the Boost
+ *  Software License, Version 1.0. (See accompanying file
+ *  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ */
+
+#pragma once
+#ifndef OGLPLUS_SHAPES_BATCH_1310271205_HPP
+#define OGLPLUS_SHAPES_BATCH_1310271205_HPP
+
+#include <oglplus/config.hpp>
+#include <oglplus/vertex_array.hpp>
+#include <oglplus/vertex_attrib.hpp>
+#include <oglplus/buffer.hpp>
+#include <oglplus/array.hpp>
+#include <oglplus/program.hpp>
+#include <oglplus/context.hpp>
+#include <oglplus/optional.hpp>
+#include <oglplus/error.hpp>
+#include <oglplus/string.hpp>
+#include <oglplus/indirect_command.hpp>
+
+#include <oglplus/shapes/draw.hpp>
+#include <oglplus/shapes/vert_attr_info.hpp>
+
+#include <vector>
+#include <iterator>
+#include <cassert>
+
+namespace oglplus {
+namespace shapes {
+
+/// A range of the batched draw commands using the same primitive type
+/**
+ *  @see ShapeBatchBuilder::SortedCommands
+ */
+struct ShapeBatchGroup
+{
+	/// The primitive type used by all commands in the group
+	PrimitiveType mode;
+
+	/// The position of the first command of the group
+	GLuint first;
+
+	/// The number of commands in the group
+	GLuint count;
+
+	/// Indicates that some commands draw other than a single instance
+	bool instanced;
+};
+
+/// Merges the vertex attributes and instructions of many shapes
+/** The builder concatenates the values of the vertex attributes with
+ *  the specified names and the indices of the added shapes into single
+ *  arrays. Each operation of the DrawingInstructions of the added shapes
+ *  is converted into a DrawElementsIndirectCommand, with the base vertex
+ *  being the position of the first vertex of the shape in the merged
+ *  vertex arrays. The DrawArrays operations are converted into ranges
+ *  of sequential indices. The primitive restart indices of the shapes
+ *  are replaced with RestartIndex().
+ *
+ *  The attributes not provided by some of the shapes are filled with
+ *  zeros. The shapes providing the same attribute must use the same
+ *  number of values per vertex. The phases of the operations are not
+ *  preserved.
+ *
+ *  The builder does not use the GL and the merged data can be uploaded
+ *  into buffers either directly or by the ShapeBatch class.
+ *
+ *  @see ShapeBatch
+ */
+class ShapeBatchBuilder
+ : public DrawingInstructionWriter
+{
+private:
+	std::vector<String> _names;
+	std::vector<GLuint> _npvs;
+	std::vector<std::vector<GLfloat> > _values;
+	std::vector<GLuint> _indices;
+	std::vector<DrawElementsIndirectCommand> _commands;
+	std::vector<PrimitiveType> _modes;
+	// the positions of the first commands of the individual shapes
+	std::vector<GLuint> _shape_commands;
+	GLuint _vertex_count;
+	bool _restart;
+
+	template <typename Iterator>
+	void _init(Iterator name, Iterator end)
+	{
+		while(name != end)
+		{
+			_names.push_back(String(*name));
+			++name;
+		}
+		_npvs.resize(_names.size(), 0);
+		_values.resize(_names.size());
+		_shape_commands.push_back(0);
+	}
+
+	GLuint _add_shape(
+		const std::vector<std::vector<GLfloat> >& values,
+		const std::vector<GLuint>& npvs,
+		const std::vector<GLuint>& indices,
+		const DrawingInstructions& instructions,
+		GLuint inst_count,
+		GLuint base_inst
+	);
+public:
+	/// Prepares a batch of shapes with the specified vertex attributes
+	template <typename Iterator>
+	ShapeBatchBuilder(Iterator names_begin, Iterator names_end)
+	 : _vertex_count(0)
+	 , _restart(false)
+	{
+		_init(names_begin, names_end);
+	}
+
+	/// Prepares a batch of shapes with the specified vertex attributes
+	template <typename StdRange>
+	ShapeBatchBuilder(const StdRange& names)
+	 : _vertex_count(0)
+	 , _restart(false)
+	{
+		_init(names.begin(), names.end());
+	}
+
+#if !OGLPLUS_NO_INITIALIZER_LISTS
+	/// Prepares a batch of shapes with the specified vertex attributes
+	ShapeBatchBuilder(const std::initializer_list<const GLchar*>& names)
+	 : _vertex_count(0)
+	 , _restart(false)
+	{
+		_init(names.begin(), names.end());
+	}
+#endif
+
+	/// Adds a shape made by the @p builder to the batch
+	/** The shape is drawn @p inst_count times, starting at the
+	 *  instance @p base_inst (which can be used to fetch per-shape
+	 *  data from instanced vertex attributes). Returns the index
+	 *  of the shape in the batch.
+	 */
+	template <class ShapeBuilder>
+	GLuint Add(
+		const ShapeBuilder& builder,
+		GLuint inst_count = 1,
+		GLuint base_inst = 0
+	)
+	{
+		typename ShapeBuilder::VertexAttribs vert_attr_info;
+		std::vector<std::vector<GLfloat> > values(_names.size());
+		std::vector<GLuint> npvs(_names.size(), 0);
+		for(std::size_t i=0, n=_names.size(); i!=n; ++i)
+		{
+			auto getter = vert_attr_info.VertexAttribGetter(
+				values[i],
+				_names[i]
+			);
+			if(getter != nullptr)
+				npvs[i] = getter(builder, values[i]);
+		}
+		const typename ShapeBuilder::IndexArray shape_indices =
+			builder.Indices();
+		const std::vector<GLuint> indices(
+			shape_indices.begin(),
+			shape_indices.end()
+		);
+		return _add_shape(
+			values,
+			npvs,
+			indices,
+			builder.Instructions(),
+			inst_count,
+			base_inst
+		);
+	}
+
+	/// The index replacing the primitive restart indices of the shapes
+	static GLuint RestartIndex(void)
+	{
+		return ~GLuint(0);
+	}
+
+	/// Returns true if some of the commands use primitive restart
+	bool PrimitiveRestart(void) const
+	{
+		return _restart;
+	}
+
+	/// Returns the number of vertex attributes
+	std::size_t AttribCount(void) const
+	{
+		return _names.size();
+	}
+
+	/// Returns the name of the @p attrib-th vertex attribute
+	const String& AttribName(std::size_t attrib) const
+	{
+		assert(attrib < _names.size());
+		return _names[attrib];
+	}
+
+	/// Returns the number of values per vertex of the @p attrib-th attribute
+	/** Zero is returned if none of the shapes provides the attribute.
+	 */
+	GLuint ValuesPerVertex(std::size_t attrib) const
+	{
+		assert(attrib < _npvs.size());
+		return _npvs[attrib];
+	}
+
+	/// Returns the merged values of the @p attrib-th vertex attribute
+	const std::vector<GLfloat>& Values(std::size_t attrib) const
+	{
+		assert(attrib < _values.size());
+		return _values[attrib];
+	}
+
+	/// Returns the number of vertices of all shapes
+	GLuint VertexCount(void) const
+	{
+		return _vertex_count;
+	}
+
+	/// Returns the merged indices of all shapes
+	const std::vector<GLuint>& Indices(void) const
+	{
+		return _indices;
+	}
+
+	/// Returns the number of shapes in the batch
+	std::size_t ShapeCount(void) const
+	{
+		return _shape_commands.size()-1;
+	}
+
+	/// Returns the position of the first command of the @p shape
+	/** The commands of the shape end where the commands of the next
+	 *  shape start, so @c FirstCommand(ShapeCount()) returns the number
+	 *  of all commands.
+	 */
+	GLuint FirstCommand(std::size_t shape) const
+	{
+		assert(shape < _shape_commands.size());
+		return _shape_commands[shape];
+	}
+
+	/// Returns the draw commands in the order of the added operations
+	const std::vector<DrawElementsIndirectCommand>& Commands(void) const
+	{
+		return _commands;
+	}
+
+	/// Returns the primitive types of the individual commands
+	const std::vector<PrimitiveType>& Modes(void) const
+	{
+		return _modes;
+	}
+
+	/// Returns the instructions drawing the commands one by one
+	/** Each command is drawn by a DrawElementsBaseVertex operation
+	 *  with the phase being the index of the shape, so that a drawing
+	 *  driver can change the program parameters for each shape.
+	 *  The instance counts and base instances of the commands are
+	 *  not preserved, these are specified when drawing.
+	 */
+	DrawingInstructions Instructions(void) const;
+
+	/// Sorts the commands by primitive type and returns the groups
+	/** The commands are stored into @p sorted, keeping the order
+	 *  of the commands with the same primitive type. Each of the
+	 *  returned groups can be submitted with a single multi-draw call.
+	 */
+	std::vector<ShapeBatchGroup> SortedCommands(
+		std::vector<DrawElementsIndirectCommand>& sorted
+	) const;
+};
+
+/// Stores a batch of shapes in buffers and draws it with few draw calls
+/** The ShapeBatch uploads the data merged by a ShapeBatchBuilder into
+ *  one buffer per vertex attribute, a single element buffer and (if
+ *  available) a draw indirect buffer with the draw commands. Draw
+ *  issues a single MultiDrawElementsIndirect call for each primitive
+ *  type used by the shapes. If indirect drawing is not available (or
+ *  disabled in the constructor) the commands are submitted with
+ *  MultiDrawElementsBaseVertex, which is the variant of MultiDrawElements
+ *  honoring the base vertices of the individual shapes.
+ *
+ *  @code
+ *  shapes::ShapeBatchBuilder builder({"Position", "Normal"});
+ *  builder.Add(shapes::Cube());
+ *  builder.Add(shapes::Sphere(), 10, 1);
+ *  shapes::ShapeBatch batch(builder, prog);
+ *  batch.Use();
+ *  batch.Draw();
+ *  @endcode
+ *
+ *  @see ShapeBatchBuilder
+ */
+class ShapeBatch
+{
+private:
+	Context _gl;
+
+	// A vertex array object for the rendered batch
+	Optional<VertexArray> _vao;
+
+	// VBOs for the vertex attributes, the element buffer
+	// and the draw indirect buffer
+	Array<Buffer> _vbos;
+
+	std::vector<String> _names;
+	std::vector<GLuint> _npvs;
+
+	std::vector<DrawElementsIndirectCommand> _commands;
+	std::vector<ShapeBatchGroup> _groups;
+
+	// the parameters for MultiDrawElementsBaseVertex
+	std::vector<GLsizei> _counts;
+	std::vector<GLuint*> _offsets;
+	std::vector<GLint> _base_vertices;
+
+	bool _restart;
+	bool _indirect;
+
+	void _init(const ShapeBatchBuilder& builder);
+
+	void _draw_indirect(const ShapeBatchGroup& group) const;
+	void _draw_multi(const ShapeBatchGroup& group) const;
+public:
+	/// Uploads the data from the @p builder into buffers
+	/** If @p indirect is false or the GL does not support
+	 *  MultiDrawElementsIndirect, the batch is drawn by
+	 *  MultiDrawElementsBaseVertex.
+	 */
+	ShapeBatch(const ShapeBatchBuilder& builder, bool indirect = true)
+	 : _vbos(GLsizei(builder.AttribCount()+2))
+	 , _indirect(indirect)
+	{
+		_init(builder);
+	}
+
+	/// Uploads the data from the @p builder and sets up a VAO for @p prog
+	ShapeBatch(
+		const ShapeBatchBuilder& builder,
+		const ProgramOps& prog,
+		bool indirect = true
+	): _vbos(GLsizei(builder.AttribCount()+2))
+	 , _indirect(indirect)
+	{
+		_init(builder);
+		UseInProgram(prog);
+	}
+
+	ShapeBatch(ShapeBatch&& temp)
+	 : _gl(std::move(temp._gl))
+	 , _vao(std::move(temp._vao))
+	 , _vbos(std::move(temp._vbos))
+	 , _names(std::move(temp._names))
+	 , _npvs(std::move(temp._npvs))
+	 , _commands(std::move(temp._commands))
+	 , _groups(std::move(temp._groups))
+	 , _counts(std::move(temp._counts))
+	 , _offsets(std::move(temp._offsets))
+	 , _base_vertices(std::move(temp._base_vertices))
+	 , _restart(temp._restart)
+	 , _indirect(temp._indirect)
+	{ }
+
+#if !OGLPLUS_NO_DELETED_FUNCTIONS
+	ShapeBatch(const ShapeBatch&) = delete;
+#else
+private:
+	ShapeBatch(const ShapeBatch&);
+public:
+#endif
+
+	/// Makes a VAO with the batch's attributes enabled for @p prog
+	VertexArray VAOForProgram(const ProgramOps& prog) const;
+
+	/// Makes the VAO for @p prog the one bound by Use
+	void UseInProgram(const ProgramOps& prog)
+	{
+		_vao.Assign(VAOForProgram(prog));
+	}
+
+	/// Binds the VAO of the batch
+	void Use(void)
+	{
+		_vao.Bind();
+	}
+
+	/// Returns true if the batch is drawn by MultiDrawElementsIndirect
+	bool Indirect(void) const
+	{
+		return _indirect;
+	}
+
+	/// Returns the number of draw calls issued by Draw
+	std::size_t DrawCallCount(void) const;
+
+	/// Draws all shapes of the batch
+	void Draw(void) const;
+};
+
+} // shapes
+} // oglplus
+
+#if !OGLPLUS_LINK_LIBRARY || defined(OGLPLUS_IMPLEMENTING_LIBRARY)
+#include <oglplus/shapes/batch.ipp>
+#endif // OGLPLUS_LINK_LIBRARY
+
+#endif // include guard
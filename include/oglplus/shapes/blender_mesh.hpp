@@ -16,6 +16,7 @@
 #include <oglplus/vector.hpp>
 #include <oglplus/matrix.hpp>
 #include <oglplus/sphere.hpp>
+#include <oglplus/bulk_transform.hpp>
 #include <oglplus/face_mode.hpp>
 
 #include <oglplus/shapes/draw.hpp>
@@ -0,0 +1,447 @@
+/**
+ *  @file oglplus/shapes/clusters.hpp
+ *  @brief Partitioning of shapes into clusters with culling bounds
+ *
+ *  @author Matus Chochlik
+ *
+ *  Copyright 2010-2013 Matus Chochlik. Distributed under the Boost
+ *  Software License, Version 1.0. (See accompanying file
+ *  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ */
+
+#pragma once
+#ifndef OGLPLUS_SHAPES_CLUSTERS_1310261410_HPP
+#define OGLPLUS_SHAPES_CLUSTERS_1310261410_HPP
+
+#include <oglplus/shapes/draw.hpp>
+#include <oglplus/shapes/vert_attr_info.hpp>
+#include <oglplus/shapes/vert_attr_forward.hpp>
+#include <oglplus/shapes/vertex_cache.hpp>
+#include <oglplus/face_mode.hpp>
+#include <oglplus/frustum.hpp>
+#include <oglplus/sphere.hpp>
+#include <oglplus/vector.hpp>
+
+#include <vector>
+#include <cstdint>
+#include <cassert>
+#include <cmath>
+
+namespace oglplus {
+namespace aux {
+
+// Returns true if the triangles of a cluster with the specified bounding
+// sphere and normal cone are all back-facing when viewed from camera
+template <typename T>
+inline bool ClusterBackFacing(
+	const T* center,
+	T radius,
+	const T* cone_axis,
+	T cone_cutoff,
+	const T* camera
+)
+{
+	const T d[3] = {
+		center[0] - camera[0],
+		center[1] - camera[1],
+		center[2] - camera[2]
+	};
+	const T dp = d[0]*cone_axis[0] + d[1]*cone_axis[1] + d[2]*cone_axis[2];
+	const T l = std::sqrt(d[0]*d[0] + d[1]*d[1] + d[2]*d[2]);
+	return dp >= cone_cutoff*l + radius;
+}
+
+} // namespace aux
+
+namespace shapes {
+
+/// A cluster of spatially coherent triangles of a shape
+/** The triangles of a cluster are stored as a continuous range
+ *  of a triangle list. Besides the range each cluster has a bounding
+ *  sphere for frustum culling and a cone containing the normals of its
+ *  triangles for back-face culling of the whole cluster.
+ *
+ *  @see BuildShapeClusters
+ *  @see ClusteredShape
+ *  @see ShapeClusterCuller
+ */
+struct ShapeCluster
+{
+	/// The index of the first index of the cluster in the triangle list
+	GLuint first;
+
+	/// The number of indices (three times the number of triangles)
+	GLuint count;
+
+	/// The number of distinct vertices referenced by the cluster
+	GLuint vertex_count;
+
+	/// The center of the bounding sphere of the cluster
+	Vec3f center;
+
+	/// The radius of the bounding sphere of the cluster
+	GLfloat radius;
+
+	/// The axis of the cone containing the normals of the triangles
+	Vec3f cone_axis;
+
+	/// The sine of the half-angle of the normal cone
+	/** If the normals cannot be bounded by a cone narrower than
+	 *  a hemisphere the cutoff is one and the cluster is never
+	 *  back-face culled.
+	 */
+	GLfloat cone_cutoff;
+
+	/// Returns true if all triangles are back-facing from the @p camera
+	/** The position of the @p camera must be in the same space
+	 *  as the vertex positions of the shape (typically model space).
+	 */
+	bool BackFacing(const Vec3f& camera) const
+	{
+		return aux::ClusterBackFacing(
+			center.Data(),
+			radius,
+			cone_axis.Data(),
+			cone_cutoff,
+			camera.Data()
+		);
+	}
+};
+
+/// Partitions a triangle list into clusters of spatially close triangles
+/** The @p triangles (three indices per triangle) are reordered in place
+ *  so that the triangles of each cluster form a continuous range.
+ *  The clusters are grown greedily from a seed triangle, preferring
+ *  the adjacent triangles that add the fewest new vertices and that are
+ *  closest to the centroid of the cluster, until either @p max_vertices
+ *  or @p max_triangles is reached or there are no more connected
+ *  triangles. The @p positions have @p values_per_vertex values
+ *  per vertex, of which the first three are used. The @p winding
+ *  determines the direction of the normals of the triangles.
+ *
+ *  @pre max_vertices >= 3 && max_triangles >= 1
+ */
+std::vector<ShapeCluster> BuildShapeClusters(
+	std::vector<GLuint>& triangles,
+	const std::vector<GLfloat>& positions,
+	GLuint values_per_vertex,
+	FaceOrientation winding,
+	GLuint max_vertices = 64,
+	GLuint max_triangles = 126
+);
+
+/// Wrapper partitioning the triangles of a shape builder into clusters
+/** The vertex attributes of the wrapped @c ShapeBuilder are forwarded
+ *  unchanged, the triangles of all triangle list, strip and fan
+ *  operations are converted into a single triangle list, ordered
+ *  by the clusters computed by BuildShapeClusters. Operations
+ *  drawing other primitive types are not included.
+ *
+ *  The Instructions() function returns a single operation drawing
+ *  all clusters, the ClusterInstructions() one operation for each
+ *  cluster. To draw only the potentially visible clusters
+ *  use the ShapeClusterCuller.
+ *
+ *  @see ShapeCluster
+ *  @see ShapeClusterCuller
+ */
+template <class ShapeBuilder>
+class ClusteredShape
+ : public DrawingInstructionWriter
+{
+private:
+	ShapeBuilder _builder;
+	std::vector<GLuint> _indices;
+	std::vector<ShapeCluster> _clusters;
+
+	void _init(GLuint max_vertices, GLuint max_triangles)
+	{
+		const typename ShapeBuilder::IndexArray indices =
+			_builder.Indices();
+		const DrawingInstructions instr = _builder.Instructions();
+		auto i = instr.Operations().begin(), e = instr.Operations().end();
+		while(i != e)
+		{
+			if(	(i->mode == PrimitiveType::Triangles) ||
+				(i->mode == PrimitiveType::TriangleStrip) ||
+				(i->mode == PrimitiveType::TriangleFan)
+			) aux::AppendShapeTriangles(_indices, *i, indices);
+			++i;
+		}
+		std::vector<GLfloat> positions;
+		const GLuint npv = _builder.Positions(positions);
+		_clusters = BuildShapeClusters(
+			_indices,
+			positions,
+			npv,
+			_builder.FaceWinding(),
+			max_vertices,
+			max_triangles
+		);
+	}
+
+	static DrawOperation _make_operation(GLuint first, GLuint count)
+	{
+		DrawOperation op;
+		op.method = DrawOperation::Method::DrawElements;
+		op.mode = PrimitiveType::Triangles;
+		op.first = first;
+		op.count = count;
+		op.restart_index = DrawOperation::NoRestartIndex();
+		op.phase = 0;
+		return op;
+	}
+public:
+	/// Partitions a copy of the specified @p builder into clusters
+	/**
+	 *  @see BuildShapeClusters
+	 */
+	ClusteredShape(
+		const ShapeBuilder& builder,
+		GLuint max_vertices = 64,
+		GLuint max_triangles = 126
+	): _builder(builder)
+	{
+		_init(max_vertices, max_triangles);
+	}
+
+	/// Returns the wrapped builder
+	const ShapeBuilder& Builder(void) const
+	{
+		return _builder;
+	}
+
+	/// Returns the clusters of the shape
+	const std::vector<ShapeCluster>& Clusters(void) const
+	{
+		return _clusters;
+	}
+
+	/// Returns the winding direction of faces
+	FaceOrientation FaceWinding(void) const
+	{
+		return _builder.FaceWinding();
+	}
+
+	/// Makes vertex coordinates and returns number of values per vertex
+	OGLPLUS_SHAPES_HLPR_FORWARD_VERT_ATTR(Positions)
+	/// Makes vertex normals and returns number of values per vertex
+	OGLPLUS_SHAPES_HLPR_FORWARD_VERT_ATTR(Normals)
+	/// Makes vertex tangents and returns number of values per vertex
+	OGLPLUS_SHAPES_HLPR_FORWARD_VERT_ATTR(Tangents)
+	/// Makes vertex bi-tangents and returns number of values per vertex
+	OGLPLUS_SHAPES_HLPR_FORWARD_VERT_ATTR(Bitangents)
+	/// Makes texture coordinates and returns number of values per vertex
+	OGLPLUS_SHAPES_HLPR_FORWARD_VERT_ATTR(TexCoordinates)
+	/// Makes material numbers and returns number of values per vertex
+	OGLPLUS_SHAPES_HLPR_FORWARD_VERT_ATTR(MaterialNumbers)
+
+	/// Vertex attribute information for this shape builder
+	/** This builder provides the same vertex attributes as
+	 *  the wrapped @c ShapeBuilder.
+	 */
+	typedef VertexAttribsInfo<
+		ClusteredShape,
+		typename VertexAttribsTags<
+			typename ShapeBuilder::VertexAttribs
+		>::type
+	> VertexAttribs;
+
+	/// Queries the bounding sphere coordinates and dimensions
+	template <typename T>
+	void BoundingSphere(oglplus::Sphere<T>& bounding_sphere) const
+	{
+		_builder.BoundingSphere(bounding_sphere);
+	}
+
+	/// The type of index container returned by Indices()
+	typedef std::vector<GLuint> IndexArray;
+
+	/// Returns the triangle list indices ordered by the clusters
+	const IndexArray& Indices(void) const
+	{
+		return _indices;
+	}
+
+	/// Returns the instructions for rendering of all clusters at once
+	DrawingInstructions Instructions(void) const
+	{
+		return this->MakeInstructions(
+			_make_operation(0, GLuint(_indices.size()))
+		);
+	}
+
+	/// Returns the instructions rendering each cluster separately
+	DrawingInstructions ClusterInstructions(void) const
+	{
+		auto instructions = this->MakeInstructions();
+		for(auto i=_clusters.begin(), e=_clusters.end(); i!=e; ++i)
+		{
+			this->AddInstruction(
+				instructions,
+				_make_operation(i->first, i->count)
+			);
+		}
+		return instructions;
+	}
+};
+
+/// Culls the clusters of a shape and makes ranges for MultiDrawElements
+/** The culler keeps the bounding spheres of the clusters in a structure
+ *  of arrays so that they can be tested against a Frustum in batches.
+ *  The Cull function tests all clusters against the frustum and
+ *  optionally against the position of the camera (with the normal cones)
+ *  and merges the consecutive visible clusters into ranges.
+ *  The resulting Counts() and Indices() (byte offsets of the ranges
+ *  in the element buffer, storing GLuint indices) can be passed
+ *  directly to Context::MultiDrawElements:
+ *
+ *  @code
+ *  std::size_t n = culler.Cull(frustum, camera);
+ *  gl.MultiDrawElements(
+ *      PrimitiveType::Triangles,
+ *      culler.Counts(),
+ *      culler.Indices(),
+ *      GLsizei(n)
+ *  );
+ *  @endcode
+ *
+ *  @see ShapeCluster
+ *  @see ClusteredShape
+ */
+template <typename T>
+class ShapeClusterCuller
+{
+private:
+	BoundingSphereArrays<T> _spheres;
+	// the bounding spheres and normal cones of the clusters
+	std::vector<T> _bounds;
+	std::vector<GLuint> _firsts;
+	std::vector<GLuint> _sizes;
+
+	std::vector<std::uint32_t> _mask;
+	std::vector<GLsizei> _counts;
+	std::vector<GLuint*> _offsets;
+	std::size_t _visible;
+
+	bool _mask_bit(std::size_t i) const
+	{
+		return (_mask[i / 32] & (std::uint32_t(1) << (i % 32))) != 0;
+	}
+
+	std::size_t _make_ranges(const T* camera)
+	{
+		_counts.clear();
+		_offsets.clear();
+		_visible = 0;
+		GLuint end = 0;
+		for(std::size_t i=0, n=_firsts.size(); i!=n; ++i)
+		{
+			if(!_mask_bit(i)) continue;
+			const T* b = _bounds.data()+i*8;
+			if(camera && aux::ClusterBackFacing(
+				b+0, b[3],
+				b+4, b[7],
+				camera
+			)) continue;
+			++_visible;
+			if(!_counts.empty() && (_firsts[i] == end))
+				_counts.back() += GLsizei(_sizes[i]);
+			else
+			{
+				_counts.push_back(GLsizei(_sizes[i]));
+				_offsets.push_back(reinterpret_cast<GLuint*>(
+					std::size_t(_firsts[i])*sizeof(GLuint)
+				));
+			}
+			end = _firsts[i] + _sizes[i];
+		}
+		return _counts.size();
+	}
+public:
+	/// Prepares the culling of the specified @p clusters
+	ShapeClusterCuller(const std::vector<ShapeCluster>& clusters)
+	 : _visible(0)
+	{
+		_spheres.Reserve(clusters.size());
+		_bounds.reserve(clusters.size()*8);
+		_firsts.reserve(clusters.size());
+		_sizes.reserve(clusters.size());
+		for(auto i=clusters.begin(), e=clusters.end(); i!=e; ++i)
+		{
+			const T b[8] = {
+				T(i->center.x()),
+				T(i->center.y()),
+				T(i->center.z()),
+				T(i->radius),
+				T(i->cone_axis.x()),
+				T(i->cone_axis.y()),
+				T(i->cone_axis.z()),
+				T(i->cone_cutoff)
+			};
+			_spheres.Append(Vector<T, 3>(b[0], b[1], b[2]), b[3]);
+			_bounds.insert(_bounds.end(), b, b+8);
+			_firsts.push_back(i->first);
+			_sizes.push_back(i->count);
+		}
+	}
+
+	/// Culls the clusters against the @p frustum only
+	/** Returns the number of the resulting draw ranges.
+	 */
+	std::size_t Cull(const Frustum<T>& frustum)
+	{
+		frustum.Cull(_spheres, _mask);
+		return _make_ranges(nullptr);
+	}
+
+	/// Culls the clusters against the @p frustum and by their normal cones
+	/** The position of the @p camera must be in the same space
+	 *  as the vertex positions of the shape. Returns the number
+	 *  of the resulting draw ranges.
+	 */
+	std::size_t Cull(const Frustum<T>& frustum, const Vector<T, 3>& camera)
+	{
+		frustum.Cull(_spheres, _mask);
+		return _make_ranges(camera.Data());
+	}
+
+	/// Returns the number of clusters
+	std::size_t ClusterCount(void) const
+	{
+		return _firsts.size();
+	}
+
+	/// Returns the number of clusters visible after the last Cull
+	std::size_t VisibleClusterCount(void) const
+	{
+		return _visible;
+	}
+
+	/// Returns the number of draw ranges made by the last Cull
+	std::size_t RangeCount(void) const
+	{
+		return _counts.size();
+	}
+
+	/// Returns the numbers of indices in the individual ranges
+	const GLsizei* Counts(void) const
+	{
+		return _counts.data();
+	}
+
+	/// Returns the offsets of the individual ranges in the index buffer
+	GLuint* const* Indices(void) const
+	{
+		return _offsets.data();
+	}
+};
+
+} // shapes
+} // oglplus
+
+#if !OGLPLUS_LINK_LIBRARY || defined(OGLPLUS_IMPLEMENTING_LIBRARY)
+#include <oglplus/shapes/clusters.ipp>
+#endif // OGLPLUS_LINK_LIBRARY
+
+#endif // include guard
@@ -19,6 +19,8 @@
 #include <oglplus/error.hpp>
 #include <oglplus/primitive_type.hpp>
 #include <oglplus/data_type.hpp>
+#include <oglplus/indirect_command.hpp>
+#include <oglplus/capability.hpp>
 
 #include <vector>
 #include <cassert>
@@ -90,7 +92,12 @@ OGLPLUS_ENUM_CLASS_BEGIN(ShapeDrawOperationMethod, GLuint)
 	OGLPLUS_ENUM_CLASS_VALUE(DrawArrays, 0)
 	OGLPLUS_ENUM_CLASS_COMMA
 	OGLPLUS_ENUM_CLASS_VALUE(DrawElements, 1)
-	// TODO
+	OGLPLUS_ENUM_CLASS_COMMA
+	OGLPLUS_ENUM_CLASS_VALUE(DrawElementsBaseVertex, 2)
+	OGLPLUS_ENUM_CLASS_COMMA
+	OGLPLUS_ENUM_CLASS_VALUE(DrawArraysIndirect, 3)
+	OGLPLUS_ENUM_CLASS_COMMA
+	OGLPLUS_ENUM_CLASS_VALUE(DrawElementsIndirect, 4)
 OGLPLUS_ENUM_CLASS_END(ShapeDrawOperationMethod)
 
 namespace shapes {
@@ -111,9 +118,16 @@ struct DrawOperation
 	PrimitiveType mode;
 
 	/// The first element
+	/** For the DrawArraysIndirect and DrawElementsIndirect methods
+	 *  this is the offset (in bytes) of the first command in the buffer
+	 *  bound to the Buffer::Target::DrawIndirect target.
+	 */
 	GLuint first;
 
 	/// Count of elements
+	/** For the DrawArraysIndirect and DrawElementsIndirect methods
+	 *  this is the number of tightly packed commands to be executed.
+	 */
 	GLuint count;
 
 	/// Special constant for disabling primitive restart
@@ -137,6 +151,40 @@ struct DrawOperation
 	 */
 	GLuint phase;
 
+	/// The value added to the indices by the DrawElementsBaseVertex method
+	/** This member is the last one so that the operations initialized
+	 *  by an aggregate initializer without it do not change; it is used
+	 *  only by the DrawElementsBaseVertex method.
+	 *
+	 *  @see BaseVertex
+	 */
+	GLint base_vertex;
+
+	/// Returns the value added to the indices of the shape
+	/** This is the base_vertex for the DrawElementsBaseVertex method
+	 *  and zero for the other methods.
+	 */
+	GLint BaseVertex(void) const
+	{
+		return (method == Method::DrawElementsBaseVertex)?
+			base_vertex:
+			0;
+	}
+
+	/// Returns true if the operation reads its parameters from a buffer
+	bool Indirect(void) const
+	{
+		return (method == Method::DrawArraysIndirect) ||
+			(method == Method::DrawElementsIndirect);
+	}
+
+	/// Returns true if the operation uses the indices of the shape
+	bool Indexed(void) const
+	{
+		return (method == Method::DrawElements) ||
+			(method == Method::DrawElementsBaseVertex);
+	}
+
 	void Draw(
 		const ElementIndexInfo& index_info,
 		GLuint inst_count = 1,
@@ -204,6 +252,17 @@ private:
 		GLuint inst_count,
 		GLuint base_inst
 	) const;
+
+	void DrawElementsBaseVertex_(
+		void* indices,
+		DataType index_data_type,
+		GLuint inst_count,
+		GLuint base_inst
+	) const;
+
+	void DrawArraysIndirect_(void) const;
+
+	void DrawElementsIndirect_(DataType index_data_type) const;
 };
 
 class DrawingInstructionWriter;
@@ -317,11 +376,37 @@ public:
 	 : _ops(other._ops)
 	{ }
 
+	DrawingInstructions& operator = (DrawingInstructions&& temp)
+	{
+		_ops = std::move(temp._ops);
+		return *this;
+	}
+
 	const std::vector<DrawOperation>& Operations(void) const
 	{
 		return _ops;
 	}
 
+	/// Makes instructions replaying these instructions from a buffer
+	/** The commands for the individual operations, drawing
+	 *  @p inst_count instances starting at @p base_inst, are appended
+	 *  to @p commands. The DrawArrays operations are stored as
+	 *  DrawArraysIndirectCommand and the DrawElements and
+	 *  DrawElementsBaseVertex operations as DrawElementsIndirectCommand.
+	 *  The returned instructions draw the shape from the @p commands
+	 *  (starting at the offset of the initial size of @p commands)
+	 *  stored in a buffer bound to the Buffer::Target::DrawIndirect target.
+	 *  The instance counts in the commands can be changed by the GL
+	 *  (for example written by a compute shader) between the draws.
+	 *
+	 *  @pre None of the operations is indirect.
+	 */
+	DrawingInstructions IndirectInstructions(
+		std::vector<GLuint>& commands,
+		GLuint inst_count = 1,
+		GLuint base_inst = 0
+	) const;
+
 	struct DefaultDriver
 	{
 		inline bool operator()(GLuint /*phase*/) const
@@ -0,0 +1,429 @@
+/**
+ *  @file oglplus/shapes/lod.hpp
+ *  @brief Generation of levels of detail of shapes by quadric edge collapse
+ *
+ *  @author Matus Chochlik
+ *
+ *  Copyright 2010-2013 Matus Chochlik. Distributed under the Boost
+ *  Software License, Version 1.0. (See accompanying file
+ *  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ */
+
+#pragma once
+#ifndef OGLPLUS_SHAPES_LOD_1310251040_HPP
+#define OGLPLUS_SHAPES_LOD_1310251040_HPP
+
+#include <oglplus/shapes/draw.hpp>
+#include <oglplus/shapes/vert_attr_info.hpp>
+#include <oglplus/shapes/vert_attr_forward.hpp>
+#include <oglplus/shapes/analyzer_data.hpp>
+#include <oglplus/face_mode.hpp>
+#include <oglplus/sphere.hpp>
+
+#include <vector>
+#include <limits>
+#include <cassert>
+
+namespace oglplus {
+namespace shapes {
+
+/// Parameters of a single level of detail generated by ShapeSimplifier
+/**
+ *  @see ShapeSimplifier
+ *  @see LODChain
+ */
+struct LODLevel
+{
+	/// The number of triangles at which the simplification stops
+	/** Zero means that the level is limited only by the @c max_error.
+	 */
+	GLuint max_triangles;
+
+	/// The maximal cost of an edge collapse performed for this level
+	GLdouble max_error;
+
+	/// Level with the specified triangle count and error limits
+	LODLevel(
+		GLuint triangles,
+		GLdouble error = std::numeric_limits<GLdouble>::max()
+	): max_triangles(triangles)
+	 , max_error(error)
+	{ }
+
+	/// Level limited only by the triangle count
+	static LODLevel TriangleCount(GLuint triangles)
+	{
+		return LODLevel(triangles);
+	}
+
+	/// Level limited only by the cost of the collapses
+	static LODLevel MaxError(GLdouble error)
+	{
+		return LODLevel(0, error);
+	}
+};
+
+/// Simplifies triangle meshes by quadric error metric edge collapse
+/** The simplifier uses the faces and the face adjacency (detected from
+ *  the vertex positions) of ShapeAnalyzerGraphData. The vertices
+ *  with the same position are welded together and each vertex accumulates
+ *  the quadric error of the planes of its faces (Garland-Heckbert).
+ *  Open borders are preserved by additional quadrics perpendicular
+ *  to the border edges and the border vertices can move only along
+ *  the border.
+ *
+ *  The edges are collapsed into one of their vertices (half-edge
+ *  collapse), so the remaining vertices keep their original attributes
+ *  and all levels can share the same vertex attribute buffers.
+ *  To preserve the attributes, the vertices lying on attribute seams
+ *  (having several vertices with the same position but different
+ *  normals or texture coordinates) are never removed. The squared
+ *  difference between the attributes of the removed vertex and
+ *  the values interpolated at its position by the collapsed faces,
+ *  multiplied by @c attrib_weight and the area of the faces around
+ *  the removed vertex, is added to the cost of each collapse.
+ *
+ *  @see LODChain
+ */
+class ShapeSimplifier
+{
+private:
+	const ShapeAnalyzerGraphData& _data;
+
+	// the welded vertex (position) of each vertex
+	std::vector<GLuint> _weld;
+	// the number of vertices welded into a welded vertex
+	std::vector<GLuint> _weld_size;
+	// a representative vertex of each welded vertex
+	std::vector<GLuint> _weld_vert;
+	// the error quadrics of the welded vertices
+	std::vector<GLdouble> _quadrics;
+	// flags indicating that the welded vertex is on an open border
+	std::vector<bool> _border;
+	// flags indicating that the welded vertex was removed
+	std::vector<bool> _removed;
+	// modification counter of the welded vertices
+	std::vector<GLuint> _version;
+	// the faces referencing each welded vertex
+	std::vector<std::vector<GLuint> > _vert_faces;
+
+	// the vertices of the individual faces
+	std::vector<GLuint> _face_verts;
+	// flags indicating that the face was collapsed
+	std::vector<bool> _face_removed;
+	GLuint _face_count;
+
+	// additional vertex attributes used in the collapse cost
+	std::vector<const std::vector<GLdouble>*> _attribs;
+	std::vector<GLuint> _attrib_vpvs;
+	GLdouble _attrib_weight;
+
+	struct _collapse
+	{
+		GLdouble cost;
+		GLuint from, to;
+		GLuint from_version, to_version;
+
+		bool operator < (const _collapse& that) const
+		{
+			return cost > that.cost;
+		}
+	};
+	std::vector<_collapse> _heap;
+
+	GLdouble _pos(GLuint weld, GLuint coord) const
+	{
+		assert(coord < 3);
+		return _data._main_va[_weld_vert[weld]*_data._main_vpv+coord];
+	}
+
+	GLuint _welded(GLuint face, GLuint corner) const
+	{
+		return _weld[_face_verts[face*3+corner]];
+	}
+
+	void _weld_vertices(void);
+	void _init_quadrics(void);
+	void _add_quadric(GLuint weld, const GLdouble plane[4], GLdouble w);
+	GLdouble _quadric_error(GLuint from, GLuint to) const;
+	GLdouble _face_area(GLuint face) const;
+	GLdouble _attrib_error(GLuint from, GLuint to, GLuint target) const;
+	GLuint _target_vertex(GLuint from, GLuint to, GLuint& shared) const;
+	bool _check_link(GLuint from, GLuint to, GLuint shared) const;
+	bool _check_flips(GLuint from, GLuint to) const;
+	bool _collapse_cost(GLuint from, GLuint to, GLdouble& cost) const;
+	void _push_collapse(GLuint from, GLuint to);
+	void _push_collapses(GLuint weld);
+	void _do_collapse(GLuint from, GLuint to);
+public:
+	/// Prepares the simplification of the analyzed mesh
+	ShapeSimplifier(
+		const ShapeAnalyzerGraphData& data,
+		GLdouble attrib_weight = 1.0
+	);
+
+	/// Adds a vertex attribute whose values should be preserved
+	/** The @p values with @p values_per_vertex per vertex must
+	 *  remain valid until the last call to Simplify.
+	 */
+	void AddAttrib(
+		const std::vector<GLdouble>& values,
+		GLuint values_per_vertex
+	);
+
+	/// Returns the current number of triangles
+	GLuint TriangleCount(void) const
+	{
+		return _face_count;
+	}
+
+	/// Simplifies the mesh according to @p level
+	/** Appends the indices of the triangles remaining after
+	 *  the simplification to @p indices and returns the largest
+	 *  cost of a collapse performed. Subsequent calls continue
+	 *  the simplification of the already simplified mesh.
+	 */
+	GLdouble Simplify(const LODLevel& level, std::vector<GLuint>& indices);
+};
+
+/// Shape builder wrapper generating levels of detail of another builder
+/** LODChain analyzes the triangles drawn by the instructions of
+ *  the wrapped @c ShapeBuilder and generates a chain of progressively
+ *  simplified triangle lists with ShapeSimplifier, one for each of
+ *  the specified LODLevel(s). The level 0 is the original mesh
+ *  (without the degenerate triangles).
+ *  All levels share the same vertex attributes which are provided
+ *  unchanged by the wrapped builder. The normals and texture coordinates
+ *  (if provided by the builder) are preserved.
+ *
+ *  The instructions returned by Instructions() draw each level with
+ *  a separate operation whose phase is the number of the level,
+ *  so a level can be selected for each draw with the drawing driver
+ *  of ShapeWrapper:
+ *  @code
+ *  shapes::ShapeWrapper sphere(
+ *      {"Position", "Normal"},
+ *      shapes::LODChain<shapes::Sphere>(
+ *          shapes::Sphere(1.0, 72, 48),
+ *          {6000, 1500, 400}
+ *      ),
+ *      prog
+ *  );
+ *  sphere.Draw(shapes::LODSelector(lod));
+ *  @endcode
+ */
+template <class ShapeBuilder>
+class LODChain
+ : public DrawingInstructionWriter
+{
+private:
+	ShapeBuilder _builder;
+	std::vector<GLuint> _indices;
+	std::vector<GLuint> _level_first;
+	std::vector<GLdouble> _level_error;
+
+	void _init(const std::vector<LODLevel>& levels, GLdouble attrib_weight)
+	{
+		ShapeAnalyzerGraphData data(_builder);
+		ShapeSimplifier simplifier(data, attrib_weight);
+		simplifier.AddAttrib(data._smooth_va, data._smooth_vpv);
+
+		std::vector<GLdouble> tex_coords;
+		auto getter = typename ShapeBuilder::VertexAttribs().
+			VertexAttribGetter(tex_coords, "TexCoord");
+		if(getter != nullptr)
+		{
+			GLuint npv = getter(_builder, tex_coords);
+			simplifier.AddAttrib(tex_coords, npv);
+		}
+
+		_level_first.push_back(0);
+		_level_error.push_back(0);
+		simplifier.Simplify(LODLevel(~GLuint(0)), _indices);
+		for(auto i=levels.begin(), e=levels.end(); i!=e; ++i)
+		{
+			_level_first.push_back(GLuint(_indices.size()));
+			_level_error.push_back(simplifier.Simplify(*i, _indices));
+		}
+		_level_first.push_back(GLuint(_indices.size()));
+	}
+
+	DrawOperation _level_operation(GLuint level) const
+	{
+		assert(level < LevelCount());
+		DrawOperation operation;
+		operation.method = DrawOperation::Method::DrawElements;
+		operation.mode = PrimitiveType::Triangles;
+		operation.first = _level_first[level];
+		operation.count = _level_first[level+1]-_level_first[level];
+		operation.restart_index = DrawOperation::NoRestartIndex();
+		operation.phase = level;
+		return operation;
+	}
+public:
+	/// Generates the specified @p levels of detail of a copy of @p builder
+	LODChain(
+		const ShapeBuilder& builder,
+		const std::vector<LODLevel>& levels,
+		GLdouble attrib_weight = 1.0
+	): _builder(builder)
+	{
+		_init(levels, attrib_weight);
+	}
+
+	/// Generates levels with the specified triangle counts
+	LODChain(
+		const ShapeBuilder& builder,
+		const std::vector<GLuint>& triangle_counts,
+		GLdouble attrib_weight = 1.0
+	): _builder(builder)
+	{
+		_init(
+			std::vector<LODLevel>(
+				triangle_counts.begin(),
+				triangle_counts.end()
+			), attrib_weight
+		);
+	}
+
+#if !OGLPLUS_NO_INITIALIZER_LISTS
+	/// Generates levels with the specified triangle counts
+	LODChain(
+		const ShapeBuilder& builder,
+		const std::initializer_list<GLuint>& triangle_counts,
+		GLdouble attrib_weight = 1.0
+	): _builder(builder)
+	{
+		_init(
+			std::vector<LODLevel>(
+				triangle_counts.begin(),
+				triangle_counts.end()
+			), attrib_weight
+		);
+	}
+#endif
+
+	/// Returns the wrapped builder
+	const ShapeBuilder& Builder(void) const
+	{
+		return _builder;
+	}
+
+	/// Returns the number of levels including the original mesh
+	GLuint LevelCount(void) const
+	{
+		return GLuint(_level_error.size());
+	}
+
+	/// Returns the number of triangles of the specified @p level
+	GLuint TriangleCount(GLuint level) const
+	{
+		assert(level < LevelCount());
+		return (_level_first[level+1] - _level_first[level]) / 3;
+	}
+
+	/// Returns the largest collapse cost of the specified @p level
+	GLdouble Error(GLuint level) const
+	{
+		assert(level < LevelCount());
+		return _level_error[level];
+	}
+
+	/// Returns the winding direction of faces
+	FaceOrientation FaceWinding(void) const
+	{
+		return _builder.FaceWinding();
+	}
+
+	/// Makes vertex coordinates and returns number of values per vertex
+	OGLPLUS_SHAPES_HLPR_FORWARD_VERT_ATTR(Positions)
+	/// Makes vertex normals and returns number of values per vertex
+	OGLPLUS_SHAPES_HLPR_FORWARD_VERT_ATTR(Normals)
+	/// Makes vertex tangents and returns number of values per vertex
+	OGLPLUS_SHAPES_HLPR_FORWARD_VERT_ATTR(Tangents)
+	/// Makes vertex bi-tangents and returns number of values per vertex
+	OGLPLUS_SHAPES_HLPR_FORWARD_VERT_ATTR(Bitangents)
+	/// Makes texture coordinates and returns number of values per vertex
+	OGLPLUS_SHAPES_HLPR_FORWARD_VERT_ATTR(TexCoordinates)
+	/// Makes material numbers and returns number of values per vertex
+	OGLPLUS_SHAPES_HLPR_FORWARD_VERT_ATTR(MaterialNumbers)
+
+	/// Vertex attribute information for this shape builder
+	/** This builder provides the same vertex attributes as
+	 *  the wrapped @c ShapeBuilder.
+	 */
+	typedef VertexAttribsInfo<
+		LODChain,
+		typename VertexAttribsTags<
+			typename ShapeBuilder::VertexAttribs
+		>::type
+	> VertexAttribs;
+
+	/// Queries the bounding sphere coordinates and dimensions
+	template <typename T>
+	void BoundingSphere(oglplus::Sphere<T>& bounding_sphere) const
+	{
+		_builder.BoundingSphere(bounding_sphere);
+	}
+
+	/// The type of index container returned by Indices()
+	typedef std::vector<GLuint> IndexArray;
+
+	/// Returns element indices of all levels
+	const IndexArray& Indices(void) const
+	{
+		return _indices;
+	}
+
+	/// Returns the instructions for rendering of the specified level
+	DrawingInstructions Instructions(GLuint level) const
+	{
+		return this->MakeInstructions(_level_operation(level));
+	}
+
+	/// Returns the instructions for rendering of all levels
+	/** The phase of each operation is the number of the level.
+	 *
+	 *  @see LODSelector
+	 */
+	DrawingInstructions Instructions(void) const
+	{
+		auto instructions = this->MakeInstructions();
+		for(GLuint level=0; level!=LevelCount(); ++level)
+		{
+			this->AddInstruction(
+				instructions,
+				_level_operation(level)
+			);
+		}
+		return instructions;
+	}
+};
+
+/// Drawing driver selecting a single level of detail of a LODChain
+/**
+ *  @see LODChain
+ */
+struct LODSelector
+{
+	/// The level to be drawn
+	GLuint level;
+
+	LODSelector(GLuint lvl)
+	 : level(lvl)
+	{ }
+
+	bool operator()(GLuint phase) const
+	{
+		return phase == level;
+	}
+};
+
+} // shapes
+} // oglplus
+
+#if !OGLPLUS_LINK_LIBRARY || defined(OGLPLUS_IMPLEMENTING_LIBRARY)
+#include <oglplus/shapes/lod.ipp>
+#endif // OGLPLUS_LINK_LIBRARY
+
+#endif // include guard
@@ -20,6 +20,8 @@
 #include <oglplus/shapes/vert_attr_info.hpp>
 
 #include <oglplus/sphere.hpp>
+#include <oglplus/strided_span.hpp>
+#include <oglplus/auxiliary/parallel_for.hpp>
 
 #include <cmath>
 #include <cassert>
@@ -36,9 +38,47 @@ private:
 	Vec3f _u, _v;
 	unsigned _udiv, _vdiv;
 
-	unsigned _vertex_count(void) const
+	// calls make_row(j, p) for each row j of vertices, where p points
+	// to the first value of the first vertex of the row in dest
+	template <typename T, typename Func>
+	GLuint _make(
+		StridedSpan<T> dest,
+		GLuint values_per_vertex,
+		unsigned max_threads,
+		Func make_row
+	) const
 	{
-		return (_udiv+1)*(_vdiv+1);
+		assert(dest.Components() == values_per_vertex);
+		assert(dest.Size() >= VertexCount());
+		aux::ParallelForRows(
+			dest,
+			_vdiv + 1,
+			_udiv + 1,
+			max_threads,
+			make_row
+		);
+		return values_per_vertex;
+	}
+
+	template <typename T>
+	GLuint _make_constant(
+		StridedSpan<T> dest,
+		const Vec3f& value,
+		unsigned max_threads
+	) const
+	{
+		return _make(dest, 3, max_threads,
+			[=](std::size_t, T* p)
+			{
+				for(unsigned i=0; i!=(_udiv+1); ++i)
+				{
+					p[0] = T(value.x());
+					p[1] = T(value.y());
+					p[2] = T(value.z());
+					p += dest.Stride();
+				}
+			}
+		);
 	}
 public:
 	/// Creates a default plane
@@ -134,125 +174,137 @@ public:
 		return FaceOrientation::CW;
 	}
 
+	/// Returns the number of vertices of the plane
+	/** This is the number of tuples written by the attribute
+	 *  functions taking a StridedSpan.
+	 */
+	GLuint VertexCount(void) const
+	{
+		return (_udiv+1)*(_vdiv+1);
+	}
+
 	/// Makes vertex normals and returns number of values per vertex
 	template <typename T>
 	GLuint Normals(std::vector<T>& dest) const
 	{
-		unsigned k = 0, n = _vertex_count();
-		dest.resize(n * 3);
-		Vec3f normal = Normal();
-
-		for(unsigned i=0; i!=n; ++i)
-		{
-			dest[k++] = T(normal.x());
-			dest[k++] = T(normal.y());
-			dest[k++] = T(normal.z());
-		}
-		//
-		assert(k == dest.size());
-		// 3 values per vertex
-		return 3;
+		dest.resize(VertexCount() * 3);
+		return Normals(StridedSpan<T>(dest, 3));
+	}
+
+	/// Makes vertex normals into the specified memory
+	/** @see Positions(StridedSpan<T>, unsigned)
+	 */
+	template <typename T>
+	GLuint Normals(StridedSpan<T> dest, unsigned max_threads = 1) const
+	{
+		return _make_constant(dest, Normal(), max_threads);
 	}
 
 	/// Makes vertex tangents and returns number of values per vertex
 	template <typename T>
 	GLuint Tangents(std::vector<T>& dest) const
 	{
-		unsigned k = 0, n = _vertex_count();
-		dest.resize(n * 3);
-		Vec3f tangent(Normalized(_u));
-
-		for(unsigned i=0; i!=n; ++i)
-		{
-			dest[k++] = T(tangent.x());
-			dest[k++] = T(tangent.y());
-			dest[k++] = T(tangent.z());
-		}
-		//
-		assert(k == dest.size());
-		// 3 values per vertex
-		return 3;
+		dest.resize(VertexCount() * 3);
+		return Tangents(StridedSpan<T>(dest, 3));
+	}
+
+	/// Makes vertex tangents into the specified memory
+	/** @see Positions(StridedSpan<T>, unsigned)
+	 */
+	template <typename T>
+	GLuint Tangents(StridedSpan<T> dest, unsigned max_threads = 1) const
+	{
+		return _make_constant(dest, Normalized(_u), max_threads);
 	}
 
 	/// Makes vertex bi-tangents and returns number of values per vertex
 	template <typename T>
 	GLuint Bitangents(std::vector<T>& dest) const
 	{
-		unsigned k = 0, n = _vertex_count();
-		dest.resize(n * 3);
-		Vec3f bitangent(Normalized(_v));
-
-		for(unsigned i=0; i!=n; ++i)
-		{
-			dest[k++] = T(bitangent.x());
-			dest[k++] = T(bitangent.y());
-			dest[k++] = T(bitangent.z());
-		}
-		//
-		assert(k == dest.size());
-		// 3 values per vertex
-		return 3;
+		dest.resize(VertexCount() * 3);
+		return Bitangents(StridedSpan<T>(dest, 3));
+	}
+
+	/// Makes vertex bi-tangents into the specified memory
+	/** @see Positions(StridedSpan<T>, unsigned)
+	 */
+	template <typename T>
+	GLuint Bitangents(StridedSpan<T> dest, unsigned max_threads = 1) const
+	{
+		return _make_constant(dest, Normalized(_v), max_threads);
 	}
 
 	/// Makes vertex coordinates and returns number of values per vertex
 	template <typename T>
 	GLuint Positions(std::vector<T>& dest) const
 	{
-		unsigned k = 0, n = _vertex_count();
-		dest.resize(n * 3);
-
-
-		Vec3f pos(_point - _u - _v);
-		Vec3f ustep(_u * (2.0 / _udiv));
-		Vec3f vstep(_v * (2.0 / _vdiv));
+		dest.resize(VertexCount() * 3);
+		return Positions(StridedSpan<T>(dest, 3));
+	}
 
-		unsigned leap = _udiv+1;
+	/// Makes vertex coordinates into the specified memory
+	/** The positions of VertexCount() vertices are written
+	 *  into @p dest (which can reference a mapped buffer or interleaved
+	 *  attributes). If @p max_threads is greater than one then the rows
+	 *  of a densely divided plane are generated in parallel.
+	 *
+	 *  @pre dest.Components() == 3
+	 *  @pre dest.Size() >= VertexCount()
+	 */
+	template <typename T>
+	GLuint Positions(StridedSpan<T> dest, unsigned max_threads = 1) const
+	{
+		const Vec3f pos(_point - _u - _v);
+		const Vec3f ustep(_u * (2.0 / _udiv));
+		const Vec3f vstep(_v * (2.0 / _vdiv));
 
-		for(unsigned j=0; j!=(_vdiv+1); ++j)
-		{
-			Vec3f tmp = pos;
-			for(unsigned i=0; i!=leap; ++i)
+		return _make(dest, 3, max_threads,
+			[=](std::size_t j, T* p)
 			{
-				dest[k++] = T(tmp.x());
-				dest[k++] = T(tmp.y());
-				dest[k++] = T(tmp.z());
-				tmp += ustep;
+				Vec3f tmp = pos + vstep * GLfloat(j);
+				for(unsigned i=0; i!=(_udiv+1); ++i)
+				{
+					p[0] = T(tmp.x());
+					p[1] = T(tmp.y());
+					p[2] = T(tmp.z());
+					p += dest.Stride();
+					tmp += ustep;
+				}
 			}
-			pos += vstep;
-		}
-		assert(k == dest.size());
-		return 3;
+		);
 	}
 
 	/// Makes texture-coorinates and returns number of values per vertex
 	template <typename T>
 	GLuint TexCoordinates(std::vector<T>& dest) const
 	{
-		unsigned k = 0, n = _vertex_count();
-		dest.resize(n * 2);
-
-
-		T uc, vc = T(0);
-		T ustep = T(1) / _udiv;
-		T vstep = T(1) / _vdiv;
-
-		unsigned leap = _udiv+1;
+		dest.resize(VertexCount() * 2);
+		return TexCoordinates(StridedSpan<T>(dest, 2));
+	}
 
+	/// Makes texture-coordinates into the specified memory
+	/** @see Positions(StridedSpan<T>, unsigned)
+	 */
+	template <typename T>
+	GLuint TexCoordinates(StridedSpan<T> dest, unsigned max_threads = 1) const
+	{
+		const T ustep = T(1) / _udiv;
+		const T vstep = T(1) / _vdiv;
 
-		for(unsigned j=0; j!=(_vdiv+1); ++j)
-		{
-			uc = T(0);
-			for(unsigned i=0; i!=leap; ++i)
+		return _make(dest, 2, max_threads,
+			[=](std::size_t j, T* p)
 			{
-				dest[k++] = T(uc);
-				dest[k++] = T(vc);
-				uc += ustep;
+				T uc = T(0);
+				const T vc = vstep * T(j);
+				for(unsigned i=0; i!=(_udiv+1); ++i)
+				{
+					p[0] = T(uc);
+					p[1] = T(vc);
+					p += dest.Stride();
+					uc += ustep;
+				}
 			}
-			vc += vstep;
-		}
-		assert(k == dest.size());
-		// 2 values per vertex
-		return 2;
+		);
 	}
 
 #if OGLPLUS_DOCUMENTATION_ONLY
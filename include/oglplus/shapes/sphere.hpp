@@ -20,6 +20,8 @@
 
 #include <oglplus/math.hpp>
 #include <oglplus/sphere.hpp>
+#include <oglplus/strided_span.hpp>
+#include <oglplus/auxiliary/parallel_for.hpp>
 
 namespace oglplus {
 namespace shapes {
@@ -31,6 +33,55 @@ class Sphere
 private:
 	GLdouble _radius;
 	unsigned _sections, _rings;
+
+	// calls make_ring(r, p) for each ring r, where p points to the first
+	// value of the first vertex of the ring in dest
+	template <typename T, typename Func>
+	GLuint _make(
+		StridedSpan<T> dest,
+		GLuint values_per_vertex,
+		unsigned max_threads,
+		Func make_ring
+	) const
+	{
+		assert(dest.Components() == values_per_vertex);
+		assert(dest.Size() >= VertexCount());
+		aux::ParallelForRows(
+			dest,
+			_rings + 2,
+			_sections + 1,
+			max_threads,
+			make_ring
+		);
+		return values_per_vertex;
+	}
+
+	template <typename T>
+	GLuint _make_normals(
+		StridedSpan<T> dest,
+		GLdouble scale,
+		unsigned max_threads
+	) const
+	{
+		const GLdouble r_step = (1.0 * math::Pi()) / GLdouble(_rings + 1);
+		const GLdouble s_step = (2.0 * math::Pi()) / GLdouble(_sections);
+
+		return _make(dest, 3, max_threads,
+			[=](std::size_t r, T* p)
+			{
+				GLdouble r_lat = std::cos(r*r_step)*scale;
+				GLdouble r_rad = std::sin(r*r_step)*scale;
+				// the sections
+				for(unsigned s=0; s!=(_sections+1);++s)
+				{
+					p[0] = T(r_rad *  std::cos(s*s_step));
+					p[1] = T(r_lat);
+					p[2] = T(r_rad * -std::sin(s*s_step));
+					p += dest.Stride();
+				}
+			}
+		);
+	}
 public:
 	/// Creates a sphere with unit radius centered at the origin
 	Sphere(void)
@@ -52,126 +103,156 @@ public:
 		return FaceOrientation::CCW;
 	}
 
+	/// Returns the number of vertices of the sphere
+	/** This is the number of tuples written by the attribute
+	 *  functions taking a StridedSpan.
+	 */
+	GLuint VertexCount(void) const
+	{
+		return (_rings + 2) * (_sections + 1);
+	}
+
 	/// Makes vertex normals and returns number of values per vertex
 	template <typename T>
 	GLuint Normals(std::vector<T>& dest) const
 	{
-		dest.resize(((_rings + 2) * (_sections + 1)) * 3);
-		unsigned k = 0;
-		//
-		GLdouble r_step = (1.0 * math::Pi()) / GLdouble(_rings + 1);
-		GLdouble s_step = (2.0 * math::Pi()) / GLdouble(_sections);
-
-		for(unsigned r=0; r!=(_rings+2);++r)
-		{
-			GLdouble r_lat = std::cos(r*r_step);
-			GLdouble r_rad = std::sin(r*r_step);
-			// the sections
-			for(unsigned s=0; s!=(_sections+1);++s)
-			{
-				dest[k++] = T(r_rad *  std::cos(s*s_step));
-				dest[k++] = T(r_lat);
-				dest[k++] = T(r_rad * -std::sin(s*s_step));
-			}
-		}
-		//
-		assert(k == dest.size());
-		// 3 values per vertex
-		return 3;
+		dest.resize(VertexCount() * 3);
+		return Normals(StridedSpan<T>(dest, 3));
+	}
+
+	/// Makes vertex normals into the specified memory
+	/** @see Positions(StridedSpan<T>, unsigned)
+	 */
+	template <typename T>
+	GLuint Normals(StridedSpan<T> dest, unsigned max_threads = 1) const
+	{
+		return _make_normals(dest, 1.0, max_threads);
 	}
 
 	/// Makes vertex tangents and returns number of values per vertex
 	template <typename T>
 	GLuint Tangents(std::vector<T>& dest) const
 	{
-		dest.resize(((_rings + 2) * (_sections + 1)) * 3);
-		unsigned k = 0;
-		//
-		GLdouble s_step = (2.0 * math::Pi()) / GLdouble(_sections);
-
-		for(unsigned r=0; r!=(_rings+2);++r)
-		{
-			for(unsigned s=0; s!=(_sections+1);++s)
+		dest.resize(VertexCount() * 3);
+		return Tangents(StridedSpan<T>(dest, 3));
+	}
+
+	/// Makes vertex tangents into the specified memory
+	/** @see Positions(StridedSpan<T>, unsigned)
+	 */
+	template <typename T>
+	GLuint Tangents(StridedSpan<T> dest, unsigned max_threads = 1) const
+	{
+		const GLdouble s_step = (2.0 * math::Pi()) / GLdouble(_sections);
+
+		return _make(dest, 3, max_threads,
+			[=](std::size_t, T* p)
 			{
-				dest[k++] = T(-std::sin(s*s_step));
-				dest[k++] = T(0);
-				dest[k++] = T(-std::cos(s*s_step));
+				for(unsigned s=0; s!=(_sections+1);++s)
+				{
+					p[0] = T(-std::sin(s*s_step));
+					p[1] = T(0);
+					p[2] = T(-std::cos(s*s_step));
+					p += dest.Stride();
+				}
 			}
-		}
-		//
-		assert(k == dest.size());
-		// 3 values per vertex
-		return 3;
+		);
 	}
 
 	/// Makes vertex bi-tangents and returns number of values per vertex
 	template <typename T>
 	GLuint Bitangents(std::vector<T>& dest) const
 	{
-		dest.resize(((_rings + 2) * (_sections + 1)) * 3);
-		unsigned k = 0;
-		//
-		GLdouble r_step = (1.0 * math::Pi()) / GLdouble(_rings + 1);
-		GLdouble s_step = (2.0 * math::Pi()) / GLdouble(_sections);
-
-		GLdouble ty = 0.0;
-		for(unsigned r=0; r!=(_rings+2);++r)
-		{
-			GLdouble r_lat = std::cos(r*r_step);
-			GLdouble r_rad = std::sin(r*r_step);
-			GLdouble ny = r_lat;
-			// the sections
-			for(unsigned s=0; s!=(_sections+1);++s)
+		dest.resize(VertexCount() * 3);
+		return Bitangents(StridedSpan<T>(dest, 3));
+	}
+
+	/// Makes vertex bi-tangents into the specified memory
+	/** @see Positions(StridedSpan<T>, unsigned)
+	 */
+	template <typename T>
+	GLuint Bitangents(StridedSpan<T> dest, unsigned max_threads = 1) const
+	{
+		const GLdouble r_step = (1.0 * math::Pi()) / GLdouble(_rings + 1);
+		const GLdouble s_step = (2.0 * math::Pi()) / GLdouble(_sections);
+
+		return _make(dest, 3, max_threads,
+			[=](std::size_t r, T* p)
 			{
-				GLdouble tx = -std::sin(s*s_step);
-				GLdouble tz = -std::cos(s*s_step);
-				GLdouble nx = -r_rad * tz;
-				GLdouble nz =  r_rad * tx;
-
-				dest[k++] = T(ny*tz-nz*ty);
-				dest[k++] = T(nz*tx-nx*tz);
-				dest[k++] = T(nx*ty-ny*tx);
+				GLdouble ty = 0.0;
+				GLdouble r_lat = std::cos(r*r_step);
+				GLdouble r_rad = std::sin(r*r_step);
+				GLdouble ny = r_lat;
+				// the sections
+				for(unsigned s=0; s!=(_sections+1);++s)
+				{
+					GLdouble tx = -std::sin(s*s_step);
+					GLdouble tz = -std::cos(s*s_step);
+					GLdouble nx = -r_rad * tz;
+					GLdouble nz =  r_rad * tx;
+
+					p[0] = T(ny*tz-nz*ty);
+					p[1] = T(nz*tx-nx*tz);
+					p[2] = T(nx*ty-ny*tx);
+					p += dest.Stride();
+				}
 			}
-		}
-		//
-		assert(k == dest.size());
-		// 3 values per vertex
-		return 3;
+		);
 	}
 
 	/// Makes vertex coordinates and returns number of values per vertex
 	template <typename T>
 	GLuint Positions(std::vector<T>& dest) const
 	{
-		GLuint n = Normals(dest);
-		if(_radius != 1.0)
-			for(auto i=dest.begin(),e=dest.end(); i!= e; ++i)
-				*i *= _radius;
-		return n;
+		dest.resize(VertexCount() * 3);
+		return Positions(StridedSpan<T>(dest, 3));
+	}
+
+	/// Makes vertex coordinates into the specified memory
+	/** The positions of VertexCount() vertices are written
+	 *  into @p dest (which can reference a mapped buffer or interleaved
+	 *  attributes). If @p max_threads is greater than one then the rings
+	 *  of a dense sphere are generated in parallel.
+	 *
+	 *  @pre dest.Components() == 3
+	 *  @pre dest.Size() >= VertexCount()
+	 */
+	template <typename T>
+	GLuint Positions(StridedSpan<T> dest, unsigned max_threads = 1) const
+	{
+		return _make_normals(dest, _radius, max_threads);
 	}
 
 	/// Makes texture-coorinates and returns number of values per vertex
 	template <typename T>
 	GLuint TexCoordinates(std::vector<T>& dest) const
 	{
-		dest.resize(((_rings + 2) * (_sections + 1)) * 2);
-		unsigned k = 0;
-		//
-		GLdouble r_step = 1.0 / GLdouble(_rings + 1);
-		GLdouble s_step = 1.0 / GLdouble(_sections);
-		for(unsigned r=0; r!=(_rings+2);++r)
-		{
-			GLdouble r_lat = 1.0 - r*r_step;
-			// the sections
-			for(unsigned s=0; s!=(_sections+1);++s)
+		dest.resize(VertexCount() * 2);
+		return TexCoordinates(StridedSpan<T>(dest, 2));
+	}
+
+	/// Makes texture-coordinates into the specified memory
+	/** @see Positions(StridedSpan<T>, unsigned)
+	 */
+	template <typename T>
+	GLuint TexCoordinates(StridedSpan<T> dest, unsigned max_threads = 1) const
+	{
+		const GLdouble r_step = 1.0 / GLdouble(_rings + 1);
+		const GLdouble s_step = 1.0 / GLdouble(_sections);
+
+		return _make(dest, 2, max_threads,
+			[=](std::size_t r, T* p)
 			{
-				dest[k++] = T(s * s_step);
-				dest[k++] = T(r_lat);
+				GLdouble r_lat = 1.0 - r*r_step;
+				// the sections
+				for(unsigned s=0; s!=(_sections+1);++s)
+				{
+					p[0] = T(s * s_step);
+					p[1] = T(r_lat);
+					p += dest.Stride();
+				}
 			}
-		}
-		assert(k == dest.size());
-		// 2 values per vertex
-		return 2;
+		);
 	}
 
 #if OGLPLUS_DOCUMENTATION_ONLY
@@ -20,7 +20,7 @@
 #include <oglplus/vector.hpp>
 #include <oglplus/sphere.hpp>
 
-#include <map>
+#include <vector>
 
 namespace oglplus {
 namespace shapes {
@@ -40,14 +40,12 @@ class SimpleSubdivSphere
 private:
 	GLuint _subdivs;
 	std::vector<GLdouble> _positions;
+	std::vector<GLdouble> _tex_coords;
 	std::vector<GLuint> _indices;
 
-	typedef std::pair<GLuint, GLuint> _edge;
-	std::map<_edge, GLuint> _midpoints;
-
-	GLuint _midpoint(GLuint ia, GLuint ib);
-	void _subdivide(GLuint ia, GLuint ib, GLuint ic, GLuint levels);
-	void _make_face(GLuint ia, GLuint ib, GLuint ic, GLuint levels);
+	void _subdivide(void);
+	void _make_tex_coords(void);
+	void _make(void);
 
 	void _init_icosah(void);
 	void _init_tetrah(void);
@@ -59,12 +57,14 @@ public:
 	 : _subdivs(2)
 	{
 		_init_icosah();
+		_make();
 	}
 
 	SimpleSubdivSphere(GLuint subdivs)
 	 : _subdivs(subdivs)
 	{
 		_init_icosah();
+		_make();
 	}
 
 	SimpleSubdivSphere(GLuint subdivs, InitialShape init_shape);
@@ -85,17 +85,47 @@ public:
 		return 3;
 	}
 
+	/// Makes the normals and returns the number of values per vertex
+	template <typename T>
+	GLuint Normals(std::vector<T>& dest) const
+	{
+		// the positions on the unit sphere are also the normals
+		dest.assign(_positions.begin(), _positions.end());
+		return 3;
+	}
+
+	/// Makes the texture coordinates and returns the values per vertex
+	/** The texture coordinates are mapped like those of the Sphere
+	 *  builder, i.e. the s coordinate goes around the y axis and
+	 *  the t coordinate goes from the south (0) to the north (1) pole.
+	 *  The vertices on the seam where s wraps from 1 back to 0
+	 *  and the pole vertices are duplicated, so the shape is not
+	 *  closed in terms of the element indices.
+	 */
+	template <typename T>
+	GLuint TexCoordinates(std::vector<T>& dest) const
+	{
+		dest.assign(_tex_coords.begin(), _tex_coords.end());
+		return 2;
+	}
+
 #if OGLPLUS_DOCUMENTATION_ONLY
 	/// Vertex attribute information for this shape builder
 	/** SubdivSphere provides build functions for the following named
 	 *  vertex attributes:
 	 *  - "Position" the vertex positions (Positions)
+	 *  - "Normal" the vertex normal vectors (Normals)
+	 *  - "TexCoord" the ST texture coordinates (TexCoordinates)
 	 */
 	typedef VertexAttribsInfo<SubdivSphere> VertexAttribs;
 #else
 	typedef VertexAttribsInfo<
 		SimpleSubdivSphere,
-		std::tuple<VertexPositionsTag>
+		std::tuple<
+			VertexPositionsTag,
+			VertexNormalsTag,
+			VertexTexCoordinatesTag
+		>
 	> VertexAttribs;
 #endif
 
@@ -20,6 +20,8 @@
 
 #include <oglplus/sphere.hpp>
 #include <oglplus/math.hpp>
+#include <oglplus/strided_span.hpp>
+#include <oglplus/auxiliary/parallel_for.hpp>
 
 namespace oglplus {
 namespace shapes {
@@ -31,6 +33,28 @@ class Torus
 private:
 	GLdouble _radius_out, _radius_in;
 	unsigned _sections, _rings;
+
+	// calls make_ring(r, p) for each ring r, where p points to the first
+	// value of the first vertex of the ring in dest
+	template <typename T, typename Func>
+	GLuint _make(
+		StridedSpan<T> dest,
+		GLuint values_per_vertex,
+		unsigned max_threads,
+		Func make_ring
+	) const
+	{
+		assert(dest.Components() == values_per_vertex);
+		assert(dest.Size() >= VertexCount());
+		aux::ParallelForRows(
+			dest,
+			_rings + 1,
+			_sections + 1,
+			max_threads,
+			make_ring
+		);
+		return values_per_vertex;
+	}
 public:
 	/// Creates a torus with unit radius centered at the origin
 	Torus(void)
@@ -54,140 +78,195 @@ public:
 		return FaceOrientation::CCW;
 	}
 
+	/// Returns the number of vertices of the torus
+	/** This is the number of tuples written by the attribute
+	 *  functions taking a StridedSpan.
+	 */
+	GLuint VertexCount(void) const
+	{
+		return (_rings + 1) * (_sections + 1);
+	}
+
 	/// Makes vertex coordinates and returns number of values per vertex
 	template <typename T>
 	GLuint Positions(std::vector<T>& dest) const
 	{
-		dest.resize((_rings + 1) * (_sections + 1) * 3);
-		unsigned k = 0;
-		//
-		GLdouble r_step = (math::TwoPi()) / GLdouble(_rings);
-		GLdouble s_step = (math::TwoPi()) / GLdouble(_sections);
-		GLdouble r1 = _radius_in;
-		GLdouble r2 = _radius_out - _radius_in;
-
-		for(unsigned r=0; r!=(_rings+1); ++r)
-		{
-			GLdouble vx =  std::cos(r*r_step);
-			GLdouble vz = -std::sin(r*r_step);
-			for(unsigned s=0; s!=(_sections+1); ++s)
+		dest.resize(VertexCount() * 3);
+		return Positions(StridedSpan<T>(dest, 3));
+	}
+
+	/// Makes vertex coordinates into the specified memory
+	/** The positions of VertexCount() vertices are written
+	 *  into @p dest (which can reference a mapped buffer or interleaved
+	 *  attributes). If @p max_threads is greater than one then the rings
+	 *  of a dense torus are generated in parallel.
+	 *
+	 *  @pre dest.Components() == 3
+	 *  @pre dest.Size() >= VertexCount()
+	 */
+	template <typename T>
+	GLuint Positions(StridedSpan<T> dest, unsigned max_threads = 1) const
+	{
+		const GLdouble r_step = (math::TwoPi()) / GLdouble(_rings);
+		const GLdouble s_step = (math::TwoPi()) / GLdouble(_sections);
+		const GLdouble r1 = _radius_in;
+		const GLdouble r2 = _radius_out - _radius_in;
+
+		return _make(dest, 3, max_threads,
+			[=](std::size_t r, T* p)
 			{
-				GLdouble vr = std::cos(s*s_step);
-				GLdouble vy = std::sin(s*s_step);
-				dest[k++] = T(vx*(r1 + r2 * (1.0 + vr)));
-				dest[k++] = T(vy*r2);
-				dest[k++] = T(vz*(r1 + r2 * (1.0 + vr)));
+				GLdouble vx =  std::cos(r*r_step);
+				GLdouble vz = -std::sin(r*r_step);
+				for(unsigned s=0; s!=(_sections+1); ++s)
+				{
+					GLdouble vr = std::cos(s*s_step);
+					GLdouble vy = std::sin(s*s_step);
+					p[0] = T(vx*(r1 + r2 * (1.0 + vr)));
+					p[1] = T(vy*r2);
+					p[2] = T(vz*(r1 + r2 * (1.0 + vr)));
+					p += dest.Stride();
+				}
 			}
-		}
-		assert(k == dest.size());
-		return 3;
+		);
 	}
 
 	/// Makes vertex normals and returns number of values per vertex
 	template <typename T>
 	GLuint Normals(std::vector<T>& dest) const
 	{
-		dest.resize((_rings + 1) * (_sections + 1) * 3);
-		unsigned k = 0;
-		//
-		GLdouble r_step = (math::TwoPi()) / GLdouble(_rings);
-		GLdouble s_step = (math::TwoPi()) / GLdouble(_sections);
-
-		for(unsigned r=0; r!=(_rings+1); ++r)
-		{
-			GLdouble nx =  std::cos(r*r_step);
-			GLdouble nz = -std::sin(r*r_step);
-			for(unsigned s=0; s!=(_sections+1); ++s)
+		dest.resize(VertexCount() * 3);
+		return Normals(StridedSpan<T>(dest, 3));
+	}
+
+	/// Makes vertex normals into the specified memory
+	/** @see Positions(StridedSpan<T>, unsigned)
+	 */
+	template <typename T>
+	GLuint Normals(StridedSpan<T> dest, unsigned max_threads = 1) const
+	{
+		const GLdouble r_step = (math::TwoPi()) / GLdouble(_rings);
+		const GLdouble s_step = (math::TwoPi()) / GLdouble(_sections);
+
+		return _make(dest, 3, max_threads,
+			[=](std::size_t r, T* p)
 			{
-				GLdouble nr = std::cos(s*s_step);
-				GLdouble ny = std::sin(s*s_step);
-				dest[k++] = T(nx*nr);
-				dest[k++] = T(ny);
-				dest[k++] = T(nz*nr);
+				GLdouble nx =  std::cos(r*r_step);
+				GLdouble nz = -std::sin(r*r_step);
+				for(unsigned s=0; s!=(_sections+1); ++s)
+				{
+					GLdouble nr = std::cos(s*s_step);
+					GLdouble ny = std::sin(s*s_step);
+					p[0] = T(nx*nr);
+					p[1] = T(ny);
+					p[2] = T(nz*nr);
+					p += dest.Stride();
+				}
 			}
-		}
-		assert(k == dest.size());
-		return 3;
+		);
 	}
 
 	/// Makes vertex tangents and returns number of values per vertex
 	template <typename T>
 	GLuint Tangents(std::vector<T>& dest) const
 	{
-		dest.resize((_rings + 1) * (_sections + 1) * 3);
-		unsigned k = 0;
-		//
-		GLdouble r_step = (math::TwoPi()) / GLdouble(_rings);
-
-		for(unsigned r=0; r!=(_rings+1); ++r)
-		{
-			GLdouble tx = -std::sin(r*r_step);
-			GLdouble tz = -std::cos(r*r_step);
-			for(unsigned s=0; s!=(_sections+1); ++s)
+		dest.resize(VertexCount() * 3);
+		return Tangents(StridedSpan<T>(dest, 3));
+	}
+
+	/// Makes vertex tangents into the specified memory
+	/** @see Positions(StridedSpan<T>, unsigned)
+	 */
+	template <typename T>
+	GLuint Tangents(StridedSpan<T> dest, unsigned max_threads = 1) const
+	{
+		const GLdouble r_step = (math::TwoPi()) / GLdouble(_rings);
+
+		return _make(dest, 3, max_threads,
+			[=](std::size_t r, T* p)
 			{
-				dest[k++] = T(tx);
-				dest[k++] = T(0);
-				dest[k++] = T(tz);
+				GLdouble tx = -std::sin(r*r_step);
+				GLdouble tz = -std::cos(r*r_step);
+				for(unsigned s=0; s!=(_sections+1); ++s)
+				{
+					p[0] = T(tx);
+					p[1] = T(0);
+					p[2] = T(tz);
+					p += dest.Stride();
+				}
 			}
-		}
-		assert(k == dest.size());
-		return 3;
+		);
 	}
 
 	/// Makes vertex bi-tangents and returns number of values per vertex
 	template <typename T>
 	GLuint Bitangents(std::vector<T>& dest) const
 	{
-		dest.resize((_rings + 1) * (_sections + 1) * 3);
-		unsigned k = 0;
-		//
-		GLdouble r_step = (math::TwoPi()) / GLdouble(_rings);
-		GLdouble s_step = (math::TwoPi()) / GLdouble(_sections);
-
-		GLdouble ty = 0.0;
-		for(unsigned r=0; r!=(_rings+1); ++r)
-		{
-			GLdouble tx = -std::sin(r*r_step);
-			GLdouble tz = -std::cos(r*r_step);
-
-			for(unsigned s=0; s!=(_sections+1); ++s)
+		dest.resize(VertexCount() * 3);
+		return Bitangents(StridedSpan<T>(dest, 3));
+	}
+
+	/// Makes vertex bi-tangents into the specified memory
+	/** @see Positions(StridedSpan<T>, unsigned)
+	 */
+	template <typename T>
+	GLuint Bitangents(StridedSpan<T> dest, unsigned max_threads = 1) const
+	{
+		const GLdouble r_step = (math::TwoPi()) / GLdouble(_rings);
+		const GLdouble s_step = (math::TwoPi()) / GLdouble(_sections);
+
+		return _make(dest, 3, max_threads,
+			[=](std::size_t r, T* p)
 			{
-				GLdouble ny = std::sin(s*s_step);
-				GLdouble nr = std::cos(s*s_step);
-				GLdouble nx = -tz*nr;
-				GLdouble nz =  tx*nr;
-
-				dest[k++] = T(ny*tz-nz*ty);
-				dest[k++] = T(nz*tx-nx*tz);
-				dest[k++] = T(nx*ty-ny*tx);
+				GLdouble ty = 0.0;
+				GLdouble tx = -std::sin(r*r_step);
+				GLdouble tz = -std::cos(r*r_step);
+
+				for(unsigned s=0; s!=(_sections+1); ++s)
+				{
+					GLdouble ny = std::sin(s*s_step);
+					GLdouble nr = std::cos(s*s_step);
+					GLdouble nx = -tz*nr;
+					GLdouble nz =  tx*nr;
+
+					p[0] = T(ny*tz-nz*ty);
+					p[1] = T(nz*tx-nx*tz);
+					p[2] = T(nx*ty-ny*tx);
+					p += dest.Stride();
+				}
 			}
-		}
-		assert(k == dest.size());
-		return 3;
+		);
 	}
 
 	/// Makes texture coordinates and returns number of values per vertex
 	template <typename T>
 	GLuint TexCoordinates(std::vector<T>& dest) const
 	{
-		dest.resize((_rings + 1) * (_sections + 1) * 2);
-		unsigned k = 0;
-		//
-		GLdouble r_step = 1.0 / GLdouble(_rings);
-		GLdouble s_step = 1.0 / GLdouble(_sections);
-
-		for(unsigned r=0; r!=(_rings+1); ++r)
-		{
-			GLdouble u = r*r_step;
-			for(unsigned s=0; s!=(_sections+1); ++s)
+		dest.resize(VertexCount() * 2);
+		return TexCoordinates(StridedSpan<T>(dest, 2));
+	}
+
+	/// Makes texture coordinates into the specified memory
+	/** @see Positions(StridedSpan<T>, unsigned)
+	 */
+	template <typename T>
+	GLuint TexCoordinates(StridedSpan<T> dest, unsigned max_threads = 1) const
+	{
+		const GLdouble r_step = 1.0 / GLdouble(_rings);
+		const GLdouble s_step = 1.0 / GLdouble(_sections);
+
+		return _make(dest, 2, max_threads,
+			[=](std::size_t r, T* p)
 			{
-				GLdouble v = s*s_step;
-				dest[k++] = T(u);
-				dest[k++] = T(v);
+				GLdouble u = r*r_step;
+				for(unsigned s=0; s!=(_sections+1); ++s)
+				{
+					GLdouble v = s*s_step;
+					p[0] = T(u);
+					p[1] = T(v);
+					p += dest.Stride();
+				}
 			}
-		}
-		assert(k == dest.size());
-		return 2;
+		);
 	}
 
 #if OGLPLUS_DOCUMENTATION_ONLY
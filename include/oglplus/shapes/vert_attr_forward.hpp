@@ -0,0 +1,44 @@
+/**
+ *  @file oglplus/shapes/vert_attr_forward.hpp
+ *  @brief Helpers for shape builders wrapping other shape builders
+ *
+ *  @author Matus Chochlik
+ *
+ *  Copyright 2010-2013 Matus Chochlik. Distributed under the Boost
+ *  Software License, Version 1.0. (See accompanying file
+ *  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ */
+
+#pragma once
+#ifndef OGLPLUS_SHAPES_VERT_ATTR_FORWARD_1311181200_HPP
+#define OGLPLUS_SHAPES_VERT_ATTR_FORWARD_1311181200_HPP
+
+#include <oglplus/config.hpp>
+
+#include <vector>
+
+// Defines a vertex attribute getter (Positions, Normals, etc.) of a shape
+// builder wrapper, which forwards the call to the wrapped _builder member
+// and then passes the values and the number of values per vertex
+// to PROCESS (for example a member function reordering the vertices).
+#define OGLPLUS_SHAPES_HLPR_PROCESS_VERT_ATTR(GETTER_NAME, PROCESS) \
+	template <typename T> \
+	GLuint GETTER_NAME(std::vector<T>& dest) const \
+	{ \
+		GLuint n = _builder.GETTER_NAME(dest); \
+		PROCESS(dest, n); \
+		return n; \
+	}
+
+// Keeps the forwarded values of a vertex attribute unchanged
+#define OGLPLUS_SHAPES_HLPR_KEEP_VERT_ATTR(DEST, VALUES_PER_VERTEX)
+
+// Defines a vertex attribute getter of a shape builder wrapper
+// returning the values of the wrapped _builder unchanged.
+#define OGLPLUS_SHAPES_HLPR_FORWARD_VERT_ATTR(GETTER_NAME) \
+	OGLPLUS_SHAPES_HLPR_PROCESS_VERT_ATTR( \
+		GETTER_NAME, \
+		OGLPLUS_SHAPES_HLPR_KEEP_VERT_ATTR \
+	)
+
+#endif // include guard
@@ -218,6 +218,19 @@ public:
 };
 #endif
 
+/// Meta-function returning the tags of a VertexAttribsInfo instantiation
+/** This is useful for shape builders wrapping other builders and providing
+ *  the same vertex attributes.
+ */
+template <class VertexAttribs>
+struct VertexAttribsTags;
+
+template <class ShapeBuilder, class VertexAttribTags>
+struct VertexAttribsTags<VertexAttribsInfo<ShapeBuilder, VertexAttribTags> >
+{
+	typedef VertexAttribTags type;
+};
+
 } // shapes
 } // oglplus
 
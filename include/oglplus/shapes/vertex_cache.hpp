@@ -0,0 +1,340 @@
+/**
+ *  @file oglplus/shapes/vertex_cache.hpp
+ *  @brief Post-transform vertex cache and vertex fetch optimization of shapes
+ *
+ *  @author Matus Chochlik
+ *
+ *  Copyright 2010-2013 Matus Chochlik. Distributed under the Boost
+ *  Software License, Version 1.0. (See accompanying file
+ *  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ */
+
+#pragma once
+#ifndef OGLPLUS_SHAPES_VERTEX_CACHE_1310231020_HPP
+#define OGLPLUS_SHAPES_VERTEX_CACHE_1310231020_HPP
+
+#include <oglplus/shapes/draw.hpp>
+#include <oglplus/shapes/vert_attr_info.hpp>
+#include <oglplus/shapes/vert_attr_forward.hpp>
+#include <oglplus/face_mode.hpp>
+#include <oglplus/sphere.hpp>
+
+#include <vector>
+#include <algorithm>
+#include <utility>
+#include <cassert>
+
+namespace oglplus {
+namespace aux {
+
+// Appends the triangles drawn by the triangle list, strip or fan
+// operation op, as a list of three indices per triangle, to dest.
+// The winding of the triangles in strips is made consistent,
+// the degenerate triangles are skipped.
+template <typename IT>
+inline void AppendShapeTriangles(
+	std::vector<GLuint>& dest,
+	const shapes::DrawOperation& op,
+	const std::vector<IT>& indices
+)
+{
+	GLuint v[3] = {0, 0, 0};
+	GLuint k = 0;
+	for(GLuint i=0; i!=op.count; ++i)
+	{
+		GLuint index;
+		if(op.Indexed())
+			index = GLuint(indices[op.first+i]);
+		else index = op.first+i;
+		if(index == op.restart_index)
+		{
+			k = 0;
+			continue;
+		}
+		index += GLuint(op.BaseVertex());
+		if(op.mode == PrimitiveType::Triangles)
+		{
+			v[k%3] = index;
+			if(k%3 == 2)
+				dest.insert(dest.end(), v, v+3);
+		}
+		else if(k < 2) v[k] = index;
+		else
+		{
+			GLuint t[3] = {v[0], v[1], index};
+			// odd triangles in a strip have reversed winding
+			if((op.mode == PrimitiveType::TriangleStrip) && (k%2))
+				std::swap(t[0], t[1]);
+			if((t[0]!=t[1]) && (t[1]!=t[2]) && (t[0]!=t[2]))
+				dest.insert(dest.end(), t, t+3);
+			if(op.mode == PrimitiveType::TriangleStrip)
+				v[0] = v[1];
+			v[1] = index;
+		}
+		++k;
+	}
+}
+
+} // namespace aux
+
+namespace shapes {
+
+/// Statistics describing the efficiency of the post-transform vertex cache
+/**
+ *  @see AnalyzeVertexCache
+ */
+struct VertexCacheStatistics
+{
+	/// The number of triangles
+	GLuint triangle_count;
+
+	/// The number of distinct vertices referenced by the triangles
+	GLuint vertex_count;
+
+	/// The number of vertex shader invocations (cache misses)
+	GLuint transform_count;
+
+	/// Average cache miss ratio (transformed vertices per triangle)
+	/** The value is between 0.5 (ideal for large regular meshes)
+	 *  and 3.0 (each vertex of each triangle is transformed).
+	 */
+	double ACMR(void) const
+	{
+		return triangle_count?
+			double(transform_count)/double(triangle_count):
+			0.0;
+	}
+
+	/// Average transform to vertex ratio (1.0 is the optimum)
+	double ATVR(void) const
+	{
+		return vertex_count?
+			double(transform_count)/double(vertex_count):
+			0.0;
+	}
+};
+
+/// Simulates a FIFO vertex cache of the specified size with a triangle list
+/** The @p triangles contain three indices for each triangle.
+ *  The results are only an approximation of the behavior of the real
+ *  hardware, but they are suitable for comparing different orderings
+ *  of the same triangles.
+ *
+ *  @see OptimizeVertexCache
+ */
+VertexCacheStatistics AnalyzeVertexCache(
+	const std::vector<GLuint>& triangles,
+	unsigned cache_size = 16
+);
+
+/// Reorders the triangles of a triangle list to improve the vertex cache use
+/** This function uses T. Forsyth's "Linear-speed vertex cache optimisation"
+ *  algorithm, which greedily picks the triangles referencing the recently
+ *  used vertices and the vertices with few remaining triangles,
+ *  with an LRU cache of @p cache_size entries.
+ *  The winding of the individual triangles is preserved.
+ *
+ *  @pre triangles.size() % 3 == 0
+ *  @pre all indices are less than @p vertex_count
+ *
+ *  @see OptimizeVertexFetch
+ *  @see AnalyzeVertexCache
+ */
+void OptimizeVertexCache(
+	std::vector<GLuint>& triangles,
+	GLuint vertex_count,
+	unsigned cache_size = 32
+);
+
+/// Renumbers the vertices in the order in which they are used by @p indices
+/** This makes the access to the vertex attribute arrays more coherent.
+ *  The @p indices are remapped in place; the values which are not less
+ *  than @p vertex_count (like primitive restart indices) are left
+ *  unchanged. The returned array contains the original index of each
+ *  of the renumbered vertices, i.e. the vertex attributes must be
+ *  reordered so that the i-th vertex is the vertex previously
+ *  at position @c result[i]. The vertices not referenced by @p indices
+ *  are moved to the end.
+ *
+ *  @see OptimizeVertexCache
+ */
+std::vector<GLuint> OptimizeVertexFetch(
+	std::vector<GLuint>& indices,
+	GLuint vertex_count
+);
+
+/// Shape builder wrapper optimizing the vertex order of another builder
+/** VertexCacheOptimized converts the triangle strips and fans and
+ *  the triangle lists (indexed or not) drawn by the instructions of
+ *  the wrapped @c ShapeBuilder into indexed triangle lists and reorders them
+ *  with OptimizeVertexCache, and then renumbers the vertices with
+ *  OptimizeVertexFetch. All the vertex attributes of the wrapped builder
+ *  are reordered accordingly. The drawing operations with other primitive
+ *  types are kept, only their indices are remapped. The phases
+ *  of the drawing operations are preserved.
+ *
+ *  Instances of this class can be used with ShapeWrapper like any other
+ *  shape builder:
+ *  @code
+ *  shapes::ShapeWrapper torus(
+ *      {"Position", "Normal"},
+ *      shapes::VertexCacheOptimized<shapes::Torus>(shapes::Torus()),
+ *      prog
+ *  );
+ *  @endcode
+ */
+template <class ShapeBuilder>
+class VertexCacheOptimized
+ : public DrawingInstructionWriter
+{
+private:
+	ShapeBuilder _builder;
+	std::vector<GLuint> _order;
+	std::vector<GLuint> _indices;
+	std::vector<DrawOperation> _ops;
+
+	template <typename IT>
+	void _append_other(const DrawOperation& op, const std::vector<IT>& indices)
+	{
+		for(GLuint i=0; i!=op.count; ++i)
+		{
+			if(op.Indexed())
+			{
+				GLuint index = GLuint(indices[op.first+i]);
+				if(index != op.restart_index)
+					index += GLuint(op.BaseVertex());
+				_indices.push_back(index);
+			}
+			else _indices.push_back(op.first+i);
+		}
+	}
+
+	void _init(void)
+	{
+		std::vector<GLfloat> positions;
+		const GLuint npv = _builder.Positions(positions);
+		const GLuint vertex_count = GLuint(positions.size() / npv);
+		const typename ShapeBuilder::IndexArray indices =
+			_builder.Indices();
+		const DrawingInstructions instr = _builder.Instructions();
+		auto i = instr.Operations().begin(), e = instr.Operations().end();
+		while(i != e)
+		{
+			DrawOperation op = *i;
+			const GLuint first = GLuint(_indices.size());
+			if(	(op.mode == PrimitiveType::Triangles) ||
+				(op.mode == PrimitiveType::TriangleStrip) ||
+				(op.mode == PrimitiveType::TriangleFan)
+			)
+			{
+				std::vector<GLuint> triangles;
+				aux::AppendShapeTriangles(triangles, op, indices);
+				OptimizeVertexCache(triangles, vertex_count);
+				_indices.insert(
+					_indices.end(),
+					triangles.begin(),
+					triangles.end()
+				);
+				op.mode = PrimitiveType::Triangles;
+				op.restart_index = DrawOperation::NoRestartIndex();
+			}
+			else _append_other(op, indices);
+			op.method = DrawOperation::Method::DrawElements;
+			op.base_vertex = 0;
+			op.first = first;
+			op.count = GLuint(_indices.size()) - first;
+			_ops.push_back(op);
+			++i;
+		}
+		_order = OptimizeVertexFetch(_indices, vertex_count);
+	}
+
+	template <typename T>
+	void _reorder(std::vector<T>& values, GLuint values_per_vertex) const
+	{
+		assert(values.size() == _order.size()*values_per_vertex);
+		std::vector<T> result(values.size());
+		auto p = result.begin();
+		for(auto i=_order.begin(), e=_order.end(); i!=e; ++i)
+		{
+			auto b = values.begin() + (*i)*values_per_vertex;
+			p = std::copy(b, b+values_per_vertex, p);
+		}
+		values.swap(result);
+	}
+public:
+	/// Wraps and optimizes a copy of the specified @p builder
+	VertexCacheOptimized(const ShapeBuilder& builder)
+	 : _builder(builder)
+	{
+		_init();
+	}
+
+	/// Returns the wrapped builder
+	const ShapeBuilder& Builder(void) const
+	{
+		return _builder;
+	}
+
+	/// Returns the winding direction of faces
+	FaceOrientation FaceWinding(void) const
+	{
+		return _builder.FaceWinding();
+	}
+
+	/// Makes vertex coordinates and returns number of values per vertex
+	OGLPLUS_SHAPES_HLPR_PROCESS_VERT_ATTR(Positions, _reorder)
+	/// Makes vertex normals and returns number of values per vertex
+	OGLPLUS_SHAPES_HLPR_PROCESS_VERT_ATTR(Normals, _reorder)
+	/// Makes vertex tangents and returns number of values per vertex
+	OGLPLUS_SHAPES_HLPR_PROCESS_VERT_ATTR(Tangents, _reorder)
+	/// Makes vertex bi-tangents and returns number of values per vertex
+	OGLPLUS_SHAPES_HLPR_PROCESS_VERT_ATTR(Bitangents, _reorder)
+	/// Makes texture coordinates and returns number of values per vertex
+	OGLPLUS_SHAPES_HLPR_PROCESS_VERT_ATTR(TexCoordinates, _reorder)
+	/// Makes material numbers and returns number of values per vertex
+	OGLPLUS_SHAPES_HLPR_PROCESS_VERT_ATTR(MaterialNumbers, _reorder)
+
+	/// Vertex attribute information for this shape builder
+	/** This builder provides the same vertex attributes as
+	 *  the wrapped @c ShapeBuilder.
+	 */
+	typedef VertexAttribsInfo<
+		VertexCacheOptimized,
+		typename VertexAttribsTags<
+			typename ShapeBuilder::VertexAttribs
+		>::type
+	> VertexAttribs;
+
+	/// Queries the bounding sphere coordinates and dimensions
+	template <typename T>
+	void BoundingSphere(oglplus::Sphere<T>& bounding_sphere) const
+	{
+		_builder.BoundingSphere(bounding_sphere);
+	}
+
+	/// The type of index container returned by Indices()
+	typedef std::vector<GLuint> IndexArray;
+
+	/// Returns element indices that are used with the drawing instructions
+	const IndexArray& Indices(void) const
+	{
+		return _indices;
+	}
+
+	/// Returns the instructions for rendering
+	DrawingInstructions Instructions(void) const
+	{
+		auto ops = _ops;
+		return this->MakeInstructions(std::move(ops));
+	}
+};
+
+} // shapes
+} // oglplus
+
+#if !OGLPLUS_LINK_LIBRARY || defined(OGLPLUS_IMPLEMENTING_LIBRARY)
+#include <oglplus/shapes/vertex_cache.ipp>
+#endif // OGLPLUS_LINK_LIBRARY
+
+#endif // include guard
@@ -0,0 +1,189 @@
+/**
+ *  @file oglplus/shapes/vertex_layout.hpp
+ *  @brief Layout and formats of the vertex attributes stored by ShapeWrapper
+ *
+ *  @author Matus Chochlik
+ *
+ *  Copyright 2010-2013 Matus Chochlik. Distributed under the Boost
+ *  Software License, Version 1.0. (See accompanying file
+ *  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ */
+
+#pragma once
+#ifndef OGLPLUS_SHAPES_VERTEX_LAYOUT_1310241130_HPP
+#define OGLPLUS_SHAPES_VERTEX_LAYOUT_1310241130_HPP
+
+#include <oglplus/config.hpp>
+#include <oglplus/enumerations.hpp>
+#include <oglplus/data_type.hpp>
+#include <oglplus/string.hpp>
+
+#include <vector>
+#include <utility>
+
+namespace oglplus {
+namespace aux {
+
+// Converts a single precision float to the IEEE 754 half precision format
+GLushort FloatToHalf(GLfloat value);
+
+// Converts a half precision value to a single precision float
+GLfloat HalfToFloat(GLushort value);
+
+// Converts a value in the range [-1, 1] to a signed normalized integer
+// with the specified number of bits
+GLint FloatToSnorm(GLfloat value, unsigned bits);
+
+// Packs up to four values in the range [-1, 1] into a single integer
+// in the INT_2_10_10_10_REV format. The missing components are zero.
+GLuint PackSnorm2101010Rev(const GLfloat* values, GLuint count);
+
+} // namespace aux
+
+/// Enumeration of the formats of vertex attributes stored by shape wrappers
+OGLPLUS_ENUM_CLASS_BEGIN(ShapeVertexAttribFormat, GLuint)
+	OGLPLUS_ENUM_CLASS_VALUE(Float, 0)
+	OGLPLUS_ENUM_CLASS_COMMA
+	OGLPLUS_ENUM_CLASS_VALUE(HalfFloat, 1)
+	OGLPLUS_ENUM_CLASS_COMMA
+	OGLPLUS_ENUM_CLASS_VALUE(Int_2_10_10_10_Rev, 2)
+	OGLPLUS_ENUM_CLASS_COMMA
+	OGLPLUS_ENUM_CLASS_VALUE(NormalizedShort, 3)
+OGLPLUS_ENUM_CLASS_END(ShapeVertexAttribFormat)
+
+namespace shapes {
+
+/// Describes how ShapeWrapper stores the vertex attributes of a shape
+/** By default (or with the @c Separate layout) each vertex attribute
+ *  is stored in its own buffer as 32-bit floats. The @c Interleaved
+ *  and @c Packed layouts store all attributes in a single buffer,
+ *  with the values of all attributes of a vertex next to each other.
+ *  In the interleaved layouts the attributes can also be stored
+ *  in the following more compact formats:
+ *
+ *  - @c Float - 32-bit floats,
+ *  - @c HalfFloat - 16-bit floats,
+ *  - @c Int_2_10_10_10_Rev - up to four components with values
+ *    in the range [-1, 1] packed into a single 32-bit integer
+ *    (10 bits for x, y and z and 2 bits for w). Suitable for
+ *    the normals, tangents and bitangents,
+ *  - @c NormalizedShort - 16-bit signed normalized integers,
+ *    suitable only for values in the range [-1, 1].
+ *
+ *  Each attribute is aligned to four bytes.
+ *  The integer formats are fed to the shaders as normalized floats.
+ *
+ *  @code
+ *  shapes::ShapeWrapper torus(
+ *      {"Position", "Normal", "TexCoord"},
+ *      shapes::Torus(),
+ *      shapes::VertexLayout::Packed(),
+ *      prog
+ *  );
+ *  @endcode
+ *
+ *  @see ShapeWrapper
+ */
+class VertexLayout
+{
+public:
+	/// The attribute format enumeration
+	typedef oglplus::ShapeVertexAttribFormat Format;
+private:
+	bool _interleaved;
+	Format _default_format;
+	std::vector<std::pair<String, Format>> _formats;
+
+	VertexLayout(bool interleaved)
+	 : _interleaved(interleaved)
+	 , _default_format(Format::Float)
+	{ }
+public:
+	/// Constructs the default layout storing attributes in separate buffers
+	VertexLayout(void)
+	 : _interleaved(false)
+	 , _default_format(Format::Float)
+	{ }
+
+	/// Returns a layout storing each attribute in a separate float buffer
+	static VertexLayout Separate(void)
+	{
+		return VertexLayout(false);
+	}
+
+	/// Returns a layout storing all float attributes in a single buffer
+	static VertexLayout Interleaved(void)
+	{
+		return VertexLayout(true);
+	}
+
+	/// Returns an interleaved layout with compact attribute formats
+	/** The positions and texture coordinates are stored as half floats,
+	 *  the normals, tangents and bitangents in the @c Int_2_10_10_10_Rev
+	 *  format and the other attributes (like the material numbers)
+	 *  as floats.
+	 */
+	static VertexLayout Packed(void);
+
+	/// Returns true if the attributes are stored in a single buffer
+	bool IsInterleaved(void) const
+	{
+		return _interleaved;
+	}
+
+	/// Sets the format of the attribute with the specified @p name
+	/** The formats are ignored by the @c Separate layout.
+	 */
+	VertexLayout& AttribFormat(const String& name, Format format);
+
+	/// Sets the format of the attributes without an explicit format
+	VertexLayout& DefaultFormat(Format format)
+	{
+		_default_format = format;
+		return *this;
+	}
+
+	/// Returns the format of the attribute with the specified @p name
+	/** If the GL implementation does not support the @c Int_2_10_10_10_Rev
+	 *  vertex attribute type, then @c NormalizedShort is returned instead.
+	 */
+	Format AttribFormat(const String& name) const;
+
+	/// Returns the number of components passed to VertexAttribPointer
+	static GLint ValuesPerVertex(Format format, GLuint values_per_vertex);
+
+	/// Returns the data type passed to VertexAttribPointer
+	static DataType FormatDataType(Format format);
+
+	/// Returns true if the format is a normalized integer format
+	static bool Normalized(Format format);
+
+	/// Returns the size in bytes of the values of an attribute of a vertex
+	/** The size is rounded up to a multiple of four bytes.
+	 */
+	static GLuint Size(Format format, GLuint values_per_vertex);
+
+	/// Converts and stores an array of float attribute values
+	/** Converts @p count vertices with @p values_per_vertex values each
+	 *  from @p source to the specified @p format and stores them into
+	 *  @p dest, with the values of the consecutive vertices @p stride
+	 *  bytes apart.
+	 */
+	static void Pack(
+		Format format,
+		GLuint values_per_vertex,
+		const GLfloat* source,
+		GLuint count,
+		GLubyte* dest,
+		GLuint stride
+	);
+};
+
+} // shapes
+} // oglplus
+
+#if !OGLPLUS_LINK_LIBRARY || defined(OGLPLUS_IMPLEMENTING_LIBRARY)
+#include <oglplus/shapes/vertex_layout.ipp>
+#endif // OGLPLUS_LINK_LIBRARY
+
+#endif // include guard
@@ -27,6 +27,7 @@
 
 #include <oglplus/shapes/draw.hpp>
 #include <oglplus/shapes/vert_attr_info.hpp>
+#include <oglplus/shapes/vertex_layout.hpp>
 
 #include <vector>
 #include <functional>
@@ -52,55 +53,138 @@ protected:
 	// A vertex array object for the rendered shape
 	Optional<VertexArray> _vao;
 
-	// VBOs for the shape's vertex attributes
+	// A buffer with the commands for indirect drawing, if used
+	Optional<Buffer> _indirect;
+
+	// VBOs for the shape's vertex attributes, or a single VBO
+	// for all attributes if they are interleaved
 	Array<Buffer> _vbos;
 
 	// numbers of values per vertex for the individual attributes
 	std::vector<GLuint> _npvs;
 
+	// formats and offsets of the interleaved attributes
+	std::vector<ShapeVertexAttribFormat> _formats;
+	std::vector<GLuint> _offsets;
+
+	// the size of the interleaved vertex data, zero if not interleaved
+	GLuint _stride;
+
 	// names of the individual vertex attributes
 	std::vector<String> _names;
 
 	// the origin and radius of the bounding sphere
 	Spheref _bounding_sphere;
 
-	template <class ShapeBuilder, class ShapeIndices, typename Iterator>
-	void _init(
+	void _prepare_draw(void) const
+	{
+		_gl.FrontFace(_face_winding);
+		if(_indirect.IsInitialized())
+			_indirect.Bind(Buffer::Target::DrawIndirect);
+	}
+
+	static std::size_t _vbo_count(
+		std::size_t attrib_count,
+		const VertexLayout& layout
+	)
+	{
+		return (layout.IsInterleaved()?1:attrib_count)+1;
+	}
+
+	template <class ShapeBuilder, typename Iterator>
+	void _init_interleaved(
 		const ShapeBuilder& builder,
-		const ShapeIndices& shape_indices,
 		Iterator name,
-		Iterator end
+		Iterator end,
+		const VertexLayout& layout
 	)
 	{
-		VertexArray::Unbind();
 		typename ShapeBuilder::VertexAttribs vert_attr_info;
+		std::vector<std::vector<GLfloat>> data(_names.size());
+		GLuint vertex_count = 0;
 		unsigned i = 0;
-		std::vector<GLfloat> data;
 		while(name != end)
 		{
 			auto getter = vert_attr_info.VertexAttribGetter(
-				data,
+				data[i],
 				*name
 			);
 			if(getter != nullptr)
 			{
-				_vbos[i].Bind(Buffer::Target::Array);
-				_npvs[i] = getter(builder, data);
+				_npvs[i] = getter(builder, data[i]);
 				_names[i] = *name;
-
-				Buffer::Data(Buffer::Target::Array, data);
+				_formats[i] = layout.AttribFormat(_names[i]);
+				_offsets[i] = _stride;
+				_stride += VertexLayout::Size(_formats[i], _npvs[i]);
+				vertex_count = GLuint(data[i].size() / _npvs[i]);
 			}
 			++name;
 			++i;
 		}
 
+		std::vector<GLubyte> buffer(_stride*vertex_count);
+		for(i=0; i!=_names.size(); ++i)
+		{
+			if(_npvs[i] == 0) continue;
+			assert(data[i].size() == _npvs[i]*vertex_count);
+			VertexLayout::Pack(
+				_formats[i],
+				_npvs[i],
+				data[i].data(),
+				vertex_count,
+				buffer.data()+_offsets[i],
+				_stride
+			);
+		}
+		_vbos[0].Bind(Buffer::Target::Array);
+		Buffer::Data(Buffer::Target::Array, buffer);
+	}
+
+	template <class ShapeBuilder, class ShapeIndices, typename Iterator>
+	void _init(
+		const ShapeBuilder& builder,
+		const ShapeIndices& shape_indices,
+		Iterator name,
+		Iterator end,
+		const VertexLayout& layout
+	)
+	{
+		VertexArray::Unbind();
+		unsigned i = unsigned(_names.size());
+		if(layout.IsInterleaved())
+		{
+			_init_interleaved(builder, name, end, layout);
+		}
+		else
+		{
+			typename ShapeBuilder::VertexAttribs vert_attr_info;
+			std::vector<GLfloat> data;
+			i = 0;
+			while(name != end)
+			{
+				auto getter = vert_attr_info.VertexAttribGetter(
+					data,
+					*name
+				);
+				if(getter != nullptr)
+				{
+					_vbos[i].Bind(Buffer::Target::Array);
+					_npvs[i] = getter(builder, data);
+					_names[i] = *name;
+
+					Buffer::Data(Buffer::Target::Array, data);
+				}
+				++name;
+				++i;
+			}
+		}
+
 		if(!shape_indices.empty())
 		{
 			assert((i+1) == _npvs.size());
-			assert((i+1) == _vbos.size());
 
 			_npvs[i] = 1;
-			_vbos[i].Bind(Buffer::Target::ElementArray);
+			_vbos[_vbos.size()-1].Bind(Buffer::Target::ElementArray);
 			Buffer::Data(
 				Buffer::Target::ElementArray,
 				shape_indices
@@ -114,19 +198,26 @@ public:
 	ShapeWrapperBase(
 		Iterator names_begin,
 		Iterator names_end,
-		const ShapeBuilder& builder
+		const ShapeBuilder& builder,
+		const VertexLayout& layout = VertexLayout()
 	): _face_winding(builder.FaceWinding())
 	 , _shape_instr(builder.Instructions())
 	 , _index_info(builder)
-	 , _vbos(std::distance(names_begin, names_end)+1)
+	 , _vbos(_vbo_count(std::distance(names_begin, names_end), layout))
 	 , _npvs(std::distance(names_begin, names_end)+1, 0)
+	 , _formats(
+		std::distance(names_begin, names_end),
+		ShapeVertexAttribFormat::Float
+	), _offsets(std::distance(names_begin, names_end), 0)
+	 , _stride(0)
 	 , _names(std::distance(names_begin, names_end))
 	{
 		this->_init(
 			builder,
 			builder.Indices(),
 			names_begin,
-			names_end
+			names_end,
+			layout
 		);
 	}
 
@@ -136,19 +227,26 @@ public:
 		Iterator names_end,
 		const ShapeBuilder& builder,
 		const ShapeIndices& shape_indices,
-		shapes::DrawingInstructions&& shape_instr
+		shapes::DrawingInstructions&& shape_instr,
+		const VertexLayout& layout = VertexLayout()
 	): _face_winding(builder.FaceWinding())
 	 , _shape_instr(std::move(shape_instr))
 	 , _index_info(builder)
-	 , _vbos(std::distance(names_begin, names_end)+1)
+	 , _vbos(_vbo_count(std::distance(names_begin, names_end), layout))
 	 , _npvs(std::distance(names_begin, names_end)+1, 0)
+	 , _formats(
+		std::distance(names_begin, names_end),
+		ShapeVertexAttribFormat::Float
+	), _offsets(std::distance(names_begin, names_end), 0)
+	 , _stride(0)
 	 , _names(std::distance(names_begin, names_end))
 	{
 		this->_init(
 			builder,
 			shape_indices,
 			names_begin,
-			names_end
+			names_end,
+			layout
 		);
 	}
 
@@ -158,8 +256,12 @@ public:
 	 , _index_info(temp._index_info)
 	 , _gl(std::move(temp._gl))
 	 , _vao(std::move(temp._vao))
+	 , _indirect(std::move(temp._indirect))
 	 , _vbos(std::move(temp._vbos))
 	 , _npvs(std::move(temp._npvs))
+	 , _formats(std::move(temp._formats))
+	 , _offsets(std::move(temp._offsets))
+	 , _stride(temp._stride)
 	 , _names(std::move(temp._names))
 	{ }
 
@@ -183,6 +285,39 @@ public:
 		_vao.Bind();
 	}
 
+	/// Makes the shape drawn by commands stored in a draw indirect buffer
+	/** The instructions of the shape are replaced by instructions
+	 *  reading their parameters from the IndirectBuffer(), which is
+	 *  initialized with commands drawing @p inst_count instances
+	 *  starting at @p base_inst. After this the instance counts
+	 *  passed to Draw are ignored and the commands in the buffer
+	 *  can be updated by the GL (for example by a compute shader)
+	 *  without any round-trips to the client.
+	 *
+	 *  @see DrawingInstructions::IndirectInstructions
+	 *
+	 *  @pre !IsIndirect()
+	 */
+	void UseIndirect(GLuint inst_count = 1, GLuint base_inst = 0);
+
+	/// Returns true if the shape is drawn by indirect commands
+	bool IsIndirect(void) const
+	{
+		return _indirect.IsInitialized();
+	}
+
+	/// Returns the buffer with the commands for indirect drawing
+	/**
+	 *  @see UseIndirect
+	 *
+	 *  @pre IsIndirect()
+	 */
+	const Buffer& IndirectBuffer(void) const
+	{
+		assert(IsIndirect());
+		return _indirect;
+	}
+
 	FaceOrientation FaceWinding(void) const
 	{
 		return _face_winding;
@@ -190,25 +325,25 @@ public:
 
 	void Draw(void) const
 	{
-		_gl.FrontFace(_face_winding);
+		_prepare_draw();
 		_shape_instr.Draw(_index_info, 1, 0);
 	}
 
 	void Draw(GLuint inst_count) const
 	{
-		_gl.FrontFace(_face_winding);
+		_prepare_draw();
 		_shape_instr.Draw(_index_info, inst_count, 0);
 	}
 
 	void Draw(GLuint inst_count, GLuint base_inst) const
 	{
-		_gl.FrontFace(_face_winding);
+		_prepare_draw();
 		_shape_instr.Draw(_index_info, inst_count, base_inst);
 	}
 
 	void Draw(const std::function<bool (GLuint)>& drawing_driver) const
 	{
-		_gl.FrontFace(_face_winding);
+		_prepare_draw();
 		_shape_instr.Draw(_index_info, 1, 0, drawing_driver);
 	}
 
@@ -244,6 +379,25 @@ public:
 		UseInProgram(prog);
 	}
 
+	template <typename StdRange, class ShapeBuilder>
+	ShapeWrapper(
+		const StdRange& names,
+		const ShapeBuilder& builder,
+		const VertexLayout& layout
+	): ShapeWrapperBase(names.begin(), names.end(), builder, layout)
+	{ }
+
+	template <typename StdRange, class ShapeBuilder>
+	ShapeWrapper(
+		const StdRange& names,
+		const ShapeBuilder& builder,
+		const VertexLayout& layout,
+		const ProgramOps& prog
+	): ShapeWrapperBase(names.begin(), names.end(), builder, layout)
+	{
+		UseInProgram(prog);
+	}
+
 #if !OGLPLUS_NO_INITIALIZER_LISTS
 	template <class ShapeBuilder>
 	ShapeWrapper(
@@ -261,6 +415,25 @@ public:
 	{
 		UseInProgram(prog);
 	}
+
+	template <class ShapeBuilder>
+	ShapeWrapper(
+		const std::initializer_list<const GLchar*>& names,
+		const ShapeBuilder& builder,
+		const VertexLayout& layout
+	): ShapeWrapperBase(names.begin(), names.end(), builder, layout)
+	{ }
+
+	template <class ShapeBuilder>
+	ShapeWrapper(
+		const std::initializer_list<const GLchar*>& names,
+		const ShapeBuilder& builder,
+		const VertexLayout& layout,
+		const ProgramOps& prog
+	): ShapeWrapperBase(names.begin(), names.end(), builder, layout)
+	{
+		UseInProgram(prog);
+	}
 #endif
 
 	template <class ShapeBuilder>
@@ -0,0 +1,420 @@
+/**
+ *  @file oglplus/state_cache.hpp
+ *  @brief Shadow copy of the GL state used to skip redundant state changes
+ *
+ *  @author Matus Chochlik
+ *
+ *  Copyright 2010-2013 Matus Chochlik. Distributed under the Boost
+ *  Software License, Version 1.0. (See accompanying file
+ *  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ */
+
+#pragma once
+#ifndef OGLPLUS_STATE_CACHE_1311061420_HPP
+#define OGLPLUS_STATE_CACHE_1311061420_HPP
+
+#include <oglplus/config.hpp>
+#include <oglplus/gl.hpp>
+
+#include <cstddef>
+#include <cstring>
+#include <vector>
+
+#if !OGLPLUS_NO_THREADS
+#include <atomic>
+#endif
+
+namespace oglplus {
+namespace aux {
+
+struct StateCacheKey
+{
+	// the kinds of the cached state values
+	enum Kind
+	{
+		Program,
+		VertexArray,
+		Buffer,
+		ActiveTexture,
+		Texture,
+		Sampler,
+		Capability,
+		BlendEquation,
+		BlendFunc,
+		BlendColor,
+		DepthFunc,
+		DepthMask,
+		StencilFunc,
+		StencilOp,
+		Viewport,
+		KindCount
+	};
+
+	Kind kind;
+	GLenum target;
+	GLuint index;
+};
+
+struct StateCacheValue
+{
+	GLint values[4];
+
+	friend bool operator == (
+		const StateCacheValue& a,
+		const StateCacheValue& b
+	)
+	{
+		return	(a.values[0] == b.values[0]) &&
+			(a.values[1] == b.values[1]) &&
+			(a.values[2] == b.values[2]) &&
+			(a.values[3] == b.values[3]);
+	}
+};
+
+// floating-point state values are compared bitwise
+inline GLint StateCacheBits(GLfloat value)
+{
+	static_assert(sizeof(GLint) == sizeof(GLfloat), "Unexpected size");
+	GLint result;
+	std::memcpy(&result, &value, sizeof(result));
+	return result;
+}
+
+class StateChange;
+class TextureBindingChange;
+
+} // namespace aux
+
+/// Shadow copy of the GL context state used to skip redundant state changes
+/** When an instance of StateCache is made current, the object binds
+ *  (Program::Use, VertexArray::Bind, Buffer::Bind, Texture::Active,
+ *  Texture::Bind, Sampler::Bind) and the context state setters
+ *  (Enable/Disable, blend equation and function, blend color, depth
+ *  function and mask, stencil function and operation, viewport) first
+ *  compare the new value with the cached one and skip the call to GL
+ *  if they are equal. The active texture unit and the enabled capabilities
+ *  are also returned from the cache if known.
+ *
+ *  Only the values set through @OGLplus are tracked. If the GL state
+ *  is changed by other means (by direct calls to GL or by other libraries)
+ *  then the cache must be invalidated. Each GL context should have its
+ *  own cache which should be made current together with the context.
+ *
+ *  @code
+ *  StateCache state_cache;
+ *  state_cache.MakeCurrent();
+ *  ...
+ *  vao.Bind();
+ *  vao.Bind(); // does not call glBindVertexArray
+ *  ...
+ *  std::cout << state_cache.Hits() << " redundant changes skipped";
+ *  @endcode
+ *
+ *  The cache can be disabled entirely at compile-time by setting
+ *  the #OGLPLUS_NO_STATE_CACHE preprocessor symbol to a nonzero value.
+ *
+ *  @ingroup utility_classes
+ */
+class StateCache
+{
+private:
+	// a cached value of a state of some kind for a target and index
+	struct _entry
+	{
+		GLenum target;
+		GLuint index;
+		aux::StateCacheValue value;
+	};
+
+	// there are only a few values of each kind set at the same time
+	// so they are kept in small flat arrays searched linearly
+	typedef std::vector<_entry> _entries;
+	_entries _state[aux::StateCacheKey::KindCount];
+	std::size_t _hits, _misses;
+	std::size_t _id;
+
+	static std::size_t _next_id(void);
+
+	// returns the position of the entry or entries.size() if not found
+	static std::size_t _find_entry(
+		const _entries& entries,
+		const aux::StateCacheKey& key
+	)
+	{
+		std::size_t i = 0, n = entries.size();
+		while(i != n)
+		{
+			const _entry& entry = entries[i];
+			if((entry.target == key.target) && (entry.index == key.index))
+				break;
+			++i;
+		}
+		return i;
+	}
+
+	static StateCache*& _current(void);
+
+	friend class aux::StateChange;
+	friend class aux::TextureBindingChange;
+
+	bool _is_redundant(
+		const aux::StateCacheKey& key,
+		const aux::StateCacheValue& value
+	);
+
+	void _record(
+		const aux::StateCacheKey& key,
+		const aux::StateCacheValue& value
+	);
+
+	bool _find(
+		const aux::StateCacheKey& key,
+		aux::StateCacheValue& value
+	) const;
+
+	void _forget(const aux::StateCacheKey& key);
+
+	void _forget_all(aux::StateCacheKey::Kind kind);
+	void _forget_all(aux::StateCacheKey::Kind kind, GLenum target);
+public:
+	/// Creates an empty state cache
+	StateCache(void)
+	 : _hits(0)
+	 , _misses(0)
+	 , _id(_next_id())
+	{ }
+
+#if !OGLPLUS_NO_DELETED_FUNCTIONS
+	StateCache(const StateCache&) = delete;
+	StateCache& operator = (const StateCache&) = delete;
+#else
+private:
+	StateCache(const StateCache&);
+	StateCache& operator = (const StateCache&);
+public:
+#endif
+
+	/// If this cache is current then no cache is made current
+	~StateCache(void)
+	{
+		if(_current() == this) _current() = nullptr;
+	}
+
+	/// Makes this state cache current
+	/** This function should be called when the GL context
+	 *  whose state is shadowed by this cache is made current.
+	 */
+	void MakeCurrent(void)
+	{
+		_current() = this;
+	}
+
+	/// Makes no state cache current, all changes go to GL
+	static void MakeNoneCurrent(void)
+	{
+		_current() = nullptr;
+	}
+
+	/// Returns a pointer to the current state cache or nullptr
+	static StateCache* Current(void)
+	{
+		return _current();
+	}
+
+	/// Returns a nonzero number identifying this cache and its context
+	/** Unlike the address of the cache, the identifier is not reused
+	 *  by other instances of StateCache.
+	 */
+	std::size_t Id(void) const
+	{
+		return _id;
+	}
+
+	/// Forgets all cached values
+	/** This function should be called after the GL state has been
+	 *  changed by other means than through @OGLplus.
+	 */
+	void Invalidate(void)
+	{
+		for(std::size_t k=0; k!=aux::StateCacheKey::KindCount; ++k)
+			_state[k].clear();
+	}
+
+	/// Forgets the cached bindings of the objects with the specified names
+	/** This function is called automatically when @OGLplus objects
+	 *  are deleted.
+	 */
+	void ForgetNames(GLsizei count, const GLuint* names);
+
+	/// Returns the number of state changes skipped so far
+	std::size_t Hits(void) const
+	{
+		return _hits;
+	}
+
+	/// Returns the number of state changes that were passed to GL
+	std::size_t Misses(void) const
+	{
+		return _misses;
+	}
+
+	/// Resets the hit and miss counters
+	void ResetCounters(void)
+	{
+		_hits = 0;
+		_misses = 0;
+	}
+};
+
+namespace aux {
+
+#if !OGLPLUS_NO_STATE_CACHE
+// A change of a value of the GL state going through the current cache
+class StateChange
+{
+protected:
+	StateCache* _cache;
+	StateCacheKey _key;
+	StateCacheValue _value;
+public:
+	StateChange(
+		StateCacheKey::Kind kind,
+		GLenum target,
+		GLuint index,
+		GLint v0,
+		GLint v1 = 0,
+		GLint v2 = 0,
+		GLint v3 = 0
+	): _cache(StateCache::Current())
+	{
+		// without a current cache the key and the value are not used
+		if(!_cache) return;
+		_key.kind = kind;
+		_key.target = target;
+		_key.index = index;
+		_value.values[0] = v0;
+		_value.values[1] = v1;
+		_value.values[2] = v2;
+		_value.values[3] = v3;
+	}
+
+	// returns true if the value is already set and the change can be skipped
+	bool Redundant(void) const
+	{
+		return _cache && _cache->_is_redundant(_key, _value);
+	}
+
+	// stores the value after the change was done
+	void Done(void) const
+	{
+		if(_cache) _cache->_record(_key, _value);
+	}
+
+	// forgets the value when the change cannot be tracked exactly
+	void Forget(void) const
+	{
+		if(_cache) _cache->_forget(_key);
+	}
+
+	// forgets all cached values of the specified kind
+	static void ForgetAll(StateCacheKey::Kind kind)
+	{
+		StateCache* cache = StateCache::Current();
+		if(cache) cache->_forget_all(kind);
+	}
+
+	// gets the cached value of the state if known
+	static bool Find(
+		StateCacheKey::Kind kind,
+		GLenum target,
+		GLuint index,
+		GLint& value
+	)
+	{
+		StateCache* cache = StateCache::Current();
+		if(!cache) return false;
+		StateCacheKey key = {kind, target, index};
+		StateCacheValue cached;
+		if(!cache->_find(key, cached)) return false;
+		value = cached.values[0];
+		return true;
+	}
+};
+
+// A change of the texture bound to a target of the active texture unit
+class TextureBindingChange
+ : public StateChange
+{
+public:
+	TextureBindingChange(GLenum target, GLuint name)
+	 : StateChange(StateCacheKey::Texture, target, 0, GLint(name))
+	{
+		if(!_cache) return;
+		GLint unit = 0;
+		if(Find(StateCacheKey::ActiveTexture, 0, 0, unit))
+			_key.index = GLuint(unit);
+		else if(_cache)
+		{
+			// the unit is not known, forget the target on all units
+			_cache->_forget_all(StateCacheKey::Texture, target);
+			_cache = nullptr;
+		}
+	}
+};
+
+inline void StateCacheForgetNames(GLsizei count, const GLuint* names)
+{
+	StateCache* cache = StateCache::Current();
+	if(cache) cache->ForgetNames(count, names);
+}
+#else
+class StateChange
+{
+public:
+	StateChange(
+		StateCacheKey::Kind,
+		GLenum,
+		GLuint,
+		GLint,
+		GLint = 0,
+		GLint = 0,
+		GLint = 0
+	){ }
+
+	bool Redundant(void) const
+	{
+		return false;
+	}
+
+	void Done(void) const { }
+
+	void Forget(void) const { }
+
+	static void ForgetAll(StateCacheKey::Kind) { }
+
+	static bool Find(StateCacheKey::Kind, GLenum, GLuint, GLint&)
+	{
+		return false;
+	}
+};
+
+class TextureBindingChange
+ : public StateChange
+{
+public:
+	TextureBindingChange(GLenum target, GLuint name)
+	 : StateChange(StateCacheKey::Texture, target, 0, GLint(name))
+	{ }
+};
+
+inline void StateCacheForgetNames(GLsizei, const GLuint*) { }
+#endif
+
+} // namespace aux
+} // namespace oglplus
+
+#if !OGLPLUS_LINK_LIBRARY || defined(OGLPLUS_IMPLEMENTING_LIBRARY)
+#include <oglplus/state_cache.ipp>
+#endif // OGLPLUS_LINK_LIBRARY
+
+#endif // include guard
@@ -0,0 +1,297 @@
+/**
+ *  @file oglplus/streaming_buffer.hpp
+ *  @brief Persistently mapped ring buffer for streaming of dynamic data
+ *
+ *  @author Matus Chochlik
+ *
+ *  Copyright 2010-2013 Matus Chochlik. Distributed under the Boost
+ *  Software License, Version 1.0. (See accompanying file
+ *  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ */
+
+#pragma once
+#ifndef OGLPLUS_STREAMING_BUFFER_1311121030_HPP
+#define OGLPLUS_STREAMING_BUFFER_1311121030_HPP
+
+#include <oglplus/config.hpp>
+#include <oglplus/glfunc.hpp>
+#include <oglplus/error.hpp>
+#include <oglplus/buffer.hpp>
+#include <oglplus/sync.hpp>
+
+#include <deque>
+#include <memory>
+#include <cstddef>
+#include <cassert>
+
+namespace oglplus {
+
+#if OGLPLUS_DOCUMENTATION_ONLY || GL_VERSION_4_4 || GL_ARB_buffer_storage
+
+/// A persistently mapped ring buffer for the streaming of dynamic data
+/** StreamingBuffer allocates immutable storage for a buffer, maps it
+ *  persistently and coherently for writing and suballocates aligned
+ *  ranges of it for the data changing every frame (uniform blocks,
+ *  vertices, indirect commands, etc.). The data are written directly
+ *  through the mapping, without the copies made by Buffer::Data or
+ *  Buffer::SubData.
+ *
+ *  The ranges allocated between two calls of EndFrame are protected
+ *  by a single fence. The client waits for a fence only if the ring wraps
+ *  around onto a region that may still be read by the GPU, the number
+ *  of such waits is returned by Stalls.
+ *
+ *  @code
+ *  StreamingBuffer stream(BufferTarget::Uniform, 4*1024*1024);
+ *  while(running)
+ *  {
+ *  	StreamingBuffer::Range r = stream.AllocateUniform(sizeof(Block));
+ *  	*r.Pointer<Block>() = block;
+ *  	stream.BindRange(BufferIndexedTarget::Uniform, 0, r);
+ *  	Draw();
+ *  	stream.EndFrame();
+ *  }
+ *  @endcode
+ *
+ *  @glvoereq{4,4,ARB,buffer_storage}
+ *  @ingroup utility_classes
+ */
+class StreamingBuffer
+{
+public:
+	/// A range of the StreamingBuffer allocated for the current frame
+	class Range
+	{
+	private:
+		GLintptr _offset;
+		GLsizeiptr _size;
+		GLubyte* _data;
+
+		friend class StreamingBuffer;
+
+		Range(GLintptr offset, GLsizeiptr size, GLubyte* data)
+		 : _offset(offset)
+		 , _size(size)
+		 , _data(data)
+		{ }
+	public:
+		/// The offset (in bytes) of the range in the buffer
+		GLintptr Offset(void) const
+		{
+			return _offset;
+		}
+
+		/// The size (in bytes) of the range
+		GLsizeiptr Size(void) const
+		{
+			return _size;
+		}
+
+		/// Returns the pointer to the mapped memory of the range
+		GLubyte* Data(void) const
+		{
+			return _data;
+		}
+
+		/// Returns the pointer to the mapped memory as a pointer to Type
+		template <typename Type>
+		Type* Pointer(void) const
+		{
+			assert(_size >= GLsizeiptr(sizeof(Type)));
+			return reinterpret_cast<Type*>(_data);
+		}
+	};
+private:
+	// a region of the buffer possibly still read by the GPU
+	struct _region
+	{
+		Sync fence;
+		GLuint64 begin;
+		GLuint64 end;
+
+		_region(GLuint64 b, GLuint64 e)
+		 : begin(b)
+		 , end(e)
+		{ }
+
+		_region(_region&& temp)
+		 : fence(std::move(temp.fence))
+		 , begin(temp.begin)
+		 , end(temp.end)
+		{ }
+	};
+
+	Buffer _buffer;
+	BufferTarget _target;
+	GLsizeiptr _size;
+	// the persistent mapping of the whole buffer
+	std::unique_ptr<Buffer::Map> _map;
+	GLubyte* _data;
+	GLsizeiptr _uniform_alignment;
+
+	// the positions in the buffer increase monotonically,
+	// the offset in the buffer is the position modulo _size
+	GLuint64 _head;
+	GLuint64 _frame_begin;
+	std::deque<_region> _regions;
+
+	unsigned _allocations;
+	unsigned _wraps;
+	unsigned _stalls;
+
+	// waits until the regions overlapping the positions before end
+	// in the previous cycle are not used by the GPU anymore
+	void _reclaim(GLuint64 end);
+
+	// binds the buffer with the specified name (possibly 0) to target
+	static void _rebind(BufferTarget target, GLuint name);
+public:
+	/// Creates a streaming buffer of the specified @p size (in bytes)
+	/** The buffer is created and its storage is allocated and mapped
+	 *  for the whole lifetime of the buffer. The buffer is bound to
+	 *  the @p target only temporarily, the previous binding of the target
+	 *  is restored before the constructor returns.
+	 *
+	 *  @glsymbols
+	 *  @glfunref{BufferStorage}
+	 *  @glfunref{MapBufferRange}
+	 *
+	 *  @throws Error
+	 */
+	StreamingBuffer(BufferTarget target, GLsizeiptr size);
+
+	/// Unmaps and destroys the buffer
+	/** The buffer is temporarily bound to the target specified in the
+	 *  constructor for the unmapping, the previous binding is restored.
+	 *
+	 *  @glsymbols
+	 *  @glfunref{UnmapBuffer}
+	 */
+	~StreamingBuffer(void);
+
+#if !OGLPLUS_NO_DELETED_FUNCTIONS
+	StreamingBuffer(const StreamingBuffer&) = delete;
+	StreamingBuffer& operator = (const StreamingBuffer&) = delete;
+#else
+private:
+	StreamingBuffer(const StreamingBuffer&);
+	StreamingBuffer& operator = (const StreamingBuffer&);
+public:
+#endif
+
+	/// Allocates a range of @p size bytes aligned to @p alignment
+	/** The range is valid until the end of the frame. If the range
+	 *  overlaps with a region used by a frame that the GPU may still
+	 *  be processing then this function waits for its fence.
+	 *
+	 *  @throws LimitError if the data of the current frame do not fit
+	 *  into the buffer.
+	 *
+	 *  @glsymbols
+	 *  @glfunref{ClientWaitSync}
+	 */
+	Range Allocate(GLsizeiptr size, GLsizeiptr alignment = 4);
+
+	/// Allocates a range for a uniform block of the specified @p size
+	/** The range is aligned to the value of UNIFORM_BUFFER_OFFSET_ALIGNMENT
+	 *  so that it can be bound to a uniform buffer binding point.
+	 *
+	 *  @see Allocate
+	 */
+	Range AllocateUniform(GLsizeiptr size)
+	{
+		return Allocate(size, _uniform_alignment);
+	}
+
+	/// Allocates a range for @p count instances of Type
+	/** The range is aligned to sizeof(Type), this is suitable for
+	 *  vertex attributes (where the offset of the range can be expressed
+	 *  as the base vertex), indices and indirect draw commands.
+	 *
+	 *  @see Allocate
+	 */
+	template <typename Type>
+	Range AllocateArray(std::size_t count)
+	{
+		return Allocate(GLsizeiptr(count*sizeof(Type)), sizeof(Type));
+	}
+
+	/// Allocates a range and copies @p size bytes from @p data into it
+	/**
+	 *  @see Allocate
+	 */
+	Range Write(
+		const GLvoid* data,
+		GLsizeiptr size,
+		GLsizeiptr alignment = 4
+	);
+
+	/// Fences the ranges allocated since the previous end of a frame
+	/** This function should be called after the commands reading
+	 *  the data of the frame are issued.
+	 *
+	 *  @glsymbols
+	 *  @glfunref{FenceSync}
+	 */
+	void EndFrame(void);
+
+	/// Binds the specified @p range of the buffer to an indexed target
+	/**
+	 *  @glsymbols
+	 *  @glfunref{BindBufferRange}
+	 */
+	void BindRange(
+		BufferIndexedTarget target,
+		GLuint index,
+		const Range& range
+	) const
+	{
+		_buffer.BindRange(target, index, range.Offset(), range.Size());
+	}
+
+	/// Returns the buffer object
+	const Buffer& Object(void) const
+	{
+		return _buffer;
+	}
+
+	/// Returns the size of the buffer in bytes
+	GLsizeiptr Size(void) const
+	{
+		return _size;
+	}
+
+	/// Returns the number of frames that may still be processed by the GPU
+	std::size_t FramesInFlight(void) const
+	{
+		return _regions.size();
+	}
+
+	/// Returns the number of the allocated ranges
+	unsigned Allocations(void) const
+	{
+		return _allocations;
+	}
+
+	/// Returns how many times the allocation wrapped around the buffer
+	unsigned Wraps(void) const
+	{
+		return _wraps;
+	}
+
+	/// Returns how many times the client had to wait for the GPU
+	unsigned Stalls(void) const
+	{
+		return _stalls;
+	}
+};
+
+#endif // buffer storage
+
+} // namespace oglplus
+
+#if !OGLPLUS_LINK_LIBRARY || defined(OGLPLUS_IMPLEMENTING_LIBRARY)
+#include <oglplus/streaming_buffer.ipp>
+#endif // OGLPLUS_LINK_LIBRARY
+
+#endif // include guard
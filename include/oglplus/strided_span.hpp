@@ -0,0 +1,128 @@
+/**
+ *  @file oglplus/strided_span.hpp
+ *  @brief View of an array of (possibly interleaved) tuples of values
+ *
+ *  @author Matus Chochlik
+ *
+ *  Copyright 2010-2013 Matus Chochlik. Distributed under the Boost
+ *  Software License, Version 1.0. (See accompanying file
+ *  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ */
+
+#pragma once
+#ifndef OGLPLUS_STRIDED_SPAN_1310251530_HPP
+#define OGLPLUS_STRIDED_SPAN_1310251530_HPP
+
+#include <cassert>
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+namespace oglplus {
+
+/// A view of an array of tuples of numeric values
+/** The @c StridedSpan class references @c Size() tuples each consisting
+ *  of @c Components() values, stored in a contiguous array with @c Stride()
+ *  elements between the starts of two consecutive tuples. This allows
+ *  to refer to the positions, normals, etc. stored in an array
+ *  of interleaved vertex attributes.
+ *
+ *  @ingroup math_utils
+ */
+template <typename T>
+class StridedSpan
+{
+private:
+	T* _addr;
+	std::size_t _size;
+	std::size_t _comps;
+	std::size_t _stride;
+public:
+	/// The type of span referencing the same values as immutable
+	typedef StridedSpan<const T> ConstSpan;
+
+	/// References @p size tuples of @p comps values starting at @p addr
+	/** @pre (comps >= 1) && (comps <= 4)
+	 *  @pre (stride == 0) || (stride >= comps)
+	 *
+	 *  If the @p stride is zero then the tuples are tightly packed.
+	 */
+	StridedSpan(
+		T* addr,
+		std::size_t size,
+		std::size_t comps,
+		std::size_t stride = 0
+	): _addr(addr)
+	 , _size(size)
+	 , _comps(comps)
+	 , _stride(stride?stride:comps)
+	{
+		assert((_comps >= 1) && (_comps <= 4));
+		assert(_stride >= _comps);
+	}
+
+	/// Converts a span of mutable values to a span of immutable values
+	template <typename U>
+	StridedSpan(
+		const StridedSpan<U>& that,
+		typename std::enable_if<
+			std::is_convertible<U*, T*>::value
+		>::type* = nullptr
+	): _addr(that.Data())
+	 , _size(that.Size())
+	 , _comps(that.Components())
+	 , _stride(that.Stride())
+	{ }
+
+	/// References the tuples in a std::vector of values
+	template <typename U>
+	StridedSpan(
+		std::vector<U>& values,
+		std::size_t comps,
+		std::size_t stride = 0
+	): _addr(values.data())
+	 , _size(0)
+	 , _comps(comps)
+	 , _stride(stride?stride:comps)
+	{
+		assert((_comps >= 1) && (_comps <= 4));
+		assert(_stride >= _comps);
+		if(values.size() >= _comps)
+			_size = (values.size() - _comps) / _stride + 1;
+	}
+
+	/// Returns the number of referenced tuples
+	std::size_t Size(void) const
+	{
+		return _size;
+	}
+
+	/// Returns the number of components in each tuple
+	std::size_t Components(void) const
+	{
+		return _comps;
+	}
+
+	/// Returns the distance (in elements) between two consecutive tuples
+	std::size_t Stride(void) const
+	{
+		return _stride;
+	}
+
+	/// Returns the pointer to the first value of the first tuple
+	T* Data(void) const
+	{
+		return _addr;
+	}
+
+	/// Returns a span referencing the tuples in range [offset, offset+size)
+	StridedSpan Slice(std::size_t offset, std::size_t size) const
+	{
+		assert(offset + size <= _size);
+		return StridedSpan(_addr+offset*_stride, size, _comps, _stride);
+	}
+};
+
+} // namespace oglplus
+
+#endif // include guard
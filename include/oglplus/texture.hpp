@@ -17,6 +17,7 @@
 #include <oglplus/error.hpp>
 #include <oglplus/glfunc.hpp>
 #include <oglplus/object.hpp>
+#include <oglplus/state_cache.hpp>
 #include <oglplus/friend_of.hpp>
 #include <oglplus/compare_func.hpp>
 #include <oglplus/data_type.hpp>
@@ -433,6 +434,8 @@ protected:
 
 	static void _bind(GLuint _name, Target target)
 	{
+		aux::TextureBindingChange change(GLenum(target), _name);
+		if(change.Redundant()) return;
 		assert(_name != 0);
 		OGLPLUS_GLFUNC(BindTexture)(GLenum(target), _name);
 		OGLPLUS_VERIFY(OGLPLUS_OBJECT_ERROR_INFO(
@@ -441,6 +444,7 @@ protected:
 			EnumValueName(target),
 			_name
 		));
+		change.Done();
 	}
 
 	friend class FriendOf<TextureOps>;
@@ -497,10 +501,18 @@ public:
 	 */
 	static void Active(TextureUnitSelector index)
 	{
+		aux::StateChange change(
+			aux::StateCacheKey::ActiveTexture,
+			0,
+			0,
+			GLint(index)
+		);
+		if(change.Redundant()) return;
 		OGLPLUS_GLFUNC(ActiveTexture)(
 			GLenum(GL_TEXTURE0 + GLuint(index))
 		);
 		OGLPLUS_VERIFY(OGLPLUS_ERROR_INFO(ActiveTexture));
+		change.Done();
 	}
 
 	/// Returns active texture unit
@@ -514,9 +526,15 @@ public:
 	static GLint Active(void)
 	{
 		GLint result;
+		if(aux::StateChange::Find(
+			aux::StateCacheKey::ActiveTexture,
+			0,
+			0,
+			result
+		)) return result;
 		OGLPLUS_GLFUNC(GetIntegerv)(GL_ACTIVE_TEXTURE, &result);
 		OGLPLUS_VERIFY(OGLPLUS_ERROR_INFO(GetIntegerv));
-		return GL_TEXTURE0 - result;
+		return result - GL_TEXTURE0;
 	}
 
 	/// Bind the texture to the target on the Active unit
@@ -546,8 +564,11 @@ public:
 	 */
 	static void Unbind(Target target)
 	{
+		aux::TextureBindingChange change(GLenum(target), 0);
+		if(change.Redundant()) return;
 		OGLPLUS_GLFUNC(BindTexture)(GLenum(target), 0);
 		OGLPLUS_VERIFY(OGLPLUS_ERROR_INFO(BindTexture));
+		change.Done();
 	}
 
 #if OGLPLUS_DOCUMENTATION_ONLY || GL_VERSION_4_4 || GL_ARB_multi_bind
@@ -569,6 +590,8 @@ public:
 			names
 		);
 		OGLPLUS_VERIFY(OGLPLUS_ERROR_INFO(BindTextures));
+		// the targets of the textures are not known here
+		aux::StateChange::ForgetAll(aux::StateCacheKey::Texture);
 	}
 #endif
 
@@ -584,7 +607,7 @@ public:
 			GetTexParameteriv,
 			Texture,
 			EnumValueName(target),
-			BindingQuery<TextureOps>::QueryBinding(target)
+			BindingQuery<TextureOps>::ErrorInfoName(target)
 		));
 		return result;
 	}
@@ -601,7 +624,7 @@ public:
 			GetTexParameterfv,
 			Texture,
 			EnumValueName(target),
-			BindingQuery<TextureOps>::QueryBinding(target)
+			BindingQuery<TextureOps>::ErrorInfoName(target)
 		));
 		return result;
 	}
@@ -620,7 +643,7 @@ public:
 			GetTexLevelParameteriv,
 			Texture,
 			EnumValueName(target),
-			BindingQuery<TextureOps>::QueryBinding(target)
+			BindingQuery<TextureOps>::ErrorInfoName(target)
 		));
 		return result;
 	}
@@ -638,7 +661,7 @@ public:
 			GetTexLevelParameterfv,
 			Texture,
 			EnumValueName(target),
-			BindingQuery<TextureOps>::QueryBinding(target)
+			BindingQuery<TextureOps>::ErrorInfoName(target)
 		));
 		return result;
 	}
@@ -1024,7 +1047,7 @@ public:
 			GetCompressedTexImage,
 			Texture,
 			EnumValueName(target),
-			BindingQuery<TextureOps>::QueryBinding(target)
+			BindingQuery<TextureOps>::ErrorInfoName(target)
 		));
 	}
 #endif // GL_VERSION_3_0
@@ -1063,7 +1086,7 @@ public:
 			TexImage3D,
 			Texture,
 			EnumValueName(target),
-			BindingQuery<TextureOps>::QueryBinding(target)
+			BindingQuery<TextureOps>::ErrorInfoName(target)
 		));
 	}
 
@@ -1095,7 +1118,7 @@ public:
 			TexImage3D,
 			Texture,
 			EnumValueName(target),
-			BindingQuery<TextureOps>::QueryBinding(target)
+			BindingQuery<TextureOps>::ErrorInfoName(target)
 		));
 	}
 
@@ -1135,7 +1158,7 @@ public:
 			TexSubImage3D,
 			Texture,
 			EnumValueName(target),
-			BindingQuery<TextureOps>::QueryBinding(target)
+			BindingQuery<TextureOps>::ErrorInfoName(target)
 		));
 	}
 
@@ -1170,7 +1193,7 @@ public:
 			TexSubImage3D,
 			Texture,
 			EnumValueName(target),
-			BindingQuery<TextureOps>::QueryBinding(target)
+			BindingQuery<TextureOps>::ErrorInfoName(target)
 		));
 	}
 
@@ -1206,7 +1229,7 @@ public:
 			TexImage2D,
 			Texture,
 			EnumValueName(target),
-			BindingQuery<TextureOps>::QueryBinding(target)
+			BindingQuery<TextureOps>::ErrorInfoName(target)
 		));
 	}
 
@@ -1237,7 +1260,7 @@ public:
 			TexImage2D,
 			Texture,
 			EnumValueName(target),
-			BindingQuery<TextureOps>::QueryBinding(target)
+			BindingQuery<TextureOps>::ErrorInfoName(target)
 		));
 	}
 
@@ -1273,7 +1296,7 @@ public:
 			TexSubImage2D,
 			Texture,
 			EnumValueName(target),
-			BindingQuery<TextureOps>::QueryBinding(target)
+			BindingQuery<TextureOps>::ErrorInfoName(target)
 		));
 	}
 
@@ -1305,7 +1328,7 @@ public:
 			TexSubImage2D,
 			Texture,
 			EnumValueName(target),
-			BindingQuery<TextureOps>::QueryBinding(target)
+			BindingQuery<TextureOps>::ErrorInfoName(target)
 		));
 	}
 
@@ -1340,7 +1363,7 @@ public:
 			TexImage1D,
 			Texture,
 			EnumValueName(target),
-			BindingQuery<TextureOps>::QueryBinding(target)
+			BindingQuery<TextureOps>::ErrorInfoName(target)
 		));
 	}
 
@@ -1370,7 +1393,7 @@ public:
 			TexImage1D,
 			Texture,
 			EnumValueName(target),
-			BindingQuery<TextureOps>::QueryBinding(target)
+			BindingQuery<TextureOps>::ErrorInfoName(target)
 		));
 	}
 
@@ -1402,7 +1425,7 @@ public:
 			TexSubImage1D,
 			Texture,
 			EnumValueName(target),
-			BindingQuery<TextureOps>::QueryBinding(target)
+			BindingQuery<TextureOps>::ErrorInfoName(target)
 		));
 	}
 
@@ -1431,7 +1454,7 @@ public:
 			TexSubImage1D,
 			Texture,
 			EnumValueName(target),
-			BindingQuery<TextureOps>::QueryBinding(target)
+			BindingQuery<TextureOps>::ErrorInfoName(target)
 		));
 	}
 #endif // GL_VERSION_3_0
@@ -1466,7 +1489,7 @@ public:
 			CopyTexImage2D,
 			Texture,
 			EnumValueName(target),
-			BindingQuery<TextureOps>::QueryBinding(target)
+			BindingQuery<TextureOps>::ErrorInfoName(target)
 		));
 	}
 
@@ -1499,7 +1522,7 @@ public:
 			CopyTexImage1D,
 			Texture,
 			EnumValueName(target),
-			BindingQuery<TextureOps>::QueryBinding(target)
+			BindingQuery<TextureOps>::ErrorInfoName(target)
 		));
 	}
 #endif // GL_VERSION_3_0
@@ -1536,7 +1559,7 @@ public:
 			CopyTexSubImage3D,
 			Texture,
 			EnumValueName(target),
-			BindingQuery<TextureOps>::QueryBinding(target)
+			BindingQuery<TextureOps>::ErrorInfoName(target)
 		));
 	}
 
@@ -1570,7 +1593,7 @@ public:
 			CopyTexSubImage2D,
 			Texture,
 			EnumValueName(target),
-			BindingQuery<TextureOps>::QueryBinding(target)
+			BindingQuery<TextureOps>::ErrorInfoName(target)
 		));
 	}
 
@@ -1601,7 +1624,7 @@ public:
 			CopyTexSubImage1D,
 			Texture,
 			EnumValueName(target),
-			BindingQuery<TextureOps>::QueryBinding(target)
+			BindingQuery<TextureOps>::ErrorInfoName(target)
 		));
 	}
 #endif // GL_VERSION_3_0
@@ -1638,7 +1661,7 @@ public:
 			CompressedTexImage3D,
 			Texture,
 			EnumValueName(target),
-			BindingQuery<TextureOps>::QueryBinding(target)
+			BindingQuery<TextureOps>::ErrorInfoName(target)
 		));
 	}
 
@@ -1672,7 +1695,7 @@ public:
 			CompressedTexImage2D,
 			Texture,
 			EnumValueName(target),
-			BindingQuery<TextureOps>::QueryBinding(target)
+			BindingQuery<TextureOps>::ErrorInfoName(target)
 		));
 	}
 
@@ -1705,7 +1728,7 @@ public:
 			CompressedTexImage1D,
 			Texture,
 			EnumValueName(target),
-			BindingQuery<TextureOps>::QueryBinding(target)
+			BindingQuery<TextureOps>::ErrorInfoName(target)
 		));
 	}
 #endif // GL_VERSION_3_0
@@ -1746,7 +1769,7 @@ public:
 			CompressedTexSubImage3D,
 			Texture,
 			EnumValueName(target),
-			BindingQuery<TextureOps>::QueryBinding(target)
+			BindingQuery<TextureOps>::ErrorInfoName(target)
 		));
 	}
 
@@ -1782,7 +1805,7 @@ public:
 			CompressedTexSubImage2D,
 			Texture,
 			EnumValueName(target),
-			BindingQuery<TextureOps>::QueryBinding(target)
+			BindingQuery<TextureOps>::ErrorInfoName(target)
 		));
 	}
 
@@ -1815,7 +1838,7 @@ public:
 			CompressedTexSubImage1D,
 			Texture,
 			EnumValueName(target),
-			BindingQuery<TextureOps>::QueryBinding(target)
+			BindingQuery<TextureOps>::ErrorInfoName(target)
 		));
 	}
 #endif
@@ -1850,7 +1873,7 @@ public:
 			TexImage3DMultisample,
 			Texture,
 			EnumValueName(target),
-			BindingQuery<TextureOps>::QueryBinding(target)
+			BindingQuery<TextureOps>::ErrorInfoName(target)
 		));
 	}
 
@@ -1881,7 +1904,7 @@ public:
 			TexImage2DMultisample,
 			Texture,
 			EnumValueName(target),
-			BindingQuery<TextureOps>::QueryBinding(target)
+			BindingQuery<TextureOps>::ErrorInfoName(target)
 		));
 	}
 #endif // texture multisample
@@ -1908,7 +1931,7 @@ public:
 			TexBuffer,
 			Texture,
 			EnumValueName(target),
-			BindingQuery<TextureOps>::QueryBinding(target)
+			BindingQuery<TextureOps>::ErrorInfoName(target)
 		));
 	}
 #endif
@@ -1939,7 +1962,7 @@ public:
 			TexBufferRange,
 			Texture,
 			EnumValueName(target),
-			BindingQuery<TextureOps>::QueryBinding(target)
+			BindingQuery<TextureOps>::ErrorInfoName(target)
 		));
 	}
 #endif
@@ -1968,7 +1991,7 @@ public:
 			TexStorage1D,
 			Texture,
 			EnumValueName(target),
-			BindingQuery<TextureOps>::QueryBinding(target)
+			BindingQuery<TextureOps>::ErrorInfoName(target)
 		));
 	}
 
@@ -1997,7 +2020,7 @@ public:
 			TexStorage2D,
 			Texture,
 			EnumValueName(target),
-			BindingQuery<TextureOps>::QueryBinding(target)
+			BindingQuery<TextureOps>::ErrorInfoName(target)
 		));
 	}
 
@@ -2028,7 +2051,7 @@ public:
 			TexStorage3D,
 			Texture,
 			EnumValueName(target),
-			BindingQuery<TextureOps>::QueryBinding(target)
+			BindingQuery<TextureOps>::ErrorInfoName(target)
 		));
 	}
 #endif
@@ -2153,7 +2176,7 @@ public:
 			TexParameteri,
 			Texture,
 			EnumValueName(target),
-			BindingQuery<TextureOps>::QueryBinding(target)
+			BindingQuery<TextureOps>::ErrorInfoName(target)
 		));
 	}
 
@@ -2176,7 +2199,7 @@ public:
 			GetTexParameterfv,
 			Texture,
 			EnumValueName(target),
-			BindingQuery<TextureOps>::QueryBinding(target)
+			BindingQuery<TextureOps>::ErrorInfoName(target)
 		));
 		return Vector<GLfloat, 4>(result, 4);
 	}
@@ -2198,7 +2221,7 @@ public:
 			TexParameterfv,
 			Texture,
 			EnumValueName(target),
-			BindingQuery<TextureOps>::QueryBinding(target)
+			BindingQuery<TextureOps>::ErrorInfoName(target)
 		));
 	}
 
@@ -2220,7 +2243,7 @@ public:
 			GetTexParameterIiv,
 			Texture,
 			EnumValueName(target),
-			BindingQuery<TextureOps>::QueryBinding(target)
+			BindingQuery<TextureOps>::ErrorInfoName(target)
 		));
 		return Vector<GLint, 4>(result, 4);
 	}
@@ -2242,7 +2265,7 @@ public:
 			TexParameterIiv,
 			Texture,
 			EnumValueName(target),
-			BindingQuery<TextureOps>::QueryBinding(target)
+			BindingQuery<TextureOps>::ErrorInfoName(target)
 		));
 	}
 
@@ -2264,7 +2287,7 @@ public:
 			GetTexParameterIuiv,
 			Texture,
 			EnumValueName(target),
-			BindingQuery<TextureOps>::QueryBinding(target)
+			BindingQuery<TextureOps>::ErrorInfoName(target)
 		));
 		return Vector<GLuint, 4>(result, 4);
 	}
@@ -2286,7 +2309,7 @@ public:
 			TexParameterIuiv,
 			Texture,
 			EnumValueName(target),
-			BindingQuery<TextureOps>::QueryBinding(target)
+			BindingQuery<TextureOps>::ErrorInfoName(target)
 		));
 	}
 #endif // GL_VERSION_3_0
@@ -2322,7 +2345,7 @@ public:
 			TexParameteri,
 			Texture,
 			EnumValueName(target),
-			BindingQuery<TextureOps>::QueryBinding(target)
+			BindingQuery<TextureOps>::ErrorInfoName(target)
 		));
 	}
 
@@ -2357,7 +2380,7 @@ public:
 			TexParameteri,
 			Texture,
 			EnumValueName(target),
-			BindingQuery<TextureOps>::QueryBinding(target)
+			BindingQuery<TextureOps>::ErrorInfoName(target)
 		));
 	}
 
@@ -2390,7 +2413,7 @@ public:
 			TexParameterf,
 			Texture,
 			EnumValueName(target),
-			BindingQuery<TextureOps>::QueryBinding(target)
+			BindingQuery<TextureOps>::ErrorInfoName(target)
 		));
 	}
 #endif // GL_VERSION_3_0
@@ -2426,7 +2449,7 @@ public:
 			TexParameteri,
 			Texture,
 			EnumValueName(target),
-			BindingQuery<TextureOps>::QueryBinding(target)
+			BindingQuery<TextureOps>::ErrorInfoName(target)
 		));
 	}
 
@@ -2461,7 +2484,7 @@ public:
 			TexParameteri,
 			Texture,
 			EnumValueName(target),
-			BindingQuery<TextureOps>::QueryBinding(target)
+			BindingQuery<TextureOps>::ErrorInfoName(target)
 		));
 	}
 
@@ -2493,7 +2516,7 @@ public:
 			TexParameterf,
 			Texture,
 			EnumValueName(target),
-			BindingQuery<TextureOps>::QueryBinding(target)
+			BindingQuery<TextureOps>::ErrorInfoName(target)
 		));
 	}
 
@@ -2525,7 +2548,7 @@ public:
 			TexParameterf,
 			Texture,
 			EnumValueName(target),
-			BindingQuery<TextureOps>::QueryBinding(target)
+			BindingQuery<TextureOps>::ErrorInfoName(target)
 		));
 	}
 
@@ -2557,7 +2580,7 @@ public:
 			TexParameteri,
 			Texture,
 			EnumValueName(target),
-			BindingQuery<TextureOps>::QueryBinding(target)
+			BindingQuery<TextureOps>::ErrorInfoName(target)
 		));
 	}
 
@@ -2617,7 +2640,7 @@ public:
 			TexParameterf,
 			Texture,
 			EnumValueName(target),
-			BindingQuery<TextureOps>::QueryBinding(target)
+			BindingQuery<TextureOps>::ErrorInfoName(target)
 		));
 #else
 		OGLPLUS_FAKE_USE(target);
@@ -2661,7 +2684,7 @@ public:
 			TexParameteri,
 			Texture,
 			EnumValueName(target),
-			BindingQuery<TextureOps>::QueryBinding(target)
+			BindingQuery<TextureOps>::ErrorInfoName(target)
 		));
 	}
 
@@ -2780,7 +2803,7 @@ public:
 			GetTexParameteriv,
 			Texture,
 			EnumValueName(target),
-			BindingQuery<TextureOps>::QueryBinding(target)
+			BindingQuery<TextureOps>::ErrorInfoName(target)
 		));
 		return result;
 	}
@@ -2806,7 +2829,7 @@ public:
 			TexParameteriv,
 			Texture,
 			EnumValueName(target),
-			BindingQuery<TextureOps>::QueryBinding(target)
+			BindingQuery<TextureOps>::ErrorInfoName(target)
 		));
 	}
 
@@ -2841,7 +2864,7 @@ public:
 			TexParameteriv,
 			Texture,
 			EnumValueName(target),
-			BindingQuery<TextureOps>::QueryBinding(target)
+			BindingQuery<TextureOps>::ErrorInfoName(target)
 		));
 	}
 
@@ -2863,7 +2886,7 @@ public:
 			TexParameteriv,
 			Texture,
 			EnumValueName(target),
-			BindingQuery<TextureOps>::QueryBinding(target)
+			BindingQuery<TextureOps>::ErrorInfoName(target)
 		));
 	}
 #endif // texture swizzle
@@ -2901,7 +2924,7 @@ public:
 			TexParameteri,
 			Texture,
 			EnumValueName(target),
-			BindingQuery<TextureOps>::QueryBinding(target)
+			BindingQuery<TextureOps>::ErrorInfoName(target)
 		));
 	}
 
@@ -3008,7 +3031,7 @@ public:
 			TexParameteri,
 			Texture,
 			EnumValueName(target),
-			BindingQuery<TextureOps>::QueryBinding(target)
+			BindingQuery<TextureOps>::ErrorInfoName(target)
 		));
 	}
 #endif
@@ -3045,7 +3068,7 @@ public:
 			TexParameteri,
 			Texture,
 			EnumValueName(target),
-			BindingQuery<TextureOps>::QueryBinding(target)
+			BindingQuery<TextureOps>::ErrorInfoName(target)
 		));
 	}
 #endif
@@ -3062,7 +3085,7 @@ public:
 			GenerateMipmap,
 			Texture,
 			EnumValueName(target),
-			BindingQuery<TextureOps>::QueryBinding(target)
+			BindingQuery<TextureOps>::ErrorInfoName(target)
 		));
 	}
 
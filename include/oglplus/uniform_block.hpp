@@ -39,6 +39,9 @@ protected:
 
 	GLint _do_init_location(GLuint program, const GLchar* identifier) const
 	{
+		ProgramReflectionEntry entry;
+		if(ProgramReflection::FindUniformBlock(program, identifier, entry))
+			return entry.location;
 		GLint result = OGLPLUS_GLFUNC(GetUniformBlockIndex)(
 			program,
 			identifier
@@ -15,6 +15,7 @@
 
 #include <oglplus/config_compiler.hpp>
 #include <oglplus/fwd.hpp>
+#include <oglplus/auxiliary/simd.hpp>
 #include <cassert>
 #include <cmath>
 #include <cstddef>
@@ -27,7 +28,11 @@ template <typename T, std::size_t Rows, std::size_t Cols>
 class Matrix;
 
 template<typename T, std::size_t R, std::size_t C>
-T At(const Matrix<T, R, C>&, std::size_t r, std::size_t c);
+OGLPLUS_CONSTEXPR_MATH T At(
+	const Matrix<T, R, C>&,
+	std::size_t r,
+	std::size_t c
+);
 
 template <typename T, std::size_t N>
 class Vector;
@@ -95,10 +100,28 @@ protected:
 	VectorBase(oglplus::Nothing)
 	{ }
 
-	VectorBase(void)
+	OGLPLUS_CONSTEXPR_MATH VectorBase(void)
+	 : _elem()
+	{ }
+
+	// Tag for the element-wise constructors
+	struct Elems_ { };
+
+#if !OGLPLUS_NO_CONSTEXPR_MATH
+	template <typename ... P>
+	constexpr VectorBase(Elems_, P ... p)
+	 : _elem{T(p)...}
 	{
-		std::fill(_elem, _elem+N, T(0));
+		static_assert(sizeof...(P) == N, "Invalid number of elements");
 	}
+#else
+	VectorBase(Elems_, T v0, T v1 = T(0), T v2 = T(0), T v3 = T(0))
+	{
+		static_assert(N <= 4, "Invalid number of elements");
+		const T v[4] = {v0, v1, v2, v3};
+		std::copy(v, v+N, _elem);
+	}
+#endif
 
 	VectorBase(T v)
 	{
@@ -167,7 +190,7 @@ public:
 	}
 
 	/// Pointer to the components of this vector
-	const T* Data(void) const
+	OGLPLUS_CONSTEXPR_MATH const T* Data(void) const
 	{
 		return this->_elem;
 	}
@@ -175,20 +198,18 @@ public:
 	/**
 	 *  @pre (i < Size())
 	 */
-	T At(std::size_t i) const
+	OGLPLUS_CONSTEXPR_MATH T At(std::size_t i) const
 	{
-		assert(i < N);
-		return _elem[i];
+		return assert(i < N), _elem[i];
 	}
 
 	/// Access to the i-th component of this vector with a fallback
 	/** Similar to At(i), but returns @c fallback if @c i is
 	 *  greater than or equal to Size().
 	 */
-	T At(std::size_t i, T fallback) const
+	OGLPLUS_CONSTEXPR_MATH T At(std::size_t i, T fallback) const
 	{
-		if(i < N) return _elem[i];
-		else return fallback;
+		return (i < N) ? _elem[i] : fallback;
 	}
 
 	/// Access to the i-th component of this vector
@@ -205,10 +226,9 @@ public:
 	/**
 	 *  @pre (i < Size())
 	 */
-	const T& operator [](std::size_t i) const
+	OGLPLUS_CONSTEXPR_MATH const T& operator [](std::size_t i) const
 	{
-		assert(i < N);
-		return _elem[i];
+		return assert(i < N), _elem[i];
 	}
 
 	/// Equality comparison
@@ -223,29 +243,25 @@ public:
 	/// Adds @p v to this vector
 	void Add(const VectorBase& v)
 	{
-		for(std::size_t i=0; i!=N; ++i)
-			_elem[i] += v._elem[i];
+		aux::VectorOps<T, N>::Add(_elem, _elem, v._elem);
 	}
 
 	/// Subtracts @p v from this vector
 	void Subtract(const VectorBase& v)
 	{
-		for(std::size_t i=0; i!=N; ++i)
-			_elem[i] -= v._elem[i];
+		aux::VectorOps<T, N>::Subtract(_elem, _elem, v._elem);
 	}
 
 	/// Multiplies this vector by a scalar value
 	void MultiplyBy(T v)
 	{
-		for(std::size_t i=0; i!=N; ++i)
-			_elem[i] *= v;
+		aux::VectorOps<T, N>::Multiply(_elem, _elem, v);
 	}
 
 	/// Divides this vector by a scalar value
 	void DivideBy(T v)
 	{
-		for(std::size_t i=0; i!=N; ++i)
-			_elem[i] /= v;
+		aux::VectorOps<T, N>::Divide(_elem, _elem, v);
 	}
 
 	/// Returns the lenght of this vector
@@ -271,10 +287,7 @@ public:
 	/// Computes the dot product of vectors @p a and @p b
 	static T DotProduct(const VectorBase& a, const VectorBase& b)
 	{
-		T result = (a._elem[0] * b._elem[0]);
-		for(std::size_t i=1; i!=N; ++i)
-			result += (a._elem[i] * b._elem[i]);
-		return result;
+		return aux::VectorOps<T, N>::Dot(a._elem, b._elem);
 	}
 };
 
@@ -291,7 +304,7 @@ public:
 #include <oglplus/auxiliary/vector_swizzle.ipp>
 
 template <typename T, std::size_t N>
-inline const T* Data(const Vector<T, N>& a)
+OGLPLUS_CONSTEXPR_MATH const T* Data(const Vector<T, N>& a)
 {
 	return a.Data();
 }
@@ -303,19 +316,19 @@ inline std::size_t Size(const Vector<T, N>&)
 }
 
 template <typename T, std::size_t N>
-inline T At(const Vector<T, N>& a, std::size_t i)
+OGLPLUS_CONSTEXPR_MATH T At(const Vector<T, N>& a, std::size_t i)
 {
 	return a.At(i);
 }
 
 template <typename T, std::size_t N>
-inline T At(const Vector<T, N>& a, std::size_t i, T fallback)
+OGLPLUS_CONSTEXPR_MATH T At(const Vector<T, N>& a, std::size_t i, T fallback)
 {
 	return a.At(i, fallback);
 }
 
 template <typename T, std::size_t N>
-inline Vector<T, 1> Extract(
+OGLPLUS_CONSTEXPR_MATH Vector<T, 1> Extract(
 	const Vector<T, N>& a,
 	std::size_t d0
 )
@@ -324,7 +337,7 @@ inline Vector<T, 1> Extract(
 }
 
 template <typename T, std::size_t N>
-inline Vector<T, 2> Extract(
+OGLPLUS_CONSTEXPR_MATH Vector<T, 2> Extract(
 	const Vector<T, N>& a,
 	std::size_t d0,
 	std::size_t d1
@@ -334,7 +347,7 @@ inline Vector<T, 2> Extract(
 }
 
 template <typename T, std::size_t N>
-inline Vector<T, 3> Extract(
+OGLPLUS_CONSTEXPR_MATH Vector<T, 3> Extract(
 	const Vector<T, N>& a,
 	std::size_t d0,
 	std::size_t d1,
@@ -345,7 +358,7 @@ inline Vector<T, 3> Extract(
 }
 
 template <typename T, std::size_t N>
-inline Vector<T, 4> Extract(
+OGLPLUS_CONSTEXPR_MATH Vector<T, 4> Extract(
 	const Vector<T, N>& a,
 	std::size_t d0,
 	std::size_t d1,
@@ -385,7 +398,7 @@ inline Vector<T, N> Normalized(Vector<T, N> a)
 }
 
 template <typename T>
-inline Vector<T, 2> Perpendicular(const Vector<T, 2>& a)
+OGLPLUS_CONSTEXPR_MATH Vector<T, 2> Perpendicular(const Vector<T, 2>& a)
 {
 	return Vector<T, 2>(-a[1], a[0]);
 }
@@ -393,11 +406,9 @@ inline Vector<T, 2> Perpendicular(const Vector<T, 2>& a)
 template <typename T>
 inline Vector<T, 3> Cross(const Vector<T, 3>& a, const Vector<T, 3>& b)
 {
-	return Vector<T, 3>(
-		a[1] * b[2] - a[2] * b[1],
-		a[2] * b[0] - a[0] * b[2],
-		a[0] * b[1] - a[1] * b[0]
-	);
+	T tmp[3];
+	aux::VectorOps<T, 3>::Cross(tmp, a.Data(), b.Data());
+	return Vector<T, 3>(tmp);
 }
 
 template <typename T, std::size_t N>
@@ -413,25 +424,31 @@ inline bool operator != (const Vector<T, N>& a, const Vector<T, N>& b)
 }
 
 template <typename T, std::size_t N>
-inline Vector<T, N> operator - (const Vector<T, N>& v)
+OGLPLUS_CONSTEXPR_MATH Vector<T, N> operator - (const Vector<T, N>& v)
 {
 	return Negated(v);
 }
 
 template <typename T, std::size_t N>
-inline Vector<T, N> operator + (const Vector<T, N>& a, const Vector<T, N>& b)
+OGLPLUS_CONSTEXPR_MATH Vector<T, N> operator + (
+	const Vector<T, N>& a,
+	const Vector<T, N>& b
+)
 {
 	return Added(a, b);
 }
 
 template <typename T, std::size_t N>
-inline Vector<T, N> operator - (const Vector<T, N>& a, const Vector<T, N>& b)
+OGLPLUS_CONSTEXPR_MATH Vector<T, N> operator - (
+	const Vector<T, N>& a,
+	const Vector<T, N>& b
+)
 {
 	return Subtracted(a, b);
 }
 
 template <typename T, typename V, std::size_t N>
-inline typename std::enable_if<
+OGLPLUS_CONSTEXPR_MATH typename std::enable_if<
 	std::is_convertible<V, T>::value,
 	Vector<T, N>
 >::type operator * (const Vector<T, N>& a, V v)
@@ -440,7 +457,7 @@ inline typename std::enable_if<
 }
 
 template <typename T, typename V, std::size_t N>
-inline typename std::enable_if<
+OGLPLUS_CONSTEXPR_MATH typename std::enable_if<
 	std::is_convertible<V, T>::value,
 	Vector<T, N>
 >::type operator * (V v, const Vector<T, N>& a)
@@ -450,7 +467,7 @@ inline typename std::enable_if<
 
 
 template <typename T, typename V, std::size_t N>
-inline typename std::enable_if<
+OGLPLUS_CONSTEXPR_MATH typename std::enable_if<
 	std::is_convertible<V, T>::value,
 	Vector<T, N>
 >::type operator / (const Vector<T, N>& a, V v)
@@ -465,14 +482,11 @@ inline Vector<T, Cols> operator * (
 )
 {
 	T tmp[Cols];
-	for(std::size_t c=0; c!=Cols; ++c)
-	{
-		tmp[c] = T(0);
-		for(std::size_t r=0; r!=N; ++r)
-		{
-			tmp[c] += v.At(r) * m.At(r, c);
-		}
-	}
+	aux::VectorMatrixMultiplyOp<T, N, Cols>::Apply(
+		tmp,
+		v.Data(),
+		m.Data()
+	);
 	return Vector<T, Cols>(tmp);
 }
 
@@ -483,14 +497,11 @@ inline Vector<T, Rows> operator * (
 )
 {
 	T tmp[Rows];
-	for(std::size_t r=0; r!=Rows; ++r)
-	{
-		tmp[r] = T(0);
-		for(std::size_t c=0; c!=N; ++c)
-		{
-			tmp[r] += m.At(r, c) * v.At(c);
-		}
-	}
+	aux::MatrixVectorMultiplyOp<T, Rows, N>::Apply(
+		tmp,
+		m.Data(),
+		v.Data()
+	);
 	return Vector<T, Rows>(tmp);
 }
 
@@ -17,6 +17,7 @@
 #include <oglplus/glfunc.hpp>
 #include <oglplus/error.hpp>
 #include <oglplus/object.hpp>
+#include <oglplus/state_cache.hpp>
 #include <oglplus/friend_of.hpp>
 #include <cassert>
 
@@ -73,9 +74,17 @@ protected:
 
 	static void _bind(GLuint _name, Nothing)
 	{
+		aux::StateChange change(
+			aux::StateCacheKey::VertexArray,
+			0,
+			0,
+			GLint(_name)
+		);
+		if(change.Redundant()) return;
 		assert(_name != 0);
 		OGLPLUS_GLFUNC(BindVertexArray)(_name);
 		OGLPLUS_VERIFY(OGLPLUS_ERROR_INFO(BindVertexArray));
+		change.Done();
 	}
 
 	friend class FriendOf<VertexArrayOps>;
@@ -97,8 +106,16 @@ public:
 	 */
 	static void Unbind(void)
 	{
+		aux::StateChange change(
+			aux::StateCacheKey::VertexArray,
+			0,
+			0,
+			0
+		);
+		if(change.Redundant()) return;
 		OGLPLUS_GLFUNC(BindVertexArray)(0);
 		OGLPLUS_VERIFY(OGLPLUS_ERROR_INFO(BindVertexArray));
+		change.Done();
 	}
 };
 
@@ -247,4 +247,24 @@ BOOST_AUTO_TEST_CASE(Angle_arc)
 	}
 }
 
+BOOST_AUTO_TEST_CASE(Angle_constexpr)
+{
+#if !OGLPLUS_NO_CONSTEXPR_MATH
+	typedef oglplus::Angle<double> Angled;
+
+	constexpr Angled a = Angled::Degrees(90.0);
+	static_assert(a.Value() > 1.5707 && a.Value() < 1.5709, "");
+
+	constexpr Angled b = Angled::Radians(oglplus::math::Pi());
+	static_assert(-b < a && a < b && a != b, "");
+	static_assert(Angled() < a*0.5 && a*1.5 > a + Angled(), "");
+
+	constexpr Angled c = (b / 4.0) * 2.0;
+	static_assert(c.ValueInRightAngles() == 1.0, "");
+	static_assert(b.ValueInFullCircles() == 0.5, "");
+
+	BOOST_CHECK_CLOSE(a.Value(), oglplus::math::HalfPi(), 0.0001);
+#endif
+}
+
 BOOST_AUTO_TEST_SUITE_END()
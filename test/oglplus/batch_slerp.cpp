@@ -0,0 +1,130 @@
+/**
+ *  .file test/oglplus/batch_slerp.cpp
+ *  .brief Test case for the batched quaternion interpolation.
+ *
+ *  .author Matus Chochlik
+ *
+ *  Copyright 2010-2013 Matus Chochlik. Distributed under the Boost
+ *  Software License, Version 1.0. (See accompanying file
+ *  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ */
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE OGLPLUS_BatchSLERP
+#include <boost/test/unit_test.hpp>
+
+#include <oglplus/gl.hpp>
+#include <oglplus/batch_slerp.hpp>
+
+#include <cmath>
+#include <vector>
+
+#include "random_values.hpp"
+
+BOOST_AUTO_TEST_SUITE(BatchSLERP)
+
+template <typename T>
+static void random_quaternions(oglplus::QuaternionArrays<T> q)
+{
+	for(std::size_t i=0; i!=q.Size(); ++i)
+	{
+		T v[4], l = T(0);
+		for(std::size_t c=0; c!=4; ++c)
+		{
+			v[c] = random_value<T>();
+			l += v[c]*v[c];
+		}
+		l = std::sqrt(l);
+		q.Set(i, oglplus::Quaternion<T>(v[0]/l, v[1]/l, v[2]/l, v[3]/l));
+	}
+}
+
+// the reference spherical linear interpolation along the shorter arc
+template <typename T>
+static oglplus::Quaternion<T> slerp(
+	const oglplus::Quaternion<T>& q1,
+	oglplus::Quaternion<T> q2,
+	T t
+)
+{
+	T d = Dot(q1, q2);
+	if(d < T(0))
+	{
+		q2 = q2*T(-1);
+		d = -d;
+	}
+	if(d > T(0.9999)) return q2;
+	const T omega = std::acos(d);
+	const T s1 = std::sin((1-t)*omega)/std::sin(omega);
+	const T s2 = std::sin(t*omega)/std::sin(omega);
+	return q1*s1 + q2*s2;
+}
+
+template <typename T>
+static bool close(
+	const oglplus::Quaternion<T>& a,
+	const oglplus::Quaternion<T>& b,
+	T eps
+)
+{
+	for(std::size_t c=0; c!=4; ++c)
+		if(std::fabs(a.At(c) - b.At(c)) > eps)
+			return false;
+	return true;
+}
+
+template <typename T>
+static void do_test_batch_nlerp(std::size_t count, T eps)
+{
+	using namespace oglplus;
+	std::vector<T> d1(count*4), d2(count*4), dr(count*4), t(count);
+	QuaternionArrays<T> q1(d1.data(), count);
+	QuaternionArrays<T> q2(d2.data(), count);
+	QuaternionArrays<T> r(dr.data(), count);
+	random_quaternions(q1);
+	random_quaternions(q2);
+	for(std::size_t i=0; i!=count; ++i)
+		t[i] = (random_value<T>() + T(1)) / T(2);
+
+	BatchNLERP(q1, q2, t.data(), r);
+	for(std::size_t i=0; i!=count; ++i)
+	{
+		const Quaternion<T> e = slerp(q1.At(i), q2.At(i), t[i]);
+		BOOST_CHECK(close(r.At(i), e, T(1e-3)));
+		BOOST_CHECK(r.At(i).IsNormal(eps));
+	}
+
+	BatchNLERP(q1, q2, t.data(), r, false);
+	for(std::size_t i=0; i!=count; ++i)
+	{
+		Quaternion<T> a = q1.At(i), b = q2.At(i);
+		if(Dot(a, b) < T(0)) b = b*T(-1);
+		Quaternion<T> e = a*(1-t[i]) + b*t[i];
+		e = e*(T(1)/e.Magnitude());
+		BOOST_CHECK(close(r.At(i), e, eps));
+	}
+
+	std::vector<Matrix<T, 3, 4> > m(count);
+	BatchNLERP(q1, q2, t.data(), m.data());
+	BatchNLERP(q1, q2, t.data(), r);
+	for(std::size_t i=0; i!=count; ++i)
+	{
+		const ModelMatrix<T> e = ModelMatrix<T>::RotationQ(r.At(i));
+		for(std::size_t j=0; j!=3; ++j)
+		for(std::size_t k=0; k!=4; ++k)
+			BOOST_CHECK(std::fabs(m[i].At(j, k) - e.At(j, k)) <= eps);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(BatchSLERP_float)
+{
+	do_test_batch_nlerp<float>(1, 1e-5f);
+	do_test_batch_nlerp<float>(203, 1e-5f);
+}
+
+BOOST_AUTO_TEST_CASE(BatchSLERP_double)
+{
+	do_test_batch_nlerp<double>(3, 1e-12);
+	do_test_batch_nlerp<double>(203, 1e-12);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -18,7 +18,7 @@
 
 #include "fixture.hpp"
 
-BOOST_GLOBAL_FIXTURE(OGLplusTestFixture)
+BOOST_GLOBAL_FIXTURE(OGLplusTestFixture);
 
 BOOST_AUTO_TEST_SUITE(Buffer)
 
@@ -0,0 +1,170 @@
+/**
+ *  .file test/oglplus/bulk_transform.cpp
+ *  .brief Test case for the bulk transformation functions.
+ *
+ *  .author Matus Chochlik
+ *
+ *  Copyright 2010-2013 Matus Chochlik. Distributed under the Boost
+ *  Software License, Version 1.0. (See accompanying file
+ *  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ */
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE OGLPLUS_BulkTransform
+#include <boost/test/unit_test.hpp>
+
+#include <oglplus/gl.hpp>
+#include <oglplus/bulk_transform.hpp>
+
+#include <cmath>
+#include <vector>
+#include <atomic>
+#include <stdexcept>
+
+#include "random_values.hpp"
+
+BOOST_AUTO_TEST_SUITE(BulkTransform)
+
+template <typename T>
+static oglplus::Matrix<T, 4, 4> random_matrix(void)
+{
+	oglplus::Matrix<T, 4, 4> m;
+	for(std::size_t i=0; i!=4; ++i)
+		for(std::size_t j=0; j!=4; ++j)
+			m.Set(i, j, random_value<T>());
+	return m;
+}
+
+template <typename T>
+static void do_test_bulk_transform(
+	std::size_t count,
+	std::size_t in_n,
+	std::size_t in_stride,
+	std::size_t out_n,
+	std::size_t out_stride,
+	bool positions,
+	bool renormalize,
+	unsigned max_threads,
+	T eps
+)
+{
+	const oglplus::Matrix<T, 4, 4> m = random_matrix<T>();
+	std::vector<T> in(count*in_stride);
+	for(auto i=in.begin(), e=in.end(); i!=e; ++i)
+		*i = random_value<T>();
+	std::vector<T> out(count*out_stride, T(0));
+
+	oglplus::StridedSpan<T> in_span(in.data(), count, in_n, in_stride);
+	oglplus::StridedSpan<T> out_span(out.data(), count, out_n, out_stride);
+	if(positions)
+	{
+		oglplus::TransformPositions(m, in_span, out_span, max_threads);
+	}
+	else
+	{
+		oglplus::TransformDirections(
+			m,
+			in_span,
+			out_span,
+			renormalize,
+			max_threads
+		);
+	}
+
+	for(std::size_t i=0; i!=count; ++i)
+	{
+		T v[4] = {T(0), T(0), T(0), positions?T(1):T(0)};
+		for(std::size_t c=0; c!=in_n; ++c)
+			v[c] = in[i*in_stride+c];
+		oglplus::Vector<T, 4> r = m * oglplus::Vector<T, 4>(v, 4);
+		T l = T(1);
+		if(renormalize)
+		{
+			l = std::sqrt(r.x()*r.x()+r.y()*r.y()+r.z()*r.z());
+		}
+		for(std::size_t c=0; c!=out_n; ++c)
+		{
+			T e = (c < 3)?r.At(c)/l:r.At(c);
+			BOOST_CHECK(std::fabs(out[i*out_stride+c]-e) <= eps);
+		}
+	}
+}
+
+template <typename T>
+static void do_test_bulk_transform_layouts(T eps)
+{
+	const bool pos = true, dir = false;
+	do_test_bulk_transform<T>(257, 3, 3, 3, 3, pos, false, 1, eps);
+	do_test_bulk_transform<T>(257, 4, 4, 4, 4, pos, false, 1, eps);
+	do_test_bulk_transform<T>(257, 3, 8, 4, 4, pos, false, 1, eps);
+	do_test_bulk_transform<T>(257, 4, 6, 3, 5, pos, false, 1, eps);
+	do_test_bulk_transform<T>(257, 2, 2, 2, 3, pos, false, 1, eps);
+	do_test_bulk_transform<T>(257, 3, 3, 3, 3, dir, false, 1, eps);
+	do_test_bulk_transform<T>(257, 3, 8, 3, 8, dir, true, 1, eps);
+	do_test_bulk_transform<T>(257, 4, 4, 3, 3, dir, true, 1, eps);
+}
+
+BOOST_AUTO_TEST_CASE(BulkTransform_float)
+{
+	do_test_bulk_transform_layouts<float>(1e-5f);
+}
+
+BOOST_AUTO_TEST_CASE(BulkTransform_double)
+{
+	do_test_bulk_transform_layouts<double>(1e-12);
+}
+
+BOOST_AUTO_TEST_CASE(BulkTransform_parallel)
+{
+	do_test_bulk_transform<float>(50001, 3, 3, 3, 3, true, false, 4, 1e-5f);
+	do_test_bulk_transform<float>(50001, 3, 8, 3, 8, false, true, 3, 1e-5f);
+	do_test_bulk_transform<double>(50001, 4, 4, 4, 4, true, false, 8, 1e-12);
+}
+
+#if !OGLPLUS_NO_THREADS
+BOOST_AUTO_TEST_CASE(BulkTransform_parallel_exception)
+{
+	// the exception thrown in a worker thread is rethrown by the caller
+	// after all the parts are processed
+	std::atomic<std::size_t> done(0);
+	BOOST_CHECK_THROW(
+		oglplus::aux::ParallelFor(
+			4000, 1000, 4,
+			[&done](std::size_t begin, std::size_t end)
+			{
+				if(begin == 2000) throw std::runtime_error("failed");
+				done += end - begin;
+			}
+		),
+		std::runtime_error
+	);
+	BOOST_CHECK_EQUAL(done.load(), 3000u);
+}
+#endif
+
+BOOST_AUTO_TEST_CASE(BulkTransform_in_place)
+{
+	const oglplus::Mat4f m = random_matrix<float>();
+	std::vector<float> data(3*100);
+	for(auto i=data.begin(), e=data.end(); i!=e; ++i)
+		*i = random_value<float>();
+	const std::vector<float> orig(data);
+
+	oglplus::TransformPositions(
+		m,
+		oglplus::StridedSpan<float>(data, 3),
+		oglplus::StridedSpan<float>(data, 3)
+	);
+	for(std::size_t i=0; i!=100; ++i)
+	{
+		oglplus::Vec4f r = m * oglplus::Vec4f(
+			orig[i*3+0],
+			orig[i*3+1],
+			orig[i*3+2],
+			1.0f
+		);
+		for(std::size_t c=0; c!=3; ++c)
+			BOOST_CHECK(std::fabs(data[i*3+c]-r.At(c)) <= 1e-5f);
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
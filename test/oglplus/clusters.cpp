@@ -0,0 +1,237 @@
+/**
+ *  .file test/oglplus/clusters.cpp
+ *  .brief Test case for the partitioning of shapes into clusters.
+ *
+ *  .author Matus Chochlik
+ *
+ *  Copyright 2010-2013 Matus Chochlik. Distributed under the Boost
+ *  Software License, Version 1.0. (See accompanying file
+ *  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ */
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE OGLPLUS_Clusters
+#include <boost/test/unit_test.hpp>
+
+#include <oglplus/gl.hpp>
+#include <oglplus/shapes/clusters.hpp>
+#include <oglplus/shapes/sphere.hpp>
+#include <oglplus/shapes/torus.hpp>
+
+#include <algorithm>
+#include <vector>
+#include <cmath>
+
+BOOST_AUTO_TEST_SUITE(Clusters)
+
+// returns the triangles of the builder rotated to start with
+// the smallest index (keeping the winding) and sorted
+template <typename ShapeBuilder>
+static std::vector<GLuint> sorted_triangles(const ShapeBuilder& builder)
+{
+	std::vector<GLuint> tris;
+	const auto indices = builder.Indices();
+	const auto instr = builder.Instructions();
+	auto i = instr.Operations().begin(), e = instr.Operations().end();
+	while(i != e)
+	{
+		oglplus::aux::AppendShapeTriangles(tris, *i, indices);
+		++i;
+	}
+	std::vector<std::vector<GLuint> > sorted;
+	for(std::size_t t=0; t!=tris.size(); t+=3)
+	{
+		std::vector<GLuint> tri(tris.begin()+t, tris.begin()+t+3);
+		std::rotate(
+			tri.begin(),
+			std::min_element(tri.begin(), tri.end()),
+			tri.end()
+		);
+		sorted.push_back(tri);
+	}
+	std::sort(sorted.begin(), sorted.end());
+	std::vector<GLuint> result;
+	for(auto s=sorted.begin(); s!=sorted.end(); ++s)
+		result.insert(result.end(), s->begin(), s->end());
+	return result;
+}
+
+template <typename ShapeBuilder>
+static void do_test_clusters(
+	const ShapeBuilder& builder,
+	GLuint max_vertices,
+	GLuint max_triangles
+)
+{
+	using namespace oglplus;
+	shapes::ClusteredShape<ShapeBuilder> clustered(
+		builder,
+		max_vertices,
+		max_triangles
+	);
+	const std::vector<GLuint>& indices = clustered.Indices();
+	const std::vector<shapes::ShapeCluster>& clusters = clustered.Clusters();
+	BOOST_CHECK(clusters.size() > 1);
+
+	// the clusters contain all triangles exactly once
+	BOOST_CHECK(sorted_triangles(clustered) == sorted_triangles(builder));
+
+	auto instr = clustered.Instructions();
+	BOOST_CHECK_EQUAL(instr.Operations().size(), 1u);
+	BOOST_CHECK_EQUAL(instr.Operations().front().count, indices.size());
+	auto cluster_instr = clustered.ClusterInstructions();
+	BOOST_CHECK_EQUAL(cluster_instr.Operations().size(), clusters.size());
+
+	std::vector<GLfloat> pos, nml;
+	const GLuint npv = clustered.Positions(pos);
+	clustered.Normals(nml);
+	GLuint next = 0;
+	GLuint culled = 0;
+	for(std::size_t c=0; c!=clusters.size(); ++c)
+	{
+		const shapes::ShapeCluster& cluster = clusters[c];
+		const shapes::DrawOperation& op = cluster_instr.Operations()[c];
+		BOOST_CHECK_EQUAL(op.first, cluster.first);
+		BOOST_CHECK_EQUAL(op.count, cluster.count);
+		BOOST_CHECK(op.mode == PrimitiveType::Triangles);
+
+		// the clusters are consecutive and within the limits
+		BOOST_CHECK_EQUAL(cluster.first, next);
+		next += cluster.count;
+		BOOST_CHECK(cluster.count > 0);
+		BOOST_CHECK(cluster.count <= max_triangles*3);
+		std::vector<GLuint> verts(
+			indices.begin()+cluster.first,
+			indices.begin()+cluster.first+cluster.count
+		);
+		std::sort(verts.begin(), verts.end());
+		verts.erase(std::unique(verts.begin(), verts.end()), verts.end());
+		BOOST_CHECK_EQUAL(verts.size(), cluster.vertex_count);
+		BOOST_CHECK(cluster.vertex_count <= max_vertices);
+
+		// the bounding sphere contains all vertices
+		for(auto v=verts.begin(); v!=verts.end(); ++v)
+		{
+			const Vec3f p(pos.data()+(*v)*npv, 3);
+			const GLfloat d = Distance(p, cluster.center);
+			BOOST_CHECK(d <= cluster.radius*1.0001f+1e-6f);
+		}
+
+		// the normal cone contains the normals of the faces
+		// and points in the direction of the vertex normals
+		if(cluster.cone_cutoff < 1.0f)
+		{
+			++culled;
+			const GLfloat min_dp = std::sqrt(
+				1.0f - cluster.cone_cutoff*cluster.cone_cutoff
+			);
+			for(GLuint i=0; i!=cluster.count; i+=3)
+			{
+				const GLuint* t = indices.data()+cluster.first+i;
+				const Vec3f a(pos.data()+t[0]*npv, 3);
+				const Vec3f b(pos.data()+t[1]*npv, 3);
+				const Vec3f d(pos.data()+t[2]*npv, 3);
+				const Vec3f n = Cross(b-a, d-a);
+				// skip the degenerate triangles at the poles
+				if(Length(n) < 1e-6f) continue;
+				BOOST_CHECK(
+					Dot(Normalized(n), cluster.cone_axis) >=
+					min_dp-1e-4f
+				);
+				const Vec3f vn(nml.data()+t[0]*3, 3);
+				BOOST_CHECK(Dot(vn, cluster.cone_axis) > 0.0f);
+			}
+		}
+	}
+	BOOST_CHECK_EQUAL(next, indices.size());
+	BOOST_CHECK(culled > clusters.size() / 2);
+}
+
+BOOST_AUTO_TEST_CASE(Clusters_sphere)
+{
+	do_test_clusters(oglplus::shapes::Sphere(1.0, 72, 48), 64, 126);
+	do_test_clusters(oglplus::shapes::Sphere(1.0, 18, 12), 3, 1);
+}
+
+BOOST_AUTO_TEST_CASE(Clusters_torus)
+{
+	do_test_clusters(oglplus::shapes::Torus(1.0, 0.5, 72, 48), 64, 126);
+	do_test_clusters(oglplus::shapes::Torus(1.0, 0.5, 36, 24), 32, 16);
+}
+
+BOOST_AUTO_TEST_CASE(Clusters_cull)
+{
+	using namespace oglplus;
+	shapes::ClusteredShape<shapes::Sphere> clustered(
+		shapes::Sphere(1.0, 72, 48)
+	);
+	const std::vector<shapes::ShapeCluster>& clusters = clustered.Clusters();
+	const std::vector<GLuint>& indices = clustered.Indices();
+	std::vector<GLfloat> pos;
+	clustered.Positions(pos);
+
+	const Vec3f camera(0.0f, 1.0f, 4.0f);
+	const Frustum<GLfloat> frustum(
+		CamMatrixf::PerspectiveX(Degrees(60), 1.0f, 1.0f, 10.0f)*
+		CamMatrixf::LookingAt(camera, Vec3f())
+	);
+	shapes::ShapeClusterCuller<GLfloat> culler(clusters);
+	BOOST_CHECK_EQUAL(culler.ClusterCount(), clusters.size());
+
+	// the whole sphere is inside of the frustum
+	BOOST_CHECK_EQUAL(culler.Cull(frustum), 1u);
+	BOOST_CHECK_EQUAL(culler.VisibleClusterCount(), clusters.size());
+	BOOST_CHECK_EQUAL(culler.Counts()[0], GLsizei(indices.size()));
+	BOOST_CHECK(culler.Indices()[0] == nullptr);
+
+	// the back side of the sphere is culled by the normal cones
+	const std::size_t ranges = culler.Cull(frustum, camera);
+	BOOST_CHECK_EQUAL(culler.RangeCount(), ranges);
+	BOOST_CHECK(culler.VisibleClusterCount() > clusters.size() / 3);
+	BOOST_CHECK(culler.VisibleClusterCount() < clusters.size() * 3 / 4);
+
+	// the ranges cover exactly the clusters which are not back-facing
+	std::vector<bool> visible(indices.size(), false);
+	GLsizei prev_end = -1;
+	for(std::size_t r=0; r!=ranges; ++r)
+	{
+		const GLsizei first = GLsizei(
+			reinterpret_cast<std::size_t>(culler.Indices()[r]) /
+			sizeof(GLuint)
+		);
+		const GLsizei count = culler.Counts()[r];
+		BOOST_CHECK(count > 0);
+		// the adjacent ranges are merged
+		BOOST_CHECK(first > prev_end);
+		prev_end = first + count;
+		std::fill(visible.begin()+first, visible.begin()+prev_end, true);
+	}
+	std::size_t visible_clusters = 0;
+	for(auto c=clusters.begin(); c!=clusters.end(); ++c)
+	{
+		const bool back_facing = c->BackFacing(camera);
+		if(!back_facing) ++visible_clusters;
+		for(GLuint i=c->first; i!=c->first+c->count; ++i)
+			BOOST_CHECK(visible[i] != back_facing);
+		if(!back_facing) continue;
+		// all triangles of the culled clusters are really back-facing
+		for(GLuint i=c->first; i!=c->first+c->count; i+=3)
+		{
+			const Vec3f a(pos.data()+indices[i+0]*3, 3);
+			const Vec3f b(pos.data()+indices[i+1]*3, 3);
+			const Vec3f d(pos.data()+indices[i+2]*3, 3);
+			const Vec3f n = Cross(b-a, d-a);
+			BOOST_CHECK(Dot(n, a-camera) >= 0.0f);
+		}
+	}
+	BOOST_CHECK_EQUAL(culler.VisibleClusterCount(), visible_clusters);
+
+	// nothing is visible when looking away from the sphere
+	const Frustum<GLfloat> away(
+		CamMatrixf::PerspectiveX(Degrees(60), 1.0f, 1.0f, 10.0f)*
+		CamMatrixf::LookingAt(camera, Vec3f(0.0f, 1.0f, 8.0f))
+	);
+	BOOST_CHECK_EQUAL(culler.Cull(away, camera), 0u);
+	BOOST_CHECK_EQUAL(culler.VisibleClusterCount(), 0u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
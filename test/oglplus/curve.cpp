@@ -0,0 +1,136 @@
+/**
+ *  .file test/oglplus/curve.cpp
+ *  .brief Test case for the Bezier curve classes.
+ *
+ *  .author Matus Chochlik
+ *
+ *  Copyright 2010-2013 Matus Chochlik. Distributed under the Boost
+ *  Software License, Version 1.0. (See accompanying file
+ *  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ */
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE OGLPLUS_Curve
+#include <boost/test/unit_test.hpp>
+
+#include <oglplus/gl.hpp>
+#include <oglplus/curve.hpp>
+
+#include <cstdlib>
+#include <cmath>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(Curve)
+
+static std::vector<oglplus::Vec2d> random_points(std::size_t n)
+{
+	std::vector<oglplus::Vec2d> result(n);
+	for(std::size_t i=0; i!=n; ++i)
+	{
+		result[i] = oglplus::Vec2d(
+			std::rand() % 1000,
+			std::rand() % 1000
+		);
+	}
+	return result;
+}
+
+template <unsigned Order>
+static void do_test_curve_approximate(void)
+{
+	using namespace oglplus;
+	BezierCurves<Vec2d, double, Order> curve(random_points(Order*4+1));
+	std::vector<Vec2d> points;
+	const unsigned n = 17;
+	curve.Approximate(points, n);
+	BOOST_CHECK_EQUAL(points.size(), curve.SegmentCount()*n+1);
+	for(unsigned i=0; i+1!=points.size(); ++i)
+	{
+		const double t = double(i)/(points.size()-1);
+		BOOST_CHECK(Distance(points[i], curve.Position01(t)) <= 1e-6);
+	}
+	BOOST_CHECK(points.back() == curve.ControlPoints().back());
+}
+
+BOOST_AUTO_TEST_CASE(Curve_approximate)
+{
+	do_test_curve_approximate<2>();
+	do_test_curve_approximate<3>();
+	do_test_curve_approximate<4>();
+}
+
+// distance of a point from a line segment
+static double segment_distance(
+	const oglplus::Vec2d& p,
+	const oglplus::Vec2d& a,
+	const oglplus::Vec2d& b
+)
+{
+	const oglplus::Vec2d ab = b - a;
+	double t = Dot(p - a, ab);
+	double l = Dot(ab, ab);
+	t = (l > 0.0)?t/l:0.0;
+	if(t < 0.0) t = 0.0;
+	if(t > 1.0) t = 1.0;
+	return Distance(p, a + ab*t);
+}
+
+template <unsigned Order>
+static void do_test_curve_adaptive(double tolerance)
+{
+	using namespace oglplus;
+	BezierCurves<Vec2d, double, Order> curve(random_points(Order*3+1));
+	std::vector<Vec2d> points;
+	curve.ApproximateAdaptive(points, tolerance);
+	BOOST_CHECK(points.size() >= curve.SegmentCount()+1);
+	BOOST_CHECK(points.front() == curve.ControlPoints().front());
+	BOOST_CHECK(points.back() == curve.ControlPoints().back());
+
+	const std::size_t samples = 2000;
+	for(std::size_t i=0; i!=samples; ++i)
+	{
+		const Vec2d p = curve.Position01(double(i)/samples);
+		double d = segment_distance(p, points[0], points[1]);
+		for(std::size_t j=2; j!=points.size(); ++j)
+		{
+			double dj = segment_distance(p, points[j-1], points[j]);
+			if(d > dj) d = dj;
+		}
+		BOOST_CHECK(d <= tolerance);
+	}
+
+	std::vector<Vec2d> coarse;
+	curve.ApproximateAdaptive(coarse, tolerance*10);
+	BOOST_CHECK(coarse.size() < points.size());
+}
+
+BOOST_AUTO_TEST_CASE(Curve_adaptive)
+{
+	do_test_curve_adaptive<2>(0.5);
+	do_test_curve_adaptive<3>(0.5);
+	do_test_curve_adaptive<3>(0.05);
+	do_test_curve_adaptive<5>(0.25);
+}
+
+BOOST_AUTO_TEST_CASE(Curve_loop_update)
+{
+	using namespace oglplus;
+	std::vector<Vec2d> points = random_points(7);
+	CubicBezierLoop<Vec2d, double> loop(points);
+	const Vec2d* storage = loop.ControlPoints().data();
+
+	points = random_points(7);
+	loop.Update(points);
+	CubicBezierLoop<Vec2d, double> expected(points);
+
+	BOOST_CHECK(loop.ControlPoints() == expected.ControlPoints());
+	BOOST_CHECK(loop.ControlPoints().data() == storage);
+	for(std::size_t i=0; i!=100; ++i)
+	{
+		BOOST_CHECK(Distance(
+			loop.Position(i*0.01),
+			expected.Position(i*0.01)
+		) <= 1e-9);
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,231 @@
+/**
+ *  .file test/oglplus/deferred_error.cpp
+ *  .brief Test case for the deferred GL error checks.
+ *
+ *  .author Matus Chochlik
+ *
+ *  Copyright 2010-2013 Matus Chochlik. Distributed under the Boost
+ *  Software License, Version 1.0. (See accompanying file
+ *  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ */
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE OGLPLUS_DeferredError
+#include <boost/test/unit_test.hpp>
+
+#define OGLPLUS_DEFERRED_ERROR_CHECKS 1
+#define OGLPLUS_DEFERRED_ERROR_HISTORY 4
+
+#include <oglplus/gl.hpp>
+#include <oglplus/error.hpp>
+#include <oglplus/buffer.hpp>
+#include <oglplus/vertex_array.hpp>
+#include <oglplus/program.hpp>
+#include <oglplus/program_cache.hpp>
+
+#include <fstream>
+#include <cstring>
+#if !OGLPLUS_NO_THREADS
+#include <thread>
+#endif
+
+#include "fixture.hpp"
+#include "mock_gl.hpp"
+
+BOOST_GLOBAL_FIXTURE(OGLplusTestFixture);
+
+BOOST_AUTO_TEST_SUITE(DeferredError)
+
+BOOST_AUTO_TEST_CASE(DeferredError_no_get_error)
+{
+	using namespace oglplus;
+	Buffer buffer;
+	VertexArray vao;
+	CheckDeferredErrors();
+
+	mock::ClearCalls();
+	vao.Bind();
+	buffer.Bind(Buffer::Target::Array);
+	Buffer::Data(Buffer::Target::Array, std::vector<GLfloat>(16));
+	Buffer::Unbind(Buffer::Target::Array);
+	VertexArray::Unbind();
+	BOOST_CHECK_EQUAL(mock::CallCount("glGetError"), 0u);
+	BOOST_CHECK_EQUAL(mock::CallCount("glGetIntegerv"), 0u);
+
+	CheckDeferredErrors();
+	BOOST_CHECK_EQUAL(mock::CallCount("glGetError"), 1u);
+}
+
+BOOST_AUTO_TEST_CASE(DeferredError_checkpoint)
+{
+	using namespace oglplus;
+	Buffer buffer;
+	CheckDeferredErrors();
+
+	bool thrown = false;
+	try
+	{
+		DeferredErrorCheckpoint checkpoint;
+		buffer.Bind(Buffer::Target::Array);
+		// no buffer is bound to the copy read target
+		Buffer::Data(Buffer::Target::CopyRead, std::vector<GLuint>(4));
+		buffer.Bind(Buffer::Target::ElementArray);
+		Buffer::Unbind(Buffer::Target::Array);
+	}
+	catch(Error& error)
+	{
+		thrown = true;
+		BOOST_CHECK_EQUAL(error.Code(), GLenum(GL_INVALID_OPERATION));
+		// the call which may fail due to run-time parameters
+		BOOST_CHECK(std::strcmp(error.GLSymbol(), "BufferData") == 0);
+#if !OGLPLUS_ERROR_NO_PROPERTIES
+		BOOST_CHECK_EQUAL(
+			error.Properties().at("DeferredCalls"),
+			"BindBuffer, BufferData, BindBuffer, BindBuffer"
+		);
+#endif
+	}
+	BOOST_CHECK(thrown);
+
+	// the errors were cleared by the checkpoint
+	BOOST_CHECK_NO_THROW(CheckDeferredErrors());
+}
+
+BOOST_AUTO_TEST_CASE(DeferredError_history)
+{
+	using namespace oglplus;
+	Buffer buffer;
+	CheckDeferredErrors();
+
+	mock::SetError(GL_INVALID_VALUE);
+	for(int i=0; i!=3; ++i)
+	{
+		buffer.Bind(Buffer::Target::Array);
+		buffer.Bind(Buffer::Target::ElementArray);
+	}
+
+	bool thrown = false;
+	try { CheckDeferredErrors(); }
+	catch(Error& error)
+	{
+		thrown = true;
+		BOOST_CHECK_EQUAL(error.Code(), GLenum(GL_INVALID_VALUE));
+		// only the most recent calls are remembered
+#if !OGLPLUS_ERROR_NO_PROPERTIES
+		BOOST_CHECK_EQUAL(
+			error.Properties().at("DeferredCalls"),
+			"..., BindBuffer, BindBuffer, BindBuffer, BindBuffer"
+		);
+#endif
+	}
+	BOOST_CHECK(thrown);
+
+	// ignoring the unchecked calls
+	buffer.Bind(Buffer::Target::Array);
+	ForgetDeferredErrors();
+	BOOST_CHECK_NO_THROW(CheckDeferredErrors());
+}
+
+BOOST_AUTO_TEST_CASE(DeferredError_multiple_errors)
+{
+	using namespace oglplus;
+	Buffer buffer;
+	CheckDeferredErrors();
+
+	mock::SetError(GL_INVALID_VALUE);
+	mock::SetError(GL_INVALID_ENUM);
+	mock::SetError(GL_OUT_OF_MEMORY);
+	buffer.Bind(Buffer::Target::Array);
+
+	bool thrown = false;
+	try { CheckDeferredErrors(); }
+	catch(Error& error)
+	{
+		thrown = true;
+		// the first error is reported, the others are attached
+		BOOST_CHECK_EQUAL(error.Code(), GLenum(GL_INVALID_VALUE));
+#if !OGLPLUS_ERROR_NO_PROPERTIES
+		BOOST_CHECK_EQUAL(
+			error.Properties().at("DeferredErrors"),
+			"INVALID_ENUM, OUT_OF_MEMORY"
+		);
+#endif
+	}
+	BOOST_CHECK(thrown);
+
+	// all error flags were cleared by the checkpoint
+	BOOST_CHECK_NO_THROW(CheckDeferredErrors());
+}
+
+BOOST_AUTO_TEST_CASE(DeferredError_ignore)
+{
+	using namespace oglplus;
+	Buffer buffer;
+	CheckDeferredErrors();
+
+	// the ignored calls do not drain the errors of the unchecked calls
+	buffer.Bind(Buffer::Target::Array);
+	mock::SetError(GL_INVALID_OPERATION);
+	mock::ClearCalls();
+	OGLPLUS_IGNORE(OGLPLUS_ERROR_INFO(UnmapBuffer));
+	BOOST_CHECK_EQUAL(mock::CallCount("glGetError"), 0u);
+	BOOST_CHECK_THROW(CheckDeferredErrors(), Error);
+}
+
+BOOST_AUTO_TEST_CASE(DeferredError_program_cache)
+{
+	using namespace oglplus;
+	oglplus::ProgramCache cache(".");
+	ProgramSource source;
+	source.AddShader(ShaderType::Vertex, "void main(void){ }");
+	source.AddShader(ShaderType::Fragment, "void main(void){ }");
+	cache.Forget(source);
+
+	Program first;
+	BOOST_CHECK(!cache.Build(first, source));
+	CheckDeferredErrors();
+
+	// change the stored binary format to one not supported by GL
+	{
+		std::fstream file(
+			cache.Path(source).c_str(),
+			std::ios::in | std::ios::out | std::ios::binary
+		);
+		const std::streamoff format_pos = 16+sizeof(unsigned long long);
+		const GLenum format = GL_NONE;
+		file.seekp(format_pos);
+		file.write(reinterpret_cast<const char*>(&format), sizeof(format));
+	}
+
+	// the rejected binary is rebuilt and its error is not reported
+	Program second;
+	BOOST_CHECK(!cache.Build(second, source));
+	BOOST_CHECK_EQUAL(cache.Rejected(), 1u);
+	BOOST_CHECK(second.IsLinked());
+	BOOST_CHECK_NO_THROW(CheckDeferredErrors());
+
+	cache.Forget(source);
+}
+
+#if !OGLPLUS_NO_THREAD_LOCAL
+BOOST_AUTO_TEST_CASE(DeferredError_per_thread)
+{
+	using namespace oglplus;
+	Buffer buffer;
+	CheckDeferredErrors();
+	buffer.Bind(Buffer::Target::Array);
+	BOOST_CHECK_EQUAL(aux::_deferred_errors().Size(), 1u);
+
+	// each thread remembers its own unchecked calls
+	std::size_t other_size = 1;
+	std::thread other([&other_size](void)
+	{
+		other_size = aux::_deferred_errors().Size();
+	});
+	other.join();
+	BOOST_CHECK_EQUAL(other_size, 0u);
+	BOOST_CHECK_EQUAL(aux::_deferred_errors().Size(), 1u);
+	CheckDeferredErrors();
+}
+#endif
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,54 @@
+/*
+ *  .file test/oglplus/fixture_mock.cpp
+ *  Implements the test fixture using the recording mock GL
+ *
+ *  Copyright 2010-2013 Matus Chochlik. Distributed under the Boost
+ *  Software License, Version 1.0. (See accompanying file
+ *  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ */
+
+#include <oglplus/gl.hpp>
+#include <oglplus/config.hpp>
+
+#include <cstdlib>
+#include <iostream>
+
+#include "fixture.hpp"
+#include "mock_gl.hpp"
+
+namespace oglplus {
+
+// there is no context to be created, the mock GL is just reset.
+// If the OGLPLUS_MOCK_GL_REPORT environment variable is set then
+// the statistics of the GL calls are printed when the test ends.
+class MockTestFixture
+{
+public:
+	MockTestFixture(void)
+	{
+		mock::Reset();
+	}
+
+	~MockTestFixture(void)
+	{
+		if(std::getenv("OGLPLUS_MOCK_GL_REPORT"))
+			mock::Report(std::clog);
+	}
+};
+
+TestFixture::TestFixture(void)
+ : _pimpl(static_cast<void*>(new MockTestFixture()))
+{ }
+
+TestFixture::TestFixture(TestFixture&& tmp)
+ : _pimpl(tmp._pimpl)
+{
+	tmp._pimpl = nullptr;
+}
+
+TestFixture::~TestFixture(void)
+{
+	if(_pimpl) delete static_cast<MockTestFixture*>(_pimpl);
+}
+
+} // namespace oglplus
@@ -0,0 +1,193 @@
+/**
+ *  .file test/oglplus/frustum.cpp
+ *  .brief Test case for the Frustum class and bounding volume culling.
+ *
+ *  .author Matus Chochlik
+ *
+ *  Copyright 2010-2013 Matus Chochlik. Distributed under the Boost
+ *  Software License, Version 1.0. (See accompanying file
+ *  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ */
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE OGLPLUS_Frustum
+#include <boost/test/unit_test.hpp>
+
+#include <oglplus/gl.hpp>
+#include <oglplus/frustum.hpp>
+
+#include <cmath>
+#include <vector>
+
+#include "random_values.hpp"
+
+BOOST_AUTO_TEST_SUITE(Frustum)
+
+template <typename T>
+static oglplus::Matrix<T, 4, 4> view_projection(void)
+{
+	using namespace oglplus;
+	return CameraMatrix<T>::PerspectiveX(Degrees(T(70)), T(1.3), T(1), T(50))*
+		CameraMatrix<T>::LookingAt(
+			Vector<T, 3>(T(3), T(4), T(5)),
+			Vector<T, 3>(T(0), T(1), T(0))
+		);
+}
+
+// transforms a point to normalized device coordinates
+template <typename T>
+static oglplus::Vector<T, 3> project(
+	const oglplus::Matrix<T, 4, 4>& m,
+	const oglplus::Vector<T, 3>& p
+)
+{
+	oglplus::Vector<T, 4> c = m*oglplus::Vector<T, 4>(p, T(1));
+	return c.xyz()/c.w();
+}
+
+template <typename T>
+static bool inside_ndc(const oglplus::Vector<T, 3>& p)
+{
+	return	(std::fabs(p.x()) <= T(1)) &&
+		(std::fabs(p.y()) <= T(1)) &&
+		(std::fabs(p.z()) <= T(1));
+}
+
+template <typename T>
+static void do_test_frustum_spheres(std::size_t count)
+{
+	using namespace oglplus;
+	const Matrix<T, 4, 4> vp = view_projection<T>();
+	const oglplus::Frustum<T> frustum(vp);
+
+	BoundingSphereArrays<T> spheres;
+	for(std::size_t i=0; i!=count; ++i)
+	{
+		spheres.Append(
+			Vector<T, 3>(
+				random_value<T>()*T(60),
+				random_value<T>()*T(60),
+				random_value<T>()*T(60)
+			),
+			random_value<T>()*T(2)+T(2)
+		);
+	}
+	std::vector<std::uint32_t> mask;
+	frustum.Cull(spheres, mask);
+	BOOST_CHECK_EQUAL(mask.size(), (count+31)/32);
+
+	std::vector<unsigned> indices;
+	std::size_t visible = frustum.CullIndices(spheres, indices);
+	BOOST_CHECK_EQUAL(visible, indices.size());
+	// the storage for all spheres is reserved up front
+	BOOST_CHECK(indices.capacity() >= count);
+
+	std::size_t j = 0, n = 0;
+	for(std::size_t i=0; i!=count; ++i)
+	{
+		const Sphere<T> s = spheres.At(i);
+		const bool bit = (mask[i/32] & (1u << (i%32))) != 0;
+		BOOST_CHECK_EQUAL(bit, frustum.Intersects(s));
+		if(bit)
+		{
+			++n;
+			BOOST_CHECK(j < indices.size() && indices[j] == i);
+			++j;
+		}
+		// spheres with the center inside must be visible
+		if(inside_ndc(project(vp, s.Center())))
+			BOOST_CHECK(bit);
+		// spheres completely behind a plane must be culled
+		for(std::size_t p=0; p!=oglplus::Frustum<T>::PlaneCount; ++p)
+		{
+			const Vector<T, 4> e = frustum.PlaneAt(p).Equation();
+			const T d = Dot(e.xyz(), s.Center()) + e.w();
+			if(d < -s.Radius()-T(1e-3))
+				BOOST_CHECK(!bit);
+		}
+	}
+	BOOST_CHECK_EQUAL(n, visible);
+	if(count > 100) BOOST_CHECK(n > 0 && n < count);
+}
+
+template <typename T>
+static void do_test_frustum_boxes(std::size_t count)
+{
+	using namespace oglplus;
+	const Matrix<T, 4, 4> vp = view_projection<T>();
+	const oglplus::Frustum<T> frustum(vp);
+
+	BoundingBoxArrays<T> boxes;
+	BoundingSphereArrays<T> spheres;
+	for(std::size_t i=0; i!=count; ++i)
+	{
+		const Vector<T, 3> c(
+			random_value<T>()*T(60),
+			random_value<T>()*T(60),
+			random_value<T>()*T(60)
+		);
+		const Vector<T, 3> h(
+			random_value<T>()*T(2)+T(2),
+			random_value<T>()*T(2)+T(2),
+			random_value<T>()*T(2)+T(2)
+		);
+		boxes.Append(c-h, c+h);
+		spheres.Append(c, Length(h));
+	}
+	std::vector<std::uint32_t> box_mask, sphere_mask;
+	frustum.Cull(boxes, box_mask);
+	frustum.Cull(spheres, sphere_mask);
+
+	std::vector<unsigned> indices;
+	frustum.CullIndices(boxes, indices);
+	std::size_t j = 0;
+	for(std::size_t i=0; i!=count; ++i)
+	{
+		const bool bit = (box_mask[i/32] & (1u << (i%32))) != 0;
+		// the bounding sphere of a box is never culled if the box is not
+		if(bit) BOOST_CHECK(sphere_mask[i/32] & (1u << (i%32)));
+		const Vector<T, 3> c = (boxes.Min(i)+boxes.Max(i))/T(2);
+		if(inside_ndc(project(vp, c)))
+			BOOST_CHECK(bit);
+		if(bit)
+		{
+			BOOST_CHECK(j < indices.size() && indices[j] == i);
+			++j;
+		}
+	}
+	BOOST_CHECK_EQUAL(j, indices.size());
+}
+
+BOOST_AUTO_TEST_CASE(Frustum_planes)
+{
+	using namespace oglplus;
+	const Mat4f vp = CameraMatrix<float>::Ortho(-2, 2, -1, 1, 1, 10);
+	const oglplus::Frustum<float> frustum(vp);
+	// the orthographic camera looks along the negative z axis
+	const Vec4f l = frustum.PlaneAt(oglplus::Frustum<float>::Left).Equation();
+	BOOST_CHECK(std::fabs(l.x() - 1) < 1e-6f);
+	BOOST_CHECK(std::fabs(l.w() - 2) < 1e-6f);
+	const Vec4f n = frustum.PlaneAt(oglplus::Frustum<float>::Near).Equation();
+	BOOST_CHECK(std::fabs(n.z() + 1) < 1e-6f);
+	BOOST_CHECK(std::fabs(n.w() + 1) < 1e-6f);
+
+	BOOST_CHECK( frustum.Intersects(Spheref(0, 0, -5, 0.1f)));
+	BOOST_CHECK( frustum.Intersects(Spheref(0, 0, 0, 1.5f)));
+	BOOST_CHECK(!frustum.Intersects(Spheref(0, 0, 0, 0.5f)));
+	BOOST_CHECK(!frustum.Intersects(Spheref(3, 0, -5, 0.5f)));
+	BOOST_CHECK( frustum.Intersects(Spheref(2.4f, 0, -5, 0.5f)));
+}
+
+BOOST_AUTO_TEST_CASE(Frustum_spheres)
+{
+	do_test_frustum_spheres<float>(1);
+	do_test_frustum_spheres<float>(5003);
+	do_test_frustum_spheres<double>(1001);
+}
+
+BOOST_AUTO_TEST_CASE(Frustum_boxes)
+{
+	do_test_frustum_boxes<float>(5003);
+	do_test_frustum_boxes<double>(1001);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,282 @@
+/**
+ *  .file test/oglplus/gl_calls.cpp
+ *  .brief Test case for the number of GL calls issued by the wrappers.
+ *
+ *  .author Matus Chochlik
+ *
+ *  Copyright 2010-2013 Matus Chochlik. Distributed under the Boost
+ *  Software License, Version 1.0. (See accompanying file
+ *  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ */
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE OGLPLUS_GLCalls
+#include <boost/test/unit_test.hpp>
+
+#include <oglplus/gl.hpp>
+#include <oglplus/buffer.hpp>
+#include <oglplus/exposed.hpp>
+#include <oglplus/shapes/batch.hpp>
+#include <oglplus/shapes/wrapper.hpp>
+#include <oglplus/shapes/cube.hpp>
+#include <oglplus/shapes/sphere.hpp>
+#include <oglplus/shapes/torus.hpp>
+
+#include <vector>
+#include <array>
+#include <stdexcept>
+#include <cstring>
+
+#include "fixture.hpp"
+#include "mock_gl.hpp"
+
+BOOST_GLOBAL_FIXTURE(OGLplusTestFixture);
+
+BOOST_AUTO_TEST_SUITE(GLCalls)
+
+BOOST_AUTO_TEST_CASE(GLCalls_Buffer_lifetime)
+{
+	using namespace oglplus;
+	mock::ClearCalls();
+	GLuint name = 0;
+	{
+		Buffer buffer;
+		name = Expose(buffer).Name();
+		BOOST_CHECK_EQUAL(mock::CallCount("glGenBuffers"), 1u);
+		BOOST_CHECK_EQUAL(mock::CallCount("glDeleteBuffers"), 0u);
+	}
+	BOOST_CHECK(name != 0);
+	BOOST_CHECK_EQUAL(mock::CallCount("glDeleteBuffers"), 1u);
+	// the creation is checked, the cleanup is verified only in debug builds
+	BOOST_CHECK(mock::CallCount("glGetError") >= 1u);
+	BOOST_CHECK(mock::CallCount("glGetError") <= 2u);
+}
+
+BOOST_AUTO_TEST_CASE(GLCalls_Buffer_Data)
+{
+	using namespace oglplus;
+	Buffer buffer;
+	const GLuint name = Expose(buffer).Name();
+
+	mock::ClearCalls();
+	buffer.Bind(Buffer::Target::Array);
+	BOOST_CHECK_EQUAL(mock::BoundBuffer(GL_ARRAY_BUFFER), name);
+	BOOST_CHECK_EQUAL(mock::CallCount("glBindBuffer"), 1u);
+	BOOST_CHECK_EQUAL(mock::CallCount(), 2u);
+
+	const GLfloat data[6] = {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f};
+	mock::ClearCalls();
+	Buffer::Data(Buffer::Target::Array, data, BufferUsage::DynamicDraw);
+	BOOST_CHECK_EQUAL(mock::CallCount("glBufferData"), 1u);
+	BOOST_CHECK_EQUAL(mock::CallCount(), 2u);
+	BOOST_CHECK_EQUAL(mock::BufferUsage(name), GLenum(GL_DYNAMIC_DRAW));
+
+	const std::vector<GLubyte>& contents = mock::BufferData(name);
+	BOOST_CHECK_EQUAL(contents.size(), sizeof(data));
+	BOOST_CHECK(std::memcmp(contents.data(), data, sizeof(data)) == 0);
+
+	const GLfloat sub_data[2] = {7.0f, 8.0f};
+	Buffer::SubData(Buffer::Target::Array, 2, 2, sub_data);
+	GLfloat result[6];
+	std::memcpy(result, mock::BufferData(name).data(), sizeof(result));
+	BOOST_CHECK_EQUAL(result[1], 2.0f);
+	BOOST_CHECK_EQUAL(result[2], 7.0f);
+	BOOST_CHECK_EQUAL(result[3], 8.0f);
+	BOOST_CHECK_EQUAL(result[4], 5.0f);
+
+	Buffer::Unbind(Buffer::Target::Array);
+	BOOST_CHECK_EQUAL(mock::BoundBuffer(GL_ARRAY_BUFFER), 0u);
+}
+
+// a minimal contiguous range which is not a standard container
+struct GLCalls_Span
+{
+	const GLuint* ptr;
+	std::size_t count;
+
+	const GLuint* data(void) const { return ptr; }
+	std::size_t size(void) const { return count; }
+};
+
+BOOST_AUTO_TEST_CASE(GLCalls_Buffer_Ranges)
+{
+	using namespace oglplus;
+	Buffer buffer;
+	const GLuint name = Expose(buffer).Name();
+	buffer.Bind(Buffer::Target::Array);
+
+	const std::array<GLuint, 6> data = {{1, 2, 3, 4, 5, 6}};
+	mock::ClearCalls();
+	Buffer::Data(Buffer::Target::Array, data);
+	BOOST_CHECK_EQUAL(mock::CallCount("glBufferData"), 1u);
+	BOOST_CHECK_EQUAL(mock::BufferData(name).size(), sizeof(data));
+
+	const GLuint sub_data[3] = {7, 8, 9};
+	GLCalls_Span span = {sub_data, 2};
+	Buffer::SubData(Buffer::Target::Array, 3, span);
+	GLuint result[6];
+	std::memcpy(result, mock::BufferData(name).data(), sizeof(result));
+	BOOST_CHECK_EQUAL(result[2], 3u);
+	BOOST_CHECK_EQUAL(result[3], 7u);
+	BOOST_CHECK_EQUAL(result[4], 8u);
+	BOOST_CHECK_EQUAL(result[5], 6u);
+
+	// the data are generated directly into the mapped buffer
+	mock::ClearCalls();
+	Buffer::Data<GLfloat>(
+		Buffer::Target::Array,
+		4,
+		[](GLfloat* values, std::size_t count)
+		{
+			for(std::size_t i=0; i!=count; ++i)
+				values[i] = GLfloat(i)*0.5f;
+		},
+		BufferUsage::DynamicDraw
+	);
+	BOOST_CHECK_EQUAL(mock::CallCount("glBufferData"), 1u);
+	BOOST_CHECK_EQUAL(mock::CallCount("glMapBufferRange"), 1u);
+	BOOST_CHECK_EQUAL(mock::CallCount("glUnmapBuffer"), 1u);
+	BOOST_CHECK(!Buffer::Mapped(Buffer::Target::Array));
+	GLfloat values[4];
+	BOOST_CHECK_EQUAL(mock::BufferData(name).size(), sizeof(values));
+	std::memcpy(values, mock::BufferData(name).data(), sizeof(values));
+	BOOST_CHECK_EQUAL(values[0], 0.0f);
+	BOOST_CHECK_EQUAL(values[3], 1.5f);
+
+	// the offset and size of typed mappings are in units of the type
+	{
+		Buffer::TypedMap<GLfloat> map(
+			Buffer::Target::Array,
+			2, 1,
+			BufferMapAccess::Write
+		);
+		BOOST_CHECK_EQUAL(map.Size(), GLsizeiptr(sizeof(GLfloat)));
+		map.At(0) = 7.0f;
+	}
+	std::memcpy(values, mock::BufferData(name).data(), sizeof(values));
+	BOOST_CHECK_EQUAL(values[1], 0.5f);
+	BOOST_CHECK_EQUAL(values[2], 7.0f);
+
+	// the buffer is unmapped if the writer throws
+	BOOST_CHECK_THROW(
+		Buffer::Data<GLfloat>(
+			Buffer::Target::Array,
+			4,
+			[](GLfloat*, std::size_t)
+			{
+				throw std::runtime_error("failed");
+			}
+		),
+		std::runtime_error
+	);
+	BOOST_CHECK(!Buffer::Mapped(Buffer::Target::Array));
+
+	// the corruption of the data while mapped is reported
+	mock::ClearCalls();
+	BOOST_CHECK_THROW(
+		Buffer::Data<GLfloat>(
+			Buffer::Target::Array,
+			4,
+			[](GLfloat*, std::size_t)
+			{
+				mock::CorruptMappedBuffers();
+			}
+		),
+		Error
+	);
+	BOOST_CHECK(!Buffer::Mapped(Buffer::Target::Array));
+	BOOST_CHECK_EQUAL(mock::CallCount("glUnmapBuffer"), 1u);
+}
+
+BOOST_AUTO_TEST_CASE(GLCalls_Error)
+{
+	using namespace oglplus;
+	Buffer buffer;
+	mock::SetError(GL_INVALID_OPERATION);
+	BOOST_CHECK_THROW(buffer.Bind(Buffer::Target::Array), Error);
+
+	// no buffer is bound to the copy read target
+	GLenum code = GL_NO_ERROR;
+	try
+	{
+		Buffer::Data(Buffer::Target::CopyRead, std::vector<GLuint>(4));
+	}
+	catch(Error& error)
+	{
+		code = error.Code();
+	}
+	BOOST_CHECK_EQUAL(code, GLenum(GL_INVALID_OPERATION));
+	BOOST_CHECK_EQUAL(mock::BoundBuffer(GL_COPY_READ_BUFFER), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(GLCalls_ShapeBatch_Draw)
+{
+	using namespace oglplus;
+	shapes::ShapeBatchBuilder builder({"Position", "Normal"});
+	builder.Add(shapes::Cube());
+	builder.Add(shapes::Sphere(1.0, 12, 8));
+	builder.Add(shapes::Torus(1.0, 0.5, 12, 8), 4, 1);
+	builder.Add(shapes::Cube());
+
+	for(int indirect=0; indirect!=2; ++indirect)
+	{
+		// the batch leaves its element buffer bound to the default VAO
+		shapes::ShapeBatch batch(builder, indirect != 0);
+		BOOST_CHECK_EQUAL(mock::BoundVertexArray(), 0u);
+		BOOST_CHECK(mock::BoundBuffer(GL_ELEMENT_ARRAY_BUFFER) != 0);
+
+		mock::ClearCalls();
+		batch.Draw();
+
+		std::size_t draw_calls = 0;
+		const std::vector<mock::GLCall>& calls = mock::Calls();
+		for(auto i=calls.begin(); i!=calls.end(); ++i)
+		{
+			if(std::strstr(i->name, "glDraw") == i->name) ++draw_calls;
+			if(std::strstr(i->name, "glMultiDraw") == i->name) ++draw_calls;
+		}
+		BOOST_CHECK_EQUAL(draw_calls, batch.DrawCallCount());
+		if(batch.Indirect())
+		{
+			BOOST_CHECK_EQUAL(
+				mock::CallCount("glMultiDrawElementsIndirect"),
+				batch.DrawCallCount()
+			);
+		}
+		else BOOST_CHECK(mock::CallCount("glMultiDrawElementsBaseVertex") > 0);
+		// the batch uses primitive restart
+		BOOST_CHECK_EQUAL(mock::CallCount("glEnable"), 1u);
+		BOOST_CHECK_EQUAL(mock::CallCount("glDisable"), 1u);
+		// the mock validates the ranges of the element and indirect buffers
+		// and all draw calls are followed by an error check
+		BOOST_CHECK_EQUAL(
+			mock::CallCount("glGetError"),
+			draw_calls + 2 + (batch.Indirect()?1:0) +
+			mock::CallCount("glPrimitiveRestartIndex")
+		);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(GLCalls_ShapeWrapper_Draw)
+{
+	using namespace oglplus;
+	const shapes::Sphere sphere(1.0, 12, 8);
+	const std::size_t op_count = sphere.Instructions().Operations().size();
+
+	shapes::ShapeWrapper shape({"Position"}, sphere);
+	mock::ClearCalls();
+	shape.Draw();
+	BOOST_CHECK_EQUAL(mock::CallCount("glDrawElements"), op_count);
+
+	shape.UseIndirect(3, 1);
+	BOOST_CHECK(shape.IsIndirect());
+	mock::ClearCalls();
+	shape.Draw();
+	BOOST_CHECK_EQUAL(mock::CallCount("glDrawElements"), 0u);
+	BOOST_CHECK_EQUAL(mock::CallCount("glDrawElementsIndirect"), op_count);
+	BOOST_CHECK_EQUAL(
+		mock::BoundBuffer(GL_DRAW_INDIRECT_BUFFER),
+		Expose(shape.IndirectBuffer()).Name()
+	);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,142 @@
+/**
+ *  .file test/oglplus/lod.cpp
+ *  .brief Test case for the generation of levels of detail of shapes.
+ *
+ *  .author Matus Chochlik
+ *
+ *  Copyright 2010-2013 Matus Chochlik. Distributed under the Boost
+ *  Software License, Version 1.0. (See accompanying file
+ *  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ */
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE OGLPLUS_LOD
+#include <boost/test/unit_test.hpp>
+
+#include <oglplus/gl.hpp>
+#include <oglplus/shapes/lod.hpp>
+#include <oglplus/shapes/sphere.hpp>
+#include <oglplus/shapes/plane.hpp>
+
+#include <vector>
+#include <cmath>
+
+BOOST_AUTO_TEST_SUITE(LOD)
+
+static void tri_normal(
+	const std::vector<GLdouble>& pos,
+	const GLuint* tri,
+	GLdouble n[3],
+	GLdouble c[3]
+)
+{
+	GLdouble e1[3], e2[3];
+	for(GLuint k=0; k!=3; ++k)
+	{
+		e1[k] = pos[tri[1]*3+k] - pos[tri[0]*3+k];
+		e2[k] = pos[tri[2]*3+k] - pos[tri[0]*3+k];
+		c[k] = (pos[tri[0]*3+k]+pos[tri[1]*3+k]+pos[tri[2]*3+k])/3;
+	}
+	n[0] = e1[1]*e2[2] - e1[2]*e2[1];
+	n[1] = e1[2]*e2[0] - e1[0]*e2[2];
+	n[2] = e1[0]*e2[1] - e1[1]*e2[0];
+}
+
+BOOST_AUTO_TEST_CASE(LOD_sphere)
+{
+	using namespace oglplus;
+	std::vector<GLuint> counts;
+	counts.push_back(800);
+	counts.push_back(200);
+	counts.push_back(100);
+	shapes::LODChain<shapes::Sphere> lods(
+		shapes::Sphere(1.0, 36, 24),
+		counts
+	);
+	BOOST_CHECK_EQUAL(lods.LevelCount(), 4u);
+
+	std::vector<GLdouble> pos;
+	BOOST_CHECK_EQUAL(lods.Positions(pos), 3u);
+	const GLuint vertex_count = GLuint(pos.size() / 3);
+
+	const std::vector<GLuint>& indices = lods.Indices();
+	auto instr = lods.Instructions();
+	BOOST_CHECK_EQUAL(instr.Operations().size(), lods.LevelCount());
+
+	for(GLuint level=0; level!=lods.LevelCount(); ++level)
+	{
+		const shapes::DrawOperation& op = instr.Operations()[level];
+		BOOST_CHECK_EQUAL(op.phase, level);
+		BOOST_CHECK(op.mode == PrimitiveType::Triangles);
+		BOOST_CHECK_EQUAL(op.count, lods.TriangleCount(level)*3);
+		if(level > 0)
+		{
+			BOOST_CHECK(
+				lods.TriangleCount(level) <=
+				counts[level-1]
+			);
+			BOOST_CHECK(
+				lods.TriangleCount(level) <
+				lods.TriangleCount(level-1)
+			);
+			BOOST_CHECK(lods.Error(level) >= lods.Error(level-1));
+		}
+
+		for(GLuint t=0; t!=op.count/3; ++t)
+		{
+			const GLuint* tri = indices.data()+op.first+t*3;
+			for(GLuint k=0; k!=3; ++k)
+				BOOST_CHECK(tri[k] < vertex_count);
+			// the triangles are not flipped (the slivers along
+			// the texture seam are perpendicular to the surface)
+			// and do not cut deep into the sphere
+			GLdouble n[3], c[3];
+			tri_normal(pos, tri, n, c);
+			BOOST_CHECK(n[0]*c[0]+n[1]*c[1]+n[2]*c[2] > -1e-9);
+			BOOST_CHECK(std::sqrt(c[0]*c[0]+c[1]*c[1]+c[2]*c[2]) > 0.6);
+		}
+	}
+	BOOST_CHECK(lods.TriangleCount(3) > 20);
+}
+
+BOOST_AUTO_TEST_CASE(LOD_plane)
+{
+	using namespace oglplus;
+	std::vector<shapes::LODLevel> levels;
+	levels.push_back(shapes::LODLevel::MaxError(1e-9));
+	shapes::LODChain<shapes::Plane> lods(shapes::Plane(8, 8), levels);
+	BOOST_CHECK_EQUAL(lods.LevelCount(), 2u);
+	BOOST_CHECK_EQUAL(lods.TriangleCount(0), 8u*8u*2u);
+	// a flat plane can be simplified without any error
+	BOOST_CHECK(lods.TriangleCount(1) < 16u);
+	BOOST_CHECK(lods.Error(1) <= 1e-9);
+
+	std::vector<GLdouble> pos;
+	lods.Positions(pos);
+	const std::vector<GLuint>& indices = lods.Indices();
+	GLdouble area[2] = {0.0, 0.0};
+	for(GLuint level=0; level!=2; ++level)
+	{
+		auto instr = lods.Instructions(level);
+		const shapes::DrawOperation& op = instr.Operations().front();
+		for(GLuint t=0; t!=op.count/3; ++t)
+		{
+			GLdouble n[3], c[3];
+			tri_normal(pos, indices.data()+op.first+t*3, n, c);
+			// the plane faces the +y axis with clockwise winding
+			BOOST_CHECK(n[1] < 0);
+			area[level] += std::sqrt(n[0]*n[0]+n[1]*n[1]+n[2]*n[2])/2;
+		}
+	}
+	// the borders are preserved
+	BOOST_CHECK(std::fabs(area[0] - area[1]) < 1e-9);
+}
+
+BOOST_AUTO_TEST_CASE(LOD_selector)
+{
+	oglplus::shapes::LODSelector select(2);
+	BOOST_CHECK(!select(0));
+	BOOST_CHECK(!select(1));
+	BOOST_CHECK(select(2));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
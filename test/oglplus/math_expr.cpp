@@ -0,0 +1,110 @@
+/**
+ *  .file test/oglplus/math_expr.cpp
+ *  .brief Test case for lazily evaluated Vector and Matrix expressions.
+ *
+ *  .author Matus Chochlik
+ *
+ *  Copyright 2010-2013 Matus Chochlik. Distributed under the Boost
+ *  Software License, Version 1.0. (See accompanying file
+ *  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ */
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE OGLPLUS_MathExpr
+#include <boost/test/unit_test.hpp>
+
+#include <oglplus/gl.hpp>
+#include <oglplus/math_expr.hpp>
+
+#include <cmath>
+
+#include "random_values.hpp"
+
+BOOST_AUTO_TEST_SUITE(MathExpr)
+
+template <typename T, std::size_t N>
+static oglplus::Vector<T, N> random_vector(void)
+{
+	T v[N];
+	for(std::size_t i=0; i!=N; ++i)
+		v[i] = random_value<T>();
+	return oglplus::Vector<T, N>(v);
+}
+
+template <typename T, std::size_t N>
+static bool close(const oglplus::Vector<T, N>& a, const oglplus::Vector<T, N>& b)
+{
+	for(std::size_t i=0; i!=N; ++i)
+		if(std::fabs(a[i] - b[i]) > T(1e-5))
+			return false;
+	return true;
+}
+
+template <typename T, std::size_t N>
+static void do_test_vector_expr(void)
+{
+	using namespace oglplus;
+	typedef Vector<T, N> Vec;
+	for(std::size_t n=0; n!=100; ++n)
+	{
+		const Vec a = random_vector<T, N>();
+		const Vec b = random_vector<T, N>();
+		const Vec c = random_vector<T, N>();
+		const T s = random_value<T>();
+		const T d = random_value<T>() + T(3);
+
+		Vec r = Lazy(a)*s + b - c;
+		BOOST_CHECK(close(r, a*s + b - c));
+
+		r = -Lazy(a) + s*Lazy(b)/d;
+		BOOST_CHECK(close(r, -a + b*s/d));
+
+		r = a - (Lazy(b) - c)*s;
+		BOOST_CHECK(close(r, a - (b - c)*s));
+
+		BOOST_CHECK(close(Eval(Lazy(a) + Lazy(b)), a + b));
+
+		BOOST_CHECK(
+			std::fabs(Dot(Lazy(a) - b, c + Lazy(b)) - Dot(a-b, c+b)) <=
+			T(1e-5)
+		);
+
+		Vec x = a;
+		Assign(x, Lazy(x)*s + b);
+		BOOST_CHECK(close(x, a*s + b));
+	}
+}
+
+BOOST_AUTO_TEST_CASE(MathExpr_vector)
+{
+	do_test_vector_expr<float, 2>();
+	do_test_vector_expr<float, 3>();
+	do_test_vector_expr<float, 4>();
+	do_test_vector_expr<double, 3>();
+	do_test_vector_expr<double, 4>();
+	do_test_vector_expr<double, 6>();
+}
+
+BOOST_AUTO_TEST_CASE(MathExpr_matrix)
+{
+	using namespace oglplus;
+	for(std::size_t n=0; n!=100; ++n)
+	{
+		Matrix<double, 2, 3> a, b, c;
+		for(std::size_t i=0; i!=2; ++i)
+		for(std::size_t j=0; j!=3; ++j)
+		{
+			a.Set(i, j, random_value<double>());
+			b.Set(i, j, random_value<double>());
+			c.Set(i, j, random_value<double>());
+		}
+		const double s = random_value<double>();
+
+		Matrix<double, 2, 3> r = Lazy(a)*s + b - c;
+		Matrix<double, 2, 3> e = a*s + b - c;
+		for(std::size_t i=0; i!=2; ++i)
+		for(std::size_t j=0; j!=3; ++j)
+			BOOST_CHECK(std::fabs(r.At(i, j) - e.At(i, j)) <= 1e-12);
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -1121,6 +1121,47 @@ BOOST_AUTO_TEST_CASE(Matrix_multiplication)
 	do_test_matrix_multiplication<double, 4, 4, 4, 4>();
 }
 
+BOOST_AUTO_TEST_CASE(Matrix_multiplication_float)
+{
+	const double eps = 1e-5;
+	for(unsigned y=0; y!=1000; ++y)
+	{
+		float data_1[16], data_2[16], data_3[4];
+		for(std::size_t x=0; x!=16; ++x)
+		{
+			data_1[x] = float(std::rand())/RAND_MAX-0.5f;
+			data_2[x] = float(std::rand())/RAND_MAX-0.5f;
+		}
+		for(std::size_t x=0; x!=4; ++x)
+			data_3[x] = float(std::rand())/RAND_MAX-0.5f;
+
+		oglplus::Matrix<float, 4, 4> mf_1(data_1), mf_2(data_2);
+		oglplus::Matrix<double, 4, 4> md_1(mf_1), md_2(mf_2);
+		oglplus::Vector<float, 4> vf(data_3);
+		oglplus::Vector<double, 4> vd(vf);
+
+		oglplus::Matrix<float, 4, 4> mmf = mf_1 * mf_2;
+		oglplus::Matrix<double, 4, 4> mmd = md_1 * md_2;
+		oglplus::Matrix<float, 4, 4> tf = Transposed(mf_1);
+		for(std::size_t i=0; i!=4; ++i)
+		for(std::size_t j=0; j!=4; ++j)
+		{
+			BOOST_CHECK(std::fabs(mmf.At(i, j) - mmd.At(i, j)) < eps);
+			BOOST_CHECK_EQUAL(tf.At(i, j), mf_1.At(j, i));
+		}
+
+		oglplus::Vector<float, 4> mvf = mf_1 * vf;
+		oglplus::Vector<double, 4> mvd = md_1 * vd;
+		oglplus::Vector<float, 4> vmf = vf * mf_1;
+		oglplus::Vector<double, 4> vmd = vd * md_1;
+		for(std::size_t i=0; i!=4; ++i)
+		{
+			BOOST_CHECK(std::fabs(mvf[i] - mvd[i]) < eps);
+			BOOST_CHECK(std::fabs(vmf[i] - vmd[i]) < eps);
+		}
+	}
+}
+
 BOOST_AUTO_TEST_CASE(Matrix_inverse)
 {
 	double eps = 1.0;
@@ -1153,6 +1194,108 @@ BOOST_AUTO_TEST_CASE(Matrix_inverse)
 	}
 }
 
+template <typename T, std::size_t N>
+bool do_test_matrix_close_abs(
+	const oglplus::Matrix<T, N, N>& a,
+	const oglplus::Matrix<T, N, N>& b,
+	T eps
+)
+{
+	for(std::size_t i=0; i!=N; ++i)
+	for(std::size_t j=0; j!=N; ++j)
+		if(std::fabs(a.At(i, j) - b.At(i, j)) > eps)
+			return false;
+	return true;
+}
+
+BOOST_AUTO_TEST_CASE(Matrix_inverse_closed_form)
+{
+	typedef oglplus::Matrix<double, 3, 3> mat3;
+	typedef oglplus::Matrix<double, 4, 4> mat4;
+	const double eps = 1e-6;
+	for(unsigned i=0; i!=1000; ++i)
+	{
+		double data[16];
+		for(std::size_t x=0; x!=16; ++x)
+			data[x] = double(std::rand())/RAND_MAX-0.5;
+		// make the matrix diagonally dominant so that it is invertible
+		for(std::size_t x=0; x!=4; ++x)
+			data[x*5] += 4.0;
+
+		mat4 m4(data);
+		mat4 e4;
+		BOOST_CHECK(do_test_matrix_close_abs(m4*Inverse(m4), e4, eps));
+
+		mat3 m3(Sub3x3(m4));
+		mat3 e3;
+		BOOST_CHECK(do_test_matrix_close_abs(m3*Inverse(m3), e3, eps));
+
+		mat4 a4(m4);
+		a4.Set(3, 0, 0.0);
+		a4.Set(3, 1, 0.0);
+		a4.Set(3, 2, 0.0);
+		a4.Set(3, 3, 1.0);
+		BOOST_CHECK(do_test_matrix_close_abs(
+			AffineInverse(a4),
+			Inverse(a4),
+			eps
+		));
+		BOOST_CHECK(do_test_matrix_close_abs(
+			InverseTranspose3x3(a4),
+			Transposed(Inverse(m3)),
+			eps
+		));
+	}
+
+	mat4 z;
+	z.Fill(0.0);
+	BOOST_CHECK(Inverse(z) == z);
+}
+
+BOOST_AUTO_TEST_CASE(Matrix_inverse_rigid)
+{
+	typedef oglplus::Vector<double, 3> vec3;
+	typedef oglplus::Matrix<double, 4, 4> mat4;
+	typedef oglplus::ModelMatrix<double> model;
+	typedef oglplus::CameraMatrix<double> camera;
+	const double eps = 1e-6;
+	for(unsigned i=0; i!=1000; ++i)
+	{
+		vec3 axis(
+			double(std::rand())/RAND_MAX-0.5,
+			double(std::rand())/RAND_MAX-0.5,
+			double(std::rand())/RAND_MAX+0.5
+		);
+		vec3 position(
+			double(std::rand())/RAND_MAX*10.0-5.0,
+			double(std::rand())/RAND_MAX*10.0-5.0,
+			double(std::rand())/RAND_MAX*10.0-5.0
+		);
+		oglplus::Angle<double> angle =
+			oglplus::Angle<double>::Degrees(std::rand()*0.001);
+
+		mat4 m =
+			model::Translation(position)*
+			model::RotationA(axis, angle);
+
+		BOOST_CHECK(do_test_matrix_close_abs(
+			RigidInverse(m),
+			Inverse(m),
+			eps
+		));
+		BOOST_CHECK(do_test_matrix_close_abs(
+			AffineInverse(m),
+			Inverse(m),
+			eps
+		));
+
+		camera cam = camera::LookingAt(position, position+axis);
+		vec3 cam_pos = cam.Position();
+		for(std::size_t c=0; c!=3; ++c)
+			BOOST_CHECK(std::fabs(cam_pos[c] - position[c]) < eps);
+	}
+}
+
 // TODO
 
 
@@ -1179,6 +1322,55 @@ BOOST_AUTO_TEST_CASE(Matrix_rotation)
 	}
 }
 
+BOOST_AUTO_TEST_CASE(Matrix_constexpr)
+{
+#if !OGLPLUS_NO_CONSTEXPR_MATH
+	typedef oglplus::Matrix<double, 4, 4> mat4;
+	typedef oglplus::ModelMatrix<double> model;
+	typedef oglplus::CameraMatrix<double> camera;
+
+	constexpr mat4 i;
+	static_assert(i.At(0, 0) == 1.0 && i.At(0, 1) == 0.0, "");
+	static_assert(i.At(3, 3) == 1.0 && At(i, 3, 2) == 0.0, "");
+
+	constexpr mat4 m(
+		 1.0,  2.0,  3.0,  4.0,
+		 5.0,  6.0,  7.0,  8.0,
+		 9.0, 10.0, 11.0, 12.0,
+		13.0, 14.0, 15.0, 16.0
+	);
+	constexpr mat4 n = -(m + i - m) * 2.0;
+	static_assert(n.At(0, 0) == -2.0 && n.At(1, 2) == 0.0, "");
+	static_assert(m.Data()[6] == 7.0 && m.At(1, 2) == 7.0, "");
+
+	constexpr model t = model::Translation(1.0, 2.0, 3.0);
+	static_assert(t.At(0, 3) == 1.0 && t.At(2, 3) == 3.0, "");
+
+	constexpr model s = model::Scale(2.0, 3.0, 4.0);
+	static_assert(s.At(1, 1) == 3.0 && s.At(3, 3) == 1.0, "");
+
+	constexpr model r = model::Reflection(true, false, true);
+	static_assert(r.At(0, 0) == -1.0 && r.At(1, 1) == 1.0, "");
+
+	constexpr camera o = camera::Ortho(-2.0, 2.0, -1.0, 1.0, 1.0, 3.0);
+	static_assert(o.At(0, 0) == 0.5 && o.At(1, 1) == 1.0, "");
+	static_assert(o.At(2, 2) == -1.0 && o.At(2, 3) == -2.0, "");
+
+	constexpr camera ox = camera::OrthoX(4.0, 2.0, 1.0, 3.0);
+	static_assert(ox.At(0, 0) == 0.5 && ox.At(1, 1) == 1.0, "");
+
+	constexpr camera st = camera::ScreenTile(1, 0, 2, 2);
+	static_assert(st.At(0, 0) == 2.0 && st.At(0, 3) == -1.0, "");
+
+	BOOST_CHECK(do_test_matrix_close_abs(
+		mat4(t),
+		mat4(model::Translation(1.0, 2.0, 3.0)),
+		0.0
+	));
+	BOOST_CHECK(n == mat4() * -2.0);
+#endif
+}
+
 // TODO
 
 BOOST_AUTO_TEST_SUITE_END()
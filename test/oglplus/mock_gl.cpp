@@ -0,0 +1,2459 @@
+/*
+ *  .file test/oglplus/mock_gl.cpp
+ *  Implements the recording mock GL
+ *
+ *  Copyright 2010-2013 Matus Chochlik. Distributed under the Boost
+ *  Software License, Version 1.0. (See accompanying file
+ *  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ */
+
+#include "mock_gl.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <map>
+#include <ostream>
+#include <set>
+#include <sstream>
+#include <utility>
+
+namespace oglplus {
+namespace mock {
+namespace {
+
+typedef std::chrono::steady_clock Clock;
+
+struct BufferObject
+{
+	std::vector<GLubyte> data;
+	GLenum usage;
+	GLboolean mapped;
+	GLboolean corrupted;
+	GLbitfield map_access;
+	GLintptr map_offset;
+	GLsizeiptr map_length;
+	GLboolean immutable;
+	GLbitfield storage_flags;
+
+	BufferObject(void)
+	 : usage(GL_STATIC_DRAW)
+	 , mapped(GL_FALSE)
+	 , corrupted(GL_FALSE)
+	 , map_access(0)
+	 , map_offset(0)
+	 , map_length(0)
+	 , immutable(GL_FALSE)
+	 , storage_flags(0)
+	{ }
+};
+
+struct VertexAttrib
+{
+	GLboolean enabled;
+	GLint size;
+	GLenum type;
+	GLsizei stride;
+	const void* pointer;
+	GLuint buffer;
+	GLuint divisor;
+
+	VertexAttrib(void)
+	 : enabled(GL_FALSE)
+	 , size(4)
+	 , type(GL_FLOAT)
+	 , stride(0)
+	 , pointer(nullptr)
+	 , buffer(0)
+	 , divisor(0)
+	{ }
+};
+
+struct VertexArrayObject
+{
+	GLuint element_buffer;
+	std::vector<VertexAttrib> attribs;
+
+	VertexArrayObject(void)
+	 : element_buffer(0)
+	 , attribs(16)
+	{ }
+};
+
+struct UniformInfo
+{
+	std::string name;
+	GLenum type;
+	GLint size;
+	GLint block;
+	GLint location;
+};
+
+struct ShaderObject
+{
+	GLenum type;
+	std::string source;
+	GLboolean compiled;
+	// the number of completion status queries reporting an unfinished job
+	GLuint pending_polls;
+};
+
+struct ProgramObject
+{
+	std::vector<UniformInfo> uniforms;
+	std::vector<std::string> blocks;
+	std::vector<GLuint> shaders;
+	std::string binary;
+	GLboolean linked;
+	GLboolean separable;
+	GLboolean retrievable;
+	GLuint pending_polls;
+
+	ProgramObject(void)
+	 : linked(GL_FALSE)
+	 , separable(GL_FALSE)
+	 , retrievable(GL_FALSE)
+	 , pending_polls(0)
+	{ }
+};
+
+// the format of the emulated program binaries
+const GLenum mock_binary_format = 0x4F47;
+
+struct FunctionStats
+{
+	std::size_t count;
+	Clock::duration time;
+
+	FunctionStats(void)
+	 : count(0)
+	 , time(Clock::duration::zero())
+	{ }
+};
+
+struct State
+{
+	// the raised error flags in the order in which they were raised
+	std::vector<GLenum> errors;
+	GLuint next_name;
+
+	std::map<GLuint, BufferObject> buffers;
+	std::map<GLenum, GLuint> buffer_bindings;
+	std::map<std::pair<GLenum, GLuint>, GLuint> indexed_bindings;
+
+	// the vertex array 0 is kept as the default VAO
+	std::map<GLuint, VertexArrayObject> vertex_arrays;
+	GLuint vertex_array;
+
+	std::set<GLuint> textures;
+	std::map<std::pair<GLuint, GLenum>, GLuint> texture_bindings;
+	GLuint active_texture;
+
+	std::set<GLuint> samplers;
+	std::map<GLuint, GLuint> sampler_bindings;
+
+	std::map<GLuint, ShaderObject> shaders;
+	std::map<GLuint, ProgramObject> programs;
+	GLuint program;
+	GLuint binary_version;
+	GLuint completion_latency;
+	GLuint compiler_threads;
+
+	std::vector<std::string> extensions;
+
+	// the sync objects and their signaled status
+	std::map<GLuint, GLboolean> syncs;
+	GLuint next_sync;
+
+	std::set<GLenum> enabled;
+	GLuint restart_index;
+	GLenum front_face;
+
+	std::vector<GLCall> calls;
+	std::map<std::string, FunctionStats> stats;
+	Clock::time_point start;
+
+	State(void)
+	{
+		Reset();
+	}
+
+	void Reset(void)
+	{
+		errors.clear();
+		next_name = 1;
+		buffers.clear();
+		buffer_bindings.clear();
+		indexed_bindings.clear();
+		vertex_arrays.clear();
+		vertex_arrays[0] = VertexArrayObject();
+		vertex_array = 0;
+		textures.clear();
+		texture_bindings.clear();
+		active_texture = 0;
+		samplers.clear();
+		sampler_bindings.clear();
+		shaders.clear();
+		programs.clear();
+		program = 0;
+		binary_version = 0;
+		completion_latency = 0;
+		compiler_threads = 0xFFFFFFFF;
+		extensions.clear();
+		syncs.clear();
+		next_sync = 1;
+		enabled.clear();
+		restart_index = 0;
+		front_face = GL_CCW;
+		ClearCalls();
+	}
+
+	void ClearCalls(void)
+	{
+		calls.clear();
+		stats.clear();
+		start = Clock::now();
+	}
+};
+
+State& state(void)
+{
+	static State s;
+	return s;
+}
+
+// like in GL each kind of error has its own flag which is kept
+// until it is queried by glGetError
+void set_error(GLenum error)
+{
+	std::vector<GLenum>& errors = state().errors;
+	if(std::find(errors.begin(), errors.end(), error) == errors.end())
+		errors.push_back(error);
+}
+
+inline void put_arg(std::ostream& out, GLubyte value)
+{
+	out << unsigned(value);
+}
+
+inline void put_arg(std::ostream& out, const GLchar* value)
+{
+	if(value) out << '"' << value << '"';
+	else out << "nullptr";
+}
+
+template <typename T>
+inline void put_arg(std::ostream& out, T* value)
+{
+	if(value) out << static_cast<const void*>(value);
+	else out << "nullptr";
+}
+
+template <typename T>
+inline void put_arg(std::ostream& out, T value)
+{
+	out << value;
+}
+
+inline void put_args(std::ostream&)
+{ }
+
+template <typename P, typename ... R>
+inline void put_args(std::ostream& out, P param, R ... rest)
+{
+	put_arg(out, param);
+	if(sizeof ... (rest) != 0) out << ", ";
+	put_args(out, rest...);
+}
+
+// records a GL call and the time spent in the mock implementation
+class RecordCall
+{
+private:
+	Clock::time_point _start;
+	const char* _name;
+public:
+	template <typename ... P>
+	RecordCall(const char* name, P ... params)
+	 : _start(Clock::now())
+	 , _name(name)
+	{
+		std::stringstream args;
+		put_args(args, params...);
+		GLCall call = {name, args.str()};
+		state().calls.push_back(call);
+	}
+
+	~RecordCall(void)
+	{
+		FunctionStats& stats = state().stats[_name];
+		++stats.count;
+		stats.time += Clock::now() - _start;
+	}
+};
+
+bool is_buffer_target(GLenum target)
+{
+	switch(target)
+	{
+		case GL_ARRAY_BUFFER:
+		case GL_COPY_READ_BUFFER:
+		case GL_COPY_WRITE_BUFFER:
+		case GL_ELEMENT_ARRAY_BUFFER:
+		case GL_PIXEL_PACK_BUFFER:
+		case GL_PIXEL_UNPACK_BUFFER:
+		case GL_TEXTURE_BUFFER:
+		case GL_TRANSFORM_FEEDBACK_BUFFER:
+		case GL_UNIFORM_BUFFER:
+#if GL_VERSION_4_0
+		case GL_DRAW_INDIRECT_BUFFER:
+#endif
+#if GL_VERSION_4_2
+		case GL_ATOMIC_COUNTER_BUFFER:
+#endif
+#if GL_VERSION_4_3
+		case GL_DISPATCH_INDIRECT_BUFFER:
+		case GL_SHADER_STORAGE_BUFFER:
+#endif
+			return true;
+		default:;
+	}
+	return false;
+}
+
+GLuint max_indexed_bindings(GLenum target)
+{
+	switch(target)
+	{
+		case GL_UNIFORM_BUFFER: return 36;
+		case GL_TRANSFORM_FEEDBACK_BUFFER: return 4;
+#if GL_VERSION_4_2
+		case GL_ATOMIC_COUNTER_BUFFER: return 8;
+#endif
+#if GL_VERSION_4_3
+		case GL_SHADER_STORAGE_BUFFER: return 8;
+#endif
+		default:;
+	}
+	return 0;
+}
+
+// the element array buffer binding is a part of the VAO state
+GLuint& buffer_binding(GLenum target)
+{
+	State& s = state();
+	if(target == GL_ELEMENT_ARRAY_BUFFER)
+		return s.vertex_arrays[s.vertex_array].element_buffer;
+	return s.buffer_bindings[target];
+}
+
+// returns the buffer bound to target or nullptr and sets the error
+BufferObject* bound_buffer(GLenum target)
+{
+	if(!is_buffer_target(target))
+	{
+		set_error(GL_INVALID_ENUM);
+		return nullptr;
+	}
+	GLuint name = buffer_binding(target);
+	if(name == 0)
+	{
+		set_error(GL_INVALID_OPERATION);
+		return nullptr;
+	}
+	return &state().buffers[name];
+}
+
+bool check_range(const BufferObject& buffer, GLintptr offset, GLsizeiptr size)
+{
+	if((offset < 0) || (size < 0) ||
+		(std::size_t(offset + size) > buffer.data.size()))
+	{
+		set_error(GL_INVALID_VALUE);
+		return false;
+	}
+	return true;
+}
+
+GLsizeiptr index_type_size(GLenum type)
+{
+	switch(type)
+	{
+		case GL_UNSIGNED_BYTE: return 1;
+		case GL_UNSIGNED_SHORT: return 2;
+		case GL_UNSIGNED_INT: return 4;
+		default:;
+	}
+	set_error(GL_INVALID_ENUM);
+	return 0;
+}
+
+bool check_draw(GLsizei count, GLsizei instance_count = 1)
+{
+	if((count < 0) || (instance_count < 0))
+	{
+		set_error(GL_INVALID_VALUE);
+		return false;
+	}
+	return true;
+}
+
+// checks that the indices are read from the bound element buffer
+bool check_elements(GLsizei count, GLenum type, const void* indices)
+{
+	if(!check_draw(count)) return false;
+	GLsizeiptr size = index_type_size(type);
+	if(size == 0) return false;
+	State& s = state();
+	GLuint name = s.vertex_arrays[s.vertex_array].element_buffer;
+	// client-side indices are not checked
+	if(name == 0) return true;
+	GLintptr offset = GLintptr(reinterpret_cast<std::size_t>(indices));
+	if((offset % size) != 0)
+	{
+		set_error(GL_INVALID_OPERATION);
+		return false;
+	}
+	if(std::size_t(offset+size*count) > s.buffers[name].data.size())
+	{
+		set_error(GL_INVALID_OPERATION);
+		return false;
+	}
+	return true;
+}
+
+// checks that the commands are read from the bound indirect buffer
+bool check_indirect(
+	const void* indirect,
+	GLsizei draw_count,
+	GLsizei stride,
+	GLsizei command_size
+)
+{
+#if GL_VERSION_4_0
+	if((draw_count < 0) || (stride < 0) || (stride % 4 != 0))
+	{
+		set_error(GL_INVALID_VALUE);
+		return false;
+	}
+	if(stride == 0) stride = command_size;
+	GLuint name = state().buffer_bindings[GL_DRAW_INDIRECT_BUFFER];
+	GLintptr offset = GLintptr(reinterpret_cast<std::size_t>(indirect));
+	if((name == 0) || (offset % 4 != 0))
+	{
+		set_error(GL_INVALID_OPERATION);
+		return false;
+	}
+	GLsizeiptr size = draw_count?stride*(draw_count-1)+command_size:0;
+	const BufferObject& buffer = state().buffers[name];
+	if(std::size_t(offset + size) > buffer.data.size())
+	{
+		set_error(GL_INVALID_OPERATION);
+		return false;
+	}
+	return true;
+#else
+	(void)indirect;
+	(void)draw_count;
+	(void)stride;
+	(void)command_size;
+	set_error(GL_INVALID_OPERATION);
+	return false;
+#endif
+}
+
+void unbind_buffer(GLuint name)
+{
+	State& s = state();
+	for(auto i=s.buffer_bindings.begin(); i!=s.buffer_bindings.end(); ++i)
+		if(i->second == name) i->second = 0;
+	for(auto i=s.indexed_bindings.begin(); i!=s.indexed_bindings.end(); ++i)
+		if(i->second == name) i->second = 0;
+	for(auto i=s.vertex_arrays.begin(); i!=s.vertex_arrays.end(); ++i)
+	{
+		if(i->second.element_buffer == name)
+			i->second.element_buffer = 0;
+	}
+}
+
+GLenum binding_target(GLenum pname)
+{
+	switch(pname)
+	{
+		case GL_ARRAY_BUFFER_BINDING:
+			return GL_ARRAY_BUFFER;
+		case GL_ELEMENT_ARRAY_BUFFER_BINDING:
+			return GL_ELEMENT_ARRAY_BUFFER;
+		case GL_PIXEL_PACK_BUFFER_BINDING:
+			return GL_PIXEL_PACK_BUFFER;
+		case GL_PIXEL_UNPACK_BUFFER_BINDING:
+			return GL_PIXEL_UNPACK_BUFFER;
+		case GL_TRANSFORM_FEEDBACK_BUFFER_BINDING:
+			return GL_TRANSFORM_FEEDBACK_BUFFER;
+		case GL_UNIFORM_BUFFER_BINDING:
+			return GL_UNIFORM_BUFFER;
+#if defined GL_COPY_READ_BUFFER_BINDING
+		case GL_COPY_READ_BUFFER_BINDING:
+			return GL_COPY_READ_BUFFER;
+		case GL_COPY_WRITE_BUFFER_BINDING:
+			return GL_COPY_WRITE_BUFFER;
+#endif
+#if defined GL_TEXTURE_BUFFER_BINDING
+		case GL_TEXTURE_BUFFER_BINDING:
+			return GL_TEXTURE_BUFFER;
+#endif
+#if GL_VERSION_4_0
+		case GL_DRAW_INDIRECT_BUFFER_BINDING:
+			return GL_DRAW_INDIRECT_BUFFER;
+#endif
+#if GL_VERSION_4_2
+		case GL_ATOMIC_COUNTER_BUFFER_BINDING:
+			return GL_ATOMIC_COUNTER_BUFFER;
+#endif
+#if GL_VERSION_4_3
+		case GL_DISPATCH_INDIRECT_BUFFER_BINDING:
+			return GL_DISPATCH_INDIRECT_BUFFER;
+		case GL_SHADER_STORAGE_BUFFER_BINDING:
+			return GL_SHADER_STORAGE_BUFFER;
+#endif
+		default:;
+	}
+	return GL_NONE;
+}
+
+} // namespace
+
+void Reset(void)
+{
+	state().Reset();
+}
+
+void ClearCalls(void)
+{
+	state().ClearCalls();
+}
+
+const std::vector<GLCall>& Calls(void)
+{
+	return state().calls;
+}
+
+std::size_t CallCount(void)
+{
+	return state().calls.size();
+}
+
+std::size_t CallCount(const char* name)
+{
+	auto pos = state().stats.find(name);
+	if(pos == state().stats.end()) return 0;
+	return pos->second.count;
+}
+
+void Report(std::ostream& out)
+{
+	typedef std::chrono::duration<double, std::micro> usecs;
+	const State& s = state();
+
+	std::vector<std::pair<std::string, FunctionStats> > stats(
+		s.stats.begin(),
+		s.stats.end()
+	);
+	std::stable_sort(
+		stats.begin(),
+		stats.end(),
+		[](
+			const std::pair<std::string, FunctionStats>& a,
+			const std::pair<std::string, FunctionStats>& b
+		) -> bool
+		{
+			return a.second.count > b.second.count;
+		}
+	);
+
+	Clock::duration mock_time = Clock::duration::zero();
+	out << std::setw(48) << std::left << "GL function";
+	out << std::setw(10) << std::right << "calls";
+	out << std::setw(14) << "time [us]" << std::endl;
+	for(auto i=stats.begin(), e=stats.end(); i!=e; ++i)
+	{
+		out << std::setw(48) << std::left << i->first;
+		out << std::setw(10) << std::right << i->second.count;
+		out << std::setw(14) << std::fixed << std::setprecision(2);
+		out << usecs(i->second.time).count() << std::endl;
+		mock_time += i->second.time;
+	}
+	out << std::setw(48) << std::left << "total";
+	out << std::setw(10) << std::right << s.calls.size();
+	out << std::setw(14) << usecs(mock_time).count() << std::endl;
+	out << "elapsed time [us]: ";
+	out << usecs(Clock::now() - s.start).count() << std::endl;
+}
+
+void SetError(GLenum error)
+{
+	set_error(error);
+}
+
+GLuint BoundBuffer(GLenum target)
+{
+	return buffer_binding(target);
+}
+
+GLuint BoundVertexArray(void)
+{
+	return state().vertex_array;
+}
+
+const std::vector<GLubyte>& BufferData(GLuint buffer)
+{
+	return state().buffers[buffer].data;
+}
+
+GLenum BufferUsage(GLuint buffer)
+{
+	return state().buffers[buffer].usage;
+}
+
+GLuint ActiveTextureUnit(void)
+{
+	return state().active_texture;
+}
+
+GLuint BoundTexture(GLuint unit, GLenum target)
+{
+	return state().texture_bindings[std::make_pair(unit, target)];
+}
+
+GLuint BoundSampler(GLuint unit)
+{
+	return state().sampler_bindings[unit];
+}
+
+GLuint CurrentProgram(void)
+{
+	return state().program;
+}
+
+void AddUniform(
+	GLuint program,
+	const char* name,
+	GLenum type,
+	GLint size,
+	GLint block
+)
+{
+	UniformInfo info = { name, type, size, block, -1 };
+	state().programs[program].uniforms.push_back(info);
+}
+
+void ClearUniforms(GLuint program)
+{
+	state().programs[program].uniforms.clear();
+	state().programs[program].blocks.clear();
+}
+
+GLint AddUniformBlock(GLuint program, const char* name)
+{
+	std::vector<std::string>& blocks = state().programs[program].blocks;
+	blocks.push_back(name);
+	return GLint(blocks.size()-1);
+}
+
+void InvalidateProgramBinaries(void)
+{
+	++state().binary_version;
+}
+
+void SignalFences(void)
+{
+	State& s = state();
+	for(auto i=s.syncs.begin(), e=s.syncs.end(); i!=e; ++i)
+		i->second = GL_TRUE;
+}
+
+void CorruptMappedBuffers(void)
+{
+	State& s = state();
+	for(auto i=s.buffers.begin(), e=s.buffers.end(); i!=e; ++i)
+		if(i->second.mapped) i->second.corrupted = GL_TRUE;
+}
+
+std::size_t FenceCount(void)
+{
+	return state().syncs.size();
+}
+
+void AddExtension(const char* name)
+{
+	state().extensions.push_back(name);
+}
+
+void SetCompletionLatency(GLuint polls)
+{
+	state().completion_latency = polls;
+}
+
+GLuint MaxShaderCompilerThreads(void)
+{
+	return state().compiler_threads;
+}
+
+} // namespace mock
+} // namespace oglplus
+
+using namespace oglplus::mock;
+
+extern "C" {
+
+// errors and queries
+
+GLenum APIENTRY glGetError(void)
+{
+	RecordCall call("glGetError");
+	std::vector<GLenum>& errors = state().errors;
+	if(errors.empty()) return GL_NO_ERROR;
+	GLenum result = errors.front();
+	errors.erase(errors.begin());
+	return result;
+}
+
+void APIENTRY glGetIntegerv(GLenum pname, GLint* data)
+{
+	RecordCall call("glGetIntegerv", pname, data);
+	State& s = state();
+	GLenum target = binding_target(pname);
+	if(target != GL_NONE)
+	{
+		*data = GLint(buffer_binding(target));
+		return;
+	}
+	switch(pname)
+	{
+		case GL_VERTEX_ARRAY_BINDING:
+			*data = GLint(s.vertex_array); break;
+		case GL_PRIMITIVE_RESTART_INDEX:
+			*data = GLint(s.restart_index); break;
+		case GL_FRONT_FACE:
+			*data = GLint(s.front_face); break;
+		case GL_ACTIVE_TEXTURE:
+			*data = GLint(GL_TEXTURE0 + s.active_texture); break;
+		case GL_CURRENT_PROGRAM:
+			*data = GLint(s.program); break;
+		case GL_MAX_COMBINED_TEXTURE_IMAGE_UNITS: *data = 32; break;
+		case GL_NUM_PROGRAM_BINARY_FORMATS: *data = 1; break;
+		case GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT: *data = 256; break;
+		case GL_MAJOR_VERSION: *data = 4; break;
+		case GL_MINOR_VERSION: *data = 3; break;
+		case GL_NUM_EXTENSIONS:
+			*data = GLint(state().extensions.size());
+			break;
+#if GL_KHR_parallel_shader_compile
+		case GL_MAX_SHADER_COMPILER_THREADS_KHR:
+			*data = GLint(state().compiler_threads);
+			break;
+#endif
+		case GL_MAX_VERTEX_ATTRIBS: *data = 16; break;
+		case GL_MAX_UNIFORM_BUFFER_BINDINGS:
+			*data = GLint(max_indexed_bindings(GL_UNIFORM_BUFFER));
+			break;
+		case GL_MAX_TRANSFORM_FEEDBACK_BUFFERS:
+			*data = GLint(
+				max_indexed_bindings(GL_TRANSFORM_FEEDBACK_BUFFER)
+			);
+			break;
+#if GL_VERSION_4_2
+		case GL_MAX_ATOMIC_COUNTER_BUFFER_BINDINGS:
+			*data = GLint(max_indexed_bindings(GL_ATOMIC_COUNTER_BUFFER));
+			break;
+#endif
+#if GL_VERSION_4_3
+		case GL_MAX_SHADER_STORAGE_BUFFER_BINDINGS:
+			*data = GLint(max_indexed_bindings(GL_SHADER_STORAGE_BUFFER));
+			break;
+#endif
+		default: set_error(GL_INVALID_ENUM);
+	}
+}
+
+void APIENTRY glGetIntegeri_v(GLenum target, GLuint index, GLint* data)
+{
+	RecordCall call("glGetIntegeri_v", target, index, data);
+	GLenum buffer_target = binding_target(target);
+	if(max_indexed_bindings(buffer_target) == 0)
+	{
+		set_error(GL_INVALID_ENUM);
+		return;
+	}
+	if(index >= max_indexed_bindings(buffer_target))
+	{
+		set_error(GL_INVALID_VALUE);
+		return;
+	}
+	auto key = std::make_pair(buffer_target, index);
+	*data = GLint(state().indexed_bindings[key]);
+}
+
+const GLubyte* APIENTRY glGetString(GLenum name)
+{
+	RecordCall call("glGetString", name);
+	const char* result = nullptr;
+	switch(name)
+	{
+		case GL_VENDOR: result = "OGLplus"; break;
+		case GL_RENDERER: result = "OGLplus mock GL"; break;
+		case GL_VERSION: result = "4.3 mock"; break;
+		case GL_SHADING_LANGUAGE_VERSION: result = "4.30"; break;
+		default: set_error(GL_INVALID_ENUM);
+	}
+	return reinterpret_cast<const GLubyte*>(result);
+}
+
+const GLubyte* APIENTRY glGetStringi(GLenum name, GLuint index)
+{
+	RecordCall call("glGetStringi", name, index);
+	const std::vector<std::string>& extensions = state().extensions;
+	if(name != GL_EXTENSIONS) set_error(GL_INVALID_ENUM);
+	else if(index >= extensions.size()) set_error(GL_INVALID_VALUE);
+	else return reinterpret_cast<const GLubyte*>(extensions[index].c_str());
+	return nullptr;
+}
+
+// capabilities and other state
+
+void APIENTRY glEnable(GLenum cap)
+{
+	RecordCall call("glEnable", cap);
+	state().enabled.insert(cap);
+}
+
+void APIENTRY glDisable(GLenum cap)
+{
+	RecordCall call("glDisable", cap);
+	state().enabled.erase(cap);
+}
+
+GLboolean APIENTRY glIsEnabled(GLenum cap)
+{
+	RecordCall call("glIsEnabled", cap);
+	return state().enabled.count(cap)?GL_TRUE:GL_FALSE;
+}
+
+void APIENTRY glFrontFace(GLenum mode)
+{
+	RecordCall call("glFrontFace", mode);
+	if((mode != GL_CW) && (mode != GL_CCW)) set_error(GL_INVALID_ENUM);
+	else state().front_face = mode;
+}
+
+void APIENTRY glPrimitiveRestartIndex(GLuint index)
+{
+	RecordCall call("glPrimitiveRestartIndex", index);
+	state().restart_index = index;
+}
+
+void APIENTRY glViewport(GLint x, GLint y, GLsizei width, GLsizei height)
+{
+	RecordCall call("glViewport", x, y, width, height);
+	if((width < 0) || (height < 0)) set_error(GL_INVALID_VALUE);
+}
+
+void APIENTRY glBlendEquation(GLenum mode)
+{
+	RecordCall call("glBlendEquation", mode);
+}
+
+void APIENTRY glBlendEquationSeparate(GLenum mode_rgb, GLenum mode_alpha)
+{
+	RecordCall call("glBlendEquationSeparate", mode_rgb, mode_alpha);
+}
+
+void APIENTRY glBlendFunc(GLenum sfactor, GLenum dfactor)
+{
+	RecordCall call("glBlendFunc", sfactor, dfactor);
+}
+
+void APIENTRY glBlendFuncSeparate(
+	GLenum src_rgb,
+	GLenum dst_rgb,
+	GLenum src_alpha,
+	GLenum dst_alpha
+)
+{
+	RecordCall call(
+		"glBlendFuncSeparate",
+		src_rgb,
+		dst_rgb,
+		src_alpha,
+		dst_alpha
+	);
+}
+
+void APIENTRY glBlendColor(GLfloat r, GLfloat g, GLfloat b, GLfloat a)
+{
+	RecordCall call("glBlendColor", r, g, b, a);
+}
+
+void APIENTRY glDepthFunc(GLenum func)
+{
+	RecordCall call("glDepthFunc", func);
+}
+
+void APIENTRY glDepthMask(GLboolean flag)
+{
+	RecordCall call("glDepthMask", flag);
+}
+
+void APIENTRY glStencilFunc(GLenum func, GLint ref, GLuint mask)
+{
+	RecordCall call("glStencilFunc", func, ref, mask);
+}
+
+void APIENTRY glStencilOp(GLenum sfail, GLenum dpfail, GLenum dppass)
+{
+	RecordCall call("glStencilOp", sfail, dpfail, dppass);
+}
+
+void APIENTRY glClearColor(GLfloat r, GLfloat g, GLfloat b, GLfloat a)
+{
+	RecordCall call("glClearColor", r, g, b, a);
+}
+
+void APIENTRY glClear(GLbitfield mask)
+{
+	RecordCall call("glClear", mask);
+}
+
+void APIENTRY glFlush(void)
+{
+	RecordCall call("glFlush");
+}
+
+void APIENTRY glFinish(void)
+{
+	RecordCall call("glFinish");
+	oglplus::mock::SignalFences();
+}
+
+// syncs
+/* The GPU is emulated to be always behind the client, the fences become
+ * signaled only when the client waits for them, calls glFinish or when
+ * the test calls mock::SignalFences.
+ */
+
+static GLboolean* sync_status(GLsync sync)
+{
+	auto p = state().syncs.find(GLuint(reinterpret_cast<std::size_t>(sync)));
+	if(p == state().syncs.end())
+	{
+		set_error(GL_INVALID_VALUE);
+		return nullptr;
+	}
+	return &p->second;
+}
+
+GLsync APIENTRY glFenceSync(GLenum condition, GLbitfield flags)
+{
+	RecordCall call("glFenceSync", condition, flags);
+	if(condition != GL_SYNC_GPU_COMMANDS_COMPLETE)
+	{
+		set_error(GL_INVALID_ENUM);
+		return 0;
+	}
+	if(flags != 0)
+	{
+		set_error(GL_INVALID_VALUE);
+		return 0;
+	}
+	State& s = state();
+	GLuint name = s.next_sync++;
+	s.syncs[name] = GL_FALSE;
+	return reinterpret_cast<GLsync>(std::size_t(name));
+}
+
+GLboolean APIENTRY glIsSync(GLsync sync)
+{
+	RecordCall call("glIsSync", sync);
+	GLuint name = GLuint(reinterpret_cast<std::size_t>(sync));
+	return state().syncs.count(name)?GL_TRUE:GL_FALSE;
+}
+
+void APIENTRY glDeleteSync(GLsync sync)
+{
+	RecordCall call("glDeleteSync", sync);
+	if(sync == 0) return;
+	if(sync_status(sync))
+		state().syncs.erase(GLuint(reinterpret_cast<std::size_t>(sync)));
+}
+
+GLenum APIENTRY glClientWaitSync(
+	GLsync sync,
+	GLbitfield flags,
+	GLuint64 timeout
+)
+{
+	RecordCall call("glClientWaitSync", sync, flags, timeout);
+	GLboolean* status = sync_status(sync);
+	if(!status) return GL_WAIT_FAILED;
+	if(*status) return GL_ALREADY_SIGNALED;
+	*status = GL_TRUE;
+	return GL_CONDITION_SATISFIED;
+}
+
+void APIENTRY glWaitSync(GLsync sync, GLbitfield flags, GLuint64 timeout)
+{
+	RecordCall call("glWaitSync", sync, flags, timeout);
+	sync_status(sync);
+}
+
+void APIENTRY glGetSynciv(
+	GLsync sync,
+	GLenum pname,
+	GLsizei buf_size,
+	GLsizei* length,
+	GLint* values
+)
+{
+	RecordCall call("glGetSynciv", sync, pname, buf_size, length, values);
+	GLboolean* status = sync_status(sync);
+	if(!status) return;
+	GLint value = 0;
+	switch(pname)
+	{
+		case GL_OBJECT_TYPE: value = GL_SYNC_FENCE; break;
+		case GL_SYNC_STATUS:
+			value = *status?GL_SIGNALED:GL_UNSIGNALED;
+			break;
+		case GL_SYNC_CONDITION:
+			value = GL_SYNC_GPU_COMMANDS_COMPLETE;
+			break;
+		case GL_SYNC_FLAGS: value = 0; break;
+		default:
+			set_error(GL_INVALID_ENUM);
+			return;
+	}
+	if(buf_size > 0) *values = value;
+	if(length) *length = 1;
+}
+
+// buffers
+
+void APIENTRY glGenBuffers(GLsizei n, GLuint* buffers)
+{
+	RecordCall call("glGenBuffers", n, buffers);
+	if(n < 0)
+	{
+		set_error(GL_INVALID_VALUE);
+		return;
+	}
+	State& s = state();
+	for(GLsizei i=0; i!=n; ++i)
+	{
+		buffers[i] = s.next_name++;
+		s.buffers[buffers[i]] = BufferObject();
+	}
+}
+
+void APIENTRY glDeleteBuffers(GLsizei n, const GLuint* buffers)
+{
+	RecordCall call("glDeleteBuffers", n, buffers);
+	if(n < 0)
+	{
+		set_error(GL_INVALID_VALUE);
+		return;
+	}
+	for(GLsizei i=0; i!=n; ++i)
+	{
+		if(buffers[i] == 0) continue;
+		unbind_buffer(buffers[i]);
+		state().buffers.erase(buffers[i]);
+	}
+}
+
+GLboolean APIENTRY glIsBuffer(GLuint buffer)
+{
+	RecordCall call("glIsBuffer", buffer);
+	return state().buffers.count(buffer)?GL_TRUE:GL_FALSE;
+}
+
+void APIENTRY glBindBuffer(GLenum target, GLuint buffer)
+{
+	RecordCall call("glBindBuffer", target, buffer);
+	if(!is_buffer_target(target)) set_error(GL_INVALID_ENUM);
+	else if(buffer && !state().buffers.count(buffer))
+		set_error(GL_INVALID_OPERATION);
+	else buffer_binding(target) = buffer;
+}
+
+static void bind_buffer_range(
+	GLenum target,
+	GLuint index,
+	GLuint buffer,
+	GLintptr offset,
+	GLsizeiptr size
+)
+{
+	if(max_indexed_bindings(target) == 0) set_error(GL_INVALID_ENUM);
+	else if(index >= max_indexed_bindings(target))
+		set_error(GL_INVALID_VALUE);
+	else if(buffer && !state().buffers.count(buffer))
+		set_error(GL_INVALID_OPERATION);
+	else if(buffer && ((offset < 0) || (size <= 0)))
+		set_error(GL_INVALID_VALUE);
+	else
+	{
+		state().indexed_bindings[std::make_pair(target, index)] = buffer;
+		buffer_binding(target) = buffer;
+	}
+}
+
+void APIENTRY glBindBufferBase(GLenum target, GLuint index, GLuint buffer)
+{
+	RecordCall call("glBindBufferBase", target, index, buffer);
+	bind_buffer_range(target, index, buffer, 0, 1);
+}
+
+void APIENTRY glBindBufferRange(
+	GLenum target,
+	GLuint index,
+	GLuint buffer,
+	GLintptr offset,
+	GLsizeiptr size
+)
+{
+	RecordCall call(
+		"glBindBufferRange",
+		target, index, buffer, offset, size
+	);
+	bind_buffer_range(target, index, buffer, offset, size);
+}
+
+void APIENTRY glBufferData(
+	GLenum target,
+	GLsizeiptr size,
+	const void* data,
+	GLenum usage
+)
+{
+	RecordCall call("glBufferData", target, size, data, usage);
+	BufferObject* buffer = bound_buffer(target);
+	if(!buffer) return;
+	if(buffer->immutable)
+	{
+		set_error(GL_INVALID_OPERATION);
+		return;
+	}
+	if(size < 0)
+	{
+		set_error(GL_INVALID_VALUE);
+		return;
+	}
+	buffer->data.assign(std::size_t(size), 0);
+	if(data) std::memcpy(buffer->data.data(), data, std::size_t(size));
+	buffer->usage = usage;
+	buffer->mapped = GL_FALSE;
+}
+
+#if GL_VERSION_4_4 || GL_ARB_buffer_storage
+void APIENTRY glBufferStorage(
+	GLenum target,
+	GLsizeiptr size,
+	const void* data,
+	GLbitfield flags
+)
+{
+	RecordCall call("glBufferStorage", target, size, data, flags);
+	BufferObject* buffer = bound_buffer(target);
+	if(!buffer) return;
+	if(buffer->immutable)
+	{
+		set_error(GL_INVALID_OPERATION);
+		return;
+	}
+	if(size <= 0)
+	{
+		set_error(GL_INVALID_VALUE);
+		return;
+	}
+	buffer->data.assign(std::size_t(size), 0);
+	if(data) std::memcpy(buffer->data.data(), data, std::size_t(size));
+	buffer->usage = GL_DYNAMIC_DRAW;
+	buffer->mapped = GL_FALSE;
+	buffer->immutable = GL_TRUE;
+	buffer->storage_flags = flags;
+}
+#endif
+
+void APIENTRY glBufferSubData(
+	GLenum target,
+	GLintptr offset,
+	GLsizeiptr size,
+	const void* data
+)
+{
+	RecordCall call("glBufferSubData", target, offset, size, data);
+	BufferObject* buffer = bound_buffer(target);
+	if(!buffer || !check_range(*buffer, offset, size)) return;
+	if(buffer->mapped) set_error(GL_INVALID_OPERATION);
+#if GL_VERSION_4_4 || GL_ARB_buffer_storage
+	else if(
+		buffer->immutable &&
+		!(buffer->storage_flags & GL_DYNAMIC_STORAGE_BIT)
+	) set_error(GL_INVALID_OPERATION);
+#endif
+	else std::memcpy(buffer->data.data()+offset, data, std::size_t(size));
+}
+
+void APIENTRY glGetBufferSubData(
+	GLenum target,
+	GLintptr offset,
+	GLsizeiptr size,
+	void* data
+)
+{
+	RecordCall call("glGetBufferSubData", target, offset, size, data);
+	BufferObject* buffer = bound_buffer(target);
+	if(!buffer || !check_range(*buffer, offset, size)) return;
+	if(buffer->mapped) set_error(GL_INVALID_OPERATION);
+	else std::memcpy(data, buffer->data.data()+offset, std::size_t(size));
+}
+
+void APIENTRY glGetBufferParameteriv(GLenum target, GLenum pname, GLint* params)
+{
+	RecordCall call("glGetBufferParameteriv", target, pname, params);
+	BufferObject* buffer = bound_buffer(target);
+	if(!buffer) return;
+	switch(pname)
+	{
+		case GL_BUFFER_SIZE:
+			*params = GLint(buffer->data.size()); break;
+		case GL_BUFFER_USAGE:
+			*params = GLint(buffer->usage); break;
+		case GL_BUFFER_MAPPED:
+			*params = GLint(buffer->mapped); break;
+		case GL_BUFFER_ACCESS_FLAGS:
+			*params = GLint(buffer->map_access); break;
+#if GL_VERSION_4_4 || GL_ARB_buffer_storage
+		case GL_BUFFER_IMMUTABLE_STORAGE:
+			*params = GLint(buffer->immutable); break;
+		case GL_BUFFER_STORAGE_FLAGS:
+			*params = GLint(buffer->storage_flags); break;
+#endif
+		default: set_error(GL_INVALID_ENUM);
+	}
+}
+
+void APIENTRY glCopyBufferSubData(
+	GLenum read_target,
+	GLenum write_target,
+	GLintptr read_offset,
+	GLintptr write_offset,
+	GLsizeiptr size
+)
+{
+	RecordCall call(
+		"glCopyBufferSubData",
+		read_target, write_target, read_offset, write_offset, size
+	);
+	BufferObject* read = bound_buffer(read_target);
+	BufferObject* write = bound_buffer(write_target);
+	if(!read || !write) return;
+	if(!check_range(*read, read_offset, size)) return;
+	if(!check_range(*write, write_offset, size)) return;
+	if(read->mapped || write->mapped) set_error(GL_INVALID_OPERATION);
+	else std::memmove(
+		write->data.data()+write_offset,
+		read->data.data()+read_offset,
+		std::size_t(size)
+	);
+}
+
+static void* map_buffer_range(
+	GLenum target,
+	GLintptr offset,
+	GLsizeiptr length,
+	GLbitfield access
+)
+{
+	BufferObject* buffer = bound_buffer(target);
+	if(!buffer || !check_range(*buffer, offset, length)) return nullptr;
+	if(buffer->mapped || (length == 0))
+	{
+		set_error(GL_INVALID_OPERATION);
+		return nullptr;
+	}
+	buffer->mapped = GL_TRUE;
+	buffer->map_access = access;
+	buffer->map_offset = offset;
+	buffer->map_length = length;
+	return buffer->data.data()+offset;
+}
+
+void* APIENTRY glMapBuffer(GLenum target, GLenum access)
+{
+	RecordCall call("glMapBuffer", target, access);
+	BufferObject* buffer = bound_buffer(target);
+	if(!buffer) return nullptr;
+	GLbitfield bits = 0;
+	switch(access)
+	{
+		case GL_READ_ONLY: bits = GL_MAP_READ_BIT; break;
+		case GL_WRITE_ONLY: bits = GL_MAP_WRITE_BIT; break;
+		case GL_READ_WRITE: bits = GL_MAP_READ_BIT|GL_MAP_WRITE_BIT; break;
+		default:
+			set_error(GL_INVALID_ENUM);
+			return nullptr;
+	}
+	return map_buffer_range(
+		target,
+		0,
+		GLsizeiptr(buffer->data.size()),
+		bits
+	);
+}
+
+void* APIENTRY glMapBufferRange(
+	GLenum target,
+	GLintptr offset,
+	GLsizeiptr length,
+	GLbitfield access
+)
+{
+	RecordCall call("glMapBufferRange", target, offset, length, access);
+	return map_buffer_range(target, offset, length, access);
+}
+
+GLboolean APIENTRY glUnmapBuffer(GLenum target)
+{
+	RecordCall call("glUnmapBuffer", target);
+	BufferObject* buffer = bound_buffer(target);
+	if(!buffer) return GL_FALSE;
+	if(!buffer->mapped)
+	{
+		set_error(GL_INVALID_OPERATION);
+		return GL_FALSE;
+	}
+	const GLboolean result = buffer->corrupted?GL_FALSE:GL_TRUE;
+	buffer->mapped = GL_FALSE;
+	buffer->corrupted = GL_FALSE;
+	buffer->map_access = 0;
+	buffer->map_offset = 0;
+	buffer->map_length = 0;
+	return result;
+}
+
+void APIENTRY glFlushMappedBufferRange(
+	GLenum target,
+	GLintptr offset,
+	GLsizeiptr length
+)
+{
+	RecordCall call("glFlushMappedBufferRange", target, offset, length);
+	BufferObject* buffer = bound_buffer(target);
+	if(!buffer) return;
+	if(!buffer->mapped || !(buffer->map_access & GL_MAP_FLUSH_EXPLICIT_BIT))
+		set_error(GL_INVALID_OPERATION);
+	else if((offset < 0) || (length < 0) ||
+		(offset + length > buffer->map_length))
+		set_error(GL_INVALID_VALUE);
+}
+
+// textures and samplers
+
+void APIENTRY glGenTextures(GLsizei n, GLuint* textures)
+{
+	RecordCall call("glGenTextures", n, textures);
+	if(n < 0)
+	{
+		set_error(GL_INVALID_VALUE);
+		return;
+	}
+	State& s = state();
+	for(GLsizei i=0; i!=n; ++i)
+	{
+		textures[i] = s.next_name++;
+		s.textures.insert(textures[i]);
+	}
+}
+
+void APIENTRY glDeleteTextures(GLsizei n, const GLuint* textures)
+{
+	RecordCall call("glDeleteTextures", n, textures);
+	if(n < 0)
+	{
+		set_error(GL_INVALID_VALUE);
+		return;
+	}
+	State& s = state();
+	for(GLsizei i=0; i!=n; ++i)
+	{
+		if(textures[i] == 0) continue;
+		auto b = s.texture_bindings.begin(), e = s.texture_bindings.end();
+		for(auto j=b; j!=e; ++j)
+			if(j->second == textures[i]) j->second = 0;
+		s.textures.erase(textures[i]);
+	}
+}
+
+void APIENTRY glActiveTexture(GLenum texture)
+{
+	RecordCall call("glActiveTexture", texture);
+	if((texture < GL_TEXTURE0) || (texture >= GL_TEXTURE0 + 32))
+		set_error(GL_INVALID_ENUM);
+	else state().active_texture = texture - GL_TEXTURE0;
+}
+
+void APIENTRY glBindTexture(GLenum target, GLuint texture)
+{
+	RecordCall call("glBindTexture", target, texture);
+	State& s = state();
+	if(texture && !s.textures.count(texture))
+		set_error(GL_INVALID_OPERATION);
+	else s.texture_bindings[std::make_pair(s.active_texture, target)] = texture;
+}
+
+void APIENTRY glGenSamplers(GLsizei n, GLuint* samplers)
+{
+	RecordCall call("glGenSamplers", n, samplers);
+	if(n < 0)
+	{
+		set_error(GL_INVALID_VALUE);
+		return;
+	}
+	State& s = state();
+	for(GLsizei i=0; i!=n; ++i)
+	{
+		samplers[i] = s.next_name++;
+		s.samplers.insert(samplers[i]);
+	}
+}
+
+void APIENTRY glDeleteSamplers(GLsizei n, const GLuint* samplers)
+{
+	RecordCall call("glDeleteSamplers", n, samplers);
+	if(n < 0)
+	{
+		set_error(GL_INVALID_VALUE);
+		return;
+	}
+	State& s = state();
+	for(GLsizei i=0; i!=n; ++i)
+	{
+		if(samplers[i] == 0) continue;
+		auto b = s.sampler_bindings.begin(), e = s.sampler_bindings.end();
+		for(auto j=b; j!=e; ++j)
+			if(j->second == samplers[i]) j->second = 0;
+		s.samplers.erase(samplers[i]);
+	}
+}
+
+void APIENTRY glBindSampler(GLuint unit, GLuint sampler)
+{
+	RecordCall call("glBindSampler", unit, sampler);
+	State& s = state();
+	if(unit >= 32) set_error(GL_INVALID_VALUE);
+	else if(sampler && !s.samplers.count(sampler))
+		set_error(GL_INVALID_OPERATION);
+	else s.sampler_bindings[unit] = sampler;
+}
+
+// shaders
+
+static ShaderObject* shader_object(GLuint shader)
+{
+	auto pos = state().shaders.find(shader);
+	if((shader == 0) || (pos == state().shaders.end()))
+	{
+		set_error(GL_INVALID_VALUE);
+		return nullptr;
+	}
+	return &pos->second;
+}
+
+GLuint APIENTRY glCreateShader(GLenum type)
+{
+	RecordCall call("glCreateShader", type);
+	switch(type)
+	{
+		case GL_VERTEX_SHADER:
+		case GL_TESS_CONTROL_SHADER:
+		case GL_TESS_EVALUATION_SHADER:
+		case GL_GEOMETRY_SHADER:
+		case GL_FRAGMENT_SHADER:
+#if GL_VERSION_4_3
+		case GL_COMPUTE_SHADER:
+#endif
+			break;
+		default:
+			set_error(GL_INVALID_ENUM);
+			return 0;
+	}
+	State& s = state();
+	GLuint result = s.next_name++;
+	ShaderObject shader = { type, std::string(), GL_FALSE, 0 };
+	s.shaders[result] = shader;
+	return result;
+}
+
+void APIENTRY glDeleteShader(GLuint shader)
+{
+	RecordCall call("glDeleteShader", shader);
+	if(shader == 0) return;
+	if(!shader_object(shader)) return;
+	state().shaders.erase(shader);
+}
+
+void APIENTRY glShaderSource(
+	GLuint shader,
+	GLsizei count,
+	const GLchar* const* strings,
+	const GLint* lengths
+)
+{
+	RecordCall call("glShaderSource", shader, count, strings, lengths);
+	ShaderObject* object = shader_object(shader);
+	if(!object) return;
+	object->source.clear();
+	for(GLsizei i=0; i!=count; ++i)
+	{
+		if(lengths && (lengths[i] >= 0))
+			object->source.append(strings[i], lengths[i]);
+		else object->source.append(strings[i]);
+	}
+}
+
+void APIENTRY glCompileShader(GLuint shader)
+{
+	RecordCall call("glCompileShader", shader);
+	ShaderObject* object = shader_object(shader);
+	if(!object) return;
+	// the sources containing an #error directive fail to compile
+	bool failed = object->source.find("#error") != std::string::npos;
+	object->compiled = failed?GL_FALSE:GL_TRUE;
+	object->pending_polls = state().completion_latency;
+}
+
+void APIENTRY glGetShaderiv(GLuint shader, GLenum pname, GLint* params)
+{
+	RecordCall call("glGetShaderiv", shader, pname, params);
+	ShaderObject* object = shader_object(shader);
+	if(!object) return;
+	switch(pname)
+	{
+		case GL_SHADER_TYPE: *params = GLint(object->type); break;
+		case GL_COMPILE_STATUS:
+			// the status query waits for the compilation
+			object->pending_polls = 0;
+			*params = object->compiled;
+			break;
+		case GL_COMPLETION_STATUS_KHR:
+			if(object->pending_polls == 0) *params = GL_TRUE;
+			else
+			{
+				--object->pending_polls;
+				*params = GL_FALSE;
+			}
+			break;
+		case GL_INFO_LOG_LENGTH: *params = 0; break;
+		case GL_SHADER_SOURCE_LENGTH:
+			*params = GLint(object->source.size()+1);
+			break;
+		default: set_error(GL_INVALID_ENUM);
+	}
+}
+
+void APIENTRY glGetShaderInfoLog(
+	GLuint shader,
+	GLsizei buf_size,
+	GLsizei* length,
+	GLchar* info_log
+)
+{
+	RecordCall call(
+		"glGetShaderInfoLog",
+		shader,
+		buf_size,
+		length,
+		info_log
+	);
+	if(!shader_object(shader)) return;
+	if(buf_size > 0) info_log[0] = '\0';
+	if(length) *length = 0;
+}
+
+#if GL_KHR_parallel_shader_compile
+void APIENTRY glMaxShaderCompilerThreadsKHR(GLuint count)
+{
+	RecordCall call("glMaxShaderCompilerThreadsKHR", count);
+	state().compiler_threads = count;
+}
+#endif
+
+// programs
+
+static ProgramObject* program_object(GLuint program)
+{
+	auto pos = state().programs.find(program);
+	if((program == 0) || (pos == state().programs.end()))
+	{
+		set_error(GL_INVALID_VALUE);
+		return nullptr;
+	}
+	return &pos->second;
+}
+
+static std::string array_element_name(const UniformInfo& uniform)
+{
+	return (uniform.size > 1)?uniform.name+"[0]":uniform.name;
+}
+
+static void copy_name(
+	const std::string& name,
+	GLsizei buf_size,
+	GLsizei* length,
+	GLchar* buffer
+)
+{
+	GLsizei len = 0;
+	if(buf_size > 0)
+	{
+		len = std::min(GLsizei(name.size()), buf_size-1);
+		std::memcpy(buffer, name.c_str(), len);
+		buffer[len] = '\0';
+	}
+	if(length) *length = len;
+}
+
+GLuint APIENTRY glCreateProgram(void)
+{
+	RecordCall call("glCreateProgram");
+	State& s = state();
+	GLuint result = s.next_name++;
+	s.programs[result] = ProgramObject();
+	return result;
+}
+
+void APIENTRY glDeleteProgram(GLuint program)
+{
+	RecordCall call("glDeleteProgram", program);
+	if(program == 0) return;
+	if(!program_object(program)) return;
+	state().programs.erase(program);
+}
+
+void APIENTRY glAttachShader(GLuint program, GLuint shader)
+{
+	RecordCall call("glAttachShader", program, shader);
+	ProgramObject* object = program_object(program);
+	if(!object || !shader_object(shader)) return;
+	auto b = object->shaders.begin(), e = object->shaders.end();
+	if(std::find(b, e, shader) != e) set_error(GL_INVALID_OPERATION);
+	else object->shaders.push_back(shader);
+}
+
+void APIENTRY glDetachShader(GLuint program, GLuint shader)
+{
+	RecordCall call("glDetachShader", program, shader);
+	ProgramObject* object = program_object(program);
+	if(!object || !shader_object(shader)) return;
+	auto b = object->shaders.begin(), e = object->shaders.end();
+	auto pos = std::find(b, e, shader);
+	if(pos == e) set_error(GL_INVALID_OPERATION);
+	else object->shaders.erase(pos);
+}
+
+void APIENTRY glBindAttribLocation(
+	GLuint program,
+	GLuint index,
+	const GLchar* name
+)
+{
+	RecordCall call("glBindAttribLocation", program, index, name);
+	if(!program_object(program)) return;
+	if(index >= 16) set_error(GL_INVALID_VALUE);
+}
+
+void APIENTRY glTransformFeedbackVaryings(
+	GLuint program,
+	GLsizei count,
+	const GLchar* const* varyings,
+	GLenum buffer_mode
+)
+{
+	RecordCall call(
+		"glTransformFeedbackVaryings",
+		program,
+		count,
+		varyings,
+		buffer_mode
+	);
+	if(!program_object(program)) return;
+	if((buffer_mode != GL_INTERLEAVED_ATTRIBS) &&
+		(buffer_mode != GL_SEPARATE_ATTRIBS))
+		set_error(GL_INVALID_ENUM);
+}
+
+void APIENTRY glProgramParameteri(GLuint program, GLenum pname, GLint value)
+{
+	RecordCall call("glProgramParameteri", program, pname, value);
+	ProgramObject* object = program_object(program);
+	if(!object) return;
+	switch(pname)
+	{
+		case GL_PROGRAM_SEPARABLE:
+			object->separable = value?GL_TRUE:GL_FALSE;
+			break;
+		case GL_PROGRAM_BINARY_RETRIEVABLE_HINT:
+			object->retrievable = value?GL_TRUE:GL_FALSE;
+			break;
+		default: set_error(GL_INVALID_ENUM);
+	}
+}
+
+// assigns the locations to the uniforms in the default block
+static void link_uniforms(ProgramObject& object)
+{
+	GLint location = 0;
+	auto b = object.uniforms.begin(), e = object.uniforms.end();
+	for(auto i=b; i!=e; ++i)
+	{
+		if(i->block >= 0) continue;
+		i->location = location;
+		location += i->size;
+	}
+}
+
+// the header of the emulated binaries, changed by InvalidateProgramBinaries
+static std::string binary_header(void)
+{
+	std::stringstream header;
+	header << "mock program binary " << state().binary_version << '\n';
+	return header.str();
+}
+
+void APIENTRY glLinkProgram(GLuint program)
+{
+	RecordCall call("glLinkProgram", program);
+	ProgramObject* object = program_object(program);
+	if(!object) return;
+	object->pending_polls = state().completion_latency;
+	// the binary consists of the sources of the attached shaders
+	object->binary = binary_header();
+	auto sb = object->shaders.begin(), se = object->shaders.end();
+	for(auto i=sb; i!=se; ++i)
+	{
+		const ShaderObject& shader = state().shaders[*i];
+		if(!shader.compiled)
+		{
+			object->binary.clear();
+			object->linked = GL_FALSE;
+			return;
+		}
+		object->binary.append(shader.source);
+	}
+	link_uniforms(*object);
+	object->linked = GL_TRUE;
+}
+
+void APIENTRY glGetProgramBinary(
+	GLuint program,
+	GLsizei buf_size,
+	GLsizei* length,
+	GLenum* binary_format,
+	void* binary
+)
+{
+	RecordCall call(
+		"glGetProgramBinary",
+		program,
+		buf_size,
+		length,
+		binary_format,
+		binary
+	);
+	ProgramObject* object = program_object(program);
+	if(!object) return;
+	if(!object->linked || (GLsizei(object->binary.size()) > buf_size))
+	{
+		set_error(GL_INVALID_OPERATION);
+		return;
+	}
+	std::memcpy(binary, object->binary.data(), object->binary.size());
+	if(length) *length = GLsizei(object->binary.size());
+	*binary_format = mock_binary_format;
+}
+
+void APIENTRY glProgramBinary(
+	GLuint program,
+	GLenum binary_format,
+	const void* binary,
+	GLsizei length
+)
+{
+	RecordCall call(
+		"glProgramBinary",
+		program,
+		binary_format,
+		binary,
+		length
+	);
+	ProgramObject* object = program_object(program);
+	if(!object) return;
+	if(binary_format != mock_binary_format)
+	{
+		set_error(GL_INVALID_ENUM);
+		return;
+	}
+	object->binary.assign(static_cast<const char*>(binary), length);
+	// the binaries from a different version of the "driver" are rejected
+	const std::string header = binary_header();
+	object->linked =
+		(object->binary.compare(0, header.size(), header) == 0)?
+		GL_TRUE:
+		GL_FALSE;
+	if(object->linked) link_uniforms(*object);
+	else object->binary.clear();
+}
+
+void APIENTRY glGetProgramiv(GLuint program, GLenum pname, GLint* params)
+{
+	RecordCall call("glGetProgramiv", program, pname, params);
+	ProgramObject* object = program_object(program);
+	if(!object) return;
+	switch(pname)
+	{
+		case GL_LINK_STATUS:
+			// the status query waits for the linking
+			object->pending_polls = 0;
+			*params = object->linked;
+			break;
+		case GL_COMPLETION_STATUS_KHR:
+			if(object->pending_polls == 0) *params = GL_TRUE;
+			else
+			{
+				--object->pending_polls;
+				*params = GL_FALSE;
+			}
+			break;
+		case GL_INFO_LOG_LENGTH:
+			*params = 0;
+			break;
+		case GL_ATTACHED_SHADERS:
+			*params = GLint(object->shaders.size());
+			break;
+		case GL_PROGRAM_SEPARABLE:
+			*params = object->separable;
+			break;
+		case GL_PROGRAM_BINARY_RETRIEVABLE_HINT:
+			*params = object->retrievable;
+			break;
+		case GL_PROGRAM_BINARY_LENGTH:
+			*params = GLint(object->binary.size());
+			break;
+		case GL_ACTIVE_UNIFORMS:
+			*params = object->linked?GLint(object->uniforms.size()):0;
+			break;
+		case GL_ACTIVE_UNIFORM_MAX_LENGTH:
+		{
+			std::size_t max_length = 0;
+			auto b = object->uniforms.begin(), e = object->uniforms.end();
+			for(auto i=b; i!=e; ++i)
+			{
+				std::size_t length = array_element_name(*i).size()+1;
+				if(max_length < length) max_length = length;
+			}
+			*params = GLint(max_length);
+			break;
+		}
+		case GL_ACTIVE_UNIFORM_BLOCKS:
+			*params = object->linked?GLint(object->blocks.size()):0;
+			break;
+		case GL_ACTIVE_UNIFORM_BLOCK_MAX_NAME_LENGTH:
+		{
+			std::size_t max_length = 0;
+			auto b = object->blocks.begin(), e = object->blocks.end();
+			for(auto i=b; i!=e; ++i)
+			{
+				if(max_length < i->size()+1)
+					max_length = i->size()+1;
+			}
+			*params = GLint(max_length);
+			break;
+		}
+		default: set_error(GL_INVALID_ENUM);
+	}
+}
+
+void APIENTRY glGetProgramInfoLog(
+	GLuint program,
+	GLsizei buf_size,
+	GLsizei* length,
+	GLchar* info_log
+)
+{
+	RecordCall call(
+		"glGetProgramInfoLog",
+		program,
+		buf_size,
+		length,
+		info_log
+	);
+	if(!program_object(program)) return;
+	// the emulated programs always link without any messages
+	copy_name(std::string(), buf_size, length, info_log);
+}
+
+void APIENTRY glGetActiveUniform(
+	GLuint program,
+	GLuint index,
+	GLsizei buf_size,
+	GLsizei* length,
+	GLint* size,
+	GLenum* type,
+	GLchar* name
+)
+{
+	RecordCall call(
+		"glGetActiveUniform",
+		program,
+		index,
+		buf_size,
+		length,
+		size,
+		type,
+		name
+	);
+	ProgramObject* object = program_object(program);
+	if(!object) return;
+	if(!object->linked || (index >= object->uniforms.size()))
+	{
+		set_error(GL_INVALID_VALUE);
+		return;
+	}
+	const UniformInfo& uniform = object->uniforms[index];
+	copy_name(array_element_name(uniform), buf_size, length, name);
+	*size = uniform.size;
+	*type = uniform.type;
+}
+
+void APIENTRY glGetActiveUniformsiv(
+	GLuint program,
+	GLsizei count,
+	const GLuint* indices,
+	GLenum pname,
+	GLint* params
+)
+{
+	RecordCall call(
+		"glGetActiveUniformsiv",
+		program,
+		count,
+		indices,
+		pname,
+		params
+	);
+	ProgramObject* object = program_object(program);
+	if(!object) return;
+	for(GLsizei i=0; i!=count; ++i)
+	{
+		if(indices[i] >= object->uniforms.size())
+		{
+			set_error(GL_INVALID_VALUE);
+			return;
+		}
+		const UniformInfo& uniform = object->uniforms[indices[i]];
+		switch(pname)
+		{
+			case GL_UNIFORM_TYPE: params[i] = uniform.type; break;
+			case GL_UNIFORM_SIZE: params[i] = uniform.size; break;
+			case GL_UNIFORM_BLOCK_INDEX: params[i] = uniform.block; break;
+			default:
+				set_error(GL_INVALID_ENUM);
+				return;
+		}
+	}
+}
+
+GLint APIENTRY glGetUniformLocation(GLuint program, const GLchar* name)
+{
+	RecordCall call("glGetUniformLocation", program, name);
+	ProgramObject* object = program_object(program);
+	if(!object) return -1;
+	if(!object->linked)
+	{
+		set_error(GL_INVALID_OPERATION);
+		return -1;
+	}
+	const std::string str(name);
+	auto b = object->uniforms.begin(), e = object->uniforms.end();
+	for(auto i=b; i!=e; ++i)
+	{
+		if(i->block >= 0) continue;
+		if((str == i->name) || (str == array_element_name(*i)))
+			return i->location;
+		// the elements of arrays "name[N]"
+		const std::string prefix = i->name+"[";
+		if((i->size > 1) && (str.compare(0, prefix.size(), prefix) == 0))
+		{
+			GLint element = std::atoi(str.c_str()+prefix.size());
+			if((element >= 0) && (element < i->size))
+				return i->location+element;
+		}
+	}
+	return -1;
+}
+
+void APIENTRY glGetActiveUniformBlockName(
+	GLuint program,
+	GLuint index,
+	GLsizei buf_size,
+	GLsizei* length,
+	GLchar* name
+)
+{
+	RecordCall call(
+		"glGetActiveUniformBlockName",
+		program,
+		index,
+		buf_size,
+		length,
+		name
+	);
+	ProgramObject* object = program_object(program);
+	if(!object) return;
+	if(!object->linked || (index >= object->blocks.size()))
+	{
+		set_error(GL_INVALID_VALUE);
+		return;
+	}
+	copy_name(object->blocks[index], buf_size, length, name);
+}
+
+GLuint APIENTRY glGetUniformBlockIndex(GLuint program, const GLchar* name)
+{
+	RecordCall call("glGetUniformBlockIndex", program, name);
+	ProgramObject* object = program_object(program);
+	if(!object) return GL_INVALID_INDEX;
+	auto b = object->blocks.begin(), e = object->blocks.end();
+	auto pos = std::find(b, e, std::string(name));
+	if(!object->linked || (pos == e)) return GL_INVALID_INDEX;
+	return GLuint(pos - b);
+}
+
+void APIENTRY glUseProgram(GLuint program)
+{
+	RecordCall call("glUseProgram", program);
+	State& s = state();
+	if((program != 0) && !s.programs.count(program))
+		set_error(GL_INVALID_VALUE);
+	else if((program != 0) && !s.programs[program].linked)
+		set_error(GL_INVALID_OPERATION);
+	else s.program = program;
+}
+
+// vertex arrays
+
+void APIENTRY glGenVertexArrays(GLsizei n, GLuint* arrays)
+{
+	RecordCall call("glGenVertexArrays", n, arrays);
+	if(n < 0)
+	{
+		set_error(GL_INVALID_VALUE);
+		return;
+	}
+	State& s = state();
+	for(GLsizei i=0; i!=n; ++i)
+	{
+		arrays[i] = s.next_name++;
+		s.vertex_arrays[arrays[i]] = VertexArrayObject();
+	}
+}
+
+void APIENTRY glDeleteVertexArrays(GLsizei n, const GLuint* arrays)
+{
+	RecordCall call("glDeleteVertexArrays", n, arrays);
+	if(n < 0)
+	{
+		set_error(GL_INVALID_VALUE);
+		return;
+	}
+	State& s = state();
+	for(GLsizei i=0; i!=n; ++i)
+	{
+		if(arrays[i] == 0) continue;
+		if(s.vertex_array == arrays[i]) s.vertex_array = 0;
+		s.vertex_arrays.erase(arrays[i]);
+	}
+}
+
+GLboolean APIENTRY glIsVertexArray(GLuint array)
+{
+	RecordCall call("glIsVertexArray", array);
+	return (array && state().vertex_arrays.count(array))?GL_TRUE:GL_FALSE;
+}
+
+void APIENTRY glBindVertexArray(GLuint array)
+{
+	RecordCall call("glBindVertexArray", array);
+	if(!state().vertex_arrays.count(array)) set_error(GL_INVALID_OPERATION);
+	else state().vertex_array = array;
+}
+
+static VertexAttrib* vertex_attrib(GLuint index)
+{
+	State& s = state();
+	std::vector<VertexAttrib>& attribs =
+		s.vertex_arrays[s.vertex_array].attribs;
+	if(index >= attribs.size())
+	{
+		set_error(GL_INVALID_VALUE);
+		return nullptr;
+	}
+	return &attribs[index];
+}
+
+void APIENTRY glEnableVertexAttribArray(GLuint index)
+{
+	RecordCall call("glEnableVertexAttribArray", index);
+	if(VertexAttrib* attrib = vertex_attrib(index))
+		attrib->enabled = GL_TRUE;
+}
+
+void APIENTRY glDisableVertexAttribArray(GLuint index)
+{
+	RecordCall call("glDisableVertexAttribArray", index);
+	if(VertexAttrib* attrib = vertex_attrib(index))
+		attrib->enabled = GL_FALSE;
+}
+
+static void vertex_attrib_pointer(
+	GLuint index,
+	GLint size,
+	GLenum type,
+	GLsizei stride,
+	const void* pointer
+)
+{
+	VertexAttrib* attrib = vertex_attrib(index);
+	if(!attrib) return;
+	if((size < 1) || (size > 4) || (stride < 0))
+	{
+		set_error(GL_INVALID_VALUE);
+		return;
+	}
+	attrib->size = size;
+	attrib->type = type;
+	attrib->stride = stride;
+	attrib->pointer = pointer;
+	attrib->buffer = state().buffer_bindings[GL_ARRAY_BUFFER];
+}
+
+void APIENTRY glVertexAttribPointer(
+	GLuint index,
+	GLint size,
+	GLenum type,
+	GLboolean normalized,
+	GLsizei stride,
+	const void* pointer
+)
+{
+	RecordCall call(
+		"glVertexAttribPointer",
+		index, size, type, normalized, stride, pointer
+	);
+	vertex_attrib_pointer(index, size, type, stride, pointer);
+}
+
+void APIENTRY glVertexAttribIPointer(
+	GLuint index,
+	GLint size,
+	GLenum type,
+	GLsizei stride,
+	const void* pointer
+)
+{
+	RecordCall call(
+		"glVertexAttribIPointer",
+		index, size, type, stride, pointer
+	);
+	vertex_attrib_pointer(index, size, type, stride, pointer);
+}
+
+void APIENTRY glVertexAttribDivisor(GLuint index, GLuint divisor)
+{
+	RecordCall call("glVertexAttribDivisor", index, divisor);
+	if(VertexAttrib* attrib = vertex_attrib(index))
+		attrib->divisor = divisor;
+}
+
+// drawing
+
+void APIENTRY glDrawArrays(GLenum mode, GLint first, GLsizei count)
+{
+	RecordCall call("glDrawArrays", mode, first, count);
+	if(first < 0) set_error(GL_INVALID_VALUE);
+	else check_draw(count);
+}
+
+void APIENTRY glDrawArraysInstanced(
+	GLenum mode,
+	GLint first,
+	GLsizei count,
+	GLsizei instance_count
+)
+{
+	RecordCall call(
+		"glDrawArraysInstanced",
+		mode, first, count, instance_count
+	);
+	if(first < 0) set_error(GL_INVALID_VALUE);
+	else check_draw(count, instance_count);
+}
+
+void APIENTRY glDrawArraysInstancedBaseInstance(
+	GLenum mode,
+	GLint first,
+	GLsizei count,
+	GLsizei instance_count,
+	GLuint base_instance
+)
+{
+	RecordCall call(
+		"glDrawArraysInstancedBaseInstance",
+		mode, first, count, instance_count, base_instance
+	);
+	if(first < 0) set_error(GL_INVALID_VALUE);
+	else check_draw(count, instance_count);
+}
+
+void APIENTRY glMultiDrawArrays(
+	GLenum mode,
+	const GLint* first,
+	const GLsizei* count,
+	GLsizei draw_count
+)
+{
+	RecordCall call("glMultiDrawArrays", mode, first, count, draw_count);
+	if(draw_count < 0) set_error(GL_INVALID_VALUE);
+	else for(GLsizei i=0; i!=draw_count; ++i)
+	{
+		if(first[i] < 0) set_error(GL_INVALID_VALUE);
+		else check_draw(count[i]);
+	}
+}
+
+void APIENTRY glDrawArraysIndirect(GLenum mode, const void* indirect)
+{
+	RecordCall call("glDrawArraysIndirect", mode, indirect);
+	check_indirect(indirect, 1, 0, 4*sizeof(GLuint));
+}
+
+void APIENTRY glMultiDrawArraysIndirect(
+	GLenum mode,
+	const void* indirect,
+	GLsizei draw_count,
+	GLsizei stride
+)
+{
+	RecordCall call(
+		"glMultiDrawArraysIndirect",
+		mode, indirect, draw_count, stride
+	);
+	check_indirect(indirect, draw_count, stride, 4*sizeof(GLuint));
+}
+
+void APIENTRY glDrawElements(
+	GLenum mode,
+	GLsizei count,
+	GLenum type,
+	const void* indices
+)
+{
+	RecordCall call("glDrawElements", mode, count, type, indices);
+	check_elements(count, type, indices);
+}
+
+void APIENTRY glDrawRangeElements(
+	GLenum mode,
+	GLuint start,
+	GLuint end,
+	GLsizei count,
+	GLenum type,
+	const void* indices
+)
+{
+	RecordCall call(
+		"glDrawRangeElements",
+		mode, start, end, count, type, indices
+	);
+	if(end < start) set_error(GL_INVALID_VALUE);
+	else check_elements(count, type, indices);
+}
+
+void APIENTRY glDrawElementsInstanced(
+	GLenum mode,
+	GLsizei count,
+	GLenum type,
+	const void* indices,
+	GLsizei instance_count
+)
+{
+	RecordCall call(
+		"glDrawElementsInstanced",
+		mode, count, type, indices, instance_count
+	);
+	if(check_draw(count, instance_count))
+		check_elements(count, type, indices);
+}
+
+void APIENTRY glDrawElementsInstancedBaseInstance(
+	GLenum mode,
+	GLsizei count,
+	GLenum type,
+	const void* indices,
+	GLsizei instance_count,
+	GLuint base_instance
+)
+{
+	RecordCall call(
+		"glDrawElementsInstancedBaseInstance",
+		mode, count, type, indices, instance_count, base_instance
+	);
+	if(check_draw(count, instance_count))
+		check_elements(count, type, indices);
+}
+
+void APIENTRY glDrawElementsBaseVertex(
+	GLenum mode,
+	GLsizei count,
+	GLenum type,
+	const void* indices,
+	GLint base_vertex
+)
+{
+	RecordCall call(
+		"glDrawElementsBaseVertex",
+		mode, count, type, indices, base_vertex
+	);
+	check_elements(count, type, indices);
+}
+
+void APIENTRY glDrawRangeElementsBaseVertex(
+	GLenum mode,
+	GLuint start,
+	GLuint end,
+	GLsizei count,
+	GLenum type,
+	const void* indices,
+	GLint base_vertex
+)
+{
+	RecordCall call(
+		"glDrawRangeElementsBaseVertex",
+		mode, start, end, count, type, indices, base_vertex
+	);
+	if(end < start) set_error(GL_INVALID_VALUE);
+	else check_elements(count, type, indices);
+}
+
+void APIENTRY glDrawElementsInstancedBaseVertex(
+	GLenum mode,
+	GLsizei count,
+	GLenum type,
+	const void* indices,
+	GLsizei instance_count,
+	GLint base_vertex
+)
+{
+	RecordCall call(
+		"glDrawElementsInstancedBaseVertex",
+		mode, count, type, indices, instance_count, base_vertex
+	);
+	if(check_draw(count, instance_count))
+		check_elements(count, type, indices);
+}
+
+void APIENTRY glDrawElementsInstancedBaseVertexBaseInstance(
+	GLenum mode,
+	GLsizei count,
+	GLenum type,
+	const void* indices,
+	GLsizei instance_count,
+	GLint base_vertex,
+	GLuint base_instance
+)
+{
+	RecordCall call(
+		"glDrawElementsInstancedBaseVertexBaseInstance",
+		mode, count, type, indices,
+		instance_count, base_vertex, base_instance
+	);
+	if(check_draw(count, instance_count))
+		check_elements(count, type, indices);
+}
+
+void APIENTRY glMultiDrawElements(
+	GLenum mode,
+	const GLsizei* count,
+	GLenum type,
+	const void* const* indices,
+	GLsizei draw_count
+)
+{
+	RecordCall call(
+		"glMultiDrawElements",
+		mode, count, type, indices, draw_count
+	);
+	if(draw_count < 0) set_error(GL_INVALID_VALUE);
+	else for(GLsizei i=0; i!=draw_count; ++i)
+		check_elements(count[i], type, indices[i]);
+}
+
+void APIENTRY glMultiDrawElementsBaseVertex(
+	GLenum mode,
+	const GLsizei* count,
+	GLenum type,
+	const void* const* indices,
+	GLsizei draw_count,
+	const GLint* base_vertex
+)
+{
+	RecordCall call(
+		"glMultiDrawElementsBaseVertex",
+		mode, count, type, indices, draw_count, base_vertex
+	);
+	if(draw_count < 0) set_error(GL_INVALID_VALUE);
+	else for(GLsizei i=0; i!=draw_count; ++i)
+		check_elements(count[i], type, indices[i]);
+}
+
+void APIENTRY glDrawElementsIndirect(
+	GLenum mode,
+	GLenum type,
+	const void* indirect
+)
+{
+	RecordCall call("glDrawElementsIndirect", mode, type, indirect);
+	if(index_type_size(type) != 0)
+		check_indirect(indirect, 1, 0, 5*sizeof(GLuint));
+}
+
+void APIENTRY glMultiDrawElementsIndirect(
+	GLenum mode,
+	GLenum type,
+	const void* indirect,
+	GLsizei draw_count,
+	GLsizei stride
+)
+{
+	RecordCall call(
+		"glMultiDrawElementsIndirect",
+		mode, type, indirect, draw_count, stride
+	);
+	if(index_type_size(type) != 0)
+		check_indirect(indirect, draw_count, stride, 5*sizeof(GLuint));
+}
+
+} // extern "C"
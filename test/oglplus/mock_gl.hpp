@@ -0,0 +1,147 @@
+/**
+ *  .file test/oglplus/mock_gl.hpp
+ *  .brief Declaration of the interface of the recording mock GL implementation.
+ *
+ *  .author Matus Chochlik
+ *
+ *  Copyright 2010-2013 Matus Chochlik. Distributed under the Boost
+ *  Software License, Version 1.0. (See accompanying file
+ *  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ */
+
+#ifndef __OGLPLUS_TEST_MOCK_GL_1311041630_HPP__
+#define __OGLPLUS_TEST_MOCK_GL_1311041630_HPP__
+
+#include <oglplus/gl.hpp>
+
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <iosfwd>
+
+// The mock implements (a subset of) the GL functions declared by
+// glcorearb.h or gl3.h in software. It keeps the object names,
+// the bindings and the contents of the buffers in memory and records
+// every call together with its arguments, so the wrappers can be tested
+// and the number of GL calls issued by them can be measured without a GPU.
+namespace oglplus {
+namespace mock {
+
+// A recorded call of a GL function
+struct GLCall
+{
+	// The name of the GL function (for example "glBindBuffer")
+	const char* name;
+
+	// The comma separated list of the arguments
+	std::string args;
+};
+
+// Resets the whole state of the mock GL including the recorded calls
+void Reset(void);
+
+// Clears the recorded calls and the statistics, but keeps the GL state
+void ClearCalls(void);
+
+// Returns the list of the GL calls recorded since the last (Clear|Reset)
+const std::vector<GLCall>& Calls(void);
+
+// Returns the total number of the recorded GL calls
+std::size_t CallCount(void);
+
+// Returns the number of the recorded calls of the specified GL function
+std::size_t CallCount(const char* name);
+
+// Writes a report with the call counts and times per function to out
+void Report(std::ostream& out);
+
+// Raises the flag of the specified error, returned by glGetError
+/* Like in GL, each kind of error has its own flag, the flags are
+ * returned by glGetError in the order in which they were raised.
+ */
+void SetError(GLenum error);
+
+// Returns the name of the buffer bound to the specified target
+GLuint BoundBuffer(GLenum target);
+
+// Returns the name of the currently bound vertex array object
+GLuint BoundVertexArray(void);
+
+// Returns the contents of the buffer with the specified name
+const std::vector<GLubyte>& BufferData(GLuint buffer);
+
+// Returns the usage hint of the buffer with the specified name
+GLenum BufferUsage(GLuint buffer);
+
+// Returns the index of the active texture unit
+GLuint ActiveTextureUnit(void);
+
+// Returns the name of the texture bound to the target on the specified unit
+GLuint BoundTexture(GLuint unit, GLenum target);
+
+// Returns the name of the sampler bound to the specified texture unit
+GLuint BoundSampler(GLuint unit);
+
+// Returns the name of the program in use
+GLuint CurrentProgram(void);
+
+// Adds an active uniform to the program, it becomes active after linking
+/* Arrays (size > 1) are reported as "name[0]" and the uniforms in blocks
+ * (block >= 0) do not have a location.
+ */
+void AddUniform(
+	GLuint program,
+	const char* name,
+	GLenum type,
+	GLint size = 1,
+	GLint block = -1
+);
+
+// Removes the uniforms and the uniform blocks added to the program
+/* This emulates a program with the same name but a different layout
+ * in another context, the change shows after the program is relinked.
+ */
+void ClearUniforms(GLuint program);
+
+// Adds an active uniform block to the program, returns its index
+GLint AddUniformBlock(GLuint program, const char* name);
+
+// Makes the previously retrieved program binaries invalid
+/* This emulates an update of the driver, programs loaded from the older
+ * binaries fail to link.
+ */
+void InvalidateProgramBinaries(void);
+
+// Makes all existing fence sync objects signaled
+/* This emulates the GPU catching up with the client, otherwise the fences
+ * are signaled only by glClientWaitSync and glFinish.
+ */
+void SignalFences(void);
+
+// Makes the data of the currently mapped buffers corrupted
+/* This emulates a change of the screen mode while the buffers are mapped,
+ * glUnmapBuffer returns GL_FALSE for them without raising an error.
+ */
+void CorruptMappedBuffers(void);
+
+// Returns the number of the existing sync objects
+std::size_t FenceCount(void);
+
+// Adds an extension to the list of the supported extensions
+void AddExtension(const char* name);
+
+// Sets the number of completion status queries reporting an unfinished job
+/* The compilation of the shaders and the linking of the programs
+ * are reported as unfinished by the specified number of queries of
+ * COMPLETION_STATUS_KHR after they start. The queries of the compile
+ * or link status wait for the job to finish.
+ */
+void SetCompletionLatency(GLuint polls);
+
+// Returns the value set by glMaxShaderCompilerThreadsKHR
+GLuint MaxShaderCompilerThreads(void);
+
+} // namespace mock
+} // namespace oglplus
+
+#endif // include guard
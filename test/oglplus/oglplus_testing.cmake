@@ -9,9 +9,26 @@ include(CTest)
 
 string(TOLOWER ${OGLPLUS_GL_INIT_LIB} OGLPLUS_TEST_FIXTURE)
 
+# the mock GL defines the functions declared by glcorearb.h or gl3.h
+if(OGLPLUS_TEST_WITH_MOCK_GL)
+	if((${OGLPLUS_USE_GLCOREARB_H}) OR (${OGLPLUS_USE_GL3_H}))
+		set(OGLPLUS_TEST_FIXTURE mock)
+	else()
+		message(
+			WARNING
+			"The mock GL requires the GL function prototypes "
+			"from glcorearb.h or gl3.h, using the "
+			"'${OGLPLUS_TEST_FIXTURE}' test fixture instead."
+		)
+		set(OGLPLUS_TEST_WITH_MOCK_GL Off)
+	endif()
+endif()
+
 # check the harness dependencies and requirements
 set(FIXTURE_CAN_BE_BUILT true)
-if(EXISTS ${CMAKE_CURRENT_SOURCE_DIR}/fixture_${OGLPLUS_TEST_FIXTURE}.cpp)
+if(OGLPLUS_TEST_WITH_MOCK_GL)
+	message(STATUS "Running the tests with the mock GL.")
+elseif(EXISTS ${CMAKE_CURRENT_SOURCE_DIR}/fixture_${OGLPLUS_TEST_FIXTURE}.cpp)
 	require_all_dependencies(${OGLPLUS_TEST_FIXTURE}_main FIXTURE_CAN_BE_BUILT)
 else()
 	message(
@@ -34,21 +51,35 @@ endif()
 
 include_directories(${PROJECT_SOURCE_DIR}/utils)
 
+set(OGLPLUS_TEST_FIXTURE_SOURCES
+	${CMAKE_CURRENT_SOURCE_DIR}/fixture_${OGLPLUS_TEST_FIXTURE}.cpp
+)
+if(OGLPLUS_TEST_WITH_MOCK_GL)
+	list(APPEND OGLPLUS_TEST_FIXTURE_SOURCES
+		${CMAKE_CURRENT_SOURCE_DIR}/mock_gl.cpp
+	)
+endif()
+
 add_library(
 	oglplus_test_fixture
 	STATIC
 	EXCLUDE_FROM_ALL
-	${CMAKE_CURRENT_SOURCE_DIR}/fixture_${OGLPLUS_TEST_FIXTURE}.cpp
+	${OGLPLUS_TEST_FIXTURE_SOURCES}
 )
-# add the dependencies for the fixture
-add_all_dependencies(fixture_${OGLPLUS_TEST_FIXTURE} oglplus_test_fixture)
 set_property(TARGET oglplus_test_fixture PROPERTY FOLDER "Test/OGLplus")
 
 # make a list of libraries that we're going to link to
-set(OGLPLUS_TEST_LIBS
-	oglplus_test_fixture
-	${OGLPLUS_GL_LIBS}
-)
+if(OGLPLUS_TEST_WITH_MOCK_GL)
+	# the GL functions are provided by the mock
+	set(OGLPLUS_TEST_LIBS oglplus_test_fixture)
+else()
+	# add the dependencies for the fixture
+	add_all_dependencies(fixture_${OGLPLUS_TEST_FIXTURE} oglplus_test_fixture)
+	set(OGLPLUS_TEST_LIBS
+		oglplus_test_fixture
+		${OGLPLUS_GL_LIBS}
+	)
+endif()
 
 
 function(add_oglplus_test TEST_NAME TEST_LIBRARIES BUILD_ONLY)
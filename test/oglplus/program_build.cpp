@@ -0,0 +1,121 @@
+/**
+ *  .file test/oglplus/program_build.cpp
+ *  .brief Test case for the asynchronous building of programs.
+ *
+ *  .author Matus Chochlik
+ *
+ *  Copyright 2010-2013 Matus Chochlik. Distributed under the Boost
+ *  Software License, Version 1.0. (See accompanying file
+ *  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ */
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE OGLPLUS_ProgramBuild
+#include <boost/test/unit_test.hpp>
+
+#include <oglplus/gl.hpp>
+#include <oglplus/program.hpp>
+#include <oglplus/program_build.hpp>
+#include <oglplus/compile_error.hpp>
+
+#include "fixture.hpp"
+#include "mock_gl.hpp"
+#include "program_sources.hpp"
+
+BOOST_GLOBAL_FIXTURE(OGLplusTestFixture);
+
+BOOST_AUTO_TEST_SUITE(ProgramBuild)
+
+static std::size_t status_queries(void)
+{
+	using namespace oglplus;
+	return	mock::CallCount("glGetShaderiv")+
+		mock::CallCount("glGetProgramiv");
+}
+
+BOOST_AUTO_TEST_CASE(ProgramBuild_deferred_status)
+{
+	using namespace oglplus;
+	ProgramSource source = make_source("void main(void){ }");
+	ProgramBuildQueue queue(false);
+	BOOST_CHECK(!queue.Parallel());
+
+	mock::ClearCalls();
+	Program first, second, third;
+	ProgramBuildHandle h1 = queue.Add(first, source);
+	ProgramBuildHandle h2 = queue.Add(second, source);
+	ProgramBuildHandle h3 = queue.Add(third, source);
+
+	// everything is submitted without waiting for the results
+	BOOST_CHECK_EQUAL(mock::CallCount("glCompileShader"), 6u);
+	BOOST_CHECK_EQUAL(mock::CallCount("glLinkProgram"), 3u);
+	BOOST_CHECK_EQUAL(mock::CallCount("glBindAttribLocation"), 3u);
+	BOOST_CHECK_EQUAL(status_queries(), 0u);
+	BOOST_CHECK_EQUAL(queue.Unfinished(), 3u);
+
+	// each poll waits only for the oldest unfinished build
+	BOOST_CHECK_EQUAL(queue.Poll(), 2u);
+	BOOST_CHECK(h1.Ready());
+	BOOST_CHECK(h2.Ready());
+	BOOST_CHECK_EQUAL(queue.Poll(), 0u);
+
+	BOOST_CHECK(h3.Get().IsLinked());
+	BOOST_CHECK_EQUAL(mock::CallCount("glDetachShader"), 6u);
+}
+
+#if GL_KHR_parallel_shader_compile || !OGLPLUS_USE_GLEW
+BOOST_AUTO_TEST_CASE(ProgramBuild_parallel)
+{
+	using namespace oglplus;
+	BOOST_CHECK(!ProgramBuildQueue().Parallel());
+	mock::AddExtension("GL_KHR_parallel_shader_compile");
+	BOOST_CHECK(KHR_parallel_shader_compile::Available());
+#if GL_KHR_parallel_shader_compile
+	KHR_parallel_shader_compile::MaxShaderCompilerThreads(4);
+	BOOST_CHECK_EQUAL(mock::MaxShaderCompilerThreads(), 4u);
+#endif
+
+	ProgramSource source = make_source("void main(void){ }");
+	ProgramBuildQueue queue;
+	BOOST_CHECK(queue.Parallel());
+
+	mock::SetCompletionLatency(2);
+	Program first, second;
+	ProgramBuildHandle h1 = queue.Add(first, source);
+	queue.Add(second, source);
+
+	// the polling does not wait for the driver
+	mock::ClearCalls();
+	BOOST_CHECK_EQUAL(queue.Poll(), 2u);
+	BOOST_CHECK(!h1.Ready());
+	BOOST_CHECK_EQUAL(mock::CallCount("glGetProgramiv"), 3u);
+	BOOST_CHECK_EQUAL(mock::CallCount("glGetShaderiv"), 0u);
+
+	// the link status is checked once the driver reports completion
+	BOOST_CHECK_EQUAL(queue.Poll(), 1u);
+	BOOST_CHECK(h1.Ready());
+	BOOST_CHECK_EQUAL(queue.Poll(), 0u);
+	BOOST_CHECK(h1.Get().IsLinked());
+
+	mock::SetCompletionLatency(0);
+}
+#endif
+
+BOOST_AUTO_TEST_CASE(ProgramBuild_errors)
+{
+	using namespace oglplus;
+	ProgramBuildQueue queue(false);
+
+	Program good, bad;
+	ProgramBuildHandle hg = queue.Add(good, make_source("void main(void){ }"));
+	ProgramBuildHandle hb = queue.Add(bad, make_source("#error \"failed\"\n"));
+
+	// the queue itself does not throw, the handles report the errors
+	queue.Finish();
+	BOOST_CHECK_EQUAL(queue.Unfinished(), 0u);
+	BOOST_CHECK(hb.Ready());
+	BOOST_CHECK_THROW(hb.Wait(), CompileError);
+	BOOST_CHECK_THROW(hb.Get(), CompileError);
+	BOOST_CHECK(hg.Get().IsLinked());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,122 @@
+/**
+ *  .file test/oglplus/program_cache.cpp
+ *  .brief Test case for the persistent program binary cache.
+ *
+ *  .author Matus Chochlik
+ *
+ *  Copyright 2010-2013 Matus Chochlik. Distributed under the Boost
+ *  Software License, Version 1.0. (See accompanying file
+ *  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ */
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE OGLPLUS_ProgramCache
+#include <boost/test/unit_test.hpp>
+
+#include <oglplus/gl.hpp>
+#include <oglplus/program.hpp>
+#include <oglplus/program_cache.hpp>
+#include <oglplus/compile_error.hpp>
+
+#include <fstream>
+
+#include "fixture.hpp"
+#include "mock_gl.hpp"
+#include "program_sources.hpp"
+
+BOOST_GLOBAL_FIXTURE(OGLplusTestFixture);
+
+BOOST_AUTO_TEST_SUITE(ProgramCache)
+
+BOOST_AUTO_TEST_CASE(ProgramCache_hit_and_miss)
+{
+	using namespace oglplus;
+	oglplus::ProgramCache cache(".");
+	ProgramSource source = make_source("void main(void){ }");
+	ProgramSource other = make_source("void main(void){ discard; }");
+	BOOST_CHECK(cache.Path(source) != cache.Path(other));
+	cache.Forget(source);
+	cache.Forget(other);
+
+	mock::ClearCalls();
+	Program first;
+	BOOST_CHECK(!cache.Build(first, source));
+	BOOST_CHECK(first.IsLinked());
+	BOOST_CHECK_EQUAL(mock::CallCount("glCompileShader"), 2u);
+	BOOST_CHECK_EQUAL(mock::CallCount("glLinkProgram"), 1u);
+	BOOST_CHECK_EQUAL(mock::CallCount("glGetProgramBinary"), 1u);
+
+	// the second build is loaded from the stored binary
+	mock::ClearCalls();
+	Program second;
+	BOOST_CHECK(cache.Build(second, source));
+	BOOST_CHECK(second.IsLinked());
+	BOOST_CHECK_EQUAL(mock::CallCount("glCompileShader"), 0u);
+	BOOST_CHECK_EQUAL(mock::CallCount("glLinkProgram"), 0u);
+	BOOST_CHECK_EQUAL(mock::CallCount("glProgramBinary"), 1u);
+
+	// a program with different inputs is not taken from the cache
+	Program third;
+	BOOST_CHECK(!cache.Build(third, other));
+	BOOST_CHECK_EQUAL(cache.Hits(), 1u);
+	BOOST_CHECK_EQUAL(cache.Misses(), 2u);
+	BOOST_CHECK_EQUAL(cache.Rejected(), 0u);
+
+	cache.Forget(source);
+	cache.Forget(other);
+}
+
+BOOST_AUTO_TEST_CASE(ProgramCache_rejected_binary)
+{
+	using namespace oglplus;
+	oglplus::ProgramCache cache(".");
+	ProgramSource source = make_source("void main(void){ }");
+	cache.Forget(source);
+
+	Program first;
+	BOOST_CHECK(!cache.Build(first, source));
+
+	// the binary is rejected after an update of the driver
+	mock::InvalidateProgramBinaries();
+	mock::ClearCalls();
+	Program second;
+	BOOST_CHECK(!cache.Build(second, source));
+	BOOST_CHECK(second.IsLinked());
+	BOOST_CHECK_EQUAL(mock::CallCount("glProgramBinary"), 1u);
+	BOOST_CHECK_EQUAL(mock::CallCount("glLinkProgram"), 1u);
+	BOOST_CHECK_EQUAL(cache.Rejected(), 1u);
+
+	// and replaced by the rebuilt one
+	Program third;
+	BOOST_CHECK(cache.Build(third, source));
+
+	// a damaged cache file is ignored
+	{
+		std::ofstream file(cache.Path(source).c_str());
+		file << "garbage";
+	}
+	mock::ClearCalls();
+	Program fourth;
+	BOOST_CHECK(!cache.Build(fourth, source));
+	BOOST_CHECK(fourth.IsLinked());
+	BOOST_CHECK_EQUAL(mock::CallCount("glProgramBinary"), 0u);
+	BOOST_CHECK_EQUAL(cache.Rejected(), 1u);
+
+	cache.Forget(source);
+}
+
+BOOST_AUTO_TEST_CASE(ProgramCache_compile_error)
+{
+	using namespace oglplus;
+	oglplus::ProgramCache cache(".");
+	ProgramSource source = make_source("#error \"failed\"\n");
+	cache.Forget(source);
+
+	Program prog;
+	BOOST_CHECK_THROW(cache.Build(prog, source), CompileError);
+
+	// nothing is stored for programs that failed to build
+	std::ifstream file(cache.Path(source).c_str());
+	BOOST_CHECK(!file.good());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,198 @@
+/**
+ *  .file test/oglplus/program_reflection.cpp
+ *  .brief Test case for the cached reflection of the program uniforms.
+ *
+ *  .author Matus Chochlik
+ *
+ *  Copyright 2010-2013 Matus Chochlik. Distributed under the Boost
+ *  Software License, Version 1.0. (See accompanying file
+ *  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ */
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE OGLPLUS_ProgramReflection
+#include <boost/test/unit_test.hpp>
+
+#include <oglplus/gl.hpp>
+#include <oglplus/program.hpp>
+#include <oglplus/uniform.hpp>
+#include <oglplus/uniform_block.hpp>
+#include <oglplus/state_cache.hpp>
+#include <oglplus/exposed.hpp>
+
+#include "fixture.hpp"
+#include "mock_gl.hpp"
+
+BOOST_GLOBAL_FIXTURE(OGLplusTestFixture);
+
+BOOST_AUTO_TEST_SUITE(ProgramReflection)
+
+BOOST_AUTO_TEST_CASE(ProgramReflection_uniforms)
+{
+	using namespace oglplus;
+	StateCache context;
+	context.MakeCurrent();
+	Program prog;
+	GLuint name = Expose(prog).Name();
+	mock::AddUniform(name, "Scale", GL_FLOAT);
+	mock::AddUniform(name, "Offset", GL_FLOAT_VEC3);
+	mock::AddUniform(name, "Weights", GL_FLOAT, 4);
+	mock::AddUniform(name, "Count", GL_INT);
+	prog.Link();
+
+	mock::ClearCalls();
+	Uniform<GLfloat> scale(prog, "Scale");
+	Uniform<Vec3f, DefaultTypecheck> offset(prog, "Offset");
+	Uniform<GLfloat> weights(prog, "Weights");
+	Uniform<GLfloat> weights0(prog, "Weights[0]");
+	Uniform<GLfloat> weights2(prog, "Weights[2]");
+	LazyUniform<GLint> count(prog, "Count");
+	OptionalUniform<GLfloat> missing(prog, "Missing");
+	BOOST_CHECK(count.IsActive());
+	BOOST_CHECK(!missing.IsActive());
+
+	// the active uniforms are queried only once, the locations
+	// of array elements and of inactive uniforms are queried from GL
+	BOOST_CHECK_EQUAL(mock::CallCount("glGetActiveUniform"), 4u);
+	BOOST_CHECK_EQUAL(mock::CallCount("glGetUniformLocation"), 6u);
+
+	BOOST_CHECK_EQUAL(scale.Location(), 0);
+	BOOST_CHECK_EQUAL(offset.Location(), 1);
+	BOOST_CHECK_EQUAL(weights.Location(), 2);
+	BOOST_CHECK_EQUAL(weights0.Location(), 2);
+	BOOST_CHECK_EQUAL(weights2.Location(), 4);
+
+#if !OGLPLUS_NO_UNIFORM_TYPECHECK
+	// the types are checked against the cached reflection data
+	mock::ClearCalls();
+	typedef Uniform<GLint, DefaultTypecheck> IntUniform;
+	typedef Uniform<Vec2f, DefaultTypecheck> Vec2fUniform;
+	typedef Uniform<GLfloat, DefaultTypecheck> FloatUniform;
+	BOOST_CHECK_THROW(IntUniform(prog, "Scale"), Error);
+	BOOST_CHECK_THROW(Vec2fUniform(prog, "Weights[3]"), Error);
+	BOOST_CHECK_NO_THROW(FloatUniform(prog, "Weights[3]"));
+	BOOST_CHECK_EQUAL(mock::CallCount("glGetActiveUniform"), 0u);
+#endif
+}
+
+BOOST_AUTO_TEST_CASE(ProgramReflection_blocks)
+{
+	using namespace oglplus;
+	StateCache context;
+	context.MakeCurrent();
+	Program prog;
+	GLuint name = Expose(prog).Name();
+	mock::AddUniform(name, "Color", GL_FLOAT_VEC4);
+	GLint lights = mock::AddUniformBlock(name, "Lights");
+	GLint material = mock::AddUniformBlock(name, "Material");
+	mock::AddUniform(name, "LightPos", GL_FLOAT_VEC3, 8, lights);
+	mock::AddUniform(name, "Shininess", GL_FLOAT, 1, material);
+	prog.Link();
+
+	mock::ClearCalls();
+	UniformBlock lights_block(prog, "Lights");
+	UniformBlock material_block(prog, "Material");
+	Uniform<Vec4f> color(prog, "Color");
+	BOOST_CHECK_EQUAL(mock::CallCount("glGetUniformBlockIndex"), 0u);
+	BOOST_CHECK_EQUAL(mock::CallCount("glGetActiveUniformBlockName"), 2u);
+	// only the uniforms in the default block have a location
+	BOOST_CHECK_EQUAL(mock::CallCount("glGetUniformLocation"), 1u);
+	BOOST_CHECK_EQUAL(color.Location(), 0);
+
+	BOOST_CHECK_THROW(UniformBlock(prog, "Missing"), Error);
+}
+
+BOOST_AUTO_TEST_CASE(ProgramReflection_relink)
+{
+	using namespace oglplus;
+	StateCache context;
+	context.MakeCurrent();
+	Program prog;
+	GLuint name = Expose(prog).Name();
+	mock::AddUniform(name, "First", GL_FLOAT);
+	prog.Link();
+	Uniform<GLfloat> first(prog, "First");
+	BOOST_CHECK_EQUAL(first.Location(), 0);
+
+	// the reflection data is rebuilt after the program is relinked
+	mock::AddUniform(name, "Second", GL_FLOAT);
+	prog.Link();
+	mock::ClearCalls();
+	Uniform<GLfloat> second(prog, "Second");
+	Uniform<GLfloat> first_again(prog, "First");
+	BOOST_CHECK_EQUAL(mock::CallCount("glGetActiveUniform"), 2u);
+	BOOST_CHECK_EQUAL(second.Location(), 1);
+	BOOST_CHECK_EQUAL(first_again.Location(), 0);
+
+	// the reflection data is not built for programs that are not linked
+	Program other;
+	mock::ClearCalls();
+	aux::ProgramReflectionEntry entry;
+	BOOST_CHECK(!aux::ProgramReflection::FindUniform(
+		Expose(other).Name(),
+		"First",
+		entry
+	));
+	BOOST_CHECK_EQUAL(mock::CallCount("glGetActiveUniform"), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(ProgramReflection_contexts)
+{
+	using namespace oglplus;
+	StateCache context;
+	context.MakeCurrent();
+	Program prog;
+	GLuint name = Expose(prog).Name();
+	mock::AddUniform(name, "Value", GL_FLOAT);
+	prog.Link();
+	Uniform<GLfloat> value(prog, "Value");
+
+	// the reflection data is built separately for each context
+	{
+		StateCache other_context;
+		other_context.MakeCurrent();
+		mock::ClearCalls();
+		Uniform<GLfloat> other_value(prog, "Value");
+		Uniform<GLfloat> other_again(prog, "Value");
+		BOOST_CHECK_EQUAL(mock::CallCount("glGetActiveUniform"), 1u);
+	}
+
+	// and kept for the other contexts
+	context.MakeCurrent();
+	mock::ClearCalls();
+	Uniform<GLfloat> value_again(prog, "Value");
+	BOOST_CHECK_EQUAL(mock::CallCount("glGetActiveUniform"), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(ProgramReflection_no_cache_contexts)
+{
+	using namespace oglplus;
+	StateCache::MakeNoneCurrent();
+	Program prog;
+	GLuint name = Expose(prog).Name();
+	mock::AddUniform(name, "Scale", GL_FLOAT);
+	mock::AddUniform(name, "Offset", GL_FLOAT_VEC3);
+	prog.Link();
+	Uniform<GLfloat> scale(prog, "Scale");
+	Uniform<Vec3f, DefaultTypecheck> offset(prog, "Offset");
+	BOOST_CHECK_EQUAL(scale.Location(), 0);
+	BOOST_CHECK_EQUAL(offset.Location(), 1);
+
+	// a program with the same name and a different layout, linked
+	// in another context without a state cache (so without oglplus
+	// noticing), must not get the data of the first one
+	mock::ClearUniforms(name);
+	mock::AddUniform(name, "Offset", GL_FLOAT_VEC2);
+	mock::AddUniform(name, "Scale", GL_FLOAT);
+	glLinkProgram(name);
+
+	Uniform<GLfloat> other_scale(prog, "Scale");
+	Uniform<Vec2f, DefaultTypecheck> other_offset(prog, "Offset");
+	BOOST_CHECK_EQUAL(other_scale.Location(), 1);
+	BOOST_CHECK_EQUAL(other_offset.Location(), 0);
+#if !OGLPLUS_NO_UNIFORM_TYPECHECK
+	typedef Uniform<Vec3f, DefaultTypecheck> Vec3fUniform;
+	BOOST_CHECK_THROW(Vec3fUniform(prog, "Offset"), Error);
+#endif
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,29 @@
+/**
+ *  .file test/oglplus/program_sources.hpp
+ *  .brief Program sources for the program building test cases.
+ *
+ *  .author Matus Chochlik
+ *
+ *  Copyright 2010-2013 Matus Chochlik. Distributed under the Boost
+ *  Software License, Version 1.0. (See accompanying file
+ *  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ */
+
+#ifndef __OGLPLUS_TEST_PROGRAM_SOURCES_1311181200_HPP__
+#define __OGLPLUS_TEST_PROGRAM_SOURCES_1311181200_HPP__
+
+#include <oglplus/program_source.hpp>
+
+// Returns the source of a program with a trivial vertex shader
+// and a fragment shader with the specified source
+inline oglplus::ProgramSource make_source(const char* fs_source)
+{
+	using namespace oglplus;
+	ProgramSource source;
+	source.AddShader(ShaderType::Vertex, "void main(void){ }");
+	source.AddShader(ShaderType::Fragment, fs_source);
+	source.BindAttribLocation(0, "Position");
+	return source;
+}
+
+#endif // include guard
@@ -0,0 +1,24 @@
+/**
+ *  .file test/oglplus/random_values.hpp
+ *  .brief Generation of random values for the math test cases.
+ *
+ *  .author Matus Chochlik
+ *
+ *  Copyright 2010-2013 Matus Chochlik. Distributed under the Boost
+ *  Software License, Version 1.0. (See accompanying file
+ *  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ */
+
+#ifndef __OGLPLUS_TEST_RANDOM_VALUES_1311181200_HPP__
+#define __OGLPLUS_TEST_RANDOM_VALUES_1311181200_HPP__
+
+#include <cstdlib>
+
+// Returns a random value from the range [-1, 1]
+template <typename T>
+inline T random_value(void)
+{
+	return T(std::rand()) / T(RAND_MAX) * T(2) - T(1);
+}
+
+#endif // include guard
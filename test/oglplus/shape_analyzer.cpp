@@ -0,0 +1,143 @@
+/**
+ *  .file test/oglplus/shape_analyzer.cpp
+ *  .brief Test case for the detection of adjacent faces of shapes.
+ *
+ *  .author Matus Chochlik
+ *
+ *  Copyright 2010-2013 Matus Chochlik. Distributed under the Boost
+ *  Software License, Version 1.0. (See accompanying file
+ *  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ */
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE OGLPLUS_ShapeAnalyzer
+#include <boost/test/unit_test.hpp>
+
+#include <oglplus/gl.hpp>
+#include <oglplus/shapes/analyzer.hpp>
+#include <oglplus/shapes/cube.hpp>
+#include <oglplus/shapes/sphere.hpp>
+#include <oglplus/shapes/torus.hpp>
+#include <oglplus/shapes/subdiv_sphere.hpp>
+
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(ShapeAnalyzer)
+
+static bool same_position(const oglplus::Vec4d& a, const oglplus::Vec4d& b)
+{
+	return Distance(a, b) < 1e-9;
+}
+
+// checks that the adjacency is symmetric, that the adjacent edges have
+// the same end-points and that each non-degenerate edge having another
+// edge with the same end-points (found by brute force) is connected
+template <typename ShapeBuilder>
+static void do_test_adjacency(
+	const ShapeBuilder& builder,
+	bool closed,
+	bool smooth
+)
+{
+	using namespace oglplus;
+	shapes::ShapeAnalyzer analyzer(builder);
+
+	std::vector<Vec4d> ends;
+	for(GLuint f=0; f!=analyzer.FaceCount(); ++f)
+	{
+		auto face = analyzer.Face(f);
+		BOOST_CHECK_EQUAL(face.Arity(), 3u);
+		for(GLuint e=0; e!=face.Arity(); ++e)
+		{
+			ends.push_back(face.Vert(e).MainAttrib());
+			ends.push_back(face.Vert((e+1)%face.Arity()).MainAttrib());
+		}
+	}
+
+	GLuint connected = 0;
+	for(GLuint f=0, i=0; f!=analyzer.FaceCount(); ++f)
+	{
+		auto face = analyzer.Face(f);
+		for(GLuint e=0; e!=face.Arity(); ++e, ++i)
+		{
+			auto edge = face.Edge(e);
+			const Vec4d& a0 = ends[i*2+0];
+			const Vec4d& a1 = ends[i*2+1];
+			const bool degenerate = same_position(a0, a1);
+			if(edge.HasAdjacentEdge())
+			{
+				++connected;
+				auto adj = edge.AdjacentEdge();
+				BOOST_CHECK(adj.AdjacentEdge().Face().Index() == f);
+				BOOST_CHECK(adj.AdjacentEdge().Index() == e);
+				BOOST_CHECK(face.AdjacentFace(e).Index() == adj.Face().Index());
+				auto b = adj.Face();
+				const Vec4d b0 = b.Vert(adj.Index()).MainAttrib();
+				const Vec4d b1 =
+					b.Vert((adj.Index()+1)%b.Arity()).MainAttrib();
+				BOOST_CHECK(
+					(same_position(a0, b0) && same_position(a1, b1)) ||
+					(same_position(a0, b1) && same_position(a1, b0))
+				);
+				if(smooth && !edge.IsStripEdge())
+					BOOST_CHECK(edge.IsSmoothEdge());
+				BOOST_CHECK(edge.IsContinuousEdge());
+			}
+			else if(!degenerate)
+			{
+				BOOST_CHECK(!closed);
+				GLuint matches = 0;
+				for(GLuint j=0; j!=ends.size()/2; ++j)
+				{
+					if(j == i) continue;
+					const Vec4d& b0 = ends[j*2+0];
+					const Vec4d& b1 = ends[j*2+1];
+					if(	(same_position(a0, b0) && same_position(a1, b1)) ||
+						(same_position(a0, b1) && same_position(a1, b0))
+					) ++matches;
+				}
+				BOOST_CHECK_EQUAL(matches, 0u);
+			}
+		}
+	}
+	BOOST_CHECK(connected > 0);
+}
+
+BOOST_AUTO_TEST_CASE(ShapeAnalyzer_sphere)
+{
+	do_test_adjacency(oglplus::shapes::Sphere(1.0, 18, 12), true, true);
+}
+
+BOOST_AUTO_TEST_CASE(ShapeAnalyzer_torus)
+{
+	do_test_adjacency(oglplus::shapes::Torus(1.0, 0.5, 18, 12), true, true);
+}
+
+BOOST_AUTO_TEST_CASE(ShapeAnalyzer_subdiv_sphere)
+{
+	do_test_adjacency(oglplus::shapes::SimpleSubdivSphere(2), true, true);
+}
+
+BOOST_AUTO_TEST_CASE(ShapeAnalyzer_cube)
+{
+	using namespace oglplus;
+	do_test_adjacency(shapes::Cube(), true, false);
+
+	// the faces on different sides of the cube are adjacent
+	// but the edges between them are not smooth
+	shapes::ShapeAnalyzer analyzer((shapes::Cube()));
+	BOOST_CHECK_EQUAL(analyzer.FaceCount(), 12u);
+	GLuint sharp = 0;
+	for(GLuint f=0; f!=analyzer.FaceCount(); ++f)
+	{
+		auto face = analyzer.Face(f);
+		for(GLuint e=0; e!=face.Arity(); ++e)
+		{
+			BOOST_CHECK(face.HasAdjacentFace(e));
+			if(!face.Edge(e).IsSmoothEdge()) ++sharp;
+		}
+	}
+	// each of the 12 edges of the cube is shared by two triangles
+	BOOST_CHECK_EQUAL(sharp, 24u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
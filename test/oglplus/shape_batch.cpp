@@ -0,0 +1,240 @@
+/**
+ *  .file test/oglplus/shape_batch.cpp
+ *  .brief Test case for the batching of the drawing instructions of shapes.
+ *
+ *  .author Matus Chochlik
+ *
+ *  Copyright 2010-2013 Matus Chochlik. Distributed under the Boost
+ *  Software License, Version 1.0. (See accompanying file
+ *  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ */
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE OGLPLUS_ShapeBatch
+#include <boost/test/unit_test.hpp>
+
+#include <oglplus/gl.hpp>
+#include <oglplus/shapes/batch.hpp>
+#include <oglplus/shapes/cube.hpp>
+#include <oglplus/shapes/sphere.hpp>
+#include <oglplus/shapes/torus.hpp>
+#include <oglplus/shapes/vertex_cache.hpp>
+
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(ShapeBatch)
+
+// checks that the command draws the same vertices as the operation
+template <typename ShapeBuilder>
+static void do_test_command(
+	const oglplus::shapes::ShapeBatchBuilder& batch,
+	const oglplus::DrawElementsIndirectCommand& command,
+	const oglplus::shapes::DrawOperation& op,
+	const ShapeBuilder& builder
+)
+{
+	using namespace oglplus;
+	const auto indices = builder.Indices();
+	BOOST_CHECK_EQUAL(command.count, op.count);
+	for(GLuint i=0; i!=op.count; ++i)
+	{
+		const GLuint index = batch.Indices()[command.first_index+i];
+		if(op.method == shapes::DrawOperation::Method::DrawArrays)
+		{
+			BOOST_CHECK_EQUAL(index, op.first+i);
+		}
+		else if(
+			(op.restart_index != shapes::DrawOperation::NoRestartIndex()) &&
+			(indices[op.first+i] == op.restart_index)
+		)
+		{
+			BOOST_CHECK_EQUAL(index, batch.RestartIndex());
+		}
+		else BOOST_CHECK_EQUAL(index, GLuint(indices[op.first+i]));
+	}
+}
+
+template <typename ShapeBuilder>
+static void do_test_shape(
+	const oglplus::shapes::ShapeBatchBuilder& batch,
+	GLuint shape,
+	const ShapeBuilder& builder,
+	GLuint inst_count,
+	GLuint base_inst
+)
+{
+	using namespace oglplus;
+	std::vector<GLfloat> pos, nml;
+	builder.Positions(pos);
+	builder.Normals(nml);
+	const auto instr = builder.Instructions();
+	const auto& ops = instr.Operations();
+	const GLuint first = batch.FirstCommand(shape);
+	BOOST_CHECK_EQUAL(batch.FirstCommand(shape+1)-first, ops.size());
+	const GLint base_vertex = batch.Commands()[first].base_vertex;
+	for(GLuint o=0; o!=ops.size(); ++o)
+	{
+		const DrawElementsIndirectCommand& command =
+			batch.Commands()[first+o];
+		BOOST_CHECK(batch.Modes()[first+o] == ops[o].mode);
+		BOOST_CHECK_EQUAL(command.base_vertex, base_vertex);
+		BOOST_CHECK_EQUAL(command.instance_count, inst_count);
+		BOOST_CHECK_EQUAL(command.base_instance, base_inst);
+		do_test_command(batch, command, ops[o], builder);
+	}
+	// the vertex attributes are copied at the base vertex
+	for(std::size_t i=0; i!=pos.size(); ++i)
+		BOOST_CHECK_EQUAL(batch.Values(0)[base_vertex*3+i], pos[i]);
+	for(std::size_t i=0; i!=nml.size(); ++i)
+		BOOST_CHECK_EQUAL(batch.Values(1)[base_vertex*3+i], nml[i]);
+}
+
+BOOST_AUTO_TEST_CASE(ShapeBatch_merge)
+{
+	using namespace oglplus;
+	const shapes::Cube cube;
+	const shapes::Sphere sphere(1.0, 18, 12);
+	const shapes::Torus torus(1.0, 0.5, 18, 12);
+
+	shapes::ShapeBatchBuilder batch({"Position", "Normal"});
+	BOOST_CHECK_EQUAL(batch.AttribCount(), 2u);
+	BOOST_CHECK_EQUAL(batch.ShapeCount(), 0u);
+	BOOST_CHECK_EQUAL(batch.Add(cube), 0u);
+	BOOST_CHECK_EQUAL(batch.Add(sphere, 4, 1), 1u);
+	BOOST_CHECK_EQUAL(batch.Add(torus, 1, 5), 2u);
+	BOOST_CHECK_EQUAL(batch.Add(sphere), 3u);
+	BOOST_CHECK_EQUAL(batch.ShapeCount(), 4u);
+
+	std::vector<GLfloat> data;
+	GLuint vertex_count = 0;
+	vertex_count += GLuint(cube.Positions(data) ? data.size()/3 : 0);
+	vertex_count += GLuint(sphere.Positions(data) ? data.size()/3 : 0)*2;
+	vertex_count += GLuint(torus.Positions(data) ? data.size()/3 : 0);
+	BOOST_CHECK_EQUAL(batch.VertexCount(), vertex_count);
+	BOOST_CHECK_EQUAL(batch.ValuesPerVertex(0), 3u);
+	BOOST_CHECK_EQUAL(batch.Values(0).size(), vertex_count*3);
+	BOOST_CHECK_EQUAL(batch.Values(1).size(), vertex_count*3);
+
+	do_test_shape(batch, 0, cube, 1, 0);
+	do_test_shape(batch, 1, sphere, 4, 1);
+	do_test_shape(batch, 2, torus, 1, 5);
+	do_test_shape(batch, 3, sphere, 1, 0);
+
+	// the sphere and the torus use primitive restart
+	BOOST_CHECK(batch.PrimitiveRestart());
+
+	// the base vertices follow the vertex counts of the shapes
+	cube.Positions(data);
+	BOOST_CHECK_EQUAL(batch.Commands()[0].base_vertex, 0);
+	BOOST_CHECK_EQUAL(
+		batch.Commands()[batch.FirstCommand(1)].base_vertex,
+		GLint(data.size()/3)
+	);
+}
+
+BOOST_AUTO_TEST_CASE(ShapeBatch_missing_attrib)
+{
+	using namespace oglplus;
+	shapes::ShapeBatchBuilder batch({"Position", "Bitangent", "Foo"});
+	batch.Add(shapes::Cube());
+	batch.Add(shapes::Sphere(1.0, 6, 4));
+
+	// the cube does not have bitangents, the values are padded with zeros
+	std::vector<GLfloat> tgt;
+	shapes::Sphere(1.0, 6, 4).Bitangents(tgt);
+	BOOST_CHECK_EQUAL(batch.ValuesPerVertex(1), 3u);
+	BOOST_CHECK_EQUAL(batch.ValuesPerVertex(2), 0u);
+	BOOST_CHECK(batch.Values(2).empty());
+	BOOST_CHECK_EQUAL(batch.Values(1).size(), batch.VertexCount()*3);
+	const GLuint offset = batch.VertexCount()*3 - GLuint(tgt.size());
+	for(GLuint i=0; i!=offset; ++i)
+		BOOST_CHECK_EQUAL(batch.Values(1)[i], 0.0f);
+	for(GLuint i=0; i!=tgt.size(); ++i)
+		BOOST_CHECK_EQUAL(batch.Values(1)[offset+i], tgt[i]);
+}
+
+BOOST_AUTO_TEST_CASE(ShapeBatch_groups)
+{
+	using namespace oglplus;
+	shapes::ShapeBatchBuilder batch({"Position"});
+	batch.Add(shapes::Sphere(1.0, 6, 4));
+	batch.Add(shapes::Cube());
+	batch.Add(shapes::Torus(1.0, 0.5, 6, 4), 3, 0);
+	batch.Add(shapes::Cube());
+
+	std::vector<DrawElementsIndirectCommand> sorted;
+	const std::vector<shapes::ShapeBatchGroup> groups =
+		batch.SortedCommands(sorted);
+	BOOST_CHECK_EQUAL(sorted.size(), batch.Commands().size());
+
+	// one group per distinct primitive type
+	GLuint next = 0;
+	for(std::size_t g=0; g!=groups.size(); ++g)
+	{
+		BOOST_CHECK_EQUAL(groups[g].first, next);
+		BOOST_CHECK(groups[g].count > 0);
+		for(std::size_t h=0; h!=g; ++h)
+			BOOST_CHECK(groups[h].mode != groups[g].mode);
+		bool instanced = false;
+		// the commands keep their relative order within the group
+		GLuint prev_first = 0;
+		for(GLuint i=next; i!=next+groups[g].count; ++i)
+		{
+			if(sorted[i].instance_count != 1) instanced = true;
+			if(i != next)
+				BOOST_CHECK(sorted[i].first_index > prev_first);
+			prev_first = sorted[i].first_index;
+		}
+		BOOST_CHECK_EQUAL(groups[g].instanced, instanced);
+		next += groups[g].count;
+	}
+	BOOST_CHECK_EQUAL(next, sorted.size());
+	BOOST_CHECK(groups.size() < sorted.size());
+}
+
+BOOST_AUTO_TEST_CASE(ShapeBatch_instructions)
+{
+	using namespace oglplus;
+	const shapes::Sphere sphere(1.0, 12, 8);
+	const shapes::Torus torus(1.0, 0.5, 12, 8);
+	shapes::ShapeBatchBuilder batch({"Position"});
+	batch.Add(sphere);
+	batch.Add(torus);
+
+	// the triangles drawn by the base vertex operations are
+	// the triangles of the shapes offset by their base vertices
+	std::vector<GLuint> expected;
+	std::vector<GLfloat> pos;
+	const GLuint offset = GLuint(sphere.Positions(pos) ? pos.size()/3 : 0);
+	const auto sphere_instr = sphere.Instructions();
+	const auto sphere_indices = sphere.Indices();
+	for(auto i=sphere_instr.Operations().begin();
+		i!=sphere_instr.Operations().end(); ++i)
+	{
+		aux::AppendShapeTriangles(expected, *i, sphere_indices);
+	}
+	const std::size_t sphere_tris = expected.size();
+	const auto torus_instr = torus.Instructions();
+	const auto torus_indices = torus.Indices();
+	for(auto i=torus_instr.Operations().begin();
+		i!=torus_instr.Operations().end(); ++i)
+	{
+		aux::AppendShapeTriangles(expected, *i, torus_indices);
+	}
+	for(std::size_t i=sphere_tris; i!=expected.size(); ++i)
+		expected[i] += offset;
+
+	std::vector<GLuint> triangles;
+	const auto instr = batch.Instructions();
+	BOOST_CHECK_EQUAL(instr.Operations().size(), batch.Commands().size());
+	for(auto i=instr.Operations().begin(); i!=instr.Operations().end(); ++i)
+	{
+		BOOST_CHECK(
+			i->method == shapes::DrawOperation::Method::DrawElementsBaseVertex
+		);
+		BOOST_CHECK_EQUAL(i->phase, (i->base_vertex == 0)?0u:1u);
+		aux::AppendShapeTriangles(triangles, *i, batch.Indices());
+	}
+	BOOST_CHECK(triangles == expected);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,133 @@
+/**
+ *  .file test/oglplus/shape_draw.cpp
+ *  .brief Test case for the conversion of shape instructions to indirect.
+ *
+ *  .author Matus Chochlik
+ *
+ *  Copyright 2010-2013 Matus Chochlik. Distributed under the Boost
+ *  Software License, Version 1.0. (See accompanying file
+ *  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ */
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE OGLPLUS_ShapeDraw
+#include <boost/test/unit_test.hpp>
+
+#include <oglplus/gl.hpp>
+#include <oglplus/shapes/draw.hpp>
+#include <oglplus/shapes/cube.hpp>
+#include <oglplus/shapes/sphere.hpp>
+
+#include <vector>
+#include <cstring>
+
+BOOST_AUTO_TEST_SUITE(ShapeDraw)
+
+// checks that the indirect instructions read commands equivalent
+// to the original operations from the right offsets
+static void do_test_indirect(
+	const oglplus::shapes::DrawingInstructions& instr,
+	GLuint inst_count,
+	GLuint base_inst
+)
+{
+	using namespace oglplus;
+	typedef shapes::DrawOperation::Method Method;
+
+	// some commands are already in the buffer
+	std::vector<GLuint> commands(3, 0);
+	const auto indirect = instr.IndirectInstructions(
+		commands,
+		inst_count,
+		base_inst
+	);
+	const auto& ops = instr.Operations();
+	const auto& indirect_ops = indirect.Operations();
+	BOOST_CHECK_EQUAL(indirect_ops.size(), ops.size());
+
+	GLuint offset = 3*sizeof(GLuint);
+	for(std::size_t i=0; i!=ops.size(); ++i)
+	{
+		const shapes::DrawOperation& op = ops[i];
+		const shapes::DrawOperation& iop = indirect_ops[i];
+		BOOST_CHECK(iop.Indirect());
+		BOOST_CHECK(!iop.Indexed());
+		BOOST_CHECK(iop.mode == op.mode);
+		BOOST_CHECK_EQUAL(iop.restart_index, op.restart_index);
+		BOOST_CHECK_EQUAL(iop.phase, op.phase);
+		BOOST_CHECK_EQUAL(iop.first, offset);
+		BOOST_CHECK_EQUAL(iop.count, 1u);
+		BOOST_CHECK(offset < commands.size()*sizeof(GLuint));
+		const char* data = reinterpret_cast<const char*>(commands.data());
+		if(op.method == Method::DrawArrays)
+		{
+			BOOST_CHECK(iop.method == Method::DrawArraysIndirect);
+			DrawArraysIndirectCommand command;
+			std::memcpy(&command, data+offset, sizeof(command));
+			BOOST_CHECK_EQUAL(command.count, op.count);
+			BOOST_CHECK_EQUAL(command.instance_count, inst_count);
+			BOOST_CHECK_EQUAL(command.first, op.first);
+			BOOST_CHECK_EQUAL(command.base_instance, base_inst);
+			offset += sizeof(command);
+		}
+		else
+		{
+			BOOST_CHECK(iop.method == Method::DrawElementsIndirect);
+			DrawElementsIndirectCommand command;
+			std::memcpy(&command, data+offset, sizeof(command));
+			BOOST_CHECK_EQUAL(command.count, op.count);
+			BOOST_CHECK_EQUAL(command.instance_count, inst_count);
+			BOOST_CHECK_EQUAL(command.first_index, op.first);
+			BOOST_CHECK_EQUAL(command.base_vertex, op.BaseVertex());
+			BOOST_CHECK_EQUAL(command.base_instance, base_inst);
+			offset += sizeof(command);
+		}
+	}
+	BOOST_CHECK_EQUAL(offset, commands.size()*sizeof(GLuint));
+}
+
+BOOST_AUTO_TEST_CASE(ShapeDraw_indirect_arrays)
+{
+	using namespace oglplus;
+	const shapes::Cube cube;
+	BOOST_CHECK(
+		cube.Instructions().Operations().front().method ==
+		shapes::DrawOperation::Method::DrawArrays
+	);
+	do_test_indirect(cube.Instructions(), 1, 0);
+	do_test_indirect(cube.Instructions(), 16, 4);
+}
+
+BOOST_AUTO_TEST_CASE(ShapeDraw_indirect_elements)
+{
+	using namespace oglplus;
+	const shapes::Sphere sphere(1.0, 12, 8);
+	BOOST_CHECK(sphere.Instructions().Operations().front().Indexed());
+	do_test_indirect(sphere.Instructions(), 1, 0);
+	do_test_indirect(sphere.Instructions(), 100, 7);
+	do_test_indirect(shapes::Cube().EdgeInstructions(), 2, 0);
+}
+
+BOOST_AUTO_TEST_CASE(ShapeDraw_aggregate)
+{
+	using namespace oglplus;
+	// the operations can be initialized by an aggregate initializer
+	// and the base vertex is used only by DrawElementsBaseVertex
+	const shapes::DrawOperation op = {
+		shapes::DrawOperation::Method::DrawElements,
+		PrimitiveType::Triangles,
+		6, 12,
+		shapes::DrawOperation::NoRestartIndex(),
+		2
+	};
+	BOOST_CHECK_EQUAL(op.first, 6u);
+	BOOST_CHECK_EQUAL(op.count, 12u);
+	BOOST_CHECK_EQUAL(op.phase, 2u);
+	BOOST_CHECK_EQUAL(op.BaseVertex(), 0);
+
+	shapes::DrawOperation bop = op;
+	bop.method = shapes::DrawOperation::Method::DrawElementsBaseVertex;
+	bop.base_vertex = 5;
+	BOOST_CHECK_EQUAL(bop.BaseVertex(), 5);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,112 @@
+/**
+ *  .file test/oglplus/shape_span.cpp
+ *  .brief Test case for generating shape attributes into spans.
+ *
+ *  .author Matus Chochlik
+ *
+ *  Copyright 2010-2013 Matus Chochlik. Distributed under the Boost
+ *  Software License, Version 1.0. (See accompanying file
+ *  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ */
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE OGLPLUS_ShapeSpan
+#include <boost/test/unit_test.hpp>
+
+#include <oglplus/gl.hpp>
+#include <oglplus/shapes/torus.hpp>
+#include <oglplus/shapes/sphere.hpp>
+#include <oglplus/shapes/plane.hpp>
+
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(ShapeSpan)
+
+// generates the attributes both into vectors and into a single
+// interleaved array, in parallel, and checks that they are equal
+template <class ShapeBuilder>
+static void check_span_generation(const ShapeBuilder& builder)
+{
+	using namespace oglplus;
+	const GLuint n = builder.VertexCount();
+	// position, normal, tangent, bitangent, tex-coord
+	const GLuint stride = 3+3+3+3+2;
+	std::vector<GLfloat> inter(n*stride, -1.0f);
+	StridedSpan<GLfloat> span(inter.data(), n, 3, stride);
+
+	BOOST_CHECK_EQUAL(builder.Positions(span, 4), 3u);
+	BOOST_CHECK_EQUAL(
+		builder.Normals(StridedSpan<GLfloat>(
+			inter.data()+3, n, 3, stride
+		), 4), 3u
+	);
+	BOOST_CHECK_EQUAL(
+		builder.Tangents(StridedSpan<GLfloat>(
+			inter.data()+6, n, 3, stride
+		), 3), 3u
+	);
+	BOOST_CHECK_EQUAL(
+		builder.Bitangents(StridedSpan<GLfloat>(
+			inter.data()+9, n, 3, stride
+		), 2), 3u
+	);
+	BOOST_CHECK_EQUAL(
+		builder.TexCoordinates(StridedSpan<GLfloat>(
+			inter.data()+12, n, 2, stride
+		), 4), 2u
+	);
+
+	std::vector<GLfloat> values[5];
+	BOOST_CHECK_EQUAL(builder.Positions(values[0]), 3u);
+	BOOST_CHECK_EQUAL(builder.Normals(values[1]), 3u);
+	BOOST_CHECK_EQUAL(builder.Tangents(values[2]), 3u);
+	BOOST_CHECK_EQUAL(builder.Bitangents(values[3]), 3u);
+	BOOST_CHECK_EQUAL(builder.TexCoordinates(values[4]), 2u);
+
+	const GLuint offsets[5] = {0, 3, 6, 9, 12};
+	const GLuint vpvs[5] = {3, 3, 3, 3, 2};
+	for(GLuint a=0; a!=5; ++a)
+	{
+		BOOST_CHECK_EQUAL(values[a].size(), n*vpvs[a]);
+		bool equal = true;
+		for(GLuint v=0; v!=n; ++v)
+		{
+			for(GLuint c=0; c!=vpvs[a]; ++c)
+			{
+				const GLfloat x = values[a][v*vpvs[a]+c];
+				const GLfloat y = inter[v*stride+offsets[a]+c];
+				if(x != y) equal = false;
+			}
+		}
+		BOOST_CHECK(equal);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(ShapeSpan_torus)
+{
+	check_span_generation(oglplus::shapes::Torus(1.0, 0.5, 360, 240));
+	check_span_generation(oglplus::shapes::Torus(1.0, 0.5, 12, 8));
+}
+
+BOOST_AUTO_TEST_CASE(ShapeSpan_sphere)
+{
+	check_span_generation(oglplus::shapes::Sphere(2.0, 360, 240));
+	check_span_generation(oglplus::shapes::Sphere(1.0, 18, 12));
+}
+
+BOOST_AUTO_TEST_CASE(ShapeSpan_plane)
+{
+	check_span_generation(oglplus::shapes::Plane(300, 200));
+	check_span_generation(oglplus::shapes::Plane(2, 2));
+}
+
+BOOST_AUTO_TEST_CASE(ShapeSpan_double)
+{
+	using namespace oglplus;
+	shapes::Sphere sphere(1.0, 36, 24);
+	std::vector<GLdouble> a, b(sphere.VertexCount()*3);
+	sphere.Positions(a);
+	sphere.Positions(StridedSpan<GLdouble>(b, 3), 8);
+	BOOST_CHECK(a == b);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
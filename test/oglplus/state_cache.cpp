@@ -0,0 +1,278 @@
+/**
+ *  .file test/oglplus/state_cache.cpp
+ *  .brief Test case for the GL state cache.
+ *
+ *  .author Matus Chochlik
+ *
+ *  Copyright 2010-2013 Matus Chochlik. Distributed under the Boost
+ *  Software License, Version 1.0. (See accompanying file
+ *  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ */
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE OGLPLUS_StateCache
+#include <boost/test/unit_test.hpp>
+
+#include <oglplus/gl.hpp>
+#include <oglplus/state_cache.hpp>
+#include <oglplus/context.hpp>
+#include <oglplus/buffer.hpp>
+#include <oglplus/texture.hpp>
+#include <oglplus/sampler.hpp>
+#include <oglplus/program.hpp>
+#include <oglplus/vertex_array.hpp>
+#include <oglplus/exposed.hpp>
+
+#if !OGLPLUS_NO_THREAD_LOCAL
+#include <thread>
+#endif
+
+#include "fixture.hpp"
+#include "mock_gl.hpp"
+
+BOOST_GLOBAL_FIXTURE(OGLplusTestFixture);
+
+BOOST_AUTO_TEST_SUITE(StateCache)
+
+#if !OGLPLUS_NO_STATE_CACHE
+
+BOOST_AUTO_TEST_CASE(StateCache_none_current)
+{
+	using namespace oglplus;
+	BOOST_CHECK(oglplus::StateCache::Current() == nullptr);
+
+	VertexArray vao;
+	mock::ClearCalls();
+	vao.Bind();
+	vao.Bind();
+	BOOST_CHECK_EQUAL(mock::CallCount("glBindVertexArray"), 2u);
+	VertexArray::Unbind();
+}
+
+BOOST_AUTO_TEST_CASE(StateCache_objects)
+{
+	using namespace oglplus;
+	oglplus::StateCache cache;
+	cache.MakeCurrent();
+	BOOST_CHECK(oglplus::StateCache::Current() == &cache);
+
+	VertexArray vao;
+	Buffer vbo, ibo;
+
+	mock::ClearCalls();
+	vao.Bind();
+	vao.Bind();
+	BOOST_CHECK_EQUAL(mock::CallCount("glBindVertexArray"), 1u);
+	BOOST_CHECK_EQUAL(mock::BoundVertexArray(), Expose(vao).Name());
+	BOOST_CHECK_EQUAL(cache.Hits(), 1u);
+	BOOST_CHECK_EQUAL(cache.Misses(), 1u);
+
+	mock::ClearCalls();
+	vbo.Bind(Buffer::Target::Array);
+	ibo.Bind(Buffer::Target::ElementArray);
+	vbo.Bind(Buffer::Target::Array);
+	ibo.Bind(Buffer::Target::ElementArray);
+	ibo.Bind(Buffer::Target::Array);
+	BOOST_CHECK_EQUAL(mock::CallCount("glBindBuffer"), 3u);
+	BOOST_CHECK_EQUAL(mock::BoundBuffer(GL_ARRAY_BUFFER), Expose(ibo).Name());
+
+	// the element array binding is a part of the VAO state
+	mock::ClearCalls();
+	VertexArray::Unbind();
+	vao.Bind();
+	ibo.Bind(Buffer::Target::ElementArray);
+	BOOST_CHECK_EQUAL(mock::CallCount("glBindVertexArray"), 2u);
+	BOOST_CHECK_EQUAL(mock::CallCount("glBindBuffer"), 1u);
+
+	mock::ClearCalls();
+	Program::UseNone();
+	Program::UseNone();
+	BOOST_CHECK_EQUAL(mock::CallCount("glUseProgram"), 1u);
+
+	cache.ResetCounters();
+	BOOST_CHECK_EQUAL(cache.Hits(), 0u);
+	BOOST_CHECK_EQUAL(cache.Misses(), 0u);
+
+	mock::ClearCalls();
+	cache.Invalidate();
+	vao.Bind();
+	BOOST_CHECK_EQUAL(mock::CallCount("glBindVertexArray"), 1u);
+	BOOST_CHECK_EQUAL(cache.Misses(), 1u);
+
+	VertexArray::Unbind();
+	oglplus::StateCache::MakeNoneCurrent();
+}
+
+BOOST_AUTO_TEST_CASE(StateCache_textures)
+{
+	using namespace oglplus;
+	oglplus::StateCache cache;
+	cache.MakeCurrent();
+
+	Texture tex0, tex1;
+	Sampler smp;
+
+	mock::ClearCalls();
+	Texture::Active(1);
+	tex1.Bind(Texture::Target::_2D);
+	Texture::Active(0);
+	tex0.Bind(Texture::Target::_2D);
+	Texture::Active(1);
+	tex1.Bind(Texture::Target::_2D);
+	tex1.Bind(Texture::Target::_2D);
+	BOOST_CHECK_EQUAL(mock::CallCount("glActiveTexture"), 3u);
+	BOOST_CHECK_EQUAL(mock::CallCount("glBindTexture"), 2u);
+	BOOST_CHECK_EQUAL(
+		mock::BoundTexture(0, GL_TEXTURE_2D),
+		Expose(tex0).Name()
+	);
+	BOOST_CHECK_EQUAL(
+		mock::BoundTexture(1, GL_TEXTURE_2D),
+		Expose(tex1).Name()
+	);
+
+	// the active unit is returned from the cache
+	mock::ClearCalls();
+	BOOST_CHECK_EQUAL(Texture::Active(), 1);
+	BOOST_CHECK_EQUAL(mock::CallCount("glGetIntegerv"), 0u);
+
+	cache.Invalidate();
+	BOOST_CHECK_EQUAL(Texture::Active(), 1);
+	BOOST_CHECK_EQUAL(mock::CallCount("glGetIntegerv"), 1u);
+
+	// the texture binding is not cached when the active unit is not known
+	mock::ClearCalls();
+	tex1.Bind(Texture::Target::_2D);
+	tex1.Bind(Texture::Target::_2D);
+	BOOST_CHECK_EQUAL(mock::CallCount("glBindTexture"), 2u);
+
+	mock::ClearCalls();
+	smp.Bind(2);
+	smp.Bind(2);
+	smp.Bind(3);
+	Sampler::Unbind(2);
+	Sampler::Unbind(2);
+	BOOST_CHECK_EQUAL(mock::CallCount("glBindSampler"), 3u);
+	BOOST_CHECK_EQUAL(mock::BoundSampler(3), Expose(smp).Name());
+
+	oglplus::StateCache::MakeNoneCurrent();
+}
+
+BOOST_AUTO_TEST_CASE(StateCache_context)
+{
+	using namespace oglplus;
+	oglplus::StateCache cache;
+	cache.MakeCurrent();
+	Context gl;
+
+	mock::ClearCalls();
+	gl.Enable(Capability::DepthTest);
+	gl.Enable(Capability::DepthTest);
+	gl.Disable(Capability::CullFace);
+	gl.Disable(Capability::CullFace);
+	BOOST_CHECK_EQUAL(mock::CallCount("glEnable"), 1u);
+	BOOST_CHECK_EQUAL(mock::CallCount("glDisable"), 1u);
+
+	// the known capabilities are returned from the cache
+	BOOST_CHECK(gl.IsEnabled(Capability::DepthTest));
+	BOOST_CHECK(!gl.IsEnabled(Capability::CullFace));
+	BOOST_CHECK_EQUAL(mock::CallCount("glIsEnabled"), 0u);
+
+	mock::ClearCalls();
+	gl.Viewport(800, 600);
+	gl.Viewport(0, 0, 800, 600);
+	gl.Viewport(0, 0, 640, 480);
+	BOOST_CHECK_EQUAL(mock::CallCount("glViewport"), 2u);
+
+	mock::ClearCalls();
+	gl.BlendFunc(BlendFn::SrcAlpha, BlendFn::OneMinusSrcAlpha);
+	gl.BlendFunc(BlendFn::SrcAlpha, BlendFn::OneMinusSrcAlpha);
+	gl.BlendFuncSeparate(
+		BlendFn::SrcAlpha,
+		BlendFn::OneMinusSrcAlpha,
+		BlendFn::SrcAlpha,
+		BlendFn::OneMinusSrcAlpha
+	);
+	gl.BlendEquation(BlendEq::Add);
+	gl.BlendEquation(BlendEq::Add);
+	gl.BlendColor(0.5f, 0.5f, 0.5f, 1.0f);
+	gl.BlendColor(0.5f, 0.5f, 0.5f, 1.0f);
+	BOOST_CHECK_EQUAL(mock::CallCount("glBlendFunc"), 1u);
+	BOOST_CHECK_EQUAL(mock::CallCount("glBlendFuncSeparate"), 0u);
+	BOOST_CHECK_EQUAL(mock::CallCount("glBlendEquation"), 1u);
+	BOOST_CHECK_EQUAL(mock::CallCount("glBlendColor"), 1u);
+
+	mock::ClearCalls();
+	gl.DepthFunc(CompareFn::LEqual);
+	gl.DepthFunc(CompareFn::LEqual);
+	gl.DepthMask(false);
+	gl.DepthMask(false);
+	gl.StencilFunc(CompareFn::Always, 1, 0xFF);
+	gl.StencilFunc(CompareFn::Always, 1, 0xFF);
+	gl.StencilOp(StencilOp::Keep, StencilOp::Keep, StencilOp::Replace);
+	gl.StencilOp(StencilOp::Keep, StencilOp::Keep, StencilOp::Replace);
+	BOOST_CHECK_EQUAL(mock::CallCount("glDepthFunc"), 1u);
+	BOOST_CHECK_EQUAL(mock::CallCount("glDepthMask"), 1u);
+	BOOST_CHECK_EQUAL(mock::CallCount("glStencilFunc"), 1u);
+	BOOST_CHECK_EQUAL(mock::CallCount("glStencilOp"), 1u);
+
+	BOOST_CHECK_EQUAL(cache.Hits(), 11u);
+
+	oglplus::StateCache::MakeNoneCurrent();
+}
+
+BOOST_AUTO_TEST_CASE(StateCache_deleted_objects)
+{
+	using namespace oglplus;
+	oglplus::StateCache cache;
+	cache.MakeCurrent();
+
+	GLint name = 0;
+	{
+		Buffer buffer;
+		buffer.Bind(Buffer::Target::Array);
+		BOOST_CHECK(aux::StateChange::Find(
+			aux::StateCacheKey::Buffer,
+			GL_ARRAY_BUFFER,
+			0,
+			name
+		));
+		BOOST_CHECK_EQUAL(GLuint(name), Expose(buffer).Name());
+	}
+	BOOST_CHECK(!aux::StateChange::Find(
+		aux::StateCacheKey::Buffer,
+		GL_ARRAY_BUFFER,
+		0,
+		name
+	));
+
+	// the cache is not current after it is destroyed
+	{
+		oglplus::StateCache other;
+		other.MakeCurrent();
+	}
+	BOOST_CHECK(oglplus::StateCache::Current() == nullptr);
+}
+
+#if !OGLPLUS_NO_THREAD_LOCAL
+BOOST_AUTO_TEST_CASE(StateCache_per_thread)
+{
+	using namespace oglplus;
+	oglplus::StateCache cache;
+	cache.MakeCurrent();
+
+	// each thread has its own current cache
+	oglplus::StateCache* other_current = &cache;
+	std::thread other([&other_current](void)
+	{
+		other_current = oglplus::StateCache::Current();
+	});
+	other.join();
+	BOOST_CHECK(other_current == nullptr);
+	BOOST_CHECK(oglplus::StateCache::Current() == &cache);
+	oglplus::StateCache::MakeNoneCurrent();
+}
+#endif
+
+#endif // OGLPLUS_NO_STATE_CACHE
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,152 @@
+/**
+ *  .file test/oglplus/streaming_buffer.cpp
+ *  .brief Test case for the persistently mapped streaming buffer.
+ *
+ *  .author Matus Chochlik
+ *
+ *  Copyright 2010-2013 Matus Chochlik. Distributed under the Boost
+ *  Software License, Version 1.0. (See accompanying file
+ *  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ */
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE OGLPLUS_StreamingBuffer
+#include <boost/test/unit_test.hpp>
+
+#include <oglplus/gl.hpp>
+#include <oglplus/streaming_buffer.hpp>
+#include <oglplus/indirect_command.hpp>
+#include <oglplus/exposed.hpp>
+
+#include "fixture.hpp"
+#include "mock_gl.hpp"
+
+BOOST_GLOBAL_FIXTURE(OGLplusTestFixture);
+
+BOOST_AUTO_TEST_SUITE(StreamingBuffer)
+
+BOOST_AUTO_TEST_CASE(StreamingBuffer_allocation)
+{
+	using namespace oglplus;
+	mock::ClearCalls();
+	oglplus::StreamingBuffer stream(BufferTarget::Uniform, 4096);
+	GLuint name = Expose(stream.Object()).Name();
+	BOOST_CHECK_EQUAL(mock::CallCount("glBufferStorage"), 1u);
+	BOOST_CHECK_EQUAL(mock::CallCount("glMapBufferRange"), 1u);
+
+	// the previous binding of the target is restored
+	BOOST_CHECK_EQUAL(mock::BoundBuffer(GL_UNIFORM_BUFFER), 0u);
+	stream.Object().Bind(BufferTarget::Uniform);
+	BOOST_CHECK(Buffer::ImmutableStorage(BufferTarget::Uniform));
+	BOOST_CHECK(Buffer::Mapped(BufferTarget::Uniform));
+	Buffer::Unbind(BufferTarget::Uniform);
+
+	oglplus::StreamingBuffer::Range a = stream.Allocate(10, 4);
+	BOOST_CHECK_EQUAL(a.Offset(), 0);
+	BOOST_CHECK_EQUAL(a.Size(), 10);
+
+	// the uniform blocks are aligned to UNIFORM_BUFFER_OFFSET_ALIGNMENT
+	GLfloat values[4] = {1.0f, 2.0f, 3.0f, 4.0f};
+	oglplus::StreamingBuffer::Range u = stream.AllocateUniform(sizeof(values));
+	BOOST_CHECK_EQUAL(u.Offset(), 256);
+	for(std::size_t i=0; i!=4; ++i)
+		u.Pointer<GLfloat>()[i] = values[i];
+	const GLubyte* data = mock::BufferData(name).data()+256;
+	BOOST_CHECK(std::memcmp(data, values, sizeof(values)) == 0);
+
+	// the arrays are aligned to the size of their elements
+	oglplus::StreamingBuffer::Range c =
+		stream.AllocateArray<DrawElementsIndirectCommand>(2);
+	BOOST_CHECK_EQUAL(c.Offset() % sizeof(DrawElementsIndirectCommand), 0);
+	BOOST_CHECK(c.Offset() >= u.Offset()+u.Size());
+
+	oglplus::StreamingBuffer::Range w = stream.Write(values, sizeof(values));
+	data = mock::BufferData(name).data()+w.Offset();
+	BOOST_CHECK(std::memcmp(data, values, sizeof(values)) == 0);
+
+	stream.BindRange(BufferIndexedTarget::Uniform, 0, u);
+	BOOST_CHECK_EQUAL(mock::CallCount("glBindBufferRange"), 1u);
+
+	// nothing is copied through the driver
+	BOOST_CHECK_EQUAL(mock::CallCount("glBufferSubData"), 0u);
+	BOOST_CHECK_EQUAL(stream.Allocations(), 4u);
+	BOOST_CHECK_EQUAL(stream.Stalls(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(StreamingBuffer_fences)
+{
+	using namespace oglplus;
+	oglplus::StreamingBuffer stream(BufferTarget::Array, 1024);
+	std::size_t fences = mock::FenceCount();
+
+	mock::ClearCalls();
+	for(GLintptr frame=0; frame!=4; ++frame)
+	{
+		BOOST_CHECK_EQUAL(stream.Allocate(256).Offset(), frame*256);
+		stream.EndFrame();
+	}
+	// an empty frame is not fenced
+	stream.EndFrame();
+	BOOST_CHECK_EQUAL(mock::CallCount("glFenceSync"), 4u);
+	BOOST_CHECK_EQUAL(mock::FenceCount(), fences+4);
+	BOOST_CHECK_EQUAL(stream.FramesInFlight(), 4u);
+	BOOST_CHECK_EQUAL(mock::CallCount("glClientWaitSync"), 0u);
+
+	// the ring wraps onto the first frame which is still in flight
+	BOOST_CHECK_EQUAL(stream.Allocate(256).Offset(), 0);
+	BOOST_CHECK_EQUAL(stream.Wraps(), 1u);
+	BOOST_CHECK_EQUAL(stream.Stalls(), 1u);
+	BOOST_CHECK_EQUAL(mock::CallCount("glClientWaitSync"), 1u);
+	BOOST_CHECK_EQUAL(stream.FramesInFlight(), 3u);
+	stream.EndFrame();
+
+	// the GPU has finished the older frames, no waiting is necessary
+	mock::SignalFences();
+	mock::ClearCalls();
+	BOOST_CHECK_EQUAL(stream.Allocate(300).Offset(), 256);
+	BOOST_CHECK_EQUAL(mock::CallCount("glClientWaitSync"), 0u);
+	BOOST_CHECK_EQUAL(stream.Stalls(), 1u);
+	BOOST_CHECK_EQUAL(stream.FramesInFlight(), 2u);
+
+	// the range which does not fit at the end starts at the beginning
+	stream.EndFrame();
+	stream.Allocate(300);
+	BOOST_CHECK_EQUAL(stream.Allocate(300).Offset(), 0);
+	BOOST_CHECK_EQUAL(stream.Wraps(), 2u);
+	BOOST_CHECK_EQUAL(stream.Stalls(), 2u);
+}
+
+BOOST_AUTO_TEST_CASE(StreamingBuffer_overflow)
+{
+	using namespace oglplus;
+	oglplus::StreamingBuffer stream(BufferTarget::Array, 1024);
+	BOOST_CHECK_THROW(stream.Allocate(2048), LimitError);
+
+	// the data of the current frame must not be overwritten
+	stream.Allocate(512);
+	stream.Allocate(400);
+	BOOST_CHECK_THROW(stream.Allocate(200), LimitError);
+	stream.EndFrame();
+	BOOST_CHECK_EQUAL(stream.Allocate(200).Offset(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(StreamingBuffer_binding)
+{
+	using namespace oglplus;
+	Buffer other;
+	other.Bind(BufferTarget::Array);
+	{
+		oglplus::StreamingBuffer stream(BufferTarget::Array, 1024);
+		BOOST_CHECK_EQUAL(
+			mock::BoundBuffer(GL_ARRAY_BUFFER),
+			Expose(other).Name()
+		);
+		mock::ClearCalls();
+	}
+	// the stream buffer is unmapped, not the one bound to the target
+	BOOST_CHECK_EQUAL(mock::CallCount("glUnmapBuffer"), 1u);
+	BOOST_CHECK_EQUAL(mock::BoundBuffer(GL_ARRAY_BUFFER), Expose(other).Name());
+	BOOST_CHECK(!Buffer::Mapped(BufferTarget::Array));
+	Buffer::Unbind(BufferTarget::Array);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,136 @@
+/**
+ *  .file test/oglplus/subdiv_sphere.cpp
+ *  .brief Test case for the SimpleSubdivSphere shape builder.
+ *
+ *  .author Matus Chochlik
+ *
+ *  Copyright 2010-2013 Matus Chochlik. Distributed under the Boost
+ *  Software License, Version 1.0. (See accompanying file
+ *  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ */
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE OGLPLUS_SubdivSphere
+#include <boost/test/unit_test.hpp>
+
+#include <oglplus/gl.hpp>
+#include <oglplus/shapes/subdiv_sphere.hpp>
+
+#include <vector>
+#include <set>
+#include <utility>
+#include <cmath>
+
+BOOST_AUTO_TEST_SUITE(SubdivSphere)
+
+static void check_subdiv_sphere(
+	GLuint subdivs,
+	oglplus::shapes::SubdivSphereInitialShape initial,
+	GLuint initial_faces,
+	GLuint pole_faces
+)
+{
+	using namespace oglplus;
+	shapes::SimpleSubdivSphere sphere(subdivs, initial);
+
+	std::vector<GLdouble> pos, nml, tc;
+	BOOST_CHECK_EQUAL(sphere.Positions(pos), 3u);
+	BOOST_CHECK_EQUAL(sphere.Normals(nml), 3u);
+	BOOST_CHECK_EQUAL(sphere.TexCoordinates(tc), 2u);
+	const GLuint vert_count = GLuint(pos.size()/3);
+	BOOST_CHECK_EQUAL(nml.size(), pos.size());
+	BOOST_CHECK_EQUAL(tc.size(), vert_count*2u);
+
+	const std::vector<GLuint> indices = sphere.Indices();
+	const GLuint face_count = GLuint(indices.size()/3);
+	BOOST_CHECK_EQUAL(face_count, initial_faces << (2*subdivs));
+
+	for(GLuint v=0; v!=vert_count; ++v)
+	{
+		const GLdouble* p = pos.data()+v*3;
+		BOOST_CHECK_CLOSE(
+			std::sqrt(p[0]*p[0]+p[1]*p[1]+p[2]*p[2]),
+			1.0, 1e-9
+		);
+		for(GLuint c=0; c!=3; ++c)
+			BOOST_CHECK_EQUAL(nml[v*3+c], p[c]);
+		// the same mapping as the one used by Sphere
+		BOOST_CHECK_CLOSE(
+			tc[v*2+1],
+			1.0 - std::acos(p[1])/(4*std::atan(1.0)),
+			1e-6
+		);
+		BOOST_CHECK(tc[v*2+0] >= 0.0 && tc[v*2+0] <= 1.5);
+	}
+
+	// the faces are oriented outwards, they do not span over
+	// the texture seam (except for the faces surrounding a pole
+	// which is not a vertex) and each directed edge is used once
+	std::set<std::pair<GLuint, GLuint> > edges;
+	GLuint wide_faces = 0;
+	for(GLuint f=0; f!=face_count; ++f)
+	{
+		const GLuint* face = indices.data()+f*3;
+		GLdouble e1[3], e2[3], c[3];
+		for(GLuint k=0; k!=3; ++k)
+		{
+			BOOST_CHECK(face[k] < vert_count);
+			e1[k] = pos[face[1]*3+k] - pos[face[0]*3+k];
+			e2[k] = pos[face[2]*3+k] - pos[face[0]*3+k];
+			c[k] = pos[face[0]*3+k];
+		}
+		const GLdouble n[3] = {
+			e1[1]*e2[2] - e1[2]*e2[1],
+			e1[2]*e2[0] - e1[0]*e2[2],
+			e1[0]*e2[1] - e1[1]*e2[0]
+		};
+		BOOST_CHECK(n[0]*c[0]+n[1]*c[1]+n[2]*c[2] > 0);
+
+		GLdouble s_min = 2.0, s_max = -1.0;
+		for(GLuint k=0; k!=3; ++k)
+		{
+			const GLdouble s = tc[face[k]*2];
+			if(s_min > s) s_min = s;
+			if(s_max < s) s_max = s;
+			const std::pair<GLuint, GLuint> e(face[k], face[(k+1)%3]);
+			BOOST_CHECK(edges.insert(e).second);
+		}
+		if(s_max - s_min > 0.5) ++wide_faces;
+	}
+	BOOST_CHECK_EQUAL(wide_faces, pole_faces);
+}
+
+BOOST_AUTO_TEST_CASE(SubdivSphere_icosahedron)
+{
+	typedef oglplus::shapes::SubdivSphereInitialShape Shape;
+	for(GLuint s=0; s!=5; ++s)
+		check_subdiv_sphere(s, Shape::Icosahedron, 20, 0);
+}
+
+BOOST_AUTO_TEST_CASE(SubdivSphere_octohedron)
+{
+	typedef oglplus::shapes::SubdivSphereInitialShape Shape;
+	for(GLuint s=0; s!=5; ++s)
+		check_subdiv_sphere(s, Shape::Octohedron, 8, 0);
+}
+
+BOOST_AUTO_TEST_CASE(SubdivSphere_tetrahedron)
+{
+	typedef oglplus::shapes::SubdivSphereInitialShape Shape;
+	for(GLuint s=0; s!=5; ++s)
+		// the south pole lies inside of one of the faces
+		check_subdiv_sphere(s, Shape::Tetrahedron, 4, 1);
+}
+
+BOOST_AUTO_TEST_CASE(SubdivSphere_dense)
+{
+	oglplus::shapes::SimpleSubdivSphere sphere(6);
+	std::vector<GLfloat> pos;
+	sphere.Positions(pos);
+	const GLuint face_count = GLuint(sphere.Indices().size()/3);
+	BOOST_CHECK_EQUAL(face_count, 20u*4096u);
+	// 10*4^n+2 unique vertices plus the seam and pole copies
+	BOOST_CHECK(pos.size()/3 >= 10u*4096u+2u);
+	BOOST_CHECK(pos.size()/3 < 10u*4096u+2u+2*256u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
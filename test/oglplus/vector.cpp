@@ -1009,4 +1009,29 @@ BOOST_AUTO_TEST_CASE(Vector_swizzle_4)
 	do_test_swizzle(Swizzle(v).wwww(), w,w,w,w);
 }
 
+BOOST_AUTO_TEST_CASE(Vector_constexpr)
+{
+#if !OGLPLUS_NO_CONSTEXPR_MATH
+	typedef oglplus::Vector<double, 3> vec3;
+	typedef oglplus::Vector<double, 4> vec4;
+
+	constexpr oglplus::Vector<float, 2> z;
+	static_assert(z.x() == 0.0f && z.y() == 0.0f, "");
+
+	constexpr vec3 a(1.0, 2.0, 3.0);
+	constexpr vec3 b = a + vec3(4.0, 5.0, 6.0);
+	static_assert(b.x() == 5.0 && b.y() == 7.0 && b.z() == 9.0, "");
+
+	constexpr vec3 c = -(b - a) * 2.0 / 4.0;
+	static_assert(c[0] == -2.0 && c[1] == -2.5 && c.At(2) == -3.0, "");
+
+	constexpr vec4 d(a, 1.0);
+	static_assert(d.w() == 1.0 && d.xyz().z() == 3.0, "");
+	static_assert(vec4(2.0).At(3) == 2.0 && d.At(4, 7.0) == 7.0, "");
+
+	BOOST_CHECK(b == vec3(5.0, 7.0, 9.0));
+	BOOST_CHECK(c == vec3(-2.0, -2.5, -3.0));
+#endif
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,151 @@
+/**
+ *  .file test/oglplus/vertex_cache.cpp
+ *  .brief Test case for the vertex cache optimization of shapes.
+ *
+ *  .author Matus Chochlik
+ *
+ *  Copyright 2010-2013 Matus Chochlik. Distributed under the Boost
+ *  Software License, Version 1.0. (See accompanying file
+ *  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ */
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE OGLPLUS_VertexCache
+#include <boost/test/unit_test.hpp>
+
+#include <oglplus/gl.hpp>
+#include <oglplus/shapes/vertex_cache.hpp>
+#include <oglplus/shapes/torus.hpp>
+#include <oglplus/shapes/sphere.hpp>
+
+#include <algorithm>
+#include <cstdlib>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(VertexCache)
+
+// rotates the triangles so that the smallest index is first
+// and sorts them, keeping the winding
+static std::vector<GLuint> canonical(std::vector<GLuint> triangles)
+{
+	std::vector<std::vector<GLuint> > tris;
+	for(std::size_t t=0; t!=triangles.size()/3; ++t)
+	{
+		GLuint* v = triangles.data()+t*3;
+		std::rotate(v, std::min_element(v, v+3), v+3);
+		tris.push_back(std::vector<GLuint>(v, v+3));
+	}
+	std::sort(tris.begin(), tris.end());
+	std::vector<GLuint> result;
+	for(auto i=tris.begin(), e=tris.end(); i!=e; ++i)
+		result.insert(result.end(), i->begin(), i->end());
+	return result;
+}
+
+BOOST_AUTO_TEST_CASE(VertexCache_statistics)
+{
+	using namespace oglplus::shapes;
+	const GLuint tris[] = {0, 1, 2, 2, 1, 3, 4, 5, 6};
+	std::vector<GLuint> triangles(tris, tris+9);
+	VertexCacheStatistics stats = AnalyzeVertexCache(triangles, 16);
+	BOOST_CHECK_EQUAL(stats.triangle_count, 3u);
+	BOOST_CHECK_EQUAL(stats.vertex_count, 7u);
+	BOOST_CHECK_EQUAL(stats.transform_count, 7u);
+	BOOST_CHECK_CLOSE(stats.ACMR(), 7.0/3.0, 1e-9);
+	BOOST_CHECK_CLOSE(stats.ATVR(), 1.0, 1e-9);
+
+	stats = AnalyzeVertexCache(triangles, 2);
+	BOOST_CHECK_EQUAL(stats.transform_count, 8u);
+}
+
+BOOST_AUTO_TEST_CASE(VertexCache_optimize)
+{
+	using namespace oglplus::shapes;
+	const GLuint n = 60;
+	// a regular grid of n x n quads split into triangles, row by row
+	std::vector<GLuint> triangles;
+	for(GLuint r=0; r!=n; ++r)
+	for(GLuint c=0; c!=n; ++c)
+	{
+		const GLuint v = r*(n+1)+c;
+		const GLuint q[6] = {v, v+1, v+n+1, v+n+1, v+1, v+n+2};
+		triangles.insert(triangles.end(), q, q+6);
+	}
+	const std::vector<GLuint> original(triangles);
+	const double before = AnalyzeVertexCache(triangles).ACMR();
+
+	OptimizeVertexCache(triangles, (n+1)*(n+1));
+	BOOST_CHECK(canonical(triangles) == canonical(original));
+	const double after = AnalyzeVertexCache(triangles).ACMR();
+	BOOST_CHECK(after < before);
+	BOOST_CHECK(after < 0.8);
+
+	std::vector<GLuint> indices(triangles);
+	std::vector<GLuint> order = OptimizeVertexFetch(indices, (n+1)*(n+1));
+	BOOST_CHECK_EQUAL(order.size(), (n+1)*(n+1));
+	BOOST_CHECK_EQUAL(indices[0], 0u);
+	for(std::size_t i=0; i!=indices.size(); ++i)
+		BOOST_CHECK_EQUAL(order[indices[i]], triangles[i]);
+}
+
+template <class ShapeBuilder>
+static void do_test_vertex_cache_optimized(
+	const ShapeBuilder& builder,
+	std::size_t triangle_count
+)
+{
+	using namespace oglplus::shapes;
+	VertexCacheOptimized<ShapeBuilder> optimized(builder);
+
+	std::vector<GLfloat> pos, opt_pos, nml, opt_nml;
+	const GLuint npv = builder.Positions(pos);
+	BOOST_CHECK_EQUAL(optimized.Positions(opt_pos), npv);
+	BOOST_CHECK_EQUAL(pos.size(), opt_pos.size());
+	BOOST_CHECK_EQUAL(builder.Normals(nml), optimized.Normals(opt_nml));
+
+	// collect the triangles of the original and the optimized shape
+	// in terms of the vertex positions
+	std::vector<GLuint> opt_tris;
+	auto ops = optimized.Instructions().Operations();
+	BOOST_CHECK_EQUAL(ops.size(), builder.Instructions().Operations().size());
+	for(auto i=ops.begin(), e=ops.end(); i!=e; ++i)
+	{
+		BOOST_CHECK(i->mode == oglplus::PrimitiveType::Triangles);
+		for(GLuint j=0; j!=i->count; ++j)
+		{
+			opt_tris.push_back(optimized.Indices()[i->first+j]);
+		}
+	}
+	BOOST_CHECK_EQUAL(opt_tris.size(), triangle_count*3);
+	VertexCacheStatistics stats = AnalyzeVertexCache(opt_tris);
+	BOOST_CHECK(stats.ACMR() < 1.0);
+	BOOST_CHECK(stats.ATVR() < 1.5);
+
+	// each optimized vertex must match some original vertex
+	std::vector<GLuint> map(opt_pos.size()/npv);
+	for(GLuint v=0; v!=map.size(); ++v)
+	{
+		bool found = false;
+		for(GLuint w=0; !found && w!=map.size(); ++w)
+		{
+			found = std::equal(
+				opt_pos.begin()+v*npv,
+				opt_pos.begin()+v*npv+npv,
+				pos.begin()+w*npv
+			) && std::equal(
+				opt_nml.begin()+v*3,
+				opt_nml.begin()+v*3+3,
+				nml.begin()+w*3
+			);
+		}
+		BOOST_CHECK(found);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(VertexCache_shapes)
+{
+	using namespace oglplus::shapes;
+	do_test_vertex_cache_optimized(Torus(1.0, 0.5, 36, 24), 36*24*2);
+	do_test_vertex_cache_optimized(Sphere(1.0, 24, 18), 24*19*2);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,167 @@
+/**
+ *  .file test/oglplus/vertex_layout.cpp
+ *  .brief Test case for the packed vertex attribute formats.
+ *
+ *  .author Matus Chochlik
+ *
+ *  Copyright 2010-2013 Matus Chochlik. Distributed under the Boost
+ *  Software License, Version 1.0. (See accompanying file
+ *  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ */
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE OGLPLUS_VertexLayout
+#include <boost/test/unit_test.hpp>
+
+#include <oglplus/gl.hpp>
+#include <oglplus/shapes/vertex_layout.hpp>
+
+#include <vector>
+#include <limits>
+#include <cstring>
+#include <cstdlib>
+#include <cmath>
+
+BOOST_AUTO_TEST_SUITE(VertexLayout)
+
+BOOST_AUTO_TEST_CASE(VertexLayout_half_float)
+{
+	using namespace oglplus;
+	BOOST_CHECK_EQUAL(aux::FloatToHalf(0.0f), 0x0000);
+	BOOST_CHECK_EQUAL(aux::FloatToHalf(-0.0f), 0x8000);
+	BOOST_CHECK_EQUAL(aux::FloatToHalf(1.0f), 0x3C00);
+	BOOST_CHECK_EQUAL(aux::FloatToHalf(-2.0f), 0xC000);
+	BOOST_CHECK_EQUAL(aux::FloatToHalf(0.5f), 0x3800);
+	BOOST_CHECK_EQUAL(aux::FloatToHalf(65504.0f), 0x7BFF);
+	BOOST_CHECK_EQUAL(aux::FloatToHalf(1e6f), 0x7C00);
+	BOOST_CHECK_EQUAL(aux::FloatToHalf(-1e6f), 0xFC00);
+	// the smallest denormalized half
+	BOOST_CHECK_EQUAL(aux::FloatToHalf(std::ldexp(1.0f, -24)), 0x0001);
+	BOOST_CHECK_EQUAL(aux::FloatToHalf(std::ldexp(1.0f, -26)), 0x0000);
+	// ties are rounded to even
+	const GLfloat tie1 = 1.0f + std::ldexp(1.0f, -11);
+	const GLfloat tie3 = 1.0f + std::ldexp(3.0f, -11);
+	BOOST_CHECK_EQUAL(aux::FloatToHalf(tie1), 0x3C00);
+	BOOST_CHECK_EQUAL(aux::FloatToHalf(tie3), 0x3C02);
+
+	const GLfloat inf = std::numeric_limits<GLfloat>::infinity();
+	BOOST_CHECK_EQUAL(aux::FloatToHalf(inf), 0x7C00);
+	BOOST_CHECK(aux::HalfToFloat(0x7C00) == inf);
+	const GLushort nan = aux::FloatToHalf(
+		std::numeric_limits<GLfloat>::quiet_NaN()
+	);
+	BOOST_CHECK(((nan & 0x7C00) == 0x7C00) && ((nan & 0x03FF) != 0));
+
+	// all finite halfs convert to floats and back without any change
+	for(GLuint h=0; h!=0x10000; ++h)
+	{
+		if((h & 0x7C00) == 0x7C00) continue;
+		const GLfloat f = aux::HalfToFloat(GLushort(h));
+		BOOST_CHECK_EQUAL(aux::FloatToHalf(f), GLushort(h));
+	}
+
+	for(std::size_t n=0; n!=1000; ++n)
+	{
+		const GLfloat f =
+			GLfloat(std::rand()) / GLfloat(RAND_MAX) * 200.0f - 100.0f;
+		const GLfloat r = aux::HalfToFloat(aux::FloatToHalf(f));
+		BOOST_CHECK(std::fabs(r - f) <= std::fabs(f) * 0.0005f);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(VertexLayout_snorm)
+{
+	using namespace oglplus;
+	BOOST_CHECK_EQUAL(aux::FloatToSnorm(1.0f, 16), 32767);
+	BOOST_CHECK_EQUAL(aux::FloatToSnorm(-1.0f, 16), -32767);
+	BOOST_CHECK_EQUAL(aux::FloatToSnorm(-2.0f, 16), -32767);
+	BOOST_CHECK_EQUAL(aux::FloatToSnorm(0.0f, 16), 0);
+	BOOST_CHECK_EQUAL(aux::FloatToSnorm(0.5f, 10), 256);
+	BOOST_CHECK_EQUAL(aux::FloatToSnorm(-1.0f, 2), -1);
+
+	const GLfloat v[4] = {1.0f, -1.0f, 0.0f, 1.0f};
+	const GLuint p = aux::PackSnorm2101010Rev(v, 4);
+	BOOST_CHECK_EQUAL(p & 0x3FF, 511u);
+	BOOST_CHECK_EQUAL((p >> 10) & 0x3FF, 0x201u);
+	BOOST_CHECK_EQUAL((p >> 20) & 0x3FF, 0u);
+	BOOST_CHECK_EQUAL(p >> 30, 1u);
+	BOOST_CHECK_EQUAL(aux::PackSnorm2101010Rev(v, 3) >> 30, 0u);
+}
+
+BOOST_AUTO_TEST_CASE(VertexLayout_formats)
+{
+	using namespace oglplus;
+	typedef shapes::VertexLayout::Format Format;
+
+	BOOST_CHECK(!shapes::VertexLayout().IsInterleaved());
+	BOOST_CHECK(!shapes::VertexLayout::Separate().IsInterleaved());
+	BOOST_CHECK(shapes::VertexLayout::Interleaved().IsInterleaved());
+
+	shapes::VertexLayout layout = shapes::VertexLayout::Packed();
+	BOOST_CHECK(layout.IsInterleaved());
+	BOOST_CHECK(layout.AttribFormat("Position") == Format::HalfFloat);
+	BOOST_CHECK(layout.AttribFormat("TexCoord") == Format::HalfFloat);
+	BOOST_CHECK(layout.AttribFormat("Material") == Format::Float);
+	layout.AttribFormat("Position", Format::NormalizedShort);
+	BOOST_CHECK(layout.AttribFormat("Position") == Format::NormalizedShort);
+	layout.DefaultFormat(Format::HalfFloat);
+	BOOST_CHECK(layout.AttribFormat("Material") == Format::HalfFloat);
+
+	BOOST_CHECK_EQUAL(shapes::VertexLayout::Size(Format::Float, 3), 12u);
+	BOOST_CHECK_EQUAL(shapes::VertexLayout::Size(Format::HalfFloat, 3), 8u);
+	BOOST_CHECK_EQUAL(shapes::VertexLayout::Size(Format::HalfFloat, 2), 4u);
+	BOOST_CHECK_EQUAL(
+		shapes::VertexLayout::Size(Format::Int_2_10_10_10_Rev, 3),
+		4u
+	);
+	BOOST_CHECK_EQUAL(
+		shapes::VertexLayout::ValuesPerVertex(
+			Format::Int_2_10_10_10_Rev,
+			3
+		), 4
+	);
+	BOOST_CHECK(
+		shapes::VertexLayout::FormatDataType(Format::HalfFloat) ==
+		DataType::HalfFloat
+	);
+	BOOST_CHECK(shapes::VertexLayout::Normalized(Format::NormalizedShort));
+	BOOST_CHECK(!shapes::VertexLayout::Normalized(Format::HalfFloat));
+}
+
+BOOST_AUTO_TEST_CASE(VertexLayout_pack)
+{
+	using namespace oglplus;
+	typedef shapes::VertexLayout::Format Format;
+
+	const GLfloat positions[6] = {1.0f, 2.0f, 3.0f, -4.0f, 5.0f, -6.0f};
+	const GLfloat normals[6] = {0.0f, 1.0f, 0.0f, -1.0f, 0.0f, 0.0f};
+	const GLuint stride =
+		shapes::VertexLayout::Size(Format::HalfFloat, 3)+
+		shapes::VertexLayout::Size(Format::Int_2_10_10_10_Rev, 3);
+	BOOST_CHECK_EQUAL(stride, 12u);
+
+	std::vector<GLubyte> buffer(stride*2, 0xFF);
+	shapes::VertexLayout::Pack(
+		Format::HalfFloat, 3,
+		positions, 2,
+		buffer.data(), stride
+	);
+	shapes::VertexLayout::Pack(
+		Format::Int_2_10_10_10_Rev, 3,
+		normals, 2,
+		buffer.data()+8, stride
+	);
+	for(GLuint v=0; v!=2; ++v)
+	{
+		for(GLuint c=0; c!=3; ++c)
+		{
+			GLushort h;
+			std::memcpy(&h, buffer.data()+v*stride+c*2, sizeof(h));
+			BOOST_CHECK_EQUAL(aux::HalfToFloat(h), positions[v*3+c]);
+		}
+		GLuint p;
+		std::memcpy(&p, buffer.data()+v*stride+8, sizeof(p));
+		BOOST_CHECK_EQUAL(p, aux::PackSnorm2101010Rev(normals+v*3, 3));
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()